@@ -124,6 +124,37 @@
 		}
 
 
+		/// <summary>
+		/// Distance and bearing of every leg of a line, same values as <see cref="Distance"/> and <see cref="Bearing"/>
+		/// without allocating a point array per call.
+		/// </summary>
+		/// <param name="line">points [longitude, latitude, longitude, latitude, ...]</param>
+		/// <param name="pointCount">Number of points in line</param>
+		/// <param name="distances">Receives pointCount - 1 distances</param>
+		/// <param name="bearings">Receives pointCount - 1 bearings</param>
+		public void Legs(double[] line, int pointCount, double[] distances, double[] bearings)
+		{
+			for (int i = 1; i < pointCount; i++)
+			{
+				var dx = (line[i * 2] - line[i * 2 - 2]) * _kx;
+				var dy = (line[i * 2 + 1] - line[i * 2 - 1]) * _ky;
+				distances[i - 1] = Math.Sqrt(dx * dx + dy * dy);
+
+				if (dx == 0 && dy == 0)
+				{
+					bearings[i - 1] = 0;
+					continue;
+				}
+				var bearing = Math.Atan2(dx, dy) * 180 / Math.PI;
+				if (bearing > 180)
+				{
+					bearing -= 360;
+				}
+				bearings[i - 1] = bearing;
+			}
+		}
+
+
 		/// <summary>
 		/// Returns a new point given distance and bearing from the starting point.
 		/// </summary>
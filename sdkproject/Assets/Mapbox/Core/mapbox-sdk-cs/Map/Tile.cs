@@ -11,7 +11,9 @@ namespace Mapbox.Map
 	using System.Linq;
 	using System.Collections.Generic;
 	using System.Collections.ObjectModel;
+	using System.Diagnostics;
 	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
 
 
 	/// <summary>
@@ -28,6 +30,8 @@ namespace Mapbox.Map
 		private State _state = State.New;
 		private IAsyncRequest _request;
 		private Action _callback;
+		// 'Stopwatch' timestamp of the request if it's traced, see 'TileTrace'
+		private long _requestStart;
 
 		/// <summary> Tile state. </summary>
 		public enum State
@@ -131,6 +135,7 @@ namespace Mapbox.Map
 			_state = State.Loading;
 			_id = param.Id;
 			_callback = callback;
+			_requestStart = TileTrace.Enabled ? Stopwatch.GetTimestamp() : 0;
 			_request = param.Fs.Request(MakeTileResource(param.TilesetId).GetUrl(), HandleTileResponse, tileId: _id, tilesetId: param.TilesetId);
 		}
 
@@ -141,6 +146,7 @@ namespace Mapbox.Map
 			_state = State.Loading;
 			_id = canonicalTileId;
 			_callback = p;
+			_requestStart = TileTrace.Enabled ? Stopwatch.GetTimestamp() : 0;
 			_request = fileSource.Request(MakeTileResource(tilesetId).GetUrl(), HandleTileResponse, tileId: _id, tilesetId: tilesetId);
 		}
 
@@ -209,6 +215,11 @@ namespace Mapbox.Map
 		List<string> ids = new List<string>();
 		private void HandleTileResponse(Response response)
 		{
+			if (0 != _requestStart)
+			{
+				TileTrace.Record(TileTraceStage.Fetch, _id, _requestStart, Stopwatch.GetTimestamp());
+				_requestStart = 0;
+			}
 
 			if (response.HasError)
 			{
@@ -226,7 +237,14 @@ namespace Mapbox.Map
 				// current implementation doesn't need to check if parsing is successful:
 				// * Mapbox.Map.VectorTile.ParseTileData() already adds any exception to the list
 				// * Mapbox.Map.RasterTile.ParseTileData() doesn't do any parsing
-				ParseTileData(response.Data);
+				// responses are shared by all requests for a tile, 'DecompressedData' decompresses gzip data once for all of them
+				TileTraceTimer trace = TileTrace.Begin(TileTraceStage.Decompress, _id);
+				byte[] data = response.DecompressedData;
+				trace.End();
+
+				trace = TileTrace.Begin(TileTraceStage.Parse, _id);
+				ParseTileData(data);
+				trace.End();
 			}
 
 			// Cancelled is not the same as loaded!
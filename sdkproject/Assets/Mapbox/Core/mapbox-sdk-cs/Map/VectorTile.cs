@@ -54,6 +54,12 @@ namespace Mapbox.Map
 
 		private bool isDisposed = false;
 
+		/// <summary>
+		/// Validate all layers and features while parsing, true by default. Consumers that decode
+		/// every feature later anyway (eg on worker threads) can turn it off to keep parsing cheap.
+		/// </summary>
+		public bool ValidateOnParse { get; set; }
+
 		/// <summary> Gets the vector decoded using Mapbox.VectorTile library. </summary>
 		/// <value> The GeoJson data. </value>
 		public Mapbox.VectorTile.VectorTile Data
@@ -67,10 +73,12 @@ namespace Mapbox.Map
 		public VectorTile()
 		{
 			_isStyleOptimized = false;
+			ValidateOnParse = true;
 		}
 
 		public VectorTile(string styleId, string modifiedDate)
 		{
+			ValidateOnParse = true;
 			if (string.IsNullOrEmpty(styleId) || string.IsNullOrEmpty(modifiedDate))
 			{
 				UnityEngine.Debug.LogWarning("Style Id or Modified Time cannot be empty for style optimized tilesets. Switching to regular tilesets!");
@@ -196,7 +204,7 @@ namespace Mapbox.Map
 			try
 			{
 				var decompressed = Compression.Decompress(data);
-				this.data = new Mapbox.VectorTile.VectorTile(decompressed);
+				this.data = new Mapbox.VectorTile.VectorTile(decompressed, ValidateOnParse);
 				return true;
 			}
 			catch (Exception ex)
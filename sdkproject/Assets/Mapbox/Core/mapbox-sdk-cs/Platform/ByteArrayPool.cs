@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------
+// <copyright file="ByteArrayPool.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.Platform
+{
+
+	using System;
+	using System.Collections.Generic;
+
+
+	/// <summary>
+	/// <para>Thread safe pool of byte arrays in power of two size classes, used for network and decompression buffers.</para>
+	/// <para>Rented arrays may be larger than requested. Arrays above <see cref="MaxPooledLength"/> are allocated and dropped.</para>
+	/// </summary>
+	public sealed class ByteArrayPool
+	{
+
+
+		private const int MIN_SHIFT = 10; // 1KB
+		private const int MAX_SHIFT = 22; // 4MB
+
+
+		/// <summary>Pool shared by the HTTP stack.</summary>
+		public static readonly ByteArrayPool Shared = new ByteArrayPool(16);
+
+
+		private readonly Stack<byte[]>[] _buckets = new Stack<byte[]>[MAX_SHIFT - MIN_SHIFT + 1];
+		private readonly int _maxArraysPerBucket;
+
+
+		/// <param name="maxArraysPerBucket">Number of arrays kept per size class, surplus returns are dropped.</param>
+		public ByteArrayPool(int maxArraysPerBucket)
+		{
+			_maxArraysPerBucket = maxArraysPerBucket;
+			for (int i = 0; i < _buckets.Length; i++)
+			{
+				_buckets[i] = new Stack<byte[]>();
+			}
+		}
+
+
+		/// <summary>Largest array size kept by the pool.</summary>
+		public int MaxPooledLength { get { return 1 << MAX_SHIFT; } }
+
+
+		/// <summary>Get an array of at least <paramref name="minimumLength"/> bytes. Content is undefined.</summary>
+		public byte[] Rent(int minimumLength)
+		{
+			if (minimumLength < 0) { throw new ArgumentOutOfRangeException("minimumLength"); }
+
+			int bucket = bucketIndex(minimumLength);
+			if (bucket < 0)
+			{
+				return new byte[minimumLength];
+			}
+
+			Stack<byte[]> stack = _buckets[bucket];
+			lock (stack)
+			{
+				if (stack.Count > 0) { return stack.Pop(); }
+			}
+			return new byte[1 << (bucket + MIN_SHIFT)];
+		}
+
+
+		/// <summary>Give an array obtained from <see cref="Rent"/> back. Must not be used afterwards.</summary>
+		public void Return(byte[] array)
+		{
+			if (null == array) { return; }
+
+			int bucket = bucketIndex(array.Length);
+			// only exact size class arrays, anything else wasn't rented from here
+			if (bucket < 0 || array.Length != 1 << (bucket + MIN_SHIFT)) { return; }
+
+			Stack<byte[]> stack = _buckets[bucket];
+			lock (stack)
+			{
+				if (stack.Count < _maxArraysPerBucket) { stack.Push(array); }
+			}
+		}
+
+
+		private static int bucketIndex(int length)
+		{
+			int shift = MIN_SHIFT;
+			while ((1 << shift) < length)
+			{
+				shift++;
+				if (shift > MAX_SHIFT) { return -1; }
+			}
+			return shift - MIN_SHIFT;
+		}
+	}
+}
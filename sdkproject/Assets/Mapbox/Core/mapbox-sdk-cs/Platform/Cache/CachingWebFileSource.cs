@@ -5,6 +5,7 @@
 	using System.Collections.Generic;
 	using Mapbox.Unity.Utilities;
 	using Mapbox.Map;
+	using Mapbox.Utils;
 	using System.Collections;
 	using System.Linq;
 
@@ -21,9 +22,11 @@
 		private string _accessToken;
 		private Func<string> _getMapsSkuToken;
 		private bool _autoRefreshCache;
+		private TileRequestScheduler _scheduler;
 
 
-		public CachingWebFileSource(string accessToken, Func<string> getMapsSkuToken, bool autoRefreshCache)
+		/// <param name="maxConcurrentRequests">Maximum number of tiles fetched from the web at the same time, 0: unbounded.</param>
+		public CachingWebFileSource(string accessToken, Func<string> getMapsSkuToken, bool autoRefreshCache, int maxConcurrentRequests = 0)
 		{
 #if MAPBOX_DEBUG_CACHE
 			_className = this.GetType().Name;
@@ -31,6 +34,7 @@
 			_accessToken = accessToken;
 			_getMapsSkuToken = getMapsSkuToken;
 			_autoRefreshCache = autoRefreshCache;
+			_scheduler = new TileRequestScheduler(maxConcurrentRequests, fetchAndCache);
 		}
 
 
@@ -54,6 +58,7 @@
 			{
 				if (disposeManagedResources)
 				{
+					_scheduler.Clear();
 					for (int i = 0; i < _caches.Count; i++)
 					{
 						IDisposable cache = _caches[i] as IDisposable;
@@ -102,6 +107,25 @@
 		}
 
 
+		/// <summary>
+		/// Scheduler of the web requests: requests for the same tile share one fetch, tiles closest to the focus are fetched first.
+		/// Exposes per priority queue depth and latency statistics.
+		/// </summary>
+		public TileRequestScheduler Scheduler
+		{
+			get { return _scheduler; }
+		}
+
+
+		/// <summary>
+		/// Set the tile the viewer is currently looking at, tiles closer to it are fetched first.
+		/// </summary>
+		public void SetRequestFocus(CanonicalTileId focus)
+		{
+			_scheduler.SetFocus(focus);
+		}
+
+
 		public void ReInit() {
 			foreach (var cache in _caches)
 			{
@@ -125,32 +149,21 @@
 			}
 
 			CacheItem cachedItem = null;
+			int cacheIndex;
 
 			// go through existing caches and check if we already have the requested tile available
-			foreach (var cache in _caches)
+			TileTraceTimer trace = TileTrace.Begin(TileTraceStage.Cache, tileId);
+			for (cacheIndex = 0; cacheIndex < _caches.Count; cacheIndex++)
 			{
-				cachedItem = cache.Get(tilesetId, tileId);
+				cachedItem = _caches[cacheIndex].Get(tilesetId, tileId);
 				if (null != cachedItem)
 				{
 					break;
 				}
 			}
+			trace.End();
 
-			var uriBuilder = new UriBuilder(uri);
-			if (!string.IsNullOrEmpty(_accessToken))
-			{
-				string accessTokenQuery = "access_token=" + _accessToken;
-				string mapsSkuToken = "sku=" + _getMapsSkuToken();
-				if (uriBuilder.Query != null && uriBuilder.Query.Length > 1)
-				{
-					uriBuilder.Query = uriBuilder.Query.Substring(1) + "&" + accessTokenQuery + "&" + mapsSkuToken;
-				}
-				else
-				{
-					uriBuilder.Query = accessTokenQuery + "&" + mapsSkuToken;
-				}
-			}
-			string finalUrl = uriBuilder.ToString();
+			string finalUrl = addAccessToken(uri);
 
 #if MAPBOX_DEBUG_CACHE
 			string methodName = _className + "." + new System.Diagnostics.StackFrame().GetMethod().Name;
@@ -162,6 +175,12 @@
 #if MAPBOX_DEBUG_CACHE
 				UnityEngine.Debug.LogFormat("{0} {1} {2} {3}", methodName, tilesetId, tileId, null != cachedItem.Data ? cachedItem.Data.Length.ToString() : "cachedItem.Data is NULL");
 #endif
+				// keep tiles found in slower caches, eg tile packs or the file cache, in the faster ones looked up before them
+				for (int i = 0; i < cacheIndex; i++)
+				{
+					_caches[i].Add(tilesetId, tileId, cachedItem, false);
+				}
+
 				// immediately return cached tile
 				callback(Response.FromCache(cachedItem.Data));
 
@@ -234,7 +253,65 @@
 		}
 
 
+		/// <summary>
+		/// Fetch a tile into the caches ahead of time, after all regular requests, see <see cref="TileRequestScheduler.PREFETCH_PRIORITY"/>.
+		/// A later <see cref="Request"/> for the tile is served from the cache or joins the running fetch.
+		/// </summary>
+		/// <returns>Null if the tile is cached already.</returns>
+		public IAsyncRequest Prefetch(
+			string uri
+			, Action<Response> callback
+			, int timeout
+			, CanonicalTileId tileId
+			, string tilesetId
+		)
+		{
+			if (string.IsNullOrEmpty(tilesetId))
+			{
+				throw new Exception("Cannot cache without a tileset id");
+			}
+
+			// 'Contains()' doesn't read the tile or count as a cache hit: prefetching must not disturb what gets evicted
+			foreach (var cache in _caches)
+			{
+				if (cache.Contains(tilesetId, tileId))
+				{
+					return null;
+				}
+			}
+
+			return _scheduler.Request(addAccessToken(uri), tilesetId, tileId, timeout, callback, true);
+		}
+
+
+		private string addAccessToken(string uri)
+		{
+			var uriBuilder = new UriBuilder(uri);
+			if (!string.IsNullOrEmpty(_accessToken))
+			{
+				string accessTokenQuery = "access_token=" + _accessToken;
+				string mapsSkuToken = "sku=" + _getMapsSkuToken();
+				if (uriBuilder.Query != null && uriBuilder.Query.Length > 1)
+				{
+					uriBuilder.Query = uriBuilder.Query.Substring(1) + "&" + accessTokenQuery + "&" + mapsSkuToken;
+				}
+				else
+				{
+					uriBuilder.Query = accessTokenQuery + "&" + mapsSkuToken;
+				}
+			}
+			return uriBuilder.ToString();
+		}
+
+
 		private IAsyncRequest requestTileAndCache(string url, string tilesetId, CanonicalTileId tileId, int timeout, Action<Response> callback)
+		{
+			// concurrent requests for the same tile are coalesced into one call of 'fetchAndCache'
+			return _scheduler.Request(url, tilesetId, tileId, timeout, callback);
+		}
+
+
+		private IAsyncRequest fetchAndCache(string url, string tilesetId, CanonicalTileId tileId, int timeout, Action<Response> callback)
 		{
 			return IAsyncRequestFactory.CreateRequest(
 				url,
@@ -262,7 +339,9 @@
 							lastModified = DateTime.ParseExact(r.Headers["Last-Modified"], "r", null);
 						}
 
-						// propagate to all caches forcing update
+						// propagate to all caches forcing update, compressed if the transport decompressed it:
+						// 'Response.DecompressedData' decompresses cached tiles when they are parsed
+						byte[] data = r.CompressedData ?? r.Data;
 						foreach (var cache in _caches)
 						{
 							cache.Add(
@@ -270,7 +349,7 @@
 								, tileId
 								, new CacheItem()
 								{
-									Data = r.Data,
+									Data = data,
 									ETag = eTag,
 									LastModified = lastModified
 								}
@@ -278,11 +357,8 @@
 							);
 						}
 					}
-					if (null != callback)
-					{
-						r.IsUpdate = true;
-						callback(r);
-					}
+					r.IsUpdate = true;
+					callback(r);
 				}, timeout);
 		}
 
@@ -34,6 +34,16 @@ namespace Mapbox.Platform.Cache
 		CacheItem Get(string tilesetId, CanonicalTileId tileId);
 
 
+		/// <summary>
+		/// Check if a tile is cached without reading it. Unlike 'Get' this doesn't count as a hit or miss
+		/// and doesn't change which tiles get evicted.
+		/// </summary>
+		/// <param name="tilesetId"></param>
+		/// <param name="tileId"></param>
+		/// <returns>True if the tile is in the cache</returns>
+		bool Contains(string tilesetId, CanonicalTileId tileId);
+
+
 		/// <summary>Clear cache for all tile sets</summary>
 		void Clear();
 
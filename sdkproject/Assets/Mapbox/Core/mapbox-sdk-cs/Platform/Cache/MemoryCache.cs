@@ -85,6 +85,17 @@ namespace Mapbox.Platform.Cache
 		}
 
 
+		public bool Contains(string tilesetId, CanonicalTileId tileId)
+		{
+			string key = tilesetId + "||" + tileId;
+
+			lock (_lock)
+			{
+				return _cachedResponses.ContainsKey(key);
+			}
+		}
+
+
 		public void Clear()
 		{
 			lock (_lock)
@@ -0,0 +1,144 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+	using System;
+	using System.Collections.Generic;
+
+
+	/// <summary>
+	/// <para>Serves tiles from caches only and never touches the network, eg to replay tiles recorded into a
+	/// <see cref="TilePackCache"/> in benchmarks or on machines without a connection.</para>
+	/// <para>Requests are answered synchronously, before <see cref="Request"/> returns. A tile that is in none of the
+	/// caches is answered with an error response.</para>
+	/// </summary>
+	public class OfflineFileSource : IFileSource, IDisposable
+	{
+
+
+		private bool _disposed;
+		private List<ICache> _caches = new List<ICache>();
+		private readonly object _lock = new object();
+		private long _hits;
+		private long _misses;
+
+
+		#region idisposable
+
+
+		~OfflineFileSource()
+		{
+			Dispose(false);
+		}
+
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources)
+				{
+					foreach (ICache cache in _caches)
+					{
+						IDisposable disposable = cache as IDisposable;
+						if (null != disposable) { disposable.Dispose(); }
+					}
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		/// <summary>Add a cache to look tiles up in, caches are looked up in the order they were added.</summary>
+		public OfflineFileSource AddCache(ICache cache)
+		{
+			_caches.Add(cache);
+			return this;
+		}
+
+
+		/// <summary>Requests answered from a cache.</summary>
+		public long Hits { get { lock (_lock) { return _hits; } } }
+
+
+		/// <summary>Requests for tiles in none of the caches.</summary>
+		public long Misses { get { lock (_lock) { return _misses; } } }
+
+
+		public IAsyncRequest Request(
+			string uri
+			, Action<Response> callback
+			, int timeout = 10
+			, CanonicalTileId tileId = new CanonicalTileId()
+			, string tilesetId = null
+		)
+		{
+			if (string.IsNullOrEmpty(tilesetId))
+			{
+				throw new Exception("Cannot look up a tile without a tileset id");
+			}
+
+			CacheItem cachedItem = null;
+			TileTraceTimer trace = TileTrace.Begin(TileTraceStage.Cache, tileId);
+			foreach (ICache cache in _caches)
+			{
+				cachedItem = cache.Get(tilesetId, tileId);
+				if (null != cachedItem) { break; }
+			}
+			trace.End();
+
+			OfflineRequest request = new OfflineRequest();
+			Response response;
+			if (null != cachedItem)
+			{
+				lock (_lock) { _hits++; }
+				response = Response.FromCache(cachedItem.Data);
+			}
+			else
+			{
+				lock (_lock) { _misses++; }
+				response = Response.FromHttpPipeline(
+					request
+					, uri
+					, null
+					, null
+					, null
+					, null
+					, new Exception(string.Format("tile {0} {1} is not available offline", tilesetId, tileId))
+				);
+			}
+
+			callback(response);
+			return request;
+		}
+
+
+		private class OfflineRequest : IAsyncRequest
+		{
+
+
+			public bool IsCompleted { get { return true; } }
+
+
+			public HttpRequestType RequestType { get { return HttpRequestType.Get; } }
+
+
+			public void Cancel()
+			{
+				// answered before it was returned, nothing to cancel
+			}
+		}
+
+
+	}
+}
@@ -361,21 +361,36 @@ lastmodified INTEGER,
 		/// <returns>True if tile exists</returns>
 		public bool TileExists(string tilesetName, CanonicalTileId tileId)
 		{
-			int? tilesetId = getTilesetId(tilesetName);
-			if (!tilesetId.HasValue)
+			return Contains(tilesetName, tileId);
+		}
+
+
+		/// <summary>
+		/// Probes the primary key index, the tile data isn't read.
+		/// </summary>
+		public bool Contains(string tilesetName, CanonicalTileId tileId)
+		{
+			try
 			{
+				int? tilesetId = getTilesetId(tilesetName);
+				if (!tilesetId.HasValue)
+				{
+					return false;
+				}
+
+				return 1 == _sqlite.ExecuteScalar<int>(
+					"SELECT 1 FROM tiles WHERE tile_set=? AND zoom_level=? AND tile_column=? AND tile_row=? LIMIT 1;"
+					, tilesetId.Value
+					, tileId.Z
+					, tileId.X
+					, tileId.Y
+				);
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("error looking up tile {1} {2} in cache{0}{3}", Environment.NewLine, tilesetName, tileId, ex);
 				return false;
 			}
-
-			return null != _sqlite
-				.Table<tiles>()
-				.Where(t =>
-					t.tile_set == tilesetId.Value
-					&& t.zoom_level == tileId.Z
-					&& t.tile_column == tileId.X
-					&& t.tile_row == tileId.Y
-					)
-				.FirstOrDefault();
 		}
 
 
@@ -0,0 +1,981 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using Mapbox.Utils;
+	using SQLite4Unity3d;
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Text;
+	using System.Threading;
+	using UnityEngine;
+
+
+	/// <summary>
+	/// <para>File cache with one SQLite database per tileset, so terrain, imagery and vector tiles don't contend for the same connection and lock.</para>
+	/// <para>Databases run in WAL mode. 'Get()' is served concurrently from a small pool of read-only connections,
+	/// 'Add()' only queues the tile. A background writer group-commits the queued tiles in one transaction per tileset
+	/// using prepared statements. Queued tiles are returned by 'Get()' until they are committed.</para>
+	/// <para>'Add()' never writes on the calling thread. If the writer falls behind, new tiles of a tileset with a full queue are
+	/// not cached, tiles already queued are still replaced.</para>
+	/// <para>Once 'MaxCacheSize' (summed over all tilesets) is exceeded the oldest tiles are evicted in small chunks after each commit.</para>
+	/// </summary>
+	public class SQLiteShardedCache : ICache, IDisposable
+	{
+
+
+		/// <summary>
+		/// maximum number tiles that get cached, over all tilesets
+		/// </summary>
+		public uint MaxCacheSize { get { return _maxTileCount; } }
+
+
+		private class PendingTile
+		{
+			public CacheItem Item;
+			public bool ReplaceIfExists;
+			public int Timestamp;
+		}
+
+
+		private class Reader
+		{
+			public SQLiteConnection Connection;
+			public IntPtr SelectTile;
+			public IntPtr SelectExists;
+		}
+
+
+		private class Shard
+		{
+			public string TilesetName;
+			public string DbPath;
+			public SQLiteConnection Writer;
+			public IntPtr InsertTile;
+			public IntPtr UpdateTile;
+			public IntPtr SelectOldest;
+			public IntPtr DeleteOldest;
+			/// <summary>committed tiles, only touched while holding '_writeLock'</summary>
+			public long TileCount;
+			/// <summary>guarded by 'lock(Readers)'</summary>
+			public bool Closed;
+			public readonly Stack<Reader> Readers = new Stack<Reader>();
+			/// <summary>tiles waiting for the next commit, guarded by 'lock(shard)'</summary>
+			public Dictionary<CanonicalTileId, PendingTile> Pending = new Dictionary<CanonicalTileId, PendingTile>();
+			/// <summary>tiles of the commit currently in progress, guarded by 'lock(shard)'</summary>
+			public Dictionary<CanonicalTileId, PendingTile> InFlight = new Dictionary<CanonicalTileId, PendingTile>();
+		}
+
+
+		/// <summary>wait that long after the first queued tile to collect more tiles into the same transaction</summary>
+		private const int GROUP_COMMIT_DELAY_MS = 50;
+		/// <summary>tiles queued per tileset, further tiles are dropped to bound memory if the writer can't keep up</summary>
+		private const int MAX_PENDING_TILES = 256;
+		/// <summary>maximum number of tiles deleted by one eviction statement</summary>
+		private const int EVICTION_CHUNK = 64;
+		/// <summary>idle read-only connections kept per tileset</summary>
+		private const int MAX_IDLE_READERS = 4;
+		/// <summary>SQLITE_TRANSIENT: sqlite copies bound values, required as managed arrays are only pinned for the duration of the call</summary>
+		private static readonly IntPtr SQLITE_TRANSIENT = new IntPtr(-1);
+
+		private const string SQL_CREATE_TILES = @"CREATE TABLE IF NOT EXISTS tiles(
+zoom_level   INTEGER NOT NULL,
+tile_column  BIGINT  NOT NULL,
+tile_row     BIGINT  NOT NULL,
+tile_data    BLOB    NOT NULL,
+timestamp    INTEGER NOT NULL,
+etag         TEXT,
+lastmodified INTEGER,
+	PRIMARY KEY(
+		zoom_level ASC,
+		tile_column ASC,
+		tile_row ASC
+	)
+);";
+		private const string SQL_CREATE_IDX_TIMESTAMP = "CREATE INDEX IF NOT EXISTS idx_timestamp ON tiles (timestamp ASC);";
+		// same parameter numbers for insert and update, so both can be bound by 'executeTile()'
+		private const string SQL_INSERT_TILE = "INSERT OR IGNORE INTO tiles (zoom_level, tile_column, tile_row, tile_data, timestamp, etag, lastmodified) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7);";
+		private const string SQL_UPDATE_TILE = "UPDATE tiles SET tile_data=?4, timestamp=?5, etag=?6, lastmodified=?7 WHERE zoom_level=?1 AND tile_column=?2 AND tile_row=?3;";
+		private const string SQL_SELECT_TILE = "SELECT tile_data, timestamp, etag, lastmodified FROM tiles WHERE zoom_level=?1 AND tile_column=?2 AND tile_row=?3;";
+		private const string SQL_SELECT_EXISTS = "SELECT 1 FROM tiles WHERE zoom_level=?1 AND tile_column=?2 AND tile_row=?3;";
+		private const string SQL_SELECT_OLDEST = "SELECT timestamp FROM tiles ORDER BY timestamp ASC LIMIT 1;";
+		private const string SQL_DELETE_OLDEST = "DELETE FROM tiles WHERE rowid IN ( SELECT rowid FROM tiles ORDER BY timestamp ASC LIMIT ?1 );";
+
+
+#if MAPBOX_DEBUG_CACHE
+		private string _className;
+#endif
+		private bool _disposed;
+		private bool _closed;
+		private string _dbName;
+		private readonly uint _maxTileCount;
+		private Dictionary<string, Shard> _shards = new Dictionary<string, Shard>();
+		private object _shardsLock = new object();
+		/// <summary>serializes everything that uses the writer connections: commits, eviction, clearing</summary>
+		private object _writeLock = new object();
+		private Thread _writerThread;
+		private AutoResetEvent _writeSignal = new AutoResetEvent(false);
+		private volatile bool _stopWriter;
+		/// <summary>set by 'Add()' when a queue is full: the writer skips the group commit delay</summary>
+		private volatile bool _writeBacklog;
+
+
+		public SQLiteShardedCache(uint? maxTileCount = null, string dbName = "cache.db")
+		{
+			_maxTileCount = maxTileCount ?? 3000;
+			_dbName = dbName;
+#if MAPBOX_DEBUG_CACHE
+			_className = this.GetType().Name;
+#endif
+			startWriter();
+		}
+
+
+		#region idisposable
+
+
+		~SQLiteShardedCache()
+		{
+			Dispose(false);
+		}
+
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources)
+				{
+					stopWriter();
+					// commit whatever is still queued
+					Flush();
+					lock (_writeLock)
+					{
+						closeShards();
+					}
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		/// <summary>
+		/// Database file of one tileset: '&lt;dbName&gt;-&lt;tileset&gt;-&lt;hash&gt;.db' in the cache directory.
+		/// </summary>
+		public static string GetFullDbPath(string dbName, string tilesetName)
+		{
+			return SQLiteCache.GetFullDbPath(shardFilePrefix(dbName) + sanitize(tilesetName) + "-" + fnv1a(tilesetName).ToString("x8") + Path.GetExtension(dbName));
+		}
+
+
+		public void Add(string tilesetName, CanonicalTileId tileId, CacheItem item, bool replaceIfExists)
+		{
+#if MAPBOX_DEBUG_CACHE
+			string methodName = _className + "." + new System.Diagnostics.StackFrame().GetMethod().Name;
+			UnityEngine.Debug.LogFormat("{0} {1} {2} replaceIfExists:{3}", methodName, tilesetName, tileId, replaceIfExists);
+#endif
+			Shard shard = getShard(tilesetName);
+			if (null == shard) { return; }
+
+			lock (shard)
+			{
+				bool queued = shard.Pending.ContainsKey(tileId);
+				// tile already queued and we don't want to overwrite -> exit early
+				if (!replaceIfExists && queued) { return; }
+
+				// writer can't keep up: don't block the caller with a commit, replace queued tiles but drop new ones.
+				// a dropped tile is just a cache miss later on
+				if (!queued && shard.Pending.Count >= MAX_PENDING_TILES)
+				{
+#if MAPBOX_DEBUG_CACHE
+					UnityEngine.Debug.LogFormat("{0} queue of {1} full, dropping {2}", methodName, tilesetName, tileId);
+#endif
+					_writeBacklog = true;
+					_writeSignal.Set();
+					return;
+				}
+
+				shard.Pending[tileId] = new PendingTile
+				{
+					Item = item,
+					ReplaceIfExists = replaceIfExists,
+					Timestamp = (int)UnixTimestampUtils.To(DateTime.Now)
+				};
+			}
+
+			_writeSignal.Set();
+		}
+
+
+		/// <summary>
+		/// Returns the tile data, otherwise null
+		/// </summary>
+		/// <param name="tileId">Canonical tile id to identify the tile</param>
+		/// <returns>tile data as byte[], if tile is not cached returns null</returns>
+		public CacheItem Get(string tilesetName, CanonicalTileId tileId)
+		{
+#if MAPBOX_DEBUG_CACHE
+			string methodName = _className + "." + new System.Diagnostics.StackFrame().GetMethod().Name;
+			Debug.LogFormat("{0} {1} {2}", methodName, tilesetName, tileId);
+#endif
+			Shard shard = getShard(tilesetName);
+			if (null == shard) { return null; }
+
+			PendingTile pending;
+			lock (shard)
+			{
+				if (shard.Pending.TryGetValue(tileId, out pending) || shard.InFlight.TryGetValue(tileId, out pending))
+				{
+					return new CacheItem()
+					{
+						Data = pending.Item.Data,
+						AddedToCacheTicksUtc = pending.Timestamp,
+						ETag = pending.Item.ETag,
+						LastModified = pending.Item.LastModified
+					};
+				}
+			}
+
+			Reader reader = null;
+			try
+			{
+				reader = rentReader(shard);
+				IntPtr stmt = reader.SelectTile;
+				try
+				{
+					SQLite3.BindInt(stmt, 1, tileId.Z);
+					SQLite3.BindInt64(stmt, 2, tileId.X);
+					SQLite3.BindInt64(stmt, 3, tileId.Y);
+
+					SQLite3.Result result = SQLite3.Step(stmt);
+					if (SQLite3.Result.Done == result) { return null; }
+					if (SQLite3.Result.Row != result)
+					{
+						throw SQLiteException.New(result, SQLite3.GetErrmsg(reader.Connection.Handle));
+					}
+
+					DateTime? lastModified = null;
+					if (SQLite3.ColType.Null != SQLite3.ColumnType(stmt, 3))
+					{
+						lastModified = UnixTimestampUtils.From((double)SQLite3.ColumnInt64(stmt, 3));
+					}
+
+					return new CacheItem()
+					{
+						Data = SQLite3.ColumnByteArray(stmt, 0),
+						AddedToCacheTicksUtc = SQLite3.ColumnInt64(stmt, 1),
+						ETag = SQLite3.ColType.Null == SQLite3.ColumnType(stmt, 2) ? null : SQLite3.ColumnString(stmt, 2),
+						LastModified = lastModified
+					};
+				}
+				finally
+				{
+					SQLite3.Reset(stmt);
+				}
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("error getting tile {1} {2} from cache{0}{3}", Environment.NewLine, tilesetName, tileId, ex);
+				// don't hand out a connection in an unknown state again
+				closeReader(reader);
+				reader = null;
+				return null;
+			}
+			finally
+			{
+				returnReader(shard, reader);
+			}
+		}
+
+
+		/// <summary>
+		/// Check if a tile is queued or committed. Probes the primary key index, the tile data isn't read.
+		/// </summary>
+		public bool Contains(string tilesetName, CanonicalTileId tileId)
+		{
+			Shard shard = getShard(tilesetName);
+			if (null == shard) { return false; }
+
+			lock (shard)
+			{
+				if (shard.Pending.ContainsKey(tileId) || shard.InFlight.ContainsKey(tileId)) { return true; }
+			}
+
+			Reader reader = null;
+			try
+			{
+				reader = rentReader(shard);
+				IntPtr stmt = reader.SelectExists;
+				try
+				{
+					SQLite3.BindInt(stmt, 1, tileId.Z);
+					SQLite3.BindInt64(stmt, 2, tileId.X);
+					SQLite3.BindInt64(stmt, 3, tileId.Y);
+
+					SQLite3.Result result = SQLite3.Step(stmt);
+					if (SQLite3.Result.Row != result && SQLite3.Result.Done != result)
+					{
+						throw SQLiteException.New(result, SQLite3.GetErrmsg(reader.Connection.Handle));
+					}
+					return SQLite3.Result.Row == result;
+				}
+				finally
+				{
+					SQLite3.Reset(stmt);
+				}
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("error looking up tile {1} {2} in cache{0}{3}", Environment.NewLine, tilesetName, tileId, ex);
+				closeReader(reader);
+				reader = null;
+				return false;
+			}
+			finally
+			{
+				returnReader(shard, reader);
+			}
+		}
+
+
+		/// <summary>
+		/// Commit all queued tiles and evict the oldest tiles if the cache has grown beyond 'MaxCacheSize'.
+		/// <para>Called by the background writer, call explicitly to make sure tiles are on disk.</para>
+		/// </summary>
+		public void Flush()
+		{
+			lock (_writeLock)
+			{
+				List<Shard> shards = snapshotShards();
+				if (0 == shards.Count) { return; }
+
+				foreach (Shard shard in shards)
+				{
+					commitPending(shard);
+				}
+
+				evict(shards);
+			}
+		}
+
+
+		/// <summary>
+		/// FOR INTERNAL DEBUGGING ONLY - DON'T RELY ON IN PRODUCTION
+		/// </summary>
+		/// <param name="tilesetName"></param>
+		/// <returns></returns>
+		public long TileCount(string tilesetName)
+		{
+			Shard shard = getShard(tilesetName);
+			if (null == shard) { return 0; }
+
+			Flush();
+			lock (_writeLock)
+			{
+				return shard.TileCount;
+			}
+		}
+
+
+		/// <summary>
+		/// Clear cache for one tile set
+		/// </summary>
+		/// <param name="tilesetName"></param>
+		public void Clear(string tilesetName)
+		{
+			Shard shard = getShard(tilesetName);
+			if (null == shard) { return; }
+
+			lock (_writeLock)
+			{
+				lock (shard)
+				{
+					shard.Pending.Clear();
+				}
+
+				try
+				{
+					shard.Writer.Execute("DELETE FROM tiles;");
+					shard.TileCount = 0;
+					pragma(shard.Writer, "PRAGMA incremental_vacuum;");
+				}
+				catch (Exception ex)
+				{
+					Debug.LogErrorFormat("could not clear tileset [{0}]: {1}", tilesetName, ex);
+				}
+			}
+		}
+
+
+		/// <summary>
+		/// <para>Delete the database files of all tilesets, including tilesets not used in this session.</para>
+		/// <para>Call 'ReInit()' if you intend to continue using the cache after 'Clear()!</para>
+		/// </summary>
+		public void Clear()
+		{
+			//already cleared or disposed
+			if (_closed || _disposed) { return; }
+
+			stopWriter();
+			lock (_writeLock)
+			{
+				closeShards();
+			}
+
+			string prefix = shardFilePrefix(_dbName);
+			string cacheDirectory = Path.GetDirectoryName(SQLiteCache.GetFullDbPath(_dbName));
+			foreach (string file in Directory.GetFiles(cacheDirectory, prefix + "*"))
+			{
+				Debug.LogFormat("deleting {0}", file);
+				deleteFile(file);
+			}
+		}
+
+
+		/// <summary>
+		/// <para>Reinitialize cache.</para>
+		/// <para>This is needed after 'Clear()', databases are reopened lazily per tileset.</para>
+		/// </summary>
+		public void ReInit()
+		{
+			if (_disposed) { return; }
+
+			if (!_closed)
+			{
+				stopWriter();
+				Flush();
+				lock (_writeLock)
+				{
+					closeShards();
+				}
+			}
+
+			lock (_shardsLock)
+			{
+				_closed = false;
+			}
+			startWriter();
+		}
+
+
+		#region writer
+
+
+		private void startWriter()
+		{
+			_stopWriter = false;
+			_writerThread = new Thread(writerLoop);
+			_writerThread.Name = "MapboxSQLiteCacheWriter";
+			_writerThread.IsBackground = true;
+			_writerThread.Start();
+		}
+
+
+		private void stopWriter()
+		{
+			if (null == _writerThread) { return; }
+
+			_stopWriter = true;
+			_writeSignal.Set();
+			_writerThread.Join();
+			_writerThread = null;
+		}
+
+
+		private void writerLoop()
+		{
+			while (true)
+			{
+				_writeSignal.WaitOne();
+				if (_stopWriter) { return; }
+
+				// during a fly-over tiles arrive in bursts: give them a moment to end up in the same transaction.
+				// no point waiting if tiles are already being dropped
+				if (!_writeBacklog)
+				{
+					Thread.Sleep(GROUP_COMMIT_DELAY_MS);
+				}
+				_writeBacklog = false;
+
+				try
+				{
+					Flush();
+				}
+				catch (Exception ex)
+				{
+					Debug.LogErrorFormat("error flushing tile cache: {0}", ex);
+				}
+			}
+		}
+
+
+		/// <summary>
+		/// Writes the queued tiles of one tileset in a single transaction.
+		/// Must be called while holding '_writeLock'.
+		/// </summary>
+		private void commitPending(Shard shard)
+		{
+			lock (shard)
+			{
+				if (0 == shard.Pending.Count) { return; }
+
+				// swap buffers: 'InFlight' is empty at this point, 'Get()' keeps finding the tiles there until they are committed
+				Dictionary<CanonicalTileId, PendingTile> swap = shard.InFlight;
+				shard.InFlight = shard.Pending;
+				shard.Pending = swap;
+			}
+
+			SQLiteConnection db = shard.Writer;
+			long inserted = 0;
+			try
+			{
+				db.Execute("BEGIN IMMEDIATE;");
+				foreach (KeyValuePair<CanonicalTileId, PendingTile> pending in shard.InFlight)
+				{
+					// 'INSERT OR REPLACE' would not tell us if the tile count changed: insert and update if it wasn't new
+					if (1 == executeTile(db, shard.InsertTile, pending.Key, pending.Value))
+					{
+						inserted++;
+					}
+					else if (pending.Value.ReplaceIfExists)
+					{
+						executeTile(db, shard.UpdateTile, pending.Key, pending.Value);
+					}
+				}
+				db.Execute("COMMIT;");
+				shard.TileCount += inserted;
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("Error inserting {0} tiles into [{1}]: {2}", shard.InFlight.Count, shard.TilesetName, ex);
+				try
+				{
+					db.Execute("ROLLBACK;");
+				}
+				catch (Exception rollbackEx)
+				{
+					Debug.LogErrorFormat("Error rolling back [{0}]: {1}", shard.DbPath, rollbackEx);
+				}
+				try
+				{
+					shard.TileCount = db.ExecuteScalar<long>("SELECT COUNT(zoom_level) FROM tiles");
+				}
+				catch (Exception countEx)
+				{
+					// keep the tracked count, eviction catches up once the database is usable again
+					Debug.LogErrorFormat("Error counting tiles of [{0}]: {1}", shard.DbPath, countEx);
+				}
+			}
+			finally
+			{
+				lock (shard)
+				{
+					shard.InFlight.Clear();
+				}
+			}
+		}
+
+
+		private int executeTile(SQLiteConnection db, IntPtr stmt, CanonicalTileId tileId, PendingTile pending)
+		{
+			try
+			{
+				SQLite3.BindInt(stmt, 1, tileId.Z);
+				SQLite3.BindInt64(stmt, 2, tileId.X);
+				SQLite3.BindInt64(stmt, 3, tileId.Y);
+				SQLite3.BindBlob(stmt, 4, pending.Item.Data, pending.Item.Data.Length, SQLITE_TRANSIENT);
+				SQLite3.BindInt(stmt, 5, pending.Timestamp);
+				if (null == pending.Item.ETag)
+				{
+					SQLite3.BindNull(stmt, 6);
+				}
+				else
+				{
+					SQLite3.BindText(stmt, 6, pending.Item.ETag, -1, SQLITE_TRANSIENT);
+				}
+				if (pending.Item.LastModified.HasValue)
+				{
+					SQLite3.BindInt64(stmt, 7, (long)UnixTimestampUtils.To(pending.Item.LastModified.Value));
+				}
+				else
+				{
+					SQLite3.BindNull(stmt, 7);
+				}
+
+				SQLite3.Result result = SQLite3.Step(stmt);
+				if (SQLite3.Result.Done != result)
+				{
+					throw SQLiteException.New(result, SQLite3.GetErrmsg(db.Handle));
+				}
+				return SQLite3.Changes(db.Handle);
+			}
+			finally
+			{
+				SQLite3.Reset(stmt);
+			}
+		}
+
+
+		/// <summary>
+		/// Deletes the oldest tiles, in chunks of 'EVICTION_CHUNK', until all tilesets together fit into 'MaxCacheSize' again.
+		/// Uses the tracked tile counts, no 'COUNT()' query. Must be called while holding '_writeLock'.
+		/// </summary>
+		private void evict(List<Shard> shards)
+		{
+			long total = 0;
+			foreach (Shard shard in shards) { total += shard.TileCount; }
+
+			while (total > _maxTileCount)
+			{
+				// evict from the tileset holding the oldest tile
+				Shard oldest = null;
+				long oldestTimestamp = long.MaxValue;
+				foreach (Shard shard in shards)
+				{
+					if (0 == shard.TileCount) { continue; }
+					long timestamp = selectOldestTimestamp(shard);
+					if (timestamp < oldestTimestamp)
+					{
+						oldestTimestamp = timestamp;
+						oldest = shard;
+					}
+				}
+				if (null == oldest) { return; }
+
+				int deleted = 0;
+				IntPtr stmt = oldest.DeleteOldest;
+				try
+				{
+					SQLite3.BindInt64(stmt, 1, Math.Min(total - _maxTileCount, EVICTION_CHUNK));
+					SQLite3.Result result = SQLite3.Step(stmt);
+					if (SQLite3.Result.Done != result)
+					{
+						throw SQLiteException.New(result, SQLite3.GetErrmsg(oldest.Writer.Handle));
+					}
+					deleted = SQLite3.Changes(oldest.Writer.Handle);
+				}
+				catch (Exception ex)
+				{
+					Debug.LogErrorFormat("error pruning: {0}", ex);
+					return;
+				}
+				finally
+				{
+					SQLite3.Reset(stmt);
+				}
+
+				if (0 == deleted) { return; }
+				oldest.TileCount -= deleted;
+				total -= deleted;
+				// return the freed pages to the file system, no full 'VACUUM' needed
+				pragma(oldest.Writer, "PRAGMA incremental_vacuum;");
+			}
+		}
+
+
+		private long selectOldestTimestamp(Shard shard)
+		{
+			IntPtr stmt = shard.SelectOldest;
+			try
+			{
+				return SQLite3.Result.Row == SQLite3.Step(stmt) ? SQLite3.ColumnInt64(stmt, 0) : long.MaxValue;
+			}
+			finally
+			{
+				SQLite3.Reset(stmt);
+			}
+		}
+
+
+		#endregion
+
+
+		#region shards
+
+
+		private Shard getShard(string tilesetName)
+		{
+			lock (_shardsLock)
+			{
+				if (_disposed || _closed) { return null; }
+
+				Shard shard;
+				if (_shards.TryGetValue(tilesetName, out shard)) { return shard; }
+
+				try
+				{
+					shard = openShard(tilesetName);
+				}
+				catch (Exception ex)
+				{
+					Debug.LogErrorFormat("could not open cache database for [{0}]: {1}", tilesetName, ex);
+					return null;
+				}
+				_shards.Add(tilesetName, shard);
+				return shard;
+			}
+		}
+
+
+		private Shard openShard(string tilesetName)
+		{
+			Shard shard = new Shard();
+			shard.TilesetName = tilesetName;
+			shard.DbPath = GetFullDbPath(_dbName, tilesetName);
+			shard.Writer = new SQLiteConnection(shard.DbPath, SQLiteOpenFlags.ReadWrite | SQLiteOpenFlags.Create);
+
+			try
+			{
+				// has to be set before the first table is created, no-op for existing databases
+				pragma(shard.Writer, "PRAGMA auto_vacuum=INCREMENTAL;");
+				shard.Writer.Execute(SQL_CREATE_TILES);
+				shard.Writer.Execute(SQL_CREATE_IDX_TIMESTAMP);
+
+				// readers don't block the writer and vice versa. 'synchronous=NORMAL' is safe in WAL mode:
+				// a crash may lose the last commits but doesn't corrupt the database
+				string journalMode = pragma(shard.Writer, "PRAGMA journal_mode=WAL;");
+				if (!"wal".Equals(journalMode, StringComparison.OrdinalIgnoreCase))
+				{
+					Debug.LogWarningFormat("WAL not supported for [{0}], journal mode: {1}", shard.DbPath, journalMode);
+				}
+				pragma(shard.Writer, "PRAGMA synchronous=NORMAL;");
+				pragma(shard.Writer, "PRAGMA temp_store=MEMORY;");
+
+				IntPtr handle = shard.Writer.Handle;
+				shard.InsertTile = SQLite3.Prepare2(handle, SQL_INSERT_TILE);
+				shard.UpdateTile = SQLite3.Prepare2(handle, SQL_UPDATE_TILE);
+				shard.SelectOldest = SQLite3.Prepare2(handle, SQL_SELECT_OLDEST);
+				shard.DeleteOldest = SQLite3.Prepare2(handle, SQL_DELETE_OLDEST);
+
+				// the only full count: from here on the count is tracked on insert and eviction
+				shard.TileCount = shard.Writer.ExecuteScalar<long>("SELECT COUNT(zoom_level) FROM tiles");
+			}
+			catch
+			{
+				closeShard(shard);
+				throw;
+			}
+
+			return shard;
+		}
+
+
+		private List<Shard> snapshotShards()
+		{
+			lock (_shardsLock)
+			{
+				return new List<Shard>(_shards.Values);
+			}
+		}
+
+
+		/// <summary>
+		/// Close all databases. Must be called while holding '_writeLock'.
+		/// </summary>
+		private void closeShards()
+		{
+			List<Shard> shards;
+			lock (_shardsLock)
+			{
+				shards = new List<Shard>(_shards.Values);
+				_shards.Clear();
+				_closed = true;
+			}
+
+			foreach (Shard shard in shards)
+			{
+				// fold the WAL back into the database so it doesn't linger on disk
+				pragma(shard.Writer, "PRAGMA wal_checkpoint(TRUNCATE);");
+				closeShard(shard);
+			}
+		}
+
+
+		private void closeShard(Shard shard)
+		{
+			lock (shard.Readers)
+			{
+				shard.Closed = true;
+				while (shard.Readers.Count > 0)
+				{
+					closeReader(shard.Readers.Pop());
+				}
+			}
+
+			finalize(ref shard.InsertTile);
+			finalize(ref shard.UpdateTile);
+			finalize(ref shard.SelectOldest);
+			finalize(ref shard.DeleteOldest);
+
+			try
+			{
+				shard.Writer.Close();
+				shard.Writer.Dispose();
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("error closing [{0}]: {1}", shard.DbPath, ex);
+			}
+		}
+
+
+		private Reader rentReader(Shard shard)
+		{
+			lock (shard.Readers)
+			{
+				if (shard.Readers.Count > 0) { return shard.Readers.Pop(); }
+			}
+
+			Reader reader = new Reader();
+			reader.Connection = new SQLiteConnection(shard.DbPath, SQLiteOpenFlags.ReadOnly);
+			try
+			{
+				reader.SelectTile = SQLite3.Prepare2(reader.Connection.Handle, SQL_SELECT_TILE);
+				reader.SelectExists = SQLite3.Prepare2(reader.Connection.Handle, SQL_SELECT_EXISTS);
+			}
+			catch
+			{
+				closeReader(reader);
+				throw;
+			}
+			return reader;
+		}
+
+
+		private void returnReader(Shard shard, Reader reader)
+		{
+			if (null == reader) { return; }
+
+			lock (shard.Readers)
+			{
+				// shard might have been closed while the reader was in use
+				if (!shard.Closed && shard.Readers.Count < MAX_IDLE_READERS)
+				{
+					shard.Readers.Push(reader);
+					return;
+				}
+			}
+			closeReader(reader);
+		}
+
+
+		private void closeReader(Reader reader)
+		{
+			if (null == reader) { return; }
+
+			finalize(ref reader.SelectTile);
+			finalize(ref reader.SelectExists);
+			try
+			{
+				reader.Connection.Close();
+				reader.Connection.Dispose();
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("error closing reader: {0}", ex);
+			}
+		}
+
+
+		#endregion
+
+
+		#region helper methods
+
+
+		/// <summary>
+		/// Execute a pragma that may or may not return a row, see workaround in 'SQLiteCache.init()'.
+		/// </summary>
+		private static string pragma(SQLiteConnection db, string cmd)
+		{
+			try
+			{
+				return db.ExecuteScalar<string>(cmd);
+			}
+			catch (SQLiteException ex)
+			{
+				Debug.LogErrorFormat("{0}: {1}", cmd, ex);
+				return null;
+			}
+		}
+
+
+		private static void finalize(ref IntPtr stmt)
+		{
+			if (IntPtr.Zero == stmt) { return; }
+			SQLite3.Finalize(stmt);
+			stmt = IntPtr.Zero;
+		}
+
+
+		private static void deleteFile(string file)
+		{
+			// try several times in case SQLite needs a bit more time to dispose
+			for (int i = 0; i < 5; i++)
+			{
+				try
+				{
+					File.Delete(file);
+					return;
+				}
+				catch
+				{
+#if !WINDOWS_UWP
+					System.Threading.Thread.Sleep(100);
+#else
+					System.Threading.Tasks.Task.Delay(100).Wait();
+#endif
+				}
+			}
+
+			// if we got till here, throw on last try
+			File.Delete(file);
+		}
+
+
+		private static string shardFilePrefix(string dbName)
+		{
+			return Path.GetFileNameWithoutExtension(dbName) + "-";
+		}
+
+
+		/// <summary>keep tileset names readable in the file name but strip everything that's not safe on all platforms</summary>
+		private static string sanitize(string tilesetName)
+		{
+			StringBuilder sb = new StringBuilder(tilesetName.Length);
+			foreach (char c in tilesetName)
+			{
+				bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '.' || c == '_';
+				sb.Append(safe ? c : '_');
+				if (sb.Length >= 48) { break; }
+			}
+			return sb.ToString();
+		}
+
+
+		/// <summary>stable across runtimes, unlike 'string.GetHashCode()'. Keeps sanitized names that collide apart.</summary>
+		private static uint fnv1a(string text)
+		{
+			uint hash = 2166136261;
+			foreach (char c in text)
+			{
+				hash = (hash ^ c) * 16777619;
+			}
+			return hash;
+		}
+
+
+		#endregion
+
+
+	}
+}
@@ -0,0 +1,432 @@
+using Mapbox.Map;
+using System;
+using System.Collections.Generic;
+
+
+namespace Mapbox.Platform.Cache
+{
+
+
+	public enum TileMemoryCachePolicy
+	{
+		/// <summary>Least recently used tile gets evicted.</summary>
+		Lru,
+		/// <summary>
+		/// Adaptive Replacement Cache: balances recently and frequently used tiles and remembers recently evicted tiles,
+		/// so a single fly-over doesn't flush tiles that are requested over and over.
+		/// </summary>
+		Arc
+	}
+
+
+	/// <summary>
+	/// <para>In memory tile cache with O(1) lookup, touch and eviction, drop-in replacement for <see cref="MemoryCache"/>.</para>
+	/// <para>Bounded by bytes as well as by number of tiles so small vector tiles and large retina rasters are weighted correctly.</para>
+	/// <para>Tiles are keyed by an interned tileset handle and the tile id, no string concatenation per lookup.</para>
+	/// </summary>
+	public class TileMemoryCache : ICache
+	{
+
+
+		/// <summary>estimated per tile overhead of entry, dictionary slot and CacheItem on top of the raw data</summary>
+		private const long ENTRY_OVERHEAD_BYTES = 128;
+
+
+		private struct TileKey : IEquatable<TileKey>
+		{
+			public readonly int Tileset;
+			public readonly CanonicalTileId TileId;
+
+			public TileKey(int tileset, CanonicalTileId tileId)
+			{
+				Tileset = tileset;
+				TileId = tileId;
+			}
+
+			public bool Equals(TileKey other)
+			{
+				return Tileset == other.Tileset && TileId.Equals(other.TileId);
+			}
+
+			public override bool Equals(object obj)
+			{
+				return obj is TileKey && Equals((TileKey)obj);
+			}
+
+			public override int GetHashCode()
+			{
+				return (Tileset * 397) ^ TileId.GetHashCode();
+			}
+		}
+
+
+		private class Entry
+		{
+			public TileKey Key;
+			/// <summary>null for ghost entries (ARC's B1 and B2): evicted, only the key is remembered</summary>
+			public CacheItem Item;
+			public long Bytes;
+			public EntryList List;
+			public Entry Prev;
+			public Entry Next;
+		}
+
+
+		/// <summary> Intrusive doubly linked list, head is the most recently used entry. </summary>
+		private class EntryList
+		{
+			public Entry Head;
+			public Entry Tail;
+			public int Count;
+			public long Bytes;
+
+			public void AddFirst(Entry entry)
+			{
+				entry.List = this;
+				entry.Prev = null;
+				entry.Next = Head;
+				if (null != Head) { Head.Prev = entry; }
+				Head = entry;
+				if (null == Tail) { Tail = entry; }
+				Count++;
+				Bytes += entry.Bytes;
+			}
+
+			public void Remove(Entry entry)
+			{
+				if (null != entry.Prev) { entry.Prev.Next = entry.Next; } else { Head = entry.Next; }
+				if (null != entry.Next) { entry.Next.Prev = entry.Prev; } else { Tail = entry.Prev; }
+				entry.Prev = null;
+				entry.Next = null;
+				entry.List = null;
+				Count--;
+				Bytes -= entry.Bytes;
+			}
+
+			public void Clear()
+			{
+				Head = null;
+				Tail = null;
+				Count = 0;
+				Bytes = 0;
+			}
+		}
+
+
+		public TileMemoryCache(uint maxCacheSize, long maxCacheBytes, TileMemoryCachePolicy policy = TileMemoryCachePolicy.Arc)
+		{
+#if MAPBOX_DEBUG_CACHE
+			_className = this.GetType().Name;
+#endif
+			_maxCacheSize = maxCacheSize;
+			_maxCacheBytes = maxCacheBytes > 0 ? maxCacheBytes : long.MaxValue;
+			_policy = policy;
+		}
+
+
+#if MAPBOX_DEBUG_CACHE
+		private string _className;
+#endif
+		private uint _maxCacheSize;
+		private long _maxCacheBytes;
+		private TileMemoryCachePolicy _policy;
+		private object _lock = new object();
+		private Dictionary<string, int> _tilesetHandles = new Dictionary<string, int>();
+		private Dictionary<TileKey, Entry> _entries = new Dictionary<TileKey, Entry>();
+		// LRU only uses '_t1'. ARC: T1 seen once recently, T2 seen at least twice, B1/B2 ghosts of evicted T1/T2 entries
+		private EntryList _t1 = new EntryList();
+		private EntryList _t2 = new EntryList();
+		private EntryList _b1 = new EntryList();
+		private EntryList _b2 = new EntryList();
+		/// <summary>ARC's adaptive target size of T1 in bytes</summary>
+		private long _p;
+		private long _hits;
+		private long _misses;
+		private long _evictions;
+
+
+		/// <summary> Maximum number of tiles. </summary>
+		public uint MaxCacheSize { get { return _maxCacheSize; } }
+
+		/// <summary> Maximum number of bytes (tile data plus estimated overhead), long.MaxValue if unbounded. </summary>
+		public long MaxCacheBytes { get { return _maxCacheBytes; } }
+
+		public TileMemoryCachePolicy Policy { get { return _policy; } }
+
+		/// <summary> Number of tiles currently cached. </summary>
+		public int Count { get { lock (_lock) { return _t1.Count + _t2.Count; } } }
+
+		/// <summary> Bytes currently used, see <see cref="MaxCacheBytes"/>. </summary>
+		public long Bytes { get { lock (_lock) { return _t1.Bytes + _t2.Bytes; } } }
+
+		/// <summary> Number of 'Get()' calls that returned a tile. </summary>
+		public long Hits { get { lock (_lock) { return _hits; } } }
+
+		/// <summary> Number of 'Get()' calls that returned null. </summary>
+		public long Misses { get { lock (_lock) { return _misses; } } }
+
+		/// <summary> Number of tiles evicted to stay within budget. </summary>
+		public long Evictions { get { lock (_lock) { return _evictions; } } }
+
+
+		public void ReInit()
+		{
+			Clear();
+		}
+
+
+		public void Add(string tilesetId, CanonicalTileId tileId, CacheItem item, bool replaceIfExists)
+		{
+			if (null == item || null == item.Data) { return; }
+
+			long bytes = item.Data.Length + ENTRY_OVERHEAD_BYTES;
+
+			lock (_lock)
+			{
+				TileKey key = new TileKey(getTilesetHandle(tilesetId, true), tileId);
+
+				Entry entry;
+				if (_entries.TryGetValue(key, out entry) && null != entry.Item)
+				{
+					if (replaceIfExists)
+					{
+						entry.List.Bytes += bytes - entry.Bytes;
+						entry.Bytes = bytes;
+						entry.Item = item;
+						item.AddedToCacheTicksUtc = DateTime.UtcNow.Ticks;
+					}
+					touch(entry);
+					evictToBudget(false);
+					return;
+				}
+
+				// tiles larger than the whole budget would just flush everything else
+				if (bytes > _maxCacheBytes || 0 == _maxCacheSize) { return; }
+
+				item.AddedToCacheTicksUtc = DateTime.UtcNow.Ticks;
+
+				if (null == entry)
+				{
+					entry = new Entry();
+					entry.Key = key;
+					entry.Item = item;
+					entry.Bytes = bytes;
+					_entries.Add(key, entry);
+					_t1.AddFirst(entry);
+					evictToBudget(false);
+					trimGhosts();
+					return;
+				}
+
+				// ghost hit: the tile was evicted not long ago, adapt ARC's target towards the list it was evicted from
+				bool wasInB2 = entry.List == _b2;
+				if (entry.List == _b1)
+				{
+					long delta = _b1.Bytes >= _b2.Bytes || 0 == _b1.Bytes ? bytes : bytes * (_b2.Bytes / _b1.Bytes);
+					_p = Math.Min(capacityBytes(), _p + delta);
+				}
+				else
+				{
+					long delta = _b2.Bytes >= _b1.Bytes || 0 == _b2.Bytes ? bytes : bytes * (_b1.Bytes / _b2.Bytes);
+					_p = Math.Max(0, _p - delta);
+				}
+				entry.List.Remove(entry);
+				entry.Item = item;
+				entry.Bytes = bytes;
+				_t2.AddFirst(entry);
+				evictToBudget(wasInB2);
+				trimGhosts();
+			}
+		}
+
+
+		public CacheItem Get(string tilesetId, CanonicalTileId tileId)
+		{
+#if MAPBOX_DEBUG_CACHE
+			string methodName = _className + "." + new System.Diagnostics.StackFrame().GetMethod().Name;
+			UnityEngine.Debug.LogFormat("{0} {1} {2}", methodName, tilesetId, tileId);
+#endif
+
+			lock (_lock)
+			{
+				int tileset = getTilesetHandle(tilesetId, false);
+				Entry entry;
+				if (tileset < 0 || !_entries.TryGetValue(new TileKey(tileset, tileId), out entry) || null == entry.Item)
+				{
+					_misses++;
+					return null;
+				}
+
+				_hits++;
+				touch(entry);
+				return entry.Item;
+			}
+		}
+
+
+		/// <summary>Doesn't count as hit or miss and leaves the tile where it is in the recency and frequency lists.</summary>
+		public bool Contains(string tilesetId, CanonicalTileId tileId)
+		{
+			lock (_lock)
+			{
+				int tileset = getTilesetHandle(tilesetId, false);
+				Entry entry;
+				return tileset >= 0 && _entries.TryGetValue(new TileKey(tileset, tileId), out entry) && null != entry.Item;
+			}
+		}
+
+
+		public void Clear()
+		{
+			lock (_lock)
+			{
+				_entries.Clear();
+				_tilesetHandles.Clear();
+				_t1.Clear();
+				_t2.Clear();
+				_b1.Clear();
+				_b2.Clear();
+				_p = 0;
+			}
+		}
+
+
+		public void Clear(string tilesetId)
+		{
+			lock (_lock)
+			{
+				int tileset = getTilesetHandle(tilesetId, false);
+				if (tileset < 0) { return; }
+
+				List<Entry> toDelete = new List<Entry>();
+				foreach (Entry entry in _entries.Values)
+				{
+					if (entry.Key.Tileset == tileset) { toDelete.Add(entry); }
+				}
+				foreach (Entry entry in toDelete)
+				{
+					entry.List.Remove(entry);
+					_entries.Remove(entry.Key);
+				}
+			}
+		}
+
+
+		#region policy
+
+
+		private void touch(Entry entry)
+		{
+			entry.List.Remove(entry);
+			// LRU: back to the front. ARC: second access, move to the frequently used list
+			if (TileMemoryCachePolicy.Lru == _policy)
+			{
+				_t1.AddFirst(entry);
+			}
+			else
+			{
+				_t2.AddFirst(entry);
+			}
+		}
+
+
+		private void evictToBudget(bool ghostHitInB2)
+		{
+			while (
+				_t1.Count + _t2.Count > 0
+				&& (_t1.Bytes + _t2.Bytes > _maxCacheBytes || _t1.Count + _t2.Count > _maxCacheSize)
+			)
+			{
+				if (TileMemoryCachePolicy.Lru == _policy)
+				{
+					evict(_t1, null);
+					continue;
+				}
+
+				// ARC's REPLACE: evict from T1 if it is above its target size, otherwise from T2
+				if (
+					_t1.Count > 0
+					&& (_t1.Bytes > _p || (ghostHitInB2 && _t1.Bytes >= _p) || 0 == _t2.Count)
+				)
+				{
+					evict(_t1, _b1);
+				}
+				else
+				{
+					evict(_t2, _b2);
+				}
+			}
+		}
+
+
+		private void evict(EntryList from, EntryList ghosts)
+		{
+			Entry victim = from.Tail;
+			from.Remove(victim);
+			victim.Item = null;
+			_evictions++;
+
+			if (null == ghosts)
+			{
+				_entries.Remove(victim.Key);
+				return;
+			}
+			ghosts.AddFirst(victim);
+		}
+
+
+		/// <summary>
+		/// Ghost lists only hold keys, keep them bounded like ARC does: T1+B1 and T2+B2 each within the budget.
+		/// </summary>
+		private void trimGhosts()
+		{
+			long capacity = capacityBytes();
+			while (_b1.Count > 0 && (_t1.Bytes + _b1.Bytes > capacity || _b1.Count > _maxCacheSize))
+			{
+				dropGhost(_b1);
+			}
+			while (_b2.Count > 0 && (_t2.Bytes + _b2.Bytes > capacity || _b2.Count > _maxCacheSize))
+			{
+				dropGhost(_b2);
+			}
+		}
+
+
+		private void dropGhost(EntryList ghosts)
+		{
+			Entry ghost = ghosts.Tail;
+			ghosts.Remove(ghost);
+			_entries.Remove(ghost.Key);
+		}
+
+
+		/// <summary>
+		/// Budget ARC adapts within. With only a tile count limit the current average tile size is used to convert it to bytes.
+		/// </summary>
+		private long capacityBytes()
+		{
+			if (long.MaxValue != _maxCacheBytes) { return _maxCacheBytes; }
+
+			int count = _t1.Count + _t2.Count;
+			long averageBytes = 0 == count ? ENTRY_OVERHEAD_BYTES : (_t1.Bytes + _t2.Bytes) / count;
+			return averageBytes * _maxCacheSize;
+		}
+
+
+		#endregion
+
+
+		private int getTilesetHandle(string tilesetId, bool create)
+		{
+			int handle;
+			if (_tilesetHandles.TryGetValue(tilesetId, out handle)) { return handle; }
+			if (!create) { return -1; }
+
+			handle = _tilesetHandles.Count;
+			_tilesetHandles.Add(tilesetId, handle);
+			return handle;
+		}
+
+
+	}
+}
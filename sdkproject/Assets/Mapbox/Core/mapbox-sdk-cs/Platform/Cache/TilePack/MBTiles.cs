@@ -0,0 +1,131 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using SQLite4Unity3d;
+	using System;
+	using System.Globalization;
+	using System.IO;
+
+
+	/// <summary>
+	/// Converts tilesets between <see cref="TilePack"/>s and MBTiles files (https://github.com/mapbox/mbtiles-spec), one tileset per MBTiles file.
+	/// </summary>
+	public static class MBTiles
+	{
+
+
+		private class tiles
+		{
+			public int zoom_level { get; set; }
+			public int tile_column { get; set; }
+			public int tile_row { get; set; }
+			public byte[] tile_data { get; set; }
+		}
+
+
+		/// <summary>Writes all tiles of <paramref name="tilesetId"/> to a new MBTiles file at <paramref name="path"/>.</summary>
+		/// <returns>Number of tiles written.</returns>
+		public static int Export(TilePack pack, string tilesetId, string path)
+		{
+			if (File.Exists(path)) { File.Delete(path); }
+
+			int count = 0;
+			int minZoom = int.MaxValue;
+			int maxZoom = int.MinValue;
+			double west = 180, south = 90, east = -180, north = -90;
+			string format = null;
+
+			using (SQLiteConnection db = new SQLiteConnection(path, SQLiteOpenFlags.ReadWrite | SQLiteOpenFlags.Create))
+			{
+				db.Execute("CREATE TABLE metadata (name TEXT, value TEXT);");
+				db.Execute("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB);");
+				db.Execute("CREATE UNIQUE INDEX tile_index ON tiles (zoom_level, tile_column, tile_row);");
+
+				db.BeginTransaction();
+				foreach (var tile in pack.GetTiles(tilesetId))
+				{
+					CanonicalTileId id = tile.Key;
+					// MBTiles rows count from the south
+					db.Execute("INSERT INTO tiles VALUES (?, ?, ?, ?);", id.Z, id.X, (1 << id.Z) - 1 - id.Y, tile.Value.Data);
+
+					if (null == format) { format = guessFormat(tile.Value.Data); }
+					minZoom = Math.Min(minZoom, id.Z);
+					maxZoom = Math.Max(maxZoom, id.Z);
+					west = Math.Min(west, tileLongitude(id.X, id.Z));
+					east = Math.Max(east, tileLongitude(id.X + 1, id.Z));
+					north = Math.Max(north, tileLatitude(id.Y, id.Z));
+					south = Math.Min(south, tileLatitude(id.Y + 1, id.Z));
+					count++;
+				}
+
+				addMetadata(db, "name", tilesetId);
+				addMetadata(db, "type", "baselayer");
+				addMetadata(db, "version", "1.3");
+				addMetadata(db, "description", "exported from " + System.IO.Path.GetFileName(pack.Path));
+				addMetadata(db, "format", format ?? "pbf");
+				if (count > 0)
+				{
+					addMetadata(db, "minzoom", minZoom.ToString(CultureInfo.InvariantCulture));
+					addMetadata(db, "maxzoom", maxZoom.ToString(CultureInfo.InvariantCulture));
+					addMetadata(db, "bounds", string.Format(CultureInfo.InvariantCulture, "{0},{1},{2},{3}", west, south, east, north));
+				}
+				db.Commit();
+				db.Close();
+			}
+
+			return count;
+		}
+
+
+		/// <summary>Adds all tiles of the MBTiles file at <paramref name="path"/> to a pack as tileset <paramref name="tilesetId"/>.</summary>
+		/// <returns>Number of tiles added.</returns>
+		public static int Import(string path, string tilesetId, TilePackWriter writer)
+		{
+			int count = 0;
+			using (SQLiteConnection db = new SQLiteConnection(path, SQLiteOpenFlags.ReadOnly))
+			{
+				foreach (tiles tile in db.DeferredQuery<tiles>("SELECT zoom_level, tile_column, tile_row, tile_data FROM tiles;"))
+				{
+					CanonicalTileId id = new CanonicalTileId(tile.zoom_level, tile.tile_column, (1 << tile.zoom_level) - 1 - tile.tile_row);
+					writer.Add(tilesetId, id, new CacheItem() { Data = tile.tile_data });
+					count++;
+				}
+				db.Close();
+			}
+			return count;
+		}
+
+
+		private static void addMetadata(SQLiteConnection db, string name, string value)
+		{
+			db.Execute("INSERT INTO metadata VALUES (?, ?);", name, value);
+		}
+
+
+		private static string guessFormat(byte[] data)
+		{
+			if (null == data || data.Length < 4) { return null; }
+			if (0x89 == data[0] && 'P' == data[1] && 'N' == data[2] && 'G' == data[3]) { return "png"; }
+			if (0xFF == data[0] && 0xD8 == data[1]) { return "jpg"; }
+			if ('R' == data[0] && 'I' == data[1] && 'F' == data[2] && 'F' == data[3]) { return "webp"; }
+			// vector tiles, gzip compressed or not
+			return "pbf";
+		}
+
+
+		private static double tileLongitude(int x, int z)
+		{
+			return x / (double)(1 << z) * 360d - 180d;
+		}
+
+
+		private static double tileLatitude(int y, int z)
+		{
+			double n = Math.PI - 2d * Math.PI * y / (1 << z);
+			return 180d / Math.PI * Math.Atan(0.5d * (Math.Exp(n) - Math.Exp(-n)));
+		}
+
+
+	}
+}
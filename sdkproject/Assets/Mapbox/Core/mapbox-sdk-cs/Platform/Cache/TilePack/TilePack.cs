@@ -0,0 +1,311 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using Mapbox.Utils;
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Text;
+
+
+	/// <summary>
+	/// <para>Read-only archive of prebuilt tiles of one or more tilesets, written by <see cref="TilePackWriter"/>.</para>
+	/// <para>Layout, little endian:
+	/// a 64 byte header ('MBTP', version, tileset count, tile count, index offset, creation time),
+	/// the tile data and their ETags back to back,
+	/// the tileset names and an index of fixed size entries (key, data offset, data length, ETag length, Last-Modified)
+	/// sorted by key: tileset, zoom, column, row.</para>
+	/// <para>Opening a pack reads the index only, lookups are binary searches on it and a tile costs one positioned read.</para>
+	/// </summary>
+	public class TilePack : IDisposable
+	{
+
+
+		public const int VERSION = 1;
+		internal const int HEADER_SIZE = 64;
+		internal const int INDEX_ENTRY_SIZE = 32;
+		internal const int MAX_TILESETS = 256;
+		internal const int MAX_ZOOM = 24;
+		internal static readonly byte[] MAGIC = new byte[] { (byte)'M', (byte)'B', (byte)'T', (byte)'P' };
+
+
+		private bool _disposed;
+		private string _path;
+		private FileStream _file;
+		private readonly object _lock = new object();
+		private DateTime _created;
+		private string[] _tilesets;
+		private Dictionary<string, int> _tilesetIndex;
+		private ulong[] _keys;
+		private long[] _offsets;
+		private int[] _lengths;
+		private int[] _etagLengths;
+		private long[] _lastModified;
+
+
+		/// <summary>Opens a pack and reads its index.</summary>
+		/// <exception cref="InvalidDataException">The file is not a tile pack or of an unsupported version.</exception>
+		public TilePack(string path)
+		{
+			_path = path;
+			_file = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read, 4096, FileOptions.RandomAccess);
+			try
+			{
+				readIndex();
+			}
+			catch
+			{
+				_file.Dispose();
+				throw;
+			}
+		}
+
+
+		#region idisposable
+
+
+		~TilePack()
+		{
+			Dispose(false);
+		}
+
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources)
+				{
+					lock (_lock)
+					{
+						_file.Dispose();
+					}
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		public string Path { get { return _path; } }
+
+
+		/// <summary>UTC time the pack was written.</summary>
+		public DateTime Created { get { return _created; } }
+
+
+		/// <summary>Number of tiles over all tilesets.</summary>
+		public int Count { get { return _keys.Length; } }
+
+
+		/// <summary>Tilesets with tiles in this pack.</summary>
+		public string[] Tilesets { get { return (string[])_tilesets.Clone(); } }
+
+
+		public bool Contains(string tilesetId, CanonicalTileId tileId)
+		{
+			return find(tilesetId, tileId) >= 0;
+		}
+
+
+		/// <returns>The tile, null if it isn't in the pack.</returns>
+		public CacheItem Get(string tilesetId, CanonicalTileId tileId)
+		{
+			int entry = find(tilesetId, tileId);
+			return entry < 0 ? null : read(entry);
+		}
+
+
+		/// <summary>All tiles of a tileset, ordered by zoom, column and row.</summary>
+		public IEnumerable<KeyValuePair<CanonicalTileId, CacheItem>> GetTiles(string tilesetId)
+		{
+			int tileset;
+			if (!_tilesetIndex.TryGetValue(tilesetId, out tileset)) { yield break; }
+
+			ulong first = MakeKey(tileset, 0, 0, 0);
+			int entry = lowerBound(first);
+			while (entry < _keys.Length && (int)(_keys[entry] >> 56) == tileset)
+			{
+				yield return new KeyValuePair<CanonicalTileId, CacheItem>(TileIdFromKey(_keys[entry]), read(entry));
+				entry++;
+			}
+		}
+
+
+		/// <summary>Copies all tiles into <paramref name="cache"/>, eg to import a region into the file cache.</summary>
+		/// <returns>Number of tiles copied.</returns>
+		public int CopyTo(ICache cache, bool replaceIfExists)
+		{
+			int copied = 0;
+			foreach (string tilesetId in _tilesets)
+			{
+				foreach (KeyValuePair<CanonicalTileId, CacheItem> tile in GetTiles(tilesetId))
+				{
+					cache.Add(tilesetId, tile.Key, tile.Value, replaceIfExists);
+					copied++;
+				}
+			}
+			return copied;
+		}
+
+
+		internal static ulong MakeKey(int tileset, int z, int x, int y)
+		{
+			return ((ulong)tileset << 56) | ((ulong)z << 48) | ((ulong)x << 24) | (ulong)y;
+		}
+
+
+		internal static CanonicalTileId TileIdFromKey(ulong key)
+		{
+			return new CanonicalTileId((int)((key >> 48) & 0xFF), (int)((key >> 24) & 0xFFFFFF), (int)(key & 0xFFFFFF));
+		}
+
+
+		private int find(string tilesetId, CanonicalTileId tileId)
+		{
+			int tileset;
+			if (null == tilesetId || !_tilesetIndex.TryGetValue(tilesetId, out tileset)) { return -1; }
+			if (tileId.Z < 0 || tileId.Z > MAX_ZOOM) { return -1; }
+
+			ulong key = MakeKey(tileset, tileId.Z, tileId.X, tileId.Y);
+			int entry = lowerBound(key);
+			return entry < _keys.Length && _keys[entry] == key ? entry : -1;
+		}
+
+
+		private int lowerBound(ulong key)
+		{
+			int lo = 0;
+			int hi = _keys.Length;
+			while (lo < hi)
+			{
+				int mid = lo + ((hi - lo) >> 1);
+				if (_keys[mid] < key) { lo = mid + 1; } else { hi = mid; }
+			}
+			return lo;
+		}
+
+
+		private CacheItem read(int entry)
+		{
+			int length = _lengths[entry];
+			int etagLength = _etagLengths[entry];
+			byte[] data = new byte[length];
+			byte[] etag = 0 == etagLength ? null : new byte[etagLength];
+
+			lock (_lock)
+			{
+				if (_disposed) { throw new ObjectDisposedException(_path); }
+				_file.Position = _offsets[entry];
+				readFully(_file, data, length);
+				if (null != etag) { readFully(_file, etag, etagLength); }
+			}
+
+			DateTime? lastModified = null;
+			if (0 != _lastModified[entry]) { lastModified = UnixTimestampUtils.From((double)_lastModified[entry]); }
+
+			return new CacheItem()
+			{
+				Data = data,
+				AddedToCacheTicksUtc = _created.Ticks,
+				ETag = null == etag ? null : Encoding.UTF8.GetString(etag),
+				LastModified = lastModified
+			};
+		}
+
+
+		private void readIndex()
+		{
+			BinaryReader reader = new BinaryReader(_file);
+
+			byte[] magic = reader.ReadBytes(MAGIC.Length);
+			for (int i = 0; i < MAGIC.Length; i++)
+			{
+				if (magic.Length != MAGIC.Length || magic[i] != MAGIC[i])
+				{
+					throw new InvalidDataException(string.Format("[{0}] is not a tile pack", _path));
+				}
+			}
+			int version = reader.ReadInt32();
+			if (VERSION != version)
+			{
+				throw new InvalidDataException(string.Format("[{0}] unsupported tile pack version: {1}", _path, version));
+			}
+			int tilesetCount = reader.ReadInt32();
+			int tileCount = reader.ReadInt32();
+			long indexOffset = reader.ReadInt64();
+			_created = new DateTime(reader.ReadInt64(), DateTimeKind.Utc);
+
+			if (tilesetCount < 0 || tilesetCount > MAX_TILESETS || tileCount < 0 || indexOffset < HEADER_SIZE || indexOffset > _file.Length)
+			{
+				throw new InvalidDataException(string.Format("[{0}] corrupt tile pack header", _path));
+			}
+
+			_file.Position = indexOffset;
+			_tilesets = new string[tilesetCount];
+			_tilesetIndex = new Dictionary<string, int>();
+			for (int i = 0; i < tilesetCount; i++)
+			{
+				_tilesets[i] = reader.ReadString();
+				_tilesetIndex[_tilesets[i]] = i;
+			}
+
+			if (_file.Length - _file.Position < (long)tileCount * INDEX_ENTRY_SIZE)
+			{
+				throw new InvalidDataException(string.Format("[{0}] truncated tile pack index", _path));
+			}
+
+			// one read for the whole index
+			byte[] index = new byte[tileCount * INDEX_ENTRY_SIZE];
+			readFully(_file, index, index.Length);
+
+			_keys = new ulong[tileCount];
+			_offsets = new long[tileCount];
+			_lengths = new int[tileCount];
+			_etagLengths = new int[tileCount];
+			_lastModified = new long[tileCount];
+			for (int i = 0; i < tileCount; i++)
+			{
+				int pos = i * INDEX_ENTRY_SIZE;
+				_keys[i] = BitConverter.ToUInt64(index, pos);
+				_offsets[i] = BitConverter.ToInt64(index, pos + 8);
+				_lengths[i] = BitConverter.ToInt32(index, pos + 16);
+				_etagLengths[i] = BitConverter.ToInt32(index, pos + 20);
+				_lastModified[i] = BitConverter.ToInt64(index, pos + 24);
+
+				if (
+					(i > 0 && _keys[i] <= _keys[i - 1])
+					|| _offsets[i] < HEADER_SIZE
+					|| _lengths[i] < 0
+					|| _etagLengths[i] < 0
+					|| _offsets[i] + _lengths[i] + _etagLengths[i] > indexOffset
+				)
+				{
+					throw new InvalidDataException(string.Format("[{0}] corrupt tile pack index entry {1}", _path, i));
+				}
+			}
+		}
+
+
+		private static void readFully(Stream stream, byte[] buffer, int count)
+		{
+			int read = 0;
+			while (read < count)
+			{
+				int n = stream.Read(buffer, read, count - read);
+				if (n <= 0) { throw new EndOfStreamException(); }
+				read += n;
+			}
+		}
+
+
+	}
+}
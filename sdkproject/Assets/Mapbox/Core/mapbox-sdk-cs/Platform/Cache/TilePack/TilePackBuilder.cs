@@ -0,0 +1,323 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using Mapbox.Utils;
+	using System;
+	using System.Collections.Generic;
+
+
+	/// <summary>
+	/// <para>Downloads all tiles of a bounding box and zoom range into a <see cref="TilePack"/>.</para>
+	/// <para>Tiles are requested through an <see cref="IFileSource"/>, with <see cref="MaxConcurrentRequests"/> requests at a time.
+	/// Requests run asynchronously, poll <see cref="IsDone"/> or pass a callback to <see cref="Build"/>.</para>
+	/// </summary>
+	/// <example>
+	/// <code>
+	/// var builder = new TilePackBuilder(MapboxAccess.Instance, path);
+	/// builder.AddTileset("mapbox.mapbox-streets-v7", TileResource.MakeVector);
+	/// builder.AddTileset("mapbox.terrain-rgb", TileResource.MakeRawPngRaster);
+	/// builder.Build(bounds, 10, 16, (b) => Debug.Log(b));
+	/// </code>
+	/// </example>
+	public class TilePackBuilder
+	{
+
+
+		private struct Tileset
+		{
+			public string Id;
+			public Func<CanonicalTileId, string, TileResource> MakeResource;
+		}
+
+
+		private IFileSource _fileSource;
+		private string _path;
+		private List<Tileset> _tilesets = new List<Tileset>();
+		private readonly object _lock = new object();
+		private TilePackWriter _writer;
+		private IEnumerator<KeyValuePair<Tileset, CanonicalTileId>> _pending;
+		private List<IAsyncRequest> _running = new List<IAsyncRequest>();
+		private Action<TilePackBuilder> _finished;
+		private int _total;
+		private int _completed;
+		private int _failed;
+		private bool _started;
+		private bool _done;
+		private bool _canceled;
+		private bool _pumping;
+
+
+		/// <param name="fileSource">Requests the tiles, eg 'MapboxAccess.Instance'.</param>
+		/// <param name="path">Pack to write, replaced once all tiles have been downloaded.</param>
+		public TilePackBuilder(IFileSource fileSource, string path)
+		{
+			if (null == fileSource) { throw new ArgumentNullException("fileSource"); }
+			if (string.IsNullOrEmpty(path)) { throw new ArgumentNullException("path"); }
+			_fileSource = fileSource;
+			_path = path;
+			MaxConcurrentRequests = 8;
+			Timeout = 30;
+		}
+
+
+		public int MaxConcurrentRequests { get; set; }
+
+
+		/// <summary>Request timeout in seconds.</summary>
+		public int Timeout { get; set; }
+
+
+		public string Path { get { return _path; } }
+
+
+		/// <summary>Tiles to download over all tilesets.</summary>
+		public int Total { get { lock (_lock) { return _total; } } }
+
+
+		/// <summary>Tiles downloaded or failed.</summary>
+		public int Completed { get { lock (_lock) { return _completed; } } }
+
+
+		/// <summary>Tiles that could not be downloaded, they are missing from the pack.</summary>
+		public int Failed { get { lock (_lock) { return _failed; } } }
+
+
+		/// <summary>Bytes of tile data written.</summary>
+		public long Bytes { get { lock (_lock) { return null == _writer ? 0 : _writer.Bytes; } } }
+
+
+		public bool IsDone { get { lock (_lock) { return _done; } } }
+
+
+		public bool IsCanceled { get { lock (_lock) { return _canceled; } } }
+
+
+		/// <summary>Adds a tileset to the pack.</summary>
+		/// <param name="tilesetId">Tileset id the tiles are cached and looked up with, the one the factory of the layer uses.</param>
+		/// <param name="makeResource">Builds the request of a tile from its id and <paramref name="tilesetId"/>, eg <see cref="TileResource.MakeVector"/>.</param>
+		public TilePackBuilder AddTileset(string tilesetId, Func<CanonicalTileId, string, TileResource> makeResource)
+		{
+			if (string.IsNullOrEmpty(tilesetId)) { throw new ArgumentNullException("tilesetId"); }
+			if (null == makeResource) { throw new ArgumentNullException("makeResource"); }
+			lock (_lock)
+			{
+				if (_started) { throw new InvalidOperationException("build has been started already"); }
+				_tilesets.Add(new Tileset() { Id = tilesetId, MakeResource = makeResource });
+			}
+			return this;
+		}
+
+
+		/// <summary>Number of tiles per tileset covering <paramref name="bounds"/> from <paramref name="minZoom"/> to <paramref name="maxZoom"/>.</summary>
+		public static int CountTiles(Vector2dBounds bounds, int minZoom, int maxZoom)
+		{
+			int count = 0;
+			for (int z = minZoom; z <= maxZoom; z++)
+			{
+				count += TileCover.Get(bounds, z).Count;
+			}
+			return count;
+		}
+
+
+		/// <summary>Starts downloading, <paramref name="finished"/> is called once all tiles have been downloaded and the pack has been written.</summary>
+		public void Build(Vector2dBounds bounds, int minZoom, int maxZoom, Action<TilePackBuilder> finished = null)
+		{
+			if (minZoom < 0 || maxZoom > TilePack.MAX_ZOOM || minZoom > maxZoom)
+			{
+				throw new ArgumentOutOfRangeException("minZoom", string.Format("invalid zoom range {0}-{1}", minZoom, maxZoom));
+			}
+
+			lock (_lock)
+			{
+				if (_started) { throw new InvalidOperationException("build has been started already"); }
+				if (0 == _tilesets.Count) { throw new InvalidOperationException("no tilesets added"); }
+				_started = true;
+				_finished = finished;
+				_total = CountTiles(bounds, minZoom, maxZoom) * _tilesets.Count;
+				_writer = new TilePackWriter(_path);
+				_pending = tiles(bounds, minZoom, maxZoom).GetEnumerator();
+			}
+
+			pump();
+		}
+
+
+		/// <summary>Stops downloading and discards the pack.</summary>
+		public void Cancel()
+		{
+			List<IAsyncRequest> running;
+			lock (_lock)
+			{
+				if (!_started || _done) { return; }
+				_canceled = true;
+				_done = true;
+				_writer.Abort();
+				running = new List<IAsyncRequest>(_running);
+				_running.Clear();
+			}
+
+			foreach (IAsyncRequest request in running)
+			{
+				request.Cancel();
+			}
+		}
+
+
+		public override string ToString()
+		{
+			lock (_lock)
+			{
+				return string.Format(
+					"[{0}] {1}/{2} tiles, {3} failed, {4} KB{5}"
+					, _path
+					, _completed
+					, _total
+					, _failed
+					, null == _writer ? 0 : _writer.Bytes / 1024
+					, _canceled ? ", canceled" : _done ? ", done" : string.Empty
+				);
+			}
+		}
+
+
+		// tiles ordered by zoom, tileset, column and row
+		private IEnumerable<KeyValuePair<Tileset, CanonicalTileId>> tiles(Vector2dBounds bounds, int minZoom, int maxZoom)
+		{
+			for (int z = minZoom; z <= maxZoom; z++)
+			{
+				List<CanonicalTileId> cover = new List<CanonicalTileId>(TileCover.Get(bounds, z));
+				cover.Sort((a, b) => a.X != b.X ? a.X.CompareTo(b.X) : a.Y.CompareTo(b.Y));
+				foreach (Tileset tileset in _tilesets)
+				{
+					foreach (CanonicalTileId tileId in cover)
+					{
+						yield return new KeyValuePair<Tileset, CanonicalTileId>(tileset, tileId);
+					}
+				}
+			}
+		}
+
+
+		private void pump()
+		{
+			lock (_lock)
+			{
+				// cached tiles call back synchronously, the running call goes on instead of recursing.
+				// it sees their results as checking for work and clearing '_pumping' happen under the same lock
+				if (_pumping) { return; }
+				_pumping = true;
+			}
+
+			bool finished = false;
+			while (true)
+			{
+				KeyValuePair<Tileset, CanonicalTileId> next;
+				lock (_lock)
+				{
+					bool full = _done || _running.Count >= Math.Max(1, MaxConcurrentRequests);
+					if (!full && !_pending.MoveNext())
+					{
+						if (0 == _running.Count)
+						{
+							_done = true;
+							finished = true;
+						}
+						full = true;
+					}
+					if (full)
+					{
+						_pumping = false;
+						break;
+					}
+					next = _pending.Current;
+				}
+				request(next.Key, next.Value);
+			}
+
+			if (finished) { finish(); }
+		}
+
+
+		private void request(Tileset tileset, CanonicalTileId tileId)
+		{
+			string url = tileset.MakeResource(tileId, tileset.Id).GetUrl();
+			RunningRequest running = new RunningRequest();
+			lock (_lock) { _running.Add(running); }
+
+			IAsyncRequest request = _fileSource.Request(
+				url
+				, (Response response) => onResponse(running, tileset, tileId, response)
+				, Timeout
+				, tileId
+				, tileset.Id
+			);
+
+			bool canceled;
+			lock (_lock)
+			{
+				// callback may have run already
+				if (running.IsCompleted) { return; }
+				running.Request = request;
+				canceled = _canceled;
+			}
+			if (canceled && null != request) { request.Cancel(); }
+		}
+
+
+		private void onResponse(RunningRequest running, Tileset tileset, CanonicalTileId tileId, Response response)
+		{
+			lock (_lock)
+			{
+				running.IsCompleted = true;
+				if (!_running.Remove(running)) { return; }
+
+				_completed++;
+				if (response.HasError || null == response.Data)
+				{
+					_failed++;
+				}
+				else
+				{
+					string etag = null;
+					if (null != response.Headers) { response.Headers.TryGetValue("ETag", out etag); }
+					_writer.Add(tileset.Id, tileId, new CacheItem() { Data = response.CompressedData ?? response.Data, ETag = etag });
+				}
+			}
+
+			pump();
+		}
+
+
+		private void finish()
+		{
+			try
+			{
+				_writer.Finish();
+			}
+			catch (Exception ex)
+			{
+				UnityEngine.Debug.LogErrorFormat("could not write tile pack [{0}]: {1}", _path, ex);
+			}
+
+			if (null != _finished) { _finished(this); }
+		}
+
+
+		/// <summary>Handle of a tile request, the request of the file source is attached once it has been started.</summary>
+		private class RunningRequest : IAsyncRequest
+		{
+			public IAsyncRequest Request;
+			public bool IsCompleted { get; set; }
+			public Mapbox.Unity.Utilities.HttpRequestType RequestType { get { return Mapbox.Unity.Utilities.HttpRequestType.Get; } }
+
+			public void Cancel()
+			{
+				if (null != Request) { Request.Cancel(); }
+			}
+		}
+
+
+	}
+}
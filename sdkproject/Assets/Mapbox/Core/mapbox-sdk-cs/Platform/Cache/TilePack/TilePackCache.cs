@@ -0,0 +1,194 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+
+
+	/// <summary>
+	/// <para>Serves tiles from <see cref="TilePack"/>s, eg regions shipped with an app or downloaded ahead of time.</para>
+	/// <para>Packs are read-only: 'Add()' and 'Clear()' do nothing and nothing is ever evicted.
+	/// Add it to 'CachingWebFileSource' before the file cache so packed tiles are never looked up in the database.</para>
+	/// </summary>
+	public class TilePackCache : ICache, IDisposable
+	{
+
+
+		/// <summary>File extension of tile packs opened by <see cref="OpenDirectory"/>.</summary>
+		public const string FILE_EXTENSION = ".tilepack";
+
+
+		private bool _disposed;
+		// replaced, not modified, when packs are opened or closed so 'Get()' doesn't have to lock it
+		private volatile TilePack[] _packs = new TilePack[0];
+		private readonly object _lock = new object();
+		private long _hits;
+		private long _misses;
+
+
+		#region idisposable
+
+
+		~TilePackCache()
+		{
+			Dispose(false);
+		}
+
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources)
+				{
+					lock (_lock)
+					{
+						foreach (TilePack pack in _packs) { pack.Dispose(); }
+						_packs = new TilePack[0];
+					}
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		/// <summary>Not limited, packs are read-only.</summary>
+		public uint MaxCacheSize { get { return uint.MaxValue; } }
+
+
+		/// <summary>Opened packs, packs opened first are looked up first.</summary>
+		public TilePack[] Packs { get { return (TilePack[])_packs.Clone(); } }
+
+
+		/// <summary>Lookups answered from a pack.</summary>
+		public long Hits { get { lock (_lock) { return _hits; } } }
+
+
+		/// <summary>Lookups of tiles not in any pack.</summary>
+		public long Misses { get { lock (_lock) { return _misses; } } }
+
+
+		/// <summary>Opens a pack and serves its tiles.</summary>
+		/// <exception cref="InvalidDataException">The file is not a tile pack.</exception>
+		public TilePack Open(string path)
+		{
+			TilePack pack = new TilePack(path);
+			lock (_lock)
+			{
+				List<TilePack> packs = new List<TilePack>(_packs);
+				packs.Add(pack);
+				_packs = packs.ToArray();
+			}
+			return pack;
+		}
+
+
+		/// <summary>Opens all <see cref="FILE_EXTENSION"/> files in <paramref name="directory"/>, files that can't be read are logged and skipped.</summary>
+		/// <returns>Number of packs opened.</returns>
+		public int OpenDirectory(string directory)
+		{
+			if (!Directory.Exists(directory)) { return 0; }
+
+			string[] files = Directory.GetFiles(directory, "*" + FILE_EXTENSION);
+			Array.Sort(files, StringComparer.Ordinal);
+			int opened = 0;
+			foreach (string file in files)
+			{
+				try
+				{
+					Open(file);
+					opened++;
+				}
+				catch (Exception ex)
+				{
+					UnityEngine.Debug.LogErrorFormat("could not open tile pack [{0}]: {1}", file, ex);
+				}
+			}
+			return opened;
+		}
+
+
+		/// <summary>Stops serving a pack and closes it.</summary>
+		public bool Close(TilePack pack)
+		{
+			lock (_lock)
+			{
+				List<TilePack> packs = new List<TilePack>(_packs);
+				if (!packs.Remove(pack)) { return false; }
+				_packs = packs.ToArray();
+			}
+			pack.Dispose();
+			return true;
+		}
+
+
+		/// <summary>Does nothing, packs are read-only.</summary>
+		public void Add(string tilesetId, CanonicalTileId tileId, CacheItem item, bool replaceIfExists) { }
+
+
+		public CacheItem Get(string tilesetId, CanonicalTileId tileId)
+		{
+			TilePack[] packs = _packs;
+			if (0 == packs.Length) { return null; }
+
+			foreach (TilePack pack in packs)
+			{
+				CacheItem item = null;
+				try
+				{
+					item = pack.Get(tilesetId, tileId);
+				}
+				catch (ObjectDisposedException)
+				{
+					// closed while we were looking
+				}
+				catch (IOException ex)
+				{
+					UnityEngine.Debug.LogErrorFormat("error reading tile {0} {1} from [{2}]: {3}", tilesetId, tileId, pack.Path, ex);
+				}
+				if (null != item)
+				{
+					lock (_lock) { _hits++; }
+					return item;
+				}
+			}
+
+			lock (_lock) { _misses++; }
+			return null;
+		}
+
+
+		/// <summary>Looks the tile up in the pack indices, doesn't read it and doesn't count as hit or miss.</summary>
+		public bool Contains(string tilesetId, CanonicalTileId tileId)
+		{
+			foreach (TilePack pack in _packs)
+			{
+				if (pack.Contains(tilesetId, tileId)) { return true; }
+			}
+			return false;
+		}
+
+
+		/// <summary>Does nothing, packs are read-only. Use <see cref="Close"/> to stop serving a pack.</summary>
+		public void Clear() { }
+
+
+		/// <summary>Does nothing, packs are read-only.</summary>
+		public void Clear(string tilesetId) { }
+
+
+		public void ReInit() { }
+
+
+	}
+}
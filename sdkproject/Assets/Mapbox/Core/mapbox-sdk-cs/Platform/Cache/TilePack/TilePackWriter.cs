@@ -0,0 +1,203 @@
+namespace Mapbox.Platform.Cache
+{
+
+	using Mapbox.Map;
+	using Mapbox.Utils;
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Text;
+
+
+	/// <summary>
+	/// <para>Writes a <see cref="TilePack"/>. Tiles are appended as they are added, the sorted index is written by <see cref="Finish"/>.</para>
+	/// <para>The pack is written to a temporary file next to the target and only moved into place once it is complete.</para>
+	/// </summary>
+	public class TilePackWriter : IDisposable
+	{
+
+
+		private struct Entry
+		{
+			public ulong Key;
+			public long Offset;
+			public int Length;
+			public int ETagLength;
+			public long LastModified;
+		}
+
+
+		private bool _disposed;
+		private bool _finished;
+		private string _path;
+		private string _tempPath;
+		private FileStream _file;
+		private BinaryWriter _writer;
+		private readonly object _lock = new object();
+		private List<string> _tilesets = new List<string>();
+		private Dictionary<string, int> _tilesetIndex = new Dictionary<string, int>();
+		// position of a tile in '_entries', a tile added twice replaces the earlier one
+		private Dictionary<ulong, int> _entryIndex = new Dictionary<ulong, int>();
+		private List<Entry> _entries = new List<Entry>();
+		private long _bytes;
+
+
+		public TilePackWriter(string path)
+		{
+			_path = path;
+			_tempPath = path + ".tmp";
+			_file = new FileStream(_tempPath, FileMode.Create, FileAccess.Write, FileShare.None, 64 * 1024);
+			_writer = new BinaryWriter(_file);
+			// header is written by 'Finish()'
+			_writer.Write(new byte[TilePack.HEADER_SIZE]);
+		}
+
+
+		#region idisposable
+
+
+		~TilePackWriter()
+		{
+			Dispose(false);
+		}
+
+		/// <summary>Finishes the pack if that hasn't been done yet.</summary>
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources && !_finished)
+				{
+					Finish();
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		public string Path { get { return _path; } }
+
+
+		/// <summary>Number of tiles added.</summary>
+		public int Count { get { lock (_lock) { return _entries.Count; } } }
+
+
+		/// <summary>Bytes of tile data written.</summary>
+		public long Bytes { get { lock (_lock) { return _bytes; } } }
+
+
+		public void Add(string tilesetId, CanonicalTileId tileId, CacheItem item)
+		{
+			if (string.IsNullOrEmpty(tilesetId)) { throw new ArgumentException("tileset id missing", "tilesetId"); }
+			if (null == item || null == item.Data) { throw new ArgumentNullException("item"); }
+			if (tileId.Z < 0 || tileId.Z > TilePack.MAX_ZOOM) { throw new ArgumentOutOfRangeException("tileId", tileId.ToString()); }
+
+			byte[] etag = string.IsNullOrEmpty(item.ETag) ? null : Encoding.UTF8.GetBytes(item.ETag);
+
+			lock (_lock)
+			{
+				if (_finished) { throw new InvalidOperationException("tile pack has been finished already"); }
+
+				int tileset;
+				if (!_tilesetIndex.TryGetValue(tilesetId, out tileset))
+				{
+					if (_tilesets.Count == TilePack.MAX_TILESETS)
+					{
+						throw new InvalidOperationException(string.Format("a tile pack can't hold more than {0} tilesets", TilePack.MAX_TILESETS));
+					}
+					tileset = _tilesets.Count;
+					_tilesets.Add(tilesetId);
+					_tilesetIndex.Add(tilesetId, tileset);
+				}
+
+				Entry entry = new Entry()
+				{
+					Key = TilePack.MakeKey(tileset, tileId.Z, tileId.X, tileId.Y),
+					Offset = _file.Position,
+					Length = item.Data.Length,
+					ETagLength = null == etag ? 0 : etag.Length,
+					LastModified = item.LastModified.HasValue ? (long)UnixTimestampUtils.To(item.LastModified.Value) : 0
+				};
+
+				_writer.Write(item.Data);
+				if (null != etag) { _writer.Write(etag); }
+				_bytes += item.Data.Length;
+
+				int existing;
+				if (_entryIndex.TryGetValue(entry.Key, out existing))
+				{
+					_entries[existing] = entry;
+				}
+				else
+				{
+					_entryIndex.Add(entry.Key, _entries.Count);
+					_entries.Add(entry);
+				}
+			}
+		}
+
+
+		/// <summary>Writes the index and header and moves the pack into place.</summary>
+		public void Finish()
+		{
+			lock (_lock)
+			{
+				if (_finished) { return; }
+				_finished = true;
+
+				long indexOffset = _file.Position;
+				foreach (string tileset in _tilesets)
+				{
+					_writer.Write(tileset);
+				}
+
+				_entries.Sort((a, b) => a.Key.CompareTo(b.Key));
+				foreach (Entry entry in _entries)
+				{
+					_writer.Write(entry.Key);
+					_writer.Write(entry.Offset);
+					_writer.Write(entry.Length);
+					_writer.Write(entry.ETagLength);
+					_writer.Write(entry.LastModified);
+				}
+
+				_file.Position = 0;
+				_writer.Write(TilePack.MAGIC);
+				_writer.Write(TilePack.VERSION);
+				_writer.Write(_tilesets.Count);
+				_writer.Write(_entries.Count);
+				_writer.Write(indexOffset);
+				_writer.Write(DateTime.UtcNow.Ticks);
+				_writer.Flush();
+				_file.Dispose();
+
+				if (File.Exists(_path)) { File.Delete(_path); }
+				File.Move(_tempPath, _path);
+			}
+		}
+
+
+		/// <summary>Discards the pack.</summary>
+		public void Abort()
+		{
+			lock (_lock)
+			{
+				if (_finished) { return; }
+				_finished = true;
+				_file.Dispose();
+				File.Delete(_tempPath);
+			}
+		}
+
+
+	}
+}
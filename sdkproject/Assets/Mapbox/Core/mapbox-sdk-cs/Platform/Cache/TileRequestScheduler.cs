@@ -0,0 +1,524 @@
+using Mapbox.Map;
+using Mapbox.Unity.Utilities;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+
+namespace Mapbox.Platform.Cache
+{
+
+
+	/// <summary>
+	/// Queue and latency statistics of one priority level of <see cref="TileRequestScheduler"/>.
+	/// </summary>
+	public struct TileRequestStats
+	{
+		/// <summary>0 is served first</summary>
+		public int Priority;
+		/// <summary>Fetches currently waiting for a free connection</summary>
+		public int QueueDepth;
+		/// <summary>Fetches that have been started</summary>
+		public long Dispatched;
+		/// <summary>Fetches dropped from the queue because all requesters canceled</summary>
+		public long Canceled;
+		/// <summary>Average time between queueing and dispatching</summary>
+		public double AverageWaitMilliseconds;
+		/// <summary>Longest time between queueing and dispatching</summary>
+		public double MaxWaitMilliseconds;
+		/// <summary>Average time between dispatching and receiving the response</summary>
+		public double AverageFetchMilliseconds;
+	}
+
+
+	/// <summary>
+	/// <para>Coalesces concurrent requests for the same tile into one network fetch and
+	/// runs fetches with bounded concurrency, tiles closest to the focus tile first.</para>
+	/// <para>Every requester gets its own handle: canceling it only detaches that requester,
+	/// the fetch is dropped from the queue or aborted once nobody is waiting for it anymore.</para>
+	/// <para>Prefetches wait in their own queue behind all other fetches and only use
+	/// <see cref="MaxConcurrentPrefetches"/> connections. A regular request for a prefetched tile joins the fetch and promotes it.</para>
+	/// </summary>
+	public class TileRequestScheduler
+	{
+
+
+		/// <summary>Number of priority levels, see <see cref="GetPriority"/>.</summary>
+		public const int PRIORITY_LEVELS = 4;
+		/// <summary>Level of prefetches, after all levels of <see cref="GetPriority"/>.</summary>
+		public const int PREFETCH_PRIORITY = PRIORITY_LEVELS;
+
+
+		/// <summary>Starts the actual network fetch, <paramref name="callback"/> has to be called exactly once.</summary>
+		public delegate IAsyncRequest StartFetch(string url, string tilesetId, CanonicalTileId tileId, int timeout, Action<Response> callback);
+
+
+		private class Fetch
+		{
+			public string Url;
+			public string TilesetId;
+			public CanonicalTileId TileId;
+			public int Timeout;
+			public int Priority;
+			public bool Prefetch;
+			public bool RunningAsPrefetch;
+			public List<TileRequest> Requesters = new List<TileRequest>();
+			public LinkedListNode<Fetch> QueueNode;
+			public IAsyncRequest Request;
+			public bool Running;
+			public bool Done;
+			public bool Aborted;
+			public long EnqueuedTimestamp;
+			public long DispatchedTimestamp;
+		}
+
+
+		private class LevelStats
+		{
+			public long Dispatched;
+			public long Canceled;
+			public long Fetched;
+			public double TotalWaitMilliseconds;
+			public double MaxWaitMilliseconds;
+			public double TotalFetchMilliseconds;
+		}
+
+
+		private class TileRequest : IAsyncRequest
+		{
+			private TileRequestScheduler _scheduler;
+
+			public Fetch Fetch;
+			public Action<Response> Callback;
+
+			public TileRequest(TileRequestScheduler scheduler, Fetch fetch, Action<Response> callback)
+			{
+				_scheduler = scheduler;
+				Fetch = fetch;
+				Callback = callback;
+			}
+
+			public bool IsCompleted { get; set; }
+
+			public HttpRequestType RequestType { get { return HttpRequestType.Get; } }
+
+			public void Cancel()
+			{
+				_scheduler.cancel(this);
+			}
+		}
+
+
+		private readonly object _lock = new object();
+		private readonly StartFetch _startFetch;
+		private readonly Dictionary<string, Fetch> _fetches = new Dictionary<string, Fetch>();
+		private readonly LinkedList<Fetch>[] _queues = new LinkedList<Fetch>[PRIORITY_LEVELS + 1];
+		private readonly LevelStats[] _stats = new LevelStats[PRIORITY_LEVELS + 1];
+		private int _maxConcurrentRequests;
+		private int _maxConcurrentPrefetches = 1;
+		private int _running;
+		private int _runningPrefetches;
+		private long _coalesced;
+		private bool _hasFocus;
+		private CanonicalTileId _focus;
+
+
+		/// <param name="maxConcurrentRequests">Maximum number of fetches running at the same time, 0: unbounded.</param>
+		/// <param name="startFetch">Starts the network fetch of a tile.</param>
+		public TileRequestScheduler(int maxConcurrentRequests, StartFetch startFetch)
+		{
+			if (null == startFetch) { throw new ArgumentNullException("startFetch"); }
+
+			_maxConcurrentRequests = Math.Max(0, maxConcurrentRequests);
+			_startFetch = startFetch;
+			for (int i = 0; i < _queues.Length; i++)
+			{
+				_queues[i] = new LinkedList<Fetch>();
+				_stats[i] = new LevelStats();
+			}
+		}
+
+
+		/// <summary>Maximum number of fetches running at the same time, 0: unbounded.</summary>
+		public int MaxConcurrentRequests
+		{
+			get { return _maxConcurrentRequests; }
+			set
+			{
+				lock (_lock) { _maxConcurrentRequests = Math.Max(0, value); }
+				pump();
+			}
+		}
+
+
+		/// <summary>Maximum number of prefetches running at the same time, they also count against <see cref="MaxConcurrentRequests"/>.</summary>
+		public int MaxConcurrentPrefetches
+		{
+			get { return _maxConcurrentPrefetches; }
+			set
+			{
+				lock (_lock) { _maxConcurrentPrefetches = Math.Max(0, value); }
+				pump();
+			}
+		}
+
+
+		/// <summary>Number of fetches currently running.</summary>
+		public int InFlight { get { lock (_lock) { return _running; } } }
+
+
+		/// <summary>Number of fetches waiting for a free connection.</summary>
+		public int Queued
+		{
+			get
+			{
+				lock (_lock)
+				{
+					int queued = 0;
+					for (int i = 0; i < _queues.Length; i++) { queued += _queues[i].Count; }
+					return queued;
+				}
+			}
+		}
+
+
+		/// <summary>Number of requests that were attached to an already queued or running fetch.</summary>
+		public long Coalesced { get { lock (_lock) { return _coalesced; } } }
+
+
+		/// <summary>
+		/// Sets the tile the viewer is looking at, typically the center tile of the current extent.
+		/// Queued fetches are reprioritized.
+		/// </summary>
+		public void SetFocus(CanonicalTileId focus)
+		{
+			lock (_lock)
+			{
+				if (_hasFocus && _focus.Equals(focus)) { return; }
+
+				_hasFocus = true;
+				_focus = focus;
+
+				List<Fetch> queued = new List<Fetch>();
+				for (int i = 0; i < _queues.Length; i++)
+				{
+					foreach (Fetch fetch in _queues[i]) { queued.Add(fetch); }
+					_queues[i].Clear();
+				}
+				// sort by time of queueing to keep first come first serve within a level
+				queued.Sort((a, b) => a.EnqueuedTimestamp.CompareTo(b.EnqueuedTimestamp));
+				foreach (Fetch fetch in queued)
+				{
+					fetch.Priority = fetch.Prefetch ? PREFETCH_PRIORITY : GetPriority(fetch.TileId);
+					fetch.QueueNode = _queues[fetch.Priority].AddLast(fetch);
+				}
+			}
+		}
+
+
+		/// <summary>
+		/// <para>Priority level of a tile, 0 is served first.</para>
+		/// <para>Based on the distance in tiles to the focus tile at the lower zoom level of the two:
+		/// 0: focus tile and direct neighbours, 1: up to 3 tiles, 2: up to 7 tiles, 3: further away.</para>
+		/// <para>Without a focus all tiles get level 0.</para>
+		/// </summary>
+		public int GetPriority(CanonicalTileId tileId)
+		{
+			if (!_hasFocus) { return 0; }
+
+			int zoom = Math.Min(tileId.Z, _focus.Z);
+			int tileShift = tileId.Z - zoom;
+			int focusShift = _focus.Z - zoom;
+
+			int tilesAtZoom = 1 << zoom;
+			int dx = Math.Abs((tileId.X >> tileShift) - (_focus.X >> focusShift));
+			// tiles wrap around the antimeridian
+			dx = Math.Min(dx, tilesAtZoom - dx);
+			int dy = Math.Abs((tileId.Y >> tileShift) - (_focus.Y >> focusShift));
+			int distance = Math.Max(dx, dy);
+
+			if (distance <= 1) { return 0; }
+			if (distance <= 3) { return 1; }
+			if (distance <= 7) { return 2; }
+			return 3;
+		}
+
+
+		/// <summary>
+		/// Requests a tile. If a fetch for <paramref name="url"/> is already queued or running the request is attached to it.
+		/// </summary>
+		/// <param name="prefetch">Fetch the tile when no other tiles are waiting, see <see cref="PREFETCH_PRIORITY"/>.</param>
+		/// <returns>Handle to cancel this request, the fetch continues as long as other requests wait for it.</returns>
+		public IAsyncRequest Request(string url, string tilesetId, CanonicalTileId tileId, int timeout, Action<Response> callback, bool prefetch = false)
+		{
+			TileRequest request;
+			lock (_lock)
+			{
+				Fetch fetch;
+				if (_fetches.TryGetValue(url, out fetch))
+				{
+					_coalesced++;
+					if (!prefetch) { fetch.Prefetch = false; }
+					// a closer requester bumps a queued fetch
+					int priority = prefetch ? PREFETCH_PRIORITY : GetPriority(tileId);
+					if (null != fetch.QueueNode && priority < fetch.Priority)
+					{
+						_queues[fetch.Priority].Remove(fetch.QueueNode);
+						fetch.Priority = priority;
+						fetch.QueueNode = _queues[priority].AddLast(fetch);
+					}
+				}
+				else
+				{
+					fetch = new Fetch()
+					{
+						Url = url,
+						TilesetId = tilesetId,
+						TileId = tileId,
+						Timeout = timeout,
+						Prefetch = prefetch,
+						Priority = prefetch ? PREFETCH_PRIORITY : GetPriority(tileId),
+						EnqueuedTimestamp = Stopwatch.GetTimestamp()
+					};
+					fetch.QueueNode = _queues[fetch.Priority].AddLast(fetch);
+					_fetches.Add(url, fetch);
+				}
+
+				request = new TileRequest(this, fetch, callback);
+				fetch.Requesters.Add(request);
+			}
+
+			pump();
+			return request;
+		}
+
+
+		/// <summary>Snapshot of the statistics of all priority levels.</summary>
+		public TileRequestStats[] GetStats()
+		{
+			TileRequestStats[] stats = new TileRequestStats[PRIORITY_LEVELS];
+			lock (_lock)
+			{
+				for (int i = 0; i < PRIORITY_LEVELS; i++)
+				{
+					stats[i] = getStats(i);
+				}
+			}
+			return stats;
+		}
+
+
+		/// <summary>Snapshot of the statistics of the prefetch level.</summary>
+		public TileRequestStats GetPrefetchStats()
+		{
+			lock (_lock)
+			{
+				return getStats(PREFETCH_PRIORITY);
+			}
+		}
+
+
+		// call with lock held
+		private TileRequestStats getStats(int priority)
+		{
+			LevelStats level = _stats[priority];
+			return new TileRequestStats()
+			{
+				Priority = priority,
+				QueueDepth = _queues[priority].Count,
+				Dispatched = level.Dispatched,
+				Canceled = level.Canceled,
+				AverageWaitMilliseconds = 0 == level.Dispatched ? 0 : level.TotalWaitMilliseconds / level.Dispatched,
+				MaxWaitMilliseconds = level.MaxWaitMilliseconds,
+				AverageFetchMilliseconds = 0 == level.Fetched ? 0 : level.TotalFetchMilliseconds / level.Fetched
+			};
+		}
+
+
+		/// <summary>Drops all queued fetches and aborts running ones without calling back.</summary>
+		public void Clear()
+		{
+			List<IAsyncRequest> toAbort = new List<IAsyncRequest>();
+			lock (_lock)
+			{
+				foreach (Fetch fetch in _fetches.Values)
+				{
+					fetch.Done = true;
+					fetch.Aborted = true;
+					fetch.QueueNode = null;
+					foreach (TileRequest requester in fetch.Requesters) { requester.IsCompleted = true; }
+					fetch.Requesters.Clear();
+					if (null != fetch.Request) { toAbort.Add(fetch.Request); }
+				}
+				_fetches.Clear();
+				for (int i = 0; i < _queues.Length; i++) { _queues[i].Clear(); }
+				_running = 0;
+				_runningPrefetches = 0;
+			}
+
+			foreach (IAsyncRequest request in toAbort) { request.Cancel(); }
+		}
+
+
+		private void cancel(TileRequest request)
+		{
+			IAsyncRequest toAbort = null;
+			bool slotFreed = false;
+			lock (_lock)
+			{
+				Fetch fetch = request.Fetch;
+				if (request.IsCompleted || fetch.Done) { return; }
+
+				request.IsCompleted = true;
+				fetch.Requesters.Remove(request);
+				if (fetch.Requesters.Count > 0) { return; }
+
+				// nobody is waiting anymore
+				if (null != fetch.QueueNode)
+				{
+					_queues[fetch.Priority].Remove(fetch.QueueNode);
+					fetch.QueueNode = null;
+					_stats[fetch.Priority].Canceled++;
+					fetch.Done = true;
+					_fetches.Remove(fetch.Url);
+					return;
+				}
+
+				if (fetch.Running)
+				{
+					// free the slot right away, the aborted request might still call back
+					finish(fetch);
+					fetch.Aborted = true;
+					slotFreed = true;
+					// if null the fetch is being started right now, 'pump()' aborts it after the start
+					toAbort = fetch.Request;
+				}
+			}
+
+			if (null != toAbort) { toAbort.Cancel(); }
+			if (slotFreed) { pump(); }
+		}
+
+
+		// call with lock held
+		private void finish(Fetch fetch)
+		{
+			fetch.Done = true;
+			if (fetch.Running)
+			{
+				fetch.Running = false;
+				_running--;
+				if (fetch.RunningAsPrefetch)
+				{
+					fetch.RunningAsPrefetch = false;
+					_runningPrefetches--;
+				}
+			}
+			Fetch registered;
+			if (_fetches.TryGetValue(fetch.Url, out registered) && registered == fetch)
+			{
+				_fetches.Remove(fetch.Url);
+			}
+		}
+
+
+		private void pump()
+		{
+			List<Fetch> toStart = null;
+			lock (_lock)
+			{
+				while (0 == _maxConcurrentRequests || _running < _maxConcurrentRequests)
+				{
+					Fetch next = null;
+					for (int i = 0; i < _queues.Length; i++)
+					{
+						if (PREFETCH_PRIORITY == i && _runningPrefetches >= _maxConcurrentPrefetches) { break; }
+						if (_queues[i].Count > 0)
+						{
+							next = _queues[i].First.Value;
+							_queues[i].RemoveFirst();
+							break;
+						}
+					}
+					if (null == next) { break; }
+
+					next.QueueNode = null;
+					next.Running = true;
+					next.DispatchedTimestamp = Stopwatch.GetTimestamp();
+					_running++;
+					if (PREFETCH_PRIORITY == next.Priority)
+					{
+						next.RunningAsPrefetch = true;
+						_runningPrefetches++;
+					}
+
+					LevelStats level = _stats[next.Priority];
+					double waitMilliseconds = elapsedMilliseconds(next.EnqueuedTimestamp, next.DispatchedTimestamp);
+					level.Dispatched++;
+					level.TotalWaitMilliseconds += waitMilliseconds;
+					level.MaxWaitMilliseconds = Math.Max(level.MaxWaitMilliseconds, waitMilliseconds);
+
+					if (null == toStart) { toStart = new List<Fetch>(); }
+					toStart.Add(next);
+				}
+			}
+
+			if (null == toStart) { return; }
+
+			foreach (Fetch fetch in toStart)
+			{
+				Fetch captured = fetch;
+				IAsyncRequest request = _startFetch(fetch.Url, fetch.TilesetId, fetch.TileId, fetch.Timeout, (Response response) => onFetched(captured, response));
+				bool abort;
+				lock (_lock)
+				{
+					fetch.Request = request;
+					// all requesters canceled while the fetch was being started
+					abort = fetch.Aborted;
+				}
+				if (abort && null != request)
+				{
+					request.Cancel();
+				}
+			}
+		}
+
+
+		private void onFetched(Fetch fetch, Response response)
+		{
+			TileRequest[] requesters;
+			lock (_lock)
+			{
+				// canceled or cleared meanwhile
+				if (fetch.Done) { return; }
+
+				LevelStats level = _stats[fetch.Priority];
+				level.Fetched++;
+				level.TotalFetchMilliseconds += elapsedMilliseconds(fetch.DispatchedTimestamp, Stopwatch.GetTimestamp());
+
+				finish(fetch);
+				requesters = fetch.Requesters.ToArray();
+				fetch.Requesters.Clear();
+				foreach (TileRequest requester in requesters) { requester.IsCompleted = true; }
+			}
+
+			try
+			{
+				foreach (TileRequest requester in requesters)
+				{
+					if (null != requester.Callback) { requester.Callback(response); }
+				}
+			}
+			finally
+			{
+				pump();
+			}
+		}
+
+
+		private static double elapsedMilliseconds(long fromTimestamp, long toTimestamp)
+		{
+			return (toTimestamp - fromTimestamp) * 1000.0 / Stopwatch.Frequency;
+		}
+	}
+}
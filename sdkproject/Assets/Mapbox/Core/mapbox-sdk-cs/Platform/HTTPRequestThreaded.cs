@@ -49,7 +49,7 @@ namespace Mapbox.Platform {
 #endif
 		private int _timeOut;
 		private string _requestUrl;
-		private readonly string _userAgent = "mapbox-sdk-cs";
+		private readonly string _userAgent = Constants.UserAgent;
 
 
 		/// <summary>
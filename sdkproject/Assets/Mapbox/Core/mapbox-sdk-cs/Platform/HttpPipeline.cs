@@ -0,0 +1,1185 @@
+//-----------------------------------------------------------------------
+// <copyright file="HttpPipeline.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+#if !UNITY_WEBGL && !NETFX_CORE
+
+namespace Mapbox.Platform
+{
+
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using System.Net;
+	using System.Net.Security;
+	using System.Net.Sockets;
+	using System.Security.Cryptography.X509Certificates;
+	using System.Text;
+	using System.Threading;
+	using Mapbox.IO.Compression;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+
+
+	/// <summary>
+	/// <para>HTTP/1.1 client running all requests on a single I/O thread.</para>
+	/// <para>Connections are kept alive and pooled per host, requests to a host are pipelined on them.
+	/// Sockets and TLS streams are driven by their asynchronous Begin/End methods, so no thread is blocked waiting
+	/// for DNS, connect or data, the I/O thread only parses responses and hands them out.</para>
+	/// <para>gzip/deflate responses are decompressed straight into the final array when the size is known,
+	/// receive and decompression buffers come from <see cref="ByteArrayPool.Shared"/>. gzip bodies are also handed out
+	/// as received in <see cref="Response.CompressedData"/>, for caches to store.</para>
+	/// </summary>
+	public sealed class HttpPipeline : IDisposable
+	{
+
+
+		public const int DEFAULT_MAX_CONNECTIONS_PER_HOST = 6;
+		public const int DEFAULT_MAX_PIPELINE_DEPTH = 4;
+
+		private const int READ_BUFFER_SIZE = 16 * 1024;
+		private const int MAX_HEAD_BYTES = 64 * 1024;
+		private const int MAX_REDIRECTS = 5;
+		/// <summary>a request is sent at most this often when connections drop before its response arrived</summary>
+		private const int MAX_ATTEMPTS = 3;
+		private const int IDLE_CONNECTION_SECONDS = 30;
+		private const int DNS_CACHE_SECONDS = 300;
+		private const int TIMER_MILLISECONDS = 50;
+
+
+		private enum ParseState
+		{
+			Head,
+			Body,
+			ChunkSize,
+			ChunkData,
+			ChunkDataEnd,
+			Trailers,
+			UntilClose
+		}
+
+
+		private sealed class Exchange : IAsyncRequest
+		{
+			public HttpPipeline Pipeline;
+			public Uri Uri;
+			public Action<Response> Callback;
+			public HttpRequestType Type;
+			public long Deadline;
+			public int Attempts;
+			public int Redirects;
+			public HostPool Host;
+			public LinkedListNode<Exchange> PendingNode;
+			public long StartTimestamp;
+			private volatile bool _canceled;
+			private volatile bool _completed;
+
+			public bool IsCompleted { get { return _completed; } set { _completed = value; } }
+
+			public bool Canceled { get { return _canceled; } }
+
+			public HttpRequestType RequestType { get { return Type; } }
+
+			public void Cancel()
+			{
+				_canceled = true;
+				Pipeline.post(() => Pipeline.cancel(this));
+			}
+		}
+
+
+		private sealed class HostPool
+		{
+			public string Key;
+			public string Host;
+			public int Port;
+			public bool Secure;
+			public IPAddress[] Addresses;
+			public long AddressesResolved;
+			public readonly LinkedList<Exchange> Pending = new LinkedList<Exchange>();
+			public readonly List<Connection> Connections = new List<Connection>();
+		}
+
+
+		private sealed class Connection
+		{
+			public HostPool Host;
+			public Socket Socket;
+			public Stream Stream;
+			public bool Connected;
+			public bool Closed;
+			public bool Reading;
+			public bool Writing;
+			/// <summary>server answered once without closing, requests may be pipelined</summary>
+			public bool KeepAliveConfirmed;
+			public long LastActivity;
+			public readonly Queue<Exchange> InFlight = new Queue<Exchange>();
+			public readonly StringBuilder Outgoing = new StringBuilder();
+			public byte[] ReadBuffer;
+
+			// response parser
+			public ParseState State;
+			public byte[] Head;
+			public int HeadLength;
+			public int StatusCode;
+			public bool HttpOneZero;
+			public Dictionary<string, string> Headers;
+			public string ContentEncoding;
+			public bool ResponseClose;
+			public long Remaining;
+			public byte[] Body;
+			public int BodyLength;
+			public bool BodyPooled;
+		}
+
+
+		private readonly object _lock = new object();
+		private readonly AutoResetEvent _signal = new AutoResetEvent(false);
+		private List<Action> _posted = new List<Action>();
+		private List<Action> _processing = new List<Action>();
+		private readonly Dictionary<string, HostPool> _hosts = new Dictionary<string, HostPool>();
+		private readonly Action<Action> _dispatch;
+		private readonly int _maxConnectionsPerHost;
+		private readonly int _maxPipelineDepth;
+		private readonly string _userAgent;
+		private readonly ByteArrayPool _pool = ByteArrayPool.Shared;
+		private Thread _thread;
+		private volatile bool _disposed;
+
+		private int _connectionsOpened;
+		private int _requestsSent;
+		private int _pipelinedRequests;
+		private int _retries;
+
+
+		/// <param name="maxConnectionsPerHost">Maximum number of open connections to one host.</param>
+		/// <param name="maxPipelineDepth">Maximum number of requests sent on a connection before their responses arrived, 1 disables pipelining.</param>
+		/// <param name="dispatch">Runs the response callbacks, eg on the main thread. null: callbacks run on the I/O thread and must return quickly.</param>
+		/// <param name="userAgent">'User-Agent' header of all requests, null: <see cref="Constants.UserAgent"/>.</param>
+		public HttpPipeline(int maxConnectionsPerHost = DEFAULT_MAX_CONNECTIONS_PER_HOST, int maxPipelineDepth = DEFAULT_MAX_PIPELINE_DEPTH, Action<Action> dispatch = null, string userAgent = null)
+		{
+			_maxConnectionsPerHost = Math.Max(1, maxConnectionsPerHost);
+			_maxPipelineDepth = Math.Max(1, maxPipelineDepth);
+			_dispatch = dispatch;
+			_userAgent = string.IsNullOrEmpty(userAgent) ? Constants.UserAgent : userAgent;
+
+			_thread = new Thread(run);
+			_thread.Name = "Mapbox HTTP pipeline";
+			_thread.IsBackground = true;
+			_thread.Start();
+		}
+
+
+		/// <summary>Connections opened since creation.</summary>
+		public int ConnectionsOpened { get { return Thread.VolatileRead(ref _connectionsOpened); } }
+		/// <summary>Requests written to a connection, including retries and redirects.</summary>
+		public int RequestsSent { get { return Thread.VolatileRead(ref _requestsSent); } }
+		/// <summary>Requests sent while earlier responses on the same connection were still outstanding.</summary>
+		public int PipelinedRequests { get { return Thread.VolatileRead(ref _pipelinedRequests); } }
+		/// <summary>Requests sent again because their connection was closed before the response arrived.</summary>
+		public int Retries { get { return Thread.VolatileRead(ref _retries); } }
+
+
+		/// <summary>Starts a request. <paramref name="callback"/> is not called if the request is canceled.</summary>
+		/// <param name="timeout">seconds</param>
+		public IAsyncRequest Request(string url, Action<Response> callback, int timeout = 10, HttpRequestType requestType = HttpRequestType.Get)
+		{
+			Exchange exchange = new Exchange()
+			{
+				Pipeline = this,
+				Uri = new Uri(url),
+				Callback = callback,
+				Type = requestType,
+				StartTimestamp = Stopwatch.GetTimestamp()
+			};
+			exchange.Deadline = exchange.StartTimestamp + (long)Math.Max(1, timeout) * Stopwatch.Frequency;
+
+			post(() => enqueue(exchange, false));
+			return exchange;
+		}
+
+
+		public void Dispose()
+		{
+			if (_disposed) { return; }
+			_disposed = true;
+			_signal.Set();
+			if (null != _thread && Thread.CurrentThread != _thread)
+			{
+				_thread.Join(2000);
+			}
+			_thread = null;
+		}
+
+
+		#region I/O loop
+
+
+		private void post(Action action)
+		{
+			lock (_lock)
+			{
+				_posted.Add(action);
+			}
+			_signal.Set();
+		}
+
+
+		private void run()
+		{
+			long nextTimerCheck = 0;
+			while (!_disposed)
+			{
+				lock (_lock)
+				{
+					List<Action> swap = _processing;
+					_processing = _posted;
+					_posted = swap;
+				}
+
+				for (int i = 0; i < _processing.Count; i++)
+				{
+					try
+					{
+						_processing[i]();
+					}
+					catch (Exception ex)
+					{
+						System.Diagnostics.Debug.WriteLine(ex);
+					}
+				}
+				_processing.Clear();
+
+				long now = Stopwatch.GetTimestamp();
+				if (now >= nextTimerCheck)
+				{
+					checkTimers(now);
+					nextTimerCheck = now + Stopwatch.Frequency * TIMER_MILLISECONDS / 1000;
+				}
+
+				bool idle;
+				lock (_lock) { idle = 0 == _posted.Count; }
+				if (idle) { _signal.WaitOne(TIMER_MILLISECONDS, false); }
+			}
+
+			foreach (HostPool host in _hosts.Values)
+			{
+				foreach (Connection connection in host.Connections.ToArray())
+				{
+					closeConnection(connection, null, false);
+				}
+				host.Pending.Clear();
+			}
+			_hosts.Clear();
+		}
+
+
+		private void enqueue(Exchange exchange, bool atFront)
+		{
+			if (exchange.Canceled) { return; }
+
+			Uri uri = exchange.Uri;
+			bool secure = uri.Scheme.Equals("https", StringComparison.OrdinalIgnoreCase);
+			if (!secure && !uri.Scheme.Equals("http", StringComparison.OrdinalIgnoreCase))
+			{
+				fail(exchange, new NotSupportedException("Unsupported scheme: " + uri.Scheme));
+				return;
+			}
+
+			string key = uri.Scheme + "://" + uri.Host + ":" + uri.Port;
+			HostPool host;
+			if (!_hosts.TryGetValue(key, out host))
+			{
+				host = new HostPool() { Key = key, Host = uri.Host, Port = uri.Port, Secure = secure };
+				_hosts.Add(key, host);
+			}
+
+			exchange.Host = host;
+			exchange.PendingNode = atFront ? host.Pending.AddFirst(exchange) : host.Pending.AddLast(exchange);
+			pump(host);
+		}
+
+
+		private void cancel(Exchange exchange)
+		{
+			// queued requests are dropped, requests on the wire are skipped once their response arrives
+			if (null != exchange.PendingNode)
+			{
+				exchange.Host.Pending.Remove(exchange.PendingNode);
+				exchange.PendingNode = null;
+			}
+			exchange.IsCompleted = true;
+		}
+
+
+		/// <summary>Assigns pending requests to connections and opens connections if needed.</summary>
+		private void pump(HostPool host)
+		{
+			while (host.Pending.Count > 0)
+			{
+				Connection best = null;
+				for (int i = 0; i < host.Connections.Count; i++)
+				{
+					Connection connection = host.Connections[i];
+					if (!connection.Connected || connection.Closed || connection.ResponseClose) { continue; }
+					int depth = connection.KeepAliveConfirmed ? _maxPipelineDepth : 1;
+					if (connection.InFlight.Count >= depth) { continue; }
+					if (null == best || connection.InFlight.Count < best.InFlight.Count) { best = connection; }
+				}
+				if (null == best) { break; }
+
+				Exchange exchange = host.Pending.First.Value;
+				host.Pending.RemoveFirst();
+				exchange.PendingNode = null;
+				send(best, exchange);
+			}
+
+			if (host.Pending.Count == 0) { return; }
+
+			int connecting = 0;
+			for (int i = 0; i < host.Connections.Count; i++)
+			{
+				if (!host.Connections[i].Connected) { connecting++; }
+			}
+			while (host.Connections.Count < _maxConnectionsPerHost && connecting < host.Pending.Count)
+			{
+				openConnection(host);
+				connecting++;
+			}
+		}
+
+
+		private void send(Connection connection, Exchange exchange)
+		{
+			if (connection.InFlight.Count > 0) { Interlocked.Increment(ref _pipelinedRequests); }
+			Interlocked.Increment(ref _requestsSent);
+			exchange.Attempts++;
+			connection.InFlight.Enqueue(exchange);
+
+			Uri uri = exchange.Uri;
+			StringBuilder sb = connection.Outgoing;
+			sb.Append(exchange.Type == HttpRequestType.Head ? "HEAD " : "GET ");
+			sb.Append(uri.PathAndQuery);
+			sb.Append(" HTTP/1.1\r\nHost: ");
+			sb.Append(uri.Host);
+			if (!uri.IsDefaultPort)
+			{
+				sb.Append(':');
+				sb.Append(uri.Port.ToString(CultureInfo.InvariantCulture));
+			}
+			sb.Append("\r\nUser-Agent: ");
+			sb.Append(_userAgent);
+			sb.Append("\r\nAccept-Encoding: gzip, deflate\r\nConnection: keep-alive\r\n\r\n");
+
+			// requests assigned in the same pass go out in one write
+			if (!connection.Writing)
+			{
+				connection.Writing = true;
+				post(() => writeNext(connection));
+			}
+		}
+
+
+		private void checkTimers(long now)
+		{
+			long idleLimit = now - IDLE_CONNECTION_SECONDS * Stopwatch.Frequency;
+			List<Exchange> expired = null;
+			List<Connection> toClose = null;
+
+			foreach (HostPool host in _hosts.Values)
+			{
+				for (LinkedListNode<Exchange> node = host.Pending.First; null != node; node = node.Next)
+				{
+					if (node.Value.Deadline <= now)
+					{
+						if (null == expired) { expired = new List<Exchange>(); }
+						expired.Add(node.Value);
+					}
+				}
+
+				for (int i = 0; i < host.Connections.Count; i++)
+				{
+					Connection connection = host.Connections[i];
+					bool headTimedOut = connection.InFlight.Count > 0 && connection.InFlight.Peek().Deadline <= now;
+					bool idle = connection.Connected && connection.InFlight.Count == 0 && connection.LastActivity < idleLimit;
+					if (headTimedOut || idle)
+					{
+						if (null == toClose) { toClose = new List<Connection>(); }
+						toClose.Add(connection);
+					}
+				}
+			}
+
+			if (null != expired)
+			{
+				foreach (Exchange exchange in expired)
+				{
+					exchange.Host.Pending.Remove(exchange.PendingNode);
+					exchange.PendingNode = null;
+					fail(exchange, new TimeoutException("Request timed out"));
+				}
+			}
+
+			if (null != toClose)
+			{
+				foreach (Connection connection in toClose)
+				{
+					// responses are in order: the others on this connection can't arrive before the one that timed out
+					if (connection.InFlight.Count > 0)
+					{
+						fail(connection.InFlight.Dequeue(), new TimeoutException("Request timed out"));
+					}
+					closeConnection(connection, null, true);
+				}
+			}
+		}
+
+
+		#endregion
+
+
+		#region connections
+
+
+		private void openConnection(HostPool host)
+		{
+			Connection connection = new Connection()
+			{
+				Host = host,
+				LastActivity = Stopwatch.GetTimestamp()
+			};
+			host.Connections.Add(connection);
+			Interlocked.Increment(ref _connectionsOpened);
+
+			long now = Stopwatch.GetTimestamp();
+			if (null != host.Addresses && now - host.AddressesResolved < DNS_CACHE_SECONDS * Stopwatch.Frequency)
+			{
+				connect(connection, host.Addresses);
+				return;
+			}
+
+			try
+			{
+				Dns.BeginGetHostAddresses(host.Host, (IAsyncResult ar) =>
+				{
+					IPAddress[] addresses = null;
+					Exception error = null;
+					try { addresses = Dns.EndGetHostAddresses(ar); }
+					catch (Exception ex) { error = ex; }
+					post(() =>
+					{
+						if (connection.Closed) { return; }
+						if (null != error || null == addresses || 0 == addresses.Length)
+						{
+							connectFailed(connection, error ?? new IOException("Could not resolve " + host.Host));
+							return;
+						}
+						host.Addresses = addresses;
+						host.AddressesResolved = Stopwatch.GetTimestamp();
+						connect(connection, addresses);
+					});
+				}, null);
+			}
+			catch (Exception ex)
+			{
+				connectFailed(connection, ex);
+			}
+		}
+
+
+		private void connect(Connection connection, IPAddress[] addresses)
+		{
+			// prefer IPv4, the socket is bound to one address family
+			IPAddress address = addresses[0];
+			for (int i = 0; i < addresses.Length; i++)
+			{
+				if (addresses[i].AddressFamily == AddressFamily.InterNetwork) { address = addresses[i]; break; }
+			}
+
+			try
+			{
+				Socket socket = new Socket(address.AddressFamily, SocketType.Stream, ProtocolType.Tcp);
+				socket.NoDelay = true;
+				connection.Socket = socket;
+				socket.BeginConnect(address, connection.Host.Port, (IAsyncResult ar) =>
+				{
+					Exception error = null;
+					try { socket.EndConnect(ar); }
+					catch (Exception ex) { error = ex; }
+					post(() =>
+					{
+						if (connection.Closed) { return; }
+						if (null != error) { connectFailed(connection, error); return; }
+						if (connection.Host.Secure) { authenticate(connection); } else { connected(connection, new NetworkStream(socket, true)); }
+					});
+				}, null);
+			}
+			catch (Exception ex)
+			{
+				connectFailed(connection, ex);
+			}
+		}
+
+
+		private void authenticate(Connection connection)
+		{
+			try
+			{
+				SslStream ssl = new SslStream(new NetworkStream(connection.Socket, true), false, validateCertificate);
+				connection.Stream = ssl;
+				ssl.BeginAuthenticateAsClient(connection.Host.Host, (IAsyncResult ar) =>
+				{
+					Exception error = null;
+					try { ssl.EndAuthenticateAsClient(ar); }
+					catch (Exception ex) { error = ex; }
+					post(() =>
+					{
+						if (connection.Closed) { return; }
+						if (null != error) { connectFailed(connection, error); return; }
+						connected(connection, ssl);
+					});
+				}, null);
+			}
+			catch (Exception ex)
+			{
+				connectFailed(connection, ex);
+			}
+		}
+
+
+		private static bool validateCertificate(object sender, X509Certificate certificate, X509Chain chain, SslPolicyErrors sslPolicyErrors)
+		{
+			// honor application wide overrides the same way HttpWebRequest does
+			RemoteCertificateValidationCallback callback = ServicePointManager.ServerCertificateValidationCallback;
+			if (null != callback) { return callback(sender, certificate, chain, sslPolicyErrors); }
+			return SslPolicyErrors.None == sslPolicyErrors;
+		}
+
+
+		private void connected(Connection connection, Stream stream)
+		{
+			connection.Stream = stream;
+			connection.Connected = true;
+			connection.LastActivity = Stopwatch.GetTimestamp();
+			connection.ReadBuffer = _pool.Rent(READ_BUFFER_SIZE);
+			connection.Head = _pool.Rent(4096);
+			resetParser(connection);
+			beginRead(connection);
+			pump(connection.Host);
+		}
+
+
+		private void connectFailed(Connection connection, Exception error)
+		{
+			HostPool host = connection.Host;
+			closeConnection(connection, null, false);
+
+			// requests waiting for this host count the failed attempt, unless another connection can serve them
+			bool otherConnections = false;
+			foreach (Connection other in host.Connections)
+			{
+				if (other.Connected) { otherConnections = true; break; }
+			}
+			if (!otherConnections)
+			{
+				List<Exchange> failed = new List<Exchange>();
+				foreach (Exchange exchange in host.Pending)
+				{
+					exchange.Attempts++;
+					if (exchange.Attempts >= MAX_ATTEMPTS) { failed.Add(exchange); }
+				}
+				foreach (Exchange exchange in failed)
+				{
+					host.Pending.Remove(exchange.PendingNode);
+					exchange.PendingNode = null;
+					fail(exchange, error);
+				}
+			}
+			pump(host);
+		}
+
+
+		/// <param name="error">null: requests on the wire are sent again on another connection</param>
+		/// <param name="pumpHost">open replacement connections for remaining requests</param>
+		private void closeConnection(Connection connection, Exception error, bool pumpHost)
+		{
+			if (connection.Closed) { return; }
+			connection.Closed = true;
+			connection.Host.Connections.Remove(connection);
+
+			try
+			{
+				if (null != connection.Stream) { connection.Stream.Close(); }
+				else if (null != connection.Socket) { connection.Socket.Close(); }
+			}
+			catch (Exception ex)
+			{
+				System.Diagnostics.Debug.WriteLine(ex);
+			}
+
+			// the read buffer is still in use by a pending read, 'onRead' returns it
+			if (!connection.Reading && null != connection.ReadBuffer)
+			{
+				_pool.Return(connection.ReadBuffer);
+				connection.ReadBuffer = null;
+			}
+			releaseBody(connection);
+			if (null != connection.Head)
+			{
+				_pool.Return(connection.Head);
+				connection.Head = null;
+			}
+
+			// requests without a response: retry in original order at the front of the queue
+			Exchange[] unanswered = connection.InFlight.ToArray();
+			connection.InFlight.Clear();
+			for (int i = unanswered.Length - 1; i >= 0; i--)
+			{
+				Exchange exchange = unanswered[i];
+				if (exchange.Canceled || _disposed) { continue; }
+				// only the first one was waiting for its response, the ones pipelined behind it don't count as attempt
+				if (i > 0) { exchange.Attempts--; }
+				if (null == error && exchange.Attempts < MAX_ATTEMPTS)
+				{
+					Interlocked.Increment(ref _retries);
+					exchange.PendingNode = connection.Host.Pending.AddFirst(exchange);
+				}
+				else
+				{
+					fail(exchange, error ?? new IOException("Connection closed before the response was received"));
+				}
+			}
+
+			if (pumpHost && !_disposed) { pump(connection.Host); }
+		}
+
+
+		private void beginRead(Connection connection)
+		{
+			Stream stream = connection.Stream;
+			byte[] buffer = connection.ReadBuffer;
+			connection.Reading = true;
+			try
+			{
+				stream.BeginRead(buffer, 0, buffer.Length, (IAsyncResult ar) =>
+				{
+					int read = 0;
+					Exception error = null;
+					try { read = stream.EndRead(ar); }
+					catch (Exception ex) { error = ex; }
+					post(() => onRead(connection, read, error));
+				}, null);
+			}
+			catch (Exception ex)
+			{
+				post(() => onRead(connection, 0, ex));
+			}
+		}
+
+
+		private void onRead(Connection connection, int read, Exception error)
+		{
+			connection.Reading = false;
+			if (connection.Closed)
+			{
+				_pool.Return(connection.ReadBuffer);
+				connection.ReadBuffer = null;
+				return;
+			}
+
+			if (null != error || 0 == read)
+			{
+				// body delimited by the end of the connection
+				if (connection.State == ParseState.UntilClose && connection.InFlight.Count > 0)
+				{
+					completeResponse(connection);
+				}
+				closeConnection(connection, null, true);
+				return;
+			}
+
+			connection.LastActivity = Stopwatch.GetTimestamp();
+			try
+			{
+				parse(connection, connection.ReadBuffer, read);
+			}
+			catch (Exception ex)
+			{
+				// malformed response: the connection is out of sync, fail the current request and retry the others
+				if (connection.InFlight.Count > 0) { fail(connection.InFlight.Dequeue(), ex); }
+				closeConnection(connection, null, true);
+				return;
+			}
+
+			if (!connection.Closed) { beginRead(connection); }
+		}
+
+
+		private void writeNext(Connection connection)
+		{
+			if (connection.Closed) { return; }
+			if (0 == connection.Outgoing.Length)
+			{
+				connection.Writing = false;
+				return;
+			}
+
+			byte[] bytes = Encoding.ASCII.GetBytes(connection.Outgoing.ToString());
+			connection.Outgoing.Length = 0;
+			connection.Writing = true;
+
+			Stream stream = connection.Stream;
+			try
+			{
+				stream.BeginWrite(bytes, 0, bytes.Length, (IAsyncResult ar) =>
+				{
+					Exception error = null;
+					try { stream.EndWrite(ar); }
+					catch (Exception ex) { error = ex; }
+					post(() =>
+					{
+						if (null != error) { closeConnection(connection, null, true); return; }
+						writeNext(connection);
+					});
+				}, null);
+			}
+			catch (Exception)
+			{
+				closeConnection(connection, null, true);
+			}
+		}
+
+
+		#endregion
+
+
+		#region response parsing
+
+
+		private void resetParser(Connection connection)
+		{
+			connection.State = ParseState.Head;
+			connection.HeadLength = 0;
+			connection.StatusCode = 0;
+			connection.HttpOneZero = false;
+			connection.Headers = null;
+			connection.ContentEncoding = null;
+			connection.Remaining = 0;
+			releaseBody(connection);
+		}
+
+
+		private void releaseBody(Connection connection)
+		{
+			if (connection.BodyPooled && null != connection.Body) { _pool.Return(connection.Body); }
+			connection.Body = null;
+			connection.BodyLength = 0;
+			connection.BodyPooled = false;
+		}
+
+
+		private void parse(Connection connection, byte[] buffer, int count)
+		{
+			int offset = 0;
+			while (offset < count && !connection.Closed)
+			{
+				if (0 == connection.InFlight.Count)
+				{
+					throw new IOException("Unexpected data from server");
+				}
+
+				switch (connection.State)
+				{
+					case ParseState.Head:
+					case ParseState.ChunkSize:
+					case ParseState.ChunkDataEnd:
+					case ParseState.Trailers:
+						{
+							int lineEnd;
+							offset = appendLine(connection, buffer, offset, count, out lineEnd);
+							if (lineEnd < 0) { break; }
+							onLine(connection, lineEnd);
+							break;
+						}
+					case ParseState.Body:
+					case ParseState.ChunkData:
+						{
+							int take = (int)Math.Min(connection.Remaining, count - offset);
+							Buffer.BlockCopy(buffer, offset, connection.Body, connection.BodyLength, take);
+							connection.BodyLength += take;
+							connection.Remaining -= take;
+							offset += take;
+							if (0 == connection.Remaining)
+							{
+								if (connection.State == ParseState.Body)
+								{
+									completeResponse(connection);
+								}
+								else
+								{
+									connection.State = ParseState.ChunkDataEnd;
+									connection.HeadLength = 0;
+								}
+							}
+							break;
+						}
+					case ParseState.UntilClose:
+						{
+							int take = count - offset;
+							ensureBodyCapacity(connection, connection.BodyLength + take);
+							Buffer.BlockCopy(buffer, offset, connection.Body, connection.BodyLength, take);
+							connection.BodyLength += take;
+							offset += take;
+							break;
+						}
+				}
+			}
+		}
+
+
+		/// <summary>
+		/// Copies bytes into the line buffer until LF. For the response head the whole block up to the empty line is collected.
+		/// </summary>
+		/// <param name="lineEnd">length of the completed line or head in 'Head', -1 if more data is needed</param>
+		private int appendLine(Connection connection, byte[] buffer, int offset, int count, out int lineEnd)
+		{
+			lineEnd = -1;
+			while (offset < count)
+			{
+				if (connection.HeadLength == connection.Head.Length)
+				{
+					if (connection.Head.Length >= MAX_HEAD_BYTES) { throw new IOException("Response header too large"); }
+					byte[] larger = _pool.Rent(connection.Head.Length * 2);
+					Buffer.BlockCopy(connection.Head, 0, larger, 0, connection.HeadLength);
+					_pool.Return(connection.Head);
+					connection.Head = larger;
+				}
+
+				byte b = buffer[offset++];
+				connection.Head[connection.HeadLength++] = b;
+				if (b != (byte)'\n') { continue; }
+
+				if (connection.State == ParseState.Head)
+				{
+					// head ends with an empty line
+					int length = connection.HeadLength;
+					bool emptyLine = (length >= 2 && connection.Head[length - 2] == '\n')
+						|| (length >= 3 && connection.Head[length - 2] == '\r' && connection.Head[length - 3] == '\n');
+					// ignore empty lines before the status line
+					if (length <= 2 && (1 == length || connection.Head[0] == '\r'))
+					{
+						connection.HeadLength = 0;
+						continue;
+					}
+					if (!emptyLine) { continue; }
+				}
+
+				lineEnd = connection.HeadLength;
+				return offset;
+			}
+			return offset;
+		}
+
+
+		private void onLine(Connection connection, int length)
+		{
+			switch (connection.State)
+			{
+				case ParseState.Head:
+					onHead(connection, Encoding.ASCII.GetString(connection.Head, 0, length));
+					break;
+				case ParseState.ChunkSize:
+					{
+						string line = Encoding.ASCII.GetString(connection.Head, 0, length).Trim();
+						connection.HeadLength = 0;
+						int extension = line.IndexOf(';');
+						if (extension >= 0) { line = line.Substring(0, extension); }
+						long size = long.Parse(line, NumberStyles.HexNumber, CultureInfo.InvariantCulture);
+						if (0 == size)
+						{
+							connection.State = ParseState.Trailers;
+						}
+						else
+						{
+							if (connection.BodyLength + size > int.MaxValue) { throw new IOException("Response too large"); }
+							ensureBodyCapacity(connection, connection.BodyLength + (int)size);
+							connection.Remaining = size;
+							connection.State = ParseState.ChunkData;
+						}
+						break;
+					}
+				case ParseState.ChunkDataEnd:
+					// CRLF after chunk data
+					connection.HeadLength = 0;
+					connection.State = ParseState.ChunkSize;
+					break;
+				case ParseState.Trailers:
+					{
+						bool empty = length <= 2;
+						connection.HeadLength = 0;
+						if (empty) { completeResponse(connection); }
+						break;
+					}
+			}
+		}
+
+
+		private void onHead(Connection connection, string head)
+		{
+			string[] lines = head.Split('\n');
+			string statusLine = lines[0].TrimEnd('\r');
+			// HTTP/1.1 200 OK
+			string[] status = statusLine.Split(new char[] { ' ' }, 3);
+			int statusCode;
+			if (status.Length < 2 || !status[0].StartsWith("HTTP/", StringComparison.Ordinal) || !int.TryParse(status[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out statusCode))
+			{
+				throw new IOException("Invalid status line: " + statusLine);
+			}
+
+			connection.HeadLength = 0;
+
+			// informational responses precede the real one
+			if (statusCode >= 100 && statusCode < 200)
+			{
+				return;
+			}
+
+			connection.StatusCode = statusCode;
+			connection.HttpOneZero = status[0].Equals("HTTP/1.0", StringComparison.Ordinal);
+
+			Dictionary<string, string> headers = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+			for (int i = 1; i < lines.Length; i++)
+			{
+				string line = lines[i].TrimEnd('\r');
+				int colon = line.IndexOf(':');
+				if (colon <= 0) { continue; }
+				string key = line.Substring(0, colon).Trim();
+				string value = line.Substring(colon + 1).Trim();
+				string existing;
+				headers[key] = headers.TryGetValue(key, out existing) ? existing + ", " + value : value;
+			}
+			connection.Headers = headers;
+
+			string headerValue;
+			bool keepAlive = headers.TryGetValue("Connection", out headerValue)
+				? headerValue.IndexOf("keep-alive", StringComparison.OrdinalIgnoreCase) >= 0
+				: !connection.HttpOneZero;
+			bool close = headers.TryGetValue("Connection", out headerValue) && headerValue.IndexOf("close", StringComparison.OrdinalIgnoreCase) >= 0;
+			connection.ResponseClose = close || !keepAlive;
+
+			if (headers.TryGetValue("Content-Encoding", out headerValue))
+			{
+				connection.ContentEncoding = headerValue.ToLowerInvariant();
+			}
+
+			Exchange exchange = connection.InFlight.Peek();
+			if (exchange.Type == HttpRequestType.Head || 204 == statusCode || 304 == statusCode)
+			{
+				completeResponse(connection);
+				return;
+			}
+
+			if (headers.TryGetValue("Transfer-Encoding", out headerValue) && headerValue.IndexOf("chunked", StringComparison.OrdinalIgnoreCase) >= 0)
+			{
+				connection.State = ParseState.ChunkSize;
+				return;
+			}
+
+			long contentLength;
+			if (headers.TryGetValue("Content-Length", out headerValue) && long.TryParse(headerValue, NumberStyles.Integer, CultureInfo.InvariantCulture, out contentLength))
+			{
+				if (contentLength > int.MaxValue) { throw new IOException("Response too large"); }
+				if (0 == contentLength)
+				{
+					completeResponse(connection);
+					return;
+				}
+				if (isCompressed(connection))
+				{
+					ensureBodyCapacity(connection, (int)contentLength);
+				}
+				else
+				{
+					// uncompressed with known length: read straight into the array handed out
+					connection.Body = new byte[contentLength];
+					connection.BodyPooled = false;
+				}
+				connection.Remaining = contentLength;
+				connection.State = ParseState.Body;
+				return;
+			}
+
+			connection.ResponseClose = true;
+			connection.State = ParseState.UntilClose;
+		}
+
+
+		private void ensureBodyCapacity(Connection connection, int capacity)
+		{
+			if (null != connection.Body && connection.Body.Length >= capacity) { return; }
+
+			byte[] larger = _pool.Rent(Math.Max(capacity, null == connection.Body ? 8 * 1024 : connection.Body.Length * 2));
+			if (null != connection.Body)
+			{
+				Buffer.BlockCopy(connection.Body, 0, larger, 0, connection.BodyLength);
+				if (connection.BodyPooled) { _pool.Return(connection.Body); }
+			}
+			connection.Body = larger;
+			connection.BodyPooled = true;
+		}
+
+
+		private static bool isCompressed(Connection connection)
+		{
+			return "gzip" == connection.ContentEncoding || "deflate" == connection.ContentEncoding;
+		}
+
+
+		private void completeResponse(Connection connection)
+		{
+			Exchange exchange = connection.InFlight.Dequeue();
+			int statusCode = connection.StatusCode;
+			Dictionary<string, string> headers = connection.Headers;
+			bool close = connection.ResponseClose;
+			if (!close) { connection.KeepAliveConfirmed = true; }
+
+			byte[] data = null;
+			byte[] compressed = null;
+			Exception error = null;
+			if (exchange.Type != HttpRequestType.Head && !exchange.Canceled)
+			{
+				try
+				{
+					data = takeBody(connection, out compressed);
+				}
+				catch (Exception ex)
+				{
+					error = new IOException("Could not decompress response", ex);
+				}
+			}
+
+			resetParser(connection);
+			connection.ResponseClose = close;
+			if (close)
+			{
+				closeConnection(connection, null, true);
+			}
+			else
+			{
+				pump(connection.Host);
+			}
+
+			if (exchange.Canceled) { return; }
+
+			string location;
+			if (
+				(301 == statusCode || 302 == statusCode || 303 == statusCode || 307 == statusCode || 308 == statusCode)
+				&& null != headers
+				&& headers.TryGetValue("Location", out location)
+				&& exchange.Redirects < MAX_REDIRECTS
+			)
+			{
+				exchange.Redirects++;
+				exchange.Attempts = 0;
+				exchange.Uri = new Uri(exchange.Uri, location);
+				enqueue(exchange, true);
+				return;
+			}
+
+			deliver(exchange, Response.FromHttpPipeline(exchange, exchange.Uri.AbsoluteUri, statusCode, headers, data, compressed, error));
+		}
+
+
+		/// <summary>Final, exactly sized and decompressed body.</summary>
+		/// <param name="compressed">gzip body as received, null if the body wasn't gzip encoded</param>
+		private byte[] takeBody(Connection connection, out byte[] compressed)
+		{
+			byte[] body = connection.Body;
+			int length = connection.BodyLength;
+			compressed = null;
+
+			if (null == body) { return new byte[0]; }
+
+			if ("gzip" == connection.ContentEncoding)
+			{
+				byte[] data = Compression.Gunzip(body, 0, length);
+				compressed = copyBody(connection);
+				return data;
+			}
+			if ("deflate" == connection.ContentEncoding)
+			{
+				// most servers send zlib (RFC 1950) instead of raw deflate: skip the zlib header
+				int start = 0;
+				if (length >= 2 && (body[0] & 0x0f) == 8 && ((body[0] << 8) | body[1]) % 31 == 0) { start = 2; }
+				using (DeflateStream deflate = new DeflateStream(new MemoryStream(body, start, length - start, false), CompressionMode.Decompress))
+				using (PooledBuffer data = Compression.Inflate(deflate, length * 4))
+				{
+					return data.ToArray();
+				}
+			}
+
+			return copyBody(connection);
+		}
+
+
+		private byte[] copyBody(Connection connection)
+		{
+			byte[] body = connection.Body;
+			int length = connection.BodyLength;
+			if (!connection.BodyPooled && length == body.Length)
+			{
+				// ownership moves to the response
+				connection.Body = null;
+				connection.BodyLength = 0;
+				return body;
+			}
+
+			byte[] data = new byte[length];
+			Buffer.BlockCopy(body, 0, data, 0, length);
+			return data;
+		}
+
+
+		#endregion
+
+
+		private void fail(Exchange exchange, Exception error)
+		{
+			if (exchange.Canceled) { return; }
+			deliver(exchange, Response.FromHttpPipeline(exchange, exchange.Uri.AbsoluteUri, null, null, null, null, error));
+		}
+
+
+		private void deliver(Exchange exchange, Response response)
+		{
+			Action callback = () =>
+			{
+				if (exchange.Canceled) { return; }
+				if (null != exchange.Callback) { exchange.Callback(response); }
+				exchange.IsCompleted = true;
+			};
+
+			if (null == _dispatch)
+			{
+				try
+				{
+					callback();
+				}
+				catch (Exception ex)
+				{
+					System.Diagnostics.Debug.WriteLine(ex);
+				}
+			}
+			else
+			{
+				_dispatch(callback);
+			}
+		}
+	}
+}
+
+#endif
@@ -17,6 +17,18 @@ namespace Mapbox.Platform {
 	/// <summary> A handle to an asynchronous request. </summary>
 	public static class IAsyncRequestFactory {
 
+#if !UNITY && !NETFX_CORE
+		private static readonly object _lock = new object();
+		private static HttpPipeline _pipeline;
+#endif
+
+		/// <summary>
+		/// Send requests through the shared <see cref="HttpPipeline"/> instead of UnityWebRequest, or HttpWebRequest outside of Unity.
+		/// Ignored on WebGL and UWP.
+		/// </summary>
+		public static bool UseHttpPipeline = false;
+
+
 		public static IAsyncRequest CreateRequest(
 			string url
 			, Action<Response> callback
@@ -24,12 +36,31 @@ namespace Mapbox.Platform {
 			, HttpRequestType requestType= HttpRequestType.Get
 		) {
 #if !UNITY
+#if !NETFX_CORE
+			if (UseHttpPipeline) {
+				HttpPipeline pipeline;
+				lock (_lock) {
+					if (null == _pipeline) {
+						// post callbacks back to the calling (UI) thread like the HttpWebRequest implementations do
+						System.Threading.SynchronizationContext sync = System.ComponentModel.AsyncOperationManager.SynchronizationContext;
+						_pipeline = new HttpPipeline(dispatch: (Action deliver) => sync.Post(delegate { deliver(); }, null));
+					}
+					pipeline = _pipeline;
+				}
+				return pipeline.Request(url, callback, timeout, requestType);
+			}
+#endif
 			if (Environment.ProcessorCount > 2) {
 				return new HTTPRequestThreaded(url, callback, timeout);
 			} else {
 				return new HTTPRequestNonThreaded(url, callback, timeout);
 			}
 #else
+#if !UNITY_WEBGL && !NETFX_CORE
+			if (UseHttpPipeline) {
+				return Mapbox.Unity.Utilities.MainThreadHttpPipeline.Request(url, callback, timeout, requestType);
+			}
+#endif
 			return new Mapbox.Unity.Utilities.HTTPRequest(url, callback, timeout, requestType);
 #endif
 		}
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------
+// <copyright file="PooledBuffer.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.Platform
+{
+
+	using System;
+	using System.IO;
+	using System.Threading;
+
+
+	/// <summary>
+	/// <para>Reference counted bytes in an array rented from a <see cref="ByteArrayPool"/>.</para>
+	/// <para>The creator holds the first reference, everyone the buffer is handed to calls <see cref="Retain"/> and
+	/// <see cref="Release"/> (or <see cref="Dispose"/>) when done. The array goes back to the pool with the last release,
+	/// <see cref="Array"/> must not be touched afterwards. Only the first <see cref="Length"/> bytes are valid.</para>
+	/// </summary>
+	public sealed class PooledBuffer : IDisposable
+	{
+
+
+		private readonly ByteArrayPool _pool;
+		private byte[] _array;
+		private int _length;
+		private int _references = 1;
+
+
+		public PooledBuffer(ByteArrayPool pool, int capacity)
+		{
+			if (null == pool) { throw new ArgumentNullException("pool"); }
+			_pool = pool;
+			_array = pool.Rent(capacity);
+		}
+
+
+		/// <summary>Rented array, may be longer than <see cref="Length"/>.</summary>
+		public byte[] Array
+		{
+			get
+			{
+				if (null == _array) { throw new ObjectDisposedException("PooledBuffer"); }
+				return _array;
+			}
+		}
+
+
+		/// <summary>Number of valid bytes.</summary>
+		public int Length
+		{
+			get { return _length; }
+			set
+			{
+				if (value < 0 || value > Array.Length) { throw new ArgumentOutOfRangeException("value"); }
+				_length = value;
+			}
+		}
+
+
+		/// <summary>Make room for at least <paramref name="capacity"/> bytes, keeping the valid ones. Only for the sole owner.</summary>
+		public void EnsureCapacity(int capacity)
+		{
+			byte[] array = Array;
+			if (capacity <= array.Length) { return; }
+
+			byte[] larger = _pool.Rent(Math.Max(capacity, array.Length * 2));
+			Buffer.BlockCopy(array, 0, larger, 0, _length);
+			_pool.Return(array);
+			_array = larger;
+		}
+
+
+		/// <summary>Append everything <paramref name="stream"/> returns.</summary>
+		public void ReadFrom(Stream stream)
+		{
+			int read;
+			while (true)
+			{
+				if (_length == Array.Length) { EnsureCapacity(_length + 1); }
+				read = stream.Read(_array, _length, _array.Length - _length);
+				if (0 == read) { return; }
+				_length += read;
+			}
+		}
+
+
+		/// <summary>Exactly sized copy of the valid bytes, for consumers that keep the array.</summary>
+		public byte[] ToArray()
+		{
+			byte[] data = new byte[_length];
+			Buffer.BlockCopy(Array, 0, data, 0, _length);
+			return data;
+		}
+
+
+		/// <summary>Read only stream over the valid bytes.</summary>
+		public MemoryStream AsStream()
+		{
+			return new MemoryStream(Array, 0, _length, false);
+		}
+
+
+		public PooledBuffer Retain()
+		{
+			if (Interlocked.Increment(ref _references) <= 1)
+			{
+				throw new ObjectDisposedException("PooledBuffer");
+			}
+			return this;
+		}
+
+
+		public void Release()
+		{
+			int references = Interlocked.Decrement(ref _references);
+			if (0 == references)
+			{
+				byte[] array = _array;
+				_array = null;
+				_pool.Return(array);
+			}
+			else if (references < 0)
+			{
+				throw new InvalidOperationException("PooledBuffer released more often than retained");
+			}
+		}
+
+
+		/// <summary>Same as <see cref="Release"/>, for 'using'.</summary>
+		public void Dispose()
+		{
+			Release();
+		}
+	}
+}
@@ -104,6 +104,40 @@ namespace Mapbox.Platform
 		/// <summary> Raw data fetched from the request. </summary>
 		public byte[] Data;
 
+
+		/// <summary>
+		/// gzip body as received when the transport already decompressed <see cref="Data"/>, otherwise null.
+		/// Caches store this instead of the larger decompressed data.
+		/// </summary>
+		public byte[] CompressedData { get; private set; }
+
+
+		private byte[] _decompressedData;
+		private byte[] _decompressedFrom;
+		private readonly object _decompressLock = new object();
+
+
+		/// <summary>
+		/// <see cref="Data"/> decompressed if it's gzip encoded, eg when loaded from a cache storing <see cref="CompressedData"/>.
+		/// Decompressed on first access and kept, so everyone handed this response shares one copy.
+		/// </summary>
+		public byte[] DecompressedData
+		{
+			get
+			{
+				lock (_decompressLock)
+				{
+					// 'Data' is a public field, start over if it was replaced
+					if (!object.ReferenceEquals(_decompressedFrom, Data))
+					{
+						_decompressedFrom = Data;
+						_decompressedData = null == Data ? null : Compression.Decompress(Data);
+					}
+					return _decompressedData;
+				}
+			}
+		}
+
 		public void AddException(Exception ex)
 		{
 			if (null == _exceptions) { _exceptions = new List<Exception>(); }
@@ -119,6 +153,69 @@ namespace Mapbox.Platform
 			return response;
 		}
 
+
+		/// <summary>Response parsed by <see cref="HttpPipeline"/>.</summary>
+		/// <param name="statusCode">null if no response was received</param>
+		/// <param name="compressedData">gzip body <paramref name="data"/> was decompressed from, if any</param>
+		internal static Response FromHttpPipeline(IAsyncRequest request, string url, int? statusCode, Dictionary<string, string> headers, byte[] data, byte[] compressedData, Exception apiEx)
+		{
+			Response response = new Response();
+			response.Request = request;
+			response.RequestUrl = url;
+
+			if (null != apiEx)
+			{
+				response.AddException(apiEx);
+			}
+
+			if (!statusCode.HasValue)
+			{
+				if (null == apiEx) { response.AddException(new Exception("No Reponse.")); }
+				return response;
+			}
+
+			if (null != headers)
+			{
+				response.Headers = headers;
+				foreach (var header in headers)
+				{
+					if (header.Key.Equals("X-Rate-Limit-Interval", StringComparison.OrdinalIgnoreCase))
+					{
+						int limitInterval;
+						if (int.TryParse(header.Value, out limitInterval)) { response.XRateLimitInterval = limitInterval; }
+					}
+					else if (header.Key.Equals("X-Rate-Limit-Limit", StringComparison.OrdinalIgnoreCase))
+					{
+						long limitLimit;
+						if (long.TryParse(header.Value, out limitLimit)) { response.XRateLimitLimit = limitLimit; }
+					}
+					else if (header.Key.Equals("X-Rate-Limit-Reset", StringComparison.OrdinalIgnoreCase))
+					{
+						double unixTimestamp;
+						if (double.TryParse(header.Value, out unixTimestamp)) { response.XRateLimitReset = UnixTimestampUtils.From(unixTimestamp); }
+					}
+					else if (header.Key.Equals("Content-Type", StringComparison.OrdinalIgnoreCase))
+					{
+						response.ContentType = header.Value;
+					}
+				}
+			}
+
+			response.StatusCode = statusCode;
+			if (200 != statusCode.Value)
+			{
+				response.AddException(new Exception(string.Format("Status Code {0}", statusCode.Value)));
+			}
+			if (429 == statusCode.Value)
+			{
+				response.AddException(new Exception("Rate limit hit"));
+			}
+
+			response.Data = data;
+			response.CompressedData = compressedData;
+			return response;
+		}
+
 #if !NETFX_CORE && !UNITY // full .NET Framework
 		public static Response FromWebResponse(IAsyncRequest request, HttpWebResponse apiResponse, Exception apiEx) {
 
@@ -0,0 +1,334 @@
+#if !UNITY_WEBGL && !NETFX_CORE
+
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.IO.Compression;
+	using Mapbox.Platform;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using System;
+	using System.Collections.Generic;
+	using System.Globalization;
+	using System.Net;
+	using System.Net.Sockets;
+	using System.Text;
+	using System.Threading;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class HttpPipelineTest
+	{
+
+
+		/// <summary>
+		/// Minimal HTTP/1.1 server on localhost: keep-alive, handles pipelined requests in order.
+		/// /tile/{n}: 2KB body, /gzip: gzip encoded body, /chunked: chunked body, /slow: never answers.
+		/// </summary>
+		private class StubServer : IDisposable
+		{
+			public static readonly byte[] TILE = makeBody(2048);
+
+			private TcpListener _listener;
+			private Thread _acceptThread;
+			private volatile bool _stopped;
+			private readonly int _closeAfterResponses;
+			private readonly byte[] _gzipped = Compression.Compress(TILE, CompressionLevel.Optimal);
+			private readonly List<Socket> _clients = new List<Socket>();
+
+			/// <param name="closeAfterResponses">close the connection without notice after this many responses, 0: never</param>
+			public StubServer(int closeAfterResponses = 0)
+			{
+				_closeAfterResponses = closeAfterResponses;
+				_listener = new TcpListener(IPAddress.Loopback, 0);
+				_listener.Start(512);
+				_acceptThread = new Thread(accept);
+				_acceptThread.IsBackground = true;
+				_acceptThread.Start();
+			}
+
+			public string Url { get { return "http://127.0.0.1:" + ((IPEndPoint)_listener.LocalEndpoint).Port; } }
+
+			/// <summary>'User-Agent' header of the last request</summary>
+			public volatile string UserAgent;
+
+			public void Dispose()
+			{
+				_stopped = true;
+				_listener.Stop();
+				lock (_clients)
+				{
+					foreach (Socket client in _clients) { client.Close(); }
+				}
+			}
+
+			private void accept()
+			{
+				while (!_stopped)
+				{
+					Socket client;
+					try { client = _listener.AcceptSocket(); }
+					catch (Exception) { return; }
+					lock (_clients) { _clients.Add(client); }
+					Thread thread = new Thread(() => serve(client));
+					thread.IsBackground = true;
+					thread.Start();
+				}
+			}
+
+			private void serve(Socket client)
+			{
+				byte[] buffer = new byte[8192];
+				StringBuilder pending = new StringBuilder();
+				int responses = 0;
+				try
+				{
+					while (!_stopped)
+					{
+						int read = client.Receive(buffer);
+						if (0 == read) { break; }
+						pending.Append(Encoding.ASCII.GetString(buffer, 0, read));
+
+						string requests = pending.ToString();
+						int end;
+						while ((end = requests.IndexOf("\r\n\r\n", StringComparison.Ordinal)) >= 0)
+						{
+							string request = requests.Substring(0, end);
+							requests = requests.Substring(end + 4);
+							string path = request.Split(' ')[1];
+							foreach (string header in request.Split(new string[] { "\r\n" }, StringSplitOptions.None))
+							{
+								if (header.StartsWith("User-Agent: ", StringComparison.Ordinal)) { UserAgent = header.Substring(12); }
+							}
+							if (path == "/slow") { continue; }
+
+							client.Send(respond(path));
+							responses++;
+							if (_closeAfterResponses > 0 && 0 == responses % _closeAfterResponses)
+							{
+								client.Shutdown(SocketShutdown.Both);
+								client.Close();
+								return;
+							}
+						}
+						pending.Length = 0;
+						pending.Append(requests);
+					}
+				}
+				catch (Exception) { }
+				finally
+				{
+					client.Close();
+				}
+			}
+
+			private byte[] respond(string path)
+			{
+				List<byte> response = new List<byte>();
+				if (path == "/gzip")
+				{
+					response.AddRange(Encoding.ASCII.GetBytes("HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\nETag: \"abc\"\r\nContent-Length: " + _gzipped.Length + "\r\n\r\n"));
+					response.AddRange(_gzipped);
+				}
+				else if (path == "/chunked")
+				{
+					response.AddRange(Encoding.ASCII.GetBytes("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"));
+					for (int offset = 0; offset < TILE.Length; offset += 1000)
+					{
+						int size = Math.Min(1000, TILE.Length - offset);
+						response.AddRange(Encoding.ASCII.GetBytes(size.ToString("x", CultureInfo.InvariantCulture) + ";ext=1\r\n"));
+						for (int i = 0; i < size; i++) { response.Add(TILE[offset + i]); }
+						response.AddRange(Encoding.ASCII.GetBytes("\r\n"));
+					}
+					response.AddRange(Encoding.ASCII.GetBytes("0\r\nX-Trailer: 1\r\n\r\n"));
+				}
+				else
+				{
+					response.AddRange(Encoding.ASCII.GetBytes("HTTP/1.1 200 OK\r\nContent-Type: application/vnd.mapbox-vector-tile\r\nContent-Length: " + TILE.Length + "\r\n\r\n"));
+					response.AddRange(TILE);
+				}
+				return response.ToArray();
+			}
+
+			private static byte[] makeBody(int length)
+			{
+				byte[] body = new byte[length];
+				for (int i = 0; i < length; i++) { body[i] = (byte)(i % 251); }
+				return body;
+			}
+		}
+
+
+		[Test]
+		public void KeepAliveAndPipelining()
+		{
+			using (StubServer server = new StubServer())
+			using (HttpPipeline pipeline = new HttpPipeline(2, 4))
+			{
+				List<Response> responses = fetch(pipeline, server.Url, "/tile/", 200, 10);
+
+				Assert.AreEqual(200, responses.Count);
+				foreach (Response response in responses)
+				{
+					Assert.IsFalse(response.HasError, response.ExceptionsAsString);
+					Assert.AreEqual(200, response.StatusCode);
+					Assert.AreEqual("application/vnd.mapbox-vector-tile", response.ContentType);
+					CollectionAssert.AreEqual(StubServer.TILE, response.Data);
+				}
+				Assert.LessOrEqual(pipeline.ConnectionsOpened, 2, "connections were not reused");
+				Assert.Greater(pipeline.PipelinedRequests, 0, "requests were not pipelined");
+			}
+		}
+
+
+		[Test]
+		public void DecodesGzipAndChunkedBodies()
+		{
+			using (StubServer server = new StubServer())
+			using (HttpPipeline pipeline = new HttpPipeline())
+			{
+				Response gzip = fetch(pipeline, server.Url, "/gzip", 1, 10)[0];
+				Assert.IsFalse(gzip.HasError, gzip.ExceptionsAsString);
+				CollectionAssert.AreEqual(StubServer.TILE, gzip.Data, "gzip body was not decompressed");
+				Assert.IsTrue(gzip.Headers.ContainsKey("etag"), "header lookup is not case insensitive");
+
+				Response chunked = fetch(pipeline, server.Url, "/chunked", 1, 10)[0];
+				Assert.IsFalse(chunked.HasError, chunked.ExceptionsAsString);
+				CollectionAssert.AreEqual(StubServer.TILE, chunked.Data, "chunked body was not reassembled");
+			}
+		}
+
+
+		[Test]
+		public void SendsUserAgent()
+		{
+			using (StubServer server = new StubServer())
+			{
+				using (HttpPipeline pipeline = new HttpPipeline())
+				{
+					Assert.IsFalse(fetch(pipeline, server.Url, "/tile/0", 1, 10)[0].HasError);
+					Assert.AreEqual(Constants.UserAgent, server.UserAgent);
+				}
+				using (HttpPipeline pipeline = new HttpPipeline(userAgent: "MapboxUnitTest/1.0"))
+				{
+					Assert.IsFalse(fetch(pipeline, server.Url, "/tile/0", 1, 10)[0].HasError);
+					Assert.AreEqual("MapboxUnitTest/1.0", server.UserAgent);
+				}
+			}
+		}
+
+
+		[Test]
+		public void RetriesWhenServerClosesConnection()
+		{
+			// server drops the connection after every other response, pipelined requests have to be sent again
+			using (StubServer server = new StubServer(2))
+			using (HttpPipeline pipeline = new HttpPipeline(2, 4))
+			{
+				List<Response> responses = fetch(pipeline, server.Url, "/tile/", 40, 10);
+
+				Assert.AreEqual(40, responses.Count);
+				foreach (Response response in responses)
+				{
+					Assert.IsFalse(response.HasError, response.ExceptionsAsString);
+				}
+				Assert.Greater(pipeline.ConnectionsOpened, 2);
+			}
+		}
+
+
+		[Test]
+		public void TimeoutAndCancel()
+		{
+			using (StubServer server = new StubServer())
+			using (HttpPipeline pipeline = new HttpPipeline())
+			{
+				bool canceledCallback = false;
+				IAsyncRequest canceled = pipeline.Request(server.Url + "/slow", (Response r) => canceledCallback = true, 1);
+				canceled.Cancel();
+
+				Response timedOut = fetch(pipeline, server.Url, "/slow", 1, 1)[0];
+				Assert.IsTrue(timedOut.HasError, "request didn't time out");
+				Assert.IsFalse(canceledCallback, "callback of canceled request was called");
+
+				// pipeline is still usable afterwards
+				Response ok = fetch(pipeline, server.Url, "/tile/", 1, 10)[0];
+				Assert.IsFalse(ok.HasError, ok.ExceptionsAsString);
+			}
+		}
+
+
+		[Test]
+		public void Benchmark10kTileFetches()
+		{
+			const int tiles = 10000;
+			using (StubServer server = new StubServer())
+			using (HttpPipeline pipeline = new HttpPipeline())
+			{
+				double[] latencies = new double[tiles];
+				int completed = 0;
+				int errors = 0;
+				ManualResetEvent done = new ManualResetEvent(false);
+
+				System.Diagnostics.Stopwatch total = System.Diagnostics.Stopwatch.StartNew();
+				for (int i = 0; i < tiles; i++)
+				{
+					int index = i;
+					long start = System.Diagnostics.Stopwatch.GetTimestamp();
+					pipeline.Request(server.Url + "/tile/" + i, (Response r) =>
+					{
+						latencies[index] = (System.Diagnostics.Stopwatch.GetTimestamp() - start) * 1000.0 / System.Diagnostics.Stopwatch.Frequency;
+						if (r.HasError) { Interlocked.Increment(ref errors); }
+						if (Interlocked.Increment(ref completed) == tiles) { done.Set(); }
+					}, 60);
+				}
+				Assert.IsTrue(done.WaitOne(120000, false), "benchmark did not finish");
+				total.Stop();
+
+				Array.Sort(latencies);
+				ued.Log(string.Format(
+					CultureInfo.InvariantCulture
+					, "[HttpPipeline] {0} tiles in {1:0}ms, p50 {2:0.00}ms p99 {3:0.00}ms, {4} connections, {5} pipelined"
+					, tiles
+					, total.Elapsed.TotalMilliseconds
+					, latencies[tiles / 2]
+					, latencies[tiles * 99 / 100]
+					, pipeline.ConnectionsOpened
+					, pipeline.PipelinedRequests
+				));
+				Assert.AreEqual(0, errors);
+			}
+		}
+
+
+		#region helper methods
+
+
+		private List<Response> fetch(HttpPipeline pipeline, string host, string path, int count, int timeout)
+		{
+			List<Response> responses = new List<Response>();
+			ManualResetEvent done = new ManualResetEvent(false);
+			for (int i = 0; i < count; i++)
+			{
+				string url = host + path + (path.EndsWith("/") ? i.ToString(CultureInfo.InvariantCulture) : string.Empty);
+				pipeline.Request(url, (Response r) =>
+				{
+					lock (responses)
+					{
+						responses.Add(r);
+						if (responses.Count == count) { done.Set(); }
+					}
+				}, timeout);
+			}
+			Assert.IsTrue(done.WaitOne((timeout + 5) * 1000, false), "requests did not complete");
+			return responses;
+		}
+
+
+		#endregion
+
+
+	}
+}
+
+#endif
@@ -0,0 +1,313 @@
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.IO.Compression;
+	using Mapbox.Map;
+	using Mapbox.Platform;
+	using Mapbox.Platform.Cache;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using System.Text;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class ResponseBuffersTest
+	{
+
+
+		private const string TS_VECTOR = "mapbox.mapbox-streets-v7";
+
+
+		[Test]
+		public void GunzipMatchesInput()
+		{
+			foreach (int length in new int[] { 0, 1, 5000, 300000 })
+			{
+				byte[] raw = compressible(length);
+				byte[] gz = Compression.CompressModeCompress(raw);
+				CollectionAssert.AreEqual(raw, Compression.Gunzip(gz, 0, gz.Length), "length " + length.ToString());
+				CollectionAssert.AreEqual(raw, Compression.Decompress(gz), "length " + length.ToString());
+
+				// gzip data in the middle of a larger buffer, like a pooled receive buffer
+				byte[] padded = new byte[gz.Length + 20];
+				Buffer.BlockCopy(gz, 0, padded, 7, gz.Length);
+				CollectionAssert.AreEqual(raw, Compression.Gunzip(padded, 7, gz.Length), "offset, length " + length.ToString());
+			}
+		}
+
+
+		[Test]
+		public void DecompressReturnsCorruptBuffers()
+		{
+			byte[] gz = Compression.CompressModeCompress(compressible(5000));
+			for (int i = 10; i < gz.Length - 8; i++) { gz[i] = 0xff; }
+			Assert.AreSame(gz, Compression.Decompress(gz));
+			Assert.Catch(() => Compression.Gunzip(gz, 0, gz.Length));
+		}
+
+
+		[Test]
+		public void PooledBufferReferenceCounting()
+		{
+			ByteArrayPool pool = new ByteArrayPool(4);
+			PooledBuffer buffer = new PooledBuffer(pool, 1000);
+			byte[] array = buffer.Array;
+
+			buffer.Retain();
+			buffer.Release();
+			Assert.AreSame(array, buffer.Array, "buffer was returned while still referenced");
+
+			buffer.Release();
+			Assert.Throws<ObjectDisposedException>(() => { byte[] b = buffer.Array; });
+			Assert.Throws<InvalidOperationException>(() => buffer.Release());
+			Assert.AreSame(array, pool.Rent(1000), "array was not returned to the pool");
+
+			// inflating beyond the size hint grows through the pool
+			byte[] raw = compressible(100000);
+			byte[] gz = Compression.CompressModeCompress(raw);
+			using (GZipStream gzip = new GZipStream(new MemoryStream(gz), CompressionMode.Decompress))
+			using (PooledBuffer inflated = Compression.Inflate(gzip, 16))
+			{
+				Assert.AreEqual(raw.Length, inflated.Length);
+				CollectionAssert.AreEqual(raw, inflated.ToArray());
+			}
+		}
+
+
+		[Test]
+		public void ResponseDecompressesOnceForAllConsumers()
+		{
+			byte[] raw = compressible(20000);
+			Response cached = Response.FromCache(Compression.CompressModeCompress(raw));
+
+			byte[] first = cached.DecompressedData;
+			CollectionAssert.AreEqual(raw, first);
+			Assert.AreSame(first, cached.DecompressedData, "data was decompressed again");
+			Assert.AreNotSame(first, cached.Data, "raw data was replaced");
+
+			Response plain = Response.FromCache(raw);
+			Assert.AreSame(raw, plain.DecompressedData, "uncompressed data was copied");
+
+			cached.Data = raw;
+			Assert.AreSame(raw, cached.DecompressedData, "replaced data was ignored");
+		}
+
+
+		[Test]
+		public void BenchmarkFetchToDecode()
+		{
+			const int tiles = 200;
+			// requests for the same tile are coalesced onto one response, eg by several layers of a map
+			const int requesters = 3;
+
+			// compressing is slow with the bundled managed gzip, a few distinct tiles are repeated
+			byte[][] distinct = new byte[8][];
+			int[] rawLengths = new int[distinct.Length];
+			for (int i = 0; i < distinct.Length; i++)
+			{
+				byte[] raw = vectorTile(400 + i);
+				distinct[i] = Compression.CompressModeCompress(raw);
+				rawLengths[i] = raw.Length;
+			}
+			byte[][] bodies = new byte[tiles][];
+			int rawBytes = 0;
+			int compressedBytes = 0;
+			for (int i = 0; i < tiles; i++)
+			{
+				bodies[i] = distinct[i % distinct.Length];
+				rawBytes += rawLengths[i % distinct.Length];
+				compressedBytes += bodies[i].Length;
+			}
+
+			// before: the transport decompresses through a growing MemoryStream, caches hold decompressed tiles and every
+			// requester runs the data through 'Decompress' again
+			int features = 0;
+			int collections = GC.CollectionCount(0);
+			TileMemoryCache cache = new TileMemoryCache((uint)tiles, 0, TileMemoryCachePolicy.Lru);
+			Stopwatch sw = Stopwatch.StartNew();
+			for (int i = 0; i < tiles; i++)
+			{
+				byte[] transport = decompressThroughMemoryStream(bodies[i]);
+				cache.Add(TS_VECTOR, new CanonicalTileId(16, i, 0), new CacheItem() { Data = transport }, true);
+				Response response = Response.FromCache(transport);
+				for (int r = 0; r < requesters; r++)
+				{
+					features += decode(decompressThroughMemoryStream(response.Data));
+				}
+			}
+			double beforeMs = sw.Elapsed.TotalMilliseconds;
+			int beforeCollections = GC.CollectionCount(0) - collections;
+			long beforeCacheBytes = cache.Bytes;
+
+			// after: one exactly sized decompression shared by all requesters, caches hold the compressed body
+			collections = GC.CollectionCount(0);
+			cache = new TileMemoryCache((uint)tiles, 0, TileMemoryCachePolicy.Lru);
+			sw = Stopwatch.StartNew();
+			for (int i = 0; i < tiles; i++)
+			{
+				cache.Add(TS_VECTOR, new CanonicalTileId(16, i, 0), new CacheItem() { Data = bodies[i] }, true);
+				Response response = Response.FromCache(bodies[i]);
+				for (int r = 0; r < requesters; r++)
+				{
+					features -= decode(response.DecompressedData);
+				}
+			}
+			double afterMs = sw.Elapsed.TotalMilliseconds;
+			int afterCollections = GC.CollectionCount(0) - collections;
+
+			Assert.AreEqual(0, features, "both paths have to decode the same features");
+			Assert.Less(cache.Bytes, beforeCacheBytes);
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[ResponseBuffers] {0} tiles ({1:0}KB, {2:0}KB gzip) x {3} requesters: MemoryStream decompression {4:0}ms {5} gen0 GCs, cache {6:0}KB; shared exact decompression {7:0}ms {8} gen0 GCs, cache {9:0}KB"
+				, tiles
+				, rawBytes / 1024.0
+				, compressedBytes / 1024.0
+				, requesters
+				, beforeMs
+				, beforeCollections
+				, beforeCacheBytes / 1024.0
+				, afterMs
+				, afterCollections
+				, cache.Bytes / 1024.0
+			));
+		}
+
+
+		#region helper methods
+
+
+		/// <summary> What the tile does with the data: parse the tile and look up a layer, features are decoded later. </summary>
+		private static int decode(byte[] data)
+		{
+			Mapbox.VectorTile.VectorTile tile = new Mapbox.VectorTile.VectorTile(data);
+			int count = 0;
+			foreach (string layerName in tile.LayerNames())
+			{
+				count += tile.GetLayer(layerName).FeatureCount();
+			}
+			return count;
+		}
+
+
+		/// <summary> Former implementation of <see cref="Compression.Decompress"/>, baseline of the benchmark. </summary>
+		private static byte[] decompressThroughMemoryStream(byte[] buffer)
+		{
+			if (buffer.Length < 2 || buffer[0] != 0x1f || buffer[1] != 0x8b)
+			{
+				return buffer;
+			}
+
+			using (GZipStream stream = new GZipStream(new MemoryStream(buffer), CompressionMode.Decompress))
+			{
+				byte[] buf = new byte[4096];
+				using (MemoryStream memory = new MemoryStream())
+				{
+					int count;
+					while (0 != (count = stream.Read(buf, 0, buf.Length)))
+					{
+						memory.Write(buf, 0, count);
+					}
+					return memory.ToArray();
+				}
+			}
+		}
+
+
+		private static byte[] compressible(int length)
+		{
+			byte[] data = new byte[length];
+			Random random = new Random(length);
+			for (int i = 0; i < length; i++)
+			{
+				data[i] = (byte)(i % 64 < 48 ? i % 7 : random.Next(256));
+			}
+			return data;
+		}
+
+
+		/// <summary> Vector tile with a 'road' layer of <paramref name="features"/> line strings, ~100 bytes each. </summary>
+		private static byte[] vectorTile(int features)
+		{
+			Random random = new Random(features);
+			MemoryStream layer = new MemoryStream();
+			writeVarint(layer, (15 << 3) | 0);
+			writeVarint(layer, 2);
+			writeBytes(layer, 1, Encoding.UTF8.GetBytes("road"));
+
+			for (int f = 0; f < features; f++)
+			{
+				MemoryStream geometry = new MemoryStream();
+				const int points = 20;
+				writeVarint(geometry, (1 << 3) | 1); // MoveTo
+				writeVarint(geometry, zigzag(random.Next(4096)));
+				writeVarint(geometry, zigzag(random.Next(4096)));
+				writeVarint(geometry, ((points - 1) << 3) | 2); // LineTo
+				for (int p = 1; p < points; p++)
+				{
+					// streets run along a grid, real tiles gzip to about half their size
+					writeVarint(geometry, zigzag(random.Next(-2, 3) * 16));
+					writeVarint(geometry, zigzag(random.Next(-2, 3) * 16));
+				}
+
+				MemoryStream feature = new MemoryStream();
+				writeVarint(feature, (1 << 3) | 0);
+				writeVarint(feature, (ulong)f + 1);
+				writeBytes(feature, 2, new byte[] { 0, (byte)(f % 4) });
+				writeVarint(feature, (3 << 3) | 0);
+				writeVarint(feature, 2); // LINESTRING
+				writeBytes(feature, 4, geometry.ToArray());
+				writeBytes(layer, 2, feature.ToArray());
+			}
+
+			writeBytes(layer, 3, Encoding.UTF8.GetBytes("class"));
+			foreach (string value in new string[] { "street", "path", "primary", "service" })
+			{
+				MemoryStream valueMessage = new MemoryStream();
+				writeBytes(valueMessage, 1, Encoding.UTF8.GetBytes(value));
+				writeBytes(layer, 4, valueMessage.ToArray());
+			}
+			writeVarint(layer, (5 << 3) | 0);
+			writeVarint(layer, 4096);
+
+			MemoryStream tile = new MemoryStream();
+			writeBytes(tile, 3, layer.ToArray());
+			return tile.ToArray();
+		}
+
+
+		private static ulong zigzag(int value)
+		{
+			return (ulong)(uint)((value << 1) ^ (value >> 31));
+		}
+
+
+		private static void writeVarint(Stream stream, ulong value)
+		{
+			while (value >= 0x80)
+			{
+				stream.WriteByte((byte)(value | 0x80));
+				value >>= 7;
+			}
+			stream.WriteByte((byte)value);
+		}
+
+
+		private static void writeBytes(Stream stream, int field, byte[] bytes)
+		{
+			writeVarint(stream, (ulong)((field << 3) | 2));
+			writeVarint(stream, (ulong)bytes.Length);
+			stream.Write(bytes, 0, bytes.Length);
+		}
+
+
+		#endregion
+
+
+	}
+}
@@ -0,0 +1,257 @@
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.Map;
+	using Mapbox.Platform.Cache;
+	using NUnit.Framework;
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class SQLiteShardedCacheTest
+	{
+
+
+		private const string _dbName = "UNITTEST_SHARDED.db";
+		private const string _dbNameBaseline = "UNITTEST_BASELINE.db";
+		private const string TS_TERRAIN = "mapbox.terrain-rgb";
+		private const string TS_IMAGERY = "mapbox.satellite";
+		private const string TS_VECTOR = "mapbox.mapbox-streets-v7";
+		private SQLiteShardedCache _cache;
+
+
+		[SetUp]
+		public void SetUp()
+		{
+			_cache = new SQLiteShardedCache(6000, _dbName);
+			// remove leftovers of previous runs
+			_cache.Clear();
+			_cache.ReInit();
+		}
+
+
+		[TearDown]
+		public void TearDown()
+		{
+			_cache.Clear();
+			_cache.Dispose();
+			_cache = null;
+		}
+
+
+		[Test]
+		public void QueuedTileIsReadable()
+		{
+			CanonicalTileId tileId = new CanonicalTileId(1, 2, 3);
+			_cache.Add(TS_VECTOR, tileId, cacheItem(0x01, 1024), false);
+
+			// no 'Flush()': tile has to be served from the write queue or the database, depending on the writer's timing
+			CacheItem ci = _cache.Get(TS_VECTOR, tileId);
+			Assert.NotNull(ci, "queued tile not found");
+			Assert.AreEqual(0x01, ci.Data[0]);
+
+			_cache.Flush();
+			ci = _cache.Get(TS_VECTOR, tileId);
+			Assert.NotNull(ci, "committed tile not found");
+			Assert.AreEqual("etag", ci.ETag);
+			Assert.AreEqual(1024, ci.Data.Length);
+			Assert.IsTrue(ci.LastModified.HasValue, "'lastmodified' was not stored");
+		}
+
+
+		[Test]
+		public void ContainsQueuedAndCommittedTiles()
+		{
+			CanonicalTileId tileId = new CanonicalTileId(1, 2, 3);
+			Assert.IsFalse(_cache.Contains(TS_VECTOR, tileId));
+
+			_cache.Add(TS_VECTOR, tileId, cacheItem(0x01, 1024), false);
+			Assert.IsTrue(_cache.Contains(TS_VECTOR, tileId), "queued tile not found");
+
+			_cache.Flush();
+			Assert.IsTrue(_cache.Contains(TS_VECTOR, tileId), "committed tile not found");
+			Assert.IsFalse(_cache.Contains(TS_IMAGERY, tileId), "tile found in wrong tileset");
+		}
+
+
+		[Test]
+		public void NoOverwriteAndForceOverwrite()
+		{
+			CanonicalTileId tileId = new CanonicalTileId(0, 0, 0);
+
+			_cache.Add(TS_VECTOR, tileId, cacheItem(0x01, 16), false);
+			_cache.Flush();
+			_cache.Add(TS_VECTOR, tileId, cacheItem(0x02, 16), false);
+			_cache.Flush();
+			Assert.AreEqual(0x01, _cache.Get(TS_VECTOR, tileId).Data[0], "tile was overwritten without 'replaceIfExists'");
+
+			_cache.Add(TS_VECTOR, tileId, cacheItem(0x03, 16), true);
+			_cache.Flush();
+			Assert.AreEqual(0x03, _cache.Get(TS_VECTOR, tileId).Data[0], "tile was not overwritten with 'replaceIfExists'");
+
+			Assert.AreEqual(1, _cache.TileCount(TS_VECTOR), "unexpected number of tiles");
+		}
+
+
+		[Test]
+		public void OneDatabasePerTileset()
+		{
+			_cache.Add(TS_TERRAIN, new CanonicalTileId(0, 0, 0), cacheItem(0x01, 16), false);
+			_cache.Add(TS_IMAGERY, new CanonicalTileId(0, 0, 0), cacheItem(0x02, 16), false);
+			_cache.Flush();
+
+			Assert.AreNotEqual(SQLiteShardedCache.GetFullDbPath(_dbName, TS_TERRAIN), SQLiteShardedCache.GetFullDbPath(_dbName, TS_IMAGERY));
+			Assert.IsTrue(File.Exists(SQLiteShardedCache.GetFullDbPath(_dbName, TS_TERRAIN)), "no database for {0}", TS_TERRAIN);
+			Assert.IsTrue(File.Exists(SQLiteShardedCache.GetFullDbPath(_dbName, TS_IMAGERY)), "no database for {0}", TS_IMAGERY);
+			Assert.AreEqual(0x01, _cache.Get(TS_TERRAIN, new CanonicalTileId(0, 0, 0)).Data[0]);
+			Assert.AreEqual(0x02, _cache.Get(TS_IMAGERY, new CanonicalTileId(0, 0, 0)).Data[0]);
+
+			_cache.Clear(TS_TERRAIN);
+			Assert.AreEqual(0, _cache.TileCount(TS_TERRAIN));
+			Assert.AreEqual(1, _cache.TileCount(TS_IMAGERY), "clearing one tileset affected another one");
+		}
+
+
+		[Test]
+		public void SurvivesReopen()
+		{
+			CanonicalTileId tileId = new CanonicalTileId(5, 6, 7);
+			_cache.Add(TS_TERRAIN, tileId, cacheItem(0x04, 64), false);
+			// 'Dispose()' has to commit queued tiles
+			_cache.Dispose();
+
+			_cache = new SQLiteShardedCache(6000, _dbName);
+			CacheItem ci = _cache.Get(TS_TERRAIN, tileId);
+			Assert.NotNull(ci, "tile was lost on dispose");
+			Assert.AreEqual(0x04, ci.Data[0]);
+			Assert.AreEqual(1, _cache.TileCount(TS_TERRAIN));
+		}
+
+
+		[Test]
+		public void PruneOverAllTilesets()
+		{
+			const uint maxTileCount = 100;
+			_cache.Dispose();
+			_cache = new SQLiteShardedCache(maxTileCount, _dbName);
+
+			for (int x = 0; x < 80; x++)
+			{
+				_cache.Add(TS_TERRAIN, new CanonicalTileId(18, x, 131205), cacheItem(0x01, 16), false);
+			}
+			_cache.Flush();
+			for (int x = 0; x < 80; x++)
+			{
+				_cache.Add(TS_IMAGERY, new CanonicalTileId(18, x, 131205), cacheItem(0x02, 16), false);
+			}
+			_cache.Flush();
+
+			Assert.AreEqual(maxTileCount, _cache.TileCount(TS_TERRAIN) + _cache.TileCount(TS_IMAGERY), "pruning did not work as expected");
+		}
+
+
+		[Test]
+		public void ClearDeletesAllDatabases()
+		{
+			_cache.Add(TS_TERRAIN, new CanonicalTileId(0, 0, 0), cacheItem(0x01, 16), false);
+			_cache.Add(TS_VECTOR, new CanonicalTileId(0, 0, 0), cacheItem(0x01, 16), false);
+			_cache.Flush();
+
+			_cache.Clear();
+			Assert.IsFalse(File.Exists(SQLiteShardedCache.GetFullDbPath(_dbName, TS_TERRAIN)), "database was not deleted");
+			Assert.IsFalse(File.Exists(SQLiteShardedCache.GetFullDbPath(_dbName, TS_VECTOR)), "database was not deleted");
+
+			// have to Reinit after Clear()
+			_cache.ReInit();
+			Assert.IsNull(_cache.Get(TS_TERRAIN, new CanonicalTileId(0, 0, 0)));
+			Assert.AreEqual(0, _cache.TileCount(TS_TERRAIN));
+		}
+
+
+		[Test]
+		public void ShardedVsSingleDatabase()
+		{
+			const int tilesPerTileset = 300;
+			string[] tilesetNames = new string[] { TS_TERRAIN, TS_IMAGERY, TS_VECTOR };
+
+			string baselinePath = SQLiteCache.GetFullDbPath(_dbNameBaseline);
+			if (File.Exists(baselinePath)) { File.Delete(baselinePath); }
+			using (SQLiteCache baseline = new SQLiteCache(6000, _dbNameBaseline))
+			{
+				logRun("SQLiteCache", baseline, tilesetNames, tilesPerTileset);
+				baseline.Clear();
+			}
+
+			logRun("SQLiteShardedCache", _cache, tilesetNames, tilesPerTileset);
+		}
+
+
+		#region helper methods
+
+
+		private CacheItem cacheItem(byte fill, int length)
+		{
+			byte[] data = new byte[length];
+			for (int i = 0; i < length; i++) { data[i] = fill; }
+			return new CacheItem()
+			{
+				Data = data,
+				ETag = "etag",
+				LastModified = new DateTime(2019, 10, 15, 0, 0, 0, DateTimeKind.Utc)
+			};
+		}
+
+
+		/// <summary>
+		/// Tiles of all tilesets arrive interleaved, like terrain, imagery and vector data during a fly-over,
+		/// and every insert is followed by reading back an earlier tile. All calls are made from the calling thread,
+		/// as 'CachingWebFileSource' does on the main thread.
+		/// </summary>
+		private void logRun(string label, ICache cache, string[] tilesetNames, int tilesPerTileset)
+		{
+			CacheItem item = cacheItem(0x58, 20 * 1024);
+			long hits = 0;
+			long maxCallTicks = 0;
+
+			Stopwatch sw = Stopwatch.StartNew();
+			Stopwatch call = new Stopwatch();
+			for (int x = 0; x < tilesPerTileset; x++)
+			{
+				foreach (string tilesetName in tilesetNames)
+				{
+					call.Reset();
+					call.Start();
+					cache.Add(tilesetName, new CanonicalTileId(16, x, 22000), item, true);
+					if (null != cache.Get(tilesetName, new CanonicalTileId(16, x / 2, 22000))) { hits++; }
+					call.Stop();
+					maxCallTicks = Math.Max(maxCallTicks, call.ElapsedTicks);
+				}
+			}
+
+			SQLiteShardedCache sharded = cache as SQLiteShardedCache;
+			if (null != sharded) { sharded.Flush(); }
+			sw.Stop();
+
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] {1} tiles of {2} tilesets written and read back in {3:0.000}s ({4:0} tiles/s), {5} hits, slowest Add+Get:{6:0.000}ms"
+				, label
+				, tilesPerTileset * tilesetNames.Length
+				, tilesetNames.Length
+				, sw.Elapsed.TotalSeconds
+				, tilesPerTileset * tilesetNames.Length / Math.Max(sw.Elapsed.TotalSeconds, 0.001)
+				, hits
+				, maxCallTicks * 1000.0 / Stopwatch.Frequency
+			));
+		}
+
+
+		#endregion
+
+
+	}
+}
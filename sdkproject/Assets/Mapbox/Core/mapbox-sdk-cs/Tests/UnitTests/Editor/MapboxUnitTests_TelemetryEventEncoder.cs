@@ -0,0 +1,247 @@
+//-----------------------------------------------------------------------
+// <copyright file="MapboxUnitTests_TelemetryEventEncoder.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.Text;
+	using Mapbox.Json;
+	using Mapbox.Json.Linq;
+	using Mapbox.Unity.Telemetry;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class TelemetryEventEncoderTest
+	{
+
+
+		private TelemetryEventEncoder _encoder;
+
+
+		[SetUp]
+		public void SetUp()
+		{
+			_encoder = new TelemetryEventEncoder();
+		}
+
+
+		[Test]
+		public void SameJsonAsJsonNet()
+		{
+			List<TelemetryEvent> batch = createBatch(25);
+
+			string encoded = encodeToString(batch, false);
+			string jsonNet = serializeWithJsonNet(batch);
+
+			Assert.IsTrue(
+				JToken.DeepEquals(JToken.Parse(jsonNet), JToken.Parse(encoded))
+				, "encoder output differs from Json.NET:\n{0}\n{1}"
+				, encoded
+				, jsonNet
+			);
+		}
+
+
+		[Test]
+		public void EscapesStrings()
+		{
+			Dictionary<string, object> attributes = new Dictionary<string, object>();
+			attributes.Add("quote", "say \"hi\"\\");
+			attributes.Add("control", "line1\nline2\t\u0001");
+			attributes.Add("unicode", "Wien ßüö € \U0001F600");
+			attributes.Add("custom key \"escaped\"", 1);
+			List<TelemetryEvent> batch = new List<TelemetryEvent>() { new TelemetryEvent("escape", 1, attributes) };
+
+			JToken parsed = JToken.Parse(encodeToString(batch, false));
+
+			Assert.AreEqual("say \"hi\"\\", (string)parsed[0]["quote"]);
+			Assert.AreEqual("line1\nline2\t\u0001", (string)parsed[0]["control"]);
+			Assert.AreEqual("Wien ßüö € \U0001F600", (string)parsed[0]["unicode"]);
+			Assert.AreEqual(1, (int)parsed[0]["custom key \"escaped\""]);
+		}
+
+
+		[Test]
+		public void Numbers()
+		{
+			Dictionary<string, object> attributes = new Dictionary<string, object>();
+			attributes.Add("min", long.MinValue);
+			attributes.Add("max", long.MaxValue);
+			attributes.Add("negative", -42);
+			attributes.Add("zero", 0);
+			attributes.Add("lat", 48.2081743);
+			attributes.Add("zoom", 16.0);
+			attributes.Add("nan", double.NaN);
+			attributes.Add("tiny", 0.000123456789);
+			attributes.Add("inexact", 0.1 + 0.2);
+			attributes.Add("negativeFraction", -0.5);
+			attributes.Add("sixteenDigits", 0.1234567890123456);
+			List<TelemetryEvent> batch = new List<TelemetryEvent>() { new TelemetryEvent("numbers", 1, attributes) };
+
+			JToken parsed = JToken.Parse(encodeToString(batch, false));
+
+			Assert.AreEqual(long.MinValue, (long)parsed[0]["min"]);
+			Assert.AreEqual(long.MaxValue, (long)parsed[0]["max"]);
+			Assert.AreEqual(-42, (int)parsed[0]["negative"]);
+			Assert.AreEqual(0, (int)parsed[0]["zero"]);
+			Assert.AreEqual(48.2081743, (double)parsed[0]["lat"]);
+			Assert.AreEqual(16.0, (double)parsed[0]["zoom"]);
+			Assert.AreEqual(JTokenType.Null, parsed[0]["nan"].Type);
+			Assert.AreEqual(0.000123456789, (double)parsed[0]["tiny"]);
+			Assert.AreEqual(0.1 + 0.2, (double)parsed[0]["inexact"]);
+			Assert.AreEqual(-0.5, (double)parsed[0]["negativeFraction"]);
+			Assert.AreEqual(0.1234567890123456, (double)parsed[0]["sixteenDigits"]);
+		}
+
+
+		[Test]
+		public void FloatsSameAsJsonNet()
+		{
+			Dictionary<string, object> attributes = new Dictionary<string, object>();
+			attributes.Add("tenth", 0.1f);
+			attributes.Add("lat", 48.20817f);
+			attributes.Add("negative", -1.5f);
+			attributes.Add("nineDigits", 0.3333333f);
+			attributes.Add("small", 0.00001f);
+			attributes.Add("integral", 16f);
+			attributes.Add("max", float.MaxValue);
+			List<TelemetryEvent> batch = new List<TelemetryEvent>() { new TelemetryEvent("floats", 1, attributes) };
+
+			string encoded = encodeToString(batch, false);
+			string jsonNet = serializeWithJsonNet(batch);
+
+			// not widened to double: 0.1f must not become 0.100000001490116
+			StringAssert.Contains("\"tenth\":0.1,", encoded);
+			Assert.IsTrue(
+				JToken.DeepEquals(JToken.Parse(jsonNet), JToken.Parse(encoded))
+				, "encoder output differs from Json.NET:\n{0}\n{1}"
+				, encoded
+				, jsonNet
+			);
+		}
+
+
+		[Test]
+		public void GzipRoundTrip()
+		{
+			// large enough to span several arena chunks
+			List<TelemetryEvent> batch = createBatch(1000);
+
+			string plain = encodeToString(batch, false);
+			int compressedLength = _encoder.Encode(batch, true);
+			Assert.AreEqual("gzip", _encoder.ContentEncoding);
+			Assert.IsTrue(TelemetryEventEncoder.IsGzipped(_encoder.Buffer, compressedLength));
+			Assert.Less(compressedLength, Encoding.UTF8.GetByteCount(plain));
+
+			byte[] compressed = new byte[compressedLength];
+			Buffer.BlockCopy(_encoder.Buffer, 0, compressed, 0, compressedLength);
+			Assert.AreEqual(plain, Encoding.UTF8.GetString(Compression.Decompress(compressed)));
+		}
+
+
+		[Test]
+		public void EncoderVsJsonNet()
+		{
+			const int batchSize = 1000;
+			const int iterations = 5;
+			List<TelemetryEvent> batch = createBatch(batchSize);
+
+			// warm up both paths, grows the encoder's arena to its final size
+			_encoder.Encode(batch, false);
+			_encoder.Encode(batch, true);
+			serializeWithJsonNet(batch);
+
+			logRun("TelemetryEventEncoder", batchSize, iterations, () => _encoder.Encode(batch, false));
+			logRun("TelemetryEventEncoder+gzip", batchSize, iterations, () => _encoder.Encode(batch, true));
+			logRun("Json.NET", batchSize, iterations, () => Encoding.UTF8.GetBytes(serializeWithJsonNet(batch)));
+		}
+
+
+		#region helper methods
+
+
+		private List<TelemetryEvent> createBatch(int eventCount)
+		{
+			List<TelemetryEvent> batch = new List<TelemetryEvent>(eventCount);
+			for (int i = 0; i < eventCount; i++)
+			{
+				Dictionary<string, object> attributes = new Dictionary<string, object>();
+				attributes.Add(TelemetryEvent.KeyUserId, "2b6a1d4e-6f3c-4c39-9b8a-" + i.ToString("000000000000"));
+				attributes.Add(TelemetryEvent.KeyEnabledTelemetry, false);
+				attributes.Add(TelemetryEvent.KeySdkIdentifier, "MapboxEventsUnityLinuxPlayer");
+				attributes.Add(TelemetryEvent.KeySkuId, "05");
+				attributes.Add(TelemetryEvent.KeySdkVersion, "2.1.1");
+				// GPS precision, 7 decimals
+				attributes.Add(TelemetryEvent.KeyLatitude, Math.Round(48.2081743 + i * 0.0001, 7));
+				attributes.Add(TelemetryEvent.KeyLongitude, Math.Round(16.3738189 - i * 0.0001, 7));
+				attributes.Add(TelemetryEvent.KeyZoomLevel, 16);
+				attributes.Add("tiles", new List<object>() { i, i + 1, "v4" });
+				batch.Add(new TelemetryEvent(i % 2 == 0 ? TelemetryEvent.TypeAppUserTurnstile : "map.load", 1571234567 + i, attributes));
+			}
+			return batch;
+		}
+
+
+		private string encodeToString(List<TelemetryEvent> batch, bool compress)
+		{
+			int length = _encoder.Encode(batch, compress);
+			return Encoding.UTF8.GetString(_encoder.Buffer, 0, length);
+		}
+
+
+		private string serializeWithJsonNet(List<TelemetryEvent> batch)
+		{
+			// the path used by 'TelemetryFallback' before the encoder existed
+			List<Dictionary<string, object>> payloads = new List<Dictionary<string, object>>(batch.Count);
+			foreach (TelemetryEvent telemetryEvent in batch)
+			{
+				payloads.Add(telemetryEvent.ToPayload());
+			}
+			return JsonConvert.SerializeObject(payloads);
+		}
+
+
+		private void logRun(string label, int batchSize, int iterations, Action encode)
+		{
+			GC.Collect();
+			long memoryBefore = GC.GetTotalMemory(true);
+			int collectionsBefore = GC.CollectionCount(0);
+
+			Stopwatch sw = Stopwatch.StartNew();
+			for (int i = 0; i < iterations; i++)
+			{
+				encode();
+			}
+			sw.Stop();
+
+			// only meaningful as long as no collection happened during the run
+			long allocated = GC.GetTotalMemory(false) - memoryBefore;
+			int collections = GC.CollectionCount(0) - collectionsBefore;
+
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] {1} batches of {2} events: {3:0} events/s, ~{4} bytes allocated per batch, {5} gen0 collections"
+				, label
+				, iterations
+				, batchSize
+				, iterations * batchSize / Math.Max(sw.Elapsed.TotalSeconds, 0.000001)
+				, Math.Max(allocated, 0) / iterations
+				, collections
+			));
+		}
+
+
+		#endregion
+
+
+	}
+}
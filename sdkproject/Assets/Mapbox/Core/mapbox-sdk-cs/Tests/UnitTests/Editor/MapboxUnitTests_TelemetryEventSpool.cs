@@ -0,0 +1,447 @@
+//-----------------------------------------------------------------------
+// <copyright file="MapboxUnitTests_TelemetryEventSpool.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using System.Text;
+	using System.Threading;
+	using Mapbox.Unity.Telemetry;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class TelemetryEventSpoolTest
+	{
+
+
+		private class FlakySender : ITelemetryEventSender
+		{
+			public volatile bool Online;
+			public volatile bool Reject;
+			public readonly List<string> Delivered = new List<string>();
+
+			public TelemetrySendResult Send(string url, string userAgent, byte[] body, int bodyLength, string contentEncoding)
+			{
+				if (!Online) { return TelemetrySendResult.Failed; }
+				if (Reject) { return TelemetrySendResult.Rejected; }
+
+				byte[] received = new byte[bodyLength];
+				Buffer.BlockCopy(body, 0, received, 0, bodyLength);
+				lock (Delivered)
+				{
+					Delivered.Add(Encoding.UTF8.GetString(Compression.Decompress(received)));
+				}
+				return TelemetrySendResult.Accepted;
+			}
+		}
+
+
+		private string _spoolPath;
+
+
+		[SetUp]
+		public void SetUp()
+		{
+			_spoolPath = Path.Combine(Path.GetTempPath(), "mapbox-unittest-" + Guid.NewGuid().ToString("N") + ".spool");
+		}
+
+
+		[TearDown]
+		public void TearDown()
+		{
+			if (File.Exists(_spoolPath)) { File.Delete(_spoolPath); }
+			if (File.Exists(_spoolPath + ".compact")) { File.Delete(_spoolPath + ".compact"); }
+		}
+
+
+		[Test]
+		public void AppendPeekAcknowledge()
+		{
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				Assert.IsTrue(append(spool, "first"));
+				Assert.IsTrue(append(spool, "second"));
+				Assert.AreEqual(2, spool.PendingBatches);
+
+				Assert.AreEqual("first", peek(spool));
+				spool.Acknowledge();
+				Assert.AreEqual("second", peek(spool));
+				spool.Acknowledge();
+
+				byte[] payload;
+				Assert.IsFalse(spool.TryPeek(out payload));
+				Assert.AreEqual(16, spool.Length, "spool was not truncated after everything was acknowledged");
+			}
+		}
+
+
+		[Test]
+		public void SurvivesReopen()
+		{
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				append(spool, "first");
+				append(spool, "second");
+				append(spool, "third");
+				spool.Acknowledge();
+			}
+
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				Assert.AreEqual(2, spool.PendingBatches, "read cursor was not persisted");
+				Assert.AreEqual("second", peek(spool));
+			}
+		}
+
+
+		[Test]
+		public void TornRecordIsDropped()
+		{
+			long validLength;
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				append(spool, "complete");
+				validLength = spool.Length;
+				append(spool, "torn record");
+			}
+
+			// simulate a crash in the middle of the last append
+			using (FileStream file = new FileStream(_spoolPath, FileMode.Open))
+			{
+				file.SetLength(file.Length - 3);
+			}
+
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				Assert.AreEqual(1, spool.PendingBatches);
+				Assert.AreEqual(validLength, spool.Length);
+				Assert.AreEqual("complete", peek(spool));
+
+				// appending after recovery must still work
+				append(spool, "after crash");
+				Assert.AreEqual(2, spool.PendingBatches);
+			}
+		}
+
+
+		[Test]
+		public void CorruptedRecordIsDropped()
+		{
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				append(spool, "good");
+				append(spool, "flipped");
+			}
+
+			using (FileStream file = new FileStream(_spoolPath, FileMode.Open))
+			{
+				file.Position = file.Length - 1;
+				file.WriteByte((byte)'X');
+			}
+
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				Assert.AreEqual(1, spool.PendingBatches, "checksum mismatch was not detected");
+				Assert.AreEqual("good", peek(spool));
+			}
+		}
+
+
+		[Test]
+		public void CompactsAcknowledgedPrefix()
+		{
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath, 1024 * 1024, 256))
+			{
+				for (int i = 0; i < 50; i++)
+				{
+					append(spool, "batch " + i.ToString());
+				}
+				long fullLength = spool.Length;
+
+				for (int i = 0; i < 40; i++)
+				{
+					spool.Acknowledge();
+				}
+
+				Assert.Less(spool.Length, fullLength, "acknowledged batches were not compacted away");
+				Assert.AreEqual(10, spool.PendingBatches);
+				Assert.AreEqual("batch 40", peek(spool));
+			}
+
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				Assert.AreEqual(10, spool.PendingBatches);
+				Assert.AreEqual("batch 40", peek(spool));
+			}
+		}
+
+
+		[Test]
+		public void FailedCompactionKeepsSpoolUsable()
+		{
+			// nothing can be created where the compacted spool goes
+			Directory.CreateDirectory(_spoolPath + ".compact");
+			try
+			{
+				using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath, 1024 * 1024, 64))
+				{
+					for (int i = 0; i < 20; i++)
+					{
+						append(spool, "batch " + i.ToString());
+					}
+					for (int i = 0; i < 15; i++)
+					{
+						spool.Acknowledge();
+					}
+
+					Assert.AreEqual(5, spool.PendingBatches);
+					Assert.AreEqual("batch 15", peek(spool));
+					Assert.IsTrue(append(spool, "after"));
+				}
+
+				using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+				{
+					Assert.AreEqual(6, spool.PendingBatches, "read cursor was not persisted without compaction");
+					Assert.AreEqual("batch 15", peek(spool));
+				}
+			}
+			finally
+			{
+				Directory.Delete(_spoolPath + ".compact");
+			}
+		}
+
+
+		[Test]
+		public void SizeLimit()
+		{
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath, 64, 32))
+			{
+				Assert.IsTrue(append(spool, "0123456789"));
+				Assert.IsFalse(append(spool, new string('x', 64)), "spool grew beyond its limit");
+				Assert.AreEqual(1, spool.PendingBatches);
+			}
+		}
+
+
+		[Test]
+		public void ManagerReplaysAfterRestart()
+		{
+			FlakySender sender = new FlakySender();
+
+			// session 1: network is down
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 60 * 1000, spool))
+				{
+					manager.Initialize("http://localhost/events", "unittest");
+					manager.EnqueueEvent("offline");
+					manager.Flush();
+					waitFor(() => spool.PendingBatches == 1);
+				}
+				Assert.AreEqual(1, spool.PendingBatches, "undelivered batch was not spooled");
+			}
+
+			// session 2: network is back, spooled batch goes out on initialize
+			sender.Online = true;
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 60 * 1000, spool))
+				{
+					manager.Initialize("http://localhost/events", "unittest");
+					waitFor(() => spool.PendingBatches == 0);
+				}
+				Assert.AreEqual(0, spool.PendingBatches);
+			}
+
+			Assert.AreEqual(1, sender.Delivered.Count);
+			StringAssert.Contains("\"event\":\"offline\"", sender.Delivered[0]);
+		}
+
+
+		[Test]
+		public void ManagerCountsSpooledEventsOnceDelivered()
+		{
+			FlakySender sender = new FlakySender();
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 60 * 1000, spool))
+				{
+					manager.Initialize("http://localhost/events", "unittest");
+					manager.EnqueueEvent("offline");
+					manager.Flush();
+					waitFor(() => spool.PendingBatches == 1);
+					Assert.AreEqual(0, manager.SentEvents, "spooled event was counted before it was delivered");
+
+					sender.Online = true;
+					manager.Flush();
+					waitFor(() => manager.SentEvents == 1);
+					Assert.AreEqual(1, manager.SentEvents);
+					Assert.AreEqual(0, spool.PendingBatches);
+				}
+			}
+		}
+
+
+		[Test]
+		public void ManagerDropsSpooledBatchAfterMaximumAttempts()
+		{
+			FlakySender sender = new FlakySender();
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 60 * 1000, spool))
+				{
+					manager.MaximumSendAttempts = 3;
+					manager.Initialize("http://localhost/events", "unittest");
+					manager.EnqueueEvent("undeliverable");
+					flushUntil(manager, () => spool.PendingBatches == 1);
+					flushUntil(manager, () => spool.PendingBatches == 0);
+					Assert.AreEqual(0, spool.PendingBatches, "failing batch was retried forever");
+					Assert.AreEqual(1, manager.FailedEvents);
+
+					// batches behind it go out again
+					sender.Online = true;
+					manager.EnqueueEvent("next");
+					flushUntil(manager, () => manager.SentEvents == 1);
+					Assert.AreEqual(1, manager.SentEvents);
+				}
+			}
+
+			Assert.AreEqual(1, sender.Delivered.Count);
+			StringAssert.Contains("\"event\":\"next\"", sender.Delivered[0]);
+		}
+
+
+		[Test]
+		public void ManagerDropsRejectedSpooledBatch()
+		{
+			FlakySender sender = new FlakySender();
+			sender.Online = true;
+			sender.Reject = true;
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 60 * 1000, spool))
+				{
+					manager.Initialize("http://localhost/events", "unittest");
+					manager.EnqueueEvent("rejected");
+					manager.Flush();
+					waitFor(() => manager.FailedEvents == 1);
+					Assert.AreEqual(1, manager.FailedEvents);
+					Assert.AreEqual(0, manager.SentEvents);
+					Assert.AreEqual(0, spool.PendingBatches, "rejected batch is blocking the spool");
+				}
+			}
+		}
+
+
+		[Test]
+		public void ManagerPostsDirectlyWhenSpoolFails()
+		{
+			FlakySender sender = new FlakySender();
+			sender.Online = true;
+			TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath);
+			// every spool call throws from now on
+			spool.Dispose();
+			using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 60 * 1000, spool))
+			{
+				manager.Initialize("http://localhost/events", "unittest");
+				manager.EnqueueEvent("first");
+				manager.Flush();
+				waitFor(() => manager.SentEvents == 1);
+				Assert.IsTrue(manager.SpoolFailed);
+
+				// flush thread is still alive
+				manager.EnqueueEvent("second");
+				manager.Flush();
+				waitFor(() => manager.SentEvents == 2);
+				Assert.AreEqual(2, manager.SentEvents);
+			}
+		}
+
+
+		[Test]
+		public void OpenTime()
+		{
+			const int batchCount = 2000;
+			byte[] batch = Encoding.UTF8.GetBytes("[{\"event\":\"appUserTurnstile\",\"created\":1571234567,\"skuId\":\"05\"}]");
+
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath, 64 * 1024 * 1024, 1024 * 1024))
+			{
+				for (int i = 0; i < batchCount; i++)
+				{
+					spool.Append(batch, batch.Length);
+				}
+			}
+
+			Stopwatch sw = Stopwatch.StartNew();
+			using (TelemetryEventSpool spool = new TelemetryEventSpool(_spoolPath))
+			{
+				sw.Stop();
+				Assert.AreEqual(batchCount, spool.PendingBatches);
+			}
+
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] opened spool with {1} batches in {2:0.000}ms"
+				, "TelemetryEventSpool"
+				, batchCount
+				, sw.Elapsed.TotalMilliseconds
+			));
+		}
+
+
+		#region helper methods
+
+
+		private bool append(TelemetryEventSpool spool, string payload)
+		{
+			byte[] bytes = Encoding.UTF8.GetBytes(payload);
+			return spool.Append(bytes, bytes.Length);
+		}
+
+
+		private string peek(TelemetryEventSpool spool)
+		{
+			byte[] payload;
+			Assert.IsTrue(spool.TryPeek(out payload), "spool is empty");
+			return Encoding.UTF8.GetString(payload);
+		}
+
+
+		/// <summary> Flush again and again, an AutoResetEvent swallows signals sent while the flush thread is busy. </summary>
+		private void flushUntil(TelemetryEventsManager manager, Func<bool> condition)
+		{
+			Stopwatch sw = Stopwatch.StartNew();
+			while (!condition() && sw.ElapsedMilliseconds < 5000)
+			{
+				manager.Flush();
+				Thread.Sleep(20);
+			}
+		}
+
+
+		private void waitFor(Func<bool> condition)
+		{
+			Stopwatch sw = Stopwatch.StartNew();
+			while (!condition() && sw.ElapsedMilliseconds < 5000)
+			{
+				Thread.Sleep(10);
+			}
+		}
+
+
+		#endregion
+
+
+	}
+}
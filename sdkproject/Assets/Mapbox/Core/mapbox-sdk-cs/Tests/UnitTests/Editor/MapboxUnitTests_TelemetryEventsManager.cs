@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------
+// <copyright file="MapboxUnitTests_TelemetryEventsManager.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using System.Net;
+	using System.Text;
+	using System.Threading;
+	using Mapbox.Unity.Telemetry;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class TelemetryEventsManagerTest
+	{
+
+
+		private class RecordingSender : ITelemetryEventSender
+		{
+			public readonly List<string> Bodies = new List<string>();
+			public readonly AutoResetEvent Received = new AutoResetEvent(false);
+			public TelemetrySendResult Result = TelemetrySendResult.Accepted;
+
+			public TelemetrySendResult Send(string url, string userAgent, byte[] body, int bodyLength, string contentEncoding)
+			{
+				byte[] received = new byte[bodyLength];
+				Buffer.BlockCopy(body, 0, received, 0, bodyLength);
+				if (TelemetryEventEncoder.ContentEncodingGzip == contentEncoding)
+				{
+					received = Compression.Decompress(received);
+				}
+
+				lock (Bodies)
+				{
+					Bodies.Add(Encoding.UTF8.GetString(received));
+				}
+				Received.Set();
+				return Result;
+			}
+		}
+
+
+		[Test]
+		public void QueueCapacityIsPowerOfTwo()
+		{
+			Assert.AreEqual(8, new TelemetryEventQueue<string>(5).Capacity);
+			Assert.AreEqual(1024, new TelemetryEventQueue<string>(1024).Capacity);
+		}
+
+
+		[Test]
+		public void QueueIsFifoAndBounded()
+		{
+			TelemetryEventQueue<string> queue = new TelemetryEventQueue<string>(4);
+			Assert.IsTrue(queue.TryEnqueue("a"));
+			Assert.IsTrue(queue.TryEnqueue("b"));
+			Assert.IsTrue(queue.TryEnqueue("c"));
+			Assert.IsTrue(queue.TryEnqueue("d"));
+			Assert.IsFalse(queue.TryEnqueue("e"), "full queue accepted an item");
+			Assert.AreEqual(4, queue.Count);
+
+			string item;
+			Assert.IsTrue(queue.TryDequeue(out item));
+			Assert.AreEqual("a", item);
+			Assert.IsTrue(queue.TryEnqueue("e"), "freed slot was not reused");
+
+			List<string> rest = new List<string>();
+			Assert.AreEqual(4, queue.DequeueBatch(rest, 10));
+			CollectionAssert.AreEqual(new string[] { "b", "c", "d", "e" }, rest);
+			Assert.IsFalse(queue.TryDequeue(out item));
+			Assert.AreEqual(0, queue.Count);
+		}
+
+
+		[Test]
+		public void QueueConcurrentProducers()
+		{
+			const int producerCount = 4;
+			const int itemsPerProducer = 20000;
+
+			TelemetryEventQueue<string> queue = new TelemetryEventQueue<string>(1024);
+			HashSet<string> received = new HashSet<string>();
+			int finishedProducers = 0;
+
+			Thread[] producers = new Thread[producerCount];
+			for (int p = 0; p < producerCount; p++)
+			{
+				int producerId = p;
+				producers[p] = new Thread(() =>
+				{
+					for (int i = 0; i < itemsPerProducer; i++)
+					{
+						string item = producerId.ToString() + "-" + i.ToString();
+						while (!queue.TryEnqueue(item)) { Thread.Sleep(0); }
+					}
+					Interlocked.Increment(ref finishedProducers);
+				});
+				producers[p].Start();
+			}
+
+			Stopwatch sw = Stopwatch.StartNew();
+			string dequeued;
+			while (Thread.VolatileRead(ref finishedProducers) < producerCount || queue.Count > 0)
+			{
+				if (queue.TryDequeue(out dequeued))
+				{
+					Assert.IsTrue(received.Add(dequeued), "item dequeued twice: {0}", dequeued);
+				}
+			}
+			sw.Stop();
+
+			foreach (Thread producer in producers) { producer.Join(); }
+
+			Assert.AreEqual(producerCount * itemsPerProducer, received.Count, "lost items");
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] {1} items from {2} producers in {3}ms ({4:0} items/s)"
+				, "TelemetryEventQueue"
+				, received.Count
+				, producerCount
+				, sw.ElapsedMilliseconds
+				, received.Count / Math.Max(sw.Elapsed.TotalSeconds, 0.001)
+			));
+		}
+
+
+		[Test]
+		public void SizeTriggeredFlush()
+		{
+			RecordingSender sender = new RecordingSender();
+			// flush interval long enough to only flush because of size
+			using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 10, 60 * 1000))
+			{
+				manager.Initialize("http://localhost/events", "unittest");
+				for (int i = 0; i < 10; i++)
+				{
+					manager.EnqueueEvent("unittest", new Dictionary<string, object>() { { "index", i } });
+				}
+
+				Assert.IsTrue(sender.Received.WaitOne(5000), "batch was not sent");
+				Assert.AreEqual(1, sender.Bodies.Count);
+				StringAssert.StartsWith("[{", sender.Bodies[0]);
+				StringAssert.Contains("\"event\":\"unittest\"", sender.Bodies[0]);
+				StringAssert.Contains("\"created\":", sender.Bodies[0]);
+			}
+		}
+
+
+		[Test]
+		public void TimeTriggeredFlush()
+		{
+			RecordingSender sender = new RecordingSender();
+			using (TelemetryEventsManager manager = new TelemetryEventsManager(sender, 64, 100, 100))
+			{
+				manager.Initialize("http://localhost/events", "unittest");
+				manager.EnqueueEvent(TelemetryEvent.TypeAppUserTurnstile);
+
+				Assert.IsTrue(sender.Received.WaitOne(5000), "interval did not trigger a flush");
+
+				// events are counted once the sender returns
+				Stopwatch sw = Stopwatch.StartNew();
+				while (manager.SentEvents == 0 && sw.ElapsedMilliseconds < 5000) { Thread.Sleep(10); }
+				Assert.AreEqual(1, manager.SentEvents);
+				Assert.AreEqual(0, manager.PendingEvents);
+			}
+		}
+
+
+		[Test]
+		public void FullQueueDropsWithoutBlocking()
+		{
+			RecordingSender sender = new RecordingSender();
+			// not initialized: nothing drains the queue
+			TelemetryEventsManager manager = new TelemetryEventsManager(sender, 4, 100, 60 * 1000);
+			for (int i = 0; i < 10; i++)
+			{
+				manager.EnqueueEvent("unittest");
+			}
+
+			Assert.AreEqual(4, manager.EnqueuedEvents);
+			Assert.AreEqual(6, manager.DroppedEvents);
+
+			manager.ResetEventQueuing();
+			Assert.AreEqual(0, manager.PendingEvents);
+		}
+
+
+		[Test]
+		public void PostToLocalStub()
+		{
+			int port = 18000 + new System.Random().Next(1000);
+			string prefix = string.Format("http://localhost:{0}/", port);
+			string receivedBody = null;
+			string receivedUserAgent = null;
+			string receivedContentEncoding = null;
+
+			HttpListener listener = new HttpListener();
+			listener.Prefixes.Add(prefix);
+			listener.Start();
+			try
+			{
+				Thread stub = new Thread(() =>
+				{
+					HttpListenerContext context = listener.GetContext();
+					using (MemoryStream body = new MemoryStream())
+					{
+						byte[] chunk = new byte[4096];
+						int read;
+						while ((read = context.Request.InputStream.Read(chunk, 0, chunk.Length)) > 0)
+						{
+							body.Write(chunk, 0, read);
+						}
+						receivedBody = Encoding.UTF8.GetString(Compression.Decompress(body.ToArray()));
+					}
+					receivedUserAgent = context.Request.UserAgent;
+					receivedContentEncoding = context.Request.Headers["Content-Encoding"];
+					context.Response.StatusCode = 204;
+					context.Response.Close();
+				});
+				stub.Start();
+
+				using (TelemetryEventsManager manager = new TelemetryEventsManager(new TelemetryHttpEventSender(5000)))
+				{
+					manager.Initialize(prefix + "events/v2?access_token=pk.test", "MapboxEventsUnityTest/1.0");
+					manager.EnqueueEvent(TelemetryEvent.TypeAppUserTurnstile, new Dictionary<string, object>() { { "skuId", "05" } });
+					manager.Flush();
+
+					Assert.IsTrue(stub.Join(5000), "stub server did not receive a request");
+
+					Stopwatch sw = Stopwatch.StartNew();
+					while (manager.SentEvents == 0 && sw.ElapsedMilliseconds < 5000) { Thread.Sleep(10); }
+					Assert.AreEqual(1, manager.SentEvents, "sender did not report success");
+				}
+
+				Assert.AreEqual("MapboxEventsUnityTest/1.0", receivedUserAgent);
+				Assert.AreEqual("gzip", receivedContentEncoding);
+				StringAssert.Contains("\"event\":\"appUserTurnstile\"", receivedBody);
+				StringAssert.Contains("\"skuId\":\"05\"", receivedBody);
+			}
+			finally
+			{
+				listener.Close();
+			}
+		}
+
+
+		[Test]
+		public void EnqueueThroughput()
+		{
+			const int eventCount = 100000;
+			RecordingSender sender = new RecordingSender();
+			TelemetryEventsManager manager = new TelemetryEventsManager(sender, eventCount, 180, 60 * 1000);
+			Dictionary<string, object> attributes = new Dictionary<string, object>();
+			TelemetryEvent[] events = new TelemetryEvent[eventCount];
+			for (int i = 0; i < eventCount; i++)
+			{
+				events[i] = new TelemetryEvent("unittest", attributes);
+			}
+
+			Stopwatch sw = Stopwatch.StartNew();
+			for (int i = 0; i < eventCount; i++)
+			{
+				manager.EnqueueEvent(events[i]);
+			}
+			sw.Stop();
+
+			Assert.AreEqual(eventCount, manager.EnqueuedEvents);
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] {1} events enqueued in {2:0.000}ms, {3:0.0}ns/event"
+				, "TelemetryEventsManager"
+				, eventCount
+				, sw.Elapsed.TotalMilliseconds
+				, sw.Elapsed.TotalMilliseconds * 1000000.0 / eventCount
+			));
+		}
+
+
+	}
+}
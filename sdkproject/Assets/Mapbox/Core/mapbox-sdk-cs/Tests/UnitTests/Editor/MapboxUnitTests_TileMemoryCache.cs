@@ -0,0 +1,229 @@
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.Map;
+	using Mapbox.Platform.Cache;
+	using NUnit.Framework;
+	using System;
+	using System.Diagnostics;
+	using System.Globalization;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class TileMemoryCacheTest
+	{
+
+
+		private const string TS_VECTOR = "mapbox.mapbox-streets-v7";
+		private const string TS_IMAGERY = "mapbox.satellite";
+
+
+		[Test]
+		public void ByteBudget()
+		{
+			// room for 10 'raster' tiles of ~10KB
+			TileMemoryCache cache = new TileMemoryCache(1000, 10 * (10 * 1024 + 128), TileMemoryCachePolicy.Lru);
+
+			for (int x = 0; x < 100; x++)
+			{
+				cache.Add(TS_VECTOR, new CanonicalTileId(16, x, 0), cacheItem(100), false);
+			}
+			Assert.AreEqual(100, cache.Count, "small tiles were evicted although they fit into the budget");
+
+			for (int x = 0; x < 20; x++)
+			{
+				cache.Add(TS_IMAGERY, new CanonicalTileId(16, x, 0), cacheItem(10 * 1024), false);
+			}
+			Assert.LessOrEqual(cache.Bytes, cache.MaxCacheBytes, "byte budget exceeded");
+			Assert.IsNotNull(cache.Get(TS_IMAGERY, new CanonicalTileId(16, 19, 0)), "most recent tile was evicted");
+			Assert.IsNull(cache.Get(TS_VECTOR, new CanonicalTileId(16, 0, 0)), "oldest tile was not evicted");
+			Assert.Greater(cache.Evictions, 0L);
+		}
+
+
+		[Test]
+		public void TileCountBudget()
+		{
+			TileMemoryCache cache = new TileMemoryCache(10, 0, TileMemoryCachePolicy.Lru);
+			for (int x = 0; x < 25; x++)
+			{
+				cache.Add(TS_VECTOR, new CanonicalTileId(16, x, 0), cacheItem(100), false);
+			}
+			Assert.AreEqual(10, cache.Count);
+			Assert.AreEqual(15, cache.Evictions);
+		}
+
+
+		[Test]
+		public void LruEvictsLeastRecentlyUsed()
+		{
+			TileMemoryCache cache = new TileMemoryCache(3, 0, TileMemoryCachePolicy.Lru);
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 0, 0), cacheItem(10), false);
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 1, 0), cacheItem(10), false);
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 0, 1), cacheItem(10), false);
+
+			// touch the oldest one, the second one becomes the victim
+			Assert.IsNotNull(cache.Get(TS_VECTOR, new CanonicalTileId(1, 0, 0)));
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 1, 1), cacheItem(10), false);
+
+			Assert.IsNotNull(cache.Get(TS_VECTOR, new CanonicalTileId(1, 0, 0)));
+			Assert.IsNull(cache.Get(TS_VECTOR, new CanonicalTileId(1, 1, 0)));
+		}
+
+
+		[Test]
+		public void ContainsDoesNotTouch()
+		{
+			TileMemoryCache cache = new TileMemoryCache(3, 0, TileMemoryCachePolicy.Lru);
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 0, 0), cacheItem(10), false);
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 1, 0), cacheItem(10), false);
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 0, 1), cacheItem(10), false);
+
+			// unlike 'Get()' the oldest one stays the victim
+			Assert.IsTrue(cache.Contains(TS_VECTOR, new CanonicalTileId(1, 0, 0)));
+			Assert.IsFalse(cache.Contains(TS_VECTOR, new CanonicalTileId(1, 1, 1)));
+			Assert.IsFalse(cache.Contains(TS_IMAGERY, new CanonicalTileId(1, 0, 0)));
+			Assert.AreEqual(0, cache.Hits);
+			Assert.AreEqual(0, cache.Misses);
+
+			cache.Add(TS_VECTOR, new CanonicalTileId(1, 1, 1), cacheItem(10), false);
+			Assert.IsFalse(cache.Contains(TS_VECTOR, new CanonicalTileId(1, 0, 0)));
+			Assert.IsTrue(cache.Contains(TS_VECTOR, new CanonicalTileId(1, 1, 0)));
+		}
+
+
+		[Test]
+		public void ArcSurvivesScan()
+		{
+			TileMemoryCache lru = new TileMemoryCache(100, 0, TileMemoryCachePolicy.Lru);
+			TileMemoryCache arc = new TileMemoryCache(100, 0, TileMemoryCachePolicy.Arc);
+
+			foreach (TileMemoryCache cache in new TileMemoryCache[] { lru, arc })
+			{
+				// working set around the camera, requested over and over
+				for (int round = 0; round < 3; round++)
+				{
+					for (int x = 0; x < 50; x++)
+					{
+						CanonicalTileId tileId = new CanonicalTileId(16, x, 0);
+						if (null == cache.Get(TS_VECTOR, tileId)) { cache.Add(TS_VECTOR, tileId, cacheItem(100), true); }
+					}
+				}
+				// fly-over: tiles seen only once
+				for (int x = 0; x < 500; x++)
+				{
+					cache.Add(TS_VECTOR, new CanonicalTileId(16, x, 1), cacheItem(100), true);
+				}
+			}
+
+			int lruHits = 0;
+			int arcHits = 0;
+			for (int x = 0; x < 50; x++)
+			{
+				if (null != lru.Get(TS_VECTOR, new CanonicalTileId(16, x, 0))) { lruHits++; }
+				if (null != arc.Get(TS_VECTOR, new CanonicalTileId(16, x, 0))) { arcHits++; }
+			}
+
+			Assert.AreEqual(0, lruHits, "LRU should have been flushed by the scan");
+			Assert.AreEqual(50, arcHits, "ARC lost frequently used tiles to a scan");
+		}
+
+
+		[Test]
+		public void ReplaceIfExistsAndCounters()
+		{
+			TileMemoryCache cache = new TileMemoryCache(10, 0);
+			CanonicalTileId tileId = new CanonicalTileId(2, 1, 1);
+
+			Assert.IsNull(cache.Get(TS_VECTOR, tileId));
+			cache.Add(TS_VECTOR, tileId, cacheItem(10), false);
+			cache.Add(TS_VECTOR, tileId, cacheItem(20), false);
+			Assert.AreEqual(10, cache.Get(TS_VECTOR, tileId).Data.Length, "tile was replaced without 'replaceIfExists'");
+
+			cache.Add(TS_VECTOR, tileId, cacheItem(30), true);
+			Assert.AreEqual(30, cache.Get(TS_VECTOR, tileId).Data.Length, "tile was not replaced");
+			Assert.AreEqual(30 + 128, cache.Bytes);
+
+			Assert.AreEqual(2, cache.Hits);
+			Assert.AreEqual(1, cache.Misses);
+		}
+
+
+		[Test]
+		public void ClearTileset()
+		{
+			TileMemoryCache cache = new TileMemoryCache(10, 0);
+			cache.Add(TS_VECTOR, new CanonicalTileId(0, 0, 0), cacheItem(10), false);
+			cache.Add(TS_IMAGERY, new CanonicalTileId(0, 0, 0), cacheItem(10), false);
+
+			cache.Clear(TS_VECTOR);
+
+			Assert.IsNull(cache.Get(TS_VECTOR, new CanonicalTileId(0, 0, 0)));
+			Assert.IsNotNull(cache.Get(TS_IMAGERY, new CanonicalTileId(0, 0, 0)));
+			Assert.AreEqual(1, cache.Count);
+		}
+
+
+		[Test]
+		public void TileMemoryCacheVsMemoryCache()
+		{
+			const uint maxTiles = 500;
+			const int operations = 20000;
+
+			logRun("MemoryCache", new MemoryCache(maxTiles), operations);
+			logRun("TileMemoryCache LRU", new TileMemoryCache(maxTiles, 0, TileMemoryCachePolicy.Lru), operations);
+			logRun("TileMemoryCache ARC", new TileMemoryCache(maxTiles, 0, TileMemoryCachePolicy.Arc), operations);
+		}
+
+
+		#region helper methods
+
+
+		private CacheItem cacheItem(int length)
+		{
+			return new CacheItem() { Data = new byte[length], ETag = "etag" };
+		}
+
+
+		/// <summary>
+		/// Mixed workload on a full cache: a working set that keeps being requested plus a stream of new tiles.
+		/// </summary>
+		private void logRun(string label, ICache cache, int operations)
+		{
+			CacheItem item = cacheItem(100);
+			int hits = 0;
+
+			Stopwatch sw = Stopwatch.StartNew();
+			for (int i = 0; i < operations; i++)
+			{
+				CanonicalTileId tileId = 0 == i % 2
+					? new CanonicalTileId(16, i % 300, 0)
+					: new CanonicalTileId(16, i, 1);
+				if (null != cache.Get(TS_VECTOR, tileId))
+				{
+					hits++;
+				}
+				else
+				{
+					cache.Add(TS_VECTOR, tileId, item, true);
+				}
+			}
+			sw.Stop();
+
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] {1} Get/Add in {2:0.000}ms, {3:0.000}us per operation, hit rate {4:0.0}%"
+				, label
+				, operations
+				, sw.Elapsed.TotalMilliseconds
+				, sw.Elapsed.TotalMilliseconds * 1000.0 / operations
+				, 100.0 * hits / operations
+			));
+		}
+
+
+		#endregion
+
+
+	}
+}
@@ -0,0 +1,387 @@
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.Map;
+	using Mapbox.Platform.Cache;
+	using NUnit.Framework;
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using ued = UnityEngine.Debug;
+
+
+	[TestFixture]
+	internal class TilePackTest
+	{
+
+
+		private const string _dbNameBaseline = "UNITTEST_TILEPACK_BASELINE.db";
+		private const string TS_TERRAIN = "mapbox.terrain-rgb";
+		private const string TS_VECTOR = "mapbox.mapbox-streets-v7";
+		private string _path;
+		private string _mbtilesPath;
+
+
+		[SetUp]
+		public void SetUp()
+		{
+			_path = Path.Combine(Path.GetTempPath(), "UNITTEST" + TilePackCache.FILE_EXTENSION);
+			_mbtilesPath = Path.Combine(Path.GetTempPath(), "UNITTEST.mbtiles");
+			deleteFiles();
+		}
+
+
+		[TearDown]
+		public void TearDown()
+		{
+			deleteFiles();
+		}
+
+
+		[Test]
+		public void WriteAndRead()
+		{
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				writer.Add(TS_VECTOR, new CanonicalTileId(14, 9326, 4739), cacheItem(0x01, 1024, "etag-1"));
+				writer.Add(TS_TERRAIN, new CanonicalTileId(14, 9326, 4739), cacheItem(0x02, 512, null));
+				Assert.IsFalse(File.Exists(_path), "pack was moved into place before it was finished");
+			}
+
+			using (TilePack pack = new TilePack(_path))
+			{
+				Assert.AreEqual(2, pack.Count);
+				CollectionAssert.AreEquivalent(new string[] { TS_VECTOR, TS_TERRAIN }, pack.Tilesets);
+
+				CacheItem ci = pack.Get(TS_VECTOR, new CanonicalTileId(14, 9326, 4739));
+				Assert.NotNull(ci, "tile not found");
+				Assert.AreEqual(1024, ci.Data.Length);
+				Assert.AreEqual(0x01, ci.Data[1023]);
+				Assert.AreEqual("etag-1", ci.ETag);
+				Assert.AreEqual(new DateTime(2019, 10, 15, 0, 0, 0, DateTimeKind.Utc), ci.LastModified.Value.ToUniversalTime());
+
+				ci = pack.Get(TS_TERRAIN, new CanonicalTileId(14, 9326, 4739));
+				Assert.AreEqual(512, ci.Data.Length);
+				Assert.AreEqual(0x02, ci.Data[0]);
+				Assert.IsNull(ci.ETag);
+
+				Assert.IsNull(pack.Get(TS_VECTOR, new CanonicalTileId(14, 9326, 4740)), "neighbour of a packed tile found");
+				Assert.IsNull(pack.Get(TS_VECTOR, new CanonicalTileId(13, 9326, 4739)), "tile of another zoom level found");
+				Assert.IsNull(pack.Get("mapbox.satellite", new CanonicalTileId(14, 9326, 4739)), "tile of an unknown tileset found");
+			}
+		}
+
+
+		[Test]
+		public void TileAddedTwiceIsReplaced()
+		{
+			CanonicalTileId tileId = new CanonicalTileId(3, 4, 5);
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				writer.Add(TS_VECTOR, tileId, cacheItem(0x01, 16, null));
+				writer.Add(TS_VECTOR, tileId, cacheItem(0x02, 32, null));
+				Assert.AreEqual(1, writer.Count);
+			}
+
+			using (TilePack pack = new TilePack(_path))
+			{
+				Assert.AreEqual(1, pack.Count);
+				Assert.AreEqual(0x02, pack.Get(TS_VECTOR, tileId).Data[0]);
+				Assert.AreEqual(32, pack.Get(TS_VECTOR, tileId).Data.Length);
+			}
+		}
+
+
+		[Test]
+		public void TilesAreOrderedByZoomColumnAndRow()
+		{
+			CanonicalTileId[] added = new CanonicalTileId[] {
+				new CanonicalTileId(16, 5, 1)
+				, new CanonicalTileId(2, 3, 0)
+				, new CanonicalTileId(16, 4, 9)
+				, new CanonicalTileId(16, 4, 2)
+				, new CanonicalTileId(0, 0, 0)
+				, new CanonicalTileId(22, (1 << 22) - 1, (1 << 22) - 1)
+			};
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				foreach (CanonicalTileId tileId in added)
+				{
+					writer.Add(TS_VECTOR, tileId, cacheItem((byte)tileId.Z, 8, null));
+					writer.Add(TS_TERRAIN, tileId, cacheItem((byte)tileId.Z, 8, null));
+				}
+			}
+
+			using (TilePack pack = new TilePack(_path))
+			{
+				List<CanonicalTileId> tiles = new List<CanonicalTileId>();
+				foreach (var tile in pack.GetTiles(TS_TERRAIN))
+				{
+					tiles.Add(tile.Key);
+					Assert.AreEqual((byte)tile.Key.Z, tile.Value.Data[0]);
+				}
+
+				CollectionAssert.AreEqual(
+					new CanonicalTileId[] {
+						new CanonicalTileId(0, 0, 0)
+						, new CanonicalTileId(2, 3, 0)
+						, new CanonicalTileId(16, 4, 2)
+						, new CanonicalTileId(16, 4, 9)
+						, new CanonicalTileId(16, 5, 1)
+						, new CanonicalTileId(22, (1 << 22) - 1, (1 << 22) - 1)
+					}
+					, tiles
+				);
+				foreach (CanonicalTileId tileId in added)
+				{
+					Assert.IsTrue(pack.Contains(TS_VECTOR, tileId), "{0} not found", tileId);
+				}
+			}
+		}
+
+
+		[Test]
+		public void AbortDiscardsPack()
+		{
+			TilePackWriter writer = new TilePackWriter(_path);
+			writer.Add(TS_VECTOR, new CanonicalTileId(0, 0, 0), cacheItem(0x01, 16, null));
+			writer.Abort();
+			writer.Dispose();
+
+			Assert.IsFalse(File.Exists(_path), "aborted pack was written");
+			Assert.IsFalse(File.Exists(_path + ".tmp"), "temporary file was not deleted");
+		}
+
+
+		[Test]
+		public void CorruptFilesAreRejected()
+		{
+			File.WriteAllBytes(_path, new byte[] { 0x1f, 0x8b, 0x08, 0x00 });
+			Assert.Throws<InvalidDataException>(() => new TilePack(_path), "file without magic was opened");
+
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				writer.Add(TS_VECTOR, new CanonicalTileId(0, 0, 0), cacheItem(0x01, 16, null));
+			}
+			byte[] bytes = File.ReadAllBytes(_path);
+			Array.Resize(ref bytes, bytes.Length - 8);
+			File.WriteAllBytes(_path, bytes);
+			Assert.Throws<InvalidDataException>(() => new TilePack(_path), "truncated pack was opened");
+		}
+
+
+		[Test]
+		public void CacheServesPacksInOrder()
+		{
+			string directory = Path.Combine(Path.GetTempPath(), "UNITTEST_TILEPACKS");
+			if (Directory.Exists(directory)) { Directory.Delete(directory, true); }
+			Directory.CreateDirectory(directory);
+			using (TilePackWriter writer = new TilePackWriter(Path.Combine(directory, "a" + TilePackCache.FILE_EXTENSION)))
+			{
+				writer.Add(TS_VECTOR, new CanonicalTileId(1, 0, 0), cacheItem(0x01, 16, null));
+			}
+			using (TilePackWriter writer = new TilePackWriter(Path.Combine(directory, "b" + TilePackCache.FILE_EXTENSION)))
+			{
+				writer.Add(TS_VECTOR, new CanonicalTileId(1, 0, 0), cacheItem(0x02, 16, null));
+				writer.Add(TS_VECTOR, new CanonicalTileId(1, 1, 0), cacheItem(0x02, 16, null));
+			}
+			File.WriteAllBytes(Path.Combine(directory, "c.mbtiles"), new byte[16]);
+
+			try
+			{
+				using (TilePackCache cache = new TilePackCache())
+				{
+					Assert.AreEqual(2, cache.OpenDirectory(directory), "unexpected number of packs opened");
+
+					Assert.AreEqual(0x01, cache.Get(TS_VECTOR, new CanonicalTileId(1, 0, 0)).Data[0], "first pack was not looked up first");
+					Assert.AreEqual(0x02, cache.Get(TS_VECTOR, new CanonicalTileId(1, 1, 0)).Data[0], "second pack was not looked up");
+					Assert.IsNull(cache.Get(TS_VECTOR, new CanonicalTileId(1, 1, 1)));
+					Assert.AreEqual(2, cache.Hits);
+					Assert.AreEqual(1, cache.Misses);
+
+					// read-only
+					cache.Add(TS_VECTOR, new CanonicalTileId(1, 1, 1), cacheItem(0x03, 16, null), true);
+					cache.Clear();
+					Assert.IsNull(cache.Get(TS_VECTOR, new CanonicalTileId(1, 1, 1)));
+					Assert.NotNull(cache.Get(TS_VECTOR, new CanonicalTileId(1, 0, 0)));
+
+					TilePack closed = cache.Packs[0];
+					Assert.IsTrue(cache.Close(closed));
+					Assert.IsFalse(cache.Close(closed));
+					Assert.AreEqual(0x02, cache.Get(TS_VECTOR, new CanonicalTileId(1, 0, 0)).Data[0], "closed pack still served");
+				}
+			}
+			finally
+			{
+				Directory.Delete(directory, true);
+			}
+		}
+
+
+		[Test]
+		public void CopyToCache()
+		{
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				for (int x = 0; x < 10; x++)
+				{
+					writer.Add(TS_TERRAIN, new CanonicalTileId(10, x, 300), cacheItem((byte)x, 64, "etag"));
+				}
+			}
+
+			MemoryCache memory = new MemoryCache(100);
+			using (TilePack pack = new TilePack(_path))
+			{
+				Assert.AreEqual(10, pack.CopyTo(memory, false));
+			}
+			for (int x = 0; x < 10; x++)
+			{
+				CacheItem ci = memory.Get(TS_TERRAIN, new CanonicalTileId(10, x, 300));
+				Assert.NotNull(ci, "tile {0} was not copied", x);
+				Assert.AreEqual((byte)x, ci.Data[0]);
+				Assert.AreEqual("etag", ci.ETag);
+			}
+		}
+
+
+		[Test]
+		public void MBTilesRoundtrip()
+		{
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				writer.Add(TS_VECTOR, new CanonicalTileId(2, 1, 0), cacheItem(0x01, 16, null));
+				writer.Add(TS_VECTOR, new CanonicalTileId(2, 1, 3), cacheItem(0x02, 16, null));
+				writer.Add(TS_TERRAIN, new CanonicalTileId(2, 1, 0), cacheItem(0x03, 16, null));
+			}
+
+			using (TilePack pack = new TilePack(_path))
+			{
+				Assert.AreEqual(2, MBTiles.Export(pack, TS_VECTOR, _mbtilesPath), "tiles of another tileset were exported");
+			}
+
+			string imported = Path.Combine(Path.GetTempPath(), "UNITTEST_IMPORTED" + TilePackCache.FILE_EXTENSION);
+			try
+			{
+				using (TilePackWriter writer = new TilePackWriter(imported))
+				{
+					Assert.AreEqual(2, MBTiles.Import(_mbtilesPath, TS_VECTOR, writer));
+				}
+				using (TilePack pack = new TilePack(imported))
+				{
+					// rows are flipped on export and back on import
+					Assert.AreEqual(0x01, pack.Get(TS_VECTOR, new CanonicalTileId(2, 1, 0)).Data[0]);
+					Assert.AreEqual(0x02, pack.Get(TS_VECTOR, new CanonicalTileId(2, 1, 3)).Data[0]);
+					Assert.AreEqual(2, pack.Count);
+				}
+			}
+			finally
+			{
+				File.Delete(imported);
+			}
+		}
+
+
+		/// <summary>
+		/// Cold start: open the store and read every tile once, as after an app launch with a prebuilt region.
+		/// </summary>
+		[Test]
+		public void ColdStartVsSQLiteCache()
+		{
+			const int tileCount = 1000;
+			CacheItem item = cacheItem(0x58, 20 * 1024, "etag");
+			List<CanonicalTileId> tiles = new List<CanonicalTileId>();
+			for (int i = 0; i < tileCount; i++)
+			{
+				tiles.Add(new CanonicalTileId(16, 36000 + i % 40, 22000 + i / 40));
+			}
+
+			string baselinePath = SQLiteCache.GetFullDbPath(_dbNameBaseline);
+			if (File.Exists(baselinePath)) { File.Delete(baselinePath); }
+			using (SQLiteCache baseline = new SQLiteCache(6000, _dbNameBaseline))
+			{
+				foreach (CanonicalTileId tileId in tiles) { baseline.Add(TS_VECTOR, tileId, item, true); }
+			}
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				foreach (CanonicalTileId tileId in tiles) { writer.Add(TS_VECTOR, tileId, item); }
+			}
+
+			Stopwatch sw = Stopwatch.StartNew();
+			using (SQLiteCache baseline = new SQLiteCache(6000, _dbNameBaseline))
+			{
+				long openTicks = sw.ElapsedTicks;
+				int hits = readAll(baseline, tiles);
+				sw.Stop();
+				logRun("SQLiteCache", openTicks, sw.ElapsedTicks, hits);
+				Assert.AreEqual(tileCount, hits);
+				baseline.Clear();
+			}
+
+			sw = Stopwatch.StartNew();
+			using (TilePackCache packs = new TilePackCache())
+			{
+				packs.Open(_path);
+				long openTicks = sw.ElapsedTicks;
+				int hits = readAll(packs, tiles);
+				sw.Stop();
+				logRun("TilePackCache", openTicks, sw.ElapsedTicks, hits);
+				Assert.AreEqual(tileCount, hits);
+			}
+		}
+
+
+		#region helper methods
+
+
+		private CacheItem cacheItem(byte fill, int length, string etag)
+		{
+			byte[] data = new byte[length];
+			for (int i = 0; i < length; i++) { data[i] = fill; }
+			return new CacheItem()
+			{
+				Data = data,
+				ETag = etag,
+				LastModified = new DateTime(2019, 10, 15, 0, 0, 0, DateTimeKind.Utc)
+			};
+		}
+
+
+		private void deleteFiles()
+		{
+			if (File.Exists(_path)) { File.Delete(_path); }
+			if (File.Exists(_path + ".tmp")) { File.Delete(_path + ".tmp"); }
+			if (File.Exists(_mbtilesPath)) { File.Delete(_mbtilesPath); }
+		}
+
+
+		private int readAll(ICache cache, List<CanonicalTileId> tiles)
+		{
+			int hits = 0;
+			foreach (CanonicalTileId tileId in tiles)
+			{
+				if (null != cache.Get(TS_VECTOR, tileId)) { hits++; }
+			}
+			return hits;
+		}
+
+
+		private void logRun(string label, long openTicks, long totalTicks, int hits)
+		{
+			ued.Log(string.Format(
+				CultureInfo.InvariantCulture
+				, "[{0}] opened in {1:0.000}ms, {2} tiles read in {3:0.000}ms ({4:0} tiles/s)"
+				, label
+				, openTicks * 1000.0 / Stopwatch.Frequency
+				, hits
+				, (totalTicks - openTicks) * 1000.0 / Stopwatch.Frequency
+				, hits / Math.Max((totalTicks - openTicks) / (double)Stopwatch.Frequency, 0.000001)
+			));
+		}
+
+
+		#endregion
+
+
+	}
+}
@@ -0,0 +1,221 @@
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.Map;
+	using Mapbox.Platform;
+	using Mapbox.Platform.Cache;
+	using Mapbox.Unity.Utilities;
+	using NUnit.Framework;
+	using System;
+	using System.Collections.Generic;
+
+
+	[TestFixture]
+	internal class TileRequestSchedulerTest
+	{
+
+
+		private const string TS_VECTOR = "mapbox.mapbox-streets-v7";
+
+
+		private class FakeRequest : IAsyncRequest
+		{
+			public string Url;
+			public Action<Response> Callback;
+			public bool Canceled;
+
+			public bool IsCompleted { get; private set; }
+
+			public HttpRequestType RequestType { get { return HttpRequestType.Get; } }
+
+			public void Cancel()
+			{
+				Canceled = true;
+			}
+
+			public void Complete()
+			{
+				IsCompleted = true;
+				Callback(Response.FromCache(new byte[] { 1 }));
+			}
+		}
+
+
+		private List<FakeRequest> _started;
+		private TileRequestScheduler _scheduler;
+
+
+		[SetUp]
+		public void SetUp()
+		{
+			_started = new List<FakeRequest>();
+			_scheduler = new TileRequestScheduler(2, (url, tilesetId, tileId, timeout, callback) =>
+			{
+				FakeRequest request = new FakeRequest() { Url = url, Callback = callback };
+				_started.Add(request);
+				return request;
+			});
+		}
+
+
+		[Test]
+		public void CoalescesDuplicateRequests()
+		{
+			int vectorCallbacks = 0;
+			int terrainCallbacks = 0;
+			CanonicalTileId tileId = new CanonicalTileId(10, 5, 5);
+
+			IAsyncRequest first = _scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, (Response r) => vectorCallbacks++);
+			IAsyncRequest second = _scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, (Response r) => terrainCallbacks++);
+
+			Assert.AreEqual(1, _started.Count, "duplicate request was not coalesced");
+			Assert.AreEqual(1, _scheduler.Coalesced);
+
+			_started[0].Complete();
+
+			Assert.AreEqual(1, vectorCallbacks);
+			Assert.AreEqual(1, terrainCallbacks);
+			Assert.IsTrue(first.IsCompleted);
+			Assert.IsTrue(second.IsCompleted);
+			Assert.AreEqual(0, _scheduler.InFlight);
+
+			// finished fetches are not reused
+			_scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, null);
+			Assert.AreEqual(2, _started.Count);
+		}
+
+
+		[Test]
+		public void BoundedConcurrency()
+		{
+			for (int x = 0; x < 5; x++)
+			{
+				CanonicalTileId tileId = new CanonicalTileId(10, x, 0);
+				_scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, null);
+			}
+
+			Assert.AreEqual(2, _started.Count);
+			Assert.AreEqual(2, _scheduler.InFlight);
+			Assert.AreEqual(3, _scheduler.Queued);
+
+			_started[0].Complete();
+
+			Assert.AreEqual(3, _started.Count, "completion did not start the next queued fetch");
+			Assert.AreEqual(2, _scheduler.InFlight);
+			Assert.AreEqual(2, _scheduler.Queued);
+		}
+
+
+		[Test]
+		public void NearestTilesFirst()
+		{
+			// occupy both slots
+			for (int x = 100; x < 102; x++)
+			{
+				CanonicalTileId tileId = new CanonicalTileId(10, x, 100);
+				_scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, null);
+			}
+
+			CanonicalTileId far = new CanonicalTileId(10, 20, 20);
+			CanonicalTileId near = new CanonicalTileId(10, 51, 50);
+			_scheduler.Request(url(far), TS_VECTOR, far, 10, null);
+			_scheduler.Request(url(near), TS_VECTOR, near, 10, null);
+
+			// viewer moves, queued fetches are reprioritized
+			_scheduler.SetFocus(new CanonicalTileId(10, 50, 50));
+			Assert.AreEqual(0, _scheduler.GetPriority(near));
+			Assert.AreEqual(TileRequestScheduler.PRIORITY_LEVELS - 1, _scheduler.GetPriority(far));
+
+			_started[0].Complete();
+			Assert.AreEqual(url(near), _started[2].Url, "tile closest to the focus was not served first");
+
+			// lower zoom tiles containing the focus are close as well
+			Assert.AreEqual(0, _scheduler.GetPriority(new CanonicalTileId(8, 12, 12)));
+		}
+
+
+		[Test]
+		public void CancelOnlyDetachesRequester()
+		{
+			int callbacks = 0;
+			CanonicalTileId tileId = new CanonicalTileId(10, 5, 5);
+
+			IAsyncRequest first = _scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, (Response r) => callbacks++);
+			IAsyncRequest second = _scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, (Response r) => callbacks += 10);
+
+			first.Cancel();
+			Assert.IsFalse(_started[0].Canceled, "fetch was aborted although a requester is still waiting");
+
+			second.Cancel();
+			Assert.IsTrue(_started[0].Canceled, "fetch was not aborted after all requesters canceled");
+			Assert.AreEqual(0, _scheduler.InFlight);
+
+			// late response of the aborted fetch
+			_started[0].Complete();
+			Assert.AreEqual(0, callbacks);
+		}
+
+
+		[Test]
+		public void CanceledTilesLeaveQueue()
+		{
+			for (int x = 0; x < 2; x++)
+			{
+				CanonicalTileId tileId = new CanonicalTileId(10, x, 0);
+				_scheduler.Request(url(tileId), TS_VECTOR, tileId, 10, null);
+			}
+
+			CanonicalTileId leftView = new CanonicalTileId(10, 9, 9);
+			IAsyncRequest queued = _scheduler.Request(url(leftView), TS_VECTOR, leftView, 10, null);
+			Assert.AreEqual(1, _scheduler.Queued);
+
+			queued.Cancel();
+			Assert.AreEqual(0, _scheduler.Queued);
+
+			_started[0].Complete();
+			_started[1].Complete();
+			Assert.AreEqual(2, _started.Count, "canceled tile was fetched");
+
+			TileRequestStats[] stats = _scheduler.GetStats();
+			Assert.AreEqual(TileRequestScheduler.PRIORITY_LEVELS, stats.Length);
+			Assert.AreEqual(2, stats[0].Dispatched);
+			Assert.AreEqual(1, stats[0].Canceled);
+			Assert.AreEqual(0, stats[0].QueueDepth);
+			Assert.GreaterOrEqual(stats[0].AverageFetchMilliseconds, 0);
+		}
+
+
+		[Test]
+		public void PrefetchesRunLastOnOneConnection()
+		{
+			CanonicalTileId prefetchA = new CanonicalTileId(10, 60, 60);
+			CanonicalTileId prefetchB = new CanonicalTileId(10, 61, 60);
+			CanonicalTileId shown = new CanonicalTileId(10, 20, 20);
+			_scheduler.Request(url(prefetchA), TS_VECTOR, prefetchA, 10, null, true);
+			_scheduler.Request(url(prefetchB), TS_VECTOR, prefetchB, 10, null, true);
+
+			Assert.AreEqual(1, _started.Count, "more than one prefetch running");
+			Assert.AreEqual(1, _scheduler.Queued);
+
+			// a regular request takes the free slot although the prefetch was queued first
+			_scheduler.Request(url(shown), TS_VECTOR, shown, 10, null);
+			Assert.AreEqual(url(shown), _started[1].Url);
+
+			// the map asks for the queued prefetch, it is promoted
+			_scheduler.SetFocus(new CanonicalTileId(10, 0, 0));
+			_scheduler.Request(url(prefetchB), TS_VECTOR, prefetchB, 10, null);
+			Assert.AreEqual(0, _scheduler.GetPrefetchStats().QueueDepth);
+			_started[1].Complete();
+			Assert.AreEqual(url(prefetchB), _started[2].Url, "promoted prefetch was not started");
+
+			Assert.AreEqual(1, _scheduler.GetPrefetchStats().Dispatched);
+		}
+
+
+		private string url(CanonicalTileId tileId)
+		{
+			return "https://api.mapbox.com/v4/" + TS_VECTOR + "/" + tileId + ".vector.pbf";
+		}
+
+
+	}
+}
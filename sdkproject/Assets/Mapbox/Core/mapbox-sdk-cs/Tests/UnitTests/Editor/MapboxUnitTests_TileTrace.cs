@@ -0,0 +1,256 @@
+namespace Mapbox.MapboxSdkCs.UnitTest
+{
+	using Mapbox.Json.Linq;
+	using Mapbox.Map;
+	using Mapbox.Platform;
+	using Mapbox.Platform.Cache;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.IO;
+	using System.Threading;
+
+
+	[TestFixture]
+	internal class TileTraceTest
+	{
+
+
+		private const string TS_VECTOR = "mapbox.mapbox-streets-v7";
+		private static readonly CanonicalTileId _tileId = new CanonicalTileId(14, 9326, 4739);
+		private List<TileTraceSpan> _spans;
+		private string _path;
+
+
+		[SetUp]
+		public void SetUp()
+		{
+			_spans = new List<TileTraceSpan>();
+			_path = Path.Combine(Path.GetTempPath(), "UNITTEST_TILETRACE" + TilePackCache.FILE_EXTENSION);
+			TileTrace.Clear();
+			TileTrace.Enabled = true;
+		}
+
+
+		[TearDown]
+		public void TearDown()
+		{
+			TileTrace.Enabled = false;
+			TileTrace.TrackAllocations = false;
+			TileTrace.Capacity = TileTrace.DEFAULT_CAPACITY;
+			TileTrace.Clear();
+			if (File.Exists(_path)) { File.Delete(_path); }
+		}
+
+
+		[Test]
+		public void DisabledRecordsNothing()
+		{
+			TileTrace.Enabled = false;
+			TileTrace.Begin(TileTraceStage.Parse, _tileId).End();
+			TileTrace.BeginPending(TileTraceStage.Modifiers).End();
+			TileTrace.FlushPending(_tileId);
+			TileTrace.Record(TileTraceStage.Fetch, _tileId, 0, 10);
+
+			Assert.AreEqual(0, TileTrace.Collect(_spans));
+		}
+
+
+		[Test]
+		public void SpansCarryTileAndStage()
+		{
+			TileTraceTimer timer = TileTrace.Begin(TileTraceStage.Parse, _tileId);
+			Thread.Sleep(2);
+			timer.End();
+			// ending twice records once
+			timer.End();
+
+			Assert.AreEqual(1, TileTrace.Collect(_spans));
+			Assert.AreEqual(_tileId, _spans[0].TileId);
+			Assert.AreEqual(TileTraceStage.Parse, _spans[0].Stage);
+			Assert.AreEqual(Thread.CurrentThread.ManagedThreadId, _spans[0].ThreadId);
+			Assert.AreEqual(-1, _spans[0].Allocated, "allocations weren't tracked");
+			Assert.GreaterOrEqual(_spans[0].Milliseconds, 1.0);
+
+			// collected spans aren't returned again
+			Assert.AreEqual(0, TileTrace.Collect(_spans));
+		}
+
+
+		[Test]
+		public void PendingTimingsAreSummedPerTile()
+		{
+			for (int i = 0; i < 5; i++)
+			{
+				TileTrace.BeginPending(TileTraceStage.Modifiers).End();
+			}
+			TileTrace.BeginPending(TileTraceStage.Triangulate).End();
+			TileTrace.FlushPending(_tileId);
+			// nothing left to flush for the next tile
+			TileTrace.FlushPending(new CanonicalTileId(14, 9327, 4739));
+
+			Assert.AreEqual(2, TileTrace.Collect(_spans));
+			foreach (TileTraceSpan span in _spans)
+			{
+				Assert.AreEqual(_tileId, span.TileId);
+				Assert.AreEqual(span.Stage == TileTraceStage.Modifiers ? 5 : 1, span.Count);
+			}
+		}
+
+
+		[Test]
+		public void FullRingDropsOldest()
+		{
+			// applies to threads that didn't record yet
+			TileTrace.Capacity = 16;
+			Thread writer = new Thread(() =>
+			{
+				for (int i = 0; i < 40; i++)
+				{
+					TileTrace.Record(TileTraceStage.Fetch, _tileId, i, i + 1);
+				}
+			});
+			writer.Start();
+			writer.Join();
+
+			Assert.AreEqual(16, TileTrace.Collect(_spans));
+			Assert.AreEqual(24, TileTrace.Dropped);
+			for (int i = 0; i < 16; i++)
+			{
+				Assert.AreEqual(24 + i, _spans[i].Start, "spans out of order");
+			}
+		}
+
+
+		[Test]
+		public void CollectsWhileThreadsRecord()
+		{
+			const int threads = 4;
+			const int spansPerThread = 20000;
+			List<Thread> writers = new List<Thread>();
+			for (int t = 0; t < threads; t++)
+			{
+				Thread writer = new Thread(() =>
+				{
+					for (int i = 0; i < spansPerThread; i++)
+					{
+						TileTrace.Record(TileTraceStage.Decode, _tileId, i, i + 1);
+					}
+				});
+				writers.Add(writer);
+				writer.Start();
+			}
+
+			while (writers.Exists(w => w.IsAlive))
+			{
+				TileTrace.Collect(_spans);
+			}
+			TileTrace.Collect(_spans);
+
+			Assert.AreEqual(threads * spansPerThread, _spans.Count + TileTrace.Dropped, "spans lost without being counted");
+			Dictionary<int, long> last = new Dictionary<int, long>();
+			foreach (TileTraceSpan span in _spans)
+			{
+				long previous;
+				if (last.TryGetValue(span.ThreadId, out previous))
+				{
+					Assert.Greater(span.Start, previous, "torn or reordered span");
+				}
+				Assert.AreEqual(1, span.Duration, "torn span");
+				last[span.ThreadId] = span.Start;
+			}
+		}
+
+
+		[Test]
+		public void ChromeTraceParses()
+		{
+			TileTrace.Begin(TileTraceStage.Parse, _tileId).End();
+			TileTrace.BeginPending(TileTraceStage.Modifiers).End();
+			TileTrace.FlushPending(_tileId);
+			TileTrace.Collect(_spans);
+
+			StringWriter writer = new StringWriter();
+			TileTrace.WriteChromeTrace(writer, _spans);
+			JToken trace = JToken.Parse(writer.ToString());
+
+			JArray events = (JArray)trace["traceEvents"];
+			int complete = 0;
+			foreach (JToken e in events)
+			{
+				if ("X" != (string)e["ph"]) { continue; }
+				complete++;
+				Assert.AreEqual(_tileId.ToString(), (string)e["args"]["tile"]);
+				Assert.GreaterOrEqual((double)e["ts"], 0);
+			}
+			Assert.AreEqual(2, complete);
+			Assert.IsTrue(events[0]["ph"].ToString() == "M", "thread names come first");
+		}
+
+
+		[Test]
+		public void ReportPercentiles()
+		{
+			long msTicks = Stopwatch.Frequency / 1000;
+			for (int i = 1; i <= 100; i++)
+			{
+				TileTrace.Record(TileTraceStage.Decode, new CanonicalTileId(14, i, 0), 0, i * msTicks);
+			}
+			TileTrace.Record(TileTraceStage.Upload, _tileId, 0, msTicks);
+			TileTrace.Collect(_spans);
+
+			TileTraceReport report = new TileTraceReport(_spans);
+			Assert.AreEqual(2, report.Stages.Count);
+			Assert.AreEqual(TileTraceStage.Decode, report.Stages[0].Stage, "stages not in pipeline order");
+			TileTraceStageStats decode = report[TileTraceStage.Decode];
+			Assert.AreEqual(100, decode.Spans);
+			Assert.AreEqual(100, decode.Tiles);
+			Assert.AreEqual(50, decode.P50Milliseconds, 0.01);
+			Assert.AreEqual(99, decode.P99Milliseconds, 0.01);
+			Assert.AreEqual(100, decode.MaxMilliseconds, 0.01);
+			Assert.AreEqual(5050, decode.TotalMilliseconds, 0.1);
+			Assert.AreEqual(-1, decode.Allocated);
+			Assert.IsNull(report[TileTraceStage.Fetch]);
+			StringAssert.Contains("Decode", report.ToString());
+		}
+
+
+		[Test]
+		public void OfflineSourceServesPacksOnly()
+		{
+			using (TilePackWriter writer = new TilePackWriter(_path))
+			{
+				writer.Add(TS_VECTOR, _tileId, new CacheItem() { Data = new byte[] { 1, 2, 3 } });
+				writer.Finish();
+			}
+
+			TilePackCache packs = new TilePackCache();
+			packs.Open(_path);
+			using (OfflineFileSource source = new OfflineFileSource().AddCache(packs))
+			{
+				Response hit = null;
+				IAsyncRequest request = source.Request("https://example.com/hit", (r) => hit = r, tileId: _tileId, tilesetId: TS_VECTOR);
+				Assert.IsNotNull(hit, "not answered synchronously");
+				Assert.IsTrue(request.IsCompleted);
+				Assert.IsFalse(hit.HasError);
+				Assert.IsTrue(hit.LoadedFromCache);
+				CollectionAssert.AreEqual(new byte[] { 1, 2, 3 }, hit.Data);
+
+				Response miss = null;
+				source.Request("https://example.com/miss", (r) => miss = r, tileId: new CanonicalTileId(14, 0, 0), tilesetId: TS_VECTOR);
+				Assert.IsNotNull(miss);
+				Assert.IsTrue(miss.HasError);
+
+				Assert.AreEqual(1, source.Hits);
+				Assert.AreEqual(1, source.Misses);
+			}
+
+			TileTrace.Collect(_spans);
+			Assert.AreEqual(2, _spans.FindAll(s => s.Stage == TileTraceStage.Cache).Count, "cache lookups weren't traced");
+		}
+
+
+	}
+}
@@ -7,13 +7,19 @@
 namespace Mapbox.Utils
 {
 
+	using System;
 	using System.IO;
 	using Mapbox.IO.Compression;
+	using Mapbox.Platform;
 
 
 	/// <summary> Collection of constants used across the project. </summary>
 	public static class Compression
 	{
+		/// <summary>Don't trust gzip's size trailer beyond this.</summary>
+		private const int MAX_EXACT_DECOMPRESSED_BYTES = 64 * 1024 * 1024;
+
+
 		/// <summary>
 		///     Decompress the specified buffer previously compressed using GZip.
 		/// </summary>
@@ -27,46 +33,88 @@ namespace Mapbox.Utils
 		public static byte[] Decompress(byte[] buffer)
 		{
 			// Test for magic bits.
-			if (buffer.Length < 2 || buffer[0] != 0x1f || buffer[1] != 0x8b)
+			if (!IsGzip(buffer, 0, buffer.Length))
 			{
 				return buffer;
 			}
 
-			using (GZipStream stream = new GZipStream(new MemoryStream(buffer), CompressionMode.Decompress))
+			try
 			{
-				const int Size = 4096; // Pagesize.
-				byte[] buf = new byte[Size];
+				return Gunzip(buffer, 0, buffer.Length);
+			}
+			catch
+			{
+				// For now we return the uncompressed buffer
+				// on error. Assumes the magic check passed
+				// by luck.
+				return buffer;
+			}
+		}
 
-				using (MemoryStream memory = new MemoryStream())
-				{
-					int count = 0;
 
-					do
+		/// <summary> Check for the gzip magic bytes. </summary>
+		public static bool IsGzip(byte[] buffer, int offset, int count)
+		{
+			return count >= 2 && buffer[offset] == 0x1f && buffer[offset + 1] == 0x8b;
+		}
+
+
+		/// <summary>
+		/// <para>Decompress <paramref name="count"/> gzip bytes into an exactly sized array, throws on corrupt data.</para>
+		/// <para>The size trailer lets single member streams decompress straight into the result, anything else is
+		/// decompressed into pooled memory and copied once.</para>
+		/// </summary>
+		public static byte[] Gunzip(byte[] buffer, int offset, int count)
+		{
+			// ISIZE trailer: uncompressed size modulo 2^32
+			int size = -1;
+			if (count >= 18 && IsGzip(buffer, offset, count))
+			{
+				int end = offset + count;
+				size = buffer[end - 4] | (buffer[end - 3] << 8) | (buffer[end - 2] << 16) | (buffer[end - 1] << 24);
+			}
+
+			if (size > 0 && size <= MAX_EXACT_DECOMPRESSED_BYTES)
+			{
+				byte[] data = new byte[size];
+				using (GZipStream gzip = new GZipStream(new MemoryStream(buffer, offset, count, false), CompressionMode.Decompress))
+				{
+					int filled = 0;
+					int read;
+					while (filled < size && 0 != (read = gzip.Read(data, filled, size - filled)))
 					{
-						try
-						{
-							count = stream.Read(buf, 0, Size);
-						}
-						catch
-						{
-							// For now we return the uncompressed buffer
-							// on error. Assumes the magic check passed
-							// by luck.
-							return buffer;
-						}
-
-						if (count > 0)
-						{
-							memory.Write(buf, 0, count);
-						}
+						filled += read;
 					}
-					while (count > 0);
-
-					buffer = memory.ToArray();
+					// trailer matched: done. Otherwise eg multiple gzip members, start over
+					if (filled == size && 0 == gzip.Read(new byte[1], 0, 1)) { return data; }
 				}
 			}
 
-			return buffer;
+			using (GZipStream gzip = new GZipStream(new MemoryStream(buffer, offset, count, false), CompressionMode.Decompress))
+			using (PooledBuffer data = Inflate(gzip, count * 4))
+			{
+				return data.ToArray();
+			}
+		}
+
+
+		/// <summary>
+		/// Read <paramref name="stream"/>, eg a <see cref="GZipStream"/> or <see cref="DeflateStream"/>, to its end into
+		/// memory rented from <see cref="ByteArrayPool.Shared"/>. The caller owns the returned buffer.
+		/// </summary>
+		public static PooledBuffer Inflate(Stream stream, int sizeHint)
+		{
+			PooledBuffer data = new PooledBuffer(ByteArrayPool.Shared, Math.Max(sizeHint, 4096));
+			try
+			{
+				data.ReadFrom(stream);
+				return data;
+			}
+			catch
+			{
+				data.Release();
+				throw;
+			}
 		}
 
 
@@ -14,6 +14,9 @@ namespace Mapbox.Utils
 
 		public const string EventsAPI = "https://events.mapbox.com/";
 
+		/// <summary> 'User-Agent' header sent by the SDK's own HTTP clients. </summary>
+		public const string UserAgent = "mapbox-sdk-cs";
+
 		/// <summary> Mercator projection max latitude limit. </summary>
 		public const double LatitudeMax = 85.0511;
 
@@ -0,0 +1,231 @@
+//-----------------------------------------------------------------------
+// <copyright file="PngDecoder.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.Utils
+{
+	using System;
+	using System.IO;
+	using Mapbox.IO.Compression;
+
+
+	/// <summary>
+	/// Managed PNG decoder for raster tiles, eg terrain-RGB, that doesn't need a texture or the main thread.
+	/// Supports non-interlaced 8 bit images: greyscale, truecolor, palette, with or without alpha.
+	/// Rows are handed out top to bottom, unfiltered and expanded to RGB or RGBA, instead of decoding into one big buffer.
+	/// Buffers are reused across images, use one instance per thread.
+	/// </summary>
+	public sealed class PngDecoder
+	{
+		/// <summary> Called for each decoded row. </summary>
+		/// <param name="y">Row index, 0 is the top row of the image.</param>
+		/// <param name="pixels">RGB or RGBA bytes of the row, valid until the next call.</param>
+		/// <param name="bytesPerPixel">3 or 4.</param>
+		public delegate void RowHandler(int y, byte[] pixels, int bytesPerPixel);
+
+
+		private static readonly byte[] SIGNATURE = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+		private const int COLOR_GREY = 0;
+		private const int COLOR_RGB = 2;
+		private const int COLOR_PALETTE = 3;
+		private const int COLOR_GREY_ALPHA = 4;
+		private const int COLOR_RGBA = 6;
+
+		private byte[] _idat = new byte[0];
+		private byte[] _palette = new byte[768];
+		private byte[] _previous = new byte[0];
+		private byte[] _current = new byte[0];
+		private byte[] _expanded = new byte[0];
+
+
+		public int Width { get; private set; }
+		public int Height { get; private set; }
+
+
+		/// <summary>
+		/// Decode <paramref name="png"/>, calling <paramref name="onRow"/> for every row.
+		/// </summary>
+		/// <returns>False if the image is valid but uses a format that isn't supported (16 bit, interlaced).</returns>
+		/// <exception cref="FormatException">Not a PNG or truncated.</exception>
+		public bool Decode(byte[] png, RowHandler onRow)
+		{
+			if (null == png || png.Length < SIGNATURE.Length) { throw new FormatException("not a png"); }
+			for (int i = 0; i < SIGNATURE.Length; i++)
+			{
+				if (png[i] != SIGNATURE[i]) { throw new FormatException("not a png"); }
+			}
+
+			int colorType = -1;
+			int idatLength = 0;
+			int pos = SIGNATURE.Length;
+			Width = Height = 0;
+
+			while (pos + 8 <= png.Length)
+			{
+				int length = readInt(png, pos);
+				int type = readInt(png, pos + 4);
+				int data = pos + 8;
+				if (length < 0 || data + length > png.Length) { throw new FormatException("truncated png chunk"); }
+
+				if (type == 0x49484452) // IHDR
+				{
+					Width = readInt(png, data);
+					Height = readInt(png, data + 4);
+					int bitDepth = png[data + 8];
+					colorType = png[data + 9];
+					int interlace = png[data + 12];
+					if (bitDepth != 8 || interlace != 0) { return false; }
+					if (colorType != COLOR_GREY && colorType != COLOR_RGB && colorType != COLOR_PALETTE && colorType != COLOR_GREY_ALPHA && colorType != COLOR_RGBA) { return false; }
+				}
+				else if (type == 0x504C5445) // PLTE
+				{
+					Buffer.BlockCopy(png, data, _palette, 0, Math.Min(length, _palette.Length));
+				}
+				else if (type == 0x49444154) // IDAT
+				{
+					if (idatLength + length > _idat.Length)
+					{
+						Array.Resize(ref _idat, Math.Max(idatLength + length, _idat.Length * 2));
+					}
+					Buffer.BlockCopy(png, data, _idat, idatLength, length);
+					idatLength += length;
+				}
+				else if (type == 0x49454E44) // IEND
+				{
+					break;
+				}
+
+				// skip data and crc
+				pos = data + length + 4;
+			}
+
+			if (colorType < 0 || Width <= 0 || Height <= 0 || idatLength < 2) { throw new FormatException("png without header or image data"); }
+
+			int channels = colorType == COLOR_RGB ? 3 : colorType == COLOR_RGBA ? 4 : colorType == COLOR_GREY_ALPHA ? 2 : 1;
+			int stride = Width * channels;
+			int outBpp = colorType == COLOR_RGBA || colorType == COLOR_GREY_ALPHA ? 4 : 3;
+			ensure(ref _previous, stride);
+			ensure(ref _current, stride);
+			if (colorType != COLOR_RGB && colorType != COLOR_RGBA) { ensure(ref _expanded, Width * outBpp); }
+			Array.Clear(_previous, 0, stride);
+
+			// zlib stream: skip the 2 byte header, adler32 at the end is ignored
+			using (DeflateStream inflate = new DeflateStream(new MemoryStream(_idat, 2, idatLength - 2, false), CompressionMode.Decompress))
+			{
+				for (int y = 0; y < Height; y++)
+				{
+					int filter = inflate.ReadByte();
+					if (filter < 0) { throw new FormatException("truncated png image data"); }
+					readFully(inflate, _current, stride);
+					unfilter(filter, _current, _previous, stride, channels);
+
+					byte[] pixels = _current;
+					if (colorType != COLOR_RGB && colorType != COLOR_RGBA)
+					{
+						expand(colorType, _current, _expanded, Width);
+						pixels = _expanded;
+					}
+					onRow(y, pixels, outBpp);
+
+					byte[] swap = _previous;
+					_previous = _current;
+					_current = swap;
+				}
+			}
+
+			return true;
+		}
+
+
+		private static void unfilter(int filter, byte[] row, byte[] previous, int stride, int bpp)
+		{
+			switch (filter)
+			{
+				case 0:
+					break;
+				case 1: // sub
+					for (int i = bpp; i < stride; i++) { row[i] = (byte)(row[i] + row[i - bpp]); }
+					break;
+				case 2: // up
+					for (int i = 0; i < stride; i++) { row[i] = (byte)(row[i] + previous[i]); }
+					break;
+				case 3: // average
+					for (int i = 0; i < bpp; i++) { row[i] = (byte)(row[i] + (previous[i] >> 1)); }
+					for (int i = bpp; i < stride; i++) { row[i] = (byte)(row[i] + ((row[i - bpp] + previous[i]) >> 1)); }
+					break;
+				case 4: // paeth
+					for (int i = 0; i < bpp; i++) { row[i] = (byte)(row[i] + previous[i]); }
+					for (int i = bpp; i < stride; i++)
+					{
+						int a = row[i - bpp];
+						int b = previous[i];
+						int c = previous[i - bpp];
+						int pa = Math.Abs(b - c);
+						int pb = Math.Abs(a - c);
+						int pc = Math.Abs(a + b - c - c);
+						row[i] = (byte)(row[i] + (pa <= pb && pa <= pc ? a : pb <= pc ? b : c));
+					}
+					break;
+				default:
+					throw new FormatException("unknown png filter " + filter);
+			}
+		}
+
+
+		private void expand(int colorType, byte[] row, byte[] output, int width)
+		{
+			switch (colorType)
+			{
+				case COLOR_PALETTE:
+					for (int x = 0, o = 0; x < width; x++, o += 3)
+					{
+						int p = row[x] * 3;
+						output[o] = _palette[p];
+						output[o + 1] = _palette[p + 1];
+						output[o + 2] = _palette[p + 2];
+					}
+					break;
+				case COLOR_GREY:
+					for (int x = 0, o = 0; x < width; x++, o += 3)
+					{
+						output[o] = output[o + 1] = output[o + 2] = row[x];
+					}
+					break;
+				case COLOR_GREY_ALPHA:
+					for (int x = 0, o = 0; x < width; x++, o += 4)
+					{
+						output[o] = output[o + 1] = output[o + 2] = row[x * 2];
+						output[o + 3] = row[x * 2 + 1];
+					}
+					break;
+			}
+		}
+
+
+		private static void readFully(Stream stream, byte[] buffer, int count)
+		{
+			int offset = 0;
+			while (offset < count)
+			{
+				int read = stream.Read(buffer, offset, count - offset);
+				if (read <= 0) { throw new FormatException("truncated png image data"); }
+				offset += read;
+			}
+		}
+
+
+		private static void ensure(ref byte[] buffer, int length)
+		{
+			if (buffer.Length < length) { buffer = new byte[length]; }
+		}
+
+
+		private static int readInt(byte[] buffer, int offset)
+		{
+			return (buffer[offset] << 24) | (buffer[offset + 1] << 16) | (buffer[offset + 2] << 8) | buffer[offset + 3];
+		}
+	}
+}
@@ -0,0 +1,409 @@
+//-----------------------------------------------------------------------
+// <copyright file="TileTrace.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.Utils
+{
+
+	using Mapbox.Map;
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using System.Threading;
+
+
+	/// <summary>Steps a tile goes through from request to mesh.</summary>
+	public enum TileTraceStage
+	{
+		/// <summary>Request until response, from the network or a cache.</summary>
+		Fetch,
+		/// <summary>Looking the tile up in the caches.</summary>
+		Cache,
+		/// <summary>Gunzipping the response.</summary>
+		Decompress,
+		/// <summary>Reading the tile: vector tile header, raster or terrain png.</summary>
+		Parse,
+		/// <summary>Decoding the features of a vector layer or the heights of a terrain tile.</summary>
+		Decode,
+		/// <summary>Layer filters, summed over the features of a layer.</summary>
+		Filter,
+		/// <summary>Polygon triangulation, summed over the features of a layer.</summary>
+		Triangulate,
+		/// <summary>Modifier stacks, summed over the features of a layer.</summary>
+		Modifiers,
+		/// <summary>Copying merged meshes to Unity.</summary>
+		Upload,
+		/// <summary>Building the terrain mesh.</summary>
+		Terrain,
+		/// <summary>Creating the raster texture.</summary>
+		Raster
+	}
+
+
+	/// <summary>One timed step of one tile, see <see cref="TileTrace"/>.</summary>
+	public struct TileTraceSpan
+	{
+		public CanonicalTileId TileId;
+		public TileTraceStage Stage;
+		/// <summary><see cref="Stopwatch.GetTimestamp"/> when the step started.</summary>
+		public long Start;
+		/// <summary>Duration in <see cref="Stopwatch"/> ticks.</summary>
+		public long Duration;
+		public int ThreadId;
+		/// <summary>Bytes allocated while the step ran, -1 unless <see cref="TileTrace.TrackAllocations"/> was set.</summary>
+		public long Allocated;
+		/// <summary>Number of timings summed up in this span, eg features of a layer.</summary>
+		public int Count;
+
+		public double Milliseconds { get { return TileTrace.ToMilliseconds(Duration); } }
+	}
+
+
+	/// <summary>A started span, <see cref="End"/> records it. Does nothing if tracing was disabled when it started.</summary>
+	public struct TileTraceTimer
+	{
+		internal bool Active;
+		internal bool Pending;
+		internal TileTraceStage Stage;
+		internal CanonicalTileId TileId;
+		internal long Start;
+		internal long StartMemory;
+
+		public void End()
+		{
+			if (Active)
+			{
+				TileTrace.End(ref this);
+			}
+		}
+	}
+
+
+	/// <summary>
+	/// <para>Low overhead timing of the tile pipeline, off unless <see cref="Enabled"/> is set.</para>
+	/// <para>Each thread writes spans into its own ring buffer without locking, <see cref="Collect"/> copies them out from
+	/// any thread. When a ring is full the oldest spans are overwritten and counted in <see cref="Dropped"/>.
+	/// Per feature steps are summed up per thread with <see cref="BeginPending"/> and recorded as one span per tile with
+	/// <see cref="FlushPending"/>. Allocations are read from the process wide heap size, spans of steps running on
+	/// several threads at once include each other's allocations.</para>
+	/// </summary>
+	public static class TileTrace
+	{
+
+
+		/// <summary>Default number of spans each thread keeps until they are collected, a power of two.</summary>
+		public const int DEFAULT_CAPACITY = 8192;
+
+		private static readonly int STAGE_COUNT = Enum.GetValues(typeof(TileTraceStage)).Length;
+
+		private sealed class Ring
+		{
+			public readonly TileTraceSpan[] Spans;
+			public readonly Thread Owner;
+			public readonly int ThreadId;
+			public readonly string ThreadName;
+			// written by the owning thread only, read with a barrier by collectors
+			public long Written;
+			// advanced by collectors under _lock
+			public long Read;
+
+			public Ring(int capacity)
+			{
+				Spans = new TileTraceSpan[capacity];
+				Owner = Thread.CurrentThread;
+				ThreadId = Thread.CurrentThread.ManagedThreadId;
+				ThreadName = Thread.CurrentThread.Name;
+			}
+		}
+
+		private sealed class PendingTotals
+		{
+			public readonly long[] Ticks = new long[STAGE_COUNT];
+			public readonly long[] Allocated = new long[STAGE_COUNT];
+			public readonly int[] Counts = new int[STAGE_COUNT];
+		}
+
+		[ThreadStatic]
+		private static Ring _ring;
+		[ThreadStatic]
+		private static PendingTotals _pending;
+
+		private static readonly object _lock = new object();
+		private static readonly List<Ring> _rings = new List<Ring>();
+		private static int _capacity = DEFAULT_CAPACITY;
+		private static long _dropped;
+
+
+		/// <summary>Record spans. Checked when a span starts, timers started before tracing was disabled still record.</summary>
+		public static bool Enabled;
+
+
+		/// <summary>Record the heap growth of each span, reads the heap size twice per span.</summary>
+		public static bool TrackAllocations;
+
+
+		/// <summary>Spans each thread keeps until they are collected, applies to threads that didn't record yet.</summary>
+		public static int Capacity
+		{
+			get { return _capacity; }
+			set
+			{
+				if (value <= 0 || (value & (value - 1)) != 0) { throw new ArgumentOutOfRangeException("value", "must be a power of two"); }
+				_capacity = value;
+			}
+		}
+
+
+		/// <summary>Spans overwritten before they were collected.</summary>
+		public static long Dropped { get { lock (_lock) { return _dropped; } } }
+
+
+		public static TileTraceTimer Begin(TileTraceStage stage, CanonicalTileId tileId)
+		{
+			TileTraceTimer timer = new TileTraceTimer();
+			if (!Enabled) { return timer; }
+
+			timer.Active = true;
+			timer.Stage = stage;
+			timer.TileId = tileId;
+			timer.StartMemory = TrackAllocations ? GC.GetTotalMemory(false) : 0;
+			timer.Start = Stopwatch.GetTimestamp();
+			return timer;
+		}
+
+
+		/// <summary>
+		/// Time a step of a feature whose tile isn't known here, eg in a modifier. The time is added to the totals of the
+		/// calling thread until <see cref="FlushPending"/> records them for a tile.
+		/// </summary>
+		public static TileTraceTimer BeginPending(TileTraceStage stage)
+		{
+			TileTraceTimer timer = Begin(stage, new CanonicalTileId());
+			timer.Pending = timer.Active;
+			return timer;
+		}
+
+
+		/// <summary>Record the totals summed up on this thread since the last flush as spans of <paramref name="tileId"/>.</summary>
+		public static void FlushPending(CanonicalTileId tileId)
+		{
+			PendingTotals pending = _pending;
+			if (null == pending) { return; }
+
+			long now = Stopwatch.GetTimestamp();
+			for (int i = 0; i < STAGE_COUNT; i++)
+			{
+				if (0 == pending.Counts[i]) { continue; }
+
+				TileTraceSpan span = new TileTraceSpan();
+				span.TileId = tileId;
+				span.Stage = (TileTraceStage)i;
+				span.Start = now - pending.Ticks[i];
+				span.Duration = pending.Ticks[i];
+				span.Allocated = TrackAllocations ? pending.Allocated[i] : -1;
+				span.Count = pending.Counts[i];
+				write(span);
+
+				pending.Ticks[i] = 0;
+				pending.Allocated[i] = 0;
+				pending.Counts[i] = 0;
+			}
+		}
+
+
+		/// <summary>Record a span timed elsewhere, eg a request started on another thread.</summary>
+		public static void Record(TileTraceStage stage, CanonicalTileId tileId, long start, long end)
+		{
+			if (!Enabled) { return; }
+
+			TileTraceSpan span = new TileTraceSpan();
+			span.TileId = tileId;
+			span.Stage = stage;
+			span.Start = start;
+			span.Duration = end - start;
+			span.Allocated = -1;
+			span.Count = 1;
+			write(span);
+		}
+
+
+		internal static void End(ref TileTraceTimer timer)
+		{
+			long end = Stopwatch.GetTimestamp();
+			long allocated = -1;
+			if (TrackAllocations)
+			{
+				// a collection during the span shrinks the heap, count nothing rather than a negative amount
+				allocated = Math.Max(0, GC.GetTotalMemory(false) - timer.StartMemory);
+			}
+			timer.Active = false;
+
+			if (timer.Pending)
+			{
+				PendingTotals pending = _pending;
+				if (null == pending) { _pending = pending = new PendingTotals(); }
+				int stage = (int)timer.Stage;
+				pending.Ticks[stage] += end - timer.Start;
+				pending.Allocated[stage] += Math.Max(0, allocated);
+				pending.Counts[stage]++;
+				return;
+			}
+
+			TileTraceSpan span = new TileTraceSpan();
+			span.TileId = timer.TileId;
+			span.Stage = timer.Stage;
+			span.Start = timer.Start;
+			span.Duration = end - timer.Start;
+			span.Allocated = allocated;
+			span.Count = 1;
+			write(span);
+		}
+
+
+		/// <summary>Append the spans recorded since the last call to <paramref name="spans"/>, oldest first per thread.</summary>
+		/// <returns>Number of spans added.</returns>
+		public static int Collect(List<TileTraceSpan> spans)
+		{
+			int added = 0;
+			lock (_lock)
+			{
+				for (int r = _rings.Count - 1; r >= 0; r--)
+				{
+					Ring ring = _rings[r];
+					bool finished = !ring.Owner.IsAlive;
+					int capacity = ring.Spans.Length;
+					long written = Thread.VolatileRead(ref ring.Written);
+					long from = Math.Max(ring.Read, written - capacity);
+					_dropped += from - ring.Read;
+
+					int first = spans.Count;
+					for (long i = from; i < written; i++)
+					{
+						spans.Add(ring.Spans[i & (capacity - 1)]);
+					}
+
+					// slots the writer reached again while we were copying may be torn, so may the one a live writer is
+					// writing now
+					long overwritten = Math.Min(Thread.VolatileRead(ref ring.Written) - capacity + (finished ? 0 : 1), written);
+					if (overwritten > from)
+					{
+						spans.RemoveRange(first, (int)(overwritten - from));
+						_dropped += overwritten - from;
+					}
+
+					added += spans.Count - first;
+					ring.Read = written;
+					// rings of finished threads can't get new spans
+					if (finished) { _rings.RemoveAt(r); }
+				}
+			}
+			return added;
+		}
+
+
+		/// <summary>Throw away everything recorded so far and reset <see cref="Dropped"/>.</summary>
+		public static void Clear()
+		{
+			lock (_lock)
+			{
+				foreach (Ring ring in _rings)
+				{
+					ring.Read = Thread.VolatileRead(ref ring.Written);
+				}
+				_dropped = 0;
+			}
+		}
+
+
+		public static double ToMilliseconds(long ticks)
+		{
+			return ticks * 1000.0 / Stopwatch.Frequency;
+		}
+
+
+		/// <summary>
+		/// Write <paramref name="spans"/> in the Chrome trace event format, to be opened in chrome://tracing or Perfetto.
+		/// Threads are rows, spans of summed up steps end at the time they were flushed.
+		/// </summary>
+		public static void WriteChromeTrace(TextWriter writer, IList<TileTraceSpan> spans)
+		{
+			long origin = long.MaxValue;
+			Dictionary<int, string> threads = new Dictionary<int, string>();
+			foreach (TileTraceSpan span in spans)
+			{
+				origin = Math.Min(origin, span.Start);
+				threads[span.ThreadId] = null;
+			}
+			lock (_lock)
+			{
+				foreach (Ring ring in _rings)
+				{
+					if (threads.ContainsKey(ring.ThreadId)) { threads[ring.ThreadId] = ring.ThreadName; }
+				}
+			}
+
+			CultureInfo invariant = CultureInfo.InvariantCulture;
+			double microsecondsPerTick = 1000000.0 / Stopwatch.Frequency;
+			writer.Write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+			bool first = true;
+			foreach (KeyValuePair<int, string> thread in threads)
+			{
+				if (!first) { writer.Write(','); }
+				first = false;
+				writer.Write(string.Format(
+					invariant
+					, "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{0},\"args\":{{\"name\":\"{1}\"}}}}"
+					, thread.Key
+					, escape(string.IsNullOrEmpty(thread.Value) ? "thread " + thread.Key : thread.Value)
+				));
+			}
+			foreach (TileTraceSpan span in spans)
+			{
+				if (!first) { writer.Write(','); }
+				first = false;
+				writer.Write(string.Format(
+					invariant
+					, "{{\"name\":\"{0}\",\"cat\":\"tile\",\"ph\":\"X\",\"pid\":1,\"tid\":{1},\"ts\":{2:0.###},\"dur\":{3:0.###},\"args\":{{\"tile\":\"{4}\",\"count\":{5},\"allocated\":{6}}}}}"
+					, span.Stage
+					, span.ThreadId
+					, (span.Start - origin) * microsecondsPerTick
+					, span.Duration * microsecondsPerTick
+					, span.TileId
+					, span.Count
+					, span.Allocated
+				));
+			}
+			writer.Write("]}");
+		}
+
+
+		private static void write(TileTraceSpan span)
+		{
+			Ring ring = _ring;
+			if (null == ring)
+			{
+				ring = new Ring(_capacity);
+				lock (_lock) { _rings.Add(ring); }
+				_ring = ring;
+			}
+
+			span.ThreadId = ring.ThreadId;
+			long written = ring.Written;
+			ring.Spans[written & (ring.Spans.Length - 1)] = span;
+			// publish the slot before the count
+			Thread.VolatileWrite(ref ring.Written, written + 1);
+		}
+
+
+		private static string escape(string value)
+		{
+			return value.Replace("\\", "\\\\").Replace("\"", "\\\"");
+		}
+
+
+	}
+}
@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------
+// <copyright file="TileTraceReport.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+namespace Mapbox.Utils
+{
+
+	using Mapbox.Map;
+	using System;
+	using System.Collections.Generic;
+	using System.Globalization;
+	using System.Text;
+
+
+	/// <summary>Timings of one <see cref="TileTraceStage"/> over all traced tiles.</summary>
+	public class TileTraceStageStats
+	{
+		public TileTraceStage Stage;
+		/// <summary>Number of spans.</summary>
+		public int Spans;
+		/// <summary>Number of timings summed up in the spans, eg features.</summary>
+		public int Count;
+		/// <summary>Distinct tiles with at least one span.</summary>
+		public int Tiles;
+		public double TotalMilliseconds;
+		public double P50Milliseconds;
+		public double P99Milliseconds;
+		public double MaxMilliseconds;
+		/// <summary>Bytes allocated over all spans, -1 if allocations weren't tracked.</summary>
+		public long Allocated;
+	}
+
+
+	/// <summary>
+	/// Per stage percentiles of spans collected with <see cref="TileTrace.Collect"/>. Percentiles are over spans, ie per
+	/// tile for stages recorded once per tile and per layer of a tile for the summed up ones.
+	/// </summary>
+	public class TileTraceReport
+	{
+
+
+		private readonly List<TileTraceStageStats> _stages = new List<TileTraceStageStats>();
+
+
+		public TileTraceReport(IList<TileTraceSpan> spans)
+		{
+			Dictionary<TileTraceStage, List<TileTraceSpan>> byStage = new Dictionary<TileTraceStage, List<TileTraceSpan>>();
+			foreach (TileTraceSpan span in spans)
+			{
+				List<TileTraceSpan> stageSpans;
+				if (!byStage.TryGetValue(span.Stage, out stageSpans))
+				{
+					stageSpans = new List<TileTraceSpan>();
+					byStage.Add(span.Stage, stageSpans);
+				}
+				stageSpans.Add(span);
+			}
+
+			foreach (TileTraceStage stage in Enum.GetValues(typeof(TileTraceStage)))
+			{
+				List<TileTraceSpan> stageSpans;
+				if (!byStage.TryGetValue(stage, out stageSpans)) { continue; }
+				_stages.Add(summarize(stage, stageSpans));
+			}
+		}
+
+
+		/// <summary>Stages that have spans, in pipeline order.</summary>
+		public IList<TileTraceStageStats> Stages { get { return _stages.AsReadOnly(); } }
+
+
+		/// <summary>Stats of <paramref name="stage"/>, null if it has no spans.</summary>
+		public TileTraceStageStats this[TileTraceStage stage]
+		{
+			get
+			{
+				foreach (TileTraceStageStats stats in _stages)
+				{
+					if (stats.Stage == stage) { return stats; }
+				}
+				return null;
+			}
+		}
+
+
+		/// <summary>Nearest rank percentile of values sorted ascending.</summary>
+		public static double Percentile(IList<double> sorted, double percentile)
+		{
+			if (0 == sorted.Count) { return 0; }
+			int rank = (int)Math.Ceiling(percentile / 100.0 * sorted.Count);
+			return sorted[Math.Min(sorted.Count - 1, Math.Max(0, rank - 1))];
+		}
+
+
+		public override string ToString()
+		{
+			CultureInfo invariant = CultureInfo.InvariantCulture;
+			StringBuilder sb = new StringBuilder();
+			sb.AppendLine(string.Format(invariant, "{0,-12}{1,8}{2,8}{3,10}{4,10}{5,10}{6,12}{7,12}", "stage", "spans", "tiles", "p50 ms", "p99 ms", "max ms", "total ms", "alloc KB"));
+			foreach (TileTraceStageStats stats in _stages)
+			{
+				sb.AppendLine(string.Format(
+					invariant
+					, "{0,-12}{1,8}{2,8}{3,10:0.000}{4,10:0.000}{5,10:0.000}{6,12:0.0}{7,12}"
+					, stats.Stage
+					, stats.Spans
+					, stats.Tiles
+					, stats.P50Milliseconds
+					, stats.P99Milliseconds
+					, stats.MaxMilliseconds
+					, stats.TotalMilliseconds
+					, stats.Allocated < 0 ? "-" : (stats.Allocated / 1024.0).ToString("0.0", invariant)
+				));
+			}
+			return sb.ToString();
+		}
+
+
+		private static TileTraceStageStats summarize(TileTraceStage stage, List<TileTraceSpan> spans)
+		{
+			TileTraceStageStats stats = new TileTraceStageStats();
+			stats.Stage = stage;
+			stats.Spans = spans.Count;
+
+			List<double> durations = new List<double>(spans.Count);
+			HashSet<CanonicalTileId> tiles = new HashSet<CanonicalTileId>();
+			bool tracked = false;
+			foreach (TileTraceSpan span in spans)
+			{
+				double ms = span.Milliseconds;
+				durations.Add(ms);
+				stats.TotalMilliseconds += ms;
+				stats.Count += span.Count;
+				tiles.Add(span.TileId);
+				if (span.Allocated >= 0)
+				{
+					tracked = true;
+					stats.Allocated += span.Allocated;
+				}
+			}
+			if (!tracked) { stats.Allocated = -1; }
+
+			durations.Sort();
+			stats.Tiles = tiles.Count;
+			stats.P50Milliseconds = Percentile(durations, 50);
+			stats.P99Milliseconds = Percentile(durations, 99);
+			stats.MaxMilliseconds = durations[durations.Count - 1];
+			return stats;
+		}
+
+
+	}
+}
@@ -3,6 +3,7 @@ namespace Mapbox.ProbeExtractorCs
 {
 
 	using Mapbox.Unity.Location;
+	using System.Collections.Generic;
 
 
 	/// <summary>
@@ -31,6 +32,18 @@ namespace Mapbox.ProbeExtractorCs
 				HDop = location.Accuracy
 			};
 		}
+
+		/// <summary>
+		/// Trace points of <paramref name="locations"/>, converted while they are enumerated,
+		/// eg from <see cref="LocationLogReader.GetLocations(bool)"/> without looping.
+		/// </summary>
+		public static IEnumerable<TracePoint> FromLocations(IEnumerator<Location> locations)
+		{
+			while (locations.MoveNext())
+			{
+				yield return FromLocation(locations.Current);
+			}
+		}
 	}
 
 
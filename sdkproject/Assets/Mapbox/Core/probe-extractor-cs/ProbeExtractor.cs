@@ -5,6 +5,7 @@
 	using Mapbox.CheapRulerCs;
 	using System;
 	using System.Collections.Generic;
+	using System.Threading;
 
 
 	public class ProbeExtractorOptions
@@ -23,16 +24,21 @@
 		public int MinProbes = 2;
 		/// <summary>Also return probes deemed not good</summary>
 		public bool OutputBadProbes = false;
+		/// <summary>Seconds between two trace points that split the trace into segments extracted independently</summary>
+		public double SegmentGap = double.MaxValue;
 	}
 
 
 	/// <summary>
 	/// <para>This module allows to pass a list of trace points and extract its probes and their properties.</para>
 	/// <para>It can also act as a filter for those probes.</para>
+	/// <para>Long traces can be streamed and split into segments that are extracted in parallel.</para>
 	/// </summary>
 	public class ProbeExtractor
 	{
 
+		private const int QUEUED_CHUNKS_PER_WORKER = 4;
+
 		private CheapRuler _ruler;
 		private ProbeExtractorOptions _options;
 
@@ -56,299 +62,277 @@
 		/// <returns>List of probes. Empty list if no trace point matched the options.</returns>
 		public List<Probe> ExtractProbes(List<TracePoint> trace)
 		{
-			int tracePntCnt = trace.Count;
-			long[] durations = new long[tracePntCnt - 1];
-			double[] distances = new double[tracePntCnt - 1];
-			double[] speeds = new double[tracePntCnt - 1];
-			double[] bearings = new double[tracePntCnt - 1];
-
-			for (int i = 1; i < tracePntCnt; i++)
-			{
-				TracePoint current = trace[i];
-				TracePoint previous = trace[i - 1];
-				int insertIdx = i - 1;
-
-				durations[insertIdx] = (current.Timestamp - previous.Timestamp) / 1000; //seconds
-
-				double[] currLocation = new double[] { current.Longitude, current.Latitude };
-				double[] prevLocation = new double[] { previous.Longitude, previous.Latitude };
-				distances[insertIdx] = _ruler.Distance(currLocation, prevLocation);
-				speeds[insertIdx] = distances[insertIdx] / durations[insertIdx] * 3600; //kph
+			return new List<Probe>(StreamProbes(trace));
+		}
 
-				double bearing = _ruler.Bearing(prevLocation, currLocation);
-				bearings[insertIdx] = bearing < 0 ? 360 + bearing : bearing;
-			}
 
+		/// <summary>
+		/// <para>Extract probes from a trace that is read while extracting, eg hours of telemetry from <see cref="TracePoint.FromLocations"/>.</para>
+		/// <para>Only a chunk of trace points is kept. Probes are the same as <see cref="ExtractProbes"/> returns, so they can only
+		/// be returned once their segment ended: set <see cref="ProbeExtractorOptions.SegmentGap"/> to split long recordings.</para>
+		/// </summary>
+		/// <param name="trace">Trace points in recording order</param>
+		/// <returns>Probes, segment by segment</returns>
+		public IEnumerable<Probe> StreamProbes(IEnumerable<TracePoint> trace)
+		{
+			TraceSegment segment = new TraceSegment(_ruler, _options);
 			List<Probe> probes = new List<Probe>();
-
-			// 1st pass: iterate trace points and determine if they are good
-			// bail early if !_options.OutputBadProbes
-			bool negativeDuration = false;
-			for (int i = 1; i < speeds.Length; i++)
+			long lastTimestamp = 0;
+			foreach (TracePoint point in trace)
 			{
-				//assume tracpoint is good
-				bool isGood = true;
-				if (negativeDuration)
-				{
-					// if trace already has a negative duration, then all probes are bad
-					isGood = false;
-				}
-				else if (durations[i] < 0)
-				{
-					// if a trace has negative duration, the trace is likely noisy
-					// bail, if we don't want bad probes
-					if (!_options.OutputBadProbes) { return new List<Probe>(); }
-
-					negativeDuration = true;
-					isGood = false;
-				}
-				else if (durations[i] < _options.MinTimeBetweenProbes)
-				{
-					// if shorter than the minTimeBetweenProbes, filter.
-					isGood = false;
-				}
-				else if (durations[i] > _options.MaxDurationRatioJump * durations[i - 1])
-				{
-					// if not a gradual decrease in sampling frequency, it's most likely a signal jump
-					isGood = false;
-				}
-				else if (speeds[i] - speeds[i - 1] > _options.MaxAcceleration * durations[i])
-				{
-					// if accelerating faster than maxAcceleration, it's most likely a glitch
-					isGood = false;
-				}
-				else if (speeds[i - 1] - speeds[i] > _options.MaxDeceleration * durations[i])
-				{
-					// if decelerating faster than maxDeceleration, it's most likely a glitch
-					isGood = false;
-				}
-				else
-				{
-					bool isForwardDirection = compareBearing(bearings[i - 1], bearings[i], 89, false);
-					if (!isForwardDirection)
-					{
-						isGood = false;
-					}
-				}
-
-				if (isGood || _options.OutputBadProbes)
+				if (segment.PointCount > 0 && splits(lastTimestamp, point.Timestamp))
 				{
-					double[] coords = pointAtDistanceAndBearing(
-						trace[i - 1]
-						, distances[i] / 2
-						, bearings[i]
-					);
-
-					probes.Add(new Probe()
-					{
-						Latitude = coords[1],
-						Longitude = coords[0],
-						StartTime = trace[i].Timestamp,
-						Duration = durations[i],
-						Distance = distances[i],
-						Speed = speeds[i],
-						Bearing = bearings[i],
-						IsGood = isGood
-					});
+					segment.Finish(probes);
+					foreach (Probe probe in probes) { yield return probe; }
+					probes.Clear();
 				}
+				segment.Add(point);
+				lastTimestamp = point.Timestamp;
 			}
 
-			// if too few good probes, drop entire trace
-			if (!_options.OutputBadProbes && probes.Count < _options.MinProbes)
-			{
-				return new List<Probe>();
-			}
+			segment.Finish(probes);
+			foreach (Probe probe in probes) { yield return probe; }
+		}
+
 
-			// MinProbes can be 0, return
-			if (probes.Count == 0 && _options.MinProbes == 0)
+		/// <summary>
+		/// <para>Like <see cref="StreamProbes(IEnumerable{TracePoint})"/> but segments are extracted on thread pool threads,
+		/// <paramref name="workers"/> chunks ahead of the calling thread reading the trace.</para>
+		/// <para>Probes are returned in the same order, only segments split by <see cref="ProbeExtractorOptions.SegmentGap"/>
+		/// can be extracted at the same time.</para>
+		/// </summary>
+		/// <param name="trace">Trace points in recording order</param>
+		/// <param name="workers">Segments extracted in parallel, 1 or less extracts on the calling thread</param>
+		/// <returns>Probes, segment by segment</returns>
+		public IEnumerable<Probe> StreamProbes(IEnumerable<TracePoint> trace, int workers)
+		{
+#if UNITY_WEBGL
+			workers = 1;
+#endif
+			if (workers <= 1)
 			{
-				return new List<Probe>();
+				foreach (Probe probe in StreamProbes(trace)) { yield return probe; }
+				yield break;
 			}
 
-
-			// 2nd pass
-
-			// require at least two probes
-			if (probes.Count > 1)
+			SegmentScheduler scheduler = new SegmentScheduler(workers * QUEUED_CHUNKS_PER_WORKER);
+			Queue<SegmentJob> jobs = new Queue<SegmentJob>();
+			SegmentJob job = null;
+			TracePoint[] chunk = null;
+			int chunkCount = 0;
+			long lastTimestamp = 0;
+			foreach (TracePoint point in trace)
 			{
-				// check first probe in a trace against the average of first two good probes
-				var avgSpeed = (probes[0].Speed + probes[1].Speed) / 2;
-				var avgDistance = (probes[0].Distance + probes[1].Distance) / 2;
-				var avgDuration = (probes[0].Duration + probes[1].Duration) / 2;
-				var avgBearing = averageAngle(probes[0].Bearing, probes[1].Bearing);
-
-				bool good = true;
-
-				if (negativeDuration)
+				if (null != job && splits(lastTimestamp, point.Timestamp))
 				{
-					if (!_options.OutputBadProbes)
-					{
-						return new List<Probe>();
-					}
-
-					negativeDuration = true;
-					good = false;
-
-					// if a trace has negative duration, the trace is likely noisy
-				}
-				else if (durations[0] < 0)
-				{
-					good = false;
-				}
-				else if (durations[0] < _options.MinTimeBetweenProbes)
-				{
-					// if shorter than the minTimeBetweenProbes, filter.
-					good = false;
-				}
-				else if (distances[0] > _options.MaxDistanceRatioJump * avgDistance)
-				{
-					// if not a gradual increase in distance, it's most likely a signal jump
-					good = false;
+					if (null != chunk) { scheduler.Submit(job, chunk, chunkCount); }
+					scheduler.Close(job);
+					chunk = null;
+					job = null;
 				}
-				else if (durations[0] > _options.MaxDurationRatioJump * avgDuration)
+				if (null == job)
 				{
-					// if not a gradual decrease in sampling frequency, it's most likely a signal jump
-					good = false;
+					job = new SegmentJob(new TraceSegment(_ruler, _options));
+					jobs.Enqueue(job);
 				}
-				else if (avgSpeed - speeds[0] > _options.MaxAcceleration * durations[0])
+				if (null == chunk)
 				{
-					// if accelerating faster than maxAcceleration, it's most likely a glitch
-					good = false;
+					chunk = scheduler.RentChunk();
+					chunkCount = 0;
 				}
-				else if (speeds[0] - avgSpeed > _options.MaxDeceleration * durations[0])
+
+				chunk[chunkCount++] = point;
+				lastTimestamp = point.Timestamp;
+				if (chunkCount == TraceSegment.CHUNK_SIZE)
 				{
-					// if decelerating faster than maxDeceleration, it's most likely a glitch
-					good = false;
-				}
-				else
-				{
-					// if in reverse direction, it's most likely signal jump
-					bool isForwardDirection = compareBearing(bearings[0], avgBearing, 89, false);
-					if (!isForwardDirection)
-					{
-						good = false;
-					}
+					scheduler.Submit(job, chunk, chunkCount);
+					chunk = null;
 				}
 
-				if (good || _options.OutputBadProbes)
+				// hand out finished segments, in order
+				while (jobs.Count > 0 && jobs.Peek().Done)
 				{
-
-					double[] coords = pointAtDistanceAndBearing(
-						trace[0]
-						, distances[0]
-						, bearings[0]
-					);
-
-					probes.Insert(
-						0,
-						new Probe()
-						{
-							Latitude = coords[1],
-							Longitude = coords[0],
-							StartTime = trace[0].Timestamp,
-							Duration = durations[0],
-							Distance = distances[0],
-							Speed = speeds[0],
-							Bearing = bearings[0],
-							IsGood = good
-						}
-					);
+					foreach (Probe probe in probesOf(jobs.Dequeue())) { yield return probe; }
 				}
 			}
 
-			return probes;
+			if (null != job)
+			{
+				if (null != chunk) { scheduler.Submit(job, chunk, chunkCount); }
+				scheduler.Close(job);
+			}
+			while (jobs.Count > 0)
+			{
+				SegmentJob next = jobs.Dequeue();
+				scheduler.Wait(next);
+				foreach (Probe probe in probesOf(next)) { yield return probe; }
+			}
 		}
 
 
 		/// <summary>
-		/// Computes the average of two angles.
+		/// Does a gap between two trace points start a new segment.
 		/// </summary>
-		/// <param name="a">First angle.</param>
-		/// <param name="b">Second angle</param>
-		/// <returns>Angle midway between a and b.</returns>
-		private double averageAngle(double a, double b)
+		private bool splits(long previousTimestamp, long timestamp)
 		{
-			var anorm = normalizeAngle(a);
-			var bnorm = normalizeAngle(b);
-
-			var minAngle = Math.Min(anorm, bnorm);
-			var maxAngle = Math.Max(anorm, bnorm);
+			return (timestamp - previousTimestamp) / 1000 > _options.SegmentGap;
+		}
 
-			var dist1 = Math.Abs(a - b);
-			var dist2 = (minAngle + (360 - maxAngle));
 
-			if (dist1 <= dist2) { return normalizeAngle(minAngle + dist1 / 2); }
-			else
+		private static List<Probe> probesOf(SegmentJob job)
+		{
+			if (null != job.Error)
 			{
-				return normalizeAngle(maxAngle + dist2 / 2);
+				throw new InvalidOperationException("Extracting probes failed", job.Error);
 			}
+			return job.Probes;
 		}
 
 
 		/// <summary>
-		/// Map angle to positive modulo 360 space.
+		/// A segment of the trace and the chunks of trace points waiting for it.
+		/// Chunks of one segment are extracted one after another, by one thread at a time.
 		/// </summary>
-		/// <param name="angle">An angle in degrees</param>
-		/// <returns>Equivalent angle in [0-360] space.</returns>
-		private double normalizeAngle(double angle)
+		private class SegmentJob
 		{
-			return (angle < 0) ? (angle % 360) + 360 : (angle % 360);
+			public readonly TraceSegment Segment;
+			public readonly List<Probe> Probes = new List<Probe>();
+			public readonly Queue<TracePoint[]> Chunks = new Queue<TracePoint[]>();
+			public readonly Queue<int> ChunkCounts = new Queue<int>();
+			public bool Scheduled;
+			public bool Closed;
+			public volatile bool Done;
+			public Exception Error;
+
+			public SegmentJob(TraceSegment segment)
+			{
+				Segment = segment;
+			}
 		}
 
 
 		/// <summary>
-		/// Compare bearing `baseBearing` to `bearing`, to determine if they are close enough to each other to be considered matching.
+		/// Runs segment jobs on the thread pool, blocks the reading thread once too many chunks wait and recycles them.
 		/// </summary>
-		/// <param name="baseBearing">Base bearing</param>
-		/// <param name="bearing">Number of degrees difference that is allowed between the bearings.</param>
-		/// <param name="range"></param>
-		/// <param name="allowReverse">allows bearings that are 180 degrees +/- `range` to be considered matching</param>
-		/// <returns></returns>
-		private bool compareBearing(double baseBearing, double bearing, double range, bool allowReverse)
+		private class SegmentScheduler
 		{
+			private readonly object _lock = new object();
+			private readonly int _maxQueuedChunks;
+			private readonly Stack<TracePoint[]> _freeChunks = new Stack<TracePoint[]>();
+			private readonly WaitCallback _drain;
+			private int _queuedChunks;
 
-			// map base and bearing into positive modulo 360 space
-			var normalizedBase = normalizeAngle(baseBearing);
-			var normalizedBearing = normalizeAngle(bearing);
-
-			var min = normalizeAngle(normalizedBase - range);
-			var max = normalizeAngle(normalizedBase + range);
+			public SegmentScheduler(int maxQueuedChunks)
+			{
+				_maxQueuedChunks = maxQueuedChunks;
+				_drain = drain;
+			}
 
-			if (min < max)
+			public TracePoint[] RentChunk()
 			{
-				if (min <= normalizedBearing && normalizedBearing <= max)
+				lock (_lock)
 				{
-					return true;
+					return _freeChunks.Count > 0 ? _freeChunks.Pop() : new TracePoint[TraceSegment.CHUNK_SIZE];
 				}
 			}
-			else if (min <= normalizedBearing || normalizedBearing <= max)
+
+			public void Submit(SegmentJob job, TracePoint[] chunk, int count)
 			{
-				return true;
+				lock (_lock)
+				{
+					while (_queuedChunks >= _maxQueuedChunks) { Monitor.Wait(_lock); }
+					job.Chunks.Enqueue(chunk);
+					job.ChunkCounts.Enqueue(count);
+					_queuedChunks++;
+					schedule(job);
+				}
 			}
 
-			if (allowReverse)
+			/// <summary> No more chunks for <paramref name="job"/>, it finishes once the queued ones are extracted. </summary>
+			public void Close(SegmentJob job)
 			{
-				return compareBearing(normalizedBase + 180, bearing, range, false);
+				lock (_lock)
+				{
+					job.Closed = true;
+					schedule(job);
+				}
 			}
 
-			return false;
-		}
+			public void Wait(SegmentJob job)
+			{
+				lock (_lock)
+				{
+					while (!job.Done) { Monitor.Wait(_lock); }
+				}
+			}
 
+			private void schedule(SegmentJob job)
+			{
+				if (!job.Scheduled)
+				{
+					job.Scheduled = true;
+					ThreadPool.QueueUserWorkItem(_drain, job);
+				}
+			}
 
+			private void drain(object state)
+			{
+				SegmentJob job = (SegmentJob)state;
+				while (true)
+				{
+					TracePoint[] chunk = null;
+					int count = 0;
+					lock (_lock)
+					{
+						if (job.Chunks.Count > 0)
+						{
+							chunk = job.Chunks.Dequeue();
+							count = job.ChunkCounts.Dequeue();
+						}
+						else if (!job.Closed)
+						{
+							// more to come, 'Submit' schedules the job again
+							job.Scheduled = false;
+							return;
+						}
+					}
 
-		/// <summary>
-		/// Creates coordinate in between two trace points to smooth line
-		/// </summary>
-		/// <returns>double array containing lng/lat</returns>
-		private double[] pointAtDistanceAndBearing(TracePoint tracePoint, double distance, double bearing)
-		{
-			return _ruler.Destination(
-				new double[] { tracePoint.Longitude, tracePoint.Latitude }
-				, distance
-				, bearing
-			);
+					if (null == chunk)
+					{
+						try
+						{
+							if (null == job.Error) { job.Segment.Finish(job.Probes); }
+						}
+						catch (Exception ex)
+						{
+							job.Error = ex;
+						}
+						lock (_lock)
+						{
+							job.Done = true;
+							Monitor.PulseAll(_lock);
+						}
+						return;
+					}
 
+					try
+					{
+						if (null == job.Error) { job.Segment.Add(chunk, count); }
+					}
+					catch (Exception ex)
+					{
+						job.Error = ex;
+					}
+					lock (_lock)
+					{
+						_freeChunks.Push(chunk);
+						_queuedChunks--;
+						Monitor.PulseAll(_lock);
+					}
+				}
+			}
 		}
 
+
 	}
 }
\ No newline at end of file
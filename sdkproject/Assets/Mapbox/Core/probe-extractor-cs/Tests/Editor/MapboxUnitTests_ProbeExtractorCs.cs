@@ -110,6 +110,129 @@ namespace Mapbox.ProbeExtractorCs.UnitTest
 		}
 
 
+		[Test]
+		public void StreamingMatchesList()
+		{
+			CheapRuler ruler = CheapRuler.FromTile(49, 7);
+			foreach (ProbeExtractorOptions options in optionVariants())
+			{
+				ProbeExtractor extractor = new ProbeExtractor(ruler, options);
+				foreach (List<TracePoint> trace in new List<TracePoint>[] { _trace, _footTrace, longTrace(5000, 0) })
+				{
+					List<Probe> expected = extractor.ExtractProbes(trace);
+					assertSameProbes(expected, new List<Probe>(extractor.StreamProbes(trace)));
+					assertSameProbes(expected, new List<Probe>(extractor.StreamProbes(trace, 4)));
+				}
+			}
+		}
+
+
+		[Test]
+		public void SegmentsAreExtractedIndependently()
+		{
+			CheapRuler ruler = new CheapRuler(49);
+			List<TracePoint> trace = longTrace(20000, 300);
+			foreach (ProbeExtractorOptions options in optionVariants())
+			{
+				// every segment on its own, split at the 5 minute gaps
+				List<Probe> expected = new List<Probe>();
+				ProbeExtractor whole = new ProbeExtractor(ruler, options);
+				int start = 0;
+				for (int i = 1; i <= trace.Count; i++)
+				{
+					if (i == trace.Count || (trace[i].Timestamp - trace[i - 1].Timestamp) / 1000 > 60)
+					{
+						expected.AddRange(whole.ExtractProbes(trace.GetRange(start, i - start)));
+						start = i;
+					}
+				}
+
+				options.SegmentGap = 60;
+				ProbeExtractor extractor = new ProbeExtractor(ruler, options);
+				assertSameProbes(expected, new List<Probe>(extractor.StreamProbes(trace)));
+				assertSameProbes(expected, new List<Probe>(extractor.StreamProbes(trace, 4)));
+				assertSameProbes(expected, extractor.ExtractProbes(trace));
+			}
+		}
+
+
+		[Test]
+		public void BenchmarkStreaming()
+		{
+			CheapRuler ruler = new CheapRuler(49);
+			// keep bad probes, otherwise the clock glitches discard the unsplit trace
+			ProbeExtractorOptions options = new ProbeExtractorOptions() { MinTimeBetweenProbes = 1, MaxAcceleration = 15, MaxDeceleration = 18, OutputBadProbes = true };
+			List<TracePoint> trace = longTrace(1000000, 2000);
+			ProbeExtractor extractor = new ProbeExtractor(ruler, options);
+
+			System.Diagnostics.Stopwatch sw = System.Diagnostics.Stopwatch.StartNew();
+			int listCount = extractor.ExtractProbes(trace).Count;
+			long listMs = sw.ElapsedMilliseconds;
+
+			sw = System.Diagnostics.Stopwatch.StartNew();
+			int streamCount = 0;
+			foreach (Probe probe in extractor.StreamProbes(trace)) { streamCount++; }
+			long streamMs = sw.ElapsedMilliseconds;
+
+			options.SegmentGap = 60;
+			int workers = Environment.ProcessorCount;
+			sw = System.Diagnostics.Stopwatch.StartNew();
+			int parallelCount = 0;
+			foreach (Probe probe in extractor.StreamProbes(trace, workers)) { parallelCount++; }
+			long parallelMs = sw.ElapsedMilliseconds;
+
+			Assert.AreEqual(listCount, streamCount);
+			Debug.Log(string.Format("[ProbeExtractor] {0} points: list {1}ms, streamed {2}ms ({3} probes), segments on {4} workers {5}ms ({6} probes)", trace.Count, listMs, streamMs, streamCount, workers, parallelMs, parallelCount));
+		}
+
+
+		private static IEnumerable<ProbeExtractorOptions> optionVariants()
+		{
+			yield return new ProbeExtractorOptions();
+			yield return new ProbeExtractorOptions() { MinTimeBetweenProbes = 1, MaxDistanceRatioJump = 3, MaxDurationRatioJump = 3, MaxAcceleration = 15, MaxDeceleration = 18 };
+			yield return new ProbeExtractorOptions() { MinTimeBetweenProbes = 2, MaxAcceleration = 15, MaxDeceleration = 18, OutputBadProbes = true };
+			yield return new ProbeExtractorOptions() { MinProbes = 50 };
+		}
+
+
+		private static void assertSameProbes(List<Probe> expected, List<Probe> actual)
+		{
+			Assert.AreEqual(expected.Count, actual.Count, "number of probes doesn't match");
+			for (int i = 0; i < expected.Count; i++)
+			{
+				Assert.AreEqual(expected[i], actual[i], "probe[" + i.ToString() + "] doesn't match");
+			}
+		}
+
+
+		/// <summary>
+		/// Noisy drive with a sample every 1-3s, some samples out of order and a 5 minute break every <paramref name="segmentLength"/> points.
+		/// </summary>
+		private static List<TracePoint> longTrace(int count, int segmentLength)
+		{
+			System.Random random = new System.Random(count);
+			List<TracePoint> trace = new List<TracePoint>(count);
+			double lng = 7.0;
+			double lat = 49.0;
+			double heading = 0;
+			long timestamp = 1500000000000;
+			for (int i = 0; i < count; i++)
+			{
+				if (segmentLength > 0 && i > 0 && i % segmentLength == 0) { timestamp += 300000; }
+				long step = 1000 + random.Next(2000);
+				// rare clock glitches, leaving whole segments with a negative duration
+				if (random.Next(3000) == 0) { step = -2000; }
+				timestamp += step;
+				heading += (random.NextDouble() - 0.5) * 40;
+				double metres = random.Next(20) == 0 ? 300 : 15 * step / 1000.0;
+				lng += Math.Sin(heading * Math.PI / 180) * metres / 73000;
+				lat += Math.Cos(heading * Math.PI / 180) * metres / 111000;
+				trace.Add(new TracePoint() { Longitude = lng, Latitude = lat, Timestamp = timestamp });
+			}
+			return trace;
+		}
+
+
 		private List<TracePoint> loadTraceFixture(string fixtureName)
 		{
 			TextAsset fixtureAsset = Resources.Load<TextAsset>(fixtureName);
@@ -0,0 +1,430 @@
+namespace Mapbox.ProbeExtractorCs
+{
+
+
+	using Mapbox.CheapRulerCs;
+	using System;
+	using System.Collections.Generic;
+
+
+	/// <summary>
+	/// <para>Extracts the probes of one trace, fed point by point.</para>
+	/// <para>Only the last two points, the first leg and a chunk of coordinates are kept, legs are measured a chunk at a time.
+	/// The probes themselves are held until <see cref="Finish"/>: a negative duration anywhere in the trace or too few good
+	/// probes discard all of them, and the first probe depends on the first two good ones.</para>
+	/// </summary>
+	internal class TraceSegment
+	{
+
+
+		public const int CHUNK_SIZE = 1024;
+
+		private CheapRuler _ruler;
+		private ProbeExtractorOptions _options;
+
+		// points waiting to be measured and their coordinates, prefixed with the last measured point
+		private TracePoint[] _chunk = new TracePoint[CHUNK_SIZE];
+		private int _chunkCount;
+		private double[] _line = new double[(CHUNK_SIZE + 1) * 2];
+		private double[] _distances = new double[CHUNK_SIZE];
+		private double[] _bearings = new double[CHUNK_SIZE];
+
+		private int _pointCount;
+		private TracePoint _first;
+		private TracePoint _previous;
+		private TracePoint _current;
+
+		private long _firstDuration;
+		private double _firstDistance;
+		private double _firstSpeed;
+		private double _firstBearing;
+		private long _previousDuration;
+		private double _previousSpeed;
+		private double _previousBearing;
+
+		private bool _negativeDuration;
+		private bool _discarded;
+		private List<Probe> _probes = new List<Probe>();
+
+
+		public TraceSegment(CheapRuler ruler, ProbeExtractorOptions options)
+		{
+			_ruler = ruler;
+			_options = options;
+		}
+
+
+		/// <summary>
+		/// Number of points added since the segment was started.
+		/// </summary>
+		public int PointCount { get { return _pointCount + _chunkCount; } }
+
+
+		public void Add(TracePoint point)
+		{
+			_chunk[_chunkCount++] = point;
+			if (_chunkCount == CHUNK_SIZE)
+			{
+				measureChunk();
+			}
+		}
+
+
+		public void Add(TracePoint[] points, int count)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				Add(points[i]);
+			}
+		}
+
+
+		/// <summary>
+		/// Append the probes of the trace to <paramref name="probes"/> and start over.
+		/// </summary>
+		public void Finish(List<Probe> probes)
+		{
+			measureChunk();
+			secondPass();
+			if (!_discarded)
+			{
+				probes.AddRange(_probes);
+			}
+
+			_probes.Clear();
+			_pointCount = 0;
+			_negativeDuration = false;
+			_discarded = false;
+		}
+
+
+		/// <summary>
+		/// Measure the legs ending in the points of the chunk with one ruler call and run them through the first pass.
+		/// </summary>
+		private void measureChunk()
+		{
+			if (_chunkCount == 0) { return; }
+
+			int linePoints = 0;
+			if (_pointCount > 0)
+			{
+				_line[0] = _current.Longitude;
+				_line[1] = _current.Latitude;
+				linePoints = 1;
+			}
+			for (int i = 0; i < _chunkCount; i++)
+			{
+				_line[linePoints * 2] = _chunk[i].Longitude;
+				_line[linePoints * 2 + 1] = _chunk[i].Latitude;
+				linePoints++;
+			}
+			if (!_discarded)
+			{
+				_ruler.Legs(_line, linePoints, _distances, _bearings);
+			}
+
+			// without a previous point the first point of the chunk starts the trace
+			int leg = _pointCount > 0 ? 0 : -1;
+			for (int i = 0; i < _chunkCount; i++, leg++)
+			{
+				TracePoint next = _chunk[i];
+				if (leg < 0)
+				{
+					_first = next;
+				}
+				else if (!_discarded)
+				{
+					addLeg(next, _distances[leg], _bearings[leg]);
+				}
+				_previous = _current;
+				_current = next;
+				_pointCount++;
+			}
+			_chunkCount = 0;
+		}
+
+
+		/// <summary>
+		/// 1st pass: determine if the leg from the current point to <paramref name="next"/> makes a good probe.
+		/// The first leg is only measured, it's checked against the first good probes in <see cref="secondPass"/>.
+		/// </summary>
+		private void addLeg(TracePoint next, double distance, double bearing)
+		{
+			long duration = (next.Timestamp - _current.Timestamp) / 1000; //seconds
+			double speed = distance / duration * 3600; //kph
+			bearing = bearing < 0 ? 360 + bearing : bearing;
+
+			if (_pointCount == 1)
+			{
+				_firstDuration = duration;
+				_firstDistance = distance;
+				_firstSpeed = speed;
+				_firstBearing = bearing;
+			}
+			else
+			{
+				//assume tracpoint is good
+				bool isGood = true;
+				if (_negativeDuration)
+				{
+					// if trace already has a negative duration, then all probes are bad
+					isGood = false;
+				}
+				else if (duration < 0)
+				{
+					// if a trace has negative duration, the trace is likely noisy
+					// bail, if we don't want bad probes
+					if (!_options.OutputBadProbes)
+					{
+						_discarded = true;
+						_probes.Clear();
+						return;
+					}
+
+					_negativeDuration = true;
+					isGood = false;
+				}
+				else if (duration < _options.MinTimeBetweenProbes)
+				{
+					// if shorter than the minTimeBetweenProbes, filter.
+					isGood = false;
+				}
+				else if (duration > _options.MaxDurationRatioJump * _previousDuration)
+				{
+					// if not a gradual decrease in sampling frequency, it's most likely a signal jump
+					isGood = false;
+				}
+				else if (speed - _previousSpeed > _options.MaxAcceleration * duration)
+				{
+					// if accelerating faster than maxAcceleration, it's most likely a glitch
+					isGood = false;
+				}
+				else if (_previousSpeed - speed > _options.MaxDeceleration * duration)
+				{
+					// if decelerating faster than maxDeceleration, it's most likely a glitch
+					isGood = false;
+				}
+				else
+				{
+					bool isForwardDirection = compareBearing(_previousBearing, bearing, 89, false);
+					if (!isForwardDirection)
+					{
+						isGood = false;
+					}
+				}
+
+				if (isGood || _options.OutputBadProbes)
+				{
+					double[] coords = pointAtDistanceAndBearing(
+						_previous
+						, distance / 2
+						, bearing
+					);
+
+					_probes.Add(new Probe()
+					{
+						Latitude = coords[1],
+						Longitude = coords[0],
+						StartTime = _current.Timestamp,
+						Duration = duration,
+						Distance = distance,
+						Speed = speed,
+						Bearing = bearing,
+						IsGood = isGood
+					});
+				}
+			}
+
+			_previousDuration = duration;
+			_previousSpeed = speed;
+			_previousBearing = bearing;
+		}
+
+
+		/// <summary>
+		/// 2nd pass: drop traces with too few good probes and check the first leg against the first two probes.
+		/// </summary>
+		private void secondPass()
+		{
+			if (_discarded) { return; }
+
+			// if too few good probes, drop entire trace
+			if (!_options.OutputBadProbes && _probes.Count < _options.MinProbes)
+			{
+				_discarded = true;
+				return;
+			}
+
+			// require at least two probes
+			if (_probes.Count < 2) { return; }
+
+			// check first probe in a trace against the average of first two good probes
+			var avgSpeed = (_probes[0].Speed + _probes[1].Speed) / 2;
+			var avgDistance = (_probes[0].Distance + _probes[1].Distance) / 2;
+			var avgDuration = (_probes[0].Duration + _probes[1].Duration) / 2;
+			var avgBearing = averageAngle(_probes[0].Bearing, _probes[1].Bearing);
+
+			bool good = true;
+
+			if (_negativeDuration)
+			{
+				// if a trace has negative duration, the trace is likely noisy
+				good = false;
+			}
+			else if (_firstDuration < 0)
+			{
+				good = false;
+			}
+			else if (_firstDuration < _options.MinTimeBetweenProbes)
+			{
+				// if shorter than the minTimeBetweenProbes, filter.
+				good = false;
+			}
+			else if (_firstDistance > _options.MaxDistanceRatioJump * avgDistance)
+			{
+				// if not a gradual increase in distance, it's most likely a signal jump
+				good = false;
+			}
+			else if (_firstDuration > _options.MaxDurationRatioJump * avgDuration)
+			{
+				// if not a gradual decrease in sampling frequency, it's most likely a signal jump
+				good = false;
+			}
+			else if (avgSpeed - _firstSpeed > _options.MaxAcceleration * _firstDuration)
+			{
+				// if accelerating faster than maxAcceleration, it's most likely a glitch
+				good = false;
+			}
+			else if (_firstSpeed - avgSpeed > _options.MaxDeceleration * _firstDuration)
+			{
+				// if decelerating faster than maxDeceleration, it's most likely a glitch
+				good = false;
+			}
+			else
+			{
+				// if in reverse direction, it's most likely signal jump
+				bool isForwardDirection = compareBearing(_firstBearing, avgBearing, 89, false);
+				if (!isForwardDirection)
+				{
+					good = false;
+				}
+			}
+
+			if (good || _options.OutputBadProbes)
+			{
+				double[] coords = pointAtDistanceAndBearing(
+					_first
+					, _firstDistance
+					, _firstBearing
+				);
+
+				_probes.Insert(
+					0,
+					new Probe()
+					{
+						Latitude = coords[1],
+						Longitude = coords[0],
+						StartTime = _first.Timestamp,
+						Duration = _firstDuration,
+						Distance = _firstDistance,
+						Speed = _firstSpeed,
+						Bearing = _firstBearing,
+						IsGood = good
+					}
+				);
+			}
+		}
+
+
+		/// <summary>
+		/// Computes the average of two angles.
+		/// </summary>
+		/// <param name="a">First angle.</param>
+		/// <param name="b">Second angle</param>
+		/// <returns>Angle midway between a and b.</returns>
+		private double averageAngle(double a, double b)
+		{
+			var anorm = normalizeAngle(a);
+			var bnorm = normalizeAngle(b);
+
+			var minAngle = Math.Min(anorm, bnorm);
+			var maxAngle = Math.Max(anorm, bnorm);
+
+			var dist1 = Math.Abs(a - b);
+			var dist2 = (minAngle + (360 - maxAngle));
+
+			if (dist1 <= dist2) { return normalizeAngle(minAngle + dist1 / 2); }
+			else
+			{
+				return normalizeAngle(maxAngle + dist2 / 2);
+			}
+		}
+
+
+		/// <summary>
+		/// Map angle to positive modulo 360 space.
+		/// </summary>
+		/// <param name="angle">An angle in degrees</param>
+		/// <returns>Equivalent angle in [0-360] space.</returns>
+		private double normalizeAngle(double angle)
+		{
+			return (angle < 0) ? (angle % 360) + 360 : (angle % 360);
+		}
+
+
+		/// <summary>
+		/// Compare bearing `baseBearing` to `bearing`, to determine if they are close enough to each other to be considered matching.
+		/// </summary>
+		/// <param name="baseBearing">Base bearing</param>
+		/// <param name="bearing">Number of degrees difference that is allowed between the bearings.</param>
+		/// <param name="range"></param>
+		/// <param name="allowReverse">allows bearings that are 180 degrees +/- `range` to be considered matching</param>
+		/// <returns></returns>
+		private bool compareBearing(double baseBearing, double bearing, double range, bool allowReverse)
+		{
+
+			// map base and bearing into positive modulo 360 space
+			var normalizedBase = normalizeAngle(baseBearing);
+			var normalizedBearing = normalizeAngle(bearing);
+
+			var min = normalizeAngle(normalizedBase - range);
+			var max = normalizeAngle(normalizedBase + range);
+
+			if (min < max)
+			{
+				if (min <= normalizedBearing && normalizedBearing <= max)
+				{
+					return true;
+				}
+			}
+			else if (min <= normalizedBearing || normalizedBearing <= max)
+			{
+				return true;
+			}
+
+			if (allowReverse)
+			{
+				return compareBearing(normalizedBase + 180, bearing, range, false);
+			}
+
+			return false;
+		}
+
+
+		/// <summary>
+		/// Creates coordinate in between two trace points to smooth line
+		/// </summary>
+		/// <returns>double array containing lng/lat</returns>
+		private double[] pointAtDistanceAndBearing(TracePoint tracePoint, double distance, double bearing)
+		{
+			return _ruler.Destination(
+				new double[] { tracePoint.Longitude, tracePoint.Latitude }
+				, distance
+				, bearing
+			);
+
+		}
+
+
+	}
+}
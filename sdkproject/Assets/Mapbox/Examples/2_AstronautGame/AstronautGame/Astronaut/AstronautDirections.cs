@@ -44,10 +44,7 @@ namespace Mapbox.Examples
 			}
 
 			var dat = new List<Vector3>();
-			foreach (var point in response.Routes[0].Geometry)
-			{
-				dat.Add(Conversions.GeoToWorldPosition(point.x, point.y, _map.CenterMercator, _map.WorldRelativeScale).ToVector3xz());
-			}
+			Conversions.GeoToWorldPosition(response.Routes[0].Geometry, _map.CenterMercator, _map.WorldRelativeScale, dat);
 
 			callback(dat);
 		}
@@ -10,6 +10,8 @@
 		public bool isEnabled = true;
 		[Tooltip("Number of feature entities to group in one single coroutine call. ")]
 		public int entityPerCoroutine = 20;
+		[Tooltip("Main thread time in milliseconds all vector layers together may spend building features each frame. Decoding and filtering run on worker threads. ")]
+		public float frameBudgetMilliseconds = 4f;
 
 		public override bool HasChanged
 		{
@@ -0,0 +1,37 @@
+namespace Mapbox.Editor
+{
+	using System.IO;
+	using Mapbox.Unity.Location;
+	using UnityEditor;
+	using UnityEngine;
+
+	/// <summary>
+	/// Converts the selected text location log into a binary log next to it, see <see cref="LocationLogConverter"/>.
+	/// </summary>
+	public static class ConvertLocationLog
+	{
+
+
+		[MenuItem("Assets/Mapbox/Convert Location Log To Binary")]
+		public static void ConvertSelected()
+		{
+			string textLogPath = AssetDatabase.GetAssetPath(Selection.activeObject);
+			// '.bytes' so Unity imports it as a TextAsset for 'EditorLocationProviderLocationLog'
+			string binaryLogPath = Path.ChangeExtension(textLogPath, ".bytes");
+
+			int count = LocationLogConverter.TextToBinary(textLogPath, binaryLogPath);
+			AssetDatabase.ImportAsset(binaryLogPath);
+			Debug.LogFormat("converted {0} locations: {1} ({2} bytes) -> {3} ({4} bytes)", count, textLogPath, new FileInfo(textLogPath).Length, binaryLogPath, new FileInfo(binaryLogPath).Length);
+		}
+
+
+		[MenuItem("Assets/Mapbox/Convert Location Log To Binary", true)]
+		public static bool ValidateConvertSelected()
+		{
+			var textAsset = Selection.activeObject as TextAsset;
+			return null != textAsset && AssetDatabase.GetAssetPath(textAsset).EndsWith(".txt");
+		}
+
+
+	}
+}
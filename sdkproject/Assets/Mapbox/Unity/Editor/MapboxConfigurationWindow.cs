@@ -27,10 +27,16 @@ namespace Mapbox.Editor
 		static string _accessToken = "";
 		[Range(0, 1000)]
 		static int _memoryCacheSize = 500;
+		[Range(0, 1024)]
+		static int _memoryCacheMegabytes = 128;
 		[Range(0, 3000)]
 		static int _fileCacheSize = 25000;
 		static int _webRequestTimeout = 30;
+		[Range(0, 64)]
+		static int _maxConcurrentTileRequests = 16;
+		static bool _useHttpPipeline = false;
 		static bool _autoRefreshCache = false;
+		static bool _shardedFileCache = false;
 
 		//mapbox access callbacks
 		static bool _listeningForTokenValidation = false;
@@ -134,9 +140,13 @@ namespace Mapbox.Editor
 				{
 					AccessToken = _accessToken,
 					MemoryCacheSize = (uint)_memoryCacheSize,
+					MemoryCacheMegabytes = (uint)_memoryCacheMegabytes,
 					FileCacheSize = (uint)_fileCacheSize,
 					AutoRefreshCache = _autoRefreshCache,
-					DefaultTimeout = _webRequestTimeout
+					ShardedFileCache = _shardedFileCache,
+					DefaultTimeout = _webRequestTimeout,
+					MaxConcurrentTileRequests = _maxConcurrentTileRequests,
+					UseHttpPipeline = _useHttpPipeline
 				};
 				var json = JsonUtility.ToJson(_mapboxConfig);
 				File.WriteAllText(_configurationFile, json);
@@ -165,9 +175,13 @@ namespace Mapbox.Editor
 			{
 				_accessToken = _mapboxConfig.AccessToken;
 				_memoryCacheSize = (int)_mapboxConfig.MemoryCacheSize;
+				_memoryCacheMegabytes = (int)_mapboxConfig.MemoryCacheMegabytes;
 				_fileCacheSize = (int)_mapboxConfig.FileCacheSize;
 				_autoRefreshCache = _mapboxConfig.AutoRefreshCache;
+				_shardedFileCache = _mapboxConfig.ShardedFileCache;
 				_webRequestTimeout = (int)_mapboxConfig.DefaultTimeout;
+				_maxConcurrentTileRequests = _mapboxConfig.MaxConcurrentTileRequests;
+				_useHttpPipeline = _mapboxConfig.UseHttpPipeline;
 
 			}
 
@@ -252,9 +266,13 @@ namespace Mapbox.Editor
 			{
 				AccessToken = _accessToken,
 				MemoryCacheSize = (uint)_memoryCacheSize,
+				MemoryCacheMegabytes = (uint)_memoryCacheMegabytes,
 				FileCacheSize = (uint)_fileCacheSize,
 				AutoRefreshCache = _autoRefreshCache,
-				DefaultTimeout = _webRequestTimeout
+				ShardedFileCache = _shardedFileCache,
+				DefaultTimeout = _webRequestTimeout,
+				MaxConcurrentTileRequests = _maxConcurrentTileRequests,
+				UseHttpPipeline = _useHttpPipeline
 			};
 			_mapboxAccess.SetConfiguration(mapboxConfiguration, false);
 			_validating = true;
@@ -542,9 +560,13 @@ namespace Mapbox.Editor
 				EditorGUIUtility.labelWidth = 240f;
 				EditorGUI.indentLevel = 2;
 				_memoryCacheSize = EditorGUILayout.IntSlider("Mem Cache Size (# of tiles)", _memoryCacheSize, 0, 1000);
+				_memoryCacheMegabytes = EditorGUILayout.IntSlider("Mem Cache Budget (MB, 0 = unlimited)", _memoryCacheMegabytes, 0, 1024);
 				_fileCacheSize = EditorGUILayout.IntSlider("File Cache Size (# of tiles)", _fileCacheSize, 0, 3000);
 				_autoRefreshCache = EditorGUILayout.Toggle(new GUIContent("Auto refresh cache", "Automatically update tiles in the local ambient cache if there is a newer version available online. ATTENTION: for every tile displayed (even a cached one) a webrequest needs to be made to check for updates."), _autoRefreshCache);
+				_shardedFileCache = EditorGUILayout.Toggle(new GUIContent("Sharded file cache", "One database per tileset in WAL mode. Tiles are written by a background thread in batches, reads don't wait for writes."), _shardedFileCache);
 				_webRequestTimeout = EditorGUILayout.IntField("Default Web Request Timeout (s)", _webRequestTimeout);
+				_maxConcurrentTileRequests = EditorGUILayout.IntSlider(new GUIContent("Concurrent Tile Requests (0 = unlimited)", "Tiles closest to the center of the view are requested first, requests for the same tile share one download."), _maxConcurrentTileRequests, 0, 64);
+				_useHttpPipeline = EditorGUILayout.Toggle(new GUIContent("HTTP pipeline", "Keep-alive connections with pipelined requests on a single I/O thread instead of UnityWebRequest. Not available on WebGL and UWP."), _useHttpPipeline);
 
 				EditorGUILayout.BeginHorizontal(_horizontalGroup);
 				GUILayout.Space(35f);
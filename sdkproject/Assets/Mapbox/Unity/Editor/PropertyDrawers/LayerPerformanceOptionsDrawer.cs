@@ -19,6 +19,7 @@
 			{
 				EditorGUI.indentLevel++;
 				EditorGUILayout.PropertyField(property.FindPropertyRelative("entityPerCoroutine"), true);
+				EditorGUILayout.PropertyField(property.FindPropertyRelative("frameBudgetMilliseconds"), true);
 				EditorGUI.indentLevel--;
 			}
 		}
@@ -0,0 +1,317 @@
+namespace Mapbox.Editor
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Globalization;
+	using System.IO;
+	using UnityEngine;
+	using UnityEditor;
+	using Mapbox.Map;
+	using Mapbox.Platform.Cache;
+	using Mapbox.Unity;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+
+	/// <summary>
+	/// Downloads a region into a tile pack, served by 'MapboxAccess' from 'MapboxAccess.TilePackDirectory' or 'StreamingAssets/tilepacks'.
+	/// Also runs without UI: 'Unity -batchmode -executeMethod Mapbox.Editor.TilePackBuilderWindow.BuildFromCommandLine', see <see cref="BuildFromCommandLine"/>.
+	/// </summary>
+	public class TilePackBuilderWindow : EditorWindow
+	{
+		public enum TilesetKind
+		{
+			Vector,
+			Terrain,
+			/// <summary>Style url, eg 'mapbox://styles/mapbox/satellite-v9'.</summary>
+			Raster,
+			/// <summary>Tileset id, eg 'mapbox.satellite'.</summary>
+			ClassicRaster
+		}
+
+		[Serializable]
+		class TilesetRow
+		{
+			public TilesetKind Kind;
+			public string Id;
+		}
+
+		[SerializeField]
+		string _southWest = "60.1500, 24.9000";
+		[SerializeField]
+		string _northEast = "60.1800, 24.9700";
+		[SerializeField]
+		int _minZoom = 10;
+		[SerializeField]
+		int _maxZoom = 16;
+		[SerializeField]
+		string _output = "";
+		[SerializeField]
+		List<TilesetRow> _tilesets = new List<TilesetRow>()
+		{
+			new TilesetRow() { Kind = TilesetKind.Vector, Id = "mapbox.mapbox-streets-v7" },
+			new TilesetRow() { Kind = TilesetKind.Terrain, Id = "mapbox.terrain-rgb" }
+		};
+
+		TilePackBuilder _builder;
+		string _status = "";
+		Vector2 _scrollPos;
+
+		[MenuItem("Mapbox/Tile Pack Builder")]
+		static void Open()
+		{
+			TilePackBuilderWindow window = GetWindow<TilePackBuilderWindow>(false, "Tile Pack Builder");
+			if (string.IsNullOrEmpty(window._output))
+			{
+				window._output = Path.Combine(MapboxAccess.TilePackDirectory, "region" + TilePackCache.FILE_EXTENSION);
+			}
+			window.minSize = new Vector2(400, 360);
+		}
+
+		void OnDisable()
+		{
+			if (null != _builder && !_builder.IsDone)
+			{
+				_builder.Cancel();
+			}
+		}
+
+		void OnInspectorUpdate()
+		{
+			if (null != _builder)
+			{
+				Repaint();
+			}
+		}
+
+		void OnGUI()
+		{
+			_scrollPos = EditorGUILayout.BeginScrollView(_scrollPos);
+
+			bool building = null != _builder && !_builder.IsDone;
+			GUI.enabled = !building;
+
+			EditorGUILayout.LabelField("Region", EditorStyles.boldLabel);
+			_southWest = EditorGUILayout.TextField("South West (lat, lon)", _southWest);
+			_northEast = EditorGUILayout.TextField("North East (lat, lon)", _northEast);
+			_minZoom = EditorGUILayout.IntSlider("Min Zoom", _minZoom, 0, 22);
+			_maxZoom = EditorGUILayout.IntSlider("Max Zoom", _maxZoom, _minZoom, 22);
+
+			EditorGUILayout.Space();
+			EditorGUILayout.LabelField("Tilesets", EditorStyles.boldLabel);
+			EditorGUILayout.HelpBox("Use the tileset ids of the map layers, tiles are looked up with them. Raster takes a style url, Classic Raster a tileset id.", MessageType.Info);
+			for (int i = 0; i < _tilesets.Count; i++)
+			{
+				EditorGUILayout.BeginHorizontal();
+				_tilesets[i].Kind = (TilesetKind)EditorGUILayout.EnumPopup(_tilesets[i].Kind, GUILayout.Width(100));
+				_tilesets[i].Id = EditorGUILayout.TextField(_tilesets[i].Id);
+				if (GUILayout.Button("-", GUILayout.Width(20)))
+				{
+					_tilesets.RemoveAt(i);
+					i--;
+				}
+				EditorGUILayout.EndHorizontal();
+			}
+			if (GUILayout.Button("Add Tileset", GUILayout.Width(100)))
+			{
+				_tilesets.Add(new TilesetRow() { Kind = TilesetKind.Vector, Id = "" });
+			}
+
+			EditorGUILayout.Space();
+			EditorGUILayout.BeginHorizontal();
+			_output = EditorGUILayout.TextField("Output", _output);
+			if (GUILayout.Button("...", GUILayout.Width(30)))
+			{
+				string path = EditorUtility.SaveFilePanel("Tile Pack", Path.GetDirectoryName(_output), Path.GetFileName(_output), TilePackCache.FILE_EXTENSION.TrimStart('.'));
+				if (!string.IsNullOrEmpty(path)) { _output = path; }
+			}
+			EditorGUILayout.EndHorizontal();
+
+			Vector2dBounds bounds;
+			string error = parseBounds(_southWest, _northEast, out bounds);
+			if (null == error)
+			{
+				int tiles = TilePackBuilder.CountTiles(bounds, _minZoom, _maxZoom) * _tilesets.Count;
+				EditorGUILayout.LabelField("Tiles to download", tiles.ToString("N0", CultureInfo.InvariantCulture));
+			}
+			else
+			{
+				EditorGUILayout.HelpBox(error, MessageType.Error);
+			}
+
+			EditorGUILayout.Space();
+			EditorGUILayout.BeginHorizontal();
+			GUI.enabled = !building && null == error && _tilesets.Count > 0 && !string.IsNullOrEmpty(_output);
+			if (GUILayout.Button("Build"))
+			{
+				build(bounds);
+			}
+			GUI.enabled = !building && File.Exists(_output);
+			if (GUILayout.Button("Export MBTiles"))
+			{
+				_status = exportMBTiles(_output);
+			}
+			GUI.enabled = building;
+			if (GUILayout.Button("Cancel"))
+			{
+				_builder.Cancel();
+			}
+			GUI.enabled = true;
+			EditorGUILayout.EndHorizontal();
+
+			if (null != _builder)
+			{
+				float progress = 0 == _builder.Total ? 1f : (float)_builder.Completed / _builder.Total;
+				Rect rect = EditorGUILayout.GetControlRect(false, EditorGUIUtility.singleLineHeight);
+				EditorGUI.ProgressBar(rect, progress, _builder.ToString());
+			}
+			if (!string.IsNullOrEmpty(_status))
+			{
+				EditorGUILayout.HelpBox(_status, MessageType.None);
+			}
+
+			EditorGUILayout.EndScrollView();
+		}
+
+		void build(Vector2dBounds bounds)
+		{
+			string directory = Path.GetDirectoryName(_output);
+			if (!string.IsNullOrEmpty(directory)) { Directory.CreateDirectory(directory); }
+
+			Runnable.EnableRunnableInEditor();
+			_status = "";
+			_builder = new TilePackBuilder(MapboxAccess.Instance, _output);
+			foreach (TilesetRow row in _tilesets)
+			{
+				if (string.IsNullOrEmpty(row.Id)) { continue; }
+				_builder.AddTileset(row.Id, MakeResource(row.Kind));
+			}
+			_builder.Build(bounds, _minZoom, _maxZoom, (b) =>
+			{
+				_status = b.IsCanceled ? "canceled" : string.Format("{0} tiles written to [{1}]", b.Completed - b.Failed, b.Path);
+				Debug.Log(b);
+			});
+		}
+
+		/// <summary>Request builder of a tileset kind.</summary>
+		public static Func<CanonicalTileId, string, TileResource> MakeResource(TilesetKind kind)
+		{
+			switch (kind)
+			{
+				case TilesetKind.Terrain:
+					return TileResource.MakeRawPngRaster;
+				case TilesetKind.Raster:
+					return TileResource.MakeRaster;
+				case TilesetKind.ClassicRaster:
+					return TileResource.MakeClassicRaster;
+				default:
+					return TileResource.MakeVector;
+			}
+		}
+
+		/// <summary>
+		/// Builds a tile pack from command line arguments and exits with 0 on success:
+		/// <code>
+		/// -tilepackBounds south,west,north,east
+		/// -tilepackZoom min-max
+		/// -tilepackTilesets vector:mapbox.mapbox-streets-v7,terrain:mapbox.terrain-rgb,raster:mapbox://styles/mapbox/satellite-v9
+		/// -tilepackOutput path/region.tilepack
+		/// -tilepackMBTiles (optional, also exports every tileset to an MBTiles file next to the pack)
+		/// </code>
+		/// </summary>
+		public static void BuildFromCommandLine()
+		{
+			string[] args = Environment.GetCommandLineArgs();
+			TilePackBuilder builder;
+			Vector2dBounds bounds;
+			int minZoom, maxZoom;
+			try
+			{
+				string[] corners = getArg(args, "-tilepackBounds").Split(',');
+				if (4 != corners.Length) { throw new ArgumentException("-tilepackBounds: expected south,west,north,east"); }
+				string error = parseBounds(corners[0] + "," + corners[1], corners[2] + "," + corners[3], out bounds);
+				if (null != error) { throw new ArgumentException("-tilepackBounds: " + error); }
+
+				string[] zoom = getArg(args, "-tilepackZoom").Split('-');
+				minZoom = int.Parse(zoom[0], CultureInfo.InvariantCulture);
+				maxZoom = zoom.Length > 1 ? int.Parse(zoom[1], CultureInfo.InvariantCulture) : minZoom;
+
+				builder = new TilePackBuilder(MapboxAccess.Instance, getArg(args, "-tilepackOutput"));
+				foreach (string tileset in getArg(args, "-tilepackTilesets").Split(','))
+				{
+					// split on the first ':' only, style urls contain one too
+					int colon = tileset.IndexOf(':');
+					if (colon < 0) { throw new ArgumentException("-tilepackTilesets: expected kind:id, got " + tileset); }
+					TilesetKind kind = (TilesetKind)Enum.Parse(typeof(TilesetKind), tileset.Substring(0, colon).Trim(), true);
+					builder.AddTileset(tileset.Substring(colon + 1).Trim(), MakeResource(kind));
+				}
+			}
+			catch (Exception ex)
+			{
+				Debug.LogErrorFormat("tile pack: {0}", ex.Message);
+				EditorApplication.Exit(1);
+				return;
+			}
+
+			string directory = Path.GetDirectoryName(builder.Path);
+			if (!string.IsNullOrEmpty(directory)) { Directory.CreateDirectory(directory); }
+			bool export = Array.IndexOf(args, "-tilepackMBTiles") >= 0;
+
+			Runnable.EnableRunnableInEditor();
+			builder.Build(bounds, minZoom, maxZoom, (b) =>
+			{
+				Debug.Log(b);
+				if (export && File.Exists(b.Path)) { Debug.Log(exportMBTiles(b.Path)); }
+				EditorApplication.Exit(0 == b.Failed && File.Exists(b.Path) ? 0 : 1);
+			});
+		}
+
+		static string exportMBTiles(string packPath)
+		{
+			try
+			{
+				using (TilePack pack = new TilePack(packPath))
+				{
+					List<string> exported = new List<string>();
+					foreach (string tilesetId in pack.Tilesets)
+					{
+						string name = tilesetId;
+						foreach (char c in Path.GetInvalidFileNameChars()) { name = name.Replace(c, '_'); }
+						string path = Path.ChangeExtension(packPath, null) + "." + name + ".mbtiles";
+						int count = MBTiles.Export(pack, tilesetId, path);
+						exported.Add(string.Format("{0} tiles to [{1}]", count, path));
+					}
+					return "exported " + string.Join(", ", exported.ToArray());
+				}
+			}
+			catch (Exception ex)
+			{
+				Debug.LogException(ex);
+				return "export failed: " + ex.Message;
+			}
+		}
+
+		static string getArg(string[] args, string name)
+		{
+			int idx = Array.IndexOf(args, name);
+			if (idx < 0 || idx + 1 >= args.Length) { throw new ArgumentException("missing argument " + name); }
+			return args[idx + 1];
+		}
+
+		static string parseBounds(string southWest, string northEast, out Vector2dBounds bounds)
+		{
+			bounds = new Vector2dBounds();
+			try
+			{
+				Vector2d sw = Conversions.StringToLatLon(southWest);
+				Vector2d ne = Conversions.StringToLatLon(northEast);
+				if (sw.x >= ne.x || sw.y >= ne.y) { return "south west has to be south west of north east"; }
+				bounds = new Vector2dBounds(sw, ne);
+				return null;
+			}
+			catch (Exception ex)
+			{
+				return ex.Message;
+			}
+		}
+	}
+}
@@ -26,7 +26,7 @@
 		private TextAsset _locationLogFile;
 
 
-		private LocationLogReader _logReader;
+		private ILocationLogReader _logReader;
 		private IEnumerator<Location> _locationEnumerator;
 
 
@@ -34,7 +34,7 @@
 		protected override void Awake()
 		{
 			base.Awake();
-			_logReader = new LocationLogReader(_locationLogFile.bytes);
+			_logReader = LocationLogReader.Open(_locationLogFile.bytes);
 			_locationEnumerator = _logReader.GetLocations();
 		}
 #endif
@@ -59,7 +59,7 @@
 		{
 			if (null == _locationEnumerator) { return; }
 
-			// no need to check if 'MoveNext()' returns false as LocationLogReader loops through log file
+			// no need to check if 'MoveNext()' returns false as the log reader loops through log file
 			_locationEnumerator.MoveNext();
 			_currentLocation = _locationEnumerator.Current;
 		}
@@ -0,0 +1,129 @@
+namespace Mapbox.Unity.Location
+{
+
+
+	using System;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+
+
+	/// <summary>
+	/// <para>Estimates position and velocity from a stream of <see cref="Location"/>s to extrapolate where the user will be.</para>
+	/// <para>Positions are smoothed with <see cref="KalmanLatLong"/>, velocity is an exponential moving average of the
+	/// movement between smoothed positions, or of speed and heading if the location provider reports them.
+	/// Everything is in web mercator meters, the unit tiles are laid out in.</para>
+	/// </summary>
+	public class LocationMotionEstimator
+	{
+
+
+		/// <param name="qMetersPerSecond">How fast the accuracy of the last position decays, see <see cref="KalmanLatLong"/>.</param>
+		/// <param name="velocityTimeConstant">Seconds after which an old velocity has lost two thirds of its weight.</param>
+		public LocationMotionEstimator(float qMetersPerSecond = 3f, double velocityTimeConstant = 4d)
+		{
+			_qMetersPerSecond = qMetersPerSecond;
+			_velocityTimeConstant = Math.Max(0.01d, velocityTimeConstant);
+			Reset();
+		}
+
+
+		private float _qMetersPerSecond;
+		private double _velocityTimeConstant;
+		private KalmanLatLong _kalman;
+		private int _fixes;
+		private Vector2d _position;
+		private Vector2d _velocity;
+		private double _timestamp;
+		private double _latitude;
+
+
+		/// <summary>Smoothed position in web mercator meters.</summary>
+		public Vector2d Position { get { return _position; } }
+
+
+		/// <summary>Velocity in web mercator meters per second.</summary>
+		public Vector2d Velocity { get { return _velocity; } }
+
+
+		/// <summary>UTC timestamp in seconds of the last fix.</summary>
+		public double Timestamp { get { return _timestamp; } }
+
+
+		/// <summary>True once two fixes have been seen and <see cref="Velocity"/> can be used.</summary>
+		public bool HasVelocity { get { return _fixes > 1; } }
+
+
+		/// <summary>Estimated speed over ground in meters per second.</summary>
+		public double SpeedMetersPerSecond
+		{
+			get { return _velocity.magnitude * Math.Cos(_latitude * Math.PI / 180d); }
+		}
+
+
+		public void Reset()
+		{
+			_kalman = new KalmanLatLong(_qMetersPerSecond);
+			_fixes = 0;
+			_position = Vector2d.zero;
+			_velocity = Vector2d.zero;
+			_timestamp = 0;
+		}
+
+
+		/// <summary>
+		/// Feed a location update. Updates without a new fix, eg heading only changes, are ignored.
+		/// </summary>
+		/// <returns>True if the estimate changed.</returns>
+		public bool Add(Location location)
+		{
+			if (location.LatitudeLongitude == Vector2d.zero) { return false; }
+			if (_fixes > 0 && location.Timestamp <= _timestamp) { return false; }
+
+			var latLng = location.LatitudeLongitude;
+			_kalman.Process(latLng.x, latLng.y, location.Accuracy, (long)(location.Timestamp * 1000d));
+			_latitude = _kalman.Lat;
+			var position = Conversions.LatLonToMeters(_kalman.Lat, _kalman.Lng);
+
+			if (_fixes > 0)
+			{
+				double dt = location.Timestamp - _timestamp;
+				Vector2d measured;
+				if (location.SpeedMetersPerSecond.HasValue && location.IsUserHeadingUpdated)
+				{
+					// ground speed to mercator meters, heading is clockwise from north
+					double speed = location.SpeedMetersPerSecond.Value / Math.Cos(_latitude * Math.PI / 180d);
+					double heading = location.UserHeading * Math.PI / 180d;
+					measured = new Vector2d(Math.Sin(heading) * speed, Math.Cos(heading) * speed);
+				}
+				else
+				{
+					measured = (position - _position) / dt;
+				}
+
+				if (_fixes == 1)
+				{
+					_velocity = measured;
+				}
+				else
+				{
+					double alpha = 1d - Math.Exp(-dt / _velocityTimeConstant);
+					_velocity = _velocity + (measured - _velocity) * alpha;
+				}
+			}
+
+			_position = position;
+			_timestamp = location.Timestamp;
+			_fixes++;
+			return true;
+		}
+
+
+		/// <summary>Extrapolated position in web mercator meters <paramref name="seconds"/> after the last fix.</summary>
+		public Vector2d Predict(double seconds)
+		{
+			return _position + _velocity * seconds;
+		}
+
+
+	}
+}
@@ -94,7 +94,7 @@ namespace Mapbox.Unity.Location
 			{
 				// else apply Kalman filter methodology
 
-				long TimeInc_milliseconds = TimeStamp_milliseconds - TimeStamp_milliseconds;
+				long TimeInc_milliseconds = TimeStamp_milliseconds - _timeStampMilliseconds;
 				if (TimeInc_milliseconds > 0)
 				{
 					// time has moved on, so the uncertainty in the current position increases
@@ -0,0 +1,133 @@
+namespace Mapbox.Unity.Location
+{
+
+
+	using System;
+	using System.IO;
+
+
+	/// <summary>
+	/// <para>Layout of binary location logs, written by <see cref="BinaryLocationLogWriter"/> and read by <see cref="BinaryLocationLogReader"/>.</para>
+	/// <para>The file starts with <see cref="Magic"/>, followed by blocks of <see cref="BLOCK_SIZE"/> locations, the string table
+	/// (provider names), the block index and a fixed size trailer pointing to the last two.</para>
+	/// <para>Blocks are columnar: all values of one field, then the next field. Numbers are fixed point (milliseconds, 1e-8 degrees,
+	/// tenths), stored as zigzag varint deltas to the previous value of the same column so a block decodes on its own.
+	/// The index holds offset and first timestamp of every block to seek by position or time without touching other blocks.</para>
+	/// </summary>
+	internal static class BinaryLocationLog
+	{
+
+
+		public const int BLOCK_SIZE = 1024;
+		public const byte VERSION = 1;
+		public const int TRAILER_SIZE = 32;
+
+		/// <summary> First and last 8 bytes of every binary log: "MBXLOG", version, 0. </summary>
+		public static readonly byte[] Magic = new byte[] { (byte)'M', (byte)'B', (byte)'X', (byte)'L', (byte)'O', (byte)'G', VERSION, 0 };
+
+		// bits of the flags column
+		public const int FLAG_SERVICE_ENABLED = 1 << 0;
+		public const int FLAG_SERVICE_INITIALIZING = 1 << 1;
+		public const int FLAG_LOCATION_UPDATED = 1 << 2;
+		public const int FLAG_USERHEADING_UPDATED = 1 << 3;
+		public const int FLAG_HAS_GPS_FIX_VALUE = 1 << 4;
+		public const int FLAG_HAS_GPS_FIX = 1 << 5;
+		public const int FLAG_SPEED_VALUE = 1 << 6;
+		public const int FLAG_SATELLITES_USED_VALUE = 1 << 7;
+		public const int FLAG_SATELLITES_IN_VIEW_VALUE = 1 << 8;
+
+		// columns of a block, in file order
+		public const int COLUMN_FLAGS = 0;
+		public const int COLUMN_PROVIDER = 1;
+		public const int COLUMN_PROVIDER_CLASS = 2;
+		public const int COLUMN_TIME_DEVICE = 3;
+		public const int COLUMN_TIME_LOCATION = 4;
+		public const int COLUMN_LATITUDE = 5;
+		public const int COLUMN_LONGITUDE = 6;
+		public const int COLUMN_ACCURACY = 7;
+		public const int COLUMN_USER_HEADING = 8;
+		public const int COLUMN_DEVICE_ORIENTATION = 9;
+		public const int COLUMN_SPEED = 10;
+		public const int COLUMN_SATELLITES_USED = 11;
+		public const int COLUMN_SATELLITES_IN_VIEW = 12;
+		public const int COLUMN_COUNT = 13;
+
+		public const double COORDINATE_SCALE = 1e8;
+
+
+		public static bool HasMagic(byte[] buffer, int offset)
+		{
+			if (null == buffer || buffer.Length - offset < Magic.Length) { return false; }
+			// the version byte is checked by the reader
+			for (int i = 0; i < 6; i++)
+			{
+				if (buffer[offset + i] != Magic[i]) { return false; }
+			}
+			return true;
+		}
+
+
+		/// <summary> Timestamp in seconds to whole milliseconds, the resolution of text logs. </summary>
+		public static long ToMilliseconds(double timestamp)
+		{
+			return (long)Math.Round(timestamp * 1000d);
+		}
+
+
+		/// <summary>
+		/// Milliseconds back to seconds through <see cref="TimeSpan"/>, the same way text logs are parsed,
+		/// so converted logs replay bit identical timestamps.
+		/// </summary>
+		public static double FromMilliseconds(long milliseconds)
+		{
+			return TimeSpan.FromTicks(milliseconds * TimeSpan.TicksPerMillisecond).TotalSeconds;
+		}
+
+
+		public static long ToTenths(float value)
+		{
+			return (long)Math.Round(value * 10d);
+		}
+
+
+		public static void WriteVarint(Stream stream, ulong value)
+		{
+			while (value >= 0x80)
+			{
+				stream.WriteByte((byte)(value | 0x80));
+				value >>= 7;
+			}
+			stream.WriteByte((byte)value);
+		}
+
+
+		public static void WriteSignedVarint(Stream stream, long value)
+		{
+			WriteVarint(stream, (ulong)((value << 1) ^ (value >> 63)));
+		}
+
+
+		public static ulong ReadVarint(byte[] buffer, ref int position)
+		{
+			ulong value = 0;
+			int shift = 0;
+			while (true)
+			{
+				byte b = buffer[position++];
+				value |= (ulong)(b & 0x7f) << shift;
+				if (b < 0x80) { return value; }
+				shift += 7;
+				if (shift > 63) { throw new FormatException("corrupt binary location log"); }
+			}
+		}
+
+
+		public static long ReadSignedVarint(byte[] buffer, ref int position)
+		{
+			ulong value = ReadVarint(buffer, ref position);
+			return (long)(value >> 1) ^ -(long)(value & 1);
+		}
+
+
+	}
+}
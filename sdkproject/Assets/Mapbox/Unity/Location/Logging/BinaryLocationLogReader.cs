@@ -0,0 +1,395 @@
+namespace Mapbox.Unity.Location
+{
+
+
+	using Mapbox.Utils;
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Text;
+
+
+	/// <summary>
+	/// <para>Reads binary location logs written by <see cref="BinaryLocationLogWriter"/> or converted with <see cref="LocationLogConverter"/>.</para>
+	/// <para>Only string table and block index are read up front. Locations are decoded a block at a time when they are
+	/// accessed, so a log opened from a file keeps one block in memory however long it is.</para>
+	/// </summary>
+	public class BinaryLocationLogReader : ILocationLogReader
+	{
+
+
+		/// <summary>
+		/// Read the log at <paramref name="path"/>, blocks are read from disk as they are needed.
+		/// </summary>
+		public BinaryLocationLogReader(string path)
+			: this(new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read))
+		{
+		}
+
+
+		public BinaryLocationLogReader(byte[] contents)
+			: this(new MemoryStream(contents, false))
+		{
+		}
+
+
+		/// <summary>
+		/// Read the log from <paramref name="stream"/>, which has to be seekable. The stream is closed on <see cref="Dispose()"/>.
+		/// </summary>
+		public BinaryLocationLogReader(Stream stream)
+		{
+			if (null == stream) { throw new ArgumentNullException("stream"); }
+			if (!stream.CanSeek) { throw new ArgumentException("stream has to be seekable", "stream"); }
+
+			_stream = stream;
+			try
+			{
+				readIndex();
+			}
+			catch
+			{
+				_stream.Dispose();
+				_stream = null;
+				throw;
+			}
+		}
+
+
+		private bool _disposed;
+		private Stream _stream;
+		private int _count;
+		private int _blockSize;
+		private long _stringTableOffset;
+		private string[] _strings;
+		private long[] _blockOffsets;
+		private double[] _blockTimestamps;
+
+		// the decoded block
+		private int _blockIndex = -1;
+		private byte[] _buffer = new byte[0];
+		private long[][] _columns;
+		private Location[] _block;
+
+
+		/// <summary>
+		/// Number of locations in the log.
+		/// </summary>
+		public int Count { get { return _count; } }
+
+
+		/// <summary>
+		/// Location at <paramref name="index"/>, decoding its block if it isn't the current one.
+		/// </summary>
+		public Location this[int index]
+		{
+			get
+			{
+				if (_disposed) { throw new ObjectDisposedException("BinaryLocationLogReader"); }
+				if (index < 0 || index >= _count) { throw new ArgumentOutOfRangeException("index"); }
+
+				int block = index / _blockSize;
+				if (block != _blockIndex) { loadBlock(block); }
+				return _block[index - block * _blockSize];
+			}
+		}
+
+
+		/// <summary>
+		/// Check for the header of a binary log, eg to tell them apart from text logs.
+		/// </summary>
+		public static bool IsBinaryLog(byte[] contents)
+		{
+			return BinaryLocationLog.HasMagic(contents, 0);
+		}
+
+
+		#region idisposable
+
+
+		~BinaryLocationLogReader()
+		{
+			Dispose(false);
+		}
+
+
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources)
+				{
+					if (null != _stream)
+					{
+#if !NETFX_CORE
+						_stream.Close();
+#endif
+						_stream.Dispose();
+						_stream = null;
+					}
+					_block = null;
+					_columns = null;
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		/// <summary>
+		/// Index of the first location at or after <paramref name="timestamp"/> (seconds, like <see cref="Location.Timestamp"/>),
+		/// <see cref="Count"/> if there is none. The block is found in the index, timestamps are expected to be ascending.
+		/// </summary>
+		public int IndexOf(double timestamp)
+		{
+			// last block starting before the timestamp, earlier blocks only hold earlier locations
+			int lo = 0;
+			int hi = _blockTimestamps.Length - 1;
+			int block = 0;
+			while (lo <= hi)
+			{
+				int mid = (lo + hi) / 2;
+				if (_blockTimestamps[mid] < timestamp)
+				{
+					block = mid;
+					lo = mid + 1;
+				}
+				else
+				{
+					hi = mid - 1;
+				}
+			}
+
+			for (int i = block * _blockSize; i < _count; i++)
+			{
+				if (this[i].Timestamp >= timestamp) { return i; }
+			}
+			return _count;
+		}
+
+
+		/// <summary>
+		/// Returns 'Location' objects from the log. Loops through the data.
+		/// </summary>
+		public IEnumerator<Location> GetLocations()
+		{
+			return GetLocations(0, true);
+		}
+
+
+		/// <summary>
+		/// Returns 'Location' objects from the log.
+		/// </summary>
+		/// <param name="loop">Start over at the end of the data, otherwise stop.</param>
+		public IEnumerator<Location> GetLocations(bool loop)
+		{
+			return GetLocations(0, loop);
+		}
+
+
+		/// <summary>
+		/// Returns 'Location' objects starting at <paramref name="startIndex"/>, see <see cref="IndexOf"/> to start at a point in time.
+		/// </summary>
+		/// <param name="startIndex">Index of the first location.</param>
+		/// <param name="loop">Start over at the beginning of the log when its end is reached, otherwise stop.</param>
+		public IEnumerator<Location> GetLocations(int startIndex, bool loop)
+		{
+			if (startIndex < 0 || startIndex > _count) { throw new ArgumentOutOfRangeException("startIndex"); }
+			return getLocations(startIndex, loop);
+		}
+
+
+		private IEnumerator<Location> getLocations(int index, bool loop)
+		{
+			while (true)
+			{
+				if (index >= _count)
+				{
+					if (!loop || 0 == _count) { yield break; }
+					index = 0;
+				}
+				yield return this[index++];
+			}
+		}
+
+
+		private void readIndex()
+		{
+			long length = _stream.Length;
+			int magicLength = BinaryLocationLog.Magic.Length;
+			if (length < magicLength + BinaryLocationLog.TRAILER_SIZE) { throw new FormatException("not a binary location log"); }
+
+			byte[] header = new byte[magicLength];
+			_stream.Position = 0;
+			readFully(header, magicLength);
+			checkMagic(header, 0);
+
+			byte[] trailer = new byte[BinaryLocationLog.TRAILER_SIZE];
+			_stream.Position = length - BinaryLocationLog.TRAILER_SIZE;
+			readFully(trailer, trailer.Length);
+			checkMagic(trailer, BinaryLocationLog.TRAILER_SIZE - magicLength);
+
+			_stringTableOffset = BitConverter.ToInt64(trailer, 0);
+			long indexOffset = BitConverter.ToInt64(trailer, 8);
+			_count = BitConverter.ToInt32(trailer, 16);
+			_blockSize = BitConverter.ToInt32(trailer, 20);
+
+			int blockCount = _blockSize > 0 ? (_count + _blockSize - 1) / _blockSize : -1;
+			long indexLength = length - BinaryLocationLog.TRAILER_SIZE - indexOffset;
+			if (
+				_count < 0
+				|| blockCount < 0
+				|| _stringTableOffset < magicLength
+				|| indexOffset < _stringTableOffset
+				|| indexLength != blockCount * 16L
+			)
+			{
+				throw new FormatException("corrupt binary location log");
+			}
+
+			// string table and index are read in one go, they are next to each other
+			byte[] tail = new byte[length - BinaryLocationLog.TRAILER_SIZE - _stringTableOffset];
+			_stream.Position = _stringTableOffset;
+			readFully(tail, tail.Length);
+
+			int position = 0;
+			int stringCount = (int)BinaryLocationLog.ReadVarint(tail, ref position);
+			_strings = new string[stringCount + 1];
+			for (int i = 1; i <= stringCount; i++)
+			{
+				int stringLength = (int)BinaryLocationLog.ReadVarint(tail, ref position);
+				_strings[i] = Encoding.UTF8.GetString(tail, position, stringLength);
+				position += stringLength;
+			}
+
+			position = (int)(indexOffset - _stringTableOffset);
+			_blockOffsets = new long[blockCount];
+			_blockTimestamps = new double[blockCount];
+			for (int i = 0; i < blockCount; i++)
+			{
+				_blockOffsets[i] = BitConverter.ToInt64(tail, position);
+				_blockTimestamps[i] = BinaryLocationLog.FromMilliseconds(BitConverter.ToInt64(tail, position + 8));
+				position += 16;
+			}
+
+			_columns = new long[BinaryLocationLog.COLUMN_COUNT][];
+			for (int i = 0; i < _columns.Length; i++)
+			{
+				_columns[i] = new long[_blockSize];
+			}
+			_block = new Location[_blockSize];
+		}
+
+
+		private void checkMagic(byte[] buffer, int offset)
+		{
+			if (!BinaryLocationLog.HasMagic(buffer, offset)) { throw new FormatException("not a binary location log"); }
+			if (buffer[offset + 6] != BinaryLocationLog.VERSION) { throw new FormatException("unsupported binary location log version: " + buffer[offset + 6]); }
+		}
+
+
+		private void loadBlock(int block)
+		{
+			long offset = _blockOffsets[block];
+			long end = block + 1 < _blockOffsets.Length ? _blockOffsets[block + 1] : _stringTableOffset;
+			int length = (int)(end - offset);
+			if (_buffer.Length < length) { _buffer = new byte[length]; }
+
+			_stream.Position = offset;
+			readFully(_buffer, length);
+
+			int rows = Math.Min(_blockSize, _count - block * _blockSize);
+			int position = 0;
+			for (int c = 0; c < _columns.Length; c++)
+			{
+				long[] column = _columns[c];
+				if (c < BinaryLocationLog.COLUMN_TIME_DEVICE)
+				{
+					for (int i = 0; i < rows; i++)
+					{
+						column[i] = (long)BinaryLocationLog.ReadVarint(_buffer, ref position);
+					}
+				}
+				else
+				{
+					long value = 0;
+					for (int i = 0; i < rows; i++)
+					{
+						value += BinaryLocationLog.ReadSignedVarint(_buffer, ref position);
+						column[i] = value;
+					}
+				}
+			}
+
+			for (int i = 0; i < rows; i++)
+			{
+				int flags = (int)_columns[BinaryLocationLog.COLUMN_FLAGS][i];
+				Location location = new Location();
+				location.IsLocationServiceEnabled = 0 != (flags & BinaryLocationLog.FLAG_SERVICE_ENABLED);
+				location.IsLocationServiceInitializing = 0 != (flags & BinaryLocationLog.FLAG_SERVICE_INITIALIZING);
+				location.IsLocationUpdated = 0 != (flags & BinaryLocationLog.FLAG_LOCATION_UPDATED);
+				location.IsUserHeadingUpdated = 0 != (flags & BinaryLocationLog.FLAG_USERHEADING_UPDATED);
+				location.Provider = getString(_columns[BinaryLocationLog.COLUMN_PROVIDER][i]);
+				location.ProviderClass = getString(_columns[BinaryLocationLog.COLUMN_PROVIDER_CLASS][i]);
+				location.TimestampDevice = BinaryLocationLog.FromMilliseconds(_columns[BinaryLocationLog.COLUMN_TIME_DEVICE][i]);
+				location.Timestamp = BinaryLocationLog.FromMilliseconds(_columns[BinaryLocationLog.COLUMN_TIME_LOCATION][i]);
+				location.LatitudeLongitude = new Vector2d(
+					_columns[BinaryLocationLog.COLUMN_LATITUDE][i] / BinaryLocationLog.COORDINATE_SCALE
+					, _columns[BinaryLocationLog.COLUMN_LONGITUDE][i] / BinaryLocationLog.COORDINATE_SCALE
+				);
+				location.Accuracy = _columns[BinaryLocationLog.COLUMN_ACCURACY][i] / 10f;
+				location.UserHeading = _columns[BinaryLocationLog.COLUMN_USER_HEADING][i] / 10f;
+				location.DeviceOrientation = _columns[BinaryLocationLog.COLUMN_DEVICE_ORIENTATION][i] / 10f;
+				if (0 != (flags & BinaryLocationLog.FLAG_SPEED_VALUE))
+				{
+					float speed = _columns[BinaryLocationLog.COLUMN_SPEED][i] / 10f;
+					location.SpeedMetersPerSecond = speed / 3.6f;
+				}
+				if (0 != (flags & BinaryLocationLog.FLAG_HAS_GPS_FIX_VALUE))
+				{
+					location.HasGpsFix = 0 != (flags & BinaryLocationLog.FLAG_HAS_GPS_FIX);
+				}
+				if (0 != (flags & BinaryLocationLog.FLAG_SATELLITES_USED_VALUE))
+				{
+					location.SatellitesUsed = (int)_columns[BinaryLocationLog.COLUMN_SATELLITES_USED][i];
+				}
+				if (0 != (flags & BinaryLocationLog.FLAG_SATELLITES_IN_VIEW_VALUE))
+				{
+					location.SatellitesInView = (int)_columns[BinaryLocationLog.COLUMN_SATELLITES_IN_VIEW][i];
+				}
+				_block[i] = location;
+			}
+
+			_blockIndex = block;
+		}
+
+
+		private string getString(long index)
+		{
+			if (index < 0 || index >= _strings.Length) { throw new FormatException("corrupt binary location log"); }
+			return _strings[index];
+		}
+
+
+		private void readFully(byte[] buffer, int count)
+		{
+			int read = 0;
+			while (read < count)
+			{
+				int n = _stream.Read(buffer, read, count - read);
+				if (n <= 0) { throw new FormatException("binary location log is truncated"); }
+				read += n;
+			}
+		}
+
+
+	}
+}
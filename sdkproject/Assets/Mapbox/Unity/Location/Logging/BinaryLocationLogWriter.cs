@@ -0,0 +1,261 @@
+namespace Mapbox.Unity.Location
+{
+
+
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Text;
+	using UnityEngine;
+
+
+	/// <summary>
+	/// Writes locations in the binary format of <see cref="BinaryLocationLog"/>.
+	/// Locations are buffered a block at a time, the log is only readable after <see cref="Dispose()"/> wrote index and trailer.
+	/// </summary>
+	public class BinaryLocationLogWriter : IDisposable
+	{
+
+
+		/// <summary>
+		/// Log into a new file in Application.persistentDataPath, named like the logs of <see cref="LocationLogWriter"/>.
+		/// </summary>
+		public BinaryLocationLogWriter()
+			: this(createLogFile())
+		{
+		}
+
+
+		/// <summary>
+		/// Log into <paramref name="stream"/>, which doesn't need to be seekable. The stream is closed on <see cref="Dispose()"/>.
+		/// </summary>
+		public BinaryLocationLogWriter(Stream stream)
+		{
+			if (null == stream) { throw new ArgumentNullException("stream"); }
+
+			_stream = stream;
+			_columns = new long[BinaryLocationLog.COLUMN_COUNT][];
+			for (int i = 0; i < _columns.Length; i++)
+			{
+				_columns[i] = new long[BinaryLocationLog.BLOCK_SIZE];
+			}
+			// index 0 is reserved for 'null'
+			_strings.Add(null);
+			write(BinaryLocationLog.Magic, BinaryLocationLog.Magic.Length);
+		}
+
+
+		private bool _disposed;
+		private Stream _stream;
+		private long _position;
+		private int _count;
+
+		private long[][] _columns;
+		private int _blockCount;
+		private MemoryStream _blockBuffer = new MemoryStream();
+
+		private List<string> _strings = new List<string>();
+		private Dictionary<string, int> _stringIndices = new Dictionary<string, int>();
+		private List<long> _blockOffsets = new List<long>();
+		private List<long> _blockTimestamps = new List<long>();
+
+
+		/// <summary>
+		/// Number of locations written.
+		/// </summary>
+		public int Count { get { return _count; } }
+
+
+		#region idisposable
+
+
+		~BinaryLocationLogWriter()
+		{
+			Dispose(false);
+		}
+
+
+		public void Dispose()
+		{
+			Dispose(true);
+			GC.SuppressFinalize(this);
+		}
+
+
+		protected virtual void Dispose(bool disposeManagedResources)
+		{
+			if (!_disposed)
+			{
+				if (disposeManagedResources)
+				{
+					if (null != _stream)
+					{
+						flushBlock();
+						writeTail();
+						_stream.Flush();
+#if !NETFX_CORE
+						_stream.Close();
+#endif
+						_stream.Dispose();
+						_stream = null;
+					}
+				}
+				_disposed = true;
+			}
+		}
+
+
+		#endregion
+
+
+		/// <summary>
+		/// Append <paramref name="location"/> as is: unlike <see cref="LocationLogWriter.Write"/> device time and provider class
+		/// are taken from the location, so logs can be converted without losing them.
+		/// Coordinates are rounded to 8 decimals, accuracy, heading, orientation and speed to 1, timestamps to milliseconds.
+		/// </summary>
+		public void Write(Location location)
+		{
+			if (_disposed) { throw new ObjectDisposedException("BinaryLocationLogWriter"); }
+
+			int flags = 0;
+			if (location.IsLocationServiceEnabled) { flags |= BinaryLocationLog.FLAG_SERVICE_ENABLED; }
+			if (location.IsLocationServiceInitializing) { flags |= BinaryLocationLog.FLAG_SERVICE_INITIALIZING; }
+			if (location.IsLocationUpdated) { flags |= BinaryLocationLog.FLAG_LOCATION_UPDATED; }
+			if (location.IsUserHeadingUpdated) { flags |= BinaryLocationLog.FLAG_USERHEADING_UPDATED; }
+			if (location.HasGpsFix.HasValue)
+			{
+				flags |= BinaryLocationLog.FLAG_HAS_GPS_FIX_VALUE;
+				if (location.HasGpsFix.Value) { flags |= BinaryLocationLog.FLAG_HAS_GPS_FIX; }
+			}
+			if (location.SpeedMetersPerSecond.HasValue) { flags |= BinaryLocationLog.FLAG_SPEED_VALUE; }
+			if (location.SatellitesUsed.HasValue) { flags |= BinaryLocationLog.FLAG_SATELLITES_USED_VALUE; }
+			if (location.SatellitesInView.HasValue) { flags |= BinaryLocationLog.FLAG_SATELLITES_IN_VIEW_VALUE; }
+
+			int row = _blockCount;
+			_columns[BinaryLocationLog.COLUMN_FLAGS][row] = flags;
+			_columns[BinaryLocationLog.COLUMN_PROVIDER][row] = stringIndex(location.Provider);
+			_columns[BinaryLocationLog.COLUMN_PROVIDER_CLASS][row] = stringIndex(location.ProviderClass);
+			_columns[BinaryLocationLog.COLUMN_TIME_DEVICE][row] = BinaryLocationLog.ToMilliseconds(location.TimestampDevice);
+			_columns[BinaryLocationLog.COLUMN_TIME_LOCATION][row] = BinaryLocationLog.ToMilliseconds(location.Timestamp);
+			_columns[BinaryLocationLog.COLUMN_LATITUDE][row] = (long)Math.Round(location.LatitudeLongitude.x * BinaryLocationLog.COORDINATE_SCALE);
+			_columns[BinaryLocationLog.COLUMN_LONGITUDE][row] = (long)Math.Round(location.LatitudeLongitude.y * BinaryLocationLog.COORDINATE_SCALE);
+			_columns[BinaryLocationLog.COLUMN_ACCURACY][row] = BinaryLocationLog.ToTenths(location.Accuracy);
+			_columns[BinaryLocationLog.COLUMN_USER_HEADING][row] = BinaryLocationLog.ToTenths(location.UserHeading);
+			_columns[BinaryLocationLog.COLUMN_DEVICE_ORIENTATION][row] = BinaryLocationLog.ToTenths(location.DeviceOrientation);
+			// speed is kept in km/h like text logs, so converted logs round trip exactly
+			_columns[BinaryLocationLog.COLUMN_SPEED][row] = location.SpeedKmPerHour.HasValue ? BinaryLocationLog.ToTenths(location.SpeedKmPerHour.Value) : 0;
+			_columns[BinaryLocationLog.COLUMN_SATELLITES_USED][row] = location.SatellitesUsed.HasValue ? location.SatellitesUsed.Value : 0;
+			_columns[BinaryLocationLog.COLUMN_SATELLITES_IN_VIEW][row] = location.SatellitesInView.HasValue ? location.SatellitesInView.Value : 0;
+
+			_count++;
+			_blockCount++;
+			if (_blockCount == BinaryLocationLog.BLOCK_SIZE)
+			{
+				flushBlock();
+			}
+		}
+
+
+		private static Stream createLogFile()
+		{
+			string fileName = "MBX-location-log-" + DateTime.Now.ToString("yyyyMMdd-HHmmss") + ".bytes";
+			string fullFilePathAndName = Path.Combine(Application.persistentDataPath, fileName);
+#if UNITY_EDITOR_WIN || UNITY_STANDALONE_WIN || UNITY_WSA
+			// use `GetFullPath` on that to sanitize the path: replaces `/` returned by `Application.persistentDataPath` with `\`
+			fullFilePathAndName = Path.GetFullPath(fullFilePathAndName);
+#endif
+			Debug.Log("starting new binary log file: " + fullFilePathAndName);
+			return new FileStream(fullFilePathAndName, FileMode.Create, FileAccess.Write);
+		}
+
+
+		private int stringIndex(string value)
+		{
+			if (null == value) { return 0; }
+
+			int index;
+			if (!_stringIndices.TryGetValue(value, out index))
+			{
+				index = _strings.Count;
+				_strings.Add(value);
+				_stringIndices.Add(value, index);
+			}
+			return index;
+		}
+
+
+		private void flushBlock()
+		{
+			if (_blockCount == 0) { return; }
+
+			_blockOffsets.Add(_position);
+			_blockTimestamps.Add(_columns[BinaryLocationLog.COLUMN_TIME_LOCATION][0]);
+
+			_blockBuffer.SetLength(0);
+			for (int c = 0; c < _columns.Length; c++)
+			{
+				long[] column = _columns[c];
+				bool delta = c >= BinaryLocationLog.COLUMN_TIME_DEVICE;
+				long previous = 0;
+				for (int i = 0; i < _blockCount; i++)
+				{
+					if (delta)
+					{
+						BinaryLocationLog.WriteSignedVarint(_blockBuffer, column[i] - previous);
+						previous = column[i];
+					}
+					else
+					{
+						BinaryLocationLog.WriteVarint(_blockBuffer, (ulong)column[i]);
+					}
+				}
+			}
+
+			write(_blockBuffer.GetBuffer(), (int)_blockBuffer.Length);
+			_blockCount = 0;
+		}
+
+
+		private void writeTail()
+		{
+			long stringTableOffset = _position;
+			_blockBuffer.SetLength(0);
+			// 'null' at index 0 isn't stored
+			BinaryLocationLog.WriteVarint(_blockBuffer, (ulong)(_strings.Count - 1));
+			for (int i = 1; i < _strings.Count; i++)
+			{
+				byte[] utf8 = Encoding.UTF8.GetBytes(_strings[i]);
+				BinaryLocationLog.WriteVarint(_blockBuffer, (ulong)utf8.Length);
+				_blockBuffer.Write(utf8, 0, utf8.Length);
+			}
+			write(_blockBuffer.GetBuffer(), (int)_blockBuffer.Length);
+
+			long indexOffset = _position;
+			_blockBuffer.SetLength(0);
+			var writer = new BinaryWriter(_blockBuffer);
+			for (int i = 0; i < _blockOffsets.Count; i++)
+			{
+				writer.Write(_blockOffsets[i]);
+				writer.Write(_blockTimestamps[i]);
+			}
+
+			// trailer
+			writer.Write(stringTableOffset);
+			writer.Write(indexOffset);
+			writer.Write(_count);
+			writer.Write(BinaryLocationLog.BLOCK_SIZE);
+			writer.Write(BinaryLocationLog.Magic);
+			writer.Flush();
+			write(_blockBuffer.GetBuffer(), (int)_blockBuffer.Length);
+		}
+
+
+		private void write(byte[] buffer, int count)
+		{
+			_stream.Write(buffer, 0, count);
+			_position += count;
+		}
+
+
+	}
+}
@@ -0,0 +1,30 @@
+namespace Mapbox.Unity.Location
+{
+
+
+	using System;
+	using System.Collections.Generic;
+
+
+	/// <summary>
+	/// Returns the locations of a log, see <see cref="LocationLogReader.Open"/> to pick the reader matching a log's format.
+	/// </summary>
+	public interface ILocationLogReader : IDisposable
+	{
+
+
+		/// <summary>
+		/// Returns 'Location' objects from the log. Loops through the data.
+		/// </summary>
+		IEnumerator<Location> GetLocations();
+
+
+		/// <summary>
+		/// Returns 'Location' objects from the log.
+		/// </summary>
+		/// <param name="loop">Start over at the end of the data, otherwise stop.</param>
+		IEnumerator<Location> GetLocations(bool loop);
+
+
+	}
+}
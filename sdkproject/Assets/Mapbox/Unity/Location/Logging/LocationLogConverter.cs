@@ -0,0 +1,51 @@
+namespace Mapbox.Unity.Location
+{
+
+
+	using System;
+	using System.IO;
+
+
+	/// <summary>
+	/// Upgrades text location logs to the binary format read by <see cref="BinaryLocationLogReader"/>.
+	/// Text logs already hold 8 decimals for coordinates, 1 for accuracy, heading, orientation and speed and milliseconds
+	/// for timestamps, so the binary log replays the same locations as the text log it was converted from.
+	/// </summary>
+	public static class LocationLogConverter
+	{
+
+
+		/// <summary>
+		/// Convert the text log <paramref name="textLog"/> into <paramref name="binaryLog"/>, which is closed when done.
+		/// </summary>
+		/// <returns>Number of locations converted.</returns>
+		public static int TextToBinary(byte[] textLog, Stream binaryLog)
+		{
+			if (null == textLog) { throw new ArgumentNullException("textLog"); }
+
+			using (var writer = new BinaryLocationLogWriter(binaryLog))
+			using (var reader = new LocationLogReader(textLog))
+			{
+				var locations = reader.GetLocations(false);
+				while (locations.MoveNext())
+				{
+					writer.Write(locations.Current);
+				}
+				return writer.Count;
+			}
+		}
+
+
+		/// <summary>
+		/// Convert the text log at <paramref name="textLogPath"/> into a binary log at <paramref name="binaryLogPath"/>.
+		/// </summary>
+		/// <returns>Number of locations converted.</returns>
+		public static int TextToBinary(string textLogPath, string binaryLogPath)
+		{
+			byte[] textLog = File.ReadAllBytes(textLogPath);
+			return TextToBinary(textLog, new FileStream(binaryLogPath, FileMode.Create, FileAccess.Write));
+		}
+
+
+	}
+}
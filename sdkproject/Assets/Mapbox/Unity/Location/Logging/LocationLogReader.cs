@@ -13,10 +13,23 @@
 	/// <summary>
 	/// Parses location data and returns Location objects.
 	/// </summary>
-	public class LocationLogReader : LocationLogAbstractBase, IDisposable
+	public class LocationLogReader : LocationLogAbstractBase, ILocationLogReader
 	{
 
 
+		/// <summary>
+		/// Reader for <paramref name="contents"/>: <see cref="BinaryLocationLogReader"/> for binary logs, otherwise <see cref="LocationLogReader"/>.
+		/// </summary>
+		public static ILocationLogReader Open(byte[] contents)
+		{
+			if (BinaryLocationLogReader.IsBinaryLog(contents))
+			{
+				return new BinaryLocationLogReader(contents);
+			}
+			return new LocationLogReader(contents);
+		}
+
+
 		public LocationLogReader(byte[] contents)
 		{
 			MemoryStream ms = new MemoryStream(contents);
@@ -72,6 +85,17 @@
 		/// </summary>
 		/// <returns>'Location' objects and loops through the data.</returns>
 		public IEnumerator<Location> GetLocations()
+		{
+			return GetLocations(true);
+		}
+
+
+		/// <summary>
+		/// Returns 'Location' objects from the data passed in.
+		/// </summary>
+		/// <param name="loop">Start over at the end of the data, otherwise stop.</param>
+		/// <returns>'Location' objects.</returns>
+		public IEnumerator<Location> GetLocations(bool loop)
 		{
 
 			while (true)
@@ -84,6 +108,7 @@
 					// rewind if end of log (or last empty line) reached
 					if (null == line || string.IsNullOrEmpty(line))
 					{
+						if (!loop) { yield break; }
 						((StreamReader)_textReader).BaseStream.Position = 0;
 						((StreamReader)_textReader).DiscardBufferedData();
 						continue;
@@ -22,12 +22,12 @@ namespace Mapbox.Unity.Location
 				throw new ArgumentNullException("locationLogFileContents");
 			}
 
-			_logReader = new LocationLogReader(locationLogFileContents);
+			_logReader = LocationLogReader.Open(locationLogFileContents);
 			_locationEnumerator = _logReader.GetLocations();
 		}
 
 
-		private LocationLogReader _logReader;
+		private ILocationLogReader _logReader;
 		private IEnumerator<Location> _locationEnumerator;
 		private bool _isRunning;
 		private bool _disposed;
@@ -85,7 +85,7 @@ namespace Mapbox.Unity.Location
 			get
 			{
 				if (null == _locationEnumerator) { return new MapboxLocationInfoMock(); }
-				// no need to check if 'MoveNext()' returns false as LocationLogReader loops through log file
+				// no need to check if 'MoveNext()' returns false as the log reader loops through log file
 				_locationEnumerator.MoveNext();
 				Location currentLocation = _locationEnumerator.Current;
 
@@ -36,6 +36,8 @@ namespace Mapbox.Unity.Map
 		[SerializeField] protected HashSet<UnwrappedTileId> _currentExtent;
 		[SerializeField] protected EditorPreviewOptions _previewOptions = new EditorPreviewOptions();
 		private List<UnwrappedTileId> tilesToProcess;
+		//tiles created ahead of time per extent change, more would stall the frame the map moved in
+		private const int MAX_TILES_WARMED_UP_PER_EXTENT = 4;
 
 		protected AbstractMapVisualizer _mapVisualizer;
 		protected float _unityTileSize = 1;
@@ -935,6 +937,8 @@ namespace Mapbox.Unity.Map
 					TileProvider_OnTileAdded(tileId);
 				}
 			}
+
+			_mapVisualizer.WarmUpTilePool(TileProvider.TilePoolSize, MAX_TILES_WARMED_UP_PER_EXTENT);
 		}
 
 		private void OnMapExtentChanged(object sender, ExtentArgs currentExtent)
@@ -32,6 +32,7 @@ namespace Mapbox.Unity.Map
 		protected IMapReadable _map;
 		protected Dictionary<UnwrappedTileId, UnityTile> _activeTiles = new Dictionary<UnwrappedTileId, UnityTile>();
 		protected Queue<UnityTile> _inactiveTiles = new Queue<UnityTile>();
+		private UnityTilePool _tilePool;
 		private int _counter;
 
 		private ModuleState _state;
@@ -55,6 +56,21 @@ namespace Mapbox.Unity.Map
 		public Dictionary<UnwrappedTileId, UnityTile> ActiveTiles { get { return _activeTiles; } }
 		public Dictionary<UnwrappedTileId, int> _tileProgress;
 
+		/// <summary>
+		/// Recycled tiles and how often tiles had to be created.
+		/// </summary>
+		public UnityTilePool TilePool
+		{
+			get
+			{
+				if (_tilePool == null)
+				{
+					_tilePool = new UnityTilePool(_inactiveTiles, CreateTile);
+				}
+				return _tilePool;
+			}
+		}
+
 		public event Action<ModuleState> OnMapVisualizerStateChanged = delegate { };
 		public event Action<UnityTile> OnTileFinished = delegate { };
 
@@ -135,6 +151,7 @@ namespace Mapbox.Unity.Map
 
 			_activeTiles.Clear();
 			_inactiveTiles.Clear();
+			TilePool.ResetActiveCount();
 		}
 
 		#region Factory event callbacks
@@ -224,29 +241,7 @@ namespace Mapbox.Unity.Map
 		/// <param name="tileId"></param>
 		public virtual UnityTile LoadTile(UnwrappedTileId tileId)
 		{
-			UnityTile unityTile = null;
-
-			if (_inactiveTiles.Count > 0)
-			{
-				unityTile = _inactiveTiles.Dequeue();
-			}
-
-			if (unityTile == null)
-			{
-				unityTile = new GameObject().AddComponent<UnityTile>();
-				try
-				{
-					unityTile.MeshRenderer.sharedMaterial = Instantiate(_map.TileMaterial);
-				}
-				catch
-				{
-					Debug.Log("Tile Material not set. Using default material");
-					unityTile.MeshRenderer.sharedMaterial = Instantiate(new Material(Shader.Find("Diffuse")));
-				}
-
-				unityTile.transform.SetParent(_map.Root, false);
-			}
-
+			var unityTile = TilePool.Get();
 			unityTile.Initialize(_map, tileId, _map.WorldRelativeScale, _map.AbsoluteZoom, _map.LoadingTexture);
 			PlaceTile(tileId, unityTile, _map);
 
@@ -280,7 +275,37 @@ namespace Mapbox.Unity.Map
 
 			unityTile.Recycle();
 			ActiveTiles.Remove(tileId);
-			_inactiveTiles.Enqueue(unityTile);
+			TilePool.Put(unityTile);
+		}
+
+		/// <summary>
+		/// Create recycled tiles ahead of time so the pool holds <paramref name="tileCount"/> tiles, at most
+		/// <paramref name="maxNewTiles"/> per call. Tiles loaded later reuse these instead of instantiating game objects and materials.
+		/// </summary>
+		public void WarmUpTilePool(int tileCount, int maxNewTiles)
+		{
+			if (_map == null || _map.Root == null)
+			{
+				return;
+			}
+			TilePool.WarmUp(tileCount, maxNewTiles);
+		}
+
+		protected virtual UnityTile CreateTile()
+		{
+			var unityTile = new GameObject().AddComponent<UnityTile>();
+			try
+			{
+				unityTile.MeshRenderer.sharedMaterial = Instantiate(_map.TileMaterial);
+			}
+			catch
+			{
+				Debug.Log("Tile Material not set. Using default material");
+				unityTile.MeshRenderer.sharedMaterial = Instantiate(new Material(Shader.Find("Diffuse")));
+			}
+
+			unityTile.transform.SetParent(_map.Root, false);
+			return unityTile;
 		}
 
 		/// <summary>
@@ -318,13 +343,11 @@ namespace Mapbox.Unity.Map
 				DisposeTile(tileId);
 			}
 
-			foreach (var tile in _inactiveTiles)
+			TilePool.Clear(tile =>
 			{
 				tile.ClearAssets();
 				DestroyImmediate(tile.gameObject);
-			}
-
-			_inactiveTiles.Clear();
+			});
 			State = ModuleState.Initialized;
 		}
 
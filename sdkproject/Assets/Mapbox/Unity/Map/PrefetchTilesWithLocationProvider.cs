@@ -0,0 +1,123 @@
+namespace Mapbox.Unity.Map
+{
+	using System;
+	using System.Collections;
+	using System.Collections.Generic;
+	using Mapbox.Map;
+	using Mapbox.Platform;
+	using Mapbox.Unity.Location;
+	using UnityEngine;
+
+	/// <summary>
+	/// Prefetches the tiles of all factories of <see cref="_map"/> along the path the default location provider is
+	/// heading, see <see cref="TilePrefetcher"/>. Prefetches run after all tiles the map requested.
+	/// </summary>
+	public class PrefetchTilesWithLocationProvider : MonoBehaviour
+	{
+		[SerializeField]
+		AbstractMap _map;
+
+		[SerializeField]
+		[Tooltip("Seconds ahead the path of the user is extrapolated.")]
+		float _horizonSeconds = 30f;
+
+		[SerializeField]
+		[Tooltip("Tiles prefetched around each point of the path.")]
+		int _radius = 1;
+
+		[SerializeField]
+		[Tooltip("Average download rate prefetches may use in KB/s.")]
+		int _kilobytesPerSecond = 256;
+
+		[SerializeField]
+		[Tooltip("Prefetched data that hasn't been shown yet in MB, no prefetches start above this.")]
+		int _maxMegabytes = 16;
+
+		[SerializeField]
+		[Tooltip("Log prefetch statistics every this many seconds, 0: never.")]
+		float _logIntervalSeconds = 0f;
+
+		ILocationProvider _locationProvider;
+		TilePrefetcher _prefetcher;
+		float _nextLog;
+
+		public TilePrefetcher Prefetcher { get { return _prefetcher; } }
+
+		protected virtual void Awake()
+		{
+			_prefetcher = new TilePrefetcher(RequestTile);
+		}
+
+		protected virtual IEnumerator Start()
+		{
+			yield return null;
+			_locationProvider = LocationProviderFactory.Instance.DefaultLocationProvider;
+			_locationProvider.OnLocationUpdated += LocationProvider_OnLocationUpdated;
+			_map.OnTilesStarting += Map_OnTilesStarting;
+			_map.OnTilesDisposing += Map_OnTilesDisposing;
+			_nextLog = Time.realtimeSinceStartup + _logIntervalSeconds;
+		}
+
+		protected virtual void OnDestroy()
+		{
+			if (_locationProvider != null)
+			{
+				_locationProvider.OnLocationUpdated -= LocationProvider_OnLocationUpdated;
+			}
+			if (_map != null)
+			{
+				_map.OnTilesStarting -= Map_OnTilesStarting;
+				_map.OnTilesDisposing -= Map_OnTilesDisposing;
+			}
+			_prefetcher.Clear();
+		}
+
+		void LocationProvider_OnLocationUpdated(Location location)
+		{
+			_prefetcher.Zoom = _map.AbsoluteZoom;
+			_prefetcher.HorizonSeconds = _horizonSeconds;
+			_prefetcher.Radius = _radius;
+			_prefetcher.BytesPerSecond = _kilobytesPerSecond * 1024L;
+			_prefetcher.MaxBytes = _maxMegabytes * 1024L * 1024L;
+			_prefetcher.UpdateLocation(location, Time.realtimeSinceStartup);
+
+			if (_logIntervalSeconds > 0 && Time.realtimeSinceStartup >= _nextLog)
+			{
+				_nextLog = Time.realtimeSinceStartup + _logIntervalSeconds;
+				Debug.Log("[TilePrefetcher] " + _prefetcher.Stats);
+			}
+		}
+
+		void Map_OnTilesStarting(List<UnwrappedTileId> tiles)
+		{
+			_prefetcher.TilesShown(tiles);
+		}
+
+		void Map_OnTilesDisposing(List<UnwrappedTileId> tiles)
+		{
+			_prefetcher.TilesRemoved(tiles);
+		}
+
+		void RequestTile(CanonicalTileId tileId, Action<Response> callback, List<IAsyncRequest> requests)
+		{
+			var visualizer = _map.MapVisualizer;
+			if (visualizer == null || visualizer.Factories == null)
+			{
+				return;
+			}
+
+			foreach (var factory in visualizer.Factories)
+			{
+				if (factory == null)
+				{
+					continue;
+				}
+				var request = factory.Prefetch(tileId, callback);
+				if (request != null)
+				{
+					requests.Add(request);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,440 @@
+namespace Mapbox.Unity.Map
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Map;
+	using Mapbox.Platform;
+	using Mapbox.Unity.Location;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+
+	/// <summary>
+	/// Counters of <see cref="TilePrefetcher"/>.
+	/// </summary>
+	public struct TilePrefetchStats
+	{
+		/// <summary> Tiles prefetches were started for. </summary>
+		public long Prefetched;
+		/// <summary> Tiles on the predicted path that didn't need fetching, they were cached already. </summary>
+		public long AlreadyCached;
+		/// <summary> Prefetched tiles with at least one failed request. </summary>
+		public long Failed;
+		/// <summary> Bytes downloaded by prefetches. </summary>
+		public long Bytes;
+		/// <summary> Tiles shown after their prefetch finished. </summary>
+		public long Hits;
+		/// <summary> Tiles shown while their prefetch was still running, they loaded faster but not instantly. </summary>
+		public long LateHits;
+		/// <summary> Tiles shown while moving that weren't prefetched. </summary>
+		public long Misses;
+		/// <summary> Prefetched tiles that expired without being shown. </summary>
+		public long Wasted;
+
+		/// <summary> Share of tiles shown while moving that were prefetched in time. </summary>
+		public double HitRate
+		{
+			get
+			{
+				var shown = Hits + LateHits + Misses;
+				return shown == 0 ? 0 : (double)Hits / shown;
+			}
+		}
+
+		/// <summary> Share of prefetched tiles that were shown eventually. </summary>
+		public double Precision
+		{
+			get
+			{
+				var resolved = Hits + LateHits + Wasted;
+				return resolved == 0 ? 0 : (double)(Hits + LateHits) / resolved;
+			}
+		}
+
+		public override string ToString()
+		{
+			return string.Format(
+				"Prefetched: {0} ({1} KB, {2} failed), already cached: {3}, hits: {4}, late: {5}, misses: {6}, wasted: {7}, hit rate: {8:P0}, precision: {9:P0}"
+				, Prefetched
+				, Bytes / 1024
+				, Failed
+				, AlreadyCached
+				, Hits
+				, LateHits
+				, Misses
+				, Wasted
+				, HitRate
+				, Precision
+			);
+		}
+	}
+
+	/// <summary>
+	/// Fetches tiles along the path the user is predicted to take into the cache before the map asks for them.
+	/// Heading and speed come from a <see cref="LocationMotionEstimator"/>, the path is extrapolated
+	/// <see cref="HorizonSeconds"/> ahead and tiles are requested in the order they are expected to come into view,
+	/// within a bandwidth (<see cref="BytesPerSecond"/>) and memory (<see cref="MaxBytes"/>) budget.
+	/// Tiles the map shows are reported back with <see cref="TilesShown"/> to measure the hit rate.
+	/// Time is passed in by the caller so logs can be replayed faster than real time. Main thread only,
+	/// request callbacks may come from any thread.
+	/// </summary>
+	public class TilePrefetcher
+	{
+		/// <summary>
+		/// Starts the prefetch requests of a tile, one per data source, and adds them to <paramref name="requests"/>.
+		/// <paramref name="callback"/> has to be called once per added request. Add nothing if the tile is cached already.
+		/// </summary>
+		public delegate void RequestTile(CanonicalTileId tileId, Action<Response> callback, List<IAsyncRequest> requests);
+
+		//bandwidth that may be spent at once after being idle
+		private const double BURST_SECONDS = 2d;
+		private const int MAX_PATH_SAMPLES = 64;
+		//size assumed for a tile until the first responses came in
+		private const long DEFAULT_TILE_BYTES = 32 * 1024;
+
+		private class Entry
+		{
+			public CanonicalTileId TileId;
+			public double RequestedAt;
+			//null while the requests are being started
+			public List<IAsyncRequest> Requests;
+			public int Completed;
+			public bool Cached;
+			public bool Failed;
+			public long Bytes;
+			public long ReservedBytes;
+
+			public bool Loading
+			{
+				get { return Requests == null || Completed < Requests.Count; }
+			}
+		}
+
+		/// <summary> Zoom level of the tiles the map shows. </summary>
+		public int Zoom = 16;
+		/// <summary> Seconds ahead the path is extrapolated. </summary>
+		public double HorizonSeconds = 30d;
+		/// <summary> Tiles around each point of the path, 1 covers a 3x3 block like a small view. </summary>
+		public int Radius = 1;
+		/// <summary> Tiles being prefetched at the same time. </summary>
+		public int MaxInFlight = 4;
+		/// <summary> Average download rate prefetches may use. </summary>
+		public long BytesPerSecond = 256 * 1024;
+		/// <summary> Prefetched data waiting to be shown, no new prefetches start above this. </summary>
+		public long MaxBytes = 16 * 1024 * 1024;
+		/// <summary> Below this speed the user is treated as standing still and nothing is prefetched. </summary>
+		public double MinSpeedMetersPerSecond = 0.5d;
+		/// <summary> Prefetched tiles not shown within this many seconds count as wasted and are forgotten. </summary>
+		public double ExpirySeconds = 90d;
+
+		private readonly object _lock = new object();
+		private readonly RequestTile _requestTile;
+		private readonly LocationMotionEstimator _motion;
+		private readonly Dictionary<CanonicalTileId, Entry> _entries = new Dictionary<CanonicalTileId, Entry>();
+		private readonly HashSet<CanonicalTileId> _visible = new HashSet<CanonicalTileId>();
+		private readonly HashSet<CanonicalTileId> _planned = new HashSet<CanonicalTileId>();
+		private readonly List<CanonicalTileId> _plan = new List<CanonicalTileId>();
+		private readonly List<Entry> _expired = new List<Entry>();
+		private TilePrefetchStats _stats;
+		private int _inFlight;
+		private long _heldBytes;
+		private long _fetchedTiles;
+		private long _fetchedBytes;
+		private double _budget;
+		private double _lastUpdate = double.NaN;
+
+		public TilePrefetcher(RequestTile requestTile, LocationMotionEstimator motion = null)
+		{
+			if (requestTile == null) { throw new ArgumentNullException("requestTile"); }
+			_requestTile = requestTile;
+			_motion = motion ?? new LocationMotionEstimator();
+		}
+
+		public LocationMotionEstimator Motion { get { return _motion; } }
+
+		public TilePrefetchStats Stats { get { lock (_lock) { return _stats; } } }
+
+		/// <summary> Tiles with prefetches still running. </summary>
+		public int InFlight { get { lock (_lock) { return _inFlight; } } }
+
+		/// <summary> Prefetched bytes, reserved or downloaded, that haven't been shown yet. </summary>
+		public long HeldBytes { get { lock (_lock) { return _heldBytes; } } }
+
+		/// <summary> Feed a location update and start prefetches, <paramref name="now"/> is in seconds. </summary>
+		public void UpdateLocation(Location location, double now)
+		{
+			_motion.Add(location);
+			Update(now);
+		}
+
+		/// <summary> Refill the budget, expire old prefetches and start new ones, <paramref name="now"/> is in seconds. </summary>
+		public void Update(double now)
+		{
+			lock (_lock)
+			{
+				var elapsed = double.IsNaN(_lastUpdate) ? BURST_SECONDS : Math.Max(0, now - _lastUpdate);
+				_budget = Math.Min(BytesPerSecond * BURST_SECONDS, _budget + elapsed * BytesPerSecond);
+				_lastUpdate = now;
+				expire(now);
+			}
+
+			if (!IsMoving)
+			{
+				return;
+			}
+
+			plan();
+			for (int i = 0; i < _plan.Count; i++)
+			{
+				long reserve;
+				lock (_lock)
+				{
+					if (_inFlight >= MaxInFlight || _budget <= 0 || _heldBytes >= MaxBytes)
+					{
+						break;
+					}
+					if (_entries.ContainsKey(_plan[i]))
+					{
+						continue;
+					}
+					reserve = _fetchedTiles == 0 ? DEFAULT_TILE_BYTES : _fetchedBytes / _fetchedTiles;
+				}
+				start(_plan[i], reserve, now);
+			}
+		}
+
+		/// <summary> Moving fast enough to prefetch. </summary>
+		public bool IsMoving
+		{
+			get { return _motion.HasVelocity && _motion.SpeedMetersPerSecond >= MinSpeedMetersPerSecond; }
+		}
+
+		/// <summary> Tiles the map started to show, prefetched ones count as hits. </summary>
+		public void TilesShown(IEnumerable<UnwrappedTileId> tiles)
+		{
+			var moving = IsMoving;
+			lock (_lock)
+			{
+				foreach (var tile in tiles)
+				{
+					var tileId = tile.Canonical;
+					_visible.Add(tileId);
+
+					Entry entry;
+					if (_entries.TryGetValue(tileId, out entry))
+					{
+						if (entry.Cached)
+						{
+							//neither a hit nor a miss of the prefetcher
+						}
+						else if (entry.Loading)
+						{
+							_stats.LateHits++;
+						}
+						else if (entry.Failed)
+						{
+							_stats.Misses++;
+						}
+						else
+						{
+							_stats.Hits++;
+						}
+						release(entry, false);
+					}
+					else if (moving && tileId.Z == Zoom)
+					{
+						_stats.Misses++;
+					}
+				}
+			}
+		}
+
+		/// <summary> Tiles the map removed. </summary>
+		public void TilesRemoved(IEnumerable<UnwrappedTileId> tiles)
+		{
+			lock (_lock)
+			{
+				foreach (var tile in tiles)
+				{
+					_visible.Remove(tile.Canonical);
+				}
+			}
+		}
+
+		/// <summary> Cancel all prefetches and forget the visible tiles, the statistics are kept. </summary>
+		public void Clear()
+		{
+			lock (_lock)
+			{
+				foreach (var entry in new List<Entry>(_entries.Values))
+				{
+					release(entry, true);
+				}
+				_visible.Clear();
+			}
+		}
+
+		// tiles along the predicted path ordered by when they are expected to come into view
+		private void plan()
+		{
+			_plan.Clear();
+			_planned.Clear();
+
+			var zoom = Zoom;
+			var tileMeters = 2 * Utils.Constants.WebMercMax / (1 << zoom);
+			var speed = _motion.Velocity.magnitude;
+			// a sample every half tile
+			var step = Math.Max(tileMeters * 0.5d / speed, HorizonSeconds / MAX_PATH_SAMPLES);
+			var tileCount = 1 << zoom;
+
+			lock (_lock)
+			{
+				for (double t = step; t <= HorizonSeconds; t += step)
+				{
+					var position = _motion.Predict(t);
+					var latLng = Conversions.MetersToLatLon(position);
+					var center = Conversions.LatitudeLongitudeToTileId(latLng.x, latLng.y, zoom);
+					// the tile on the path first, then the rings around it
+					for (int ring = 0; ring <= Radius; ring++)
+					{
+						for (int dy = -ring; dy <= ring; dy++)
+						{
+							var y = center.Y + dy;
+							if (y < 0 || y >= tileCount) { continue; }
+							for (int dx = -ring; dx <= ring; dx++)
+							{
+								if (Math.Max(Math.Abs(dx), Math.Abs(dy)) != ring) { continue; }
+								var tileId = new CanonicalTileId(zoom, ((center.X + dx) % tileCount + tileCount) % tileCount, y);
+								if (_visible.Contains(tileId) || !_planned.Add(tileId)) { continue; }
+								_plan.Add(tileId);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		private void start(CanonicalTileId tileId, long reserve, double now)
+		{
+			var entry = new Entry() { TileId = tileId, RequestedAt = now };
+			lock (_lock)
+			{
+				_entries.Add(tileId, entry);
+				_inFlight++;
+			}
+
+			var requests = new List<IAsyncRequest>();
+			_requestTile(tileId, (Response response) => onResponse(entry, response), requests);
+
+			lock (_lock)
+			{
+				entry.Requests = requests;
+				if (requests.Count == 0)
+				{
+					//kept so it isn't requested again
+					_stats.AlreadyCached++;
+					entry.Cached = true;
+					_inFlight--;
+					return;
+				}
+
+				_stats.Prefetched++;
+				entry.ReservedBytes = reserve * requests.Count;
+				_budget -= entry.ReservedBytes;
+				_heldBytes += entry.ReservedBytes;
+				//callbacks may have run already
+				if (!entry.Loading)
+				{
+					finish(entry);
+				}
+			}
+		}
+
+		private void onResponse(Entry entry, Response response)
+		{
+			lock (_lock)
+			{
+				entry.Completed++;
+				if (response.HasError || response.Data == null)
+				{
+					entry.Failed = true;
+				}
+				else
+				{
+					entry.Bytes += response.Data.Length;
+					_stats.Bytes += response.Data.Length;
+					_fetchedBytes += response.Data.Length;
+					_fetchedTiles++;
+				}
+
+				if (entry.Requests != null && entry.Completed == entry.Requests.Count)
+				{
+					finish(entry);
+				}
+			}
+		}
+
+		// call with lock held, all requests of the entry called back
+		private void finish(Entry entry)
+		{
+			if (entry.Failed)
+			{
+				_stats.Failed++;
+			}
+
+			// the reservation becomes the real size
+			var correction = entry.Bytes - entry.ReservedBytes;
+			_budget -= correction;
+
+			Entry registered;
+			if (_entries.TryGetValue(entry.TileId, out registered) && registered == entry)
+			{
+				_inFlight--;
+				_heldBytes += correction;
+				entry.ReservedBytes = entry.Bytes;
+			}
+		}
+
+		// call with lock held
+		private void expire(double now)
+		{
+			_expired.Clear();
+			foreach (var entry in _entries.Values)
+			{
+				if (now - entry.RequestedAt > ExpirySeconds)
+				{
+					_expired.Add(entry);
+				}
+			}
+			foreach (var entry in _expired)
+			{
+				if (!entry.Cached)
+				{
+					_stats.Wasted++;
+				}
+				release(entry, true);
+			}
+		}
+
+		// call with lock held, forget about a tile. Its requests keep running unless canceled, their
+		// callbacks only count the bytes against the bandwidth budget then
+		private void release(Entry entry, bool cancelRequests)
+		{
+			_entries.Remove(entry.TileId);
+			_heldBytes -= entry.ReservedBytes;
+			if (!entry.Cached && entry.Loading)
+			{
+				_inFlight--;
+				if (cancelRequests && entry.Requests != null)
+				{
+					foreach (var request in entry.Requests)
+					{
+						if (!request.IsCompleted)
+						{
+							request.Cancel();
+						}
+					}
+				}
+			}
+		}
+	}
+}
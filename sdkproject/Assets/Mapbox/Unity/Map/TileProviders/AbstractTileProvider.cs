@@ -42,6 +42,22 @@ namespace Mapbox.Unity.Map.TileProviders
 			}
 		}
 
+		/// <summary>
+		/// Tiles closer to <paramref name="focus"/> are requested first.
+		/// </summary>
+		protected void SetRequestFocus(UnwrappedTileId focus)
+		{
+			MapboxAccess.Instance.SetTileRequestFocus(focus.Canonical);
+		}
+
+		/// <summary>
+		/// Number of tiles the map should keep, shown or pooled, so moving to the next extent doesn't instantiate tiles.
+		/// </summary>
+		public virtual int TilePoolSize
+		{
+			get { return _currentExtent.activeTiles == null ? 0 : _currentExtent.activeTiles.Count; }
+		}
+
 		public abstract void OnInitialized();
 		public abstract void UpdateTileExtent();
 
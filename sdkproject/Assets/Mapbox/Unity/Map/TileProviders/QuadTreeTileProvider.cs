@@ -28,8 +28,18 @@ namespace Mapbox.Unity.Map.TileProviders
 		private Vector3[] _hitPnt = new Vector3[HIT_POINTS_COUNT];
 		private Vector2d[] _hitPntGeoPos = new Vector2d[HIT_POINTS_COUNT];
 		private bool _isFirstLoad;
+		private int _extentColumns;
+		private int _extentRows;
 		#endregion
 
+		/// <summary>
+		/// Panning by up to a tile in each direction brings in one more column and row.
+		/// </summary>
+		public override int TilePoolSize
+		{
+			get { return (_extentColumns + 1) * (_extentRows + 1); }
+		}
+
 		public override void OnInitialized()
 		{
 			_tiles = new HashSet<UnwrappedTileId>();
@@ -63,6 +73,10 @@ namespace Mapbox.Unity.Map.TileProviders
 			//update viewport in case it was changed by switching zoom level
 			_viewPortWebMercBounds = getcurrentViewPortWebMerc();
 			_currentExtent.activeTiles = GetWithWebMerc(_viewPortWebMercBounds, _map.AbsoluteZoom);
+			if (!_viewPortWebMercBounds.IsEmpty())
+			{
+				SetRequestFocus(WebMercatorToTileId(_viewPortWebMercBounds.Center, _map.AbsoluteZoom));
+			}
 
 			OnExtentChanged();
 		}
@@ -71,6 +85,8 @@ namespace Mapbox.Unity.Map.TileProviders
 		{
 			_tiles.Clear();
 			_canonicalTiles.Clear();
+			_extentColumns = 0;
+			_extentRows = 0;
 
 			if (bounds.IsEmpty()) { return _tiles; }
 
@@ -80,6 +96,8 @@ namespace Mapbox.Unity.Map.TileProviders
 
 			UnwrappedTileId swTile = WebMercatorToTileId(swWebMerc, zoom);
 			UnwrappedTileId neTile = WebMercatorToTileId(neWebMerc, zoom);
+			_extentColumns = Math.Max(0, neTile.X - swTile.X + 1);
+			_extentRows = Math.Max(0, swTile.Y - neTile.Y + 1);
 
 			for (int x = swTile.X; x <= neTile.X; x++)
 			{
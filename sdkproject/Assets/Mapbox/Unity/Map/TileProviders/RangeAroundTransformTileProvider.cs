@@ -43,6 +43,7 @@ namespace Mapbox.Unity.Map.TileProviders
 
 			_currentExtent.activeTiles.Clear();
 			_currentTile = TileCover.CoordinateToTileId(_map.WorldToGeoPosition(_rangeTileProviderOptions.targetTransform.localPosition), _map.AbsoluteZoom);
+			SetRequestFocus(_currentTile);
 
 			for (int x = _currentTile.X - _rangeTileProviderOptions.visibleBuffer; x <= (_currentTile.X + _rangeTileProviderOptions.visibleBuffer); x++)
 			{
@@ -0,0 +1,135 @@
+namespace Mapbox.Unity.Map
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Unity.MeshGeneration.Data;
+
+	/// <summary>
+	/// Recycled <see cref="UnityTile"/>s of a map visualizer. Pooled tiles keep their game object, mesh, material, collider
+	/// and textures, recycling only resets their state, so panning the map reuses tiles instead of instantiating new ones.
+	/// The pool is warmed up to the number of tiles the tile provider expects to show and reports how often tiles had to be
+	/// created or could be reused.
+	/// </summary>
+	public class UnityTilePool
+	{
+		private readonly Queue<UnityTile> _inactive;
+		private readonly Func<UnityTile> _create;
+		private int _active;
+
+		/// <param name="inactive">Queue pooled tiles are kept in.</param>
+		/// <param name="create">Creates a new tile when the pool is empty.</param>
+		public UnityTilePool(Queue<UnityTile> inactive, Func<UnityTile> create)
+		{
+			if (inactive == null) { throw new ArgumentNullException("inactive"); }
+			if (create == null) { throw new ArgumentNullException("create"); }
+			_inactive = inactive;
+			_create = create;
+		}
+
+		/// <summary> Tiles handed out and not returned yet. </summary>
+		public int ActiveCount { get { return _active; } }
+		/// <summary> Recycled tiles waiting to be reused. </summary>
+		public int InactiveCount { get { return _inactive.Count; } }
+		/// <summary> Highest number of tiles handed out at the same time. </summary>
+		public int PeakActiveCount { get; private set; }
+		/// <summary> Tiles instantiated by <see cref="Get"/> because the pool was empty. </summary>
+		public int CreatedCount { get; private set; }
+		/// <summary> Tiles instantiated ahead of time by <see cref="WarmUp"/>. </summary>
+		public int WarmedUpCount { get; private set; }
+		/// <summary> Tiles <see cref="Get"/> took from the pool. </summary>
+		public int ReusedCount { get; private set; }
+		/// <summary> Tiles destroyed by <see cref="Clear"/>. </summary>
+		public int DestroyedCount { get; private set; }
+
+		/// <summary>
+		/// A recycled tile or a new one if the pool is empty. Tiles destroyed by a scene change are skipped.
+		/// </summary>
+		public UnityTile Get()
+		{
+			UnityTile tile = null;
+			while (tile == null && _inactive.Count > 0)
+			{
+				tile = _inactive.Dequeue();
+			}
+
+			if (tile == null)
+			{
+				tile = _create();
+				CreatedCount++;
+			}
+			else
+			{
+				ReusedCount++;
+			}
+
+			_active++;
+			if (_active > PeakActiveCount)
+			{
+				PeakActiveCount = _active;
+			}
+			return tile;
+		}
+
+		/// <summary> Return a tile, it should be recycled already. </summary>
+		public void Put(UnityTile tile)
+		{
+			_active = Math.Max(0, _active - 1);
+			_inactive.Enqueue(tile);
+		}
+
+		/// <summary>
+		/// Create recycled tiles until <paramref name="tileCount"/> tiles, active and pooled, exist.
+		/// At most <paramref name="maxNewTiles"/> are created per call to spread the cost over several frames.
+		/// </summary>
+		/// <returns>Number of tiles created.</returns>
+		public int WarmUp(int tileCount, int maxNewTiles)
+		{
+			var created = 0;
+			while (_active + _inactive.Count < tileCount && created < maxNewTiles)
+			{
+				var tile = _create();
+				tile.Recycle();
+				_inactive.Enqueue(tile);
+				created++;
+			}
+			WarmedUpCount += created;
+			return created;
+		}
+
+		/// <summary>
+		/// Destroy pooled tiles with <paramref name="destroy"/>, active tiles are left to their owner.
+		/// </summary>
+		public void Clear(Action<UnityTile> destroy)
+		{
+			while (_inactive.Count > 0)
+			{
+				var tile = _inactive.Dequeue();
+				if (tile != null && destroy != null)
+				{
+					destroy(tile);
+					DestroyedCount++;
+				}
+			}
+		}
+
+		/// <summary> Forget about handed out tiles, eg after the map was reset and they were destroyed with the scene. </summary>
+		public void ResetActiveCount()
+		{
+			_active = 0;
+		}
+
+		public override string ToString()
+		{
+			return string.Format(
+				"Tiles active: {0} (peak {1}), pooled: {2}, created: {3}, warmed up: {4}, reused: {5}, destroyed: {6}"
+				, _active
+				, PeakActiveCount
+				, _inactive.Count
+				, CreatedCount
+				, WarmedUpCount
+				, ReusedCount
+				, DestroyedCount
+			);
+		}
+	}
+}
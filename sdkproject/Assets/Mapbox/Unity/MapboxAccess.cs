@@ -23,6 +23,7 @@ namespace Mapbox.Unity
 	{
 		ITelemetryLibrary _telemetryLibrary;
 		CachingWebFileSource _fileSource;
+		TilePackCache _tilePacks;
 
 		public delegate void TokenValidationEvent(MapboxTokenStatus response);
 		public event TokenValidationEvent OnTokenValidation;
@@ -167,15 +168,41 @@ namespace Mapbox.Unity
 
 		void ConfigureFileSource()
 		{
-			_fileSource = new CachingWebFileSource(_configuration.AccessToken, _configuration.GetMapsSkuToken, _configuration.AutoRefreshCache)
-				.AddCache(new MemoryCache(_configuration.MemoryCacheSize))
+			IAsyncRequestFactory.UseHttpPipeline = _configuration.UseHttpPipeline;
+			_fileSource = new CachingWebFileSource(_configuration.AccessToken, _configuration.GetMapsSkuToken, _configuration.AutoRefreshCache, _configuration.MaxConcurrentTileRequests)
+				.AddCache(new TileMemoryCache(_configuration.MemoryCacheSize, (long)_configuration.MemoryCacheMegabytes * 1024 * 1024))
 #if !UNITY_WEBGL
-				.AddCache(new SQLiteCache(_configuration.FileCacheSize))
+				.AddCache(CreateTilePackCache())
+				.AddCache(CreateFileCache())
 #endif
 				;
 		}
 
 
+#if !UNITY_WEBGL
+		TilePackCache CreateTilePackCache()
+		{
+			_tilePacks = new TilePackCache();
+			_tilePacks.OpenDirectory(TilePackDirectory);
+#if !UNITY_ANDROID
+			// packs in StreamingAssets are inside the apk on Android, copy them to 'TilePackDirectory' instead
+			_tilePacks.OpenDirectory(Path.Combine(Application.streamingAssetsPath, "tilepacks"));
+#endif
+			return _tilePacks;
+		}
+
+
+		ICache CreateFileCache()
+		{
+			if (_configuration.ShardedFileCache)
+			{
+				return new SQLiteShardedCache(_configuration.FileCacheSize);
+			}
+			return new SQLiteCache(_configuration.FileCacheSize);
+		}
+#endif
+
+
 		void ConfigureTelemetry()
 		{
 			// TODO: enable after token validation has been made async
@@ -235,6 +262,59 @@ namespace Mapbox.Unity
 		}
 
 
+		/// <summary>
+		/// Fetch a tile into the cache ahead of time, after all tiles that have been requested for display.
+		/// </summary>
+		/// <returns>Null if the tile is cached already.</returns>
+		public IAsyncRequest Prefetch(string url, Action<Response> callback, CanonicalTileId tileId, string tilesetId)
+		{
+			return _fileSource.Prefetch(url, callback, _configuration.DefaultTimeout, tileId, tilesetId);
+		}
+
+
+		/// <summary>
+		/// Tile the viewer is looking at, tiles closer to it are requested first.
+		/// </summary>
+		public void SetTileRequestFocus(CanonicalTileId focus)
+		{
+			if (null != _fileSource)
+			{
+				_fileSource.SetRequestFocus(focus);
+			}
+		}
+
+
+		/// <summary>
+		/// Directory tile packs are opened from on startup, in addition to 'StreamingAssets/tilepacks'.
+		/// </summary>
+		public static string TilePackDirectory
+		{
+			get { return Path.Combine(Application.persistentDataPath, "tilepacks"); }
+		}
+
+
+		/// <summary>
+		/// Offline tile packs, looked up after the memory cache and before the file cache. Open more with <see cref="TilePackCache.Open"/>.
+		/// Null on WebGL.
+		/// </summary>
+		public TilePackCache TilePacks
+		{
+			get { return _tilePacks; }
+		}
+
+
+		/// <summary>
+		/// Scheduler of the tile requests, exposes per priority queue depth and latency statistics.
+		/// </summary>
+		public TileRequestScheduler TileRequestScheduler
+		{
+			get
+			{
+				return null == _fileSource ? null : _fileSource.Scheduler;
+			}
+		}
+
+
 		Geocoder _geocoder;
 		/// <summary>
 		/// Lazy geocoder.
@@ -333,9 +413,17 @@ namespace Mapbox.Unity
 
 		public string AccessToken;
 		public uint MemoryCacheSize = 500;
+		/// <summary>Memory cache budget in megabytes, 0: only limited by 'MemoryCacheSize'.</summary>
+		public uint MemoryCacheMegabytes = 128;
 		public uint FileCacheSize = 2500;
 		public int DefaultTimeout = 30;
 		public bool AutoRefreshCache = false;
+		/// <summary>Use one WAL mode database per tileset with a background writer instead of the single 'cache.db'.</summary>
+		public bool ShardedFileCache = false;
+		/// <summary>Maximum number of tiles fetched from the web at the same time, 0: unbounded.</summary>
+		public int MaxConcurrentTileRequests = 16;
+		/// <summary>Send web requests over pooled, pipelined keep-alive connections on one I/O thread instead of UnityWebRequest. Not available on WebGL and UWP.</summary>
+		public bool UseHttpPipeline = false;
 
 		public string GetMapsSkuToken()
 		{
@@ -15,5 +15,17 @@
 
 		}
 
+		/// <summary> Add a feature of <paramref name="tile"/>, collections that track tiles override this and <see cref="RemoveTile"/>. </summary>
+		public virtual void AddFeature(double[] position, VectorEntity ve, UnityTile tile)
+		{
+			AddFeature(position, ve);
+		}
+
+		/// <summary> Called when <paramref name="tile"/> unloads, its features are pooled right after. </summary>
+		public virtual void RemoveTile(UnityTile tile)
+		{
+
+		}
+
 	}
 }
\ No newline at end of file
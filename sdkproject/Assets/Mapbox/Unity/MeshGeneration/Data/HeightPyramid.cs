@@ -0,0 +1,302 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System;
+	using UnityEngine;
+
+	/// <summary>
+	/// Min/max mip chain over the square height grid of a tile (<see cref="UnityTile.HeightData"/>).
+	/// Level 0 is the grid itself, every level above halves the resolution and keeps the lowest and highest sample
+	/// of the cells below. Height ranges and ray intersections descend only into cells that can contain the answer
+	/// instead of scanning the grid. Samples are addressed like the grid: column x, row y, index y * size + x.
+	/// </summary>
+	public class HeightPyramid
+	{
+		private float[] _heights;
+		private int _size;
+		//levels 1 and up, index 0 is unused
+		private float[][] _min;
+		private float[][] _max;
+		private int[] _levelSize;
+
+		/// <summary> Samples per side of the grid. </summary>
+		public int Size
+		{
+			get { return _size; }
+		}
+
+		/// <summary> Number of levels including the grid itself, the top level is a single cell. </summary>
+		public int LevelCount
+		{
+			get { return _levelSize == null ? 0 : _levelSize.Length; }
+		}
+
+		public float MinHeight
+		{
+			get { return cellMin(LevelCount - 1, 0, 0); }
+		}
+
+		public float MaxHeight
+		{
+			get { return cellMax(LevelCount - 1, 0, 0); }
+		}
+
+		/// <summary> True if all samples have the same height, eg flat or sea level tiles. </summary>
+		public bool IsFlat
+		{
+			get { return MinHeight == MaxHeight; }
+		}
+
+		/// <summary>
+		/// Build the levels above <paramref name="heights"/>. Buffers are reused as long as the size doesn't change.
+		/// The grid is referenced, not copied.
+		/// </summary>
+		public void Build(float[] heights, int size)
+		{
+			if (heights == null || size <= 0 || heights.Length < size * size)
+			{
+				throw new ArgumentException("height grid is smaller than size * size");
+			}
+
+			if (size != _size || _levelSize == null)
+			{
+				allocate(size);
+			}
+			_heights = heights;
+
+			for (int level = 1; level < _levelSize.Length; level++)
+			{
+				var levelSize = _levelSize[level];
+				var childSize = _levelSize[level - 1];
+				var min = _min[level];
+				var max = _max[level];
+				for (int y = 0; y < levelSize; y++)
+				{
+					var y0 = y * 2;
+					var y1 = Math.Min(y0 + 1, childSize - 1);
+					for (int x = 0; x < levelSize; x++)
+					{
+						var x0 = x * 2;
+						var x1 = Math.Min(x0 + 1, childSize - 1);
+						var lo = Math.Min(Math.Min(cellMin(level - 1, x0, y0), cellMin(level - 1, x1, y0)), Math.Min(cellMin(level - 1, x0, y1), cellMin(level - 1, x1, y1)));
+						var hi = Math.Max(Math.Max(cellMax(level - 1, x0, y0), cellMax(level - 1, x1, y0)), Math.Max(cellMax(level - 1, x0, y1), cellMax(level - 1, x1, y1)));
+						min[y * levelSize + x] = lo;
+						max[y * levelSize + x] = hi;
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Point the pyramid at an identical copy of the grid it was built from.
+		/// </summary>
+		internal void SetHeights(float[] heights)
+		{
+			_heights = heights;
+		}
+
+		/// <summary>
+		/// Lowest and highest sample between two corners in [0-1] range, mapped to samples like <see cref="UnityTile.QueryHeightData"/>.
+		/// </summary>
+		public void GetRange(float x0, float y0, float x1, float y1, out float min, out float max)
+		{
+			var last = _size - 1;
+			GetRange(
+				(int)(Mathf.Clamp01(Math.Min(x0, x1)) * last),
+				(int)(Mathf.Clamp01(Math.Min(y0, y1)) * last),
+				(int)(Mathf.Clamp01(Math.Max(x0, x1)) * last),
+				(int)(Mathf.Clamp01(Math.Max(y0, y1)) * last),
+				out min, out max);
+		}
+
+		/// <summary>
+		/// Lowest and highest sample in the inclusive range of columns <paramref name="col0"/>..<paramref name="col1"/>
+		/// and rows <paramref name="row0"/>..<paramref name="row1"/>.
+		/// </summary>
+		public void GetRange(int col0, int row0, int col1, int row1, out float min, out float max)
+		{
+			min = float.MaxValue;
+			max = float.MinValue;
+			col0 = Math.Max(col0, 0);
+			row0 = Math.Max(row0, 0);
+			col1 = Math.Min(col1, _size - 1);
+			row1 = Math.Min(row1, _size - 1);
+			if (col0 > col1 || row0 > row1)
+			{
+				return;
+			}
+			range(LevelCount - 1, 0, 0, col0, row0, col1, row1, ref min, ref max);
+		}
+
+		/// <summary>
+		/// Intersect a ray with the height field, in grid space: x is the column, z the row and y the height.
+		/// Sample (x, y) is a column of its height over the cell [x, x + 1) * [y, y + 1).
+		/// </summary>
+		/// <param name="direction">Doesn't need to be normalized, <paramref name="distance"/> is in multiples of it.</param>
+		/// <returns>True if the ray hits the height field at or after <paramref name="origin"/>.</returns>
+		public bool Raycast(Vector3 origin, Vector3 direction, out float distance)
+		{
+			distance = 0;
+			if (LevelCount == 0)
+			{
+				return false;
+			}
+
+			// clip to the grid on x and z
+			float tEnter = 0;
+			float tExit = float.MaxValue;
+			if (!clip(origin.x, direction.x, _size, ref tEnter, ref tExit) || !clip(origin.z, direction.z, _size, ref tEnter, ref tExit))
+			{
+				return false;
+			}
+			if (tExit == float.MaxValue)
+			{
+				// vertical ray
+				tExit = direction.y != 0 ? Math.Abs((origin.y - MinHeight) / direction.y) + 1 : 1;
+			}
+
+			return intersect(LevelCount - 1, 0, 0, origin, direction, tEnter, tExit, out distance);
+		}
+
+		private bool intersect(int level, int cx, int cy, Vector3 o, Vector3 d, float tEnter, float tExit, out float distance)
+		{
+			distance = 0;
+			var yEnter = o.y + d.y * tEnter;
+			var yExit = o.y + d.y * tExit;
+			var top = cellMax(level, cx, cy);
+			if (Math.Min(yEnter, yExit) > top)
+			{
+				return false;
+			}
+
+			if (level == 0)
+			{
+				if (yEnter <= top)
+				{
+					distance = tEnter;
+					return true;
+				}
+				distance = (top - o.y) / d.y;
+				return true;
+			}
+
+			// split at the children's boundaries and visit them along the ray
+			var half = 1 << (level - 1);
+			var splitX = (cx * 2 + 1) * half;
+			var splitZ = (cy * 2 + 1) * half;
+			var t1 = d.x != 0 ? (splitX - o.x) / d.x : float.MaxValue;
+			var t2 = d.z != 0 ? (splitZ - o.z) / d.z : float.MaxValue;
+			if (t1 > t2)
+			{
+				var swap = t1;
+				t1 = t2;
+				t2 = swap;
+			}
+
+			var start = tEnter;
+			for (int i = 0; i < 3; i++)
+			{
+				var end = i == 0 ? t1 : i == 1 ? t2 : tExit;
+				if (end <= start)
+				{
+					continue;
+				}
+				end = Math.Min(end, tExit);
+
+				var mid = (start + end) * 0.5f;
+				var childX = cx * 2 + ((o.x + d.x * mid) >= splitX ? 1 : 0);
+				var childY = cy * 2 + ((o.z + d.z * mid) >= splitZ ? 1 : 0);
+				if (childX < _levelSize[level - 1] && childY < _levelSize[level - 1]
+					&& intersect(level - 1, childX, childY, o, d, start, end, out distance))
+				{
+					return true;
+				}
+
+				start = end;
+				if (start >= tExit)
+				{
+					break;
+				}
+			}
+			return false;
+		}
+
+		private void range(int level, int cx, int cy, int col0, int row0, int col1, int row1, ref float min, ref float max)
+		{
+			var x0 = cx << level;
+			var y0 = cy << level;
+			var x1 = Math.Min(((cx + 1) << level) - 1, _size - 1);
+			var y1 = Math.Min(((cy + 1) << level) - 1, _size - 1);
+			if (x1 < col0 || x0 > col1 || y1 < row0 || y0 > row1)
+			{
+				return;
+			}
+
+			if (level == 0 || (x0 >= col0 && x1 <= col1 && y0 >= row0 && y1 <= row1))
+			{
+				min = Math.Min(min, cellMin(level, cx, cy));
+				max = Math.Max(max, cellMax(level, cx, cy));
+				return;
+			}
+
+			var childSize = _levelSize[level - 1];
+			for (int y = cy * 2; y <= Math.Min(cy * 2 + 1, childSize - 1); y++)
+			{
+				for (int x = cx * 2; x <= Math.Min(cx * 2 + 1, childSize - 1); x++)
+				{
+					range(level - 1, x, y, col0, row0, col1, row1, ref min, ref max);
+				}
+			}
+		}
+
+		private static bool clip(float origin, float direction, int size, ref float tEnter, ref float tExit)
+		{
+			if (direction == 0)
+			{
+				return origin >= 0 && origin < size;
+			}
+
+			var a = (0 - origin) / direction;
+			var b = (size - origin) / direction;
+			if (a > b)
+			{
+				var swap = a;
+				a = b;
+				b = swap;
+			}
+			tEnter = Math.Max(tEnter, a);
+			tExit = Math.Min(tExit, b);
+			return tEnter < tExit;
+		}
+
+		private float cellMin(int level, int x, int y)
+		{
+			return level == 0 ? _heights[y * _size + x] : _min[level][y * _levelSize[level] + x];
+		}
+
+		private float cellMax(int level, int x, int y)
+		{
+			return level == 0 ? _heights[y * _size + x] : _max[level][y * _levelSize[level] + x];
+		}
+
+		private void allocate(int size)
+		{
+			_size = size;
+			var levels = 1;
+			for (int s = size; s > 1; s = (s + 1) / 2)
+			{
+				levels++;
+			}
+
+			_levelSize = new int[levels];
+			_min = new float[levels][];
+			_max = new float[levels][];
+			_levelSize[0] = size;
+			for (int level = 1; level < levels; level++)
+			{
+				_levelSize[level] = (_levelSize[level - 1] + 1) / 2;
+				_min[level] = new float[_levelSize[level] * _levelSize[level]];
+				_max[level] = new float[_levelSize[level] * _levelSize[level]];
+			}
+		}
+	}
+}
@@ -0,0 +1,190 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System.Collections.Generic;
+	using UnityEngine;
+	using UnityEngine.Rendering;
+
+	/// <summary>
+	/// Vertex and index buffers of all the features of a tile merged into one mesh. Features are appended once, straight
+	/// from the <see cref="MeshData"/> the modifiers filled, with their indices offset on the way. Meshes above 65535
+	/// vertices are uploaded with 32 bit indices, so a tile is one mesh and one draw call per submesh.
+	/// Lists keep their capacity across <see cref="Clear"/>, pool instances to reuse them for the next tile.
+	/// Attributes a feature doesn't have (normals, uv channels) are padded with zeros to keep them aligned with the vertices.
+	/// </summary>
+	public class MergedMeshBuffer
+	{
+		/// <summary> Vertex limit of meshes with 16 bit indices, with some headroom like before 32 bit support. </summary>
+		public const int MAX_16BIT_VERTICES = 65000;
+
+		public readonly List<Vector3> Vertices = new List<Vector3>();
+		public readonly List<Vector3> Normals = new List<Vector3>();
+		// lists past the counts are empty and kept for the next tile
+		private readonly List<List<int>> _triangles = new List<List<int>>();
+		private readonly List<List<Vector2>> _uv = new List<List<Vector2>>();
+		private int _submeshCount;
+		private int _uvCount;
+		private int _indexCount;
+		private int _featureCount;
+		private long _bytesCopied;
+
+		public int VertexCount { get { return Vertices.Count; } }
+
+		public int IndexCount { get { return _indexCount; } }
+
+		public int SubmeshCount { get { return _submeshCount; } }
+
+		public int UvChannelCount { get { return _uvCount; } }
+
+		/// <summary> Features appended since the last <see cref="Clear"/>. </summary>
+		public int FeatureCount { get { return _featureCount; } }
+
+		/// <summary> Bytes written into the buffers by <see cref="Append"/> since the last <see cref="Clear"/>. </summary>
+		public long BytesCopied { get { return _bytesCopied; } }
+
+		/// <summary> Managed memory held by the merged data, not counting spare capacity. </summary>
+		public int SizeInBytes
+		{
+			get { return Vertices.Count * (12 + 12 + 8 * _uvCount) + _indexCount * 4; }
+		}
+
+		public List<int> GetTriangles(int submesh)
+		{
+			return _triangles[submesh];
+		}
+
+		public List<Vector2> GetUV(int channel)
+		{
+			return _uv[channel];
+		}
+
+		/// <summary>
+		/// Append the vertices and triangles of <paramref name="meshData"/>, false if it was skipped for having no more than
+		/// three vertices, like the stacks always did.
+		/// </summary>
+		public bool Append(MeshData meshData)
+		{
+			int count = meshData.Vertices.Count;
+			if (count <= 3)
+			{
+				return false;
+			}
+
+			int start = Vertices.Count;
+			MeshData.Reserve(Vertices, count);
+			Vertices.AddRange(meshData.Vertices);
+			_bytesCopied += count * 12L;
+
+			MeshData.Reserve(Normals, count);
+			if (meshData.Normals.Count == count)
+			{
+				Normals.AddRange(meshData.Normals);
+			}
+			else
+			{
+				pad(Normals, start + count);
+			}
+			_bytesCopied += count * 12L;
+
+			int channels = meshData.UV.Count;
+			while (_uvCount < channels)
+			{
+				var uv = nextList(_uv, _uvCount++);
+				pad(uv, start);
+			}
+			for (int i = 0; i < _uvCount; i++)
+			{
+				var uv = _uv[i];
+				MeshData.Reserve(uv, count);
+				if (i < channels && meshData.UV[i].Count == count)
+				{
+					uv.AddRange(meshData.UV[i]);
+				}
+				else
+				{
+					pad(uv, start + count);
+				}
+				_bytesCopied += count * 8L;
+			}
+
+			int submeshes = meshData.Triangles.Count;
+			while (_submeshCount < submeshes)
+			{
+				nextList(_triangles, _submeshCount++);
+			}
+			for (int i = 0; i < submeshes; i++)
+			{
+				var source = meshData.Triangles[i];
+				var target = _triangles[i];
+				int indices = source.Count;
+				MeshData.Reserve(target, indices);
+				for (int j = 0; j < indices; j++)
+				{
+					target.Add(source[j] + start);
+				}
+				_indexCount += indices;
+				_bytesCopied += indices * 4L;
+			}
+
+			_featureCount++;
+			return true;
+		}
+
+		/// <summary>
+		/// Replace the contents of <paramref name="mesh"/> with the merged data, with 32 bit indices if there are more
+		/// vertices than 16 bit ones can address.
+		/// </summary>
+		public void Upload(Mesh mesh)
+		{
+			mesh.Clear();
+			mesh.indexFormat = Vertices.Count > ushort.MaxValue ? IndexFormat.UInt32 : IndexFormat.UInt16;
+			mesh.subMeshCount = _submeshCount;
+			mesh.SetVertices(Vertices);
+			mesh.SetNormals(Normals);
+			for (int i = 0; i < _submeshCount; i++)
+			{
+				mesh.SetTriangles(_triangles[i], i);
+			}
+			for (int i = 0; i < _uvCount; i++)
+			{
+				mesh.SetUVs(i, _uv[i]);
+			}
+		}
+
+		/// <summary> Empty the buffers, keeping their capacity. </summary>
+		public void Clear()
+		{
+			Vertices.Clear();
+			Normals.Clear();
+			for (int i = 0; i < _submeshCount; i++)
+			{
+				_triangles[i].Clear();
+			}
+			for (int i = 0; i < _uvCount; i++)
+			{
+				_uv[i].Clear();
+			}
+			_submeshCount = 0;
+			_uvCount = 0;
+			_indexCount = 0;
+			_featureCount = 0;
+			_bytesCopied = 0;
+		}
+
+		private static List<T> nextList<T>(List<List<T>> lists, int index)
+		{
+			if (lists.Count <= index)
+			{
+				lists.Add(new List<T>());
+			}
+			return lists[index];
+		}
+
+		private static void pad<T>(List<T> list, int count)
+		{
+			while (list.Count < count)
+			{
+				list.Add(default(T));
+			}
+		}
+	}
+}
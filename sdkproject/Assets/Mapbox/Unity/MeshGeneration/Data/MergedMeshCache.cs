@@ -0,0 +1,207 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Runtime.CompilerServices;
+
+	/// <summary>
+	/// Identifies the merged output of one layer of one tile: the vector data it was built from, the layer, a hash of
+	/// the style and modifier settings, and what of the tile goes into the geometry (scale and terrain heights).
+	/// The source is compared by identity, a reloaded tile never matches the meshes of the data it had before.
+	/// </summary>
+	public struct MergedMeshKey : IEquatable<MergedMeshKey>
+	{
+		private const int HEIGHT_SAMPLES = 64;
+
+		public readonly int SourceId;
+		public readonly string LayerName;
+		public readonly int StyleHash;
+		public readonly float TileScale;
+		public readonly int HeightHash;
+
+		public MergedMeshKey(object source, string layerName, int styleHash, UnityTile tile)
+			: this(RuntimeHelpers.GetHashCode(source), layerName, styleHash, tile.TileScale, HashHeights(tile))
+		{
+		}
+
+		public MergedMeshKey(int sourceId, string layerName, int styleHash, float tileScale, int heightHash)
+		{
+			SourceId = sourceId;
+			LayerName = layerName;
+			StyleHash = styleHash;
+			TileScale = tileScale;
+			HeightHash = heightHash;
+		}
+
+		/// <summary>
+		/// Hash of the elevation type and a strided sample of the height data, enough to tell flat, loading and
+		/// loaded terrain apart without hashing the whole grid.
+		/// </summary>
+		public static int HashHeights(UnityTile tile)
+		{
+			int hash = (int)tile.ElevationType;
+			var heights = tile.HeightData;
+			if (heights == null)
+			{
+				return hash;
+			}
+
+			hash = hash * 31 + heights.Length;
+			int step = Math.Max(1, heights.Length / HEIGHT_SAMPLES);
+			for (int i = 0; i < heights.Length; i += step)
+			{
+				hash = hash * 31 + heights[i].GetHashCode();
+			}
+			return hash;
+		}
+
+		public bool Equals(MergedMeshKey other)
+		{
+			return SourceId == other.SourceId
+				&& StyleHash == other.StyleHash
+				&& TileScale == other.TileScale
+				&& HeightHash == other.HeightHash
+				&& string.Equals(LayerName, other.LayerName);
+		}
+
+		public override bool Equals(object obj)
+		{
+			return obj is MergedMeshKey && Equals((MergedMeshKey)obj);
+		}
+
+		public override int GetHashCode()
+		{
+			unchecked
+			{
+				int hash = SourceId;
+				hash = hash * 31 + StyleHash;
+				hash = hash * 31 + TileScale.GetHashCode();
+				hash = hash * 31 + HeightHash;
+				hash = hash * 31 + (LayerName == null ? 0 : LayerName.GetHashCode());
+				return hash;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Keeps the merged buffers of recently built tile layers so toggling a layer or redrawing a tile with an unchanged
+	/// style uploads them again instead of decoding and running the modifiers. Least recently used entries are evicted
+	/// once the cached vertices exceed <see cref="VertexBudget"/>, their buffers go to the release callback.
+	/// Sources are held weakly, entries of collected tile data never match again and age out. Main thread only.
+	/// </summary>
+	public class MergedMeshCache
+	{
+		private class Entry
+		{
+			public MergedMeshKey Key;
+			public WeakReference Source;
+			public List<MergedMeshBuffer> Buffers;
+			public int VertexCount;
+		}
+
+		private readonly Dictionary<MergedMeshKey, LinkedListNode<Entry>> _entries = new Dictionary<MergedMeshKey, LinkedListNode<Entry>>();
+		// most recently used first
+		private readonly LinkedList<Entry> _order = new LinkedList<Entry>();
+		private readonly Action<MergedMeshBuffer> _release;
+		private int _vertexCount;
+
+		public int VertexBudget;
+
+		public MergedMeshCache(int vertexBudget, Action<MergedMeshBuffer> release)
+		{
+			VertexBudget = vertexBudget;
+			_release = release;
+		}
+
+		public int Count { get { return _entries.Count; } }
+
+		/// <summary> Vertices of all cached buffers. </summary>
+		public int VertexCount { get { return _vertexCount; } }
+
+		/// <summary> Buffers cached for <paramref name="key"/> if they were built from <paramref name="source"/>, null otherwise. </summary>
+		public List<MergedMeshBuffer> Get(MergedMeshKey key, object source)
+		{
+			LinkedListNode<Entry> node;
+			if (!_entries.TryGetValue(key, out node))
+			{
+				return null;
+			}
+			if (!ReferenceEquals(node.Value.Source.Target, source))
+			{
+				remove(node);
+				return null;
+			}
+
+			_order.Remove(node);
+			_order.AddFirst(node);
+			return node.Value.Buffers;
+		}
+
+		/// <summary>
+		/// Cache <paramref name="buffers"/>, the cache owns them from now on. Anything already cached for the key is
+		/// replaced, buffers over the budget on their own are released right away.
+		/// </summary>
+		public void Add(MergedMeshKey key, object source, List<MergedMeshBuffer> buffers)
+		{
+			LinkedListNode<Entry> existing;
+			if (_entries.TryGetValue(key, out existing))
+			{
+				remove(existing);
+			}
+
+			int vertices = 0;
+			for (int i = 0; i < buffers.Count; i++)
+			{
+				vertices += buffers[i].VertexCount;
+			}
+			if (vertices > VertexBudget)
+			{
+				release(buffers);
+				return;
+			}
+
+			var node = _order.AddFirst(new Entry()
+			{
+				Key = key,
+				Source = new WeakReference(source),
+				Buffers = buffers,
+				VertexCount = vertices
+			});
+			_entries.Add(key, node);
+			_vertexCount += vertices;
+
+			while (_vertexCount > VertexBudget)
+			{
+				remove(_order.Last);
+			}
+		}
+
+		public void Clear()
+		{
+			while (_order.Count > 0)
+			{
+				remove(_order.Last);
+			}
+		}
+
+		private void remove(LinkedListNode<Entry> node)
+		{
+			_order.Remove(node);
+			_entries.Remove(node.Value.Key);
+			_vertexCount -= node.Value.VertexCount;
+			release(node.Value.Buffers);
+		}
+
+		private void release(List<MergedMeshBuffer> buffers)
+		{
+			if (_release == null)
+			{
+				return;
+			}
+			for (int i = 0; i < buffers.Count; i++)
+			{
+				_release(buffers[i]);
+			}
+		}
+	}
+}
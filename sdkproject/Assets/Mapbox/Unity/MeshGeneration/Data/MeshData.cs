@@ -6,8 +6,16 @@ namespace Mapbox.Unity.MeshGeneration.Data
 	using Utils;
 
 	// TODO: Do we need this class? Why not just use `Mesh`?
+	/// <summary>
+	/// Mesh buffers of a feature, one list per vertex attribute (struct of arrays) so they can be uploaded to a
+	/// <see cref="Mesh"/> as they are. Instances rented from a <see cref="MeshDataArena"/> keep the capacity
+	/// of their lists, and of the triangle lists added with <see cref="AddSubmesh"/>, across features and tiles.
+	/// Modifiers that add their own lists or replace them keep working, those lists are simply pooled as well.
+	/// </summary>
 	public class MeshData
 	{
+		private const int MAX_POOLED_SUBMESHES = 4;
+
 		public Vector3 PositionInTile;
 		public List<int> Edges;
 		public Vector2 MercatorCenter;
@@ -18,6 +26,13 @@ namespace Mapbox.Unity.MeshGeneration.Data
 		public List<List<int>> Triangles;
 		public List<List<Vector2>> UV;
 
+		//triangle lists of previous features, handed out again by AddSubmesh
+		private Stack<List<int>> _submeshPool;
+
+		internal MeshDataArena Arena;
+		internal UnityTile Owner;
+		internal bool IsRented;
+
 		public MeshData()
 		{
 			Edges = new List<int>();
@@ -29,6 +44,52 @@ namespace Mapbox.Unity.MeshGeneration.Data
 			UV.Add(new List<Vector2>());
 		}
 
+		/// <summary>
+		/// Add a new submesh and return its triangle list. Pooled instances reuse lists of earlier features,
+		/// prefer this over adding a new list to <see cref="Triangles"/>.
+		/// </summary>
+		/// <param name="capacity">Expected number of indices.</param>
+		public List<int> AddSubmesh(int capacity = 0)
+		{
+			List<int> triangles;
+			if (_submeshPool != null && _submeshPool.Count > 0)
+			{
+				triangles = _submeshPool.Pop();
+				Reserve(triangles, capacity);
+			}
+			else
+			{
+				triangles = new List<int>(capacity);
+			}
+			Triangles.Add(triangles);
+			return triangles;
+		}
+
+		/// <summary>
+		/// Return this instance to the arena it was rented from, no-op for instances created with new.
+		/// Must not be used afterwards.
+		/// </summary>
+		public void Release()
+		{
+			if (Arena != null)
+			{
+				Arena.Release(this);
+			}
+		}
+
+		/// <summary>
+		/// Make sure <paramref name="list"/> can take <paramref name="additional"/> more items without growing more than once.
+		/// Unlike setting <see cref="List{T}.Capacity"/> directly this never shrinks a pooled list.
+		/// </summary>
+		public static void Reserve<T>(List<T> list, int additional)
+		{
+			var required = list.Count + additional;
+			if (required > list.Capacity)
+			{
+				list.Capacity = Math.Max(required, list.Capacity * 2);
+			}
+		}
+
 		internal void Clear()
 		{
 			Edges.Clear();
@@ -45,5 +106,57 @@ namespace Mapbox.Unity.MeshGeneration.Data
 				item.Clear();
 			}
 		}
+
+		/// <summary>
+		/// Reset to the state of a new instance, keeping list capacities.
+		/// </summary>
+		internal void Reset()
+		{
+			PositionInTile = Vector3.zero;
+			MercatorCenter = Vector2.zero;
+			TileRect = new RectD();
+			Edges.Clear();
+			Vertices.Clear();
+			Normals.Clear();
+			Tangents.Clear();
+
+			if (_submeshPool == null)
+			{
+				_submeshPool = new Stack<List<int>>();
+			}
+			for (int i = 0; i < Triangles.Count && _submeshPool.Count < MAX_POOLED_SUBMESHES; i++)
+			{
+				Triangles[i].Clear();
+				_submeshPool.Push(Triangles[i]);
+			}
+			Triangles.Clear();
+
+			//first uv channel is always there, additional ones are rare and dropped
+			if (UV.Count > 1)
+			{
+				UV.RemoveRange(1, UV.Count - 1);
+			}
+			if (UV.Count == 0)
+			{
+				UV.Add(new List<Vector2>());
+			}
+			UV[0].Clear();
+		}
+
+		/// <summary>
+		/// Largest list capacity of this instance, used by the arena to drop oversized buffers.
+		/// </summary>
+		internal int LargestCapacity
+		{
+			get
+			{
+				var largest = Math.Max(Vertices.Capacity, Edges.Capacity);
+				for (int i = 0; i < Triangles.Count; i++)
+				{
+					largest = Math.Max(largest, Triangles[i].Capacity);
+				}
+				return largest;
+			}
+		}
 	}
 }
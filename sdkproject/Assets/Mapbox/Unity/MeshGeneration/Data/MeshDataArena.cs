@@ -0,0 +1,135 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System.Collections.Generic;
+
+	/// <summary>
+	/// Hands out pooled <see cref="MeshData"/> instances and keeps track of the tile they were rented for.
+	/// Released instances go back to a free list shared by all arenas, so buffers grown by one layer or tile
+	/// are reused by the next. Everything still rented for a tile is released with <see cref="ReleaseTile"/>
+	/// when the tile is recycled. Main thread only.
+	/// </summary>
+	public class MeshDataArena
+	{
+		/// <summary> Number of free instances kept, surplus releases are dropped. </summary>
+		public const int MAX_POOLED = 256;
+		/// <summary> Instances whose buffers grew beyond this many elements are dropped instead of pooled. </summary>
+		public const int MAX_POOLED_CAPACITY = 16384;
+
+		private static readonly Stack<MeshData> _free = new Stack<MeshData>();
+		private static int _created;
+
+		private readonly Dictionary<UnityTile, List<MeshData>> _rented = new Dictionary<UnityTile, List<MeshData>>();
+		private readonly Stack<List<MeshData>> _listPool = new Stack<List<MeshData>>();
+
+		/// <summary> Free instances waiting to be rented again. </summary>
+		public static int Pooled { get { return _free.Count; } }
+
+		/// <summary> Instances created since startup, stays flat once the pool is warm. </summary>
+		public static int Created { get { return _created; } }
+
+		/// <summary> Instances currently rented for <paramref name="tile"/>. </summary>
+		public int RentedCount(UnityTile tile)
+		{
+			List<MeshData> rented;
+			return _rented.TryGetValue(tile, out rented) ? rented.Count : 0;
+		}
+
+		/// <summary> Rent an empty instance for a feature of <paramref name="tile"/>. </summary>
+		public MeshData Rent(UnityTile tile)
+		{
+			MeshData meshData;
+			if (_free.Count > 0)
+			{
+				meshData = _free.Pop();
+			}
+			else
+			{
+				meshData = new MeshData();
+				_created++;
+			}
+
+			meshData.Arena = this;
+			meshData.Owner = tile;
+			meshData.IsRented = true;
+
+			List<MeshData> rented;
+			if (!_rented.TryGetValue(tile, out rented))
+			{
+				rented = _listPool.Count > 0 ? _listPool.Pop() : new List<MeshData>();
+				_rented.Add(tile, rented);
+			}
+			rented.Add(meshData);
+			return meshData;
+		}
+
+		/// <summary>
+		/// Give an instance back before its tile is recycled, eg once its mesh has been uploaded.
+		/// Releasing twice or releasing instances of another arena is ignored.
+		/// </summary>
+		public void Release(MeshData meshData)
+		{
+			if (meshData == null || !meshData.IsRented || meshData.Arena != this)
+			{
+				return;
+			}
+
+			//ReleaseTile drops the tile's list before releasing what's in it
+			List<MeshData> rented;
+			if (meshData.Owner != null && _rented.TryGetValue(meshData.Owner, out rented))
+			{
+				//usually the instance rented last, swap remove from the back
+				int index = rented.LastIndexOf(meshData);
+				if (index >= 0)
+				{
+					rented[index] = rented[rented.Count - 1];
+					rented.RemoveAt(rented.Count - 1);
+				}
+				if (rented.Count == 0)
+				{
+					_rented.Remove(meshData.Owner);
+					_listPool.Push(rented);
+				}
+			}
+
+			meshData.IsRented = false;
+			meshData.Owner = null;
+			meshData.Arena = null;
+
+			if (_free.Count >= MAX_POOLED || meshData.LargestCapacity > MAX_POOLED_CAPACITY)
+			{
+				return;
+			}
+			meshData.Reset();
+			_free.Push(meshData);
+		}
+
+		/// <summary> Release everything still rented for <paramref name="tile"/>. </summary>
+		public void ReleaseTile(UnityTile tile)
+		{
+			List<MeshData> rented;
+			if (!_rented.TryGetValue(tile, out rented))
+			{
+				return;
+			}
+			_rented.Remove(tile);
+
+			//instances released early were already taken out of the list
+			for (int i = 0; i < rented.Count; i++)
+			{
+				Release(rented[i]);
+			}
+			rented.Clear();
+			_listPool.Push(rented);
+		}
+
+		/// <summary> Release everything rented from this arena. </summary>
+		public void Clear()
+		{
+			var tiles = new List<UnityTile>(_rented.Keys);
+			for (int i = 0; i < tiles.Count; i++)
+			{
+				ReleaseTile(tiles[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,370 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Map;
+	using UnityEngine;
+
+	/// <summary>
+	/// Spatial index over the features of all loaded tiles, one <see cref="PackedRTree{T}"/> per tile.
+	/// Items are added and removed tile by tile: additions are staged and the tree of a tile is bulk loaded once,
+	/// on the first query after it changed, and a removed tile just drops its tree.
+	/// Queries work on an immutable snapshot of the trees and can run on any thread, also while the main thread
+	/// adds or removes tiles. Batched overloads answer many queries against the same snapshot.
+	/// Radius and nearest neighbour queries measure on the x/z plane, box and ray queries are 3D.
+	/// </summary>
+	public class FeatureSpatialIndex<T>
+	{
+		private class TileEntry
+		{
+			public PackedRTree<T> Tree;
+			public List<Bounds> PendingBounds = new List<Bounds>();
+			public List<T> PendingItems = new List<T>();
+		}
+
+		/// <summary> Node of a best first search over several trees. </summary>
+		private struct QueueEntry
+		{
+			public float Distance;
+			public PackedRTree<T> Tree;
+			public int Slot;
+		}
+
+		private readonly object _lock = new object();
+		private readonly Dictionary<UnwrappedTileId, TileEntry> _tiles = new Dictionary<UnwrappedTileId, TileEntry>();
+		private readonly int _nodeSize;
+		private volatile PackedRTree<T>[] _snapshot = new PackedRTree<T>[0];
+		private volatile bool _dirty;
+		private int _count;
+
+		public FeatureSpatialIndex(int nodeSize = PackedRTree<T>.DEFAULT_NODE_SIZE)
+		{
+			_nodeSize = nodeSize;
+		}
+
+		/// <summary> Number of items over all tiles, including items not indexed yet. </summary>
+		public int Count { get { lock (_lock) { return _count; } } }
+
+		/// <summary> Number of tiles with items. </summary>
+		public int TileCount { get { lock (_lock) { return _tiles.Count; } } }
+
+		/// <summary> Stage an item of <paramref name="tileId"/>, it is indexed with the other staged items of the tile by the next query. </summary>
+		public void Add(UnwrappedTileId tileId, Bounds bounds, T item)
+		{
+			lock (_lock)
+			{
+				TileEntry entry = getEntry(tileId);
+				entry.PendingBounds.Add(bounds);
+				entry.PendingItems.Add(item);
+				_count++;
+				_dirty = true;
+			}
+		}
+
+		/// <summary> Stage all items of a tile at once, one box per item. </summary>
+		public void Add(UnwrappedTileId tileId, IList<Bounds> bounds, IList<T> items)
+		{
+			if (bounds.Count != items.Count) { throw new ArgumentException("one box per item expected", "bounds"); }
+			lock (_lock)
+			{
+				TileEntry entry = getEntry(tileId);
+				entry.PendingBounds.AddRange(bounds);
+				entry.PendingItems.AddRange(items);
+				_count += items.Count;
+				_dirty = true;
+			}
+		}
+
+		/// <summary> Drop all items of a tile, eg when it unloads. </summary>
+		/// <returns> False if the tile had no items. </returns>
+		public bool Remove(UnwrappedTileId tileId)
+		{
+			lock (_lock)
+			{
+				TileEntry entry;
+				if (!_tiles.TryGetValue(tileId, out entry)) { return false; }
+				_count -= entry.PendingItems.Count + (entry.Tree == null ? 0 : entry.Tree.Count);
+				_tiles.Remove(tileId);
+				_dirty = true;
+				return true;
+			}
+		}
+
+		public void Clear()
+		{
+			lock (_lock)
+			{
+				_tiles.Clear();
+				_count = 0;
+				_snapshot = new PackedRTree<T>[0];
+				_dirty = false;
+			}
+		}
+
+		/// <summary> Index staged items now instead of on the next query, eg right after a tile finished loading. </summary>
+		public void Build()
+		{
+			getSnapshot();
+		}
+
+		/// <summary> Append items within <paramref name="radius"/> of <paramref name="center"/>. </summary>
+		/// <returns> Number of items appended. </returns>
+		public int Radius(Vector3 center, float radius, List<T> results)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			int found = 0;
+			for (int i = 0; i < trees.Length; i++)
+			{
+				if (trees[i].DistanceSqrXZ(trees[i].Root, center.x, center.z) > radius * radius) { continue; }
+				found += trees[i].Radius(center, radius, results);
+			}
+			return found;
+		}
+
+		/// <summary> Radius query for every center, results of <paramref name="centers"/>[i] are appended to <paramref name="results"/>[i]. </summary>
+		public void Radius(IList<Vector3> centers, float radius, IList<List<T>> results)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			for (int q = 0; q < centers.Count; q++)
+			{
+				Vector3 center = centers[q];
+				for (int i = 0; i < trees.Length; i++)
+				{
+					if (trees[i].DistanceSqrXZ(trees[i].Root, center.x, center.z) > radius * radius) { continue; }
+					trees[i].Radius(center, radius, results[q]);
+				}
+			}
+		}
+
+		/// <summary> Append items overlapping <paramref name="bounds"/>. </summary>
+		/// <returns> Number of items appended. </returns>
+		public int Intersecting(Bounds bounds, List<T> results)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			int found = 0;
+			for (int i = 0; i < trees.Length; i++)
+			{
+				found += trees[i].Intersecting(bounds, results);
+			}
+			return found;
+		}
+
+		/// <summary> Box query for every box, results of <paramref name="bounds"/>[i] are appended to <paramref name="results"/>[i]. </summary>
+		public void Intersecting(IList<Bounds> bounds, IList<List<T>> results)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			for (int q = 0; q < bounds.Count; q++)
+			{
+				for (int i = 0; i < trees.Length; i++)
+				{
+					trees[i].Intersecting(bounds[q], results[q]);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Append up to <paramref name="maxCount"/> items closest to <paramref name="point"/>, closest first.
+		/// Items further away than <paramref name="maxDistance"/> are skipped, negative values mean no limit.
+		/// </summary>
+		/// <returns> Number of items appended. </returns>
+		public int Nearest(Vector3 point, int maxCount, float maxDistance, List<T> results)
+		{
+			return nearest(getSnapshot(), point, maxCount, maxDistance, results, new List<QueueEntry>());
+		}
+
+		/// <summary> Nearest neighbours of every point, results of <paramref name="points"/>[i] are appended to <paramref name="results"/>[i]. </summary>
+		public void Nearest(IList<Vector3> points, int maxCount, float maxDistance, IList<List<T>> results)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			List<QueueEntry> queue = new List<QueueEntry>();
+			for (int q = 0; q < points.Count; q++)
+			{
+				nearest(trees, points[q], maxCount, maxDistance, results[q], queue);
+			}
+		}
+
+		/// <summary> Closest item whose box is hit by <paramref name="ray"/> within <paramref name="maxDistance"/>. </summary>
+		public bool Raycast(Ray ray, float maxDistance, out T item, out float distance)
+		{
+			return raycast(getSnapshot(), ray, maxDistance, out item, out distance, new List<QueueEntry>());
+		}
+
+		/// <summary> Closest hit of every ray, <paramref name="hits"/>[i] is false if <paramref name="rays"/>[i] hit nothing. </summary>
+		public void Raycast(IList<Ray> rays, float maxDistance, bool[] hits, T[] items, float[] distances)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			List<QueueEntry> queue = new List<QueueEntry>();
+			for (int q = 0; q < rays.Count; q++)
+			{
+				hits[q] = raycast(trees, rays[q], maxDistance, out items[q], out distances[q], queue);
+			}
+		}
+
+		/// <summary> Append all items whose box is hit by <paramref name="ray"/> within <paramref name="maxDistance"/>, in no particular order. </summary>
+		/// <returns> Number of items appended. </returns>
+		public int RaycastAll(Ray ray, float maxDistance, List<T> results)
+		{
+			PackedRTree<T>[] trees = getSnapshot();
+			int found = 0;
+			for (int i = 0; i < trees.Length; i++)
+			{
+				found += trees[i].RaycastAll(ray, maxDistance, results);
+			}
+			return found;
+		}
+
+		private TileEntry getEntry(UnwrappedTileId tileId)
+		{
+			TileEntry entry;
+			if (!_tiles.TryGetValue(tileId, out entry))
+			{
+				entry = new TileEntry();
+				_tiles.Add(tileId, entry);
+			}
+			return entry;
+		}
+
+		/// <summary> Trees of all tiles, bulk loading tiles with staged items first. </summary>
+		private PackedRTree<T>[] getSnapshot()
+		{
+			if (!_dirty)
+			{
+				return _snapshot;
+			}
+
+			lock (_lock)
+			{
+				if (!_dirty)
+				{
+					return _snapshot;
+				}
+
+				List<PackedRTree<T>> trees = new List<PackedRTree<T>>(_tiles.Count);
+				foreach (var entry in _tiles.Values)
+				{
+					if (entry.PendingItems.Count > 0)
+					{
+						if (entry.Tree != null)
+						{
+							// rebuilding keeps the tree packed, tiles usually arrive in one go anyway
+							entry.Tree.CopyTo(entry.PendingBounds, entry.PendingItems);
+						}
+						entry.Tree = new PackedRTree<T>(entry.PendingBounds, entry.PendingItems, _nodeSize);
+						entry.PendingBounds.Clear();
+						entry.PendingItems.Clear();
+					}
+					if (entry.Tree != null && entry.Tree.Count > 0)
+					{
+						trees.Add(entry.Tree);
+					}
+				}
+				_snapshot = trees.ToArray();
+				_dirty = false;
+				return _snapshot;
+			}
+		}
+
+		private static int nearest(PackedRTree<T>[] trees, Vector3 point, int maxCount, float maxDistance, List<T> results, List<QueueEntry> queue)
+		{
+			float maxDistanceSqr = maxDistance < 0 ? float.PositiveInfinity : maxDistance * maxDistance;
+			queue.Clear();
+			for (int i = 0; i < trees.Length; i++)
+			{
+				float d = trees[i].DistanceSqrXZ(trees[i].Root, point.x, point.z);
+				if (d <= maxDistanceSqr) { push(queue, new QueueEntry() { Distance = d, Tree = trees[i], Slot = trees[i].Root }); }
+			}
+
+			// best first: items come off the queue in order of distance
+			int found = 0;
+			while (found < maxCount && queue.Count > 0)
+			{
+				QueueEntry next = pop(queue);
+				PackedRTree<T> tree = next.Tree;
+				if (tree.IsLeaf(next.Slot))
+				{
+					results.Add(tree.ItemAt(next.Slot));
+					found++;
+					continue;
+				}
+				int end = tree.ChildEnd(next.Slot);
+				for (int c = tree.FirstChild(next.Slot); c < end; c++)
+				{
+					float d = tree.DistanceSqrXZ(c, point.x, point.z);
+					if (d <= maxDistanceSqr) { push(queue, new QueueEntry() { Distance = d, Tree = tree, Slot = c }); }
+				}
+			}
+			return found;
+		}
+
+		private static bool raycast(PackedRTree<T>[] trees, Ray ray, float maxDistance, out T item, out float distance, List<QueueEntry> queue)
+		{
+			Vector3 origin = ray.origin;
+			Vector3 inverse = PackedRTree<T>.InverseDirection(ray.direction);
+			queue.Clear();
+			for (int i = 0; i < trees.Length; i++)
+			{
+				float d = trees[i].RayDistance(trees[i].Root, origin, inverse);
+				if (d <= maxDistance) { push(queue, new QueueEntry() { Distance = d, Tree = trees[i], Slot = trees[i].Root }); }
+			}
+
+			while (queue.Count > 0)
+			{
+				QueueEntry next = pop(queue);
+				PackedRTree<T> tree = next.Tree;
+				if (tree.IsLeaf(next.Slot))
+				{
+					item = tree.ItemAt(next.Slot);
+					distance = next.Distance;
+					return true;
+				}
+				int end = tree.ChildEnd(next.Slot);
+				for (int c = tree.FirstChild(next.Slot); c < end; c++)
+				{
+					float d = tree.RayDistance(c, origin, inverse);
+					if (d <= maxDistance) { push(queue, new QueueEntry() { Distance = d, Tree = tree, Slot = c }); }
+				}
+			}
+
+			item = default(T);
+			distance = float.PositiveInfinity;
+			return false;
+		}
+
+		// binary min heap on 'Distance'
+		private static void push(List<QueueEntry> heap, QueueEntry entry)
+		{
+			heap.Add(entry);
+			int i = heap.Count - 1;
+			while (i > 0)
+			{
+				int parent = (i - 1) >> 1;
+				if (heap[parent].Distance <= entry.Distance) { break; }
+				heap[i] = heap[parent];
+				i = parent;
+			}
+			heap[i] = entry;
+		}
+
+		private static QueueEntry pop(List<QueueEntry> heap)
+		{
+			QueueEntry top = heap[0];
+			QueueEntry last = heap[heap.Count - 1];
+			heap.RemoveAt(heap.Count - 1);
+			int count = heap.Count;
+			if (count == 0) { return top; }
+
+			int i = 0;
+			while (true)
+			{
+				int child = 2 * i + 1;
+				if (child >= count) { break; }
+				if (child + 1 < count && heap[child + 1].Distance < heap[child].Distance) { child++; }
+				if (last.Distance <= heap[child].Distance) { break; }
+				heap[i] = heap[child];
+				i = child;
+			}
+			heap[i] = last;
+			return top;
+		}
+	}
+}
@@ -0,0 +1,365 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System;
+	using System.Collections.Generic;
+	using UnityEngine;
+
+	/// <summary>
+	/// Static R-tree over axis aligned boxes, bulk loaded once with sort-tile-recursive packing on the x/z plane.
+	/// Boxes and child links live in flat arrays, leaves first and the root last, so building allocates a handful of
+	/// arrays and queries allocate nothing. The tree never changes after construction and can be queried from any
+	/// thread; <see cref="FeatureSpatialIndex{T}"/> keeps one per tile and replaces it when the tile changes.
+	/// Radius and nearest neighbour queries measure on the x/z plane, box and ray queries are 3D.
+	/// </summary>
+	public class PackedRTree<T>
+	{
+		public const int DEFAULT_NODE_SIZE = 16;
+
+		// min x, y, z, max x, y, z of every slot
+		private const int STRIDE = 6;
+
+		private readonly int _count;
+		private readonly int _nodeSize;
+		private readonly T[] _items;
+		private readonly float[] _boxes;
+		// leaf slots: index into '_items', node slots: first child slot
+		private readonly int[] _indices;
+		// end slot of every level, leaves first
+		private readonly int[] _levelEnds;
+
+		[ThreadStatic] private static int[] _stack;
+
+		public PackedRTree(IList<Bounds> bounds, IList<T> items, int nodeSize = DEFAULT_NODE_SIZE)
+		{
+			if (bounds == null) { throw new ArgumentNullException("bounds"); }
+			if (items == null) { throw new ArgumentNullException("items"); }
+			if (bounds.Count != items.Count) { throw new ArgumentException("one box per item expected", "bounds"); }
+			if (nodeSize < 2) { throw new ArgumentOutOfRangeException("nodeSize"); }
+
+			_count = items.Count;
+			_nodeSize = nodeSize;
+			_items = new T[_count];
+			items.CopyTo(_items, 0);
+
+			List<int> levelEnds = new List<int>();
+			int slots = _count;
+			int levelSize = _count;
+			levelEnds.Add(_count);
+			// at least one node above the leaves, the root is never a leaf
+			do
+			{
+				levelSize = (levelSize + nodeSize - 1) / nodeSize;
+				slots += levelSize;
+				levelEnds.Add(slots);
+			}
+			while (levelSize > 1);
+			_levelEnds = levelEnds.ToArray();
+			_boxes = new float[slots * STRIDE];
+			_indices = new int[slots];
+
+			if (_count == 0)
+			{
+				return;
+			}
+
+			int[] order = sortTileRecursive(bounds);
+			for (int i = 0; i < _count; i++)
+			{
+				Bounds b = bounds[order[i]];
+				Vector3 min = b.min;
+				Vector3 max = b.max;
+				int o = i * STRIDE;
+				_boxes[o] = min.x;
+				_boxes[o + 1] = min.y;
+				_boxes[o + 2] = min.z;
+				_boxes[o + 3] = max.x;
+				_boxes[o + 4] = max.y;
+				_boxes[o + 5] = max.z;
+				_indices[i] = order[i];
+			}
+
+			// every node covers up to 'nodeSize' consecutive slots of the level below
+			int slot = _count;
+			int levelStart = 0;
+			for (int level = 0; level < _levelEnds.Length - 1; level++)
+			{
+				int levelEnd = _levelEnds[level];
+				for (int child = levelStart; child < levelEnd; child += nodeSize)
+				{
+					int childEnd = Math.Min(child + nodeSize, levelEnd);
+					int o = slot * STRIDE;
+					for (int k = 0; k < 3; k++)
+					{
+						_boxes[o + k] = float.MaxValue;
+						_boxes[o + 3 + k] = float.MinValue;
+					}
+					for (int c = child; c < childEnd; c++)
+					{
+						int co = c * STRIDE;
+						for (int k = 0; k < 3; k++)
+						{
+							_boxes[o + k] = Math.Min(_boxes[o + k], _boxes[co + k]);
+							_boxes[o + 3 + k] = Math.Max(_boxes[o + 3 + k], _boxes[co + 3 + k]);
+						}
+					}
+					_indices[slot] = child;
+					slot++;
+				}
+				levelStart = levelEnd;
+			}
+		}
+
+		/// <summary> Number of items. </summary>
+		public int Count { get { return _count; } }
+
+		/// <summary> Box around all items, empty and centered on the origin without items. </summary>
+		public Bounds Bounds
+		{
+			get
+			{
+				if (_count == 0) { return new Bounds(); }
+				Bounds bounds = new Bounds();
+				bounds.SetMinMax(slotMin(Root), slotMax(Root));
+				return bounds;
+			}
+		}
+
+		/// <summary> Append all items and their boxes, eg to rebuild the tree with more items. </summary>
+		public void CopyTo(List<Bounds> bounds, List<T> items)
+		{
+			for (int i = 0; i < _count; i++)
+			{
+				Bounds b = new Bounds();
+				b.SetMinMax(slotMin(i), slotMax(i));
+				bounds.Add(b);
+				items.Add(_items[_indices[i]]);
+			}
+		}
+
+		/// <summary> Append items whose box is within <paramref name="radius"/> of <paramref name="center"/> on the x/z plane. </summary>
+		/// <returns> Number of items appended. </returns>
+		public int Radius(Vector3 center, float radius, List<T> results)
+		{
+			if (_count == 0) { return 0; }
+
+			float radiusSqr = radius * radius;
+			int found = 0;
+			int[] stack = getStack();
+			int top = 0;
+			stack[top++] = Root;
+			while (top > 0)
+			{
+				int node = stack[--top];
+				int end = ChildEnd(node);
+				for (int c = _indices[node]; c < end; c++)
+				{
+					if (DistanceSqrXZ(c, center.x, center.z) > radiusSqr) { continue; }
+					if (c < _count)
+					{
+						results.Add(_items[_indices[c]]);
+						found++;
+					}
+					else
+					{
+						stack[top++] = c;
+					}
+				}
+			}
+			return found;
+		}
+
+		/// <summary> Append items whose box overlaps <paramref name="bounds"/>. </summary>
+		/// <returns> Number of items appended. </returns>
+		public int Intersecting(Bounds bounds, List<T> results)
+		{
+			if (_count == 0) { return 0; }
+
+			Vector3 min = bounds.min;
+			Vector3 max = bounds.max;
+			int found = 0;
+			int[] stack = getStack();
+			int top = 0;
+			stack[top++] = Root;
+			while (top > 0)
+			{
+				int node = stack[--top];
+				int end = ChildEnd(node);
+				for (int c = _indices[node]; c < end; c++)
+				{
+					int o = c * STRIDE;
+					if (
+						_boxes[o] > max.x || _boxes[o + 3] < min.x
+						|| _boxes[o + 1] > max.y || _boxes[o + 4] < min.y
+						|| _boxes[o + 2] > max.z || _boxes[o + 5] < min.z
+					)
+					{
+						continue;
+					}
+					if (c < _count)
+					{
+						results.Add(_items[_indices[c]]);
+						found++;
+					}
+					else
+					{
+						stack[top++] = c;
+					}
+				}
+			}
+			return found;
+		}
+
+		/// <summary> Append items whose box is hit by <paramref name="ray"/> within <paramref name="maxDistance"/>, in no particular order. </summary>
+		/// <returns> Number of items appended. </returns>
+		public int RaycastAll(Ray ray, float maxDistance, List<T> results)
+		{
+			if (_count == 0) { return 0; }
+
+			Vector3 origin = ray.origin;
+			Vector3 inverse = InverseDirection(ray.direction);
+			int found = 0;
+			int[] stack = getStack();
+			int top = 0;
+			stack[top++] = Root;
+			while (top > 0)
+			{
+				int node = stack[--top];
+				int end = ChildEnd(node);
+				for (int c = _indices[node]; c < end; c++)
+				{
+					if (RayDistance(c, origin, inverse) > maxDistance) { continue; }
+					if (c < _count)
+					{
+						results.Add(_items[_indices[c]]);
+						found++;
+					}
+					else
+					{
+						stack[top++] = c;
+					}
+				}
+			}
+			return found;
+		}
+
+		internal int Root { get { return _indices.Length - 1; } }
+
+		internal bool IsLeaf(int slot)
+		{
+			return slot < _count;
+		}
+
+		internal T ItemAt(int slot)
+		{
+			return _items[_indices[slot]];
+		}
+
+		internal int FirstChild(int node)
+		{
+			return _indices[node];
+		}
+
+		/// <summary> End of the children of <paramref name="node"/>, nodes of the last group of a level have less than 'nodeSize'. </summary>
+		internal int ChildEnd(int node)
+		{
+			int first = _indices[node];
+			int levelEnd = _levelEnds[0];
+			for (int i = 0; i < _levelEnds.Length; i++)
+			{
+				if (first < _levelEnds[i])
+				{
+					levelEnd = _levelEnds[i];
+					break;
+				}
+			}
+			return Math.Min(first + _nodeSize, levelEnd);
+		}
+
+		/// <summary> Squared distance from a point to the box of <paramref name="slot"/> on the x/z plane, 0 inside. </summary>
+		internal float DistanceSqrXZ(int slot, float x, float z)
+		{
+			int o = slot * STRIDE;
+			float dx = x < _boxes[o] ? _boxes[o] - x : x > _boxes[o + 3] ? x - _boxes[o + 3] : 0f;
+			float dz = z < _boxes[o + 2] ? _boxes[o + 2] - z : z > _boxes[o + 5] ? z - _boxes[o + 5] : 0f;
+			return dx * dx + dz * dz;
+		}
+
+		/// <summary> Distance along the ray to the box of <paramref name="slot"/>, 0 if the origin is inside, positive infinity if it misses. </summary>
+		internal float RayDistance(int slot, Vector3 origin, Vector3 inverseDirection)
+		{
+			int o = slot * STRIDE;
+			float tMin = 0f;
+			float tMax = float.PositiveInfinity;
+			for (int k = 0; k < 3; k++)
+			{
+				float start = origin[k];
+				float inverse = inverseDirection[k];
+				float t1 = (_boxes[o + k] - start) * inverse;
+				float t2 = (_boxes[o + 3 + k] - start) * inverse;
+				// parallel to the slab: NaN if the origin lies on a face, treat as inside
+				if (float.IsNaN(t1) || float.IsNaN(t2)) { continue; }
+				if (t1 > t2) { float t = t1; t1 = t2; t2 = t; }
+				tMin = Math.Max(tMin, t1);
+				tMax = Math.Min(tMax, t2);
+				if (tMin > tMax) { return float.PositiveInfinity; }
+			}
+			return tMin;
+		}
+
+		internal static Vector3 InverseDirection(Vector3 direction)
+		{
+			return new Vector3(1f / direction.x, 1f / direction.y, 1f / direction.z);
+		}
+
+		private Vector3 slotMin(int slot)
+		{
+			int o = slot * STRIDE;
+			return new Vector3(_boxes[o], _boxes[o + 1], _boxes[o + 2]);
+		}
+
+		private Vector3 slotMax(int slot)
+		{
+			int o = slot * STRIDE;
+			return new Vector3(_boxes[o + 3], _boxes[o + 4], _boxes[o + 5]);
+		}
+
+		/// <summary> Depth first traversal holds at most 'nodeSize' children per level. </summary>
+		private int[] getStack()
+		{
+			int size = _levelEnds.Length * _nodeSize + 1;
+			if (_stack == null || _stack.Length < size)
+			{
+				_stack = new int[Math.Max(size, 256)];
+			}
+			return _stack;
+		}
+
+		/// <summary>
+		/// Sort by x into vertical slices of about sqrt(leaves) leaves each, then every slice by z,
+		/// so consecutive items form compact leaves.
+		/// </summary>
+		private int[] sortTileRecursive(IList<Bounds> bounds)
+		{
+			int[] order = new int[_count];
+			float[] keys = new float[_count];
+			for (int i = 0; i < _count; i++)
+			{
+				order[i] = i;
+				keys[i] = bounds[i].center.x;
+			}
+			Array.Sort(keys, order);
+
+			int leaves = (_count + _nodeSize - 1) / _nodeSize;
+			int sliceSize = (int)Math.Ceiling(Math.Sqrt(leaves)) * _nodeSize;
+			for (int i = 0; i < _count; i++)
+			{
+				keys[i] = bounds[order[i]].center.z;
+			}
+			for (int start = 0; start < _count; start += sliceSize)
+			{
+				Array.Sort(keys, order, start, Math.Min(sliceSize, _count - start));
+			}
+			return order;
+		}
+	}
+}
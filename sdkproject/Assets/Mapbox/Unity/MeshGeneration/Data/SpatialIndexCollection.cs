@@ -0,0 +1,65 @@
+namespace Mapbox.Unity.MeshGeneration
+{
+	using UnityEngine;
+	using Mapbox.Map;
+	using Mapbox.Unity.MeshGeneration.Data;
+
+	/// <summary>
+	/// Spatial Index Collection keeps the features of all loaded tiles in a <see cref="FeatureSpatialIndex{T}"/>, for
+	/// queries like "all buildings within 100m of the player", "10 closest POIs" or "first building hit by this ray".
+	/// Unlike <see cref="KdTreeCollection"/> features are indexed per tile, bulk loaded once a tile is queried and
+	/// dropped when the tile unloads. Features are indexed by the world space bounds of their renderer, or their
+	/// position if they have no mesh, as of when they were added; queries can run off the main thread.
+	/// </summary>
+	[CreateAssetMenu(menuName = "Mapbox/Feature Collections/Spatial Index Collection")]
+	public class SpatialIndexCollection : FeatureCollectionBase
+	{
+		private FeatureSpatialIndex<VectorEntity> _entities;
+		public int Count;
+
+		/// <summary> Radius, nearest neighbour, box and ray queries, single or batched. </summary>
+		public FeatureSpatialIndex<VectorEntity> Index
+		{
+			get { return _entities; }
+		}
+
+		public override void Initialize()
+		{
+			base.Initialize();
+			_entities = new FeatureSpatialIndex<VectorEntity>();
+			Count = 0;
+		}
+
+		public override void AddFeature(double[] position, VectorEntity ve)
+		{
+			// features of unknown tiles share one entry and are only removed by 'Initialize()'
+			addEntity(ve, default(UnwrappedTileId));
+		}
+
+		public override void AddFeature(double[] position, VectorEntity ve, UnityTile tile)
+		{
+			addEntity(ve, tile.UnwrappedTileId);
+		}
+
+		public override void RemoveTile(UnityTile tile)
+		{
+			_entities.Remove(tile.UnwrappedTileId);
+			Count = _entities.Count;
+		}
+
+		private void addEntity(VectorEntity ve, UnwrappedTileId tileId)
+		{
+			Bounds bounds;
+			if (ve.MeshRenderer != null && ve.Mesh != null && ve.Mesh.vertexCount > 0)
+			{
+				bounds = ve.MeshRenderer.bounds;
+			}
+			else
+			{
+				bounds = new Bounds(ve.Transform.position, Vector3.zero);
+			}
+			_entities.Add(tileId, bounds, ve);
+			Count = _entities.Count;
+		}
+	}
+}
@@ -0,0 +1,261 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Threading;
+	using Mapbox.Map;
+	using Mapbox.Utils;
+
+	/// <summary>
+	/// Terrain-RGB tile of one <see cref="UnityTile"/> handed to <see cref="TerrainRgbDecoder"/>.
+	/// Heights and their <see cref="HeightPyramid"/> are decoded into pooled buffers on a worker thread
+	/// and handed to the tile on the main thread with <see cref="UnityTile.SetHeightData(HeightDataDecodeJob)"/>.
+	/// </summary>
+	public class HeightDataDecodeJob
+	{
+		public readonly UnityTile Tile;
+		/// <summary> Tile the data was requested for, the <see cref="UnityTile"/> may have been recycled since. </summary>
+		public readonly CanonicalTileId TileId;
+		public readonly byte[] Data;
+
+		/// <summary> False if the png uses a format the managed decoder doesn't support, callers fall back to <see cref="UnityTile.SetHeightData(byte[], float, bool, bool)"/>. </summary>
+		public bool Decoded { get; private set; }
+		public Exception Error { get; private set; }
+
+		internal float[] Heights;
+		internal HeightPyramid Pyramid;
+
+		private readonly float _scale;
+		private readonly object _lock = new object();
+		private volatile bool _done;
+		private volatile bool _canceled;
+
+		internal HeightDataDecodeJob(UnityTile tile, byte[] data, float scale)
+		{
+			Tile = tile;
+			TileId = tile.CanonicalTileId;
+			Data = data;
+			_scale = scale;
+		}
+
+		public bool IsDone { get { return _done; } }
+
+		public bool IsCanceled { get { return _canceled; } }
+
+		public void Cancel()
+		{
+			_canceled = true;
+		}
+
+		/// <summary> Block until the job has been decoded. </summary>
+		public void Wait()
+		{
+			lock (_lock)
+			{
+				while (!_done) { Monitor.Wait(_lock); }
+			}
+		}
+
+		/// <summary> Return the buffers to the pool if they weren't handed to a tile. </summary>
+		public void Release()
+		{
+			TerrainRgbDecoder.ReturnBuffers(this);
+		}
+
+		internal void Run(PngDecoder decoder)
+		{
+			try
+			{
+				if (!_canceled)
+				{
+					var trace = TileTrace.Begin(TileTraceStage.Decode, TileId);
+					TerrainRgbDecoder.RentBuffers(this);
+					Decoded = TerrainRgbDecoder.DecodeHeights(decoder, Data, Heights, _scale);
+					if (Decoded)
+					{
+						Pyramid.Build(Heights, TerrainRgbDecoder.SIZE);
+					}
+					trace.End();
+				}
+			}
+			catch (Exception ex)
+			{
+				Error = ex;
+			}
+			finally
+			{
+				lock (_lock)
+				{
+					_done = true;
+					Monitor.PulseAll(_lock);
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Decodes terrain-RGB pngs to heights in metres on background threads without going through a texture,
+	/// and builds the min/max <see cref="HeightPyramid"/> of each tile. On platforms without threads (WebGL) jobs are decoded synchronously.
+	/// </summary>
+	public static class TerrainRgbDecoder
+	{
+		/// <summary> Samples per side of <see cref="UnityTile.HeightData"/>. </summary>
+		public const int SIZE = 256;
+		private const int MAX_WORKERS = 2;
+		private const int MAX_POOLED = 16;
+
+		private static readonly object _lock = new object();
+		private static readonly Queue<HeightDataDecodeJob> _pending = new Queue<HeightDataDecodeJob>();
+		private static readonly Stack<float[]> _heightPool = new Stack<float[]>();
+		private static readonly Stack<HeightPyramid> _pyramidPool = new Stack<HeightPyramid>();
+		private static List<Thread> _workers;
+#if UNITY_WEBGL
+		private static PngDecoder _decoder;
+#endif
+
+		/// <summary> Number of worker threads, decoding a tile takes a few milliseconds so two are plenty. </summary>
+		public static int WorkerCount
+		{
+			get { return Math.Max(1, Math.Min(MAX_WORKERS, Environment.ProcessorCount - 1)); }
+		}
+
+		/// <summary> Jobs waiting for a worker. </summary>
+		public static int Pending
+		{
+			get { lock (_lock) { return _pending.Count; } }
+		}
+
+		/// <summary>
+		/// Queue decoding of the terrain-RGB png <paramref name="data"/> of <paramref name="tile"/>.
+		/// Must be called on the main thread, the height scale is read from the tile here.
+		/// </summary>
+		public static HeightDataDecodeJob Decode(UnityTile tile, byte[] data, float heightMultiplier = 1f, bool useRelative = false)
+		{
+			var job = new HeightDataDecodeJob(tile, data, tile.GetHeightScale(heightMultiplier, useRelative));
+#if UNITY_WEBGL
+			if (_decoder == null) { _decoder = new PngDecoder(); }
+			job.Run(_decoder);
+#else
+			lock (_lock)
+			{
+				if (_workers == null)
+				{
+					_workers = new List<Thread>();
+					for (int i = 0; i < WorkerCount; i++)
+					{
+						var worker = new Thread(work);
+						worker.IsBackground = true;
+						worker.Name = "TerrainRgbDecoder" + i;
+						worker.Start();
+						_workers.Add(worker);
+					}
+				}
+				_pending.Enqueue(job);
+				Monitor.Pulse(_lock);
+			}
+#endif
+			return job;
+		}
+
+		/// <summary>
+		/// Decode a terrain-RGB png into <paramref name="heights"/>, <see cref="SIZE"/> squared samples, bottom row first like the texture based decoding.
+		/// Images of other sizes are resampled to the nearest sample.
+		/// </summary>
+		/// <param name="scale">Height multiplier applied to the metres.</param>
+		/// <returns>False if the png format isn't supported.</returns>
+		public static bool DecodeHeights(PngDecoder decoder, byte[] png, float[] heights, float scale)
+		{
+			return decoder.Decode(png, (y, pixels, bpp) =>
+			{
+				// rows of the grid go bottom up, png rows top down
+				var height = decoder.Height;
+				var width = decoder.Width;
+				var rowStart = (y * SIZE + height - 1) / height;
+				var rowEnd = ((y + 1) * SIZE + height - 1) / height;
+				for (int row = rowStart; row < rowEnd && row < SIZE; row++)
+				{
+					var offset = (SIZE - 1 - row) * SIZE;
+					if (width == SIZE)
+					{
+						ConvertRow(pixels, bpp, heights, offset, scale);
+					}
+					else
+					{
+						for (int x = 0; x < SIZE; x++)
+						{
+							var p = (x * width / SIZE) * bpp;
+							heights[offset + x] = scale * (-10000f + ((pixels[p] << 16) | (pixels[p + 1] << 8) | pixels[p + 2]) * 0.1f);
+						}
+					}
+				}
+			});
+		}
+
+		/// <summary>
+		/// RGB to metres for one row of <see cref="SIZE"/> pixels: -10000 + (r * 65536 + g * 256 + b) * 0.1, times <paramref name="scale"/>.
+		/// The channels are packed into one integer, exact as a float, so results are bit identical to
+		/// <see cref="Mapbox.Unity.Utilities.Conversions.GetAbsoluteHeightFromColor(float, float, float)"/> on separate channels. Unrolled by four.
+		/// </summary>
+		public static void ConvertRow(byte[] pixels, int bpp, float[] heights, int offset, float scale)
+		{
+			int p = 0;
+			int x = 0;
+			for (; x + 4 <= SIZE; x += 4, p += bpp * 4)
+			{
+				int v0 = (pixels[p] << 16) | (pixels[p + 1] << 8) | pixels[p + 2];
+				int v1 = (pixels[p + bpp] << 16) | (pixels[p + bpp + 1] << 8) | pixels[p + bpp + 2];
+				int v2 = (pixels[p + bpp * 2] << 16) | (pixels[p + bpp * 2 + 1] << 8) | pixels[p + bpp * 2 + 2];
+				int v3 = (pixels[p + bpp * 3] << 16) | (pixels[p + bpp * 3 + 1] << 8) | pixels[p + bpp * 3 + 2];
+				heights[offset + x] = scale * (-10000f + v0 * 0.1f);
+				heights[offset + x + 1] = scale * (-10000f + v1 * 0.1f);
+				heights[offset + x + 2] = scale * (-10000f + v2 * 0.1f);
+				heights[offset + x + 3] = scale * (-10000f + v3 * 0.1f);
+			}
+			for (; x < SIZE; x++, p += bpp)
+			{
+				heights[offset + x] = scale * (-10000f + ((pixels[p] << 16) | (pixels[p + 1] << 8) | pixels[p + 2]) * 0.1f);
+			}
+		}
+
+		internal static void RentBuffers(HeightDataDecodeJob job)
+		{
+			lock (_heightPool)
+			{
+				job.Heights = _heightPool.Count > 0 ? _heightPool.Pop() : new float[SIZE * SIZE];
+				job.Pyramid = _pyramidPool.Count > 0 ? _pyramidPool.Pop() : new HeightPyramid();
+			}
+		}
+
+		internal static void ReturnBuffers(HeightDataDecodeJob job)
+		{
+			lock (_heightPool)
+			{
+				if (job.Heights != null && _heightPool.Count < MAX_POOLED)
+				{
+					_heightPool.Push(job.Heights);
+				}
+				if (job.Pyramid != null && _pyramidPool.Count < MAX_POOLED)
+				{
+					_pyramidPool.Push(job.Pyramid);
+				}
+				job.Heights = null;
+				job.Pyramid = null;
+			}
+		}
+
+		private static void work()
+		{
+			var decoder = new PngDecoder();
+			while (true)
+			{
+				HeightDataDecodeJob job;
+				lock (_lock)
+				{
+					while (_pending.Count == 0) { Monitor.Wait(_lock); }
+					job = _pending.Dequeue();
+				}
+				job.Run(decoder);
+			}
+		}
+	}
+}
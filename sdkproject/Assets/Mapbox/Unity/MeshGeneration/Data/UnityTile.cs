@@ -21,6 +21,7 @@ namespace Mapbox.Unity.MeshGeneration.Data
 		public VectorTile VectorData { get; private set; }
 		private Texture2D _heightTexture;
 		public float[] HeightData;
+		private HeightPyramid _heightPyramid;
 
 		private Texture2D _loadingTexture;
 		//keeping track of tile objects to be able to cancel them safely if tile is destroyed before data fetching finishes
@@ -230,6 +231,14 @@ namespace Mapbox.Unity.MeshGeneration.Data
 			_tiles.Clear();
 		}
 
+		/// <summary>
+		/// Min/max pyramid over <see cref="HeightData"/>, for height range queries and ray intersections without scanning the grid.
+		/// </summary>
+		public HeightPyramid HeightPyramid
+		{
+			get { return _heightPyramid; }
+		}
+
 		public void SetHeightData(byte[] data, float heightMultiplier = 1f, bool useRelative = false, bool addCollider = false)
 		{
 			if (HeightDataState != TilePropertyState.Unregistered)
@@ -238,11 +247,12 @@ namespace Mapbox.Unity.MeshGeneration.Data
 				if(data == null)
 				{
 					HeightData = new float[256 * 256];
+					BuildHeightPyramid();
 					HeightDataState = TilePropertyState.None;
 					return;
 				}
 
-				// HACK: compute height values for terrain. We could probably do this without a texture2d.
+				// Decoding through a texture on the main thread, only used for pngs TerrainRgbDecoder can't handle.
 				if (_heightTexture == null)
 				{
 					_heightTexture = new Texture2D(0, 0);
@@ -271,11 +281,48 @@ namespace Mapbox.Unity.MeshGeneration.Data
 						HeightData[xx * 256 + yy] = relativeScale * heightMultiplier * (-10000f + ((r * 65536f + g * 256f + b) * 0.1f));
 					}
 				}
+				BuildHeightPyramid();
 
+				HeightDataState = TilePropertyState.Loaded;
+			}
+		}
 
+		/// <summary>
+		/// Take the heights decoded by <see cref="TerrainRgbDecoder"/>. The job's buffers go back to the decoder's pool.
+		/// </summary>
+		public void SetHeightData(HeightDataDecodeJob job)
+		{
+			if (HeightDataState != TilePropertyState.Unregistered && job.Decoded)
+			{
+				if (HeightData == null || HeightData.Length != job.Heights.Length)
+				{
+					HeightData = new float[job.Heights.Length];
+				}
+				Array.Copy(job.Heights, HeightData, HeightData.Length);
+
+				//the job's pyramid was built from identical heights, swap it with ours
+				var pyramid = job.Pyramid;
+				pyramid.SetHeights(HeightData);
+				job.Pyramid = _heightPyramid;
+				_heightPyramid = pyramid;
 
 				HeightDataState = TilePropertyState.Loaded;
 			}
+			job.Release();
+		}
+
+		internal float GetHeightScale(float heightMultiplier, bool useRelative)
+		{
+			return (useRelative ? _relativeScale : 1f) * heightMultiplier;
+		}
+
+		private void BuildHeightPyramid()
+		{
+			if (_heightPyramid == null)
+			{
+				_heightPyramid = new HeightPyramid();
+			}
+			_heightPyramid.Build(HeightData, 256);
 		}
 
 		public void SetRasterData(byte[] data, bool useMipMap = true, bool useCompression = false)
@@ -286,7 +333,7 @@ namespace Mapbox.Unity.MeshGeneration.Data
 				//reset image on null data
 				if (data == null)
 				{
-					MeshRenderer.material.mainTexture = null;
+					MeshRenderer.sharedMaterial.mainTexture = null;
 					return;
 				}
 
@@ -353,9 +400,58 @@ namespace Mapbox.Unity.MeshGeneration.Data
 			return 0;
 		}
 
+		/// <summary>
+		/// Lowest and highest elevation between two corners given in [0-1] range like <see cref="QueryHeightData"/>,
+		/// answered from the height pyramid without visiting every sample.
+		/// </summary>
+		/// <returns>False if the tile has no height data.</returns>
+		public bool QueryHeightRange(float x0, float y0, float x1, float y1, out float min, out float max)
+		{
+			if (HeightData == null || _heightPyramid == null)
+			{
+				min = max = 0;
+				return false;
+			}
+
+			_heightPyramid.GetRange(x0, y0, x1, y1, out min, out max);
+			min *= _tileScale;
+			max *= _tileScale;
+			return true;
+		}
+
+		/// <summary>
+		/// Intersect a world space ray with the elevation of this tile, the surface elevated terrain meshes approximate.
+		/// Doesn't need a collider.
+		/// </summary>
+		public bool RaycastHeightData(Ray ray, out Vector3 point)
+		{
+			point = Vector3.zero;
+			if (HeightData == null || _heightPyramid == null)
+			{
+				return false;
+			}
+
+			//world to tile space to grid space: x and z scaled to samples, y to metres
+			var origin = transform.InverseTransformPoint(ray.origin);
+			var direction = transform.InverseTransformVector(ray.direction);
+			var sizeX = (float)Rect.Size.x * _tileScale;
+			var sizeY = (float)Rect.Size.y * _tileScale;
+			var last = _heightPyramid.Size - 1;
+			var gridOrigin = new Vector3((origin.x / sizeX + 0.5f) * last, origin.y / _tileScale, (origin.z / sizeY + 0.5f) * last);
+			var gridDirection = new Vector3(direction.x / sizeX * last, direction.y / _tileScale, direction.z / sizeY * last);
+
+			float distance;
+			if (!_heightPyramid.Raycast(gridOrigin, gridDirection, out distance))
+			{
+				return false;
+			}
+			point = transform.TransformPoint(origin + direction * distance);
+			return true;
+		}
+
 		public void SetLoadingTexture(Texture2D texture)
 		{
-			MeshRenderer.material.mainTexture = texture;
+			MeshRenderer.sharedMaterial.mainTexture = texture;
 		}
 
 		public Texture2D GetRasterData()
@@ -46,21 +46,27 @@ namespace Mapbox.Unity.MeshGeneration.Data
 			_rectSizex = tile.Rect.Size.x;
 			_rectSizey = tile.Rect.Size.y;
 
-			_geomCount = _geom.Count;
-			for (int i = 0; i < _geomCount; i++)
-			{
-				_pointCount = _geom[i].Count;
-				_newPoints = new List<Vector3>(_pointCount);
-				for (int j = 0; j < _pointCount; j++)
-				{
-					var point = _geom[i][j];
-					_newPoints.Add(new Vector3((float)(point.X / layerExtent * _rectSizex - (_rectSizex / 2)) * tile.TileScale, 0, (float)((layerExtent - point.Y) / layerExtent * _rectSizey - (_rectSizey / 2)) * tile.TileScale));
-				}
-				Points.Add(_newPoints);
-			}
+			project(new TileTransform(_rectSizex, _rectSizey, tile.TileScale, layerExtent));
 		}
 
 		public VectorFeatureUnity(VectorTileFeature feature, List<List<Point2d<float>>> geom, UnityTile tile, float layerExtent, bool buildingsWithUniqueIds = false)
+			: this(feature, geom, tile, layerExtent, tile.Rect.Size.x, tile.Rect.Size.y, tile.TileScale)
+		{
+		}
+
+		/// <summary>
+		/// Projects already decoded geometry to tile space without reading from <paramref name="tile"/>,
+		/// tile size and scale are passed in so this can run on worker threads.
+		/// </summary>
+		public VectorFeatureUnity(VectorTileFeature feature, List<List<Point2d<float>>> geom, UnityTile tile, float layerExtent, double rectSizeX, double rectSizeY, float tileScale)
+			: this(feature, geom, tile, new TileTransform(rectSizeX, rectSizeY, tileScale, layerExtent))
+		{
+		}
+
+		/// <summary>
+		/// Projects already decoded geometry to tile space with a transform computed once per tile and layer.
+		/// </summary>
+		public VectorFeatureUnity(VectorTileFeature feature, List<List<Point2d<float>>> geom, UnityTile tile, TileTransform transform)
 		{
 			Data = feature;
 			Properties = Data.GetProperties();
@@ -68,19 +74,17 @@ namespace Mapbox.Unity.MeshGeneration.Data
 			Tile = tile;
 			_geom = geom;
 
-			_rectSizex = tile.Rect.Size.x;
-			_rectSizey = tile.Rect.Size.y;
+			project(transform);
+		}
 
+		private void project(TileTransform transform)
+		{
 			_geomCount = _geom.Count;
 			for (int i = 0; i < _geomCount; i++)
 			{
 				_pointCount = _geom[i].Count;
 				_newPoints = new List<Vector3>(_pointCount);
-				for (int j = 0; j < _pointCount; j++)
-				{
-					var point = _geom[i][j];
-					_newPoints.Add(new Vector3((float)(point.X / layerExtent * _rectSizex - (_rectSizex / 2)) * tile.TileScale, 0, (float)((layerExtent - point.Y) / layerExtent * _rectSizey - (_rectSizey / 2)) * tile.TileScale));
-				}
+				transform.VectorTileToLocal(_geom[i], _newPoints);
 				Points.Add(_newPoints);
 			}
 		}
@@ -0,0 +1,276 @@
+namespace Mapbox.Unity.MeshGeneration.Data
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Threading;
+	using Mapbox.Map;
+	using Mapbox.Unity.MeshGeneration.Filters;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+	using Mapbox.VectorTile;
+	using Mapbox.VectorTile.Geometry;
+
+	/// <summary>
+	/// One vector layer of one tile handed to <see cref="VectorLayerDecoder"/>.
+	/// Everything the worker needs is captured on the main thread, the worker never touches Unity objects.
+	/// </summary>
+	public class VectorLayerDecodeJob
+	{
+		public readonly Mapbox.VectorTile.VectorTile VectorTile;
+		public readonly string LayerName;
+		public readonly UnityTile Tile;
+
+		/// <summary> Decoded layer, null if the tile doesn't contain it. Valid once <see cref="IsDone"/>. </summary>
+		public VectorTileLayer Layer { get; private set; }
+		/// <summary> Features projected to tile space that passed the filter, in layer order. Valid once <see cref="IsDone"/>. </summary>
+		public List<VectorFeatureUnity> Features { get; private set; }
+		/// <summary> Set if decoding or filtering threw, <see cref="Features"/> holds what was decoded until then. </summary>
+		public Exception Error { get; private set; }
+
+		private readonly bool _buildingsWithUniqueIds;
+		private readonly ILayerFeatureFilterComparer _filter;
+		private readonly CompiledLayerFilter _compiledFilter;
+		private readonly double _rectSizeX;
+		private readonly double _rectSizeY;
+		private readonly float _tileScale;
+		private readonly CanonicalTileId _tileId;
+		private readonly object _lock = new object();
+		private volatile bool _done;
+		private volatile bool _canceled;
+
+		/// <param name="filter">
+		/// Combined layer filter, null to keep every feature. Pass a <see cref="CompiledLayerFilter"/>, compiled once per layer,
+		/// to filter on the tags of the features, other filters run on the decoded properties.
+		/// </param>
+		public VectorLayerDecodeJob(Mapbox.VectorTile.VectorTile vectorTile, string layerName, UnityTile tile, bool buildingsWithUniqueIds, ILayerFeatureFilterComparer filter)
+			: this(tile, buildingsWithUniqueIds, filter)
+		{
+			VectorTile = vectorTile;
+			LayerName = layerName;
+		}
+
+		/// <summary> Job for a layer that has already been read from its tile, only features are decoded. </summary>
+		public VectorLayerDecodeJob(VectorTileLayer layer, UnityTile tile, bool buildingsWithUniqueIds, ILayerFeatureFilterComparer filter)
+			: this(tile, buildingsWithUniqueIds, filter)
+		{
+			Layer = layer;
+			LayerName = null == layer ? null : layer.Name;
+		}
+
+		private VectorLayerDecodeJob(UnityTile tile, bool buildingsWithUniqueIds, ILayerFeatureFilterComparer filter)
+		{
+			Tile = tile;
+			Features = new List<VectorFeatureUnity>();
+			_buildingsWithUniqueIds = buildingsWithUniqueIds;
+			_filter = filter;
+			// compiling is up to the caller, the job only binds the compiled filter to its layer
+			_compiledFilter = filter as CompiledLayerFilter;
+			_rectSizeX = tile.Rect.Size.x;
+			_rectSizeY = tile.Rect.Size.y;
+			_tileScale = tile.TileScale;
+			_tileId = tile.CanonicalTileId;
+		}
+
+		public bool IsDone { get { return _done; } }
+
+		public bool IsCanceled { get { return _canceled; } }
+
+		/// <summary> Stop decoding as soon as possible, results are dropped. </summary>
+		public void Cancel()
+		{
+			_canceled = true;
+		}
+
+		/// <summary> Block until the job has been decoded. </summary>
+		public void Wait()
+		{
+			lock (_lock)
+			{
+				while (!_done) { Monitor.Wait(_lock); }
+			}
+		}
+
+		internal void Run()
+		{
+			try
+			{
+				if (!_canceled)
+				{
+					TileTraceTimer trace = TileTrace.Begin(TileTraceStage.Decode, _tileId);
+					decode();
+					trace.End();
+				}
+			}
+			catch (Exception ex)
+			{
+				Error = ex;
+			}
+			finally
+			{
+				TileTrace.FlushPending(_tileId);
+				lock (_lock)
+				{
+					_done = true;
+					Monitor.PulseAll(_lock);
+				}
+			}
+		}
+
+		private void decode()
+		{
+			if (null == Layer && null != VectorTile)
+			{
+				Layer = VectorTile.GetLayer(LayerName);
+			}
+			if (null == Layer)
+			{
+				return;
+			}
+
+			// built in filters run on the tags, before geometry and properties of rejected features are decoded
+			CompiledLayerFilter.LayerTagFilter tagFilter = null;
+			if (null != _compiledFilter)
+			{
+				tagFilter = _compiledFilter.ForLayer(Layer);
+				if (tagFilter.RejectsAll)
+				{
+					return;
+				}
+				if (tagFilter.AcceptsAll)
+				{
+					tagFilter = null;
+				}
+			}
+
+			float layerExtent = Layer.Extent;
+			var transform = new TileTransform(_rectSizeX, _rectSizeY, _tileScale, layerExtent);
+			int featureCount = Layer.FeatureCount();
+			for (int i = 0; i < featureCount; i++)
+			{
+				if (_canceled)
+				{
+					return;
+				}
+
+				var fe = Layer.GetFeature(i);
+				if (null != tagFilter)
+				{
+					TileTraceTimer filterTrace = TileTrace.BeginPending(TileTraceStage.Filter);
+					bool accepted = tagFilter.Try(fe);
+					filterTrace.End();
+					if (!accepted)
+					{
+						continue;
+					}
+				}
+				List<List<Point2d<float>>> geom;
+				if (_buildingsWithUniqueIds) //ids from building dataset is big ulongs
+				{
+					geom = fe.Geometry<float>(); //and we're not clipping by passing no parameters
+
+					if (geom.Count == 0 || geom[0].Count == 0 || geom[0][0].X < 0 || geom[0][0].X > layerExtent || geom[0][0].Y < 0 || geom[0][0].Y > layerExtent)
+					{
+						continue;
+					}
+				}
+				else //streets ids, will require clipping
+				{
+					geom = fe.Geometry<float>(0); //passing zero means clip at tile edge
+				}
+
+				var feature = new VectorFeatureUnity(fe, geom, Tile, transform);
+				if (_filter == null || null != _compiledFilter)
+				{
+					Features.Add(feature);
+					continue;
+				}
+
+				TileTraceTimer customTrace = TileTrace.BeginPending(TileTraceStage.Filter);
+				bool passed = _filter.Try(feature);
+				customTrace.End();
+				if (passed)
+				{
+					Features.Add(feature);
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Decodes vector tile layers on background threads: protobuf decoding, projection to tile space and filtering.
+	/// Callers poll <see cref="VectorLayerDecodeJob.IsDone"/> and only build meshes and game objects on the main thread.
+	/// On platforms without threads (WebGL) jobs are decoded synchronously.
+	/// </summary>
+	public static class VectorLayerDecoder
+	{
+		private const int MAX_WORKERS = 4;
+
+		private static readonly object _lock = new object();
+		private static readonly Queue<VectorLayerDecodeJob> _pending = new Queue<VectorLayerDecodeJob>();
+		private static List<Thread> _workers;
+
+		/// <summary> Number of worker threads, one less than the cores to leave the main thread alone. </summary>
+		public static int WorkerCount
+		{
+			get { return Math.Max(1, Math.Min(MAX_WORKERS, Environment.ProcessorCount - 1)); }
+		}
+
+		/// <summary> Jobs waiting for a worker. </summary>
+		public static int Pending
+		{
+			get { lock (_lock) { return _pending.Count; } }
+		}
+
+		/// <summary> Queue decoding of layer <paramref name="layerName"/> of <paramref name="vectorTile"/>. </summary>
+		public static VectorLayerDecodeJob Decode(Mapbox.VectorTile.VectorTile vectorTile, string layerName, UnityTile tile, bool buildingsWithUniqueIds, ILayerFeatureFilterComparer filter)
+		{
+			return enqueue(new VectorLayerDecodeJob(vectorTile, layerName, tile, buildingsWithUniqueIds, filter));
+		}
+
+		/// <summary> Queue decoding of the features of an already read <paramref name="layer"/>. </summary>
+		public static VectorLayerDecodeJob Decode(VectorTileLayer layer, UnityTile tile, bool buildingsWithUniqueIds, ILayerFeatureFilterComparer filter)
+		{
+			return enqueue(new VectorLayerDecodeJob(layer, tile, buildingsWithUniqueIds, filter));
+		}
+
+		private static VectorLayerDecodeJob enqueue(VectorLayerDecodeJob job)
+		{
+#if UNITY_WEBGL
+			job.Run();
+#else
+			lock (_lock)
+			{
+				if (_workers == null)
+				{
+					_workers = new List<Thread>();
+					for (int i = 0; i < WorkerCount; i++)
+					{
+						var worker = new Thread(work);
+						worker.IsBackground = true;
+						worker.Name = "VectorLayerDecoder" + i;
+						worker.Start();
+						_workers.Add(worker);
+					}
+				}
+				_pending.Enqueue(job);
+				Monitor.Pulse(_lock);
+			}
+#endif
+			return job;
+		}
+
+		private static void work()
+		{
+			while (true)
+			{
+				VectorLayerDecodeJob job;
+				lock (_lock)
+				{
+					while (_pending.Count == 0) { Monitor.Wait(_lock); }
+					job = _pending.Dequeue();
+				}
+				job.Run();
+			}
+		}
+	}
+}
@@ -95,6 +95,26 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 			}
 		}
 
+		/// <summary>
+		/// Fetch the data this factory loads for <paramref name="tileId"/> into the cache without building a tile, for tiles
+		/// that are likely to be shown soon.
+		/// </summary>
+		/// <returns>Null if the data is cached already or the factory doesn't load any with its current settings.</returns>
+		public virtual IAsyncRequest Prefetch(CanonicalTileId tileId, Action<Response> callback)
+		{
+			return null;
+		}
+
+		protected IAsyncRequest PrefetchResource(TileResource resource, CanonicalTileId tileId, string tilesetId, Action<Response> callback)
+		{
+			var mapboxAccess = _fileSource as MapboxAccess;
+			if (mapboxAccess == null || string.IsNullOrEmpty(tilesetId))
+			{
+				return null;
+			}
+			return mapboxAccess.Prefetch(resource.GetUrl(), callback, tileId, tilesetId);
+		}
+
 		protected abstract void OnInitialized();
 
 		protected abstract void OnRegistered(UnityTile tile);
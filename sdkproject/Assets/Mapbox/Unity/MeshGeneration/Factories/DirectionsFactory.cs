@@ -142,11 +142,9 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 
 			var totalLength = 0f;
 			Vector3 prevPoint = Unity.Constants.Math.Vector3Zero;
-			foreach (var point in response.Routes[0].Geometry)
+			Conversions.GeoToWorldPosition(response.Routes[0].Geometry, _map.CenterMercator, _map.WorldRelativeScale, unitySpacePositions);
+			foreach (var newPoint in unitySpacePositions)
 			{
-				var newPoint = Conversions.GeoToWorldPosition(point.x, point.y, _map.CenterMercator, _map.WorldRelativeScale).ToVector3xz();
-				unitySpacePositions.Add(newPoint);
-
 				if (prevPoint != Unity.Constants.Math.Vector3Zero)
 				{
 					totalLength += Vector3.Distance(prevPoint, newPoint);
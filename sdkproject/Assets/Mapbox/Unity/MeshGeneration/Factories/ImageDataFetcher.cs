@@ -32,7 +32,7 @@ public class ImageDataFetcher : DataFetcher
 			imageDataParameters.tile.AddTile(rasterTile);
 		}
 
-		rasterTile.Initialize(_fileSource, imageDataParameters.canonicalTileId, imageDataParameters.tilesetId, () =>
+		rasterTile.Initialize(FileSource, imageDataParameters.canonicalTileId, imageDataParameters.tilesetId, () =>
 		{
 			if (imageDataParameters.tile != null && imageDataParameters.tile.CanonicalTileId != rasterTile.Id)
 			{
@@ -2,11 +2,13 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 {
 	using System;
 	using Mapbox.Map;
+	using Mapbox.Platform;
 	using UnityEngine;
 	using Mapbox.Unity.MeshGeneration.Enums;
 	using Mapbox.Unity.MeshGeneration.Data;
 	using Mapbox.Unity.Utilities;
 	using Mapbox.Unity.Map;
+	using Mapbox.Utils;
 	using System.Collections.Generic;
 
 	public enum MapImageType
@@ -68,7 +70,9 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 
 				if (tile.RasterDataState != TilePropertyState.Unregistered)
 				{
+					var trace = TileTrace.Begin(TileTraceStage.Raster, tile.CanonicalTileId);
 					tile.SetRasterData(rasterTile.Data, _properties.rasterOptions.useMipMap, _properties.rasterOptions.useCompression);
+					trace.End();
 				}
 			}
 		}
@@ -93,6 +97,7 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 		protected override void OnInitialized()
 		{
 			DataFetcher = ScriptableObject.CreateInstance<ImageDataFetcher>();
+			DataFetcher.FileSource = _fileSource;
 			DataFetcher.DataRecieved += OnImageRecieved;
 			DataFetcher.FetchingError += OnDataError;
 		}
@@ -128,6 +133,27 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 			}
 		}
 
+		public override IAsyncRequest Prefetch(CanonicalTileId tileId, Action<Response> callback)
+		{
+			if (_properties.sourceType == ImagerySourceType.None)
+			{
+				return null;
+			}
+
+			//same resources as ImageDataFetcher
+			var tilesetId = TilesetId;
+			TileResource resource;
+			if (tilesetId.StartsWith("mapbox://", StringComparison.Ordinal))
+			{
+				resource = _properties.rasterOptions.useRetina ? TileResource.MakeRetinaRaster(tileId, tilesetId) : TileResource.MakeRaster(tileId, tilesetId);
+			}
+			else
+			{
+				resource = _properties.rasterOptions.useRetina ? TileResource.MakeClassicRetinaRaster(tileId, tilesetId) : TileResource.MakeClassicRaster(tileId, tilesetId);
+			}
+			return PrefetchResource(resource, tileId, tilesetId, callback);
+		}
+
 		/// <summary>
 		/// Method to be called when a tile error has occurred.
 		/// </summary>
@@ -1,4 +1,5 @@
 ﻿using Mapbox.Map;
+using Mapbox.Platform;
 using Mapbox.Unity;
 using Mapbox.Unity.Map;
 using Mapbox.Unity.MeshGeneration.Data;
@@ -32,11 +33,44 @@ public class VectorDataFetcherParameters : DataFetcherParameters
 
 public abstract class DataFetcher : ScriptableObject
 {
-	protected MapboxAccess _fileSource;
+	private IFileSource _source;
 
+	/// <summary>
+	/// Where tiles are requested from, <see cref="MapboxAccess.Instance"/> unless the factory was initialized with another
+	/// source, eg an <see cref="Mapbox.Platform.Cache.OfflineFileSource"/> replaying recorded tiles.
+	/// </summary>
+	public IFileSource FileSource
+	{
+		get
+		{
+			if (_source == null)
+			{
+				_source = MapboxAccess.Instance;
+			}
+			return _source;
+		}
+		set
+		{
+			_source = value;
+		}
+	}
+
+	/// <summary>
+	/// Kept for fetchers written against earlier versions. Null if <see cref="FileSource"/> isn't a <see cref="MapboxAccess"/>.
+	/// </summary>
+	[Obsolete("Use FileSource, it also returns sources other than MapboxAccess.")]
+	protected MapboxAccess _fileSource
+	{
+		get { return FileSource as MapboxAccess; }
+		set { FileSource = value; }
+	}
+
+	/// <summary>
+	/// Does nothing: <see cref="FileSource"/> is resolved on first use, so fetchers can be created without touching <see cref="MapboxAccess"/>.
+	/// </summary>
+	[Obsolete("FileSource is resolved on first use, OnEnable doesn't need to be called.")]
 	public void OnEnable()
 	{
-		_fileSource = MapboxAccess.Instance;
 	}
 
 	public abstract void FetchData(DataFetcherParameters parameters);
@@ -60,7 +94,7 @@ public class TerrainDataFetcher : DataFetcher
 		{
 			terrainDataParameters.tile.AddTile(pngRasterTile);
 		}
-		pngRasterTile.Initialize(_fileSource, terrainDataParameters.canonicalTileId, terrainDataParameters.tilesetId, () =>
+		pngRasterTile.Initialize(FileSource, terrainDataParameters.canonicalTileId, terrainDataParameters.tilesetId, () =>
 		{
 			if (terrainDataParameters.tile != null && terrainDataParameters.tile.CanonicalTileId != pngRasterTile.Id)
 			{
@@ -4,8 +4,11 @@ using UnityEngine;
 using Mapbox.Unity.MeshGeneration.Data;
 using Mapbox.Unity.Map;
 using Mapbox.Map;
+using Mapbox.Platform;
 using Mapbox.Unity.MeshGeneration.Enums;
 using Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies;
+using Mapbox.Unity.Utilities;
+using Mapbox.Utils;
 using System;
 using System.Collections.Generic;
 
@@ -17,6 +20,8 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 		[SerializeField]
 		protected ElevationLayerProperties _elevationOptions = new ElevationLayerProperties();
 		protected TerrainDataFetcher DataFetcher;
+		//height data being decoded on worker threads
+		private Dictionary<UnityTile, HeightDataDecodeJob> _activeDecodes = new Dictionary<UnityTile, HeightDataDecodeJob>();
 
 		public TerrainDataFetcher GetFetcher()
 		{
@@ -47,6 +52,7 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 		{
 			Strategy.Initialize(_elevationOptions);
 			DataFetcher = ScriptableObject.CreateInstance<TerrainDataFetcher>();
+			DataFetcher.FileSource = _fileSource;
 			DataFetcher.DataRecieved += OnTerrainRecieved;
 			DataFetcher.FetchingError += OnDataError;
 		}
@@ -83,22 +89,45 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 			{
 				//reseting height data
 				tile.SetHeightData(null);
+				var trace = TileTrace.Begin(TileTraceStage.Terrain, tile.CanonicalTileId);
 				Strategy.RegisterTile(tile);
+				trace.End();
 				tile.HeightDataState = TilePropertyState.Loaded;
 			}
 		}
 
+		public override IAsyncRequest Prefetch(CanonicalTileId tileId, Action<Response> callback)
+		{
+			if (Properties.sourceType == ElevationSourceType.None || !(Strategy is IElevationBasedTerrainStrategy))
+			{
+				return null;
+			}
+			var tilesetId = _elevationOptions.sourceOptions.Id;
+			return PrefetchResource(TileResource.MakeRawPngRaster(tileId, tilesetId), tileId, tilesetId, callback);
+		}
+
 		protected override void OnUnregistered(UnityTile tile)
 		{
 			if (_tilesWaitingResponse != null && _tilesWaitingResponse.Contains(tile))
 			{
 				_tilesWaitingResponse.Remove(tile);
 			}
+			HeightDataDecodeJob job;
+			if (_activeDecodes.TryGetValue(tile, out job))
+			{
+				job.Cancel();
+				_activeDecodes.Remove(tile);
+			}
 			Strategy.UnregisterTile(tile);
 		}
 
 		public override void Clear()
 		{
+			foreach (var job in _activeDecodes.Values)
+			{
+				job.Cancel();
+			}
+			_activeDecodes.Clear();
 			DestroyImmediate(DataFetcher);
 		}
 
@@ -126,12 +155,68 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 
 				if (tile.HeightDataState != TilePropertyState.Unregistered)
 				{
-					tile.SetHeightData(pngRasterTile.Data, _elevationOptions.requiredOptions.exaggerationFactor, _elevationOptions.modificationOptions.useRelativeHeight, _elevationOptions.colliderOptions.addCollider);
-					Strategy.RegisterTile(tile);
+					var job = TerrainRgbDecoder.Decode(tile, pngRasterTile.Data, _elevationOptions.requiredOptions.exaggerationFactor, _elevationOptions.modificationOptions.useRelativeHeight);
+					HeightDataDecodeJob previous;
+					if (_activeDecodes.TryGetValue(tile, out previous))
+					{
+						previous.Cancel();
+					}
+					_activeDecodes[tile] = job;
+
+					if (Application.isEditor && !Application.isPlaying)
+					{
+						job.Wait();
+						OnHeightDataDecoded(job);
+					}
+					else
+					{
+						Runnable.Run(WaitForHeightData(job));
+					}
 				}
+			}
+		}
+
+		private IEnumerator WaitForHeightData(HeightDataDecodeJob job)
+		{
+			while (!job.IsDone)
+			{
+				yield return null;
+			}
+			OnHeightDataDecoded(job);
+		}
 
+		private void OnHeightDataDecoded(HeightDataDecodeJob job)
+		{
+			var tile = job.Tile;
+			HeightDataDecodeJob active;
+			if (_activeDecodes.TryGetValue(tile, out active) && active == job)
+			{
+				_activeDecodes.Remove(tile);
+			}
+			if (tile == null || job.IsCanceled || active != job
+				|| tile.HeightDataState == TilePropertyState.Unregistered || tile.CanonicalTileId != job.TileId)
+			{
+				//tile was recycled or got newer data in the meantime
+				job.Release();
+				return;
+			}
 
+			if (job.Decoded)
+			{
+				tile.SetHeightData(job);
+			}
+			else
+			{
+				if (job.Error != null)
+				{
+					Debug.LogWarning("Decoding height data of " + job.TileId + " failed, decoding through a texture instead: " + job.Error.Message);
+				}
+				job.Release();
+				tile.SetHeightData(job.Data, _elevationOptions.requiredOptions.exaggerationFactor, _elevationOptions.modificationOptions.useRelativeHeight, _elevationOptions.colliderOptions.addCollider);
 			}
+			var trace = TileTrace.Begin(TileTraceStage.Terrain, tile.CanonicalTileId);
+			Strategy.RegisterTile(tile);
+			trace.End();
 		}
 
 		private void OnDataError(UnityTile tile, RawPngRasterTile rawTile, TileErrorEventArgs e)
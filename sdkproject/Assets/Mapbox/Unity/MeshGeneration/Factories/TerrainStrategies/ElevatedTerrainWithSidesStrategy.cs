@@ -9,18 +9,16 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 {
 	public class ElevatedTerrainWithSidesStrategy : TerrainStrategy, IElevationBasedTerrainStrategy
 	{
-		Mesh _stitchTarget;
-
 		protected Dictionary<UnwrappedTileId, Mesh> _meshData;
 		private MeshData _currentTileMeshData;
-		private MeshData _stitchTargetMeshData;
+		private TerrainMeshGrid _grid;
+		private Vector3[] _gridVertices;
+		private Vector3[] _gridNormals;
 
 		private List<Vector3> _newVertexList;
 		private List<Vector3> _newNormalList;
 		private List<Vector2> _newUvList;
 		private List<int> _newTriangleList;
-		private Vector3 _newDir;
-		private int _vertA, _vertB, _vertC;
 		private int _counter;
 		public override int RequiredVertexCount
 		{
@@ -34,7 +32,7 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 
 			_meshData = new Dictionary<UnwrappedTileId, Mesh>();
 			_currentTileMeshData = new MeshData();
-			_stitchTargetMeshData = new MeshData();
+			_grid = null;
 			var sampleCountSquare = _elevationOptions.modificationOptions.sampleCount * _elevationOptions.modificationOptions.sampleCount;
 			_newVertexList = new List<Vector3>(sampleCountSquare);
 			_newNormalList = new List<Vector3>(sampleCountSquare);
@@ -253,65 +251,31 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 			tile.MeshFilter.sharedMesh.GetNormals(_currentTileMeshData.Normals);
 
 			var _sampleCount = _elevationOptions.modificationOptions.sampleCount;
-			int sideStart = _sampleCount * _sampleCount;
-			for (float y = 0; y < _sampleCount; y++)
+			if (_grid == null || _grid.SampleCount != _sampleCount)
 			{
-				for (float x = 0; x < _sampleCount; x++)
-				{
-					_currentTileMeshData.Vertices[(int)(y * _sampleCount + x)] = new Vector3(
-						_currentTileMeshData.Vertices[(int)(y * _sampleCount + x)].x,
-						tile.QueryHeightData(x / (_sampleCount - 1), 1 - y / (_sampleCount - 1)),
-						_currentTileMeshData.Vertices[(int)(y * _sampleCount + x)].z);
-					_currentTileMeshData.Normals[(int)(y * _sampleCount + x)] = Mapbox.Unity.Constants.Math.Vector3Zero;
-
-					if (y == 0)
-					{
-						_currentTileMeshData.Vertices[(int)(sideStart + 8 * x)] = _currentTileMeshData.Vertices[(int)(y * _sampleCount + x)];
-					}
-					else if (y == _sampleCount - 1)
-					{
-						_currentTileMeshData.Vertices[(int)(sideStart + 8 * x + 6)] = _currentTileMeshData.Vertices[(int)(y * _sampleCount + x)];
-					}
-
-					if (x == 0)
-					{
-						_currentTileMeshData.Vertices[(int)(sideStart + 8 * y + 2)] = _currentTileMeshData.Vertices[(int)(y * _sampleCount + x)];
-					}
-					else if (x == _sampleCount - 1)
-					{
-						_currentTileMeshData.Vertices[(int)(sideStart + 8 * y + 4)] = _currentTileMeshData.Vertices[(int)(y * _sampleCount + x)];
-					}
-				}
+				//side walls cover the cracks between tiles, no skirts needed
+				_grid = TerrainMeshGrid.Get(_sampleCount, false);
+				_gridVertices = new Vector3[_grid.VertexCount];
+				_gridNormals = new Vector3[_grid.VertexCount];
 			}
+			_grid.Build(tile, _gridVertices, _gridNormals);
 
-			tile.MeshFilter.sharedMesh.SetVertices(_currentTileMeshData.Vertices);
-
-			for (int y = 0; y < _sampleCount - 1; y++)
+			int sideStart = _sampleCount * _sampleCount;
+			for (int i = 0; i < sideStart; i++)
 			{
-				for (int x = 0; x < _sampleCount - 1; x++)
-				{
-					_vertA = (y * _sampleCount) + x;
-					_vertB = (y * _sampleCount) + x + _sampleCount + 1;
-					_vertC = (y * _sampleCount) + x + _sampleCount;
-					_newDir = Vector3.Cross(_currentTileMeshData.Vertices[_vertB] - _currentTileMeshData.Vertices[_vertA], _currentTileMeshData.Vertices[_vertC] - _currentTileMeshData.Vertices[_vertA]);
-					_currentTileMeshData.Normals[_vertA] += _newDir;
-					_currentTileMeshData.Normals[_vertB] += _newDir;
-					_currentTileMeshData.Normals[_vertC] += _newDir;
-
-					_vertA = (y * _sampleCount) + x;
-					_vertB = (y * _sampleCount) + x + 1;
-					_vertC = (y * _sampleCount) + x + _sampleCount + 1;
-					_newDir = Vector3.Cross(_currentTileMeshData.Vertices[_vertB] - _currentTileMeshData.Vertices[_vertA], _currentTileMeshData.Vertices[_vertC] - _currentTileMeshData.Vertices[_vertA]);
-					_currentTileMeshData.Normals[_vertA] += _newDir;
-					_currentTileMeshData.Normals[_vertB] += _newDir;
-					_currentTileMeshData.Normals[_vertC] += _newDir;
-				}
+				_currentTileMeshData.Vertices[i] = _gridVertices[i];
+				_currentTileMeshData.Normals[i] = _gridNormals[i];
+			}
+			for (int i = 0; i < _sampleCount; i++)
+			{
+				_currentTileMeshData.Vertices[sideStart + 8 * i] = _gridVertices[i];
+				_currentTileMeshData.Vertices[sideStart + 8 * i + 2] = _gridVertices[i * _sampleCount];
+				_currentTileMeshData.Vertices[sideStart + 8 * i + 4] = _gridVertices[i * _sampleCount + _sampleCount - 1];
+				_currentTileMeshData.Vertices[sideStart + 8 * i + 6] = _gridVertices[(_sampleCount - 1) * _sampleCount + i];
 			}
 
-			FixStitches(tile.UnwrappedTileId, _currentTileMeshData);
-
-			tile.MeshFilter.sharedMesh.SetNormals(_currentTileMeshData.Normals);
 			tile.MeshFilter.sharedMesh.SetVertices(_currentTileMeshData.Vertices);
+			tile.MeshFilter.sharedMesh.SetNormals(_currentTileMeshData.Normals);
 
 			tile.MeshFilter.sharedMesh.RecalculateBounds();
 
@@ -357,178 +321,5 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 				tile.MeshFilter.sharedMesh.RecalculateBounds();
 			}
 		}
-
-		/// <summary>
-		/// Checkes all neighbours of the given tile and stitches the edges to achieve a smooth mesh surface.
-		/// </summary>
-		/// <param name="tileId"></param>
-		/// <param name="mesh"></param>
-		private void FixStitches(UnwrappedTileId tileId, MeshData mesh)
-		{
-			var _sampleCount = _elevationOptions.modificationOptions.sampleCount;
-			var meshVertCount = _sampleCount * _sampleCount;
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.North, out _stitchTarget);
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-				for (int i = 0; i < _sampleCount; i++)
-				{
-					//just snapping the y because vertex pos is relative and we'll have to do tile pos + vertex pos for x&z otherwise
-					mesh.Vertices[i] = new Vector3(
-						mesh.Vertices[i].x,
-						_stitchTargetMeshData.Vertices[meshVertCount - _sampleCount + i].y,
-						mesh.Vertices[i].z);
-					mesh.Vertices[meshVertCount + (8 * i)] = mesh.Vertices[i];
-
-					mesh.Normals[i] = new Vector3(_stitchTargetMeshData.Normals[meshVertCount - _sampleCount + i].x,
-						_stitchTargetMeshData.Normals[meshVertCount - _sampleCount + i].y,
-						_stitchTargetMeshData.Normals[meshVertCount - _sampleCount + i].z);
-				}
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.South, out _stitchTarget);
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-				for (int i = 0; i < _sampleCount; i++)
-				{
-					mesh.Vertices[meshVertCount - _sampleCount + i] = new Vector3(
-						mesh.Vertices[meshVertCount - _sampleCount + i].x,
-						_stitchTargetMeshData.Vertices[i].y,
-						mesh.Vertices[meshVertCount - _sampleCount + i].z);
-					mesh.Vertices[meshVertCount + 6 + (8 * i)] = mesh.Vertices[meshVertCount - _sampleCount + i];
-
-					mesh.Normals[meshVertCount - _sampleCount + i] = new Vector3(
-						_stitchTargetMeshData.Normals[i].x,
-						_stitchTargetMeshData.Normals[i].y,
-						_stitchTargetMeshData.Normals[i].z);
-				}
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.West, out _stitchTarget);
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-
-				for (int i = 0; i < _sampleCount; i++)
-				{
-					mesh.Vertices[i * _sampleCount] = new Vector3(
-						mesh.Vertices[i * _sampleCount].x,
-						_stitchTargetMeshData.Vertices[i * _sampleCount + _sampleCount - 1].y,
-						mesh.Vertices[i * _sampleCount].z);
-					mesh.Vertices[meshVertCount + 2 + (8 * i)] = mesh.Vertices[i * _sampleCount];
-
-					mesh.Normals[i * _sampleCount] = new Vector3(
-						_stitchTargetMeshData.Normals[i * _sampleCount + _sampleCount - 1].x,
-						_stitchTargetMeshData.Normals[i * _sampleCount + _sampleCount - 1].y,
-						_stitchTargetMeshData.Normals[i * _sampleCount + _sampleCount - 1].z);
-				}
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.East, out _stitchTarget);
-
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-
-				for (int i = 0; i < _sampleCount; i++)
-				{
-					mesh.Vertices[i * _sampleCount + _sampleCount - 1] = new Vector3(
-						mesh.Vertices[i * _sampleCount + _sampleCount - 1].x,
-						_stitchTargetMeshData.Vertices[i * _sampleCount].y,
-						mesh.Vertices[i * _sampleCount + _sampleCount - 1].z);
-					mesh.Vertices[meshVertCount + 4 + (8 * i)] = mesh.Vertices[i * _sampleCount + _sampleCount - 1];
-
-					mesh.Normals[i * _sampleCount + _sampleCount - 1] = new Vector3(
-						_stitchTargetMeshData.Normals[i * _sampleCount].x,
-						_stitchTargetMeshData.Normals[i * _sampleCount].y,
-						_stitchTargetMeshData.Normals[i * _sampleCount].z);
-				}
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.NorthWest, out _stitchTarget);
-
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-
-				mesh.Vertices[0] = new Vector3(
-					mesh.Vertices[0].x,
-					_stitchTargetMeshData.Vertices[meshVertCount - 1].y,
-					mesh.Vertices[0].z);
-
-				mesh.Normals[0] = new Vector3(
-					_stitchTargetMeshData.Normals[meshVertCount - 1].x,
-					_stitchTargetMeshData.Normals[meshVertCount - 1].y,
-					_stitchTargetMeshData.Normals[meshVertCount - 1].z);
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.NorthEast, out _stitchTarget);
-
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-
-				mesh.Vertices[_sampleCount - 1] = new Vector3(
-					mesh.Vertices[_sampleCount - 1].x,
-					_stitchTargetMeshData.Vertices[meshVertCount - _sampleCount].y,
-					mesh.Vertices[_sampleCount - 1].z);
-
-				mesh.Normals[_sampleCount - 1] = new Vector3(
-					_stitchTargetMeshData.Normals[meshVertCount - _sampleCount].x,
-					_stitchTargetMeshData.Normals[meshVertCount - _sampleCount].y,
-					_stitchTargetMeshData.Normals[meshVertCount - _sampleCount].z);
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.SouthWest, out _stitchTarget);
-
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-
-				mesh.Vertices[meshVertCount - _sampleCount] = new Vector3(
-					mesh.Vertices[meshVertCount - _sampleCount].x,
-					_stitchTargetMeshData.Vertices[_sampleCount - 1].y,
-					mesh.Vertices[meshVertCount - _sampleCount].z);
-
-				mesh.Normals[meshVertCount - _sampleCount] = new Vector3(
-					_stitchTargetMeshData.Normals[_sampleCount - 1].x,
-					_stitchTargetMeshData.Normals[_sampleCount - 1].y,
-					_stitchTargetMeshData.Normals[_sampleCount - 1].z);
-			}
-
-			_stitchTarget = null;
-			_meshData.TryGetValue(tileId.SouthEast, out _stitchTarget);
-
-			if (_stitchTarget != null)
-			{
-				_stitchTarget.GetVertices(_stitchTargetMeshData.Vertices);
-				_stitchTarget.GetNormals(_stitchTargetMeshData.Normals);
-				mesh.Vertices[meshVertCount - 1] = new Vector3(
-					mesh.Vertices[meshVertCount - 1].x,
-					_stitchTargetMeshData.Vertices[0].y,
-					mesh.Vertices[meshVertCount - 1].z);
-
-				mesh.Normals[meshVertCount - 1] = new Vector3(
-					_stitchTargetMeshData.Normals[0].x,
-					_stitchTargetMeshData.Normals[0].y,
-					_stitchTargetMeshData.Normals[0].z);
-			}
-		}
-
 	}
 }
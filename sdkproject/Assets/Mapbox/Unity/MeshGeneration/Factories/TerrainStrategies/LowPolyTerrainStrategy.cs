@@ -21,6 +21,8 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 		private Vector3 _newDir;
 		private int _vertA, _vertB, _vertC;
 		private int _counter;
+		private bool _isFlatTile;
+		private float _flatHeight;
 
 
 		public override void Initialize(ElevationLayerProperties elOptions)
@@ -135,40 +137,43 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 			tile.MeshFilter.sharedMesh.GetNormals(_currentTileMeshData.Normals);
 
 			var cap = (_elevationOptions.modificationOptions.sampleCount - 1);
+			var pyramid = tile.HeightPyramid;
+			_isFlatTile = pyramid != null && pyramid.IsFlat;
+			_flatHeight = _isFlatTile ? pyramid.MinHeight * tile.TileScale : 0;
 			for (float y = 0; y < cap; y++)
 			{
 				for (float x = 0; x < cap; x++)
 				{
 					_currentTileMeshData.Vertices[(int)(y * cap + x) * 6] = new Vector3(
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6].x,
-						tile.QueryHeightData(x / cap, 1 - y / cap),
+						SampleHeight(tile, x / cap, 1 - y / cap),
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6].z);
 
 					_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 1] = new Vector3(
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 1].x,
-						tile.QueryHeightData((x + 1) / cap, 1 - y / cap),
+						SampleHeight(tile, (x + 1) / cap, 1 - y / cap),
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 1].z);
 
 					_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 2] = new Vector3(
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 2].x,
-						tile.QueryHeightData(x / cap, 1 - (y + 1) / cap),
+						SampleHeight(tile, x / cap, 1 - (y + 1) / cap),
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 2].z);
 
 					//--
 
 					_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 3] = new Vector3(
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 3].x,
-						tile.QueryHeightData((x + 1) / cap, 1 - y / cap),
+						SampleHeight(tile, (x + 1) / cap, 1 - y / cap),
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 3].z);
 
 					_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 4] = new Vector3(
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 4].x,
-						tile.QueryHeightData((x + 1) / cap, 1 - (y + 1) / cap),
+						SampleHeight(tile, (x + 1) / cap, 1 - (y + 1) / cap),
 						_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 4].z);
 
 					_currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 5] = new Vector3(
 					   _currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 5].x,
-					   tile.QueryHeightData(x / cap, 1 - (y + 1) / cap),
+					   SampleHeight(tile, x / cap, 1 - (y + 1) / cap),
 					   _currentTileMeshData.Vertices[(int)(y * cap + x) * 6 + 5].z);
 
 
@@ -204,6 +209,14 @@ namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
 			}
 		}
 
+		/// <summary>
+		/// Height at a [0-1] position, without a grid lookup if the whole tile is flat.
+		/// </summary>
+		private float SampleHeight(UnityTile tile, float x, float y)
+		{
+			return _isFlatTile ? _flatHeight : tile.QueryHeightData(x, y);
+		}
+
 		private void ResetToFlatMesh(UnityTile tile)
 		{
 			tile.MeshFilter.sharedMesh.GetVertices(_currentTileMeshData.Vertices);
@@ -0,0 +1,249 @@
+using System;
+using System.Collections.Generic;
+using UnityEngine;
+using UnityEngine.Rendering;
+using Mapbox.Unity.MeshGeneration.Data;
+
+namespace Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies
+{
+	/// <summary>
+	/// Layout of an n x n terrain grid shared by all tiles with the same sample count: triangles, uvs and the height sample
+	/// each vertex reads are computed once, tiles only fill in positions and normals. Vertex order goes right and down,
+	/// row 0 is the north edge, same as the meshes elevated terrain always used.
+	/// Optional skirts hang down from the edges so cracks between neighbouring tiles, of the same or a different zoom level,
+	/// are covered without reading or changing the neighbours.
+	/// Instances are immutable and shared, don't modify the arrays. Main thread only.
+	/// </summary>
+	public class TerrainMeshGrid
+	{
+		private static readonly Dictionary<int, TerrainMeshGrid> _grids = new Dictionary<int, TerrainMeshGrid>();
+
+		public readonly int SampleCount;
+		public readonly bool HasSkirts;
+		/// <summary> Vertices of the grid itself, skirt vertices follow them. </summary>
+		public readonly int GridVertexCount;
+		public readonly int VertexCount;
+		public readonly int[] Triangles;
+		public readonly Vector2[] Uvs;
+
+		//index into UnityTile.HeightData of every grid vertex
+		private readonly int[] _heightIndex;
+		//position of every column/row in [-0.5, 0.5] of the tile size, rows go from north to south
+		private readonly float[] _x;
+		private readonly float[] _z;
+		//grid vertex each skirt vertex hangs from, clockwise around the tile seen from above
+		private readonly int[] _edge;
+
+		/// <summary> Shared grid for a sample count. </summary>
+		public static TerrainMeshGrid Get(int sampleCount, bool skirts)
+		{
+			var key = sampleCount * 2 + (skirts ? 1 : 0);
+			TerrainMeshGrid grid;
+			if (!_grids.TryGetValue(key, out grid))
+			{
+				grid = new TerrainMeshGrid(sampleCount, skirts);
+				_grids.Add(key, grid);
+			}
+			return grid;
+		}
+
+		private TerrainMeshGrid(int sampleCount, bool skirts)
+		{
+			if (sampleCount < 2)
+			{
+				throw new ArgumentOutOfRangeException("sampleCount", "terrain grid needs at least 2 samples per side");
+			}
+
+			var n = sampleCount;
+			SampleCount = n;
+			HasSkirts = skirts;
+			GridVertexCount = n * n;
+			VertexCount = GridVertexCount + (skirts ? 4 * (n - 1) : 0);
+
+			_x = new float[n];
+			_z = new float[n];
+			for (int i = 0; i < n; i++)
+			{
+				var ratio = (float)i / (n - 1);
+				_x[i] = ratio - 0.5f;
+				_z[i] = 0.5f - ratio;
+			}
+
+			_heightIndex = new int[GridVertexCount];
+			Uvs = new Vector2[VertexCount];
+			for (float y = 0; y < n; y++)
+			{
+				for (float x = 0; x < n; x++)
+				{
+					var i = (int)(y * n + x);
+					_heightIndex[i] = ((int)((1 - y / (n - 1)) * 255) * 256) + ((int)(x / (n - 1) * 255));
+					Uvs[i] = new Vector2(x * 1f / (n - 1), 1 - (y * 1f / (n - 1)));
+				}
+			}
+
+			var triangleCount = (n - 1) * (n - 1) * 6 + (skirts ? 4 * (n - 1) * 6 : 0);
+			Triangles = new int[triangleCount];
+			var t = 0;
+			for (int y = 0; y < n - 1; y++)
+			{
+				for (int x = 0; x < n - 1; x++)
+				{
+					Triangles[t++] = (y * n) + x;
+					Triangles[t++] = (y * n) + x + n + 1;
+					Triangles[t++] = (y * n) + x + n;
+
+					Triangles[t++] = (y * n) + x;
+					Triangles[t++] = (y * n) + x + 1;
+					Triangles[t++] = (y * n) + x + n + 1;
+				}
+			}
+
+			if (skirts)
+			{
+				//north edge west to east, east edge north to south, south edge east to west, west edge south to north
+				_edge = new int[4 * (n - 1)];
+				var e = 0;
+				for (int x = 0; x < n - 1; x++) { _edge[e++] = x; }
+				for (int y = 0; y < n - 1; y++) { _edge[e++] = y * n + n - 1; }
+				for (int x = n - 1; x > 0; x--) { _edge[e++] = (n - 1) * n + x; }
+				for (int y = n - 1; y > 0; y--) { _edge[e++] = y * n; }
+
+				for (int i = 0; i < _edge.Length; i++)
+				{
+					var top = _edge[i];
+					var next = _edge[(i + 1) % _edge.Length];
+					var bottom = GridVertexCount + i;
+					var nextBottom = GridVertexCount + (i + 1) % _edge.Length;
+					Uvs[bottom] = Uvs[top];
+
+					//facing away from the tile
+					Triangles[t++] = top;
+					Triangles[t++] = bottom;
+					Triangles[t++] = next;
+
+					Triangles[t++] = next;
+					Triangles[t++] = bottom;
+					Triangles[t++] = nextBottom;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Positions and normals of <paramref name="tile"/>'s terrain, written to <paramref name="vertices"/> and
+		/// <paramref name="normals"/> which need at least <see cref="VertexCount"/> elements.
+		/// Flat tiles don't sample the height data at all.
+		/// </summary>
+		/// <returns>Bounds of the mesh.</returns>
+		public Bounds Build(UnityTile tile, Vector3[] vertices, Vector3[] normals)
+		{
+			var ts = tile.TileScale;
+			var width = (float)tile.Rect.Size.x * ts;
+			var depth = (float)tile.Rect.Size.y * ts;
+			var pyramid = tile.HeightPyramid;
+			if (tile.HeightData == null || (pyramid != null && pyramid.IsFlat))
+			{
+				var h = tile.HeightData == null ? 0 : pyramid.MinHeight * ts;
+				return build(null, h, width, depth, vertices, normals);
+			}
+			return build(tile.HeightData, ts, width, depth, vertices, normals);
+		}
+
+		/// <summary>
+		/// Positions and normals of a tile of <paramref name="width"/> by <paramref name="depth"/> units with
+		/// <paramref name="heights"/> laid out like <see cref="UnityTile.HeightData"/>.
+		/// </summary>
+		/// <returns>Bounds of the mesh.</returns>
+		public Bounds Build(float[] heights, float heightScale, float width, float depth, Vector3[] vertices, Vector3[] normals)
+		{
+			return build(heights, heightScale, width, depth, vertices, normals);
+		}
+
+		/// <summary>
+		/// Copy a built tile to <paramref name="mesh"/>. Triangles and uvs are only set if the mesh doesn't have this layout yet.
+		/// </summary>
+		public void Apply(Mesh mesh, Vector3[] vertices, Vector3[] normals, Bounds bounds)
+		{
+			if (mesh.vertexCount != VertexCount)
+			{
+				mesh.Clear();
+				//skirts take the largest grids past 16 bit indices
+				mesh.indexFormat = VertexCount > 65535 ? IndexFormat.UInt32 : IndexFormat.UInt16;
+				mesh.vertices = vertices;
+				mesh.normals = normals;
+				mesh.uv = Uvs;
+				mesh.triangles = Triangles;
+			}
+			else
+			{
+				mesh.vertices = vertices;
+				mesh.normals = normals;
+			}
+			mesh.bounds = bounds;
+		}
+
+		// heights null means a flat tile at heightScale
+		private Bounds build(float[] heights, float heightScale, float width, float depth, Vector3[] vertices, Vector3[] normals)
+		{
+			var n = SampleCount;
+			var minY = float.MaxValue;
+			var maxY = float.MinValue;
+			for (int y = 0; y < n; y++)
+			{
+				var z = _z[y] * depth;
+				for (int x = 0; x < n; x++)
+				{
+					var i = y * n + x;
+					var h = heights == null ? heightScale : heights[_heightIndex[i]] * heightScale;
+					vertices[i] = new Vector3(_x[x] * width, h, z);
+					if (h < minY) { minY = h; }
+					if (h > maxY) { maxY = h; }
+				}
+			}
+
+			if (heights == null)
+			{
+				for (int i = 0; i < GridVertexCount; i++)
+				{
+					normals[i] = Mapbox.Unity.Constants.Math.Vector3Up;
+				}
+			}
+			else
+			{
+				//central differences, one sided on the edges
+				var cellX = width / (n - 1);
+				var cellZ = depth / (n - 1);
+				for (int y = 0; y < n; y++)
+				{
+					var north = y > 0 ? y - 1 : y;
+					var south = y < n - 1 ? y + 1 : y;
+					var dz = (south - north) * cellZ;
+					for (int x = 0; x < n; x++)
+					{
+						var west = x > 0 ? x - 1 : x;
+						var east = x < n - 1 ? x + 1 : x;
+						var dhdx = (vertices[y * n + east].y - vertices[y * n + west].y) / ((east - west) * cellX);
+						var dhdz = (vertices[north * n + x].y - vertices[south * n + x].y) / dz;
+						var length = (float)Math.Sqrt(dhdx * dhdx + 1 + dhdz * dhdz);
+						normals[y * n + x] = new Vector3(-dhdx / length, 1 / length, -dhdz / length);
+					}
+				}
+			}
+
+			var bottom = minY;
+			if (HasSkirts)
+			{
+				//deep enough for the steepest step between two neighbouring tiles' edge samples
+				var skirtDepth = Math.Max(Math.Max(width, depth) / (n - 1), (maxY - minY) * 0.25f);
+				var offset = new Vector3(0, skirtDepth, 0);
+				for (int i = 0; i < _edge.Length; i++)
+				{
+					vertices[GridVertexCount + i] = vertices[_edge[i]] - offset;
+					normals[GridVertexCount + i] = normals[_edge[i]];
+				}
+				bottom = minY - skirtDepth;
+			}
+
+			return new Bounds(new Vector3(0, (bottom + maxY) / 2, 0), new Vector3(width, maxY - bottom, depth));
+		}
+	}
+}
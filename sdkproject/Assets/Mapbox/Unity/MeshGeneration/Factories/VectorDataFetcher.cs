@@ -17,11 +17,13 @@ public class VectorDataFetcher : DataFetcher
 			return;
 		}
 		var vectorTile = (vectorDataParameters.useOptimizedStyle) ? new VectorTile(vectorDataParameters.style.Id, vectorDataParameters.style.Modified) : new VectorTile();
+		//layers and features are decoded by VectorLayerDecoder off the main thread, no need to walk them while parsing
+		vectorTile.ValidateOnParse = false;
 		if (vectorDataParameters.tile != null)
 		{
 			vectorDataParameters.tile.AddTile(vectorTile);
 		}
-		vectorTile.Initialize(_fileSource, vectorDataParameters.canonicalTileId, vectorDataParameters.tilesetId, () =>
+		vectorTile.Initialize(FileSource, vectorDataParameters.canonicalTileId, vectorDataParameters.tilesetId, () =>
 		{
 			if (vectorDataParameters.tile != null && vectorDataParameters.tile.CanonicalTileId != vectorTile.Id)
 			{
@@ -4,6 +4,7 @@ using Mapbox.Unity.MeshGeneration.Enums;
 using Mapbox.Unity.MeshGeneration.Data;
 using Mapbox.Unity.MeshGeneration.Interfaces;
 using Mapbox.Map;
+using Mapbox.Platform;
 using Mapbox.Unity.Map;
 using System;
 
@@ -182,6 +183,7 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 			_layerBuilder = new Dictionary<string, List<LayerVisualizerBase>>();
 
 			DataFetcher = ScriptableObject.CreateInstance<VectorDataFetcher>();
+			DataFetcher.FileSource = _fileSource;
 			DataFetcher.DataRecieved += OnVectorDataRecieved;
 			DataFetcher.FetchingError += OnDataError;
 
@@ -210,6 +212,18 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 			DataFetcher.FetchData(parameters);
 		}
 
+		public override IAsyncRequest Prefetch(CanonicalTileId tileId, Action<Response> callback)
+		{
+			if (string.IsNullOrEmpty(TilesetId) || _properties.sourceOptions.isActive == false || (_properties.vectorSubLayers.Count + _properties.locationPrefabList.Count) == 0)
+			{
+				return null;
+			}
+			var resource = _properties.useOptimizedStyle
+				? TileResource.MakeStyleOptimizedVector(tileId, TilesetId, _properties.optimizedStyle.Id, _properties.optimizedStyle.Modified)
+				: TileResource.MakeVector(tileId, TilesetId);
+			return PrefetchResource(resource, tileId, TilesetId, callback);
+		}
+
 		protected override void OnUnregistered(UnityTile tile)
 		{
 			if (_layerProgress != null && _layerProgress.ContainsKey(tile))
@@ -455,12 +469,12 @@ namespace Mapbox.Unity.MeshGeneration.Factories
 				}
 				if (layerName != "")
 				{
-					builder.Create(tile.VectorData.Data.GetLayer(layerName), tile, DecreaseProgressCounter);
+					builder.Create(tile.VectorData.Data, layerName, tile, DecreaseProgressCounter);
 				}
 				else
 				{
 					//just pass the first available layer - we should create a static null layer for this
-					builder.Create(tile.VectorData.Data.GetLayer(tile.VectorData.Data.LayerNames()[0]), tile, DecreaseProgressCounter);
+					builder.Create(tile.VectorData.Data, tile.VectorData.Data.LayerNames()[0], tile, DecreaseProgressCounter);
 				}
 			}
 		}
@@ -0,0 +1,496 @@
+namespace Mapbox.Unity.MeshGeneration.Filters
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.VectorTile;
+
+	/// <summary>
+	/// A tree of the built in comparers (<see cref="LayerFilterCombiner"/>, the <see cref="LayerHasPropertyFilterComparer"/>
+	/// family and <see cref="TypeFilter"/>) flattened into arrays, with keys interned and match values lowered once.
+	/// <see cref="ForLayer"/> binds it to the keys and values of one vector tile layer, features are then filtered on their
+	/// tags without building <see cref="VectorTileFeature.GetProperties"/> or decoding geometry.
+	/// Values that can't be compared (non numeric strings in numeric filters, a missing 'type') fail the condition instead of throwing.
+	/// </summary>
+	public sealed class CompiledLayerFilter : ILayerFeatureFilterComparer
+	{
+		private enum NodeType
+		{
+			True,
+			False,
+			Condition,
+			Any,
+			All,
+			None,
+		}
+
+		private enum ConditionType
+		{
+			HasProperty,
+			InRange,
+			IsGreater,
+			IsLess,
+			IsEqual,
+			Contains,
+			TypeInclude,
+			TypeExclude,
+		}
+
+		private struct Node
+		{
+			public NodeType Type;
+			// condition index for conditions, first entry in '_children' for combiners
+			public int Index;
+			public int ChildCount;
+		}
+
+		private struct Condition
+		{
+			public ConditionType Type;
+			public int KeySlot;
+			public double Min;
+			public double Max;
+			public string[] Strings;
+		}
+
+		private readonly Node[] _nodes;
+		private readonly int[] _children;
+		private readonly Condition[] _conditions;
+		private readonly string[] _keys;
+
+		private CompiledLayerFilter(List<Node> nodes, List<int> children, List<Condition> conditions, List<string> keys)
+		{
+			_nodes = nodes.ToArray();
+			_children = children.ToArray();
+			_conditions = conditions.ToArray();
+			_keys = keys.ToArray();
+		}
+
+		/// <summary>
+		/// Compile <paramref name="filter"/>, null if it contains comparers that can only run on <see cref="VectorFeatureUnity.Properties"/>,
+		/// eg custom implementations of <see cref="ILayerFeatureFilterComparer"/>.
+		/// </summary>
+		public static CompiledLayerFilter Compile(ILayerFeatureFilterComparer filter)
+		{
+			if (null == filter) { throw new ArgumentNullException("filter"); }
+
+			var compiled = filter as CompiledLayerFilter;
+			if (null != compiled) { return compiled; }
+
+			var builder = new Builder();
+			if (builder.Add(filter) < 0) { return null; }
+			return new CompiledLayerFilter(builder.Nodes, builder.Children, builder.Conditions, builder.Keys);
+		}
+
+		/// <summary>
+		/// Bind to the keys and values of <paramref name="layer"/>. The result isn't thread safe, use one per layer and thread.
+		/// </summary>
+		public LayerTagFilter ForLayer(VectorTileLayer layer)
+		{
+			if (null == layer) { throw new ArgumentNullException("layer"); }
+			return new LayerTagFilter(this, layer.Keys, layer.Values);
+		}
+
+		/// <summary> Evaluates on <see cref="VectorFeatureUnity.Properties"/>, same results as <see cref="LayerTagFilter.Try(VectorTileFeature)"/>. </summary>
+		public bool Try(VectorFeatureUnity feature)
+		{
+			return evaluate(0, feature.Properties);
+		}
+
+		private bool evaluate(int node, Dictionary<string, object> properties)
+		{
+			Node n = _nodes[node];
+			switch (n.Type)
+			{
+				case NodeType.True:
+					return true;
+				case NodeType.Condition:
+					object value;
+					if (null == properties || !properties.TryGetValue(_keys[_conditions[n.Index].KeySlot], out value))
+					{
+						return false;
+					}
+					return test(ref _conditions[n.Index], value);
+				case NodeType.Any:
+				case NodeType.None:
+					for (int i = 0; i < n.ChildCount; i++)
+					{
+						if (evaluate(_children[n.Index + i], properties)) { return n.Type == NodeType.Any; }
+					}
+					return n.Type == NodeType.None;
+				case NodeType.All:
+					for (int i = 0; i < n.ChildCount; i++)
+					{
+						if (!evaluate(_children[n.Index + i], properties)) { return false; }
+					}
+					return true;
+				default:
+					return false;
+			}
+		}
+
+		/// <summary> Same comparisons as the comparers the condition was compiled from. </summary>
+		private static bool test(ref Condition condition, object value)
+		{
+			switch (condition.Type)
+			{
+				case ConditionType.HasProperty:
+					return true;
+				case ConditionType.Contains:
+					if (null == value) { return false; }
+					string lowered = value.ToString().ToLower();
+					for (int i = 0; i < condition.Strings.Length; i++)
+					{
+						if (lowered.Contains(condition.Strings[i])) { return true; }
+					}
+					return false;
+				case ConditionType.TypeInclude:
+				case ConditionType.TypeExclude:
+					bool match = null != value && Array.IndexOf(condition.Strings, value.ToString().ToLowerInvariant()) >= 0;
+					return match == (condition.Type == ConditionType.TypeInclude);
+			}
+
+			double number;
+			if (!toDouble(value, out number)) { return false; }
+			switch (condition.Type)
+			{
+				case ConditionType.InRange:
+					return number >= condition.Min && number < condition.Max;
+				case ConditionType.IsGreater:
+					return number > condition.Min;
+				case ConditionType.IsLess:
+					return number < condition.Min;
+				case ConditionType.IsEqual:
+					return Math.Abs(number - condition.Min) < Mapbox.Utils.Constants.EpsilonFloatingPoint;
+				default:
+					return false;
+			}
+		}
+
+		private static bool toDouble(object value, out double number)
+		{
+			number = 0;
+			if (null == value) { return false; }
+			try
+			{
+				number = Convert.ToDouble(value);
+				return true;
+			}
+			catch (FormatException) { return false; }
+			catch (InvalidCastException) { return false; }
+			catch (OverflowException) { return false; }
+		}
+
+		/// <summary>
+		/// A <see cref="CompiledLayerFilter"/> bound to one layer: filter keys resolved to key indices of the layer, conditions
+		/// on keys the layer doesn't have folded into constants and the result of every condition memoized per value index,
+		/// so each distinct value of the layer is compared once.
+		/// </summary>
+		public sealed class LayerTagFilter
+		{
+			private const sbyte UNKNOWN = 0;
+			private const sbyte PASSES = 1;
+			private const sbyte FAILS = 2;
+
+			private readonly CompiledLayerFilter _filter;
+			private readonly List<object> _values;
+			private readonly int _valueCount;
+			// key slot of every key index of the layer, -1 for keys no condition uses
+			private readonly int[] _slotOfKey;
+			// value index of each key slot for the feature being filtered, -1 if the feature doesn't have the key
+			private readonly int[] _slotValues;
+			private readonly sbyte[][] _memo;
+			// per node: constant result or Condition/combiner, combiners keep only the children that aren't constant
+			private readonly NodeType[] _types;
+			private readonly int[] _first;
+			private readonly int[] _count;
+			private readonly List<int> _children = new List<int>();
+
+			internal LayerTagFilter(CompiledLayerFilter filter, List<string> keys, List<object> values)
+			{
+				_filter = filter;
+				_values = values;
+				_valueCount = null == values ? 0 : values.Count;
+				int keyCount = null == keys ? 0 : keys.Count;
+				_slotOfKey = new int[keyCount];
+				bool[] present = new bool[filter._keys.Length];
+				for (int i = 0; i < keyCount; i++)
+				{
+					_slotOfKey[i] = Array.IndexOf(filter._keys, keys[i]);
+					if (_slotOfKey[i] >= 0) { present[_slotOfKey[i]] = true; }
+				}
+				_slotValues = new int[filter._keys.Length];
+				_memo = new sbyte[filter._conditions.Length][];
+
+				int nodeCount = filter._nodes.Length;
+				_types = new NodeType[nodeCount];
+				_first = new int[nodeCount];
+				_count = new int[nodeCount];
+				// children always come after their parent, so fold back to front
+				for (int node = nodeCount - 1; node >= 0; node--)
+				{
+					bind(node, present);
+				}
+			}
+
+			/// <summary> True if no feature of the layer can pass, the layer can be skipped. </summary>
+			public bool RejectsAll { get { return _types[0] == NodeType.False; } }
+
+			/// <summary> True if every feature of the layer passes. </summary>
+			public bool AcceptsAll { get { return _types[0] == NodeType.True; } }
+
+			public bool Try(VectorTileFeature feature)
+			{
+				return Try(feature.Tags);
+			}
+
+			/// <summary> Filter a feature by its tags: pairs of key and value indices into the layer. </summary>
+			public bool Try(List<int> tags)
+			{
+				switch (_types[0])
+				{
+					case NodeType.True:
+						return true;
+					case NodeType.False:
+						return false;
+				}
+
+				for (int i = 0; i < _slotValues.Length; i++) { _slotValues[i] = -1; }
+				if (null != tags)
+				{
+					int tagCount = tags.Count - 1;
+					for (int i = 0; i < tagCount; i += 2)
+					{
+						int key = tags[i];
+						if (key >= 0 && key < _slotOfKey.Length && _slotOfKey[key] >= 0)
+						{
+							_slotValues[_slotOfKey[key]] = tags[i + 1];
+						}
+					}
+				}
+				return evaluate(0);
+			}
+
+			private bool evaluate(int node)
+			{
+				switch (_types[node])
+				{
+					case NodeType.True:
+						return true;
+					case NodeType.Condition:
+						return condition(_filter._nodes[node].Index);
+					case NodeType.Any:
+					case NodeType.None:
+						for (int i = 0; i < _count[node]; i++)
+						{
+							if (evaluate(_children[_first[node] + i])) { return _types[node] == NodeType.Any; }
+						}
+						return _types[node] == NodeType.None;
+					case NodeType.All:
+						for (int i = 0; i < _count[node]; i++)
+						{
+							if (!evaluate(_children[_first[node] + i])) { return false; }
+						}
+						return true;
+					default:
+						return false;
+				}
+			}
+
+			private bool condition(int index)
+			{
+				int value = _slotValues[_filter._conditions[index].KeySlot];
+				if (value < 0 || value >= _valueCount) { return false; }
+
+				sbyte[] memo = _memo[index];
+				if (null == memo)
+				{
+					memo = _memo[index] = new sbyte[_valueCount];
+				}
+				if (memo[value] == UNKNOWN)
+				{
+					memo[value] = test(ref _filter._conditions[index], _values[value]) ? PASSES : FAILS;
+				}
+				return memo[value] == PASSES;
+			}
+
+			/// <summary>
+			/// Fold <paramref name="node"/> for this layer. Combiners drop children that don't change their result and
+			/// evaluate conditions before nested combiners.
+			/// </summary>
+			private void bind(int node, bool[] present)
+			{
+				Node n = _filter._nodes[node];
+				switch (n.Type)
+				{
+					case NodeType.Condition:
+						_types[node] = present[_filter._conditions[n.Index].KeySlot] ? NodeType.Condition : NodeType.False;
+						return;
+					case NodeType.Any:
+					case NodeType.All:
+					case NodeType.None:
+						break;
+					default:
+						_types[node] = n.Type;
+						return;
+				}
+
+				// a true child decides Any and None, a false one decides All
+				NodeType deciding = n.Type == NodeType.All ? NodeType.False : NodeType.True;
+				NodeType neutral = n.Type == NodeType.All ? NodeType.True : NodeType.False;
+				int first = _children.Count;
+				for (int pass = 0; pass < 2; pass++)
+				{
+					for (int i = 0; i < n.ChildCount; i++)
+					{
+						int child = _filter._children[n.Index + i];
+						NodeType type = _types[child];
+						if (type == deciding)
+						{
+							_children.RemoveRange(first, _children.Count - first);
+							_types[node] = n.Type == NodeType.Any ? NodeType.True : NodeType.False;
+							return;
+						}
+						if (type == neutral || (type == NodeType.Condition) != (pass == 0)) { continue; }
+						_children.Add(child);
+					}
+				}
+
+				_first[node] = first;
+				_count[node] = _children.Count - first;
+				if (_count[node] == 0)
+				{
+					// nothing left to decide: All passes, Any fails, None passes
+					_types[node] = n.Type == NodeType.Any ? NodeType.False : NodeType.True;
+					return;
+				}
+				_types[node] = n.Type;
+			}
+		}
+
+		private class Builder
+		{
+			public readonly List<Node> Nodes = new List<Node>();
+			public readonly List<int> Children = new List<int>();
+			public readonly List<Condition> Conditions = new List<Condition>();
+			public readonly List<string> Keys = new List<string>();
+
+			/// <summary> Index of the node added for <paramref name="filter"/>, -1 if it can't be compiled. </summary>
+			public int Add(ILayerFeatureFilterComparer filter)
+			{
+				// exact types only, subclasses may override the comparison
+				Type type = null == filter ? null : filter.GetType();
+				if (type == typeof(LayerFilterCombiner))
+				{
+					return addCombiner((LayerFilterCombiner)filter);
+				}
+				if (type == typeof(LayerFilterComparer) || type == typeof(FilterBase))
+				{
+					return addNode(NodeType.True, 0, 0);
+				}
+				if (type == typeof(TypeFilter))
+				{
+					var typeFilter = (TypeFilter)filter;
+					string[] types = null == typeFilter.Types ? new string[0] : new string[typeFilter.Types.Length];
+					for (int i = 0; i < types.Length; i++)
+					{
+						types[i] = string.Intern(typeFilter.Types[i].ToLowerInvariant());
+					}
+					return addCondition(
+						typeFilter.Behaviour == TypeFilter.TypeFilterType.Include ? ConditionType.TypeInclude : ConditionType.TypeExclude
+						, typeFilter.Key
+						, 0
+						, 0
+						, types
+					);
+				}
+				if (type == typeof(LayerHasPropertyFilterComparer))
+				{
+					return addCondition(ConditionType.HasProperty, ((LayerHasPropertyFilterComparer)filter).Key, 0, 0, null);
+				}
+				if (type == typeof(LayerPropertyInRangeFilterComparer))
+				{
+					var range = (LayerPropertyInRangeFilterComparer)filter;
+					return addCondition(ConditionType.InRange, range.Key, range.Min, range.Max, null);
+				}
+				if (type == typeof(LayerPropertyIsGreaterFilterComparer))
+				{
+					var greater = (LayerPropertyIsGreaterFilterComparer)filter;
+					return addCondition(ConditionType.IsGreater, greater.Key, greater.Min, 0, null);
+				}
+				if (type == typeof(LayerPropertyIsLessFilterComparer))
+				{
+					var less = (LayerPropertyIsLessFilterComparer)filter;
+					return addCondition(ConditionType.IsLess, less.Key, less.Min, 0, null);
+				}
+				if (type == typeof(LayerPropertyIsEqualFilterComparer))
+				{
+					var equal = (LayerPropertyIsEqualFilterComparer)filter;
+					return addCondition(ConditionType.IsEqual, equal.Key, equal.Min, 0, null);
+				}
+				if (type == typeof(LayerPropertyContainsFilterComparer))
+				{
+					var contains = (LayerPropertyContainsFilterComparer)filter;
+					var values = new List<string>();
+					if (null != contains.ValueSet)
+					{
+						foreach (var value in contains.ValueSet)
+						{
+							if (null != value) { values.Add(string.Intern(value.ToString())); }
+						}
+					}
+					return addCondition(ConditionType.Contains, contains.Key, 0, 0, values.ToArray());
+				}
+				return -1;
+			}
+
+			private int addCombiner(LayerFilterCombiner combiner)
+			{
+				NodeType type;
+				switch (combiner.Type)
+				{
+					case LayerFilterCombinerOperationType.Any: type = NodeType.Any; break;
+					case LayerFilterCombinerOperationType.All: type = NodeType.All; break;
+					case LayerFilterCombinerOperationType.None: type = NodeType.None; break;
+					default: return addNode(NodeType.False, 0, 0);
+				}
+
+				int node = addNode(type, 0, 0);
+				var children = new List<int>();
+				if (null != combiner.Filters)
+				{
+					foreach (var filter in combiner.Filters)
+					{
+						int child = Add(filter);
+						if (child < 0) { return -1; }
+						children.Add(child);
+					}
+				}
+				Nodes[node] = new Node { Type = type, Index = Children.Count, ChildCount = children.Count };
+				Children.AddRange(children);
+				return node;
+			}
+
+			private int addCondition(ConditionType type, string key, double min, double max, string[] strings)
+			{
+				if (null == key) { return addNode(NodeType.False, 0, 0); }
+
+				key = string.Intern(key);
+				int slot = Keys.IndexOf(key);
+				if (slot < 0)
+				{
+					slot = Keys.Count;
+					Keys.Add(key);
+				}
+				Conditions.Add(new Condition { Type = type, KeySlot = slot, Min = min, Max = max, Strings = strings });
+				return addNode(NodeType.Condition, Conditions.Count - 1, 0);
+			}
+
+			private int addNode(NodeType type, int index, int childCount)
+			{
+				Nodes.Add(new Node { Type = type, Index = index, ChildCount = childCount });
+				return Nodes.Count - 1;
+			}
+		}
+	}
+}
@@ -14,20 +14,57 @@ namespace Mapbox.Unity.MeshGeneration.Filters
 		private string[] _types;
 		[SerializeField]
 		private TypeFilterType _behaviour;
+		// lowered copy of '_loweredFrom', rebuilt whenever '_types' is assigned
+		private string[] _loweredTypes;
+		private string[] _loweredFrom;
+
+		internal string[] Types
+		{
+			get { return _types; }
+			set
+			{
+				_types = value;
+				_loweredTypes = null;
+			}
+		}
+
+		internal TypeFilterType Behaviour
+		{
+			get { return _behaviour; }
+			set { _behaviour = value; }
+		}
+
+		public override void Initialize()
+		{
+			base.Initialize();
+			lowerTypes();
+		}
 
 		public override bool Try(VectorFeatureUnity feature)
 		{
-			var check = false;
-			for (int i = 0; i < _types.Length; i++)
+			// '_types' may have been replaced by deserialization
+			if (_loweredTypes == null || !ReferenceEquals(_loweredFrom, _types))
 			{
-				if (_types[i].ToLowerInvariant() == feature.Properties["type"].ToString().ToLowerInvariant())
-				{
-					check = true;
-				}
+				lowerTypes();
 			}
+
+			var type = feature.Properties["type"].ToString().ToLowerInvariant();
+			var check = Array.IndexOf(_loweredTypes, type) >= 0;
 			return _behaviour == TypeFilterType.Include ? check : !check;
 		}
 
+		private void lowerTypes()
+		{
+			var types = _types ?? new string[0];
+			var lowered = new string[types.Length];
+			for (int i = 0; i < types.Length; i++)
+			{
+				lowered[i] = types[i].ToLowerInvariant();
+			}
+			_loweredFrom = _types;
+			_loweredTypes = lowered;
+		}
+
 		public enum TypeFilterType
 		{
 			Include,
@@ -63,15 +100,28 @@ namespace Mapbox.Unity.MeshGeneration.Filters
 			switch (Type)
 			{
 				case LayerFilterCombinerOperationType.Any:
-					return Filters.Any(m => m.Try(feature));
+					return any(feature);
 				case LayerFilterCombinerOperationType.All:
-					return Filters.All(m => m.Try(feature));
+					for (int i = 0; i < Filters.Count; i++)
+					{
+						if (!Filters[i].Try(feature)) { return false; }
+					}
+					return true;
 				case LayerFilterCombinerOperationType.None:
-					return !Filters.Any(m => m.Try(feature));
+					return !any(feature);
 				default:
 					return false;
 			}
 		}
+
+		private bool any(VectorFeatureUnity feature)
+		{
+			for (int i = 0; i < Filters.Count; i++)
+			{
+				if (Filters[i].Try(feature)) { return true; }
+			}
+			return false;
+		}
 	}
 
 	public class LayerFilterComparer : ILayerFeatureFilterComparer
@@ -279,9 +329,10 @@ namespace Mapbox.Unity.MeshGeneration.Filters
 
 		protected override bool PropertyComparer(object property)
 		{
-			foreach (var value in ValueSet)
+			var lowered = property.ToString().ToLower();
+			for (int i = 0; i < ValueSet.Count; i++)
 			{
-				if (property.ToString().ToLower().Contains(value.ToString()))
+				if (lowered.Contains(ValueSet[i].ToString()))
 				{
 					return true;
 				}
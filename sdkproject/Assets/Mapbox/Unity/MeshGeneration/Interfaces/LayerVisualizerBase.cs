@@ -17,6 +17,15 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 
 		public abstract void Create(VectorTileLayer layer, UnityTile tile, Action<UnityTile, LayerVisualizerBase> callback = null);
 
+		/// <summary>
+		/// Create features of layer <paramref name="layerName"/>. Reads the layer right away by default,
+		/// visualizers decoding off the main thread override this to read it on a worker.
+		/// </summary>
+		public virtual void Create(Mapbox.VectorTile.VectorTile vectorTile, string layerName, UnityTile tile, Action<UnityTile, LayerVisualizerBase> callback = null)
+		{
+			Create(vectorTile.GetLayer(layerName), tile, callback);
+		}
+
 		public event System.EventHandler LayerVisualizerHasChanged;
 
 		public virtual void Initialize()
@@ -332,6 +332,23 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			}
 		}
 
+		public override void Create(Mapbox.VectorTile.VectorTile vectorTile, string layerName, UnityTile tile, Action<UnityTile, LayerVisualizerBase> callback)
+		{
+			if ((SubLayerProperties as PrefabItemOptions).findByType == LocationPrefabFindBy.AddressOrLatLon)
+			{
+				Create(vectorTile.GetLayer(layerName), tile, callback);
+			}
+			else
+			{
+				var item = (SubLayerProperties as PrefabItemOptions);
+				bool isCategoryNone = (item.findByType == LocationPrefabFindBy.MapboxCategory && item.categories == LocationPrefabCategories.None);
+				if (!isCategoryNone)
+				{
+					base.Create(vectorTile, layerName, tile, callback);
+				}
+			}
+		}
+
 		/// <summary>
 		/// Creates a vector feature from lat lon and builds that feature using the modifier stack.
 		/// </summary>
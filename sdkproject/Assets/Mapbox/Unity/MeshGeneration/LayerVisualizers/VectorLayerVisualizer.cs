@@ -14,6 +14,7 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 	using Mapbox.Unity.Utilities;
 	using Mapbox.Unity.MeshGeneration.Filters;
 	using Mapbox.Map;
+	using Mapbox.Utils;
 
 	public class VectorLayerVisualizerProperties
 	{
@@ -54,12 +55,24 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 
 		protected LayerPerformanceOptions _performanceOptions;
 		protected Dictionary<UnityTile, List<int>> _activeCoroutines;
+		protected Dictionary<UnityTile, List<VectorLayerDecodeJob>> _activeDecodes;
 		int _entityInCurrentCoroutine = 0;
 
+		//main thread time spent building features in the current frame, shared by all layers
+		private static int _budgetFrame = -1;
+		private static readonly System.Diagnostics.Stopwatch _budgetStopwatch = new System.Diagnostics.Stopwatch();
+
 		protected ModifierStackBase _defaultStack;
 		private HashSet<ulong> _activeIds;
+		private MeshDataArena _meshDataArena = new MeshDataArena();
 		private Dictionary<UnityTile, List<ulong>> _idPool; //necessary to keep _activeIds list up to date when unloading tiles
 		private string _key;
+		//hash of the layer settings and mesh modifiers the merged mesh cache is keyed with, computed on first use
+		private int? _styleHash;
+		//filters of the layer and the filter handed to the decoder, built and compiled once until the filter options change
+		private ILayerFeatureFilterComparer[] _layerFeatureFilters;
+		private ILayerFeatureFilterComparer _layerFeatureFilterCombiner;
+		private ILayerFeatureFilterComparer _decodeFilter;
 
 		protected HashSet<ModifierBase> _coreModifiers = new HashSet<ModifierBase>();
 
@@ -122,6 +135,8 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 				layerUpdateArgs.property.PropertyHasChanged -= UpdateVector;
 			}
 			UnbindSubLayerEvents();
+			_styleHash = null;
+			_layerFeatureFilters = null;
 
 			OnUpdateLayerVisualizer(layerUpdateArgs);
 		}
@@ -151,6 +166,8 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 		public override void SetProperties(VectorSubLayerProperties properties)
 		{
 			_coreModifiers = new HashSet<ModifierBase>();
+			_styleHash = null;
+			_layerFeatureFilters = null;
 
 			if (_layerProperties == null && properties != null)
 			{
@@ -381,28 +398,6 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			}
 		}
 
-		/// <summary>
-		/// Apply filters to the layer and check if the current feature is eleigible for rendering.
-		/// </summary>
-		/// <returns><c>true</c>, if feature eligible after filtering was applied, <c>false</c> otherwise.</returns>
-		/// <param name="feature">Feature.</param>
-		private bool IsFeatureEligibleAfterFiltering(VectorFeatureUnity feature, UnityTile tile, VectorLayerVisualizerProperties layerProperties)
-		{
-			if (layerProperties.layerFeatureFilters.Count() == 0)
-			{
-				return true;
-			}
-			else
-			{
-				// build features only if the filter returns true.
-				if (layerProperties.layerFeatureFilterCombiner.Try(feature))
-				{
-					return true;
-				}
-			}
-			return false;
-		}
-
 		/// <summary>
 		/// Function to fetch feature in vector tile at the index specified.
 		/// </summary>
@@ -439,6 +434,31 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			}
 		}
 
+		/// <summary>
+		/// Gets a value indicating whether all layers together used up the main thread time budget of this frame.
+		/// </summary>
+		/// <value><c>true</c> if the frame budget is spent; otherwise, <c>false</c>.</value>
+		private bool IsFrameBudgetSpent
+		{
+			get
+			{
+				return (_performanceOptions != null && _performanceOptions.isEnabled && _budgetStopwatch.Elapsed.TotalMilliseconds >= _performanceOptions.frameBudgetMilliseconds);
+			}
+		}
+
+		/// <summary>
+		/// Starts measuring the frame budget on the first feature built in a new frame.
+		/// </summary>
+		private static void StartFrameBudget()
+		{
+			if (_budgetFrame != Time.frameCount)
+			{
+				_budgetFrame = Time.frameCount;
+				_budgetStopwatch.Reset();
+				_budgetStopwatch.Start();
+			}
+		}
+
 		public override bool Active
 		{
 			get
@@ -454,8 +474,11 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			_entityInCurrentCoroutine = 0;
 
 			_activeCoroutines = new Dictionary<UnityTile, List<int>>();
+			_activeDecodes = new Dictionary<UnityTile, List<VectorLayerDecodeJob>>();
 			_activeIds = new HashSet<ulong>();
 			_idPool = new Dictionary<UnityTile, List<ulong>>();
+			_styleHash = null;
+			_layerFeatureFilters = null;
 
 			if (_defaultStack != null)
 			{
@@ -476,10 +499,24 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 		{
 			if (!_activeCoroutines.ContainsKey(tile))
 				_activeCoroutines.Add(tile, new List<int>());
-			_activeCoroutines[tile].Add(Runnable.Run(ProcessLayer(layer, tile, tile.UnwrappedTileId, callback)));
+			_activeCoroutines[tile].Add(Runnable.Run(ProcessLayer(null, null, layer, tile, tile.UnwrappedTileId, callback)));
 		}
 
-		protected IEnumerator ProcessLayer(VectorTileLayer layer, UnityTile tile, UnwrappedTileId tileId, Action<UnityTile, LayerVisualizerBase> callback = null)
+		/// <summary>
+		/// Reads the layer and decodes its features on a worker thread, only the modifier stack runs on the main thread.
+		/// </summary>
+		public override void Create(Mapbox.VectorTile.VectorTile vectorTile, string layerName, UnityTile tile, Action<UnityTile, LayerVisualizerBase> callback)
+		{
+			if (!_activeCoroutines.ContainsKey(tile))
+				_activeCoroutines.Add(tile, new List<int>());
+			_activeCoroutines[tile].Add(Runnable.Run(ProcessLayer(vectorTile, layerName, null, tile, tile.UnwrappedTileId, callback)));
+		}
+
+		/// <summary>
+		/// Decodes either <paramref name="layerName"/> of <paramref name="vectorTile"/> or the already read <paramref name="layer"/>
+		/// off the main thread and builds the decoded features within the frame budget.
+		/// </summary>
+		protected IEnumerator ProcessLayer(Mapbox.VectorTile.VectorTile vectorTile, string layerName, VectorTileLayer layer, UnityTile tile, UnwrappedTileId tileId, Action<UnityTile, LayerVisualizerBase> callback = null)
 		{
 			if (tile == null)
 			{
@@ -487,75 +524,121 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			}
 
 			VectorLayerVisualizerProperties tempLayerProperties = new VectorLayerVisualizerProperties();
-			tempLayerProperties.vectorTileLayer = layer;
 			tempLayerProperties.featureProcessingStage = FeatureProcessingStage.PreProcess;
 
-			//Get all filters in the array.
-			tempLayerProperties.layerFeatureFilters = _layerProperties.filterOptions.filters.Select(m => m.GetFilterComparer()).ToArray();
-
-			// Pass them to the combiner
-			tempLayerProperties.layerFeatureFilterCombiner = new Filters.LayerFilterComparer();
-			switch (_layerProperties.filterOptions.combinerType)
-			{
-				case Filters.LayerFilterCombinerOperationType.Any:
-					tempLayerProperties.layerFeatureFilterCombiner = Filters.LayerFilterComparer.AnyOf(tempLayerProperties.layerFeatureFilters);
-					break;
-				case Filters.LayerFilterCombinerOperationType.All:
-					tempLayerProperties.layerFeatureFilterCombiner = Filters.LayerFilterComparer.AllOf(tempLayerProperties.layerFeatureFilters);
-					break;
-				case Filters.LayerFilterCombinerOperationType.None:
-					tempLayerProperties.layerFeatureFilterCombiner = Filters.LayerFilterComparer.NoneOf(tempLayerProperties.layerFeatureFilters);
-					break;
-				default:
-					break;
-			}
+			BuildLayerFilters();
+			tempLayerProperties.layerFeatureFilters = _layerFeatureFilters;
+			tempLayerProperties.layerFeatureFilterCombiner = _layerFeatureFilterCombiner;
 
 			tempLayerProperties.buildingsWithUniqueIds = (_layerProperties.honorBuildingIdSetting) && _layerProperties.buildingsWithUniqueIds;
 
 			//find any replacement criteria and assign them
+			var hasReplacementCriteria = false;
 			foreach (var goModifier in _defaultStack.GoModifiers)
 			{
 				if (goModifier is IReplacementCriteria && goModifier.Active)
 				{
 					SetReplacementCriteria((IReplacementCriteria)goModifier);
+					hasReplacementCriteria = true;
+				}
+			}
+
+			//merged output built from the same data with the same style is uploaded again without decoding,
+			//unless features depend on other layers or tiles through unique ids or replacement criteria
+			var mergedStack = _defaultStack as MergedModifierStack;
+			object cacheSource = (vectorTile != null) ? (object)vectorTile : layer;
+			if (mergedStack != null && cacheSource != null && !tempLayerProperties.buildingsWithUniqueIds && !hasReplacementCriteria)
+			{
+				var cacheName = (layer != null) ? layer.Name : layerName;
+				var cacheKey = new MergedMeshKey(cacheSource, cacheName, StyleHash, tile);
+				if (mergedStack.TryRestore(tile, cacheKey, cacheSource, cacheName))
+				{
+					if (callback != null)
+						callback(tile, this);
+					yield break;
+				}
+				mergedStack.CacheAs(tile, cacheKey, cacheSource);
+			}
+
+			#region Decode
+
+			//decoding, projection and filtering run on a worker, features come back in tile space
+			var decodeJob = (layer != null)
+				? VectorLayerDecoder.Decode(layer, tile, tempLayerProperties.buildingsWithUniqueIds, _decodeFilter)
+				: VectorLayerDecoder.Decode(vectorTile, layerName, tile, tempLayerProperties.buildingsWithUniqueIds, _decodeFilter);
+			if (!_activeDecodes.ContainsKey(tile))
+				_activeDecodes.Add(tile, new List<VectorLayerDecodeJob>());
+			_activeDecodes[tile].Add(decodeJob);
+
+			if (Application.isEditor && !Application.isPlaying)
+			{
+				decodeJob.Wait();
+			}
+			else
+			{
+				while (!decodeJob.IsDone)
+				{
+					yield return null;
 				}
 			}
 
+			if (_activeDecodes.ContainsKey(tile))
+			{
+				_activeDecodes[tile].Remove(decodeJob);
+			}
+			if (decodeJob.IsCanceled || tile.UnwrappedTileId != tileId || tile.TileState == Enums.TilePropertyState.Unregistered)
+			{
+				yield break;
+			}
+			if (decodeJob.Error != null)
+			{
+				Debug.LogException(decodeJob.Error);
+			}
+			tempLayerProperties.vectorTileLayer = decodeJob.Layer;
+
+			#endregion
+
 			#region PreProcess & Process.
 
-			var featureCount = (tempLayerProperties.vectorTileLayer == null) ? 0 : tempLayerProperties.vectorTileLayer.FeatureCount();
+			var features = decodeJob.Features;
+			var featureCount = features.Count;
 			do
 			{
+				StartFrameBudget();
 				for (int i = 0; i < featureCount; i++)
 				{
 					//checking if tile is recycled and changed
 					if (tile.UnwrappedTileId != tileId || !_activeCoroutines.ContainsKey(tile) || tile.TileState == Enums.TilePropertyState.Unregistered)
 					{
+						TileTrace.FlushPending(tileId.Canonical);
 						yield break;
 					}
 
-					ProcessFeature(i, tile, tempLayerProperties, layer.Extent);
+					ProcessFeature(features[i], tile, tempLayerProperties);
 
-					if (IsCoroutineBucketFull && !(Application.isEditor && !Application.isPlaying))
+					if ((IsCoroutineBucketFull || IsFrameBudgetSpent) && !(Application.isEditor && !Application.isPlaying))
 					{
 						//Reset bucket..
 						_entityInCurrentCoroutine = 0;
+						//modifier timings summed up so far belong to this tile, other tiles run before we're back
+						TileTrace.FlushPending(tileId.Canonical);
 						yield return null;
+						StartFrameBudget();
 					}
 				}
 				// move processing to next stage.
 				tempLayerProperties.featureProcessingStage++;
 			} while (tempLayerProperties.featureProcessingStage == FeatureProcessingStage.PreProcess
 			|| tempLayerProperties.featureProcessingStage == FeatureProcessingStage.Process);
+			TileTrace.FlushPending(tileId.Canonical);
 
 			#endregion
 
 			#region PostProcess
 			// TODO : Clean this up to follow the same pattern.
-			var mergedStack = _defaultStack as MergedModifierStack;
 			if (mergedStack != null && tile != null)
 			{
-				mergedStack.End(tile, tile.gameObject, layer.Name);
+				mergedStack.End(tile, tile.gameObject, decodeJob.LayerName);
 			}
 			#endregion
 
@@ -563,58 +646,97 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 				callback(tile, this);
 		}
 
-		private bool ProcessFeature(int index, UnityTile tile, VectorLayerVisualizerProperties layerProperties, float layerExtent)
+		/// <summary>
+		/// Builds the filters of the layer and their combiner once and compiles them for the decoder,
+		/// again after the filter options changed.
+		/// </summary>
+		private void BuildLayerFilters()
 		{
-			var fe = layerProperties.vectorTileLayer.GetFeature(index);
-			List<List<Point2d<float>>> geom;
-			if (layerProperties.buildingsWithUniqueIds == true) //ids from building dataset is big ulongs
+			if (_layerFeatureFilters != null)
 			{
-				geom = fe.Geometry<float>(); //and we're not clipping by passing no parameters
-
-				if (geom[0][0].X < 0 || geom[0][0].X > layerExtent || geom[0][0].Y < 0 || geom[0][0].Y > layerExtent)
-				{
-					return false;
-				}
+				return;
 			}
-			else //streets ids, will require clipping
+
+			//Get all filters in the array.
+			var filters = _layerProperties.filterOptions.filters.Select(m => m.GetFilterComparer()).ToArray();
+
+			// Pass them to the combiner
+			ILayerFeatureFilterComparer combiner = new Filters.LayerFilterComparer();
+			switch (_layerProperties.filterOptions.combinerType)
 			{
-				geom = fe.Geometry<float>(0); //passing zero means clip at tile edge
+				case Filters.LayerFilterCombinerOperationType.Any:
+					combiner = Filters.LayerFilterComparer.AnyOf(filters);
+					break;
+				case Filters.LayerFilterCombinerOperationType.All:
+					combiner = Filters.LayerFilterComparer.AllOf(filters);
+					break;
+				case Filters.LayerFilterCombinerOperationType.None:
+					combiner = Filters.LayerFilterComparer.NoneOf(filters);
+					break;
+				default:
+					break;
 			}
 
-			var feature = new VectorFeatureUnity(layerProperties.vectorTileLayer.GetFeature(index),
-				geom,
-				tile,
-				layerProperties.vectorTileLayer.Extent,
-				layerProperties.buildingsWithUniqueIds);
-
+			//built in comparers are compiled to run on the feature tags, the decoder only binds them to each layer
+			_decodeFilter = (filters.Length == 0) ? null : (CompiledLayerFilter.Compile(combiner) ?? combiner);
+			_layerFeatureFilterCombiner = combiner;
+			_layerFeatureFilters = filters;
+		}
 
-			if (IsFeatureEligibleAfterFiltering(feature, tile, layerProperties))
+		/// <summary>
+		/// Hash of everything besides the tile data that goes into the meshes of this layer: the layer properties and the type
+		/// and settings of each active mesh modifier.
+		/// </summary>
+		private int StyleHash
+		{
+			get
 			{
-				if (tile != null && tile.gameObject != null && tile.VectorDataState != Enums.TilePropertyState.Cancelled)
+				if (!_styleHash.HasValue)
 				{
-					switch (layerProperties.featureProcessingStage)
+					int hash = JsonUtility.ToJson(_layerProperties).GetHashCode();
+					foreach (var modifier in _defaultStack.MeshModifiers)
 					{
-						case FeatureProcessingStage.PreProcess:
-							//pre process features.
-							PreProcessFeatures(feature, tile, tile.gameObject);
-							break;
-						case FeatureProcessingStage.Process:
-							//skip existing features, only works on tilesets with unique ids
-							if (ShouldSkipProcessingFeatureWithId(feature.Data.Id, tile, layerProperties))
-							{
-								return false;
-							}
-							//feature not skipped. Add to pool only if features are in preprocess stage.
-							AddFeatureToTileObjectPool(feature, tile);
-							Build(feature, tile, tile.gameObject);
-							break;
-						case FeatureProcessingStage.PostProcess:
-							break;
-						default:
-							break;
+						if (modifier != null && modifier.Active)
+						{
+							hash = hash * 31 + modifier.GetType().FullName.GetHashCode();
+							hash = hash * 31 + JsonUtility.ToJson(modifier).GetHashCode();
+						}
 					}
-					_entityInCurrentCoroutine++;
+					_styleHash = hash;
+				}
+				return _styleHash.Value;
+			}
+		}
+
+		/// <summary>
+		/// Runs one stage of the modifier stack on a feature that has already been decoded and filtered by <see cref="VectorLayerDecoder"/>.
+		/// </summary>
+		private bool ProcessFeature(VectorFeatureUnity feature, UnityTile tile, VectorLayerVisualizerProperties layerProperties)
+		{
+			if (tile != null && tile.gameObject != null && tile.VectorDataState != Enums.TilePropertyState.Cancelled)
+			{
+				switch (layerProperties.featureProcessingStage)
+				{
+					case FeatureProcessingStage.PreProcess:
+						//pre process features.
+						PreProcessFeatures(feature, tile, tile.gameObject);
+						break;
+					case FeatureProcessingStage.Process:
+						//skip existing features, only works on tilesets with unique ids
+						if (ShouldSkipProcessingFeatureWithId(feature.Data.Id, tile, layerProperties))
+						{
+							return false;
+						}
+						//feature not skipped. Add to pool only if features are in preprocess stage.
+						AddFeatureToTileObjectPool(feature, tile);
+						Build(feature, tile, tile.gameObject);
+						break;
+					case FeatureProcessingStage.PostProcess:
+						break;
+					default:
+						break;
 				}
+				_entityInCurrentCoroutine++;
 			}
 			return true;
 		}
@@ -659,7 +781,7 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			//this will be improved in next version and will probably be replaced by filters
 			var styleSelectorKey = _layerProperties.coreOptions.sublayerName;
 
-			var meshData = new MeshData();
+			var meshData = _meshDataArena.Rent(tile);
 			meshData.TileRect = tile.Rect;
 
 			//and finally, running the modifier stack on the feature
@@ -669,9 +791,17 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			{
 				if (_defaultStack != null)
 				{
+					var trace = TileTrace.BeginPending(TileTraceStage.Modifiers);
 					_defaultStack.Execute(tile, feature, meshData, parent, styleSelectorKey);
+					trace.End();
 				}
 			}
+
+			//mesh is uploaded by now unless the stack holds on to the data, then it's released by the stack or with the tile
+			if (_defaultStack == null || !_defaultStack.RetainsMeshData)
+			{
+				_meshDataArena.Release(meshData);
+			}
 		}
 
 		/// <summary>
@@ -690,10 +820,20 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 			}
 			_activeCoroutines.Remove(tile);
 
+			if (_activeDecodes.ContainsKey(tile))
+			{
+				foreach (var job in _activeDecodes[tile])
+				{
+					job.Cancel();
+				}
+			}
+			_activeDecodes.Remove(tile);
+
 			if (_defaultStack != null)
 			{
 				_defaultStack.UnregisterTile(tile);
 			}
+			_meshDataArena.ReleaseTile(tile);
 
 			//removing ids from activeIds list so they'll be recreated next time tile loads (necessary when you're unloading/loading tiles)
 			if (_idPool.ContainsKey(tile))
@@ -710,6 +850,7 @@ namespace Mapbox.Unity.MeshGeneration.Interfaces
 		{
 			_idPool.Clear();
 			_defaultStack.Clear();
+			_meshDataArena.Clear();
 
 			foreach (var mod in _defaultStack.MeshModifiers)
 			{
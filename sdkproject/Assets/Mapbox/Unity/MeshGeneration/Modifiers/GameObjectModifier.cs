@@ -29,6 +29,12 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 
 		}
 
+		/// <summary> Called once when <paramref name="tile"/> unloads, before its entities are pooled. </summary>
+		public virtual void OnUnregisterTile(UnityTile tile)
+		{
+
+		}
+
 		public virtual void Clear()
 		{
 
@@ -18,7 +18,12 @@
 
 		public override void Run(VectorEntity ve, UnityTile tile)
         {
-			_collection.AddFeature(new double[] { ve.Transform.position.x, ve.Transform.position.z }, ve);
+			_collection.AddFeature(new double[] { ve.Transform.position.x, ve.Transform.position.z }, ve, tile);
+		}
+
+		public override void OnUnregisterTile(UnityTile tile)
+		{
+			_collection.RemoveTile(tile);
 		}
     }
 }
@@ -5,6 +5,7 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 	using Mapbox.Unity.MeshGeneration.Data;
 	using Mapbox.Unity.Map;
 	using System;
+	using System.Collections.Generic;
 
 	/// <summary>
 	/// Texture Modifier is a basic modifier which simply adds a TextureSelector script to the features.
@@ -16,6 +17,13 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 		[SerializeField]
 		GeometryMaterialOptions _options;
 
+		//satellite materials are instantiated per feature object shown, they go to a free list when the object is pooled
+		//and are handed to the next object that needs them, so only a new texture is set
+		[NonSerialized]
+		private Dictionary<GameObject, Material[]> _satelliteMaterials;
+		[NonSerialized]
+		private Stack<Material[]> _freeSatelliteMaterials;
+
 		public override void SetProperties(ModifierProperties properties)
 		{
 			_options = (GeometryMaterialOptions)properties;
@@ -46,13 +54,14 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 			}
 			else if (_options.style == StyleTypes.Satellite)
 			{
-				for (int i = 0; i < min; i++)
+				mats = GetSatelliteMaterials(ve, min);
+				if (min > 0)
 				{
-					mats[i] = Instantiate(_options.materials[i].Materials[UnityEngine.Random.Range(0, _options.materials[i].Materials.Length)]);
+					mats[0].mainTexture = tile.GetRasterData();
+					mats[0].mainTextureScale = new Vector2(1f, 1f);
 				}
-
-				mats[0].mainTexture = tile.GetRasterData();
-				mats[0].mainTextureScale = new Vector2(1f, 1f);
+				ve.MeshRenderer.sharedMaterials = mats;
+				return;
 			}
 			else
 			{
@@ -82,9 +91,76 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 
 		public override void OnPoolItem(VectorEntity vectorEntity)
 		{
-			if (_options.style == StyleTypes.Satellite)
+			Material[] mats;
+			if (_satelliteMaterials == null || vectorEntity.GameObject == null || !_satelliteMaterials.TryGetValue(vectorEntity.GameObject, out mats))
+			{
+				return;
+			}
+
+			//keep the instances for the next feature shown, just let go of the tile texture
+			_satelliteMaterials.Remove(vectorEntity.GameObject);
+			if (mats.Length > 0 && mats[0] != null)
+			{
+				mats[0].mainTexture = null;
+			}
+			_freeSatelliteMaterials.Push(mats);
+		}
+
+		public override void Clear()
+		{
+			if (_satelliteMaterials == null)
+			{
+				return;
+			}
+
+			foreach (var mats in _satelliteMaterials.Values)
+			{
+				DestroyMaterials(mats);
+			}
+			_satelliteMaterials.Clear();
+			while (_freeSatelliteMaterials.Count > 0)
+			{
+				DestroyMaterials(_freeSatelliteMaterials.Pop());
+			}
+		}
+
+		private Material[] GetSatelliteMaterials(VectorEntity ve, int count)
+		{
+			if (_satelliteMaterials == null)
+			{
+				_satelliteMaterials = new Dictionary<GameObject, Material[]>();
+				_freeSatelliteMaterials = new Stack<Material[]>();
+			}
+
+			Material[] mats;
+			if (!_satelliteMaterials.TryGetValue(ve.GameObject, out mats) && _freeSatelliteMaterials.Count > 0)
+			{
+				mats = _freeSatelliteMaterials.Pop();
+			}
+			if (mats != null)
+			{
+				if (mats.Length == count && (count == 0 || mats[0] != null))
+				{
+					_satelliteMaterials[ve.GameObject] = mats;
+					return mats;
+				}
+				DestroyMaterials(mats);
+			}
+
+			mats = new Material[count];
+			for (int i = 0; i < count; i++)
+			{
+				mats[i] = Instantiate(_options.materials[i].Materials[UnityEngine.Random.Range(0, _options.materials[i].Materials.Length)]);
+			}
+			_satelliteMaterials[ve.GameObject] = mats;
+			return mats;
+		}
+
+		private static void DestroyMaterials(Material[] mats)
+		{
+			foreach (var material in mats)
 			{
-				foreach (var material in vectorEntity.MeshRenderer.sharedMaterials)
+				if (material != null)
 				{
 					DestroyImmediate(material, true);
 				}
@@ -6,36 +6,48 @@ using Mapbox.Map;
 using Mapbox.Unity.MeshGeneration.Modifiers;
 using Mapbox.Unity.MeshGeneration.Data;
 using Mapbox.Unity.MeshGeneration.Components;
+using Mapbox.Utils;
 
 namespace Mapbox.Unity.MeshGeneration.Modifiers
 {
 	/// <summary>
-	/// Merged Modifier Stack, just like regular Modifier stack, creates a game object from features. But the difference is, regular modifier stack creates a game object for each given faeture meanwhile Merged Modifier Stack merges meshes and creates one game object for all features (until the 65k vertex limit).
+	/// Merged Modifier Stack, just like regular Modifier stack, creates a game object from features. But the difference is, regular modifier stack creates a game object for each given faeture meanwhile Merged Modifier Stack merges meshes and creates one game object for all features.
 	/// It has extremely higher performance compared to regular modifier stack but since it merged all entities together, it also loses all individual entity data & makes it harder to interact with them.
 	/// It pools and merges objects based on the tile contains them.
+	/// Features are appended to a per tile <see cref="MergedMeshBuffer"/> as soon as the mesh modifiers ran, with 32 bit indices a tile layer is a single mesh.
+	/// Merged buffers of layers built under a cache key (see <see cref="CacheAs"/>) are kept, <see cref="TryRestore"/> uploads them again without running the modifiers.
 	/// </summary>
 	[CreateAssetMenu(menuName = "Mapbox/Modifiers/Merged Modifier Stack")]
 	public class MergedModifierStack : ModifierStackBase
 	{
-		private Dictionary<UnityTile, int> _cacheVertexCount = new Dictionary<UnityTile, int>();
-		private Dictionary<UnityTile, List<MeshData>> _cached = new Dictionary<UnityTile, List<MeshData>>();
-		private Dictionary<UnityTile, int> _buildingCount = new Dictionary<UnityTile, int>();
+		/// <summary> Free merged buffers kept for the next tiles, surplus releases are dropped. </summary>
+		public const int MAX_POOLED_BUFFERS = 16;
+
+		[Tooltip("Merge whole tiles into one mesh with 32 bit indices, otherwise meshes are split at 65000 vertices.")]
+		public bool Use32BitIndices = true;
+		[Tooltip("Vertices of merged tile layers kept to rebuild them without running the modifiers again, 0 disables the cache.")]
+		public int CachedVertexBudget = 1 << 18;
+
+		private Dictionary<UnityTile, MergedMeshBuffer> _buffers = new Dictionary<UnityTile, MergedMeshBuffer>();
+		// buffers uploaded for the layer being built, cached or released when it ends
+		private Dictionary<UnityTile, List<MergedMeshBuffer>> _uploaded = new Dictionary<UnityTile, List<MergedMeshBuffer>>();
+		private Dictionary<UnityTile, MergedMeshKey> _cacheKeys = new Dictionary<UnityTile, MergedMeshKey>();
+		private Dictionary<UnityTile, object> _cacheSources = new Dictionary<UnityTile, object>();
+		private Stack<MergedMeshBuffer> _freeBuffers = new Stack<MergedMeshBuffer>();
+		private MergedMeshCache _cache;
 
 		private Dictionary<UnityTile, List<VectorEntity>> _activeObjects = new Dictionary<UnityTile, List<VectorEntity>>();
-		private MeshData _tempMeshData;
 		private MeshFilter _tempMeshFilter;
 		private GameObject _tempGameObject;
 		private VectorEntity _tempVectorEntity;
-		private MeshData _temp2MeshData;
 		private ObjectPool<VectorEntity> _pool;
 		private ObjectPool<List<VectorEntity>> _listPool;
-		private ObjectPool<List<MeshData>> _meshDataPool;
+		private ObjectPool<List<MergedMeshBuffer>> _bufferListPool;
 
-		private int _counter, _counter2;
+		private int _counter;
 
 		protected virtual void OnEnable()
 		{
-			//we'll use this to concat building data until it reaches 65000 verts
 			_pool = new ObjectPool<VectorEntity>(() =>
 			{
 				_tempGameObject = new GameObject();
@@ -52,18 +64,34 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				return _tempVectorEntity;
 			});
 			_listPool = new ObjectPool<List<VectorEntity>>(() => { return new List<VectorEntity>(); });
-			_meshDataPool = new ObjectPool<List<MeshData>>(() => { return new List<MeshData>(); });
-			_tempMeshData = new MeshData();
+			_bufferListPool = new ObjectPool<List<MergedMeshBuffer>>(() => { return new List<MergedMeshBuffer>(); });
+			_cache = new MergedMeshCache(CachedVertexBudget, ReleaseBuffer);
+		}
+
+		/// <summary> Vertices currently held by the merged mesh cache. </summary>
+		public int CachedVertexCount
+		{
+			get { return _cache.VertexCount; }
 		}
 
 		public override void OnUnregisterTile(UnityTile tile)
 		{
+			_counter = GoModifiers.Count;
+			for (int i = 0; i < _counter; i++)
+			{
+				GoModifiers[i].OnUnregisterTile(tile);
+			}
+
 			//removing all caches
 			if (_activeObjects.ContainsKey(tile))
 			{
 				_counter = _activeObjects[tile].Count;
 				for (int i = 0; i < _counter; i++)
 				{
+					foreach (var item in GoModifiers)
+					{
+						item.OnPoolItem(_activeObjects[tile][i]);
+					}
 					if (null != _activeObjects[tile][i].GameObject)
 					{
 						_activeObjects[tile][i].GameObject.SetActive(false);
@@ -76,30 +104,34 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				_activeObjects.Remove(tile);
 			}
 
-			//reset all counters
-			if (_cacheVertexCount.ContainsKey(tile))
-			{
-				_cacheVertexCount.Remove(tile);
-			}
-			if (_cached.ContainsKey(tile))
-			{
-				_cached[tile].Clear();
-				_meshDataPool.Put(_cached[tile]);
-				_cached.Remove(tile);
-			}
-			if (_buildingCount.ContainsKey(tile))
-			{
-				_buildingCount.Remove(tile);
-			}
+			//a layer cut short is incomplete, never cache it
+			ReleaseTileBuffers(tile);
 		}
 
 		public override void Initialize()
 		{
 			base.Initialize();
 			//init is also used for reloading map/ location change, so reseting everything here
-			_cacheVertexCount.Clear();
-			_cached.Clear();
-			_buildingCount.Clear();
+			//the cache stays, its entries only match the tile data they were built from
+			var tiles = new List<UnityTile>(_buffers.Keys);
+			tiles.AddRange(_uploaded.Keys);
+			foreach (var tile in tiles)
+			{
+				ReleaseTileBuffers(tile);
+			}
+			_cache.VertexBudget = CachedVertexBudget;
+			//pooled objects would be orphaned otherwise
+			foreach (var vectorEntity in _pool.GetQueue())
+			{
+				if (vectorEntity.Mesh != null)
+				{
+					vectorEntity.Mesh.Destroy(true);
+				}
+				if (vectorEntity.GameObject != null)
+				{
+					vectorEntity.GameObject.Destroy();
+				}
+			}
 			_pool.Clear();
 
 			_counter = MeshModifiers.Count;
@@ -115,18 +147,15 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 			}
 		}
 
+		public override bool RetainsMeshData
+		{
+			get { return false; }
+		}
+
 		public override GameObject Execute(UnityTile tile, VectorFeatureUnity feature, MeshData meshData, GameObject parent = null, string type = "")
 		{
 			base.Execute(tile, feature, meshData, parent, type);
 
-			if (!_cacheVertexCount.ContainsKey(tile))
-			{
-				_cacheVertexCount.Add(tile, 0);
-				_cached.Add(tile, _meshDataPool.GetObject());
-				_buildingCount.Add(tile, 0);
-			}
-
-			_buildingCount[tile]++;
 			_counter = MeshModifiers.Count;
 			for (int i = 0; i < _counter; i++)
 			{
@@ -137,126 +166,188 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 			}
 
 			GameObject go = null;
-			//65000 is the vertex limit for meshes, keep stashing it until that
-			_counter = meshData.Vertices.Count;
-			if (_cacheVertexCount[tile] + _counter < 65000)
-			{
-				_cacheVertexCount[tile] += _counter;
-				_cached[tile].Add(meshData);
-			}
-			else
+			var buffer = GetBuffer(tile);
+			//16 bit meshes are cut at 65000 vertices, the feature goes into the next one
+			if (!Use32BitIndices && buffer.VertexCount + meshData.Vertices.Count >= MergedMeshBuffer.MAX_16BIT_VERTICES)
 			{
-				go = End(tile, parent, type);
+				go = Flush(tile, type);
+				buffer = GetBuffer(tile);
 			}
+			buffer.Append(meshData);
 
 			return go;
 		}
 
+		/// <summary>
+		/// Build the merged output of the features of <paramref name="tile"/> under <paramref name="key"/>, once the layer
+		/// ends it's cached for <see cref="TryRestore"/>. <paramref name="source"/> is the data the features come from.
+		/// </summary>
+		public void CacheAs(UnityTile tile, MergedMeshKey key, object source)
+		{
+			if (CachedVertexBudget <= 0 || source == null)
+			{
+				return;
+			}
+			_cacheKeys[tile] = key;
+			_cacheSources[tile] = source;
+		}
 
-		public GameObject End(UnityTile tile, GameObject parent, string name = "")
+		/// <summary>
+		/// Upload the cached output of <paramref name="key"/> to <paramref name="tile"/> and run the game object modifiers
+		/// on it, false if nothing was cached for it.
+		/// </summary>
+		public bool TryRestore(UnityTile tile, MergedMeshKey key, object source, string name = "")
 		{
-			var c2 = 0;
-			if (_cached.ContainsKey(tile))
+			if (source == null)
 			{
-				_tempMeshData.Clear();
+				return false;
+			}
+			var buffers = _cache.Get(key, source);
+			if (buffers == null)
+			{
+				return false;
+			}
 
-				//concat mesh data into _tempMeshData
-				_counter = _cached[tile].Count;
-				for (int i = 0; i < _counter; i++)
+			for (int i = 0; i < buffers.Count; i++)
+			{
+				Upload(tile, buffers[i], name);
+			}
+			return true;
+		}
+
+		public GameObject End(UnityTile tile, GameObject parent, string name = "")
+		{
+			var go = Flush(tile, name);
+
+			List<MergedMeshBuffer> uploaded;
+			if (_uploaded.TryGetValue(tile, out uploaded))
+			{
+				_uploaded.Remove(tile);
+				MergedMeshKey key;
+				if (_cacheKeys.TryGetValue(tile, out key))
+				{
+					//the cache keeps the list, it's not pooled
+					_cache.Add(key, _cacheSources[tile], uploaded);
+				}
+				else
 				{
-					_temp2MeshData = _cached[tile][i];
-					if (_temp2MeshData.Vertices.Count <= 3)
-						continue;
+					ReleaseBuffers(uploaded);
+				}
+			}
+			_cacheKeys.Remove(tile);
+			_cacheSources.Remove(tile);
 
-					var st = _tempMeshData.Vertices.Count;
-					_tempMeshData.Vertices.AddRange(_temp2MeshData.Vertices);
-					_tempMeshData.Normals.AddRange(_temp2MeshData.Normals);
+			return go;
+		}
 
-					c2 = _temp2MeshData.UV.Count;
-					for (int j = 0; j < c2; j++)
-					{
-						if (_tempMeshData.UV.Count <= j)
-						{
-							_tempMeshData.UV.Add(new List<Vector2>(_temp2MeshData.UV[j].Count));
-						}
-					}
+		/// <summary>
+		/// Upload the open buffer of the tile as a new mesh and keep it until the layer ends.
+		/// </summary>
+		private GameObject Flush(UnityTile tile, string name)
+		{
+			MergedMeshBuffer buffer;
+			if (!_buffers.TryGetValue(tile, out buffer) || buffer.VertexCount <= 3)
+			{
+				return null;
+			}
 
-					c2 = _temp2MeshData.UV.Count;
-					for (int j = 0; j < c2; j++)
-					{
-						_tempMeshData.UV[j].AddRange(_temp2MeshData.UV[j]);
-					}
+			_buffers.Remove(tile);
+			List<MergedMeshBuffer> uploaded;
+			if (!_uploaded.TryGetValue(tile, out uploaded))
+			{
+				uploaded = _cacheKeys.ContainsKey(tile) ? new List<MergedMeshBuffer>() : _bufferListPool.GetObject();
+				_uploaded.Add(tile, uploaded);
+			}
+			uploaded.Add(buffer);
 
-					c2 = _temp2MeshData.Triangles.Count;
-					for (int j = 0; j < c2; j++)
-					{
-						if (_tempMeshData.Triangles.Count <= j)
-						{
-							_tempMeshData.Triangles.Add(new List<int>(_temp2MeshData.Triangles[j].Count));
-						}
-					}
+			return Upload(tile, buffer, name).GameObject;
+		}
 
-					for (int j = 0; j < c2; j++)
-					{
-						for (int k = 0; k < _temp2MeshData.Triangles[j].Count; k++)
-						{
-							_tempMeshData.Triangles[j].Add(_temp2MeshData.Triangles[j][k] + st);
-						}
-					}
-				}
+		private VectorEntity Upload(UnityTile tile, MergedMeshBuffer buffer, string name)
+		{
+			_tempVectorEntity = _pool.GetObject();
+			_tempVectorEntity.GameObject.SetActive(true);
+			_tempVectorEntity.GameObject.name = name;
+			var trace = TileTrace.Begin(TileTraceStage.Upload, tile.CanonicalTileId);
+			buffer.Upload(_tempVectorEntity.Mesh);
+			trace.End();
+			_tempVectorEntity.GameObject.transform.SetParent(tile.transform, false);
+
+			if (!_activeObjects.ContainsKey(tile))
+			{
+				_activeObjects.Add(tile, _listPool.GetObject());
+			}
+			_activeObjects[tile].Add(_tempVectorEntity);
 
-				//update pooled vector entity with new data
-				if (_tempMeshData.Vertices.Count > 3)
+			_counter = GoModifiers.Count;
+			for (int i = 0; i < _counter; i++)
+			{
+				if (GoModifiers[i].Active)
 				{
-					_cached[tile].Clear();
-					_cacheVertexCount[tile] = 0;
-					_tempVectorEntity = null;
-					_tempVectorEntity = _pool.GetObject();
-					_tempVectorEntity.GameObject.SetActive(true);
-					_tempVectorEntity.Mesh.Clear();
-
-					_tempVectorEntity.GameObject.name = name;
-					_tempVectorEntity.Mesh.subMeshCount = _tempMeshData.Triangles.Count;
-					_tempVectorEntity.Mesh.SetVertices(_tempMeshData.Vertices);
-					_tempVectorEntity.Mesh.SetNormals(_tempMeshData.Normals);
-
-					_counter = _tempMeshData.Triangles.Count;
-					for (int i = 0; i < _counter; i++)
-					{
-						_tempVectorEntity.Mesh.SetTriangles(_tempMeshData.Triangles[i], i);
-					}
+					GoModifiers[i].Run(_tempVectorEntity, tile);
+				}
+			}
 
-					_counter = _tempMeshData.UV.Count;
-					for (int i = 0; i < _counter; i++)
-					{
-						_tempVectorEntity.Mesh.SetUVs(i, _tempMeshData.UV[i]);
-					}
+			return _tempVectorEntity;
+		}
 
-					_tempVectorEntity.GameObject.transform.SetParent(tile.transform, false);
+		private MergedMeshBuffer GetBuffer(UnityTile tile)
+		{
+			MergedMeshBuffer buffer;
+			if (!_buffers.TryGetValue(tile, out buffer))
+			{
+				buffer = _freeBuffers.Count > 0 ? _freeBuffers.Pop() : new MergedMeshBuffer();
+				_buffers.Add(tile, buffer);
+			}
+			return buffer;
+		}
 
-					if (!_activeObjects.ContainsKey(tile))
-					{
-						_activeObjects.Add(tile, _listPool.GetObject());
-					}
-					_activeObjects[tile].Add(_tempVectorEntity);
+		/// <summary>
+		/// Give the open and uploaded but not yet cached buffers of the tile back to the pool.
+		/// </summary>
+		private void ReleaseTileBuffers(UnityTile tile)
+		{
+			MergedMeshBuffer buffer;
+			if (_buffers.TryGetValue(tile, out buffer))
+			{
+				ReleaseBuffer(buffer);
+				_buffers.Remove(tile);
+			}
 
-					_counter = GoModifiers.Count;
-					for (int i = 0; i < _counter; i++)
-					{
-						if (GoModifiers[i].Active)
-						{
-							GoModifiers[i].Run(_tempVectorEntity, tile);
-						}
-					}
+			List<MergedMeshBuffer> uploaded;
+			if (_uploaded.TryGetValue(tile, out uploaded))
+			{
+				ReleaseBuffers(uploaded);
+				_uploaded.Remove(tile);
+			}
+			_cacheKeys.Remove(tile);
+			_cacheSources.Remove(tile);
+		}
 
-					return _tempVectorEntity.GameObject;
-				}
+		private void ReleaseBuffers(List<MergedMeshBuffer> buffers)
+		{
+			for (int i = 0; i < buffers.Count; i++)
+			{
+				ReleaseBuffer(buffers[i]);
+			}
+			buffers.Clear();
+			_bufferListPool.Put(buffers);
+		}
+
+		private void ReleaseBuffer(MergedMeshBuffer buffer)
+		{
+			if (_freeBuffers.Count < MAX_POOLED_BUFFERS)
+			{
+				buffer.Clear();
+				_freeBuffers.Push(buffer);
 			}
-			return null;
 		}
 
 		public override void Clear()
 		{
+			_cache.Clear();
+			_freeBuffers.Clear();
+
 			foreach (var vectorEntity in _pool.GetQueue())
 			{
 				if (vectorEntity.Mesh != null)
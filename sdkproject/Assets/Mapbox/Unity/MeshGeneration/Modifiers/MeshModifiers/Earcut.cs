@@ -1,86 +1,237 @@
 using System;
 using System.Collections.Generic;
-using Mapbox.VectorTile.Geometry;
+using Mapbox.Unity.MeshGeneration.Data;
 using UnityEngine;
 
 namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 {
 	public static class EarcutLibrary
 	{
+		//one triangulator per thread, triangulation itself doesn't allocate once its arena has grown
+		[ThreadStatic]
+		private static EarcutTriangulator _triangulator;
+
+		private static EarcutTriangulator Triangulator
+		{
+			get
+			{
+				if (_triangulator == null)
+				{
+					_triangulator = new EarcutTriangulator();
+				}
+				return _triangulator;
+			}
+		}
+
 		public static List<int> Earcut(List<float> data, List<int> holeIndices, int dim)
 		{
-			dim = Math.Max(dim, 2);
+			var triangles = new List<int>();
+			Triangulator.Triangulate(data, holeIndices, dim, triangles, 0);
+			return triangles;
+		}
 
-			var hasHoles = holeIndices.Count;
-			var outerLen = hasHoles > 0 ? holeIndices[0] * dim : data.Count;
-			var outerNode = linkedList(data, 0, outerLen, dim, true);
-			var triangles = new List<int>((int)(outerNode.i * 1.5));
+		/// <summary>
+		/// Triangulate without allocating: indices are appended to <paramref name="triangles"/>, shifted by <paramref name="indexOffset"/>.
+		/// </summary>
+		public static void Earcut(List<float> data, List<int> holeIndices, int dim, List<int> triangles, int indexOffset = 0)
+		{
+			Triangulator.Triangulate(data, holeIndices, dim, triangles, indexOffset);
+		}
 
-			if (outerNode == null) return triangles;
-			var minX = 0f;
-			var minY = 0f;
-			var maxX = 0f;
-			var maxY = 0f;
-			var x = 0f;
-			var y = 0f;
-			var size = 0f;
+		public static Data Flatten(List<List<Vector3>> data)
+		{
+			var result = new Data();
+			Flatten(data, result);
+			return result;
+		}
 
-			if (hasHoles > 0) outerNode = EliminateHoles(data, holeIndices, outerNode, dim);
+		/// <summary>
+		/// Flatten into an existing <see cref="Data"/>, its lists are cleared and reused.
+		/// </summary>
+		public static void Flatten(List<List<Vector3>> data, Data result)
+		{
+			var dataCount = data.Count;
+			var totalVertCount = 0;
+			for (int i = 0; i < dataCount; i++)
+			{
+				totalVertCount += data[i].Count;
+			}
 
-			// if the shape is not too simple, we'll use z-order curve hash later; calculate polygon bbox
-			if (data.Count > 80 * dim)
+			result.Dim = 2;
+			if (result.Vertices == null)
 			{
-				minX = maxX = data[0];
-				minY = maxY = data[1];
+				result.Vertices = new List<float>(totalVertCount * 2);
+			}
+			else
+			{
+				result.Vertices.Clear();
+				MeshData.Reserve(result.Vertices, totalVertCount * 2);
+			}
+			result.Holes.Clear();
+			var holeIndex = 0;
 
-				for (var i = dim; i < outerLen; i += dim)
+			for (var i = 0; i < dataCount; i++)
+			{
+				var subCount = data[i].Count;
+				for (var j = 0; j < subCount; j++)
 				{
-					x = data[i];
-					y = data[i + 1];
-					if (x < minX) minX = x;
-					if (y < minY) minY = y;
-					if (x > maxX) maxX = x;
-					if (y > maxY) maxY = y;
+					result.Vertices.Add(data[i][j][0]);
+					result.Vertices.Add(data[i][j][2]);
+				}
+				if (i > 0)
+				{
+					holeIndex += data[i - 1].Count;
+					result.Holes.Add(holeIndex);
 				}
-
-				// minX, minY and size are later used to transform coords into integers for z-order calculation
-				size = Math.Max(maxX - minX, maxY - minY);
 			}
+		}
+	}
 
-			earcutLinked(outerNode, triangles, dim, minX, minY, size);
+	/// <summary>
+	/// Earcut triangulation (port of mapbox/earcut) on an index based node arena.
+	/// Nodes live in parallel arrays that grow with the largest polygon seen and are reused for every polygon,
+	/// so triangulating doesn't allocate. Not thread safe, use one instance per thread.
+	/// </summary>
+	public sealed class EarcutTriangulator
+	{
+		private const int NIL = -1;
 
-			return triangles;
+		//node arena, a node is an index into these arrays
+		private int[] _i;
+		private float[] _x;
+		private float[] _y;
+		private int[] _z;
+		private int[] _prev;
+		private int[] _next;
+		private int[] _prevZ;
+		private int[] _nextZ;
+		private bool[] _steiner;
+		private int _count;
+
+		private readonly List<int> _holeQueue = new List<int>();
+		private readonly Comparison<int> _compareX;
+
+		//state of the current polygon
+		private List<int> _triangles;
+		private int _dim;
+		private int _indexOffset;
+
+		public EarcutTriangulator(int capacity = 64)
+		{
+			allocate(Math.Max(capacity, 4));
+			_compareX = compareX;
+		}
+
+		/// <summary> Number of nodes the arena can hold without growing. </summary>
+		public int Capacity
+		{
+			get { return _i.Length; }
+		}
+
+		/// <summary>
+		/// Triangulate one polygon, same as <see cref="EarcutLibrary.Earcut(List{float}, List{int}, int)"/>.
+		/// </summary>
+		public void Triangulate(List<float> data, List<int> holeIndices, int dim, List<int> triangles, int indexOffset)
+		{
+			Triangulate(data, 0, data.Count, holeIndices, 0, holeIndices == null ? 0 : holeIndices.Count, dim, triangles, indexOffset);
+		}
+
+		/// <summary>
+		/// Triangulate the polygon stored in <paramref name="data"/> between <paramref name="start"/> and <paramref name="end"/>.
+		/// </summary>
+		/// <param name="start">First coordinate of the outer ring.</param>
+		/// <param name="end">End of the last ring, exclusive.</param>
+		/// <param name="holeIndices">Vertex index (coordinate / dim) where each hole starts.</param>
+		/// <param name="firstHole">Position of the first hole of this polygon in <paramref name="holeIndices"/>.</param>
+		/// <param name="holeCount">Number of holes.</param>
+		/// <param name="triangles">Triangle indices are appended here: vertex index in <paramref name="data"/> plus <paramref name="indexOffset"/>.</param>
+		public void Triangulate(List<float> data, int start, int end, List<int> holeIndices, int firstHole, int holeCount, int dim, List<int> triangles, int indexOffset)
+		{
+			dim = Math.Max(dim, 2);
+			_count = 0;
+			_dim = dim;
+			_triangles = triangles;
+			_indexOffset = indexOffset;
+
+			try
+			{
+				var outerLen = holeCount > 0 ? holeIndices[firstHole] * dim : end;
+				var outerNode = linkedList(data, start, outerLen, true);
+				if (outerNode == NIL) return;
+
+				MeshData.Reserve(triangles, (end - start) / dim * 3);
+				var minX = 0f;
+				var minY = 0f;
+				var maxX = 0f;
+				var maxY = 0f;
+				var x = 0f;
+				var y = 0f;
+				var size = 0f;
+
+				if (holeCount > 0) outerNode = eliminateHoles(data, end, holeIndices, firstHole, holeCount, outerNode);
+
+				// if the shape is not too simple, we'll use z-order curve hash later; calculate polygon bbox
+				if (end - start > 80 * dim)
+				{
+					minX = maxX = data[start];
+					minY = maxY = data[start + 1];
+
+					for (var i = start + dim; i < outerLen; i += dim)
+					{
+						x = data[i];
+						y = data[i + 1];
+						if (x < minX) minX = x;
+						if (y < minY) minY = y;
+						if (x > maxX) maxX = x;
+						if (y > maxY) maxY = y;
+					}
+
+					// minX, minY and size are later used to transform coords into integers for z-order calculation
+					size = Math.Max(maxX - minX, maxY - minY);
+				}
+
+				earcutLinked(outerNode, minX, minY, size, 0);
+			}
+			finally
+			{
+				_triangles = null;
+			}
 		}
 
-		private static void earcutLinked(Node ear, List<int> triangles, int dim, float minX, float minY, float size, int pass = 0)
+		private void addTriangle(int a, int b, int c)
 		{
-			if (ear == null) return;
+			_triangles.Add(_i[a] / _dim + _indexOffset);
+			_triangles.Add(_i[b] / _dim + _indexOffset);
+			_triangles.Add(_i[c] / _dim + _indexOffset);
+		}
+
+		private void earcutLinked(int ear, float minX, float minY, float size, int pass)
+		{
+			if (ear == NIL) return;
 
 			// interlink polygon nodes in z-order
 			if (pass == 0 && size > 0) indexCurve(ear, minX, minY, size);
 
 			var stop = ear;
-			Node prev;
-			Node next;
+			int prev;
+			int next;
 
 			// iterate through ears, slicing them one by one
-			while (ear.prev != ear.next)
+			while (_prev[ear] != _next[ear])
 			{
-				prev = ear.prev;
-				next = ear.next;
+				prev = _prev[ear];
+				next = _next[ear];
 
 				if (size > 0 ? isEarHashed(ear, minX, minY, size) : isEar(ear))
 				{
 					// cut off the triangle
-					triangles.Add(prev.i / dim);
-					triangles.Add(next.i / dim);
-					triangles.Add(ear.i / dim);
+					addTriangle(prev, next, ear);
 
 					removeNode(ear);
 
 					// skipping the next vertice leads to less sliver triangles
-					ear = next.next;
-					stop = next.next;
+					ear = _next[next];
+					stop = _next[next];
 
 					continue;
 				}
@@ -93,20 +244,20 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 					// try filtering points and slicing again
 					if (pass == 0)
 					{
-						earcutLinked(FilterPoints(ear, null), triangles, dim, minX, minY, size, 1);
+						earcutLinked(filterPoints(ear, NIL), minX, minY, size, 1);
 
 						// if this didn't work, try curing all small self-intersections locally
 					}
 					else if (pass == 1)
 					{
-						ear = cureLocalIntersections(ear, triangles, dim);
-						earcutLinked(ear, triangles, dim, minX, minY, size, 2);
+						ear = cureLocalIntersections(ear);
+						earcutLinked(ear, minX, minY, size, 2);
 
 						// as a last resort, try splitting the remaining polygon into two
 					}
 					else if (pass == 2)
 					{
-						splitEarcut(ear, triangles, dim, minX, minY, size);
+						splitEarcut(ear, minX, minY, size);
 					}
 
 					break;
@@ -114,45 +265,46 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 			}
 		}
 
-
-		private static bool isEarHashed(Node ear, float minX, float minY, float size)
+		private bool isEarHashed(int ear, float minX, float minY, float size)
 		{
-			var a = ear.prev;
+			var a = _prev[ear];
 			var b = ear;
-			var c = ear.next;
+			var c = _next[ear];
 
 			if (area(a, b, c) >= 0) return false; // reflex, can't be an ear
 
+			float ax = _x[a], ay = _y[a], bx = _x[b], by = _y[b], cx = _x[c], cy = _y[c];
+
 			// triangle bbox; min & max are calculated like this for speed
-			var minTX = a.x < b.x ? (a.x < c.x ? a.x : c.x) : (b.x < c.x ? b.x : c.x);
-			var minTY = a.y < b.y ? (a.y < c.y ? a.y : c.y) : (b.y < c.y ? b.y : c.y);
-			var maxTX = a.x > b.x ? (a.x > c.x ? a.x : c.x) : (b.x > c.x ? b.x : c.x);
-			var maxTY = a.y > b.y ? (a.y > c.y ? a.y : c.y) : (b.y > c.y ? b.y : c.y);
+			var minTX = ax < bx ? (ax < cx ? ax : cx) : (bx < cx ? bx : cx);
+			var minTY = ay < by ? (ay < cy ? ay : cy) : (by < cy ? by : cy);
+			var maxTX = ax > bx ? (ax > cx ? ax : cx) : (bx > cx ? bx : cx);
+			var maxTY = ay > by ? (ay > cy ? ay : cy) : (by > cy ? by : cy);
 
 			// z-order range for the current triangle bbox;
 			var minZ = zOrder(minTX, minTY, minX, minY, size);
 			var maxZ = zOrder(maxTX, maxTY, minX, minY, size);
 
 			// first look for points inside the triangle in increasing z-order
-			var p = ear.nextZ;
+			var p = _nextZ[ear];
 
-			while (p != null && p.mZOrder <= maxZ)
+			while (p != NIL && _z[p] <= maxZ)
 			{
-				if (p != ear.prev && p != ear.next &&
-					pointInTriangle(a.x, a.y, b.x, b.y, c.x, c.y, p.x, p.y) &&
-					area(p.prev, p, p.next) >= 0) return false;
-				p = p.nextZ;
+				if (p != a && p != c &&
+					pointInTriangle(ax, ay, bx, by, cx, cy, _x[p], _y[p]) &&
+					area(_prev[p], p, _next[p]) >= 0) return false;
+				p = _nextZ[p];
 			}
 
 			// then look for points in decreasing z-order
-			p = ear.prevZ;
+			p = _prevZ[ear];
 
-			while (p != null && p.mZOrder >= minZ)
+			while (p != NIL && _z[p] >= minZ)
 			{
-				if (p != ear.prev && p != ear.next &&
-					pointInTriangle(a.x, a.y, b.x, b.y, c.x, c.y, p.x, p.y) &&
-					area(p.prev, p, p.next) >= 0) return false;
-				p = p.prevZ;
+				if (p != a && p != c &&
+					pointInTriangle(ax, ay, bx, by, cx, cy, _x[p], _y[p]) &&
+					area(_prev[p], p, _next[p]) >= 0) return false;
+				p = _prevZ[p];
 			}
 
 			return true;
@@ -177,164 +329,166 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 			return (int)x | ((int)y << 1);
 		}
 
-		private static void splitEarcut(Node start, List<int> triangles, int dim, float minX, float minY, float size)
+		private void splitEarcut(int start, float minX, float minY, float size)
 		{
 			var a = start;
 			do
 			{
-				var b = a.next.next;
-				while (b != a.prev)
+				var b = _next[_next[a]];
+				while (b != _prev[a])
 				{
-					if (a.i != b.i && isValidDiagonal(a, b))
+					if (_i[a] != _i[b] && isValidDiagonal(a, b))
 					{
 						// split the polygon in two by the diagonal
-						var c = SplitPolygon(a, b);
+						var c = splitPolygon(a, b);
 
 						// filter colinear points around the cuts
-						a = FilterPoints(a, a.next);
-						c = FilterPoints(c, c.next);
+						a = filterPoints(a, _next[a]);
+						c = filterPoints(c, _next[c]);
 
 						// run earcut on each half
-						earcutLinked(a, triangles, dim, minX, minY, size);
-						earcutLinked(c, triangles, dim, minX, minY, size);
+						earcutLinked(a, minX, minY, size, 0);
+						earcutLinked(c, minX, minY, size, 0);
 						return;
 					}
-					b = b.next;
+					b = _next[b];
 				}
-				a = a.next;
+				a = _next[a];
 			} while (a != start);
 		}
 
-		private static bool isValidDiagonal(Node a, Node b)
+		private bool isValidDiagonal(int a, int b)
 		{
-			return a.next.i != b.i && a.prev.i != b.i && !intersectsPolygon(a, b) &&
-		   locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b);
+			return _i[_next[a]] != _i[b] && _i[_prev[a]] != _i[b] && !intersectsPolygon(a, b) &&
+				locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b);
 		}
 
-		private static bool middleInside(Node a, Node b)
+		private bool middleInside(int a, int b)
 		{
 			var p = a;
 			var inside = false;
-			var px = (a.x + b.x) / 2;
-			var py = (a.y + b.y) / 2;
+			var px = (_x[a] + _x[b]) / 2;
+			var py = (_y[a] + _y[b]) / 2;
 
 			do
 			{
-				if (((p.y > py) != (p.next.y > py)) && p.next.y != p.y &&
-						(px < (p.next.x - p.x) * (py - p.y) / (p.next.y - p.y) + p.x))
+				var n = _next[p];
+				if (((_y[p] > py) != (_y[n] > py)) && _y[n] != _y[p] &&
+						(px < (_x[n] - _x[p]) * (py - _y[p]) / (_y[n] - _y[p]) + _x[p]))
 					inside = !inside;
-				p = p.next;
+				p = n;
 			} while (p != a);
 
 			return inside;
 		}
 
-		private static bool intersectsPolygon(Node a, Node b)
+		private bool intersectsPolygon(int a, int b)
 		{
 			var p = a;
 			do
 			{
-				if (p.i != a.i && p.next.i != a.i && p.i != b.i && p.next.i != b.i &&
-						intersects(p, p.next, a, b)) return true;
-				p = p.next;
+				var n = _next[p];
+				if (_i[p] != _i[a] && _i[n] != _i[a] && _i[p] != _i[b] && _i[n] != _i[b] &&
+						intersects(p, n, a, b)) return true;
+				p = n;
 			} while (p != a);
 
 			return false;
 		}
 
-		private static Node cureLocalIntersections(Node start, List<int> triangles, int dim)
+		private int cureLocalIntersections(int start)
 		{
 			var p = start;
 			do
 			{
-				var a = p.prev;
-				var b = p.next.next;
+				var a = _prev[p];
+				var b = _next[_next[p]];
 
-				if (!equals(a, b) && intersects(a, p, p.next, b) && locallyInside(a, b) && locallyInside(b, a))
+				if (!equals(a, b) && intersects(a, p, _next[p], b) && locallyInside(a, b) && locallyInside(b, a))
 				{
-
-					triangles.Add(a.i / dim);
-					triangles.Add(p.i / dim);
-					triangles.Add(b.i / dim);
+					addTriangle(a, p, b);
 
 					// remove two nodes involved
 					removeNode(p);
-					removeNode(p.next);
+					removeNode(_next[p]);
 
 					p = start = b;
 				}
-				p = p.next;
+				p = _next[p];
 			} while (p != start);
 
 			return p;
 		}
 
-		private static bool intersects(Node p1, Node q1, Node p2, Node q2)
+		private bool intersects(int p1, int q1, int p2, int q2)
 		{
 			if ((equals(p1, q1) && equals(p2, q2)) ||
-		(equals(p1, q2) && equals(p2, q1))) return true;
+				(equals(p1, q2) && equals(p2, q1))) return true;
 			return area(p1, q1, p2) > 0 != area(p1, q1, q2) > 0 &&
 				   area(p2, q2, p1) > 0 != area(p2, q2, q1) > 0;
 		}
 
-		private static bool isEar(Node ear)
+		private bool isEar(int ear)
 		{
-			var a = ear.prev;
+			var a = _prev[ear];
 			var b = ear;
-			var c = ear.next;
+			var c = _next[ear];
 
 			if (area(a, b, c) >= 0) return false; // reflex, can't be an ear
 
+			float ax = _x[a], ay = _y[a], bx = _x[b], by = _y[b], cx = _x[c], cy = _y[c];
+
 			// now make sure we don't have other points inside the potential ear
-			var p = ear.next.next;
+			var p = _next[c];
 
-			while (p != ear.prev)
+			while (p != a)
 			{
-				if (pointInTriangle(a.x, a.y, b.x, b.y, c.x, c.y, p.x, p.y) &&
-					area(p.prev, p, p.next) >= 0) return false;
-				p = p.next;
+				if (pointInTriangle(ax, ay, bx, by, cx, cy, _x[p], _y[p]) &&
+					area(_prev[p], p, _next[p]) >= 0) return false;
+				p = _next[p];
 			}
 
 			return true;
 		}
 
-		private static void indexCurve(Node start, float minX, float minY, float size)
+		private void indexCurve(int start, float minX, float minY, float size)
 		{
 			var p = start;
 			do
 			{
-				if (p.mZOrder == 0) p.mZOrder = zOrder(p.x, p.y, minX, minY, size);
-				p.prevZ = p.prev;
-				p.nextZ = p.next;
-				p = p.next;
+				if (_z[p] == 0) _z[p] = zOrder(_x[p], _y[p], minX, minY, size);
+				_prevZ[p] = _prev[p];
+				_nextZ[p] = _next[p];
+				p = _next[p];
 			} while (p != start);
 
-			p.prevZ.nextZ = null;
-			p.prevZ = null;
+			_nextZ[_prevZ[p]] = NIL;
+			_prevZ[p] = NIL;
 
 			sortLinked(p);
 		}
 
-		private static Node sortLinked(Node list)
+		// simon tatham's linked list merge sort on the z-order links
+		private int sortLinked(int list)
 		{
-			var i = 0;
-			Node p;
-			Node q;
-			Node e;
-			Node tail;
-			var numMerges = 0; ;
-			var pSize = 0;
-			var qSize = 0;
+			int i;
+			int p;
+			int q;
+			int e;
+			int tail;
+			int numMerges;
+			int pSize;
+			int qSize;
 			var inSize = 1;
 
 			do
 			{
 				p = list;
-				list = null;
-				tail = null;
+				list = NIL;
+				tail = NIL;
 				numMerges = 0;
 
-				while (p != null)
+				while (p != NIL)
 				{
 					numMerges++;
 					q = p;
@@ -342,38 +496,37 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 					for (i = 0; i < inSize; i++)
 					{
 						pSize++;
-						q = q.nextZ;
-						if (q == null) break;
+						q = _nextZ[q];
+						if (q == NIL) break;
 					}
 					qSize = inSize;
 
-					while (pSize > 0 || (qSize > 0 && q != null))
+					while (pSize > 0 || (qSize > 0 && q != NIL))
 					{
-
-						if (pSize != 0 && (qSize == 0 || q == null || p.mZOrder <= q.mZOrder))
+						if (pSize != 0 && (qSize == 0 || q == NIL || _z[p] <= _z[q]))
 						{
 							e = p;
-							p = p.nextZ;
+							p = _nextZ[p];
 							pSize--;
 						}
 						else
 						{
 							e = q;
-							q = q.nextZ;
+							q = _nextZ[q];
 							qSize--;
 						}
 
-						if (tail != null) tail.nextZ = e;
+						if (tail != NIL) _nextZ[tail] = e;
 						else list = e;
 
-						e.prevZ = tail;
+						_prevZ[e] = tail;
 						tail = e;
 					}
 
 					p = q;
 				}
 
-				tail.nextZ = null;
+				_nextZ[tail] = NIL;
 				inSize *= 2;
 
 			} while (numMerges > 1);
@@ -381,232 +534,229 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 			return list;
 		}
 
-		private static Node EliminateHoles(List<float> data, List<int> holeIndices, Node outerNode, int dim)
+		private int eliminateHoles(List<float> data, int end, List<int> holeIndices, int firstHole, int holeCount, int outerNode)
 		{
-			var i = 0;
-			var len = holeIndices.Count;
-			var start = 0;
-			var end = 0;
-			Node list = null;
-			var queue = new List<Node>(len);
-			for (i = 0; i < len; i++)
+			_holeQueue.Clear();
+			for (var i = 0; i < holeCount; i++)
 			{
-				start = holeIndices[i] * dim;
-				end = i < len - 1 ? holeIndices[i + 1] * dim : data.Count;
-				list = linkedList(data, start, end, dim, false);
-				if (list == list.next) list.steiner = true;
-				queue.Add(getLeftmost(list));
+				var start = holeIndices[firstHole + i] * _dim;
+				var holeEnd = i < holeCount - 1 ? holeIndices[firstHole + i + 1] * _dim : end;
+				var list = linkedList(data, start, holeEnd, false);
+				if (list == NIL) continue;
+				if (list == _next[list]) _steiner[list] = true;
+				_holeQueue.Add(getLeftmost(list));
 			}
 
-			queue.Sort(delegate (Node a, Node b)
-			{
-				return (int)Math.Ceiling(a.x - b.x);
-			});
+			_holeQueue.Sort(_compareX);
 
 			// process holes from left to right
-			for (i = 0; i < queue.Count; i++)
+			for (var i = 0; i < _holeQueue.Count; i++)
 			{
-				EliminateHole(queue[i], outerNode);
-				outerNode = FilterPoints(outerNode, outerNode.next);
+				eliminateHole(_holeQueue[i], outerNode);
+				outerNode = filterPoints(outerNode, _next[outerNode]);
 			}
 
 			return outerNode;
 		}
 
-		private static void EliminateHole(Node hole, Node outerNode)
+		private int compareX(int a, int b)
+		{
+			return (int)Math.Ceiling(_x[a] - _x[b]);
+		}
+
+		private void eliminateHole(int hole, int outerNode)
 		{
-			outerNode = FindHoleBridge(hole, outerNode);
-			if (outerNode != null)
+			outerNode = findHoleBridge(hole, outerNode);
+			if (outerNode != NIL)
 			{
-				var b = SplitPolygon(outerNode, hole);
-				FilterPoints(b, b.next);
+				var b = splitPolygon(outerNode, hole);
+				filterPoints(b, _next[b]);
 			}
 		}
 
-		private static Node FilterPoints(Node start, Node end)
+		private int filterPoints(int start, int end)
 		{
-			if (start == null) return start;
-			if (end == null) end = start;
+			if (start == NIL) return start;
+			if (end == NIL) end = start;
 
 			var p = start;
-			bool again = true;
+			bool again;
 			do
 			{
 				again = false;
 
-				if (!p.steiner && (equals(p, p.next) || area(p.prev, p, p.next) == 0))
+				if (!_steiner[p] && (equals(p, _next[p]) || area(_prev[p], p, _next[p]) == 0))
 				{
 					removeNode(p);
-					p = end = p.prev;
-					if (p == p.next) return null;
+					p = end = _prev[p];
+					if (p == _next[p]) return NIL;
 					again = true;
-
 				}
 				else
 				{
-					p = p.next;
+					p = _next[p];
 				}
 			} while (again || p != end);
 
 			return end;
 		}
 
-		private static Node SplitPolygon(Node a, Node b)
+		private int splitPolygon(int a, int b)
 		{
-			var a2 = new Node(a.i, a.x, a.y);
-			var b2 = new Node(b.i, b.x, b.y);
-			var an = a.next;
-			var bp = b.prev;
+			var a2 = createNode(_i[a], _x[a], _y[a]);
+			var b2 = createNode(_i[b], _x[b], _y[b]);
+			var an = _next[a];
+			var bp = _prev[b];
 
-			a.next = b;
-			b.prev = a;
+			_next[a] = b;
+			_prev[b] = a;
 
-			a2.next = an;
-			an.prev = a2;
+			_next[a2] = an;
+			_prev[an] = a2;
 
-			b2.next = a2;
-			a2.prev = b2;
+			_next[b2] = a2;
+			_prev[a2] = b2;
 
-			bp.next = b2;
-			b2.prev = bp;
+			_next[bp] = b2;
+			_prev[b2] = bp;
 
 			return b2;
 		}
 
-		private static Node FindHoleBridge(Node hole, Node outerNode)
+		private int findHoleBridge(int hole, int outerNode)
 		{
 			var p = outerNode;
-			var hx = hole.x;
-			var hy = hole.y;
+			var hx = _x[hole];
+			var hy = _y[hole];
 			var qx = float.MinValue;
-			Node m = null;
+			var m = NIL;
 
 			// find a segment intersected by a ray from the hole's leftmost point to the left;
 			// segment's endpoint with lesser x will be potential connection point
 			do
 			{
-				if (hy <= p.y && hy >= p.next.y && p.next.y != p.y)
+				var n = _next[p];
+				if (hy <= _y[p] && hy >= _y[n] && _y[n] != _y[p])
 				{
-					var x = p.x + (hy - p.y) * (p.next.x - p.x) / (p.next.y - p.y);
+					var x = _x[p] + (hy - _y[p]) * (_x[n] - _x[p]) / (_y[n] - _y[p]);
 					if (x <= hx && x > qx)
 					{
 						qx = x;
 						if (x == hx)
 						{
-							if (hy == p.y) return p;
-							if (hy == p.next.y) return p.next;
+							if (hy == _y[p]) return p;
+							if (hy == _y[n]) return n;
 						}
-						m = p.x < p.next.x ? p : p.next;
+						m = _x[p] < _x[n] ? p : n;
 					}
 				}
-				p = p.next;
+				p = n;
 			} while (p != outerNode);
 
-			if (m == null) return null;
+			if (m == NIL) return NIL;
 
-			if (hx == qx) return m.prev; // hole touches outer segment; pick lower endpoint
+			if (hx == qx) return _prev[m]; // hole touches outer segment; pick lower endpoint
 
 			// look for points inside the triangle of hole point, segment intersection and endpoint;
 			// if there are no points found, we have a valid connection;
 			// otherwise choose the point of the minimum angle with the ray as connection point
 
 			var stop = m;
-			var mx = m.x;
-			var my = m.y;
+			var mx = _x[m];
+			var my = _y[m];
 			var tanMin = float.MaxValue;
-			float tan = 0f;
+			float tan;
 
-			p = m.next;
+			p = _next[m];
 
 			while (p != stop)
 			{
-				if (hx >= p.x && p.x >= mx && hx != p.x &&
-						pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p.x, p.y))
+				if (hx >= _x[p] && _x[p] >= mx && hx != _x[p] &&
+						pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, _x[p], _y[p]))
 				{
+					tan = Math.Abs(hy - _y[p]) / (hx - _x[p]); // tangential
 
-					tan = Math.Abs(hy - p.y) / (hx - p.x); // tangential
-
-					if ((tan < tanMin || (tan == tanMin && p.x > m.x)) && locallyInside(p, hole))
+					if ((tan < tanMin || (tan == tanMin && _x[p] > _x[m])) && locallyInside(p, hole))
 					{
 						m = p;
 						tanMin = tan;
 					}
 				}
 
-				p = p.next;
+				p = _next[p];
 			}
 
 			return m;
 		}
 
-		private static bool locallyInside(Node a, Node b)
+		private bool locallyInside(int a, int b)
 		{
-			return area(a.prev, a, a.next) < 0 ?
-		area(a, b, a.next) >= 0 && area(a, a.prev, b) >= 0 :
-		area(a, b, a.prev) < 0 || area(a, a.next, b) < 0;
+			return area(_prev[a], a, _next[a]) < 0 ?
+				area(a, b, _next[a]) >= 0 && area(a, _prev[a], b) >= 0 :
+				area(a, b, _prev[a]) < 0 || area(a, _next[a], b) < 0;
 		}
 
-		private static float area(Node p, Node q, Node r)
+		private float area(int p, int q, int r)
 		{
-			return (q.y - p.y) * (r.x - q.x) - (q.x - p.x) * (r.y - q.y);
+			return (_y[q] - _y[p]) * (_x[r] - _x[q]) - (_x[q] - _x[p]) * (_y[r] - _y[q]);
 		}
 
 		private static bool pointInTriangle(float ax, float ay, float bx, float by, float cx, float cy, float px, float py)
 		{
 			return (cx - px) * (ay - py) - (ax - px) * (cy - py) >= 0 &&
-		   (ax - px) * (by - py) - (bx - px) * (ay - py) >= 0 &&
-		   (bx - px) * (cy - py) - (cx - px) * (by - py) >= 0;
+				(ax - px) * (by - py) - (bx - px) * (ay - py) >= 0 &&
+				(bx - px) * (cy - py) - (cx - px) * (by - py) >= 0;
 		}
 
-		private static Node getLeftmost(Node start)
+		private int getLeftmost(int start)
 		{
 			var p = start;
 			var leftmost = start;
 			do
 			{
-				if (p.x < leftmost.x) leftmost = p;
-				p = p.next;
+				if (_x[p] < _x[leftmost]) leftmost = p;
+				p = _next[p];
 			} while (p != start);
 
 			return leftmost;
 		}
 
 		// create a circular doubly linked list from polygon points in the specified winding order
-		private static Node linkedList(List<float> data, int start, int end, int dim, bool clockwise)
+		private int linkedList(List<float> data, int start, int end, bool clockwise)
 		{
-			var i = 0;
-			Node last = null;
+			var dim = _dim;
+			var last = NIL;
 
 			if (clockwise == (signedArea(data, start, end, dim) > 0))
 			{
-				for (i = start; i < end; i += dim) last = insertNode(i, data[i], data[i + 1], last);
+				for (var i = start; i < end; i += dim) last = insertNode(i, data[i], data[i + 1], last);
 			}
 			else
 			{
-				for (i = end - dim; i >= start; i -= dim) last = insertNode(i, data[i], data[i + 1], last);
+				for (var i = end - dim; i >= start; i -= dim) last = insertNode(i, data[i], data[i + 1], last);
 			}
 
-			if (last != null && equals(last, last.next))
+			if (last != NIL && equals(last, _next[last]))
 			{
 				removeNode(last);
-				last = last.next;
+				last = _next[last];
 			}
 
 			return last;
 		}
 
-		private static void removeNode(Node p)
+		private void removeNode(int p)
 		{
-			p.next.prev = p.prev;
-			p.prev.next = p.next;
+			_prev[_next[p]] = _prev[p];
+			_next[_prev[p]] = _next[p];
 
-			if (p.prevZ != null) p.prevZ.nextZ = p.nextZ;
-			if (p.nextZ != null) p.nextZ.prevZ = p.prevZ;
+			if (_prevZ[p] != NIL) _nextZ[_prevZ[p]] = _nextZ[p];
+			if (_nextZ[p] != NIL) _prevZ[_nextZ[p]] = _prevZ[p];
 		}
 
-		private static bool equals(Node p1, Node p2)
+		private bool equals(int p1, int p2)
 		{
-			return p1.x == p2.x && p1.y == p2.y;
+			return _x[p1] == _x[p2] && _y[p1] == _y[p2];
 		}
 
 		private static float signedArea(List<float> data, int start, int end, int dim)
@@ -621,54 +771,70 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 			return sum;
 		}
 
-		private static Node insertNode(int i, float x, float y, Node last)
+		private int insertNode(int i, float x, float y, int last)
 		{
-			var p = new Node(i, x, y);
+			var p = createNode(i, x, y);
 
-			if (last == null)
+			if (last == NIL)
 			{
-				p.prev = p;
-				p.next = p;
-
+				_prev[p] = p;
+				_next[p] = p;
 			}
 			else
 			{
-				p.next = last.next;
-				p.prev = last;
-				last.next.prev = p;
-				last.next = p;
+				_next[p] = _next[last];
+				_prev[p] = last;
+				_prev[_next[last]] = p;
+				_next[last] = p;
 			}
 			return p;
 		}
-				
-		public static Data Flatten(List<List<Vector3>> data)
+
+		private int createNode(int i, float x, float y)
 		{
-			var dataCount = data.Count;
-			var totalVertCount = 0;
-			for (int i = 0; i < dataCount; i++)
+			if (_count == _i.Length)
 			{
-				totalVertCount += data[i].Count;
+				grow();
 			}
 
-			var result = new Data() { Dim = 2 };
-			result.Vertices = new List<float>(totalVertCount * 2);
-			var holeIndex = 0;
+			var p = _count++;
+			_i[p] = i;
+			_x[p] = x;
+			_y[p] = y;
+			_z[p] = 0;
+			_prev[p] = NIL;
+			_next[p] = NIL;
+			_prevZ[p] = NIL;
+			_nextZ[p] = NIL;
+			_steiner[p] = false;
+			return p;
+		}
 
-			for (var i = 0; i < dataCount; i++)
-			{
-				var subCount = data[i].Count;
-				for (var j = 0; j < subCount; j++)
-				{
-					result.Vertices.Add(data[i][j][0]);
-					result.Vertices.Add(data[i][j][2]);
-				}
-				if (i > 0)
-				{
-					holeIndex += data[i - 1].Count;
-					result.Holes.Add(holeIndex);
-				}
-			}
-			return result;
+		private void allocate(int capacity)
+		{
+			_i = new int[capacity];
+			_x = new float[capacity];
+			_y = new float[capacity];
+			_z = new int[capacity];
+			_prev = new int[capacity];
+			_next = new int[capacity];
+			_prevZ = new int[capacity];
+			_nextZ = new int[capacity];
+			_steiner = new bool[capacity];
+		}
+
+		private void grow()
+		{
+			var capacity = _i.Length * 2;
+			Array.Resize(ref _i, capacity);
+			Array.Resize(ref _x, capacity);
+			Array.Resize(ref _y, capacity);
+			Array.Resize(ref _z, capacity);
+			Array.Resize(ref _prev, capacity);
+			Array.Resize(ref _next, capacity);
+			Array.Resize(ref _prevZ, capacity);
+			Array.Resize(ref _nextZ, capacity);
+			Array.Resize(ref _steiner, capacity);
 		}
 	}
 
@@ -684,83 +850,4 @@ namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
 			Dim = 2;
 		}
 	}
-
-	public class Node
-	{
-
-		/* Member Variables. */
-		public int i;
-		public float x;
-		public float y;
-		public int mZOrder;
-		public Node prev;
-		public Node next;
-		public Node prevZ;
-		public Node nextZ;
-		public bool steiner;
-
-		public Node(int ind, float pX, float pY)
-		{
-			/* Initialize Member Variables. */
-			this.i = ind;
-			this.x = pX;
-			this.y = pY;
-			this.mZOrder = 0;
-			this.prev = null;
-			this.next = null;
-			this.prevZ = null;
-			this.nextZ = null;
-		}
-
-		protected void setPreviousNode(Node pNode)
-		{
-			this.prev = pNode;
-		}
-
-		protected Node getPreviousNode()
-		{
-			return this.prev;
-		}
-
-		protected void setNextNode(Node pNode)
-		{
-			this.next = pNode;
-		}
-
-		protected Node getNextNode()
-		{
-			return this.next;
-		}
-
-		protected void setZOrder(int pZOrder)
-		{
-			this.mZOrder = pZOrder;
-		}
-
-		protected int getZOrder()
-		{
-			return this.mZOrder;
-		}
-
-		protected void setPreviousZNode(Node pNode)
-		{
-			this.prevZ = pNode;
-		}
-
-		protected Node getPreviousZNode()
-		{
-			return this.prevZ;
-		}
-
-		protected void setNextZNode(Node pNode)
-		{
-			this.nextZ = pNode;
-		}
-
-		protected Node getNextZNode()
-		{
-			return this.nextZ;
-		}
-
-	}
 }
@@ -0,0 +1,246 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using UnityEngine;
+
+namespace Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers
+{
+	/// <summary>
+	/// Triangulates many polygons, eg all building footprints of a layer, into one contiguous index buffer.
+	/// Polygons are added with <see cref="AddPolygon"/>, their x/z coordinates are packed into <see cref="Vertices"/>
+	/// and <see cref="Triangulate(int)"/> writes indices into that vertex buffer to <see cref="Triangles"/>, polygon by polygon
+	/// in the order they were added. Work can be split across worker threads, the output is the same either way.
+	/// All buffers are kept across <see cref="Clear"/> so a reused batch doesn't allocate once it has grown.
+	/// </summary>
+	public class EarcutBatch
+	{
+		private const int MAX_WORKERS = 4;
+		//smaller batches aren't worth the thread hand off
+		private const int MIN_POLYGONS_PER_WORKER = 64;
+
+		/// <summary> x/z pairs of every polygon, outer ring followed by its holes. </summary>
+		public readonly List<float> Vertices = new List<float>();
+		/// <summary> Triangle indices into <see cref="Vertices"/> (pair index) of all polygons, valid after <see cref="Triangulate(int)"/>. </summary>
+		public readonly List<int> Triangles = new List<int>();
+
+		//vertex index each ring starts at
+		private readonly List<int> _rings = new List<int>();
+		//ring index each polygon starts at
+		private readonly List<int> _polygons = new List<int>();
+		//offset of each polygon in Triangles, plus the total count
+		private readonly List<int> _triangleStarts = new List<int>();
+
+		private readonly List<Chunk> _chunks = new List<Chunk>();
+		private readonly ManualResetEvent _workersDone = new ManualResetEvent(false);
+		private readonly WaitCallback _runChunk;
+		private int _pendingWorkers;
+
+		private class Chunk
+		{
+			public EarcutBatch Batch;
+			public int FirstPolygon;
+			public int EndPolygon;
+			public readonly EarcutTriangulator Triangulator = new EarcutTriangulator();
+			public readonly List<int> Triangles = new List<int>();
+			public readonly List<int> Starts = new List<int>();
+			public Exception Error;
+		}
+
+		public EarcutBatch()
+		{
+			_runChunk = runChunk;
+		}
+
+		/// <summary> Number of worker threads used by default, one less than the cores. </summary>
+		public static int DefaultWorkerCount
+		{
+			get { return Math.Max(1, Math.Min(MAX_WORKERS, Environment.ProcessorCount - 1)); }
+		}
+
+		public int PolygonCount
+		{
+			get { return _polygons.Count; }
+		}
+
+		public int VertexCount
+		{
+			get { return Vertices.Count / 2; }
+		}
+
+		/// <summary>
+		/// Add a polygon, first ring is the outer ring and the others are its holes, same layout as <see cref="EarcutLibrary.Flatten(List{List{Vector3}})"/>.
+		/// </summary>
+		/// <returns>Index of the polygon, -1 if it has no outer ring and was skipped.</returns>
+		public int AddPolygon(List<List<Vector3>> rings)
+		{
+			var ringCount = rings.Count;
+			if (ringCount == 0 || rings[0].Count == 0)
+			{
+				return -1;
+			}
+			_polygons.Add(_rings.Count);
+			var vertexCount = 0;
+			for (int i = 0; i < ringCount; i++)
+			{
+				vertexCount += rings[i].Count;
+			}
+			if (Vertices.Count + vertexCount * 2 > Vertices.Capacity)
+			{
+				Vertices.Capacity = Math.Max(Vertices.Count + vertexCount * 2, Vertices.Capacity * 2);
+			}
+
+			for (int i = 0; i < ringCount; i++)
+			{
+				var ring = rings[i];
+				//an empty hole would start where the next ring does
+				if (ring.Count == 0)
+				{
+					continue;
+				}
+				_rings.Add(VertexCount);
+				for (int j = 0; j < ring.Count; j++)
+				{
+					Vertices.Add(ring[j].x);
+					Vertices.Add(ring[j].z);
+				}
+			}
+			return _polygons.Count - 1;
+		}
+
+		/// <summary> First vertex (pair index into <see cref="Vertices"/>) of a polygon. </summary>
+		public int FirstVertex(int polygon)
+		{
+			return _rings[_polygons[polygon]];
+		}
+
+		/// <summary> Range of a polygon's indices in <see cref="Triangles"/>. </summary>
+		public void GetTriangles(int polygon, out int start, out int count)
+		{
+			start = _triangleStarts[polygon];
+			count = _triangleStarts[polygon + 1] - start;
+		}
+
+		public void Clear()
+		{
+			Vertices.Clear();
+			Triangles.Clear();
+			_rings.Clear();
+			_polygons.Clear();
+			_triangleStarts.Clear();
+		}
+
+		/// <summary> Triangulate all polygons on the calling thread. </summary>
+		public void Triangulate()
+		{
+			Triangulate(1);
+		}
+
+		/// <summary>
+		/// Triangulate all polygons, split into <paramref name="workers"/> chunks of consecutive polygons.
+		/// The calling thread works on the first chunk and blocks until the others are done.
+		/// </summary>
+		public void Triangulate(int workers)
+		{
+#if UNITY_WEBGL
+			workers = 1;
+#endif
+			var polygonCount = _polygons.Count;
+			workers = Math.Max(1, Math.Min(workers, polygonCount / MIN_POLYGONS_PER_WORKER));
+			while (_chunks.Count < workers)
+			{
+				_chunks.Add(new Chunk { Batch = this });
+			}
+
+			//balance chunks by vertex count, polygon sizes vary a lot within a layer
+			var vertexCount = VertexCount;
+			var polygon = 0;
+			for (int c = 0; c < workers; c++)
+			{
+				var chunk = _chunks[c];
+				var endVertex = (int)((long)vertexCount * (c + 1) / workers);
+				chunk.FirstPolygon = polygon;
+				while (polygon < polygonCount && (c == workers - 1 || FirstVertex(polygon) < endVertex))
+				{
+					polygon++;
+				}
+				chunk.EndPolygon = polygon;
+			}
+
+			if (workers > 1)
+			{
+				_pendingWorkers = workers - 1;
+				_workersDone.Reset();
+				for (int c = 1; c < workers; c++)
+				{
+					ThreadPool.QueueUserWorkItem(_runChunk, _chunks[c]);
+				}
+			}
+			triangulate(_chunks[0]);
+			if (workers > 1)
+			{
+				_workersDone.WaitOne();
+			}
+
+			Triangles.Clear();
+			_triangleStarts.Clear();
+			var total = 0;
+			for (int c = 0; c < workers; c++)
+			{
+				total += _chunks[c].Triangles.Count;
+			}
+			if (total > Triangles.Capacity)
+			{
+				Triangles.Capacity = total;
+			}
+			for (int c = 0; c < workers; c++)
+			{
+				var chunk = _chunks[c];
+				if (chunk.Error != null)
+				{
+					throw new InvalidOperationException("Triangulating polygons " + chunk.FirstPolygon + " to " + chunk.EndPolygon + " failed", chunk.Error);
+				}
+				var offset = Triangles.Count;
+				for (int i = 0; i < chunk.Starts.Count; i++)
+				{
+					_triangleStarts.Add(chunk.Starts[i] + offset);
+				}
+				Triangles.AddRange(chunk.Triangles);
+			}
+			_triangleStarts.Add(Triangles.Count);
+		}
+
+		private static void runChunk(object state)
+		{
+			var chunk = (Chunk)state;
+			chunk.Batch.triangulate(chunk);
+			if (Interlocked.Decrement(ref chunk.Batch._pendingWorkers) == 0)
+			{
+				chunk.Batch._workersDone.Set();
+			}
+		}
+
+		private void triangulate(Chunk chunk)
+		{
+			chunk.Triangles.Clear();
+			chunk.Starts.Clear();
+			chunk.Error = null;
+			try
+			{
+				var ringCount = _rings.Count;
+				for (int p = chunk.FirstPolygon; p < chunk.EndPolygon; p++)
+				{
+					var firstRing = _polygons[p];
+					var endRing = p + 1 < _polygons.Count ? _polygons[p + 1] : ringCount;
+					var end = endRing < ringCount ? _rings[endRing] * 2 : Vertices.Count;
+					chunk.Starts.Add(chunk.Triangles.Count);
+					chunk.Triangulator.Triangulate(Vertices, _rings[firstRing] * 2, end, _rings, firstRing + 1, endRing - firstRing - 1, 2, chunk.Triangles, 0);
+				}
+			}
+			catch (Exception ex)
+			{
+				//rethrown on the calling thread
+				chunk.Error = ex;
+			}
+		}
+	}
+}
@@ -50,6 +50,9 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 		public override ModifierType Type { get { return ModifierType.Preprocess; } }
 
 		private int _counter = 0;
+		//reused between features, only their content goes into the mesh data
+		private List<int> _wallTriangles = new List<int>();
+		private List<Vector2> _wallUv = new List<Vector2>();
 		float height = 0.0f;
 
 		public override void SetProperties(ModifierProperties properties)
@@ -99,7 +102,7 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 
 		protected virtual void GenerateWallMesh(MeshData md)
 		{
-			md.Vertices.Capacity = _counter + md.Edges.Count * 2;
+			MeshData.Reserve(md.Vertices, md.Edges.Count * 2);
 			float d = 0f;
 			Vector3 v1;
 			Vector3 v2;
@@ -109,12 +112,15 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 			if (_options.extrusionGeometryType != ExtrusionGeometryType.RoofOnly)
 			{
 				_counter = md.Edges.Count;
-				var wallTri = new List<int>(_counter * 3);
-				var wallUv = new List<Vector2>(_counter * 2);
+				var wallTri = _wallTriangles;
+				var wallUv = _wallUv;
+				wallTri.Clear();
+				wallUv.Clear();
 				Vector3 norm = Constants.Math.Vector3Zero;
 
-				md.Vertices.Capacity = md.Vertices.Count + _counter * 2;
-				md.Normals.Capacity = md.Normals.Count + _counter * 2;
+				MeshData.Reserve(md.Vertices, _counter * 2);
+				MeshData.Reserve(md.Normals, _counter * 2);
+				MeshData.Reserve(md.Tangents, _counter * 2);
 
 				for (int i = 0; i < _counter; i += 2)
 				{
@@ -156,11 +162,11 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				// TODO: Do we really need this?
 				if (_separateSubmesh)
 				{
-					md.Triangles.Add(wallTri);
+					md.AddSubmesh(wallTri.Count).AddRange(wallTri);
 				}
 				else
 				{
-					md.Triangles.Capacity = md.Triangles.Count + wallTri.Count;
+					MeshData.Reserve(md.Triangles[0], wallTri.Count);
 					md.Triangles[0].AddRange(wallTri);
 				}
 				md.UV[0].AddRange(wallUv);
@@ -367,7 +367,7 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				md.Normals.AddRange(_normalList);
 				if (md.Triangles.Count == 0)
 				{
-					md.Triangles.Add(new List<int>());
+					md.AddSubmesh(_triangleList.Count);
 				}
 
 				md.Triangles[0].AddRange(_triangleList);
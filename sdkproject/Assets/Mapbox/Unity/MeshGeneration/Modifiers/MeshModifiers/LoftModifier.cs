@@ -1,7 +1,6 @@
 namespace Mapbox.Unity.MeshGeneration.Modifiers
 {
 	using System.Collections.Generic;
-	using System.Linq;
 	using UnityEngine;
 	using Mapbox.Unity.MeshGeneration.Data;
 	using Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers;
@@ -19,6 +18,8 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 		private int _sliceCount;
 		private float _sliceTotalMagnitude;
 		private Vector2[] _sliceUvs;
+		private List<List<Vector3>> _capRings = new List<List<Vector3>>(1);
+		private Data _capData = new Data();
 
 		public override void Initialize()
 		{
@@ -94,11 +95,11 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 
 				if (md.Triangles.Count == 0)
 				{
-					md.Triangles.Add(new List<int>());
+					md.AddSubmesh();
 				}
-				md.Vertices.Capacity = md.Vertices.Count + (vl.Count - _sliceCount) * 4;
-				md.Normals.Capacity = md.Normals.Count + (vl.Count - _sliceCount) * 4;
-				md.Triangles.Capacity = md.Triangles.Count + (vl.Count - _sliceCount) * 6;
+				MeshData.Reserve(md.Vertices, (vl.Count - _sliceCount) * 4);
+				MeshData.Reserve(md.Normals, (vl.Count - _sliceCount) * 4);
+				MeshData.Reserve(md.Triangles[0], (vl.Count - _sliceCount) * 6);
 
 				var uvDist = 0f;
 				float edMag = 0f, h = 0f;
@@ -154,10 +155,11 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 						md.Triangles.Add(new List<int>());
 					}
 
-					var flatData = EarcutLibrary.Flatten(new List<List<Vector3>>() { edges });
-					var result = EarcutLibrary.Earcut(flatData.Vertices, flatData.Holes, flatData.Dim);
-
-					md.Triangles[1].AddRange(result.Select(x => md.Vertices.Count + x).ToList());
+					_capRings.Clear();
+					_capRings.Add(edges);
+					EarcutLibrary.Flatten(_capRings, _capData);
+					EarcutLibrary.Earcut(_capData.Vertices, _capData.Holes, _capData.Dim, md.Triangles[1], md.Vertices.Count);
+					_capRings.Clear();
 					for (int i = 0; i < edges.Count; i++)
 					{
 						md.Vertices.Add(edges[i]);
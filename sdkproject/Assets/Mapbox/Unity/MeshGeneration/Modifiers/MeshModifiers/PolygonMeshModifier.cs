@@ -1,4 +1,5 @@
 using Mapbox.Unity.Map;
+using Mapbox.Utils;
 
 namespace Mapbox.Unity.MeshGeneration.Modifiers
 {
@@ -23,6 +24,11 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 		private UVModifierOptions _options;
 		private Vector3 _v1, _v2;
 
+		//triangulation buffers, reused across features
+		private List<List<Vector3>> _subset = new List<List<Vector3>>();
+		private Data _flatData = new Data();
+		private List<int> _result = new List<int>();
+
 		#region Atlas Fields
 
 		private Vector3 _vert;
@@ -64,9 +70,10 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 			}
 
 			var _counter = feature.Points.Count;
-			var subset = new List<List<Vector3>>(_counter);
-			Data flatData = null;
-			List<int> result = null;
+			var subset = _subset;
+			var flatData = _flatData;
+			var result = _result;
+			subset.Clear();
 			var currentIndex = 0;
 			int vertCount = 0, polygonVertexCount = 0;
 			List<int> triList = null;
@@ -83,16 +90,19 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				vertCount = md.Vertices.Count;
 				if (IsClockwise(sub) && vertCount > 0)
 				{
-					flatData = EarcutLibrary.Flatten(subset);
-					result = EarcutLibrary.Earcut(flatData.Vertices, flatData.Holes, flatData.Dim);
+					TileTraceTimer trace = TileTrace.BeginPending(TileTraceStage.Triangulate);
+					EarcutLibrary.Flatten(subset, flatData);
+					result.Clear();
+					EarcutLibrary.Earcut(flatData.Vertices, flatData.Holes, flatData.Dim, result);
+					trace.End();
 					polygonVertexCount = result.Count;
 					if (triList == null)
 					{
-						triList = new List<int>(polygonVertexCount);
+						triList = md.AddSubmesh(polygonVertexCount);
 					}
 					else
 					{
-						triList.Capacity = triList.Count + polygonVertexCount;
+						MeshData.Reserve(triList, polygonVertexCount);
 					}
 
 					for (int j = 0; j < polygonVertexCount; j++)
@@ -107,9 +117,10 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				subset.Add(sub);
 
 				polygonVertexCount = sub.Count;
-				md.Vertices.Capacity = md.Vertices.Count + polygonVertexCount;
-				md.Normals.Capacity = md.Normals.Count + polygonVertexCount;
-				md.Edges.Capacity = md.Edges.Count + polygonVertexCount * 2;
+				MeshData.Reserve(md.Vertices, polygonVertexCount);
+				MeshData.Reserve(md.Normals, polygonVertexCount);
+				MeshData.Reserve(md.Tangents, polygonVertexCount);
+				MeshData.Reserve(md.Edges, polygonVertexCount * 2);
 				var _size = md.TileRect.Size;
 
 				for (int j = 0; j < polygonVertexCount; j++)
@@ -134,8 +145,12 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				}
 			}
 
-			flatData = EarcutLibrary.Flatten(subset);
-			result = EarcutLibrary.Earcut(flatData.Vertices, flatData.Holes, flatData.Dim);
+			TileTraceTimer lastTrace = TileTrace.BeginPending(TileTraceStage.Triangulate);
+			EarcutLibrary.Flatten(subset, flatData);
+			result.Clear();
+			EarcutLibrary.Earcut(flatData.Vertices, flatData.Holes, flatData.Dim, result);
+			lastTrace.End();
+			subset.Clear();
 			polygonVertexCount = result.Count;
 
 			if (_options.texturingType == UvMapType.Atlas || _options.texturingType == UvMapType.AtlasWithColorPalette)
@@ -180,19 +195,17 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 
 			if (triList == null)
 			{
-				triList = new List<int>(polygonVertexCount);
+				triList = md.AddSubmesh(polygonVertexCount);
 			}
 			else
 			{
-				triList.Capacity = triList.Count + polygonVertexCount;
+				MeshData.Reserve(triList, polygonVertexCount);
 			}
 
 			for (int i = 0; i < polygonVertexCount; i++)
 			{
 				triList.Add(result[i] + currentIndex);
 			}
-
-			md.Triangles.Add(triList);
 		}
 
 
@@ -17,6 +17,15 @@
 			scaledX = tile.Rect.Size.x * tile.TileScale;
 			scaledY = tile.Rect.Size.y * tile.TileScale;
 			_counter = md.Vertices.Count;
+
+			//coarse check first, every vertex of a flat tile gets the same height
+			var pyramid = tile.HeightPyramid;
+			if (tile.HeightData != null && pyramid != null && pyramid.IsFlat)
+			{
+				SnapToHeight(feature, md, pyramid.MinHeight * tile.TileScale);
+				return;
+			}
+
 			if (_counter > 0)
 			{
 				for (int i = 0; i < _counter; i++)
@@ -42,5 +51,27 @@
 				}
 			}
 		}
+
+		private void SnapToHeight(VectorFeatureUnity feature, MeshData md, float h)
+		{
+			var offset = new Vector3(0, h, 0);
+			if (_counter > 0)
+			{
+				for (int i = 0; i < _counter; i++)
+				{
+					md.Vertices[i] += offset;
+				}
+			}
+			else
+			{
+				foreach (var sub in feature.Points)
+				{
+					for (int i = 0; i < sub.Count; i++)
+					{
+						sub[i] += offset;
+					}
+				}
+			}
+		}
 	}
 }
@@ -76,6 +76,12 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 
 		public override void OnUnregisterTile(UnityTile tile)
 		{
+			_counter = GoModifiers.Count;
+			for (int i = 0; i < _counter; i++)
+			{
+				GoModifiers[i].OnUnregisterTile(tile);
+			}
+
 			if (_activeObjects.ContainsKey(tile))
 			{
 				_counter = _activeObjects[tile].Count;
@@ -116,6 +122,11 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 			}
 		}
 
+		public override bool RetainsMeshData
+		{
+			get { return false; }
+		}
+
 		public override GameObject Execute(UnityTile tile, VectorFeatureUnity feature, MeshData meshData, GameObject parent = null, string type = "")
 		{
 			_counter = feature.Points.Count;
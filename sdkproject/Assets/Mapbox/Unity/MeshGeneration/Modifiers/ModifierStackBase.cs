@@ -13,6 +13,16 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 		[NodeEditorElement("Mesh Modifiers")] public List<MeshModifier> MeshModifiers = new List<MeshModifier>();
 		[NodeEditorElement("Game Object Modifiers")] public List<GameObjectModifier> GoModifiers = new List<GameObjectModifier>();
 
+		/// <summary>
+		/// True if the stack keeps the <see cref="MeshData"/> passed to <see cref="Execute"/> after it returned.
+		/// Callers must not reuse such mesh data, the stack releases it itself or it's released with the tile.
+		/// Stacks that are done with the mesh data once <see cref="Execute"/> returned override this to hand it back early.
+		/// </summary>
+		public virtual bool RetainsMeshData
+		{
+			get { return true; }
+		}
+
 		public virtual GameObject Execute(UnityTile tile, VectorFeatureUnity feature, MeshData meshData, GameObject parent = null, string type = "")
 		{
 			return null;
@@ -144,7 +144,12 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				finalFirstHeight = Mathf.Min(height, _scaledFirstFloorHeight);
 				finalTopHeight = (height - finalFirstHeight) < _scaledTopFloorHeight ? 0 : _scaledTopFloorHeight;
 				finalMidHeight = Mathf.Max(0, height - (finalFirstHeight + finalTopHeight));
-				wallTriangles = new List<int>();
+				//reused between features, its content is copied into the mesh data
+				if (wallTriangles == null)
+				{
+					wallTriangles = new List<int>();
+				}
+				wallTriangles.Clear();
 
 				//cuts long edges into smaller ones using PreferredEdgeSectionLength
 				currentWallLength = 0;
@@ -216,11 +221,11 @@ namespace Mapbox.Unity.MeshGeneration.Modifiers
 				//this first loop is for columns
 				if (_separateSubmesh)
 				{
-					md.Triangles.Add(wallTriangles);
+					md.AddSubmesh(wallTriangles.Count).AddRange(wallTriangles);
 				}
 				else
 				{
-					md.Triangles.Capacity = md.Triangles.Count + wallTriangles.Count;
+					MeshData.Reserve(md.Triangles[0], wallTriangles.Count);
 					md.Triangles[0].AddRange(wallTriangles);
 				}
 			}
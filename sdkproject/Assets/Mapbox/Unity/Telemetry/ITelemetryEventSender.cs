@@ -0,0 +1,29 @@
+namespace Mapbox.Unity.Telemetry
+{
+	/// <summary> Outcome of <see cref="ITelemetryEventSender.Send"/>. </summary>
+	public enum TelemetrySendResult
+	{
+		/// <summary> The events endpoint accepted the batch. </summary>
+		Accepted,
+		/// <summary> Not delivered, eg no network or a server error. Worth retrying. </summary>
+		Failed,
+		/// <summary> The endpoint refused the batch (4xx), sending it again won't help. </summary>
+		Rejected
+	}
+
+	/// <summary>
+	/// Transport used by <see cref="TelemetryEventsManager"/> to post a batch of events.
+	/// Called from the manager's background thread, never from the main thread.
+	/// </summary>
+	public interface ITelemetryEventSender
+	{
+		/// <summary> Synchronously post a serialized batch. </summary>
+		/// <param name="url">Events endpoint including the access token.</param>
+		/// <param name="userAgent">Value for the 'User-Agent' header.</param>
+		/// <param name="body">Request body.</param>
+		/// <param name="bodyLength">Number of valid bytes in <paramref name="body"/>.</param>
+		/// <param name="contentEncoding">Value for the 'Content-Encoding' header, null for an uncompressed body.</param>
+		/// <returns>Whether the events endpoint accepted the batch and, if not, whether it's worth retrying.</returns>
+		TelemetrySendResult Send(string url, string userAgent, byte[] body, int bodyLength, string contentEncoding);
+	}
+}
@@ -0,0 +1,80 @@
+namespace Mapbox.Unity.Telemetry
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Utils;
+
+	/// <summary>
+	/// Managed counterpart of MapboxMobileEvents' <c>MMEEvent</c>: a telemetry event with a name,
+	/// a creation date and a dictionary of JSON compatible attributes.
+	/// </summary>
+	public class TelemetryEvent
+	{
+		// attribute keys, same values as the 'MMEEventKey*' constants of MapboxMobileEvents
+		public const string KeyEvent = "event";
+		public const string KeyCreated = "created";
+		public const string KeyUserId = "userId";
+		public const string KeyEnabledTelemetry = "enabled.telemetry";
+		public const string KeySdkIdentifier = "sdkIdentifier";
+		public const string KeySdkVersion = "sdkVersion";
+		public const string KeySkuId = "skuId";
+		public const string KeyUserAgent = "userAgent";
+		public const string KeyLatitude = "lat";
+		public const string KeyLongitude = "lng";
+		public const string KeyAltitude = "altitude";
+		public const string KeyZoomLevel = "zoom";
+		public const string KeySource = "source";
+		public const string KeySessionId = "sessionId";
+		public const string KeyOperatingSystem = "operatingSystem";
+		public const string KeyModel = "model";
+		public const string KeyDevice = "device";
+		public const string KeyResolution = "resolution";
+		public const string KeyApplicationState = "applicationState";
+
+		public const string TypeAppUserTurnstile = "appUserTurnstile";
+
+		private readonly string _name;
+		private readonly long _created;
+		private readonly Dictionary<string, object> _attributes;
+
+		public TelemetryEvent(string name, Dictionary<string, object> attributes)
+			: this(name, (long)UnixTimestampUtils.To(DateTime.UtcNow), attributes)
+		{
+		}
+
+		public TelemetryEvent(string name, long created, Dictionary<string, object> attributes)
+		{
+			if (string.IsNullOrEmpty(name))
+			{
+				throw new ArgumentNullException("name");
+			}
+
+			_name = name;
+			_created = created;
+			_attributes = null != attributes ? attributes : new Dictionary<string, object>();
+		}
+
+		/// <summary> Name of the event, sent as <c>MMEEventKeyEvent</c>. </summary>
+		public string Name { get { return _name; } }
+
+		/// <summary> Unix timestamp (seconds) of the event, sent as <c>MMEEventKeyCreated</c> unless overridden by the attributes. </summary>
+		public long Created { get { return _created; } }
+
+		/// <summary> Event attributes. Values have to be JSON primitives, lists or dictionaries. </summary>
+		public Dictionary<string, object> Attributes { get { return _attributes; } }
+
+		/// <summary>
+		/// Attributes as they go on the wire: a copy of <see cref="Attributes"/> with 'event' and 'created' filled in.
+		/// </summary>
+		public Dictionary<string, object> ToPayload()
+		{
+			Dictionary<string, object> payload = new Dictionary<string, object>(_attributes);
+			payload[KeyEvent] = _name;
+			if (!payload.ContainsKey(KeyCreated))
+			{
+				payload[KeyCreated] = _created;
+			}
+			return payload;
+		}
+	}
+}
@@ -0,0 +1,513 @@
+namespace Mapbox.Unity.Telemetry
+{
+	using System;
+	using System.Collections;
+	using System.Collections.Generic;
+	using System.Globalization;
+	using System.IO;
+	using Mapbox.IO.Compression;
+
+	/// <summary>
+	/// Serializes batches of <see cref="TelemetryEvent"/>s straight to UTF-8 JSON, optionally gzipped,
+	/// without going through Json.NET.
+	/// <para>JSON is written into a reusable byte arena. Well known event keys are pre-encoded once,
+	/// numbers and strings are encoded by hand, so encoding a batch does not allocate per event or per field.
+	/// With compression enabled the arena is pushed through a gzip stream whenever it fills up, the
+	/// uncompressed body is never materialized as a whole.</para>
+	/// <para>Exceptions to the no-allocation rule: floating point values that need more than 16 significant digits
+	/// to round-trip, <see cref="DateTime"/>s and values of unknown types are formatted via <c>ToString()</c>.
+	/// Every compressed batch creates one gzip stream.</para>
+	/// <para>Not thread safe: use one encoder per thread.</para>
+	/// </summary>
+	public class TelemetryEventEncoder
+	{
+		public const string ContentEncodingGzip = "gzip";
+
+		private const int CHUNK_SIZE = 16 * 1024;
+		// 2^53: larger integers are not exactly representable as double
+		private const double MAX_EXACT_MANTISSA = 9007199254740992.0;
+
+		private static readonly Dictionary<string, byte[]> _internedKeys = createInternedKeys();
+		private static readonly byte[] _hexDigits = new byte[] { (byte)'0', (byte)'1', (byte)'2', (byte)'3', (byte)'4', (byte)'5', (byte)'6', (byte)'7', (byte)'8', (byte)'9', (byte)'a', (byte)'b', (byte)'c', (byte)'d', (byte)'e', (byte)'f' };
+		private static readonly byte[] _true = new byte[] { (byte)'t', (byte)'r', (byte)'u', (byte)'e' };
+		private static readonly byte[] _false = new byte[] { (byte)'f', (byte)'a', (byte)'l', (byte)'s', (byte)'e' };
+		private static readonly byte[] _null = new byte[] { (byte)'n', (byte)'u', (byte)'l', (byte)'l' };
+		private static readonly byte[] _pointZero = new byte[] { (byte)'.', (byte)'0' };
+		private static readonly double[] _doublePowersOf10 = createPowersOf10();
+		// significant digits tried before falling back to 'ToString("R")'. Floats follow "R": 7 digits if they round-trip, else 9
+		private static readonly int[] _doubleDigits = new int[] { 15, 16 };
+		private static readonly int[] _floatDigits = new int[] { 7, 9 };
+		private static readonly byte[] _longMinValue = new byte[] { (byte)'-', (byte)'9', (byte)'2', (byte)'2', (byte)'3', (byte)'3', (byte)'7', (byte)'2', (byte)'0', (byte)'3', (byte)'6', (byte)'8', (byte)'5', (byte)'4', (byte)'7', (byte)'7', (byte)'5', (byte)'8', (byte)'0', (byte)'8' };
+
+		private readonly MemoryStream _compressed = new MemoryStream(CHUNK_SIZE);
+		private readonly byte[] _digits = new byte[20];
+		private byte[] _arena = new byte[CHUNK_SIZE + 1024];
+		private int _length;
+		private Stream _gzip;
+		private bool _compress;
+
+
+		/// <summary> Encoded body of the last <see cref="Encode"/> call. Only the first <see cref="Length"/> bytes are valid. </summary>
+		public byte[] Buffer { get { return _compress ? _compressed.GetBuffer() : _arena; } }
+
+		/// <summary> Number of valid bytes in <see cref="Buffer"/>. </summary>
+		public int Length { get { return _compress ? (int)_compressed.Length : _length; } }
+
+		/// <summary> Value for the 'Content-Encoding' header of the last encoded body, null if not compressed. </summary>
+		public string ContentEncoding { get { return _compress ? ContentEncodingGzip : null; } }
+
+
+		/// <summary> Encode <paramref name="batch"/> as a JSON array of event objects. </summary>
+		/// <returns>Number of valid bytes in <see cref="Buffer"/>.</returns>
+		public int Encode(List<TelemetryEvent> batch, bool compress)
+		{
+			_compress = compress;
+			_length = 0;
+			if (_compress)
+			{
+				_compressed.SetLength(0);
+				_gzip = new GZipStream(_compressed, CompressionLevel.Fastest, true);
+			}
+
+			writeByte((byte)'[');
+			for (int i = 0; i < batch.Count; i++)
+			{
+				if (i > 0) { writeByte((byte)','); }
+				writeEvent(batch[i]);
+				flushChunkIfFull();
+			}
+			writeByte((byte)']');
+
+			if (_compress)
+			{
+				_gzip.Write(_arena, 0, _length);
+				_gzip.Close();
+				_gzip = null;
+				_length = 0;
+			}
+
+			return Length;
+		}
+
+
+		/// <summary> True if <paramref name="body"/> starts with the gzip magic bytes. </summary>
+		public static bool IsGzipped(byte[] body, int length)
+		{
+			return length >= 2 && body[0] == 0x1f && body[1] == 0x8b;
+		}
+
+
+		private void writeEvent(TelemetryEvent telemetryEvent)
+		{
+			Dictionary<string, object> attributes = telemetryEvent.Attributes;
+
+			writeByte((byte)'{');
+			writeKey(TelemetryEvent.KeyEvent);
+			writeString(telemetryEvent.Name);
+			if (!attributes.ContainsKey(TelemetryEvent.KeyCreated))
+			{
+				writeByte((byte)',');
+				writeKey(TelemetryEvent.KeyCreated);
+				writeLong(telemetryEvent.Created);
+			}
+
+			foreach (KeyValuePair<string, object> attribute in attributes)
+			{
+				// the event's name always wins, same as 'TelemetryEvent.ToPayload()'
+				if (attribute.Key == TelemetryEvent.KeyEvent) { continue; }
+
+				writeByte((byte)',');
+				writeKey(attribute.Key);
+				writeValue(attribute.Value);
+				flushChunkIfFull();
+			}
+			writeByte((byte)'}');
+		}
+
+
+		private void writeKey(string key)
+		{
+			byte[] interned;
+			if (_internedKeys.TryGetValue(key, out interned))
+			{
+				writeBytes(interned);
+				return;
+			}
+
+			writeString(key);
+			writeByte((byte)':');
+		}
+
+
+		private void writeValue(object value)
+		{
+			if (null == value) { writeBytes(_null); return; }
+
+			string stringValue = value as string;
+			if (null != stringValue) { writeString(stringValue); return; }
+
+			if (value is bool) { writeBytes((bool)value ? _true : _false); return; }
+			if (value is int) { writeLong((int)value); return; }
+			if (value is long) { writeLong((long)value); return; }
+			if (value is double) { writeDouble((double)value); return; }
+			if (value is float) { writeFloat((float)value); return; }
+			if (value is short) { writeLong((short)value); return; }
+			if (value is byte) { writeLong((byte)value); return; }
+			if (value is uint) { writeLong((uint)value); return; }
+			if (value is ulong) { writeRaw(((ulong)value).ToString(CultureInfo.InvariantCulture)); return; }
+			if (value is decimal) { writeRaw(((decimal)value).ToString(CultureInfo.InvariantCulture)); return; }
+			if (value is DateTime) { writeString(((DateTime)value).ToString("yyyy-MM-ddTHH:mm:ss.fffK", CultureInfo.InvariantCulture)); return; }
+
+			Dictionary<string, object> dictionary = value as Dictionary<string, object>;
+			if (null != dictionary)
+			{
+				writeByte((byte)'{');
+				bool first = true;
+				foreach (KeyValuePair<string, object> entry in dictionary)
+				{
+					if (!first) { writeByte((byte)','); }
+					first = false;
+					writeKey(entry.Key);
+					writeValue(entry.Value);
+				}
+				writeByte((byte)'}');
+				return;
+			}
+
+			IDictionary genericDictionary = value as IDictionary;
+			if (null != genericDictionary)
+			{
+				writeByte((byte)'{');
+				bool first = true;
+				foreach (DictionaryEntry entry in genericDictionary)
+				{
+					if (!first) { writeByte((byte)','); }
+					first = false;
+					writeKey(Convert.ToString(entry.Key, CultureInfo.InvariantCulture));
+					writeValue(entry.Value);
+				}
+				writeByte((byte)'}');
+				return;
+			}
+
+			IList list = value as IList;
+			if (null != list)
+			{
+				writeByte((byte)'[');
+				for (int i = 0; i < list.Count; i++)
+				{
+					if (i > 0) { writeByte((byte)','); }
+					writeValue(list[i]);
+				}
+				writeByte((byte)']');
+				return;
+			}
+
+			writeString(Convert.ToString(value, CultureInfo.InvariantCulture));
+		}
+
+
+		private void writeLong(long value)
+		{
+			if (value == long.MinValue) { writeBytes(_longMinValue); return; }
+
+			ensureCapacity(20);
+			if (value < 0)
+			{
+				_arena[_length++] = (byte)'-';
+				value = -value;
+			}
+
+			int digitCount = 0;
+			do
+			{
+				_digits[digitCount++] = (byte)('0' + (int)(value % 10));
+				value /= 10;
+			}
+			while (value > 0);
+
+			while (digitCount > 0)
+			{
+				_arena[_length++] = _digits[--digitCount];
+			}
+		}
+
+
+		private void writeDouble(double value)
+		{
+			if (double.IsNaN(value) || double.IsInfinity(value))
+			{
+				// not representable in JSON
+				writeBytes(_null);
+				return;
+			}
+
+			if (value == Math.Floor(value) && Math.Abs(value) < 1e15)
+			{
+				// '.0' like Json.NET, so the value still reads back as a floating point number
+				writeLong((long)value);
+				writeBytes(_pointZero);
+				return;
+			}
+
+			if (!tryWriteFixedPoint(value, _doubleDigits, false))
+			{
+				writeRaw(value.ToString("R", CultureInfo.InvariantCulture));
+			}
+		}
+
+
+		/// <summary>
+		/// Floats are written at float precision like Json.NET does, widened to double 0.1f would become 0.100000001490116.
+		/// </summary>
+		private void writeFloat(float value)
+		{
+			if (float.IsNaN(value) || float.IsInfinity(value))
+			{
+				// not representable in JSON
+				writeBytes(_null);
+				return;
+			}
+
+			if (value == Math.Floor(value) && Math.Abs(value) < 1e15)
+			{
+				writeLong((long)value);
+				writeBytes(_pointZero);
+				return;
+			}
+
+			if (!tryWriteFixedPoint(value, _floatDigits, true))
+			{
+				writeRaw(value.ToString("R", CultureInfo.InvariantCulture));
+			}
+		}
+
+
+		/// <summary>
+		/// Writes <paramref name="value"/> as 'integer.fraction' with the fewest of <paramref name="significantDigitCounts"/>
+		/// significant digits that parse back to exactly the same double, or float if <paramref name="singlePrecision"/> is set.
+		/// <para>Both the mantissa (less than 2^53) and the power of ten are exact doubles, so their quotient is
+		/// correctly rounded, same as what a JSON parser does with the decimal string.</para>
+		/// </summary>
+		private bool tryWriteFixedPoint(double value, int[] significantDigitCounts, bool singlePrecision)
+		{
+			double absolute = Math.Abs(value);
+			if (absolute < 1e-3 || absolute >= 1e15)
+			{
+				return false;
+			}
+
+			int exponent = (int)Math.Floor(Math.Log10(absolute));
+			foreach (int significantDigits in significantDigitCounts)
+			{
+				int decimals = significantDigits - 1 - exponent;
+				if (decimals < 1 || decimals >= _doublePowersOf10.Length) { continue; }
+
+				double scale = _doublePowersOf10[decimals];
+				double mantissa = Math.Round(absolute * scale);
+				if (mantissa >= MAX_EXACT_MANTISSA) { continue; }
+				double parsed = mantissa / scale;
+				if (singlePrecision ? (float)parsed != (float)absolute : parsed != absolute) { continue; }
+
+				long digits = (long)mantissa;
+				while (decimals > 0 && digits % 10 == 0)
+				{
+					digits /= 10;
+					decimals--;
+				}
+
+				long divisor = (long)_doublePowersOf10[decimals];
+				if (value < 0) { writeByte((byte)'-'); }
+				writeLong(digits / divisor);
+				if (decimals > 0)
+				{
+					writeByte((byte)'.');
+					writePaddedFraction(digits % divisor, decimals);
+				}
+				return true;
+			}
+
+			return false;
+		}
+
+
+		private void writePaddedFraction(long fraction, int digitCount)
+		{
+			ensureCapacity(digitCount);
+			for (int i = digitCount - 1; i >= 0; i--)
+			{
+				_arena[_length + i] = (byte)('0' + (int)(fraction % 10));
+				fraction /= 10;
+			}
+			_length += digitCount;
+		}
+
+
+		/// <summary> ASCII only, used for numbers formatted by the framework. </summary>
+		private void writeRaw(string ascii)
+		{
+			ensureCapacity(ascii.Length);
+			for (int i = 0; i < ascii.Length; i++)
+			{
+				_arena[_length++] = (byte)ascii[i];
+			}
+		}
+
+
+		private void writeString(string value)
+		{
+			// worst case: every char becomes a 6 byte escape sequence
+			ensureCapacity(value.Length * 6 + 2);
+
+			_arena[_length++] = (byte)'"';
+			for (int i = 0; i < value.Length; i++)
+			{
+				char c = value[i];
+				if (c < 0x80)
+				{
+					if (c == '"' || c == '\\')
+					{
+						_arena[_length++] = (byte)'\\';
+						_arena[_length++] = (byte)c;
+					}
+					else if (c < 0x20)
+					{
+						_arena[_length++] = (byte)'\\';
+						_arena[_length++] = (byte)'u';
+						_arena[_length++] = (byte)'0';
+						_arena[_length++] = (byte)'0';
+						_arena[_length++] = _hexDigits[c >> 4];
+						_arena[_length++] = _hexDigits[c & 0xF];
+					}
+					else
+					{
+						_arena[_length++] = (byte)c;
+					}
+				}
+				else if (c < 0x800)
+				{
+					_arena[_length++] = (byte)(0xC0 | (c >> 6));
+					_arena[_length++] = (byte)(0x80 | (c & 0x3F));
+				}
+				else if (char.IsHighSurrogate(c) && i + 1 < value.Length && char.IsLowSurrogate(value[i + 1]))
+				{
+					int codePoint = char.ConvertToUtf32(c, value[i + 1]);
+					i++;
+					_arena[_length++] = (byte)(0xF0 | (codePoint >> 18));
+					_arena[_length++] = (byte)(0x80 | ((codePoint >> 12) & 0x3F));
+					_arena[_length++] = (byte)(0x80 | ((codePoint >> 6) & 0x3F));
+					_arena[_length++] = (byte)(0x80 | (codePoint & 0x3F));
+				}
+				else if (char.IsSurrogate(c))
+				{
+					// lone surrogate: U+FFFD replacement character
+					_arena[_length++] = 0xEF;
+					_arena[_length++] = 0xBF;
+					_arena[_length++] = 0xBD;
+				}
+				else
+				{
+					_arena[_length++] = (byte)(0xE0 | (c >> 12));
+					_arena[_length++] = (byte)(0x80 | ((c >> 6) & 0x3F));
+					_arena[_length++] = (byte)(0x80 | (c & 0x3F));
+				}
+			}
+			_arena[_length++] = (byte)'"';
+		}
+
+
+		private void writeByte(byte value)
+		{
+			ensureCapacity(1);
+			_arena[_length++] = value;
+		}
+
+
+		private void writeBytes(byte[] value)
+		{
+			ensureCapacity(value.Length);
+			System.Buffer.BlockCopy(value, 0, _arena, _length, value.Length);
+			_length += value.Length;
+		}
+
+
+		private void flushChunkIfFull()
+		{
+			if (_compress && _length >= CHUNK_SIZE)
+			{
+				_gzip.Write(_arena, 0, _length);
+				_length = 0;
+			}
+		}
+
+
+		private void ensureCapacity(int additionalBytes)
+		{
+			int required = _length + additionalBytes;
+			if (required <= _arena.Length) { return; }
+
+			int newSize = _arena.Length * 2;
+			while (newSize < required) { newSize *= 2; }
+
+			byte[] grown = new byte[newSize];
+			System.Buffer.BlockCopy(_arena, 0, grown, 0, _length);
+			_arena = grown;
+		}
+
+
+		private static double[] createPowersOf10()
+		{
+			// up to 10^18: exact as double and still fits into a long
+			double[] powers = new double[19];
+			powers[0] = 1;
+			for (int i = 1; i < powers.Length; i++)
+			{
+				powers[i] = powers[i - 1] * 10;
+			}
+			return powers;
+		}
+
+
+		private static Dictionary<string, byte[]> createInternedKeys()
+		{
+			string[] keys = new string[]
+			{
+				TelemetryEvent.KeyEvent
+				, TelemetryEvent.KeyCreated
+				, TelemetryEvent.KeyUserId
+				, TelemetryEvent.KeyEnabledTelemetry
+				, TelemetryEvent.KeySdkIdentifier
+				, TelemetryEvent.KeySdkVersion
+				, TelemetryEvent.KeySkuId
+				, TelemetryEvent.KeyUserAgent
+				, TelemetryEvent.KeyLatitude
+				, TelemetryEvent.KeyLongitude
+				, TelemetryEvent.KeyAltitude
+				, TelemetryEvent.KeyZoomLevel
+				, TelemetryEvent.KeySource
+				, TelemetryEvent.KeySessionId
+				, TelemetryEvent.KeyOperatingSystem
+				, TelemetryEvent.KeyModel
+				, TelemetryEvent.KeyDevice
+				, TelemetryEvent.KeyResolution
+				, TelemetryEvent.KeyApplicationState
+			};
+
+			Dictionary<string, byte[]> interned = new Dictionary<string, byte[]>();
+			foreach (string key in keys)
+			{
+				// keys are plain ASCII, no escaping needed
+				byte[] encoded = new byte[key.Length + 3];
+				encoded[0] = (byte)'"';
+				for (int i = 0; i < key.Length; i++)
+				{
+					encoded[i + 1] = (byte)key[i];
+				}
+				encoded[key.Length + 1] = (byte)'"';
+				encoded[key.Length + 2] = (byte)':';
+				interned[key] = encoded;
+			}
+			return interned;
+		}
+	}
+}
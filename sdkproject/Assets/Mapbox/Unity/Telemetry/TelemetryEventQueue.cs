@@ -0,0 +1,142 @@
+namespace Mapbox.Unity.Telemetry
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Threading;
+
+	/// <summary>
+	/// Bounded multi-producer/multi-consumer ring buffer without locks.
+	/// <para>Every slot carries a sequence number that tells producers and consumers whose turn it is
+	/// (http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue).</para>
+	/// <para>Enqueueing never blocks and never allocates: when the buffer is full <see cref="TryEnqueue"/> returns false.</para>
+	/// </summary>
+	public class TelemetryEventQueue<T> where T : class
+	{
+		private struct Slot
+		{
+			public int Sequence;
+			public T Item;
+		}
+
+		private readonly Slot[] _slots;
+		private readonly int _mask;
+		private int _enqueuePosition;
+		private int _dequeuePosition;
+
+		/// <param name="capacity">Rounded up to the next power of two.</param>
+		public TelemetryEventQueue(int capacity)
+		{
+			if (capacity < 2) { throw new ArgumentOutOfRangeException("capacity", "must be at least 2"); }
+
+			int size = 2;
+			while (size < capacity) { size <<= 1; }
+
+			_slots = new Slot[size];
+			_mask = size - 1;
+			for (int i = 0; i < size; i++)
+			{
+				_slots[i].Sequence = i;
+			}
+		}
+
+		public int Capacity { get { return _slots.Length; } }
+
+		/// <summary> Approximate number of queued items. Exact when no producer or consumer is running. </summary>
+		public int Count
+		{
+			get
+			{
+				int count = Thread.VolatileRead(ref _enqueuePosition) - Thread.VolatileRead(ref _dequeuePosition);
+				if (count < 0) { return 0; }
+				return count > _slots.Length ? _slots.Length : count;
+			}
+		}
+
+		public bool TryEnqueue(T item)
+		{
+			if (null == item) { throw new ArgumentNullException("item"); }
+
+			int position = Thread.VolatileRead(ref _enqueuePosition);
+			while (true)
+			{
+				int index = position & _mask;
+				int sequence = Thread.VolatileRead(ref _slots[index].Sequence);
+				int difference = sequence - position;
+
+				if (difference == 0)
+				{
+					if (Interlocked.CompareExchange(ref _enqueuePosition, position + 1, position) == position)
+					{
+						_slots[index].Item = item;
+						Thread.VolatileWrite(ref _slots[index].Sequence, position + 1);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					// slot still holds an item from the previous lap: full
+					return false;
+				}
+
+				position = Thread.VolatileRead(ref _enqueuePosition);
+			}
+		}
+
+		public bool TryDequeue(out T item)
+		{
+			int position = Thread.VolatileRead(ref _dequeuePosition);
+			while (true)
+			{
+				int index = position & _mask;
+				int sequence = Thread.VolatileRead(ref _slots[index].Sequence);
+				int difference = sequence - (position + 1);
+
+				if (difference == 0)
+				{
+					if (Interlocked.CompareExchange(ref _dequeuePosition, position + 1, position) == position)
+					{
+						item = _slots[index].Item;
+						_slots[index].Item = null;
+						Thread.VolatileWrite(ref _slots[index].Sequence, position + _mask + 1);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					// producer has not published this slot yet: empty
+					item = null;
+					return false;
+				}
+
+				position = Thread.VolatileRead(ref _dequeuePosition);
+			}
+		}
+
+		/// <summary> Moves up to <paramref name="maxItems"/> items into <paramref name="batch"/>. </summary>
+		/// <returns>Number of items added to the batch.</returns>
+		public int DequeueBatch(List<T> batch, int maxItems)
+		{
+			int dequeued = 0;
+			T item;
+			while (dequeued < maxItems && TryDequeue(out item))
+			{
+				batch.Add(item);
+				dequeued++;
+			}
+			return dequeued;
+		}
+
+		/// <summary> Drops everything currently queued. </summary>
+		/// <returns>Number of dropped items.</returns>
+		public int Clear()
+		{
+			int cleared = 0;
+			T item;
+			while (TryDequeue(out item))
+			{
+				cleared++;
+			}
+			return cleared;
+		}
+	}
+}
@@ -0,0 +1,444 @@
+namespace Mapbox.Unity.Telemetry
+{
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+
+	/// <summary>
+	/// Append-only on-disk spool for serialized telemetry batches that have not been delivered yet.
+	/// <para>Layout: a 16 byte header (magic, version, read cursor) followed by records of
+	/// [int32 length][uint32 crc32][payload]. Batches are written before they are posted and
+	/// acknowledged after the events endpoint accepted them, so a crash or a missing network
+	/// connection only delays delivery.</para>
+	/// <para>Opening the spool reads the unacknowledged part of the file once and only validates
+	/// record checksums, payloads are not parsed. A torn record at the end (crash during append)
+	/// is cut off.</para>
+	/// <para>I/O errors are passed on to the caller. A failed compaction reopens the spool from disk, if even that
+	/// fails every later call throws until the spool could be reopened.</para>
+	/// </summary>
+	public class TelemetryEventSpool : IDisposable
+	{
+		public const int DefaultMaxSpoolBytes = 1024 * 1024;
+		public const int DefaultCompactThresholdBytes = 64 * 1024;
+
+		private const int MAGIC = 0x5354424D; // "MBTS"
+		private const int VERSION = 1;
+		private const int HEADER_SIZE = 16;
+		private const int CURSOR_OFFSET = 8;
+		private const int RECORD_HEADER_SIZE = 8;
+
+		private static readonly uint[] _crcTable = createCrcTable();
+
+		private struct Record
+		{
+			public long Offset;
+			public int Length;
+		}
+
+		private readonly object _lock = new object();
+		private readonly string _path;
+		private readonly int _maxSpoolBytes;
+		private readonly int _compactThresholdBytes;
+		private readonly Queue<Record> _pending = new Queue<Record>();
+		private readonly byte[] _scratch = new byte[HEADER_SIZE];
+		private FileStream _file;
+		private bool _disposed;
+		private long _readCursor;
+		private long _writePosition;
+
+
+		public TelemetryEventSpool(string path)
+			: this(path, DefaultMaxSpoolBytes, DefaultCompactThresholdBytes)
+		{
+		}
+
+
+		public TelemetryEventSpool(string path, int maxSpoolBytes, int compactThresholdBytes)
+		{
+			if (string.IsNullOrEmpty(path)) { throw new ArgumentNullException("path"); }
+
+			_path = path;
+			_maxSpoolBytes = maxSpoolBytes;
+			_compactThresholdBytes = compactThresholdBytes;
+			open();
+		}
+
+
+		public string FilePath { get { return _path; } }
+
+		/// <summary> Number of batches waiting for acknowledgement. </summary>
+		public int PendingBatches { get { lock (_lock) { return _pending.Count; } } }
+
+		/// <summary> Current size of the spool file in bytes. </summary>
+		public long Length { get { lock (_lock) { return _writePosition; } } }
+
+
+		/// <summary> Append a serialized batch. </summary>
+		/// <returns>False if the spool reached its size limit, the batch was not stored.</returns>
+		public bool Append(byte[] payload, int length)
+		{
+			lock (_lock)
+			{
+				ensureOpen();
+				if (_writePosition + RECORD_HEADER_SIZE + length > _maxSpoolBytes)
+				{
+					return false;
+				}
+
+				writeInt(_scratch, 0, length);
+				writeInt(_scratch, 4, (int)crc32(payload, 0, length));
+
+				try
+				{
+					_file.Position = _writePosition;
+					_file.Write(_scratch, 0, RECORD_HEADER_SIZE);
+					_file.Write(payload, 0, length);
+					_file.Flush();
+				}
+				catch (Exception)
+				{
+					// eg disk full: cut off the partial record, it was never queued
+					try { _file.SetLength(_writePosition); }
+					catch (Exception) { }
+					throw;
+				}
+
+				_pending.Enqueue(new Record() { Offset = _writePosition, Length = length });
+				_writePosition += RECORD_HEADER_SIZE + length;
+				return true;
+			}
+		}
+
+
+		/// <summary> Oldest unacknowledged batch. </summary>
+		public bool TryPeek(out byte[] payload)
+		{
+			lock (_lock)
+			{
+				ensureOpen();
+				if (0 == _pending.Count)
+				{
+					payload = null;
+					return false;
+				}
+
+				Record record = _pending.Peek();
+				payload = new byte[record.Length];
+				_file.Position = record.Offset + RECORD_HEADER_SIZE;
+				readFully(_file, payload, 0, record.Length);
+				return true;
+			}
+		}
+
+
+		/// <summary> Mark the oldest batch as delivered and compact the file if enough space can be reclaimed. </summary>
+		public void Acknowledge()
+		{
+			lock (_lock)
+			{
+				ensureOpen();
+				if (0 == _pending.Count) { return; }
+
+				Record record = _pending.Dequeue();
+				_readCursor = record.Offset + RECORD_HEADER_SIZE + record.Length;
+
+				if (0 == _pending.Count)
+				{
+					// everything delivered: start over instead of growing forever
+					_file.SetLength(HEADER_SIZE);
+					_readCursor = HEADER_SIZE;
+					_writePosition = HEADER_SIZE;
+					writeCursor();
+				}
+				else
+				{
+					// persisted first, a failed compaction reopens the spool from disk
+					writeCursor();
+					if (_readCursor - HEADER_SIZE >= _compactThresholdBytes)
+					{
+						compact();
+					}
+				}
+			}
+		}
+
+
+		/// <summary> Drop all pending batches. </summary>
+		public void Clear()
+		{
+			lock (_lock)
+			{
+				ensureOpen();
+				_pending.Clear();
+				_file.SetLength(HEADER_SIZE);
+				_readCursor = HEADER_SIZE;
+				_writePosition = HEADER_SIZE;
+				writeCursor();
+			}
+		}
+
+
+		public void Dispose()
+		{
+			lock (_lock)
+			{
+				_disposed = true;
+				if (null != _file)
+				{
+					_file.Close();
+					_file = null;
+				}
+			}
+		}
+
+
+		/// <summary> Reopen after a failed recovery, see <see cref="compact"/>. </summary>
+		private void ensureOpen()
+		{
+			if (_disposed) { throw new ObjectDisposedException(_path); }
+			if (null == _file)
+			{
+				open();
+			}
+		}
+
+
+		private void open()
+		{
+			_pending.Clear();
+			string compactPath = _path + ".compact";
+			// crash between deleting the old spool and renaming the compacted one
+			if (!File.Exists(_path) && File.Exists(compactPath))
+			{
+				File.Move(compactPath, _path);
+			}
+
+			string directory = Path.GetDirectoryName(_path);
+			if (!string.IsNullOrEmpty(directory) && !Directory.Exists(directory))
+			{
+				Directory.CreateDirectory(directory);
+			}
+
+			FileStream file = new FileStream(_path, FileMode.OpenOrCreate, FileAccess.ReadWrite, FileShare.Read);
+			_file = file;
+			try
+			{
+				initialize();
+			}
+			catch (Exception)
+			{
+				_file = null;
+				_pending.Clear();
+				file.Close();
+				throw;
+			}
+		}
+
+
+		private void initialize()
+		{
+			if (_file.Length < HEADER_SIZE || !readHeader())
+			{
+				_file.SetLength(0);
+				writeInt(_scratch, 0, MAGIC);
+				writeInt(_scratch, 4, VERSION);
+				writeLong(_scratch, CURSOR_OFFSET, HEADER_SIZE);
+				_file.Position = 0;
+				_file.Write(_scratch, 0, HEADER_SIZE);
+				_file.Flush();
+				_readCursor = HEADER_SIZE;
+				_writePosition = HEADER_SIZE;
+				return;
+			}
+
+			scanRecords();
+		}
+
+
+		private bool readHeader()
+		{
+			_file.Position = 0;
+			readFully(_file, _scratch, 0, HEADER_SIZE);
+			if (MAGIC != readInt(_scratch, 0) || VERSION != readInt(_scratch, 4))
+			{
+				return false;
+			}
+
+			_readCursor = readLong(_scratch, CURSOR_OFFSET);
+			return _readCursor >= HEADER_SIZE && _readCursor <= _file.Length;
+		}
+
+
+		/// <summary> One read of the unacknowledged tail, validating checksums only. </summary>
+		private void scanRecords()
+		{
+			int tailLength = (int)(_file.Length - _readCursor);
+			byte[] tail = new byte[tailLength];
+			_file.Position = _readCursor;
+			readFully(_file, tail, 0, tailLength);
+
+			int position = 0;
+			while (position + RECORD_HEADER_SIZE <= tailLength)
+			{
+				int length = readInt(tail, position);
+				if (length < 0 || position + RECORD_HEADER_SIZE + length > tailLength)
+				{
+					break;
+				}
+
+				uint checksum = (uint)readInt(tail, position + 4);
+				if (checksum != crc32(tail, position + RECORD_HEADER_SIZE, length))
+				{
+					break;
+				}
+
+				_pending.Enqueue(new Record() { Offset = _readCursor + position, Length = length });
+				position += RECORD_HEADER_SIZE + length;
+			}
+
+			_writePosition = _readCursor + position;
+			if (_writePosition != _file.Length)
+			{
+				// drop torn or corrupted records at the end
+				_file.SetLength(_writePosition);
+			}
+		}
+
+
+		/// <summary>
+		/// Move pending records to the front. Written to a separate file and swapped in
+		/// so a crash never leaves a half compacted spool behind.
+		/// If writing the compacted file fails the spool keeps the old one, if swapping fails it is reopened from
+		/// whichever file is left, same as after a crash. Only a failed reopen is passed on.
+		/// </summary>
+		private void compact()
+		{
+			string compactPath = _path + ".compact";
+			int tailLength = (int)(_writePosition - _readCursor);
+			byte[] tail = new byte[tailLength];
+			_file.Position = _readCursor;
+			readFully(_file, tail, 0, tailLength);
+
+			writeInt(_scratch, 0, MAGIC);
+			writeInt(_scratch, 4, VERSION);
+			writeLong(_scratch, CURSOR_OFFSET, HEADER_SIZE);
+			try
+			{
+				using (FileStream compacted = new FileStream(compactPath, FileMode.Create, FileAccess.Write, FileShare.None))
+				{
+					compacted.Write(_scratch, 0, HEADER_SIZE);
+					compacted.Write(tail, 0, tailLength);
+				}
+			}
+			catch (Exception)
+			{
+				// try again on the next acknowledgement
+				try { File.Delete(compactPath); }
+				catch (Exception) { }
+				return;
+			}
+
+			try
+			{
+				_file.Close();
+				File.Delete(_path);
+				File.Move(compactPath, _path);
+				_file = new FileStream(_path, FileMode.Open, FileAccess.ReadWrite, FileShare.Read);
+			}
+			catch (Exception)
+			{
+				_file = null;
+				open();
+				return;
+			}
+
+			long shift = _readCursor - HEADER_SIZE;
+			int count = _pending.Count;
+			for (int i = 0; i < count; i++)
+			{
+				Record record = _pending.Dequeue();
+				record.Offset -= shift;
+				_pending.Enqueue(record);
+			}
+
+			_readCursor = HEADER_SIZE;
+			_writePosition = HEADER_SIZE + tailLength;
+		}
+
+
+		private void writeCursor()
+		{
+			writeLong(_scratch, 0, _readCursor);
+			_file.Position = CURSOR_OFFSET;
+			_file.Write(_scratch, 0, 8);
+			_file.Flush();
+		}
+
+
+		private static void readFully(Stream stream, byte[] buffer, int offset, int count)
+		{
+			while (count > 0)
+			{
+				int read = stream.Read(buffer, offset, count);
+				if (read <= 0) { throw new EndOfStreamException(); }
+				offset += read;
+				count -= read;
+			}
+		}
+
+
+		private static void writeInt(byte[] buffer, int offset, int value)
+		{
+			buffer[offset] = (byte)value;
+			buffer[offset + 1] = (byte)(value >> 8);
+			buffer[offset + 2] = (byte)(value >> 16);
+			buffer[offset + 3] = (byte)(value >> 24);
+		}
+
+
+		private static int readInt(byte[] buffer, int offset)
+		{
+			return buffer[offset] | (buffer[offset + 1] << 8) | (buffer[offset + 2] << 16) | (buffer[offset + 3] << 24);
+		}
+
+
+		private static void writeLong(byte[] buffer, int offset, long value)
+		{
+			writeInt(buffer, offset, (int)value);
+			writeInt(buffer, offset + 4, (int)(value >> 32));
+		}
+
+
+		private static long readLong(byte[] buffer, int offset)
+		{
+			return (uint)readInt(buffer, offset) | ((long)readInt(buffer, offset + 4) << 32);
+		}
+
+
+		private static uint[] createCrcTable()
+		{
+			uint[] table = new uint[256];
+			for (uint i = 0; i < 256; i++)
+			{
+				uint crc = i;
+				for (int bit = 0; bit < 8; bit++)
+				{
+					crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+				}
+				table[i] = crc;
+			}
+			return table;
+		}
+
+
+		private static uint crc32(byte[] buffer, int offset, int count)
+		{
+			uint crc = 0xFFFFFFFFu;
+			for (int i = offset; i < offset + count; i++)
+			{
+				crc = _crcTable[(crc ^ buffer[i]) & 0xFF] ^ (crc >> 8);
+			}
+			return ~crc;
+		}
+	}
+}
@@ -0,0 +1,423 @@
+namespace Mapbox.Unity.Telemetry
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Threading;
+
+	/// <summary>
+	/// Managed implementation of the <c>MMEEventsManager</c> queueing contract
+	/// (<c>enqueueEventWithName:attributes:</c>, <c>flush</c>, <c>resetEventQueuing</c>).
+	/// <para>Producers push into a lock-free <see cref="TelemetryEventQueue{T}"/> and return immediately.
+	/// A single background thread drains the queue and posts batches when either
+	/// <see cref="MaximumEventsPerFlush"/> events are pending or <see cref="FlushIntervalMilliseconds"/> elapsed.</para>
+	/// <para>With a <see cref="TelemetryEventSpool"/> every batch is persisted before it is posted and only removed
+	/// once the endpoint accepted it. Batches left over from a previous session are replayed on <see cref="Initialize(string, string, string)"/>.
+	/// A spooled batch the endpoint rejects, or that failed <see cref="MaximumSendAttempts"/> times in a row, is dropped so it
+	/// can't block the batches behind it. If the spool itself fails, eg the disk is full, it is no longer used for this
+	/// session and batches are posted directly.</para>
+	/// </summary>
+	public class TelemetryEventsManager : IDisposable
+	{
+		// same thresholds as MapboxMobileEvents
+		public const int DefaultMaximumEventsPerFlush = 180;
+		public const int DefaultFlushIntervalMilliseconds = 180 * 1000;
+		public const int DefaultQueueCapacity = 1024;
+		public const int DefaultMaximumSendAttempts = 10;
+
+		private readonly ITelemetryEventSender _sender;
+		private readonly TelemetryEventSpool _spool;
+		private readonly TelemetryEventQueue<TelemetryEvent> _queue;
+		private readonly int _maximumEventsPerFlush;
+		private readonly int _flushIntervalMilliseconds;
+		private readonly AutoResetEvent _flushSignal = new AutoResetEvent(false);
+		private readonly List<TelemetryEvent> _batch;
+		private readonly TelemetryEventEncoder _encoder = new TelemetryEventEncoder();
+		// event counts of the batches spooled by this session, oldest first. Spooled batches beyond these were left
+		// over by a previous session and sit at the head of the spool.
+		private readonly Queue<int> _spooledEventCounts = new Queue<int>();
+		private int _maximumSendAttempts = DefaultMaximumSendAttempts;
+		private int _headAttempts;
+		private volatile bool _spoolFailed;
+
+		private Thread _worker;
+		private volatile bool _running;
+		private volatile string _url;
+		private volatile string _userAgent;
+		private volatile bool _compressBodies = true;
+
+		private int _enqueuedEvents;
+		private int _droppedEvents;
+		private int _sentEvents;
+		private int _failedEvents;
+		private int _sentBatches;
+
+
+		public TelemetryEventsManager(ITelemetryEventSender sender)
+			: this(sender, DefaultQueueCapacity, DefaultMaximumEventsPerFlush, DefaultFlushIntervalMilliseconds)
+		{
+		}
+
+
+		public TelemetryEventsManager(ITelemetryEventSender sender, TelemetryEventSpool spool)
+			: this(sender, DefaultQueueCapacity, DefaultMaximumEventsPerFlush, DefaultFlushIntervalMilliseconds, spool)
+		{
+		}
+
+
+		public TelemetryEventsManager(
+			ITelemetryEventSender sender
+			, int queueCapacity
+			, int maximumEventsPerFlush
+			, int flushIntervalMilliseconds
+			, TelemetryEventSpool spool = null
+		)
+		{
+			if (null == sender) { throw new ArgumentNullException("sender"); }
+			if (maximumEventsPerFlush < 1) { throw new ArgumentOutOfRangeException("maximumEventsPerFlush"); }
+			if (flushIntervalMilliseconds < 1) { throw new ArgumentOutOfRangeException("flushIntervalMilliseconds"); }
+
+			_sender = sender;
+			_spool = spool;
+			_queue = new TelemetryEventQueue<TelemetryEvent>(queueCapacity);
+			_maximumEventsPerFlush = maximumEventsPerFlush;
+			_flushIntervalMilliseconds = flushIntervalMilliseconds;
+			_batch = new List<TelemetryEvent>(maximumEventsPerFlush);
+		}
+
+
+		public int MaximumEventsPerFlush { get { return _maximumEventsPerFlush; } }
+		public int FlushIntervalMilliseconds { get { return _flushIntervalMilliseconds; } }
+
+		/// <summary> Failed posts of the oldest spooled batch after which it is dropped. </summary>
+		public int MaximumSendAttempts
+		{
+			get { return _maximumSendAttempts; }
+			set
+			{
+				if (value < 1) { throw new ArgumentOutOfRangeException("value"); }
+				_maximumSendAttempts = value;
+			}
+		}
+
+		/// <summary> True once spool I/O failed, batches are posted without persisting them from then on. </summary>
+		public bool SpoolFailed { get { return _spoolFailed; } }
+		public bool IsInitialized { get { return null != _url; } }
+
+		/// <summary> Gzip request bodies (default). Applies to batches encoded after the change. </summary>
+		public bool CompressBodies
+		{
+			get { return _compressBodies; }
+			set { _compressBodies = value; }
+		}
+
+		/// <summary> Events waiting for the next flush. </summary>
+		public int PendingEvents { get { return _queue.Count; } }
+		public int EnqueuedEvents { get { return Thread.VolatileRead(ref _enqueuedEvents); } }
+		/// <summary> Events rejected because the queue was full. </summary>
+		public int DroppedEvents { get { return Thread.VolatileRead(ref _droppedEvents); } }
+		/// <summary> Events of this session accepted by the events endpoint. </summary>
+		public int SentEvents { get { return Thread.VolatileRead(ref _sentEvents); } }
+		/// <summary>
+		/// Events of this session that were given up on: not delivered and not spooled for a retry, rejected by the
+		/// endpoint, or dropped after <see cref="MaximumSendAttempts"/>.
+		/// </summary>
+		public int FailedEvents { get { return Thread.VolatileRead(ref _failedEvents); } }
+		/// <summary> Batches accepted by the events endpoint, including ones replayed from a previous session. </summary>
+		public int SentBatches { get { return Thread.VolatileRead(ref _sentBatches); } }
+
+
+		/// <summary>
+		/// Mirrors <c>initializeWithAccessToken:userAgentBase:hostSDKVersion:</c>. Starts the background flush thread.
+		/// </summary>
+		public void Initialize(string accessToken, string userAgentBase, string hostSDKVersion)
+		{
+			if (string.IsNullOrEmpty(accessToken))
+			{
+				throw new ArgumentNullException("accessToken");
+			}
+
+			Initialize(
+				string.Format("{0}events/v2?access_token={1}", Mapbox.Utils.Constants.EventsAPI, accessToken)
+				, string.Format("{0}/{1}", userAgentBase, hostSDKVersion)
+			);
+		}
+
+
+		/// <summary> Initialize with a custom endpoint, eg a local stub server. Spooled batches are posted to this endpoint as well. </summary>
+		public void Initialize(string url, string userAgent)
+		{
+			_url = url;
+			_userAgent = userAgent;
+
+			lock (_flushSignal)
+			{
+				if (null != _worker) { return; }
+
+				_running = true;
+				_worker = new Thread(flushLoop);
+				_worker.Name = "MapboxTelemetry";
+				_worker.IsBackground = true;
+				_worker.Start();
+			}
+		}
+
+
+		public void EnqueueEvent(string name)
+		{
+			EnqueueEvent(new TelemetryEvent(name, null));
+		}
+
+
+		public void EnqueueEvent(string name, Dictionary<string, object> attributes)
+		{
+			EnqueueEvent(new TelemetryEvent(name, attributes));
+		}
+
+
+		/// <summary> Never blocks. Drops the event if the queue is full. </summary>
+		/// <returns>False if the event was dropped.</returns>
+		public bool EnqueueEvent(TelemetryEvent telemetryEvent)
+		{
+			if (!_queue.TryEnqueue(telemetryEvent))
+			{
+				Interlocked.Increment(ref _droppedEvents);
+				_flushSignal.Set();
+				return false;
+			}
+
+			Interlocked.Increment(ref _enqueuedEvents);
+			if (_queue.Count >= _maximumEventsPerFlush)
+			{
+				_flushSignal.Set();
+			}
+			return true;
+		}
+
+
+		/// <summary> Ask the background thread to post all pending events now. Does not wait for completion. </summary>
+		public void Flush()
+		{
+			_flushSignal.Set();
+		}
+
+
+		/// <summary> Discard all pending events, including spooled batches. </summary>
+		public void ResetEventQueuing()
+		{
+			_queue.Clear();
+			if (null == _spool) { return; }
+
+			lock (_spooledEventCounts)
+			{
+				_spooledEventCounts.Clear();
+				_headAttempts = 0;
+				if (_spoolFailed) { return; }
+				try
+				{
+					_spool.Clear();
+				}
+				catch (Exception)
+				{
+					_spoolFailed = true;
+				}
+			}
+		}
+
+
+		public void Dispose()
+		{
+			Thread worker;
+			lock (_flushSignal)
+			{
+				worker = _worker;
+				_worker = null;
+				_running = false;
+			}
+
+			if (null != worker)
+			{
+				_flushSignal.Set();
+				worker.Join(_flushIntervalMilliseconds);
+			}
+		}
+
+
+		private void flushLoop()
+		{
+			// replay batches spooled by a previous session first
+			sendSpooled();
+
+			while (_running)
+			{
+				_flushSignal.WaitOne(_flushIntervalMilliseconds);
+				flushPending();
+			}
+
+			// last chance for events enqueued while shutting down
+			flushPending();
+		}
+
+
+		private void flushPending()
+		{
+			while (_queue.DequeueBatch(_batch, _maximumEventsPerFlush) > 0)
+			{
+				sendBatch(_batch);
+				_batch.Clear();
+			}
+
+			sendSpooled();
+		}
+
+
+		/// <summary>
+		/// Post spooled batches oldest first, stop at the first failure to keep the order. Rejected batches and batches
+		/// that failed too often are dropped.
+		/// </summary>
+		private void sendSpooled()
+		{
+			if (null == _spool || _spoolFailed || null == _url) { return; }
+
+			byte[] body;
+			while (tryPeekSpooled(out body))
+			{
+				TelemetrySendResult result = trySend(body, body.Length, TelemetryEventEncoder.IsGzipped(body, body.Length) ? TelemetryEventEncoder.ContentEncodingGzip : null);
+				lock (_spooledEventCounts)
+				{
+					if (TelemetrySendResult.Failed == result && ++_headAttempts < _maximumSendAttempts)
+					{
+						return;
+					}
+
+					// delivered or given up on
+					_headAttempts = 0;
+					int events = headEventCount();
+					try
+					{
+						_spool.Acknowledge();
+					}
+					catch (Exception)
+					{
+						failSpool();
+					}
+					if (TelemetrySendResult.Accepted == result)
+					{
+						Interlocked.Add(ref _sentEvents, events);
+					}
+					else
+					{
+						Interlocked.Add(ref _failedEvents, events);
+					}
+					if (_spoolFailed) { return; }
+				}
+			}
+		}
+
+
+		private bool tryPeekSpooled(out byte[] body)
+		{
+			try
+			{
+				return _spool.TryPeek(out body);
+			}
+			catch (Exception)
+			{
+				lock (_spooledEventCounts)
+				{
+					failSpool();
+				}
+				body = null;
+				return false;
+			}
+		}
+
+
+		/// <summary> Events of the oldest spooled batch, 0 if it was spooled by a previous session. Call with the lock held. </summary>
+		private int headEventCount()
+		{
+			int previousSession = _spool.PendingBatches - _spooledEventCounts.Count;
+			if (previousSession > 0 || 0 == _spooledEventCounts.Count)
+			{
+				return 0;
+			}
+			return _spooledEventCounts.Dequeue();
+		}
+
+
+		/// <summary> Stop using the spool, events still in it are counted as failed. Call with the lock held. </summary>
+		private void failSpool()
+		{
+			_spoolFailed = true;
+			while (_spooledEventCounts.Count > 0)
+			{
+				Interlocked.Add(ref _failedEvents, _spooledEventCounts.Dequeue());
+			}
+		}
+
+
+		private void sendBatch(List<TelemetryEvent> batch)
+		{
+			if (null == _url)
+			{
+				Interlocked.Add(ref _failedEvents, batch.Count);
+				return;
+			}
+
+			int bodyLength = _encoder.Encode(batch, _compressBodies);
+
+			// spooled batches are posted by 'sendSpooled()' after the queue has been drained
+			if (null != _spool && !_spoolFailed)
+			{
+				lock (_spooledEventCounts)
+				{
+					bool spooled;
+					try
+					{
+						spooled = _spool.Append(_encoder.Buffer, bodyLength);
+					}
+					catch (Exception)
+					{
+						// eg disk full, post directly from now on
+						failSpool();
+						spooled = false;
+					}
+					if (spooled)
+					{
+						_spooledEventCounts.Enqueue(batch.Count);
+						return;
+					}
+				}
+			}
+
+			if (TelemetrySendResult.Accepted == trySend(_encoder.Buffer, bodyLength, _encoder.ContentEncoding))
+			{
+				Interlocked.Add(ref _sentEvents, batch.Count);
+			}
+			else
+			{
+				Interlocked.Add(ref _failedEvents, batch.Count);
+			}
+		}
+
+
+		private TelemetrySendResult trySend(byte[] body, int bodyLength, string contentEncoding)
+		{
+			TelemetrySendResult result;
+			try
+			{
+				result = _sender.Send(_url, _userAgent, body, bodyLength, contentEncoding);
+			}
+			catch (Exception)
+			{
+				// a misbehaving sender must never take the flush thread down
+				result = TelemetrySendResult.Failed;
+			}
+
+			if (TelemetrySendResult.Accepted == result)
+			{
+				Interlocked.Increment(ref _sentBatches);
+			}
+			return result;
+		}
+	}
+}
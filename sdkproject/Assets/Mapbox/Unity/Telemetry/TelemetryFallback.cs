@@ -1,17 +1,13 @@
 namespace Mapbox.Unity.Telemetry
 {
 	using System.Collections.Generic;
-	using System.Collections;
-	using Mapbox.Json;
 	using System;
-	using Mapbox.Unity.Utilities;
+	using System.IO;
 	using UnityEngine;
-	using System.Text;
-	using UnityEngine.Networking;
 
 	public class TelemetryFallback : ITelemetryLibrary
 	{
-		string _url;
+		TelemetryEventsManager _eventsManager;
 
 		static ITelemetryLibrary _instance = new TelemetryFallback();
 		public static ITelemetryLibrary Instance
@@ -24,7 +20,15 @@ namespace Mapbox.Unity.Telemetry
 
 		public void Initialize(string accessToken)
 		{
-			_url = string.Format("{0}events/v2?access_token={1}", Mapbox.Utils.Constants.EventsAPI, accessToken);
+			if (null == _eventsManager)
+			{
+				_eventsManager = new TelemetryEventsManager(new TelemetryHttpEventSender(), CreateSpool());
+			}
+
+			_eventsManager.Initialize(
+				string.Format("{0}events/v2?access_token={1}", Mapbox.Utils.Constants.EventsAPI, accessToken)
+				, GetUserAgent()
+			);
 		}
 
 		public void SendTurnstile()
@@ -32,29 +36,36 @@ namespace Mapbox.Unity.Telemetry
 			var ticks = DateTime.Now.Ticks;
 			if (ShouldPostTurnstile(ticks))
 			{
-				Runnable.Run(PostWWW(_url, GetPostBody()));
+				// posting happens on the events manager's thread, never blocks the caller
+				_eventsManager.EnqueueEvent(TelemetryEvent.TypeAppUserTurnstile, GetTurnstileAttributes());
+				_eventsManager.Flush();
 				PlayerPrefs.SetString(Constants.Path.TELEMETRY_TURNSTILE_LAST_TICKS_FALLBACK_KEY, ticks.ToString());
 			}
 		}
 
-		string GetPostBody()
+		static TelemetryEventSpool CreateSpool()
 		{
-			List<Dictionary<string, object>> eventList = new List<Dictionary<string, object>>();
-			Dictionary<string, object> jsonDict = new Dictionary<string, object>();
-
-			long unixTimestamp = (long)Mapbox.Utils.UnixTimestampUtils.To(DateTime.UtcNow);
-
-			jsonDict.Add("event", "appUserTurnstile");
-			jsonDict.Add("created", unixTimestamp);
-			jsonDict.Add("userId", SystemInfo.deviceUniqueIdentifier);
-			jsonDict.Add("enabled.telemetry", false);
-			jsonDict.Add("sdkIdentifier", GetSDKIdentifier());
-			jsonDict.Add("skuId", Constants.SDK_SKU_ID);
-			jsonDict.Add("sdkVersion", Constants.SDK_VERSION);
-			eventList.Add(jsonDict);
+			try
+			{
+				return new TelemetryEventSpool(Path.Combine(Application.persistentDataPath, "telemetry.spool"));
+			}
+			catch (Exception ex)
+			{
+				// no persistent storage: events are still sent, just not retried across sessions
+				Debug.LogWarningFormat("Telemetry spool not available: {0}", ex.Message);
+				return null;
+			}
+		}
 
-			var jsonString = JsonConvert.SerializeObject(eventList);
-			return jsonString;
+		Dictionary<string, object> GetTurnstileAttributes()
+		{
+			Dictionary<string, object> attributes = new Dictionary<string, object>();
+			attributes.Add(TelemetryEvent.KeyUserId, SystemInfo.deviceUniqueIdentifier);
+			attributes.Add(TelemetryEvent.KeyEnabledTelemetry, false);
+			attributes.Add(TelemetryEvent.KeySdkIdentifier, GetSDKIdentifier());
+			attributes.Add(TelemetryEvent.KeySkuId, Constants.SDK_SKU_ID);
+			attributes.Add(TelemetryEvent.KeySdkVersion, Constants.SDK_VERSION);
+			return attributes;
 		}
 
 		bool ShouldPostTurnstile(long ticks)
@@ -69,27 +80,6 @@ namespace Mapbox.Unity.Telemetry
 			return timeSpan.Days >= 1;
 		}
 
-		IEnumerator PostWWW(string url, string bodyJsonString)
-		{
-			byte[] bodyRaw = Encoding.UTF8.GetBytes(bodyJsonString);
-
-#if UNITY_2017_1_OR_NEWER
-			UnityWebRequest postRequest = new UnityWebRequest(url, "POST");
-			postRequest.SetRequestHeader("Content-Type", "application/json");
-
-			postRequest.downloadHandler = new DownloadHandlerBuffer();
-			postRequest.uploadHandler = new UploadHandlerRaw(bodyRaw);
-
-			yield return postRequest.SendWebRequest();
-#else
-			var headers = new Dictionary<string, string>();
-			headers.Add("Content-Type", "application/json");
-			headers.Add("user-agent", GetUserAgent());
-			var www = new WWW(url, bodyRaw, headers);
-			yield return www;
-#endif
-		}
-
 		static string GetUserAgent()
 		{
 			var userAgent = string.Format("{0}/{1}/{2} MapboxEventsUnity{3}/{4}",
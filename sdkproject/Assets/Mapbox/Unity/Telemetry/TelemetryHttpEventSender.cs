@@ -0,0 +1,72 @@
+namespace Mapbox.Unity.Telemetry
+{
+	using System;
+	using System.IO;
+	using System.Net;
+
+	/// <summary>
+	/// <see cref="ITelemetryEventSender"/> on top of <see cref="HttpWebRequest"/>.
+	/// Unlike UnityWebRequest it can be used from any thread.
+	/// </summary>
+	public class TelemetryHttpEventSender : ITelemetryEventSender
+	{
+		private readonly int _timeoutMilliseconds;
+
+		public TelemetryHttpEventSender(int timeoutMilliseconds = 30000)
+		{
+			_timeoutMilliseconds = timeoutMilliseconds;
+		}
+
+		public TelemetrySendResult Send(string url, string userAgent, byte[] body, int bodyLength, string contentEncoding)
+		{
+			try
+			{
+				HttpWebRequest request = (HttpWebRequest)WebRequest.Create(url);
+				request.Method = "POST";
+				request.ContentType = "application/json";
+				request.UserAgent = userAgent;
+				request.KeepAlive = true;
+				request.Timeout = _timeoutMilliseconds;
+				request.ContentLength = bodyLength;
+				if (null != contentEncoding)
+				{
+					request.Headers[HttpRequestHeader.ContentEncoding] = contentEncoding;
+				}
+
+				using (Stream requestStream = request.GetRequestStream())
+				{
+					requestStream.Write(body, 0, bodyLength);
+				}
+
+				using (HttpWebResponse response = (HttpWebResponse)request.GetResponse())
+				{
+					return result((int)response.StatusCode);
+				}
+			}
+			catch (WebException ex)
+			{
+				// non 2xx responses end up here as well
+				HttpWebResponse response = ex.Response as HttpWebResponse;
+				if (null == response) { return TelemetrySendResult.Failed; }
+				using (response)
+				{
+					return result((int)response.StatusCode);
+				}
+			}
+			catch (IOException)
+			{
+				return TelemetrySendResult.Failed;
+			}
+		}
+
+
+		private static TelemetrySendResult result(int statusCode)
+		{
+			if (statusCode >= 200 && statusCode < 300) { return TelemetrySendResult.Accepted; }
+			// throttled, may be accepted later
+			if (429 == statusCode || 408 == statusCode) { return TelemetrySendResult.Failed; }
+			if (statusCode >= 400 && statusCode < 500) { return TelemetrySendResult.Rejected; }
+			return TelemetrySendResult.Failed;
+		}
+	}
+}
@@ -13,7 +13,7 @@
 	{
 		string _url;
 
-		static ITelemetryLibrary _instance = new TelemetryFallback();
+		static ITelemetryLibrary _instance = new TelemetryWebgl();
 		public static ITelemetryLibrary Instance
 		{
 			get
@@ -0,0 +1,236 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+	using Mapbox.VectorTile.Geometry;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class ConversionsTests
+	{
+		private const int POINTS = 10000;
+		private const int BENCHMARK_POINTS = 1000000;
+		private const int ZOOM = 16;
+
+		// around Helsinki, where tiles are ~300m wide at zoom 16
+		private static readonly Vector2d CENTER = new Vector2d(60.1699, 24.9384);
+
+		[Test]
+		public void BatchMatchesScalar()
+		{
+			var latLons = points(POINTS, 1, 0.5);
+			var refPoint = Conversions.LatLonToMeters(CENTER);
+
+			var meters = new Vector2d[POINTS];
+			Conversions.LatLonToMeters(latLons, meters);
+			var back = new Vector2d[POINTS];
+			Conversions.MetersToLatLon(meters, back);
+			var world = new Vector3[POINTS];
+			Conversions.GeoToWorldPosition(latLons, 0, refPoint, 0.5f, world, 0, POINTS);
+			var tile = new Vector2[POINTS];
+			Conversions.LatitudeLongitudeToUnityTilePosition(latLons, 0, ZOOM, 2f, tile, 0, POINTS);
+
+			for (int i = 0; i < POINTS; i++)
+			{
+				var expectedMeters = Conversions.LatLonToMeters(latLons[i]);
+				Assert.AreEqual(expectedMeters.x, meters[i].x, 1e-6, "meters " + i);
+				Assert.AreEqual(expectedMeters.y, meters[i].y, 1e-6, "meters " + i);
+
+				var expectedLatLon = Conversions.MetersToLatLon(meters[i]);
+				Assert.AreEqual(expectedLatLon.x, back[i].x, 1e-10, "lat/lon " + i);
+				Assert.AreEqual(expectedLatLon.y, back[i].y, 1e-10, "lat/lon " + i);
+				Assert.AreEqual(latLons[i].x, back[i].x, 1e-9, "roundtrip " + i);
+
+				// float positions up to ~30km from the center
+				var expectedWorld = Conversions.GeoToWorldPosition(latLons[i], refPoint, 0.5f);
+				Assert.AreEqual(expectedWorld.x, world[i].x, 1e-2, "world " + i);
+				Assert.AreEqual(0f, world[i].y, "world " + i);
+				Assert.AreEqual(expectedWorld.y, world[i].z, 1e-2, "world " + i);
+
+				// the scalar path goes through float vector tile coordinates
+				var expectedTile = Conversions.LatitudeLongitudeToUnityTilePosition(latLons[i], ZOOM, 2f);
+				Assert.AreEqual(expectedTile.x, tile[i].x, 1e-2, "tile " + i);
+				Assert.AreEqual(expectedTile.y, tile[i].y, 1e-2, "tile " + i);
+			}
+
+			// lists, eg route geometries, are appended to
+			var list = new List<Vector3> { Vector3.up };
+			Conversions.GeoToWorldPosition(new List<Vector2d>(latLons), refPoint, 0.5f, list);
+			Assert.AreEqual(POINTS + 1, list.Count);
+			Assert.AreEqual(Vector3.up, list[0]);
+			Assert.AreEqual(world[POINTS - 1], list[POINTS]);
+		}
+
+		[Test]
+		public void SlicesAreRespected()
+		{
+			var latLons = points(20, 2, 0.5);
+			var meters = new Vector2d[30];
+			Conversions.LatLonToMeters(latLons, 5, meters, 10, 8);
+			for (int i = 0; i < meters.Length; i++)
+			{
+				var expected = i >= 10 && i < 18 ? Conversions.LatLonToMeters(latLons[i - 5]) : Vector2d.zero;
+				Assert.AreEqual(expected.x, meters[i].x, 1e-6, "slot " + i);
+				Assert.AreEqual(expected.y, meters[i].y, 1e-6, "slot " + i);
+			}
+
+			// in place
+			var copy = (Vector2d[])latLons.Clone();
+			Conversions.LatLonToMeters(copy, 0, copy, 0, copy.Length);
+			Conversions.MetersToLatLon(copy, copy);
+			for (int i = 0; i < copy.Length; i++)
+			{
+				Assert.AreEqual(latLons[i].x, copy[i].x, 1e-9);
+				Assert.AreEqual(latLons[i].y, copy[i].y, 1e-9);
+			}
+
+			// empty slices at the end are fine, anything past it isn't
+			Conversions.LatLonToMeters(latLons, 20, meters, 30, 0);
+			Assert.Throws<ArgumentOutOfRangeException>(() => Conversions.LatLonToMeters(latLons, 15, meters, 0, 6));
+			Assert.Throws<ArgumentOutOfRangeException>(() => Conversions.LatLonToMeters(latLons, 0, meters, 25, 6));
+			Assert.Throws<ArgumentOutOfRangeException>(() => Conversions.MetersToLatLon(meters, -1, latLons, 0, 1));
+			Assert.Throws<ArgumentNullException>(() => Conversions.GeoToWorldPosition(latLons, 0, Vector2d.zero, 1f, null, 0, 1));
+		}
+
+		[Test]
+		public void TileTransformMatchesScalar()
+		{
+			var tileId = Conversions.LatitudeLongitudeToTileId(CENTER.x, CENTER.y, ZOOM);
+			var bounds = Conversions.TileBounds(tileId);
+			var transform = TileTransform.ForTile(tileId, 2f);
+
+			// vector tile coordinates, the way features used to be projected
+			var random = new System.Random(3);
+			var geometry = new List<Point2d<float>>();
+			for (int i = 0; i < 1000; i++)
+			{
+				geometry.Add(new Point2d<float>((float)random.NextDouble() * 4352 - 128, (float)random.NextDouble() * 4352 - 128));
+			}
+			var local = new List<Vector3>();
+			transform.VectorTileToLocal(geometry, local);
+			Assert.AreEqual(geometry.Count, local.Count);
+			for (int i = 0; i < geometry.Count; i++)
+			{
+				var point = geometry[i];
+				var expectedX = (float)(point.X / 4096f * bounds.Size.x - (bounds.Size.x / 2)) * 2f;
+				var expectedZ = (float)((4096f - point.Y) / 4096f * bounds.Size.y - (bounds.Size.y / 2)) * 2f;
+				Assert.AreEqual(expectedX, local[i].x, 1e-3, "point " + i);
+				Assert.AreEqual(expectedZ, local[i].z, 1e-3, "point " + i);
+				Assert.AreEqual(local[i], transform.VectorTileToLocal(point.X, point.Y));
+			}
+
+			// lat/lon and meters of points within the tile
+			var sw = Conversions.MetersToLatLon(new Vector2d(bounds.Min.x, bounds.Max.y));
+			var ne = Conversions.MetersToLatLon(new Vector2d(bounds.Max.x, bounds.Min.y));
+			var latLons = new Vector2d[POINTS];
+			for (int i = 0; i < POINTS; i++)
+			{
+				latLons[i] = new Vector2d(sw.x + (ne.x - sw.x) * (0.001 + random.NextDouble() * 0.998), sw.y + (ne.y - sw.y) * (0.001 + random.NextDouble() * 0.998));
+			}
+			var meters = new Vector2d[POINTS];
+			Conversions.LatLonToMeters(latLons, meters);
+			var fromMeters = new Vector3[POINTS];
+			transform.MetersToLocal(meters, 0, fromMeters, 0, POINTS);
+			var fromLatLons = new Vector3[POINTS];
+			transform.LatLonToLocal(latLons, 0, fromLatLons, 0, POINTS);
+			for (int i = 0; i < POINTS; i++)
+			{
+				var expected = Conversions.LatitudeLongitudeToUnityTilePosition(latLons[i], ZOOM, 2f);
+				Assert.AreEqual(expected.x, fromMeters[i].x, 1e-2, "meters " + i);
+				Assert.AreEqual(expected.y, fromMeters[i].z, 1e-2, "meters " + i);
+				Assert.AreEqual(expected.x, fromLatLons[i].x, 1e-2, "lat/lon " + i);
+				Assert.AreEqual(expected.y, fromLatLons[i].z, 1e-2, "lat/lon " + i);
+				Assert.AreEqual(fromMeters[i], transform.MetersToLocal(meters[i]));
+			}
+
+			// translated to where the tile sits in the world
+			var offset = new Vector3(100, 5, -200);
+			var world = transform.Translate(offset);
+			var expectedCorner = transform.VectorTileToLocal(10, 20) + offset;
+			var corner = world.VectorTileToLocal(10, 20);
+			Assert.AreEqual(expectedCorner.x, corner.x, 1e-3);
+			Assert.AreEqual(expectedCorner.y, corner.y);
+			Assert.AreEqual(expectedCorner.z, corner.z, 1e-3);
+			var moved = world.MetersToLocal(meters[0]);
+			Assert.AreEqual(fromMeters[0].x + offset.x, moved.x, 1e-3);
+			Assert.AreEqual(offset.y, moved.y);
+			Assert.AreEqual(fromMeters[0].z + offset.z, moved.z, 1e-3);
+		}
+
+		[Test]
+		public void BenchmarkMillionPoints()
+		{
+			var latLons = points(BENCHMARK_POINTS, 4, 0.5);
+			var refPoint = Conversions.LatLonToMeters(CENTER);
+			var meters = new Vector2d[BENCHMARK_POINTS];
+			var world = new Vector3[BENCHMARK_POINTS];
+			var tile = new Vector2[BENCHMARK_POINTS];
+			var transform = TileTransform.ForTile(Conversions.LatitudeLongitudeToTileId(CENTER.x, CENTER.y, ZOOM), 1f);
+
+			var watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_POINTS; i++) { meters[i] = Conversions.LatLonToMeters(latLons[i]); }
+			var metersScalar = watch.Elapsed.TotalMilliseconds;
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			Conversions.LatLonToMeters(latLons, meters);
+			var metersBatch = watch.Elapsed.TotalMilliseconds;
+
+			var latLonsBack = new Vector2d[BENCHMARK_POINTS];
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_POINTS; i++) { latLonsBack[i] = Conversions.MetersToLatLon(meters[i]); }
+			var latLonScalar = watch.Elapsed.TotalMilliseconds;
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			Conversions.MetersToLatLon(meters, latLonsBack);
+			var latLonBatch = watch.Elapsed.TotalMilliseconds;
+
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_POINTS; i++) { world[i] = Conversions.GeoToWorldPosition(latLons[i], refPoint, 0.5f).ToVector3xz(); }
+			var worldScalar = watch.Elapsed.TotalMilliseconds;
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			Conversions.GeoToWorldPosition(latLons, 0, refPoint, 0.5f, world, 0, BENCHMARK_POINTS);
+			var worldBatch = watch.Elapsed.TotalMilliseconds;
+
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_POINTS; i++) { tile[i] = Conversions.LatitudeLongitudeToUnityTilePosition(latLons[i], ZOOM, 1f); }
+			var tileScalar = watch.Elapsed.TotalMilliseconds;
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			Conversions.LatitudeLongitudeToUnityTilePosition(latLons, 0, ZOOM, 1f, tile, 0, BENCHMARK_POINTS);
+			var tileBatch = watch.Elapsed.TotalMilliseconds;
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			transform.LatLonToLocal(latLons, 0, world, 0, BENCHMARK_POINTS);
+			var tileTransform = watch.Elapsed.TotalMilliseconds;
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			transform.MetersToLocal(meters, 0, world, 0, BENCHMARK_POINTS);
+			var metersTransform = watch.Elapsed.TotalMilliseconds;
+
+			Debug.Log(string.Format(
+				"[Conversions] {0} points, scalar vs batch: LatLonToMeters {1:0}ms / {2:0}ms, MetersToLatLon {3:0}ms / {4:0}ms, GeoToWorldPosition {5:0}ms / {6:0}ms, LatitudeLongitudeToUnityTilePosition {7:0}ms / {8:0}ms, TileTransform lat/lon {9:0}ms, meters {10:0}ms"
+				, BENCHMARK_POINTS
+				, metersScalar
+				, metersBatch
+				, latLonScalar
+				, latLonBatch
+				, worldScalar
+				, worldBatch
+				, tileScalar
+				, tileBatch
+				, tileTransform
+				, metersTransform
+			));
+		}
+
+		/// <summary> Random coordinates within <paramref name="spread"/> degrees of <see cref="CENTER"/>. </summary>
+		private static Vector2d[] points(int count, int seed, double spread)
+		{
+			var random = new System.Random(seed);
+			var latLons = new Vector2d[count];
+			for (int i = 0; i < count; i++)
+			{
+				latLons[i] = new Vector2d(CENTER.x + (random.NextDouble() * 2 - 1) * spread, CENTER.y + (random.NextDouble() * 2 - 1) * spread);
+			}
+			return latLons;
+		}
+	}
+}
@@ -0,0 +1,260 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using Assets.Mapbox.Unity.MeshGeneration.Modifiers.MeshModifiers;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class EarcutTests
+	{
+		//downtown tile with more building footprints than any real one
+		private const int BUILDINGS_PER_TILE = 6000;
+
+		// triangulations recorded with the previous Node based implementation
+		[Test]
+		public void MatchesReferenceTriangulation()
+		{
+			assertTriangulation(new[] { 1, 3, 0, 3, 1, 2 }, ring(0, 0, 0, 10, 10, 10, 10, 0));
+			assertTriangulation(new[] { 0, 4, 5, 3, 1, 2, 0, 3, 4, 3, 0, 1 }, ring(0, 0, 0, 10, 4, 10, 4, 4, 10, 4, 10, 0));
+			assertTriangulation(new[] { 3, 0, 4, 0, 2, 1, 2, 0, 3 }, ring(0, 0, 10, 0, 10, 10, 5, 15, 0, 10));
+			assertTriangulation(new[] { 1, 6, 0, 6, 4, 5, 1, 4, 6, 1, 2, 4 }, ring(0, 0, 0, 5, 0, 10, 0, 10, 10, 10, 10, 0, 5, 0));
+			assertTriangulation(
+				new[] { 0, 7, 4, 5, 0, 4, 1, 7, 0, 5, 3, 0, 2, 7, 1, 6, 3, 5, 2, 6, 7, 6, 2, 3 }
+				, ring(0, 0, 0, 10, 10, 10, 10, 0)
+				, ring(3, 3, 7, 3, 7, 7, 3, 7)
+			);
+			assertTriangulation(
+				new[] { 6, 8, 5, 9, 0, 4, 1, 4, 0, 6, 11, 8, 9, 3, 0, 1, 7, 4, 10, 3, 9, 2, 7, 1, 10, 2, 3, 2, 6, 7, 11, 2, 10, 2, 11, 6 }
+				, ring(0, 0, 0, 10, 20, 10, 20, 0)
+				, ring(2, 2, 6, 2, 6, 8, 2, 8)
+				, ring(12, 2, 18, 2, 18, 8, 12, 8)
+			);
+		}
+
+		[Test]
+		public void AppendsWithIndexOffset()
+		{
+			var data = EarcutLibrary.Flatten(new List<List<Vector3>> { ring(0, 0, 0, 10, 10, 10, 10, 0) });
+			var triangles = new List<int> { 42 };
+			EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim, triangles, 100);
+			CollectionAssert.AreEqual(new[] { 42, 101, 103, 100, 103, 101, 102 }, triangles);
+		}
+
+		[Test]
+		public void LargePolygonCoversItsArea()
+		{
+			//more than 80 vertices switches to the z-order hashed ear test
+			var rings = new List<List<Vector3>> { star(0, 0, 200), star(0, 0, 40, 0.2f, 3f) };
+			rings[1].Reverse();
+			var data = EarcutLibrary.Flatten(rings);
+			var triangles = EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim);
+
+			var expected = Math.Abs(area(rings[0])) - Math.Abs(area(rings[1]));
+			var actual = 0.0;
+			for (int i = 0; i < triangles.Count; i += 3)
+			{
+				actual += Math.Abs(area(new List<Vector3> { vertex(rings, triangles[i]), vertex(rings, triangles[i + 1]), vertex(rings, triangles[i + 2]) }));
+			}
+			Assert.AreEqual(expected, actual, expected * 1e-4);
+
+			// scratch arena is reused, output doesn't depend on previous polygons
+			CollectionAssert.AreEqual(triangles, EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim));
+		}
+
+		[Test]
+		public void BatchMatchesSinglePolygons()
+		{
+			var polygons = buildings(500);
+			var batch = new EarcutBatch();
+			foreach (var polygon in polygons)
+			{
+				batch.AddPolygon(polygon);
+			}
+
+			batch.Triangulate();
+			var single = new List<int>(batch.Triangles);
+			batch.Triangulate(4);
+			CollectionAssert.AreEqual(single, batch.Triangles, "result depends on the number of workers");
+
+			for (int p = 0; p < polygons.Count; p++)
+			{
+				var data = EarcutLibrary.Flatten(polygons[p]);
+				var expected = EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim);
+				int start, count;
+				batch.GetTriangles(p, out start, out count);
+				Assert.AreEqual(expected.Count, count, "polygon " + p);
+				for (int i = 0; i < count; i++)
+				{
+					Assert.AreEqual(expected[i] + batch.FirstVertex(p), batch.Triangles[start + i], "polygon " + p);
+				}
+			}
+		}
+
+		[Test]
+		public void BatchSkipsEmptyPolygons()
+		{
+			var polygons = buildings(3);
+			var withEmptyHole = new List<List<Vector3>>(polygons[1]);
+			withEmptyHole.Add(new List<Vector3>());
+			var batch = new EarcutBatch();
+
+			Assert.AreEqual(0, batch.AddPolygon(polygons[0]));
+			Assert.AreEqual(-1, batch.AddPolygon(new List<List<Vector3>>()));
+			Assert.AreEqual(-1, batch.AddPolygon(new List<List<Vector3>> { new List<Vector3>(), new List<Vector3>() }));
+			Assert.AreEqual(1, batch.AddPolygon(withEmptyHole));
+			Assert.AreEqual(2, batch.AddPolygon(polygons[2]));
+			Assert.AreEqual(3, batch.PolygonCount);
+
+			batch.Triangulate();
+			for (int p = 0; p < polygons.Count; p++)
+			{
+				var data = EarcutLibrary.Flatten(polygons[p]);
+				int start, count;
+				batch.GetTriangles(p, out start, out count);
+				Assert.AreEqual(EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim).Count, count, "polygon " + p);
+			}
+		}
+
+		[Test]
+		public void BenchmarkDenseTile()
+		{
+			var polygons = buildings(BUILDINGS_PER_TILE);
+			var data = new Data();
+			var triangles = new List<int>();
+			var batch = new EarcutBatch();
+			foreach (var polygon in polygons)
+			{
+				batch.AddPolygon(polygon);
+			}
+
+			// warm up, buffers grow to their final size
+			triangulateEach(polygons, data, triangles);
+			batch.Triangulate(EarcutBatch.DefaultWorkerCount);
+
+			GC.Collect();
+			var before = GC.GetTotalMemory(false);
+			var watch = System.Diagnostics.Stopwatch.StartNew();
+			foreach (var polygon in polygons)
+			{
+				var flat = EarcutLibrary.Flatten(polygon);
+				EarcutLibrary.Earcut(flat.Vertices, flat.Holes, flat.Dim);
+			}
+			var allocatingMs = watch.Elapsed.TotalMilliseconds;
+			var allocatingBytes = GC.GetTotalMemory(false) - before;
+
+			GC.Collect();
+			before = GC.GetTotalMemory(false);
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			triangulateEach(polygons, data, triangles);
+			var reusedMs = watch.Elapsed.TotalMilliseconds;
+			var reusedBytes = GC.GetTotalMemory(false) - before;
+
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			batch.Triangulate();
+			var batchMs = watch.Elapsed.TotalMilliseconds;
+
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			batch.Triangulate(EarcutBatch.DefaultWorkerCount);
+			var parallelMs = watch.Elapsed.TotalMilliseconds;
+
+			Debug.Log(string.Format(
+				"[Earcut] {0} buildings: allocating {1:0.0}ms {2}KB, reused buffers {3:0.0}ms {4}KB, batch {5:0.0}ms, batch on {6} workers {7:0.0}ms"
+				, BUILDINGS_PER_TILE
+				, allocatingMs
+				, allocatingBytes / 1024
+				, reusedMs
+				, reusedBytes / 1024
+				, batchMs
+				, EarcutBatch.DefaultWorkerCount
+				, parallelMs
+			));
+			Assert.Less(reusedBytes, allocatingBytes);
+		}
+
+		private static void triangulateEach(List<List<List<Vector3>>> polygons, Data data, List<int> triangles)
+		{
+			foreach (var polygon in polygons)
+			{
+				EarcutLibrary.Flatten(polygon, data);
+				triangles.Clear();
+				EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim, triangles);
+			}
+		}
+
+		private static void assertTriangulation(int[] expected, params List<Vector3>[] rings)
+		{
+			var data = EarcutLibrary.Flatten(new List<List<Vector3>>(rings));
+			CollectionAssert.AreEqual(expected, EarcutLibrary.Earcut(data.Vertices, data.Holes, data.Dim));
+		}
+
+		/// <summary>
+		/// Footprints with 4 to 24 jagged corners, every tenth one with a courtyard, laid out on a grid.
+		/// </summary>
+		private static List<List<List<Vector3>>> buildings(int count)
+		{
+			var random = new System.Random(7);
+			var polygons = new List<List<List<Vector3>>>(count);
+			for (int i = 0; i < count; i++)
+			{
+				var x = (i % 100) * 30f;
+				var z = (i / 100) * 30f;
+				var polygon = new List<List<Vector3>> { star(x, z, 4 + random.Next(21), 0.3f) };
+				if (i % 10 == 0)
+				{
+					var courtyard = star(x, z, 4, 0f, 3f);
+					courtyard.Reverse();
+					polygon.Add(courtyard);
+				}
+				polygons.Add(polygon);
+			}
+			return polygons;
+		}
+
+		private static List<Vector3> star(float x, float z, int corners, float jag = 0.5f, float radius = 10f)
+		{
+			var points = new List<Vector3>(corners);
+			for (int i = 0; i < corners; i++)
+			{
+				var angle = -i * Mathf.PI * 2 / corners;
+				var r = radius * (i % 2 == 0 ? 1 : 1 - jag);
+				points.Add(new Vector3(x + Mathf.Cos(angle) * r, 0, z + Mathf.Sin(angle) * r));
+			}
+			return points;
+		}
+
+		private static List<Vector3> ring(params float[] xz)
+		{
+			var points = new List<Vector3>(xz.Length / 2);
+			for (int i = 0; i < xz.Length; i += 2)
+			{
+				points.Add(new Vector3(xz[i], 0, xz[i + 1]));
+			}
+			return points;
+		}
+
+		private static Vector3 vertex(List<List<Vector3>> rings, int index)
+		{
+			foreach (var r in rings)
+			{
+				if (index < r.Count)
+				{
+					return r[index];
+				}
+				index -= r.Count;
+			}
+			throw new ArgumentOutOfRangeException("index");
+		}
+
+		private static double area(List<Vector3> points)
+		{
+			var sum = 0.0;
+			for (int i = 0, j = points.Count - 1; i < points.Count; j = i++)
+			{
+				sum += (double)points[j].x * points[i].z - (double)points[i].x * points[j].z;
+			}
+			return sum / 2;
+		}
+	}
+}
@@ -0,0 +1,451 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.IO;
+	using Mapbox.Unity.Map;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.Unity.MeshGeneration.Filters;
+	using Mapbox.VectorTile;
+	using Mapbox.VectorTile.Geometry;
+	using NUnit.Framework;
+
+	[TestFixture]
+	internal class LayerFilterTests
+	{
+		private static readonly string[] _buildingTypes = new string[] { "residential", "commercial", "apartments", "garage", "industrial", "school", "Church", "house" };
+		private static readonly string[] _roadClasses = new string[] { "motorway", "motorway_link", "trunk", "primary", "secondary", "tertiary", "street", "street_limited", "service", "path", "major_rail" };
+		private static readonly string[] _structures = new string[] { "none", "bridge", "tunnel", "ford" };
+
+		private System.Random _random;
+
+		[SetUp]
+		public void SetUp()
+		{
+			_random = new System.Random(42);
+		}
+
+		[Test]
+		public void CompiledMatchesComparers()
+		{
+			VectorTileLayer layer = mixedLayer(2000);
+			int compared = 0;
+			for (int f = 0; f < 300; f++)
+			{
+				ILayerFeatureFilterComparer comparer = randomFilter(0);
+				CompiledLayerFilter compiled = CompiledLayerFilter.Compile(comparer);
+				Assert.IsNotNull(compiled, "built in comparers have to compile");
+				CompiledLayerFilter.LayerTagFilter tagFilter = compiled.ForLayer(layer);
+
+				for (int i = 0; i < layer.FeatureCount(); i++)
+				{
+					VectorTileFeature feature = layer.GetFeature(i);
+					var unityFeature = new VectorFeatureUnity() { Data = feature, Properties = feature.GetProperties() };
+					bool expected;
+					try
+					{
+						expected = comparer.Try(unityFeature);
+					}
+					catch (Exception)
+					{
+						// comparers throw on values they can't compare, the compiled filter rejects them
+						continue;
+					}
+					Assert.AreEqual(expected, tagFilter.Try(feature), "tags of feature {0}, filter {1}", i, f);
+					Assert.AreEqual(expected, compiled.Try(unityFeature), "properties of feature {0}, filter {1}", i, f);
+					compared++;
+				}
+			}
+			Assert.Greater(compared, 300 * 1000);
+		}
+
+		[Test]
+		public void MissingKeysFoldToConstants()
+		{
+			VectorTileLayer layer = roadLayer(10);
+
+			var greater = CompiledLayerFilter.Compile(LayerFilterComparer.AllOf(
+				LayerFilterComparer.HasPropertyGreaterThan("height", 10)
+				, LayerFilterComparer.PropertyContainsValue("class", "street")
+			));
+			Assert.IsTrue(greater.ForLayer(layer).RejectsAll);
+
+			var none = CompiledLayerFilter.Compile(LayerFilterComparer.NoneOf(LayerFilterComparer.HasProperty("height")));
+			Assert.IsTrue(none.ForLayer(layer).AcceptsAll);
+
+			var any = CompiledLayerFilter.Compile(LayerFilterComparer.AnyOf(
+				LayerFilterComparer.HasProperty("height")
+				, LayerFilterComparer.PropertyContainsValue("class", "motorway")
+			));
+			var tagFilter = any.ForLayer(layer);
+			Assert.IsFalse(tagFilter.RejectsAll);
+			Assert.IsFalse(tagFilter.AcceptsAll);
+		}
+
+		[Test]
+		public void CustomComparersAreNotCompiled()
+		{
+			Assert.IsNull(CompiledLayerFilter.Compile(new PassEverything()));
+			Assert.IsNull(CompiledLayerFilter.Compile(LayerFilterComparer.AnyOf(LayerFilterComparer.HasProperty("class"), new PassEverything())));
+
+			var compiled = CompiledLayerFilter.Compile(LayerFilterComparer.HasProperty("class"));
+			Assert.AreSame(compiled, CompiledLayerFilter.Compile(compiled));
+		}
+
+		[Test]
+		public void TypeFilterFollowsReassignedTypes()
+		{
+			var feature = new VectorFeatureUnity() { Properties = new Dictionary<string, object>() { { "type", "House" } } };
+			var filter = new TypeFilter() { Types = new string[] { "GARAGE" }, Behaviour = TypeFilter.TypeFilterType.Include };
+			filter.Initialize();
+			Assert.IsFalse(filter.Try(feature));
+
+			// same length, the lowered types must not be reused
+			filter.Types = new string[] { "HOUSE" };
+			Assert.IsTrue(filter.Try(feature));
+		}
+
+		[Test]
+		public void BenchmarkBuildingAndRoadFilters()
+		{
+			const int features = 20000;
+			const int repeats = 3;
+
+			// the same filters the layer visualizer builds from the sublayer filter options
+			var buildingOptions = new VectorFilterOptions() { combinerType = LayerFilterCombinerOperationType.All };
+			buildingOptions.filters.Add(new LayerFilter() { Key = "extrude", filterOperator = LayerFilterOperationType.Contains, PropertyValue = "true" });
+			buildingOptions.filters.Add(new LayerFilter() { Key = "height", filterOperator = LayerFilterOperationType.IsInRange, Min = 10, Max = 300 });
+			buildingOptions.filters.Add(new LayerFilter() { Key = "type", filterOperator = LayerFilterOperationType.Contains, PropertyValue = "residential, commercial, apartments" });
+
+			var roadOptions = new VectorFilterOptions() { combinerType = LayerFilterCombinerOperationType.Any };
+			roadOptions.filters.Add(new LayerFilter() { Key = "class", filterOperator = LayerFilterOperationType.Contains, PropertyValue = "motorway,trunk,primary" });
+			roadOptions.filters.Add(new LayerFilter() { Key = "lanes", filterOperator = LayerFilterOperationType.IsGreater, Min = 3 });
+
+			VectorTileLayer buildings = buildingLayer(features);
+			VectorTileLayer roads = roadLayer(features);
+			ILayerFeatureFilterComparer buildingFilter = combine(buildingOptions);
+			ILayerFeatureFilterComparer roadFilter = combine(roadOptions);
+
+			int legacyPassed = 0;
+			Stopwatch sw = Stopwatch.StartNew();
+			for (int r = 0; r < repeats; r++)
+			{
+				legacyPassed += legacyFilter(buildings, buildingFilter) + legacyFilter(roads, roadFilter);
+			}
+			double legacyMs = sw.Elapsed.TotalMilliseconds;
+
+			int compiledPassed = 0;
+			sw = Stopwatch.StartNew();
+			for (int r = 0; r < repeats; r++)
+			{
+				compiledPassed += compiledFilter(buildings, buildingFilter) + compiledFilter(roads, roadFilter);
+			}
+			double compiledMs = sw.Elapsed.TotalMilliseconds;
+
+			// the predicates alone, on features that have already been read
+			var parsed = new List<VectorTileFeature>();
+			for (int i = 0; i < features; i++) { parsed.Add(buildings.GetFeature(i)); }
+			sw = Stopwatch.StartNew();
+			int predicatePassed = 0;
+			for (int r = 0; r < repeats; r++)
+			{
+				foreach (VectorTileFeature feature in parsed)
+				{
+					if (buildingFilter.Try(new VectorFeatureUnity() { Data = feature, Properties = feature.GetProperties() })) { predicatePassed++; }
+				}
+			}
+			double legacyPredicateMs = sw.Elapsed.TotalMilliseconds;
+			sw = Stopwatch.StartNew();
+			for (int r = 0; r < repeats; r++)
+			{
+				CompiledLayerFilter.LayerTagFilter tagFilter = CompiledLayerFilter.Compile(buildingFilter).ForLayer(buildings);
+				foreach (VectorTileFeature feature in parsed)
+				{
+					if (tagFilter.Try(feature)) { predicatePassed--; }
+				}
+			}
+			double compiledPredicateMs = sw.Elapsed.TotalMilliseconds;
+
+			Assert.AreEqual(0, predicatePassed);
+			Assert.AreEqual(legacyPassed, compiledPassed);
+			Assert.Greater(compiledPassed, 0);
+			Assert.Less(compiledPassed, repeats * features * 2);
+			UnityEngine.Debug.Log(string.Format(
+				"[LayerFilter] {0} buildings + {0} roads x {1}: decoding all features for the comparers {2:0.0}ms, filtering on tags first {3:0.0}ms ({4:0.0}x), {5:0.0}% of the features passed; building predicate alone {6:0.0}ms vs {7:0.0}ms ({8:0.0}x)"
+				, features
+				, repeats
+				, legacyMs
+				, compiledMs
+				, legacyMs / Math.Max(compiledMs, 0.001)
+				, 100.0 * compiledPassed / (repeats * features * 2)
+				, legacyPredicateMs
+				, compiledPredicateMs
+				, legacyPredicateMs / Math.Max(compiledPredicateMs, 0.001)
+			));
+		}
+
+		#region helper methods
+
+		private class PassEverything : ILayerFeatureFilterComparer
+		{
+			public bool Try(VectorFeatureUnity feature)
+			{
+				return true;
+			}
+		}
+
+		private static ILayerFeatureFilterComparer combine(VectorFilterOptions options)
+		{
+			var filters = new ILayerFeatureFilterComparer[options.filters.Count];
+			for (int i = 0; i < filters.Length; i++)
+			{
+				filters[i] = options.filters[i].GetFilterComparer();
+			}
+			switch (options.combinerType)
+			{
+				case LayerFilterCombinerOperationType.Any:
+					return LayerFilterComparer.AnyOf(filters);
+				case LayerFilterCombinerOperationType.None:
+					return LayerFilterComparer.NoneOf(filters);
+				default:
+					return LayerFilterComparer.AllOf(filters);
+			}
+		}
+
+		/// <summary> What the decoder did before: decode geometry and properties of every feature and run the comparers on them. </summary>
+		private static int legacyFilter(VectorTileLayer layer, ILayerFeatureFilterComparer filter)
+		{
+			int passed = 0;
+			int count = layer.FeatureCount();
+			for (int i = 0; i < count; i++)
+			{
+				VectorTileFeature feature = layer.GetFeature(i);
+				feature.Geometry<float>(0);
+				var unityFeature = new VectorFeatureUnity() { Data = feature, Properties = feature.GetProperties() };
+				if (filter.Try(unityFeature)) { passed++; }
+			}
+			return passed;
+		}
+
+		private static int compiledFilter(VectorTileLayer layer, ILayerFeatureFilterComparer filter)
+		{
+			CompiledLayerFilter.LayerTagFilter tagFilter = CompiledLayerFilter.Compile(filter).ForLayer(layer);
+			int passed = 0;
+			int count = layer.FeatureCount();
+			for (int i = 0; i < count; i++)
+			{
+				VectorTileFeature feature = layer.GetFeature(i);
+				if (!tagFilter.Try(feature)) { continue; }
+				feature.Geometry<float>(0);
+				feature.GetProperties();
+				passed++;
+			}
+			return passed;
+		}
+
+		private ILayerFeatureFilterComparer randomFilter(int depth)
+		{
+			if (depth < 2 && _random.Next(3) == 0)
+			{
+				var children = new ILayerFeatureFilterComparer[_random.Next(4)];
+				for (int i = 0; i < children.Length; i++) { children[i] = randomFilter(depth + 1); }
+				switch (_random.Next(3))
+				{
+					case 0: return LayerFilterComparer.AnyOf(children);
+					case 1: return LayerFilterComparer.AllOf(children);
+					default: return LayerFilterComparer.NoneOf(children);
+				}
+			}
+
+			string numericKey = _random.Next(2) == 0 ? "height" : "min_height";
+			double min = _random.Next(-5, 60);
+			switch (_random.Next(8))
+			{
+				case 0: return LayerFilterComparer.HasProperty(_random.Next(2) == 0 ? "name" : "missing");
+				case 1: return LayerFilterComparer.HasPropertyInRange(numericKey, min, min + _random.Next(40));
+				case 2: return LayerFilterComparer.HasPropertyGreaterThan(numericKey, min);
+				case 3: return LayerFilterComparer.HasPropertyLessThan(numericKey, min);
+				case 4: return LayerFilterComparer.HasPropertyIsEqual(numericKey, _random.Next(10));
+				case 5: return LayerFilterComparer.PropertyContainsValue(_random.Next(2) == 0 ? "type" : "name", "res", "church", "x");
+				case 6: return new LayerFilter() { Key = "extrude", filterOperator = LayerFilterOperationType.Contains, PropertyValue = "true" }.GetFilterComparer();
+				default:
+					return new TypeFilter()
+					{
+						Types = new string[] { "Residential", "GARAGE", "church" },
+						Behaviour = _random.Next(2) == 0 ? TypeFilter.TypeFilterType.Include : TypeFilter.TypeFilterType.Exclude
+					};
+			}
+		}
+
+		/// <summary> Values of every kind the vector tile spec allows, features miss some keys. </summary>
+		private VectorTileLayer mixedLayer(int features)
+		{
+			var builder = new LayerBuilder(_random, "mixed", GeomType.POINT);
+			for (int i = 0; i < features; i++)
+			{
+				builder.BeginFeature();
+				if (_random.Next(10) > 0) { builder.Tag("type", _buildingTypes[_random.Next(_buildingTypes.Length)]); }
+				if (_random.Next(4) > 0) { builder.Tag("name", _random.Next(3) == 0 ? "Main Street" : "Church " + _random.Next(20)); }
+				switch (_random.Next(5))
+				{
+					case 0: builder.Tag("height", (double)_random.Next(60) + 0.5); break;
+					case 1: builder.Tag("height", (float)_random.Next(60)); break;
+					case 2: builder.Tag("height", (long)_random.Next(-10, 60)); break;
+					case 3: builder.Tag("height", (ulong)_random.Next(60)); break;
+				}
+				if (_random.Next(2) == 0) { builder.Tag("min_height", (long)_random.Next(10)); }
+				if (_random.Next(3) > 0) { builder.Tag("extrude", _random.Next(2) == 0 ? "true" : "false"); }
+				if (_random.Next(5) == 0) { builder.Tag("underground", _random.Next(2) == 0); }
+			}
+			return builder.Layer;
+		}
+
+		private VectorTileLayer buildingLayer(int features)
+		{
+			var builder = new LayerBuilder(_random, "building", GeomType.POLYGON);
+			for (int i = 0; i < features; i++)
+			{
+				builder.BeginFeature();
+				builder.Tag("type", _buildingTypes[_random.Next(_buildingTypes.Length)]);
+				builder.Tag("height", (long)(3 * _random.Next(1, 40)));
+				builder.Tag("min_height", 0L);
+				builder.Tag("extrude", _random.Next(10) == 0 ? "false" : "true");
+				builder.Tag("underground", "false");
+			}
+			return builder.Layer;
+		}
+
+		private VectorTileLayer roadLayer(int features)
+		{
+			var builder = new LayerBuilder(_random, "road", GeomType.LINESTRING);
+			for (int i = 0; i < features; i++)
+			{
+				builder.BeginFeature();
+				builder.Tag("class", _roadClasses[_random.Next(_roadClasses.Length)]);
+				builder.Tag("type", _roadClasses[_random.Next(_roadClasses.Length)]);
+				builder.Tag("structure", _structures[_random.Next(_structures.Length)]);
+				builder.Tag("oneway", _random.Next(3) == 0 ? "true" : "false");
+				if (_random.Next(4) == 0) { builder.Tag("lanes", (long)_random.Next(1, 6)); }
+				builder.Tag("len", _random.NextDouble() * 500);
+			}
+			return builder.Layer;
+		}
+
+		/// <summary> Layer with deduplicated keys and values like a decoded tile, one geometry type for all features. </summary>
+		private class LayerBuilder
+		{
+			private readonly VectorTileLayer _layer;
+			private readonly System.Random _random;
+			private readonly GeomType _geometryType;
+			private readonly Dictionary<string, int> _keys = new Dictionary<string, int>();
+			private readonly Dictionary<object, int> _values = new Dictionary<object, int>();
+			private readonly List<int> _tags = new List<int>();
+			private bool _hasFeature;
+
+			public LayerBuilder(System.Random random, string name, GeomType geometryType)
+			{
+				_random = random;
+				_geometryType = geometryType;
+				_layer = new VectorTileLayer() { Name = name, Extent = 4096, Version = 2 };
+				_layer.Keys = new List<string>();
+				_layer.Values = new List<object>();
+			}
+
+			public VectorTileLayer Layer
+			{
+				get
+				{
+					endFeature();
+					return _layer;
+				}
+			}
+
+			public void BeginFeature()
+			{
+				endFeature();
+				_hasFeature = true;
+			}
+
+			public void Tag(string key, object value)
+			{
+				int keyIndex;
+				if (!_keys.TryGetValue(key, out keyIndex))
+				{
+					keyIndex = _keys[key] = _layer.Keys.Count;
+					_layer.Keys.Add(key);
+				}
+				int valueIndex;
+				if (!_values.TryGetValue(value, out valueIndex))
+				{
+					valueIndex = _values[value] = _layer.Values.Count;
+					_layer.Values.Add(value);
+				}
+				_tags.Add(keyIndex);
+				_tags.Add(valueIndex);
+			}
+
+			private void endFeature()
+			{
+				if (!_hasFeature) { return; }
+				_hasFeature = false;
+
+				var tags = new MemoryStream();
+				foreach (int tag in _tags) { writeVarint(tags, (ulong)tag); }
+				var geometry = new MemoryStream();
+				writeVarint(geometry, (1 << 3) | 1); // MoveTo
+				writeVarint(geometry, zigzag(_random.Next(4096)));
+				writeVarint(geometry, zigzag(_random.Next(4096)));
+				if (_geometryType != GeomType.POINT)
+				{
+					// footprints of ~10 corners, roads of ~20 points
+					int points = _geometryType == GeomType.POLYGON ? _random.Next(4, 12) : _random.Next(10, 30);
+					writeVarint(geometry, (ulong)((points << 3) | 2)); // LineTo
+					for (int i = 0; i < points; i++)
+					{
+						writeVarint(geometry, zigzag(_random.Next(-40, 40)));
+						writeVarint(geometry, zigzag(_random.Next(-40, 40)));
+					}
+					if (_geometryType == GeomType.POLYGON)
+					{
+						writeVarint(geometry, (1 << 3) | 7); // ClosePath
+					}
+				}
+
+				var feature = new MemoryStream();
+				writeVarint(feature, (1 << 3) | 0);
+				writeVarint(feature, (ulong)_layer.FeatureCount() + 1);
+				writeBytes(feature, 2, tags.ToArray());
+				writeVarint(feature, (3 << 3) | 0);
+				writeVarint(feature, (ulong)_geometryType);
+				writeBytes(feature, 4, geometry.ToArray());
+				_layer.AddFeatureData(feature.ToArray());
+				_tags.Clear();
+			}
+
+			private static ulong zigzag(int value)
+			{
+				return (ulong)(uint)((value << 1) ^ (value >> 31));
+			}
+
+			private static void writeVarint(Stream stream, ulong value)
+			{
+				while (value >= 0x80)
+				{
+					stream.WriteByte((byte)(value | 0x80));
+					value >>= 7;
+				}
+				stream.WriteByte((byte)value);
+			}
+
+			private static void writeBytes(Stream stream, int field, byte[] bytes)
+			{
+				writeVarint(stream, (ulong)((field << 3) | 2));
+				writeVarint(stream, (ulong)bytes.Length);
+				stream.Write(bytes, 0, bytes.Length);
+			}
+		}
+
+		#endregion
+	}
+}
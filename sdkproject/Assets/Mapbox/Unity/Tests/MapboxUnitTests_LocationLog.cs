@@ -0,0 +1,311 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Globalization;
+	using System.IO;
+	using System.Text;
+	using Mapbox.Unity.Location;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class LocationLogTests
+	{
+		private static readonly string[] _exampleTraces = new string[]
+		{
+			"Helsinki.txt",
+			"LocationProviderAndroidNative.txt",
+			"LocationProviderAndroidNative-2.txt",
+			"LocationProviderUnity.txt"
+		};
+
+		[Test]
+		public void ConvertedExampleTracesMatchText()
+		{
+			foreach (var trace in _exampleTraces)
+			{
+				var path = Path.Combine(Application.dataPath, "Mapbox/Unity/Location/ExampleGpsTraces/" + trace);
+				var text = File.ReadAllBytes(path);
+
+				var expected = new List<Location>();
+				using (var reader = new LocationLogReader(text))
+				{
+					var locations = reader.GetLocations(false);
+					while (locations.MoveNext()) { expected.Add(locations.Current); }
+				}
+
+				var output = new MemoryStream();
+				Assert.AreEqual(expected.Count, LocationLogConverter.TextToBinary(text, output), trace);
+				var binary = output.ToArray();
+				Assert.Less(binary.Length, text.Length / 4, trace);
+
+				using (var reader = new BinaryLocationLogReader(binary))
+				{
+					Assert.AreEqual(expected.Count, reader.Count, trace);
+					var locations = reader.GetLocations(false);
+					for (int i = 0; i < expected.Count; i++)
+					{
+						Assert.IsTrue(locations.MoveNext(), trace);
+						assertSameLocation(expected[i], locations.Current, trace + "[" + i + "]");
+					}
+					Assert.IsFalse(locations.MoveNext(), trace);
+				}
+			}
+		}
+
+		[Test]
+		public void RoundTripPreservesFields()
+		{
+			var expected = syntheticTrace(2500);
+			var binary = writeBinary(expected);
+
+			using (var reader = new BinaryLocationLogReader(binary))
+			{
+				Assert.AreEqual(expected.Count, reader.Count);
+				// out of order access decodes blocks again
+				foreach (var i in new int[] { 2499, 0, 1024, 1023, 2048, 7 })
+				{
+					assertSameLocation(expected[i], reader[i], "location[" + i + "]");
+				}
+				Assert.Throws<ArgumentOutOfRangeException>(() => { var l = reader[expected.Count]; });
+			}
+		}
+
+		[Test]
+		public void SeekByTime()
+		{
+			var expected = syntheticTrace(5000);
+			using (var reader = new BinaryLocationLogReader(writeBinary(expected)))
+			{
+				Assert.AreEqual(0, reader.IndexOf(0));
+				Assert.AreEqual(0, reader.IndexOf(expected[0].Timestamp));
+				Assert.AreEqual(reader.Count, reader.IndexOf(expected[expected.Count - 1].Timestamp + 1));
+				foreach (var i in new int[] { 1, 1023, 1024, 1025, 3000, 4999 })
+				{
+					Assert.AreEqual(i, reader.IndexOf(expected[i].Timestamp), "exact " + i);
+					Assert.AreEqual(i, reader.IndexOf(expected[i].Timestamp - 0.0005), "between " + i);
+				}
+
+				// starting in the middle wraps around when looping
+				var locations = reader.GetLocations(4998, true);
+				var timestamps = new List<double>();
+				for (int i = 0; i < 4 && locations.MoveNext(); i++) { timestamps.Add(locations.Current.Timestamp); }
+				Assert.AreEqual(new double[] { expected[4998].Timestamp, expected[4999].Timestamp, expected[0].Timestamp, expected[1].Timestamp }, timestamps.ToArray());
+			}
+		}
+
+		[Test]
+		public void OpenPicksReaderByFormat()
+		{
+			var trace = syntheticTrace(10);
+			using (var reader = LocationLogReader.Open(textLog(trace)))
+			{
+				Assert.IsInstanceOf<LocationLogReader>(reader);
+			}
+			using (var reader = LocationLogReader.Open(writeBinary(trace)))
+			{
+				Assert.IsInstanceOf<BinaryLocationLogReader>(reader);
+				var locations = reader.GetLocations();
+				for (int i = 0; i < 25; i++) { Assert.IsTrue(locations.MoveNext()); }
+				assertSameLocation(trace[4], locations.Current, "looped location");
+			}
+			Assert.Throws<FormatException>(() => new BinaryLocationLogReader(new byte[64]));
+		}
+
+		[Test]
+		public void BenchmarkMillionPoints()
+		{
+			const int count = 1000000;
+			var textPath = Path.Combine(Application.temporaryCachePath, "location-log-benchmark.txt");
+			var binaryPath = Path.Combine(Application.temporaryCachePath, "location-log-benchmark.bytes");
+			using (var writer = new StreamWriter(textPath, false, new UTF8Encoding(false)))
+			{
+				textLog(syntheticLocations(count), writer);
+			}
+
+			var sw = System.Diagnostics.Stopwatch.StartNew();
+			Assert.AreEqual(count, LocationLogConverter.TextToBinary(textPath, binaryPath));
+			long convertMs = sw.ElapsedMilliseconds;
+
+			// resident memory is what the reader holds on to while replaying, text logs are read into memory as a whole
+			long before = GC.GetTotalMemory(true);
+			sw = System.Diagnostics.Stopwatch.StartNew();
+			int textCount = 0;
+			long textResident;
+			using (var reader = new LocationLogReader(File.ReadAllBytes(textPath)))
+			{
+				var locations = reader.GetLocations(false);
+				while (locations.MoveNext()) { textCount++; }
+				textResident = GC.GetTotalMemory(true) - before;
+			}
+			long textMs = sw.ElapsedMilliseconds;
+
+			before = GC.GetTotalMemory(true);
+			sw = System.Diagnostics.Stopwatch.StartNew();
+			int binaryCount = 0;
+			long binaryResident;
+			double seekMs;
+			int seekIndex;
+			using (var reader = new BinaryLocationLogReader(binaryPath))
+			{
+				var locations = reader.GetLocations(false);
+				double lastTimestamp = 0;
+				while (locations.MoveNext())
+				{
+					binaryCount++;
+					lastTimestamp = locations.Current.Timestamp;
+				}
+				binaryResident = GC.GetTotalMemory(true) - before;
+
+				var seekSw = System.Diagnostics.Stopwatch.StartNew();
+				seekIndex = reader.IndexOf((reader[0].Timestamp + lastTimestamp) / 2);
+				seekMs = seekSw.Elapsed.TotalMilliseconds;
+			}
+			long binaryMs = sw.ElapsedMilliseconds;
+
+			Assert.AreEqual(count, textCount);
+			Assert.AreEqual(count, binaryCount);
+			Assert.Greater(seekIndex, 0);
+			Assert.Less(binaryResident, textResident);
+			Debug.Log(string.Format(
+				"[LocationLog] {0} points: text {1} bytes parsed in {2}ms ({3:0} points/s), {4} bytes resident; binary {5} bytes converted in {6}ms, decoded in {7}ms ({8:0} points/s), {9} bytes resident, seek by time {10:0.000}ms"
+				, count
+				, new FileInfo(textPath).Length
+				, textMs
+				, count * 1000d / Math.Max(textMs, 1)
+				, textResident
+				, new FileInfo(binaryPath).Length
+				, convertMs
+				, binaryMs
+				, count * 1000d / Math.Max(binaryMs, 1)
+				, binaryResident
+				, seekMs
+			));
+
+			File.Delete(textPath);
+			File.Delete(binaryPath);
+		}
+
+		private static void assertSameLocation(Location expected, Location actual, string message)
+		{
+			Assert.AreEqual(expected.IsLocationServiceEnabled, actual.IsLocationServiceEnabled, message);
+			Assert.AreEqual(expected.IsLocationServiceInitializing, actual.IsLocationServiceInitializing, message);
+			Assert.AreEqual(expected.IsLocationUpdated, actual.IsLocationUpdated, message);
+			Assert.AreEqual(expected.IsUserHeadingUpdated, actual.IsUserHeadingUpdated, message);
+			Assert.AreEqual(expected.Provider, actual.Provider, message);
+			Assert.AreEqual(expected.ProviderClass, actual.ProviderClass, message);
+			Assert.AreEqual(expected.Timestamp, actual.Timestamp, message);
+			Assert.AreEqual(expected.TimestampDevice, actual.TimestampDevice, message);
+			// parsing isn't guaranteed to round correctly, allow for the last bit
+			Assert.AreEqual(expected.LatitudeLongitude.x, actual.LatitudeLongitude.x, 1e-12, message);
+			Assert.AreEqual(expected.LatitudeLongitude.y, actual.LatitudeLongitude.y, 1e-12, message);
+			Assert.AreEqual(expected.Accuracy, actual.Accuracy, 1e-4f, message);
+			Assert.AreEqual(expected.UserHeading, actual.UserHeading, 1e-4f, message);
+			Assert.AreEqual(expected.DeviceOrientation, actual.DeviceOrientation, 1e-4f, message);
+			Assert.AreEqual(expected.SpeedMetersPerSecond.HasValue, actual.SpeedMetersPerSecond.HasValue, message);
+			if (expected.SpeedMetersPerSecond.HasValue)
+			{
+				Assert.AreEqual(expected.SpeedMetersPerSecond.Value, actual.SpeedMetersPerSecond.Value, 1e-4f, message);
+			}
+			Assert.AreEqual(expected.HasGpsFix, actual.HasGpsFix, message);
+			Assert.AreEqual(expected.SatellitesUsed, actual.SatellitesUsed, message);
+			Assert.AreEqual(expected.SatellitesInView, actual.SatellitesInView, message);
+		}
+
+		private static List<Location> syntheticTrace(int count)
+		{
+			return new List<Location>(syntheticLocations(count));
+		}
+
+		/// <summary>
+		/// A walk with one fix per second, values at the precision of text logs so they survive both formats unchanged.
+		/// </summary>
+		private static IEnumerable<Location> syntheticLocations(int count)
+		{
+			var random = new System.Random(42);
+			double lat = 60.1699;
+			double lng = 24.9384;
+			long milliseconds = 1500000000000;
+			for (int i = 0; i < count; i++)
+			{
+				lat += (random.Next(200) - 100) * 1e-7;
+				lng += (random.Next(200) - 100) * 1e-7;
+				milliseconds += 1000 + random.Next(100);
+				var location = new Location();
+				location.IsLocationServiceEnabled = true;
+				location.IsLocationServiceInitializing = i < 3;
+				location.IsLocationUpdated = random.Next(4) > 0;
+				location.IsUserHeadingUpdated = random.Next(2) > 0;
+				location.Provider = i % 7 == 0 ? "network" : "gps";
+				location.ProviderClass = "DeviceLocationProviderAndroidNative";
+				// through DateTime like the text log reader
+				location.Timestamp = UnixTimestampUtils.To(UnixTimestampUtils.FromMilliseconds(milliseconds));
+				location.TimestampDevice = UnixTimestampUtils.To(UnixTimestampUtils.FromMilliseconds(milliseconds + 200));
+				location.LatitudeLongitude = new Vector2d(Math.Round(lat, 8), Math.Round(lng, 8));
+				location.Accuracy = random.Next(5, 300) / 10f;
+				location.UserHeading = random.Next(3600) / 10f;
+				location.DeviceOrientation = random.Next(3600) / 10f;
+				if (i % 5 != 0) { location.SpeedMetersPerSecond = random.Next(200) / 10f / 3.6f; }
+				if (i % 3 != 0) { location.HasGpsFix = i % 2 == 0; }
+				if (i % 4 != 0)
+				{
+					location.SatellitesUsed = random.Next(12);
+					location.SatellitesInView = random.Next(12, 30);
+				}
+				yield return location;
+			}
+		}
+
+		private static byte[] writeBinary(List<Location> locations)
+		{
+			var output = new MemoryStream();
+			using (var writer = new BinaryLocationLogWriter(output))
+			{
+				foreach (var location in locations) { writer.Write(location); }
+			}
+			return output.ToArray();
+		}
+
+		private static byte[] textLog(IEnumerable<Location> locations)
+		{
+			var writer = new StringWriter(CultureInfo.InvariantCulture);
+			textLog(locations, writer);
+			return Encoding.UTF8.GetBytes(writer.ToString());
+		}
+
+		/// <summary>
+		/// Text log in the format of <see cref="LocationLogWriter"/>, which needs a running location provider to write one.
+		/// </summary>
+		private static void textLog(IEnumerable<Location> locations, TextWriter writer)
+		{
+			var culture = CultureInfo.InvariantCulture;
+			const string notSupported = "[not supported by provider]";
+			writer.WriteLine("#synthetic trace");
+			foreach (var l in locations)
+			{
+				writer.WriteLine(string.Join(";", new string[]
+				{
+					l.IsLocationServiceEnabled.ToString(),
+					l.IsLocationServiceInitializing.ToString(),
+					l.IsLocationUpdated.ToString(),
+					l.IsUserHeadingUpdated.ToString(),
+					l.Provider,
+					l.ProviderClass,
+					UnixTimestampUtils.From(l.TimestampDevice).ToString("yyyyMMdd-HHmmss.fff", culture),
+					UnixTimestampUtils.From(l.Timestamp).ToString("yyyyMMdd-HHmmss.fff", culture),
+					string.Format(culture, "{0:0.00000000}", l.LatitudeLongitude.x),
+					string.Format(culture, "{0:0.00000000}", l.LatitudeLongitude.y),
+					string.Format(culture, "{0:0.0}", l.Accuracy),
+					string.Format(culture, "{0:0.0}", l.UserHeading),
+					string.Format(culture, "{0:0.0}", l.DeviceOrientation),
+					l.SpeedKmPerHour.HasValue ? string.Format(culture, "{0:0.0}", l.SpeedKmPerHour.Value) : notSupported,
+					l.HasGpsFix.HasValue ? l.HasGpsFix.Value.ToString() : notSupported,
+					l.SatellitesUsed.HasValue ? l.SatellitesUsed.Value.ToString(culture) : notSupported,
+					l.SatellitesInView.HasValue ? l.SatellitesInView.Value.ToString(culture) : notSupported
+				}));
+			}
+		}
+	}
+}
@@ -0,0 +1,398 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.Unity.MeshGeneration.Modifiers;
+	using NUnit.Framework;
+	using UnityEngine;
+	using UnityEngine.Rendering;
+
+	[TestFixture]
+	internal class MergedMeshTests
+	{
+		//dense downtown tile: a few thousand extruded buildings with ~10 corners each, ~150k vertices
+		private const int BUILDINGS_PER_TILE = 3000;
+		private const int CORNERS = 10;
+
+		private List<GameObject> _gameObjects = new List<GameObject>();
+		private List<MergedModifierStack> _stacks = new List<MergedModifierStack>();
+
+		[TearDown]
+		public void TearDown()
+		{
+			foreach (var stack in _stacks)
+			{
+				stack.Clear();
+				UnityEngine.Object.DestroyImmediate(stack);
+			}
+			_stacks.Clear();
+			foreach (var go in _gameObjects)
+			{
+				UnityEngine.Object.DestroyImmediate(go);
+			}
+			_gameObjects.Clear();
+		}
+
+		[Test]
+		public void AppendOffsetsIndices()
+		{
+			var buffer = new MergedMeshBuffer();
+			var md = new MeshData();
+			Fill(md);
+			int vertices = md.Vertices.Count;
+
+			Assert.IsTrue(buffer.Append(md));
+			Assert.IsTrue(buffer.Append(md));
+
+			Assert.AreEqual(vertices * 2, buffer.VertexCount);
+			Assert.AreEqual(2, buffer.SubmeshCount);
+			for (int s = 0; s < md.Triangles.Count; s++)
+			{
+				var triangles = buffer.GetTriangles(s);
+				int count = md.Triangles[s].Count;
+				Assert.AreEqual(count * 2, triangles.Count);
+				for (int i = 0; i < count; i++)
+				{
+					Assert.AreEqual(md.Triangles[s][i], triangles[i]);
+					Assert.AreEqual(md.Triangles[s][i] + vertices, triangles[count + i], "second feature was not offset");
+				}
+			}
+			Assert.AreEqual(buffer.IndexCount * 4L + vertices * 2 * (12 + 12 + 8), buffer.BytesCopied);
+		}
+
+		[Test]
+		public void SkipsDegenerateAndPadsMissingAttributes()
+		{
+			var buffer = new MergedMeshBuffer();
+			var point = new MeshData();
+			point.Vertices.Add(Vector3.zero);
+			Assert.IsFalse(buffer.Append(point), "features with up to three vertices are skipped");
+
+			// no normals or uvs, then a feature with two uv channels
+			var bare = new MeshData();
+			bare.UV.Clear();
+			var quad = bare.AddSubmesh();
+			for (int i = 0; i < 4; i++)
+			{
+				bare.Vertices.Add(new Vector3(i, 0, 0));
+				quad.Add(i);
+			}
+			var md = new MeshData();
+			Fill(md);
+			md.UV.Add(new List<Vector2>(md.UV[0]));
+
+			buffer.Append(bare);
+			buffer.Append(md);
+
+			Assert.AreEqual(2, buffer.UvChannelCount);
+			Assert.AreEqual(buffer.VertexCount, buffer.Normals.Count);
+			Assert.AreEqual(buffer.VertexCount, buffer.GetUV(0).Count);
+			Assert.AreEqual(buffer.VertexCount, buffer.GetUV(1).Count);
+			Assert.AreEqual(Vector3.zero, buffer.Normals[0]);
+			Assert.AreEqual(md.UV[1][1], buffer.GetUV(1)[4 + 1]);
+		}
+
+		[Test]
+		public void ClearKeepsCapacity()
+		{
+			var buffer = new MergedMeshBuffer();
+			var md = new MeshData();
+			Fill(md);
+			buffer.Append(md);
+			var capacity = buffer.Vertices.Capacity;
+			var triangles = buffer.GetTriangles(0);
+
+			buffer.Clear();
+			Assert.AreEqual(0, buffer.VertexCount);
+			Assert.AreEqual(0, buffer.SubmeshCount);
+			Assert.AreEqual(0, buffer.BytesCopied);
+			Assert.AreEqual(capacity, buffer.Vertices.Capacity);
+
+			buffer.Append(md);
+			Assert.AreSame(triangles, buffer.GetTriangles(0), "triangle list was not reused");
+		}
+
+		[Test]
+		public void LargeTileUploadsWith32BitIndices()
+		{
+			var buffer = new MergedMeshBuffer();
+			var md = new MeshData();
+			Fill(md);
+			for (int b = 0; b < BUILDINGS_PER_TILE; b++)
+			{
+				buffer.Append(md);
+			}
+			Assert.Greater(buffer.VertexCount, ushort.MaxValue);
+
+			var mesh = new Mesh();
+			try
+			{
+				buffer.Upload(mesh);
+				Assert.AreEqual(IndexFormat.UInt32, mesh.indexFormat);
+				Assert.AreEqual(buffer.VertexCount, mesh.vertexCount);
+				Assert.AreEqual(buffer.GetTriangles(1).Count, mesh.GetTriangles(1).Length);
+
+				buffer.Clear();
+				buffer.Append(md);
+				buffer.Upload(mesh);
+				Assert.AreEqual(IndexFormat.UInt16, mesh.indexFormat, "small tiles should keep 16 bit indices");
+			}
+			finally
+			{
+				UnityEngine.Object.DestroyImmediate(mesh);
+			}
+		}
+
+		[Test]
+		public void StackSplitsOnlyWith16BitIndices()
+		{
+			var tile = CreateTile();
+			var stack = CreateStack(true);
+			BuildTile(stack, tile);
+			Assert.AreEqual(1, CountMeshes(tile), "32 bit indices should merge the tile into one mesh");
+
+			stack.UnregisterTile(tile);
+			stack.Use32BitIndices = false;
+			BuildTile(stack, tile);
+			var meshes = CountMeshes(tile);
+			Assert.AreEqual(3, meshes);
+			int vertices = 0;
+			foreach (var filter in tile.GetComponentsInChildren<MeshFilter>())
+			{
+				Assert.Less(filter.sharedMesh.vertexCount, MergedMeshBuffer.MAX_16BIT_VERTICES);
+				vertices += filter.sharedMesh.vertexCount;
+			}
+			Assert.AreEqual(BUILDINGS_PER_TILE * CORNERS * 5, vertices, "features were dropped when the mesh was split");
+		}
+
+		[Test]
+		public void StackRestoresCachedTile()
+		{
+			var tile = CreateTile();
+			var stack = CreateStack(true);
+			var source = new object();
+			var key = new MergedMeshKey(source, "building", 1, tile);
+
+			Assert.IsFalse(stack.TryRestore(tile, key, source));
+			stack.CacheAs(tile, key, source);
+			BuildTile(stack, tile);
+			var vertices = tile.GetComponentInChildren<MeshFilter>().sharedMesh.vertexCount;
+			Assert.AreEqual(vertices, stack.CachedVertexCount);
+
+			stack.UnregisterTile(tile);
+			Assert.AreEqual(0, CountMeshes(tile));
+			Assert.IsTrue(stack.TryRestore(tile, key, source));
+			Assert.AreEqual(1, CountMeshes(tile));
+			Assert.AreEqual(vertices, tile.GetComponentInChildren<MeshFilter>().sharedMesh.vertexCount);
+
+			stack.UnregisterTile(tile);
+			Assert.IsFalse(stack.TryRestore(tile, new MergedMeshKey(source, "building", 2, tile), source), "other style hit the cache");
+			Assert.IsFalse(stack.TryRestore(tile, key, new object()), "other tile data hit the cache");
+		}
+
+		[Test]
+		public void CacheEvictsLeastRecentlyUsed()
+		{
+			var released = new List<MergedMeshBuffer>();
+			var cache = new MergedMeshCache(250, released.Add);
+			var source = new object();
+			var a = Key("a");
+			var b = Key("b");
+			var c = Key("c");
+
+			cache.Add(a, source, Buffers(100));
+			cache.Add(b, source, Buffers(100));
+			Assert.IsNotNull(cache.Get(a, source));
+			cache.Add(c, source, Buffers(100));
+
+			Assert.IsNull(cache.Get(b, source), "least recently used entry was kept");
+			Assert.IsNotNull(cache.Get(a, source));
+			Assert.IsNotNull(cache.Get(c, source));
+			Assert.AreEqual(1, released.Count);
+			Assert.AreEqual(200, cache.VertexCount);
+
+			cache.Add(Key("d"), source, Buffers(300));
+			Assert.AreEqual(2, released.Count, "entry over the budget should be released right away");
+			Assert.AreEqual(2, cache.Count);
+
+			cache.Clear();
+			Assert.AreEqual(4, released.Count);
+			Assert.AreEqual(0, cache.VertexCount);
+		}
+
+		[Test]
+		public void BenchmarkDenseDowntownTile()
+		{
+			var tile = CreateTile();
+			var stack16 = CreateStack(false);
+			var stack32 = CreateStack(true);
+			var source = new object();
+			var key = new MergedMeshKey(source, "building", 1, tile);
+
+			// warm up pools and the upload path
+			BuildTile(stack16, tile);
+			stack16.UnregisterTile(tile);
+			BuildTile(stack32, tile);
+			stack32.UnregisterTile(tile);
+
+			var watch16 = System.Diagnostics.Stopwatch.StartNew();
+			BuildTile(stack16, tile);
+			watch16.Stop();
+			var drawCalls16 = CountDrawCalls(tile);
+			stack16.UnregisterTile(tile);
+
+			stack32.CacheAs(tile, key, source);
+			var watch32 = System.Diagnostics.Stopwatch.StartNew();
+			BuildTile(stack32, tile);
+			watch32.Stop();
+			var drawCalls32 = CountDrawCalls(tile);
+			stack32.UnregisterTile(tile);
+
+			var restoreWatch = System.Diagnostics.Stopwatch.StartNew();
+			Assert.IsTrue(stack32.TryRestore(tile, key, source));
+			restoreWatch.Stop();
+			Assert.AreEqual(drawCalls32, CountDrawCalls(tile));
+			Assert.Less(drawCalls32, drawCalls16);
+
+			// managed bytes the merge copies per tile, restoring copies none
+			var buffer = new MergedMeshBuffer();
+			var md = new MeshData();
+			Fill(md);
+			for (int b = 0; b < BUILDINGS_PER_TILE; b++)
+			{
+				buffer.Append(md);
+			}
+
+			Debug.Log(string.Format(
+				"[MergedMesh] {0} buildings, {1} vertices: 16 bit {2} draw calls {3:0.0}ms, 32 bit {4} draw calls {5:0.0}ms, cached {6:0.0}ms, {7}KB copied per tile"
+				, BUILDINGS_PER_TILE
+				, buffer.VertexCount
+				, drawCalls16
+				, watch16.Elapsed.TotalMilliseconds
+				, drawCalls32
+				, watch32.Elapsed.TotalMilliseconds
+				, restoreWatch.Elapsed.TotalMilliseconds
+				, buffer.BytesCopied / 1024
+			));
+		}
+
+		#region helper methods
+
+		/// <summary>
+		/// Runs the features of a dense tile through the stack the way VectorLayerVisualizer does.
+		/// </summary>
+		private static void BuildTile(MergedModifierStack stack, UnityTile tile)
+		{
+			var arena = new MeshDataArena();
+			for (int b = 0; b < BUILDINGS_PER_TILE; b++)
+			{
+				var md = arena.Rent(tile);
+				Fill(md);
+				stack.Execute(tile, null, md, tile.gameObject, "building");
+				md.Release();
+			}
+			stack.End(tile, tile.gameObject, "building");
+		}
+
+		private static int CountMeshes(UnityTile tile)
+		{
+			int count = 0;
+			foreach (var filter in tile.GetComponentsInChildren<MeshFilter>())
+			{
+				if (filter.gameObject.activeSelf)
+				{
+					count++;
+				}
+			}
+			return count;
+		}
+
+		private static int CountDrawCalls(UnityTile tile)
+		{
+			int count = 0;
+			foreach (var filter in tile.GetComponentsInChildren<MeshFilter>())
+			{
+				count += filter.sharedMesh.subMeshCount;
+			}
+			return count;
+		}
+
+		private static MergedMeshKey Key(string layer)
+		{
+			return new MergedMeshKey(0, layer, 0, 1, 0);
+		}
+
+		private static List<MergedMeshBuffer> Buffers(int vertices)
+		{
+			var buffer = new MergedMeshBuffer();
+			for (int i = 0; i < vertices; i++)
+			{
+				buffer.Vertices.Add(Vector3.zero);
+			}
+			return new List<MergedMeshBuffer>() { buffer };
+		}
+
+		/// <summary>
+		/// Roughly what PolygonMeshModifier and HeightModifier produce for an extruded building, 5 vertices per corner.
+		/// </summary>
+		private static void Fill(MeshData md)
+		{
+			var roof = md.AddSubmesh((CORNERS - 2) * 3);
+			for (int i = 0; i < CORNERS; i++)
+			{
+				var angle = i * Mathf.PI * 2 / CORNERS;
+				md.Vertices.Add(new Vector3(Mathf.Cos(angle), 10, Mathf.Sin(angle)));
+				md.Normals.Add(Vector3.up);
+				md.UV[0].Add(new Vector2(i, 0));
+			}
+			for (int i = 1; i < CORNERS - 1; i++)
+			{
+				roof.Add(0);
+				roof.Add(i);
+				roof.Add(i + 1);
+			}
+
+			var walls = md.AddSubmesh(CORNERS * 6);
+			for (int i = 0; i < CORNERS; i++)
+			{
+				var v1 = md.Vertices[i];
+				var v2 = md.Vertices[(i + 1) % CORNERS];
+				var ind = md.Vertices.Count;
+				md.Vertices.Add(v1);
+				md.Vertices.Add(v2);
+				md.Vertices.Add(new Vector3(v1.x, 0, v1.z));
+				md.Vertices.Add(new Vector3(v2.x, 0, v2.z));
+				for (int j = 0; j < 4; j++)
+				{
+					md.Normals.Add(Vector3.right);
+					md.UV[0].Add(Vector2.zero);
+				}
+				walls.Add(ind);
+				walls.Add(ind + 1);
+				walls.Add(ind + 2);
+				walls.Add(ind + 1);
+				walls.Add(ind + 3);
+				walls.Add(ind + 2);
+			}
+		}
+
+		private MergedModifierStack CreateStack(bool use32BitIndices)
+		{
+			var stack = ScriptableObject.CreateInstance<MergedModifierStack>();
+			stack.Use32BitIndices = use32BitIndices;
+			stack.Initialize();
+			_stacks.Add(stack);
+			return stack;
+		}
+
+		private UnityTile CreateTile()
+		{
+			var go = new GameObject("tile");
+			_gameObjects.Add(go);
+			return go.AddComponent<UnityTile>();
+		}
+
+		#endregion
+	}
+}
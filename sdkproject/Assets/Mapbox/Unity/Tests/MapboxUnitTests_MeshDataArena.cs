@@ -0,0 +1,253 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class MeshDataArenaTests
+	{
+		//dense downtown tile: a few thousand extruded buildings with ~10 corners each
+		private const int BUILDINGS_PER_TILE = 3000;
+		private const int CORNERS = 10;
+
+		private List<GameObject> _gameObjects = new List<GameObject>();
+
+		[TearDown]
+		public void TearDown()
+		{
+			foreach (var go in _gameObjects)
+			{
+				UnityEngine.Object.DestroyImmediate(go);
+			}
+			_gameObjects.Clear();
+		}
+
+		[Test]
+		public void ReusesReleasedInstances()
+		{
+			var arena = new MeshDataArena();
+			var tile = CreateTile();
+
+			var first = arena.Rent(tile);
+			Fill(first);
+			var capacity = first.Vertices.Capacity;
+			first.Release();
+
+			var second = arena.Rent(tile);
+			Assert.AreSame(first, second, "released instance was not reused");
+			Assert.AreEqual(0, second.Vertices.Count);
+			Assert.AreEqual(0, second.Triangles.Count);
+			Assert.AreEqual(1, second.UV.Count);
+			Assert.AreEqual(0, second.UV[0].Count);
+			Assert.AreEqual(capacity, second.Vertices.Capacity, "capacity was not kept");
+			arena.ReleaseTile(tile);
+		}
+
+		[Test]
+		public void ReleaseTileReturnsOnlyItsInstances()
+		{
+			var arena = new MeshDataArena();
+			var tileA = CreateTile();
+			var tileB = CreateTile();
+
+			var a = arena.Rent(tileA);
+			var b = arena.Rent(tileB);
+			arena.ReleaseTile(tileA);
+
+			Assert.IsFalse(a.IsRented);
+			Assert.IsTrue(b.IsRented, "instance of another tile was released");
+
+			// released twice is ignored
+			var pooled = MeshDataArena.Pooled;
+			a.Release();
+			arena.ReleaseTile(tileA);
+			Assert.AreEqual(pooled, MeshDataArena.Pooled);
+			arena.ReleaseTile(tileB);
+		}
+
+		[Test]
+		public void EarlyReleasedInstanceRentedByOtherTileSurvivesTileRelease()
+		{
+			var arena = new MeshDataArena();
+			var tileA = CreateTile();
+			var tileB = CreateTile();
+
+			var md = arena.Rent(tileA);
+			md.Release();
+			var again = arena.Rent(tileB);
+			Assert.AreSame(md, again);
+
+			arena.ReleaseTile(tileA);
+			Assert.IsTrue(again.IsRented, "instance now owned by another tile was released");
+			arena.ReleaseTile(tileB);
+		}
+
+		[Test]
+		public void ReleasedInstancesLeaveTheTile()
+		{
+			var arena = new MeshDataArena();
+			var tile = CreateTile();
+
+			var kept = arena.Rent(tile);
+			for (int i = 0; i < 100; i++)
+			{
+				arena.Rent(tile).Release();
+			}
+			Assert.AreEqual(1, arena.RentedCount(tile), "released instances are still tracked for the tile");
+
+			kept.Release();
+			Assert.AreEqual(0, arena.RentedCount(tile));
+			arena.ReleaseTile(tile);
+		}
+
+		[Test]
+		public void SubmeshListsAreReused()
+		{
+			var arena = new MeshDataArena();
+			var tile = CreateTile();
+
+			var md = arena.Rent(tile);
+			var triangles = md.AddSubmesh(600);
+			triangles.Add(0);
+			md.Release();
+
+			md = arena.Rent(tile);
+			Assert.AreSame(triangles, md.AddSubmesh(), "triangle list was not reused");
+			Assert.AreEqual(0, triangles.Count);
+			arena.ReleaseTile(tile);
+		}
+
+		[Test]
+		public void ReserveNeverShrinks()
+		{
+			var list = new List<int>(1000);
+			MeshData.Reserve(list, 10);
+			Assert.AreEqual(1000, list.Capacity);
+
+			list.AddRange(new int[1000]);
+			MeshData.Reserve(list, 1);
+			Assert.GreaterOrEqual(list.Capacity, 2000, "capacity should double, not grow by one");
+		}
+
+		[Test]
+		public void BenchmarkDenseDowntownTile()
+		{
+			var arena = new MeshDataArena();
+			var tiles = new UnityTile[4];
+			for (int i = 0; i < tiles.Length; i++)
+			{
+				tiles[i] = CreateTile();
+			}
+
+			// warm up, the first tile fills the pool
+			BuildTile(arena, tiles[0]);
+			arena.ReleaseTile(tiles[0]);
+
+			GC.Collect();
+			var created = MeshDataArena.Created;
+			var before = GC.GetTotalMemory(false);
+			var watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 1; i < tiles.Length; i++)
+			{
+				BuildTile(arena, tiles[i]);
+				arena.ReleaseTile(tiles[i]);
+			}
+			watch.Stop();
+			var pooledBytes = GC.GetTotalMemory(false) - before;
+			Assert.AreEqual(created, MeshDataArena.Created, "warm pool should not create new mesh data");
+
+			GC.Collect();
+			before = GC.GetTotalMemory(false);
+			var newWatch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 1; i < tiles.Length; i++)
+			{
+				for (int b = 0; b < BUILDINGS_PER_TILE; b++)
+				{
+					Fill(new MeshData());
+				}
+			}
+			newWatch.Stop();
+			var newBytes = GC.GetTotalMemory(false) - before;
+
+			Debug.Log(string.Format(
+				"[MeshDataArena] {0} tiles x {1} buildings: pooled {2:0.0}ms {3}KB, new MeshData {4:0.0}ms {5}KB"
+				, tiles.Length - 1
+				, BUILDINGS_PER_TILE
+				, watch.Elapsed.TotalMilliseconds
+				, pooledBytes / 1024
+				, newWatch.Elapsed.TotalMilliseconds
+				, newBytes / 1024
+			));
+		}
+
+		private void BuildTile(MeshDataArena arena, UnityTile tile)
+		{
+			for (int b = 0; b < BUILDINGS_PER_TILE; b++)
+			{
+				var md = arena.Rent(tile);
+				Fill(md);
+				md.Release();
+			}
+		}
+
+		/// <summary>
+		/// Roughly what PolygonMeshModifier and HeightModifier produce for an extruded building.
+		/// </summary>
+		private static void Fill(MeshData md)
+		{
+			var roof = md.AddSubmesh((CORNERS - 2) * 3);
+			for (int i = 0; i < CORNERS; i++)
+			{
+				var angle = i * Mathf.PI * 2 / CORNERS;
+				md.Vertices.Add(new Vector3(Mathf.Cos(angle), 10, Mathf.Sin(angle)));
+				md.Normals.Add(Vector3.up);
+				md.Tangents.Add(Vector3.forward);
+				md.UV[0].Add(new Vector2(i, 0));
+				md.Edges.Add((i + 1) % CORNERS);
+				md.Edges.Add(i);
+			}
+			for (int i = 1; i < CORNERS - 1; i++)
+			{
+				roof.Add(0);
+				roof.Add(i);
+				roof.Add(i + 1);
+			}
+
+			var walls = md.AddSubmesh(CORNERS * 6);
+			MeshData.Reserve(md.Vertices, CORNERS * 4);
+			MeshData.Reserve(md.Normals, CORNERS * 4);
+			for (int i = 0; i < md.Edges.Count; i += 2)
+			{
+				var v1 = md.Vertices[md.Edges[i]];
+				var v2 = md.Vertices[md.Edges[i + 1]];
+				var ind = md.Vertices.Count;
+				md.Vertices.Add(v1);
+				md.Vertices.Add(v2);
+				md.Vertices.Add(new Vector3(v1.x, 0, v1.z));
+				md.Vertices.Add(new Vector3(v2.x, 0, v2.z));
+				for (int j = 0; j < 4; j++)
+				{
+					md.Normals.Add(Vector3.right);
+					md.Tangents.Add(Vector3.forward);
+					md.UV[0].Add(Vector2.zero);
+				}
+				walls.Add(ind);
+				walls.Add(ind + 1);
+				walls.Add(ind + 2);
+				walls.Add(ind + 1);
+				walls.Add(ind + 3);
+				walls.Add(ind + 2);
+			}
+		}
+
+		private UnityTile CreateTile()
+		{
+			var go = new GameObject("tile");
+			_gameObjects.Add(go);
+			return go.AddComponent<UnityTile>();
+		}
+	}
+}
@@ -0,0 +1,374 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.Threading;
+	using KDTree;
+	using Mapbox.Map;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class SpatialIndexTests
+	{
+		private const int TILES_PER_SIDE = 4;
+		private const float TILE_SIZE = 100f;
+
+		private System.Random _random;
+		private FeatureSpatialIndex<int> _index;
+		private List<Bounds> _bounds;
+		private volatile bool _stopWorkers;
+
+		[SetUp]
+		public void SetUp()
+		{
+			_random = new System.Random(42);
+			_index = new FeatureSpatialIndex<int>();
+			_bounds = new List<Bounds>();
+		}
+
+		[Test]
+		public void RadiusMatchesBruteForce()
+		{
+			addBuildings(50);
+
+			for (int q = 0; q < 200; q++)
+			{
+				Vector3 center = randomPoint();
+				float radius = (float)_random.NextDouble() * 40f;
+				List<int> results = new List<int>();
+				_index.Radius(center, radius, results);
+
+				HashSet<int> found = new HashSet<int>(results);
+				Assert.AreEqual(results.Count, found.Count, "item returned twice");
+				for (int i = 0; i < _bounds.Count; i++)
+				{
+					float distance = Mathf.Sqrt(sqrDistanceXZ(_bounds[i], center));
+					if (Mathf.Abs(distance - radius) < 1e-3f) { continue; }
+					Assert.AreEqual(distance < radius, found.Contains(i), "item {0} at {1} of radius {2}", i, distance, radius);
+				}
+			}
+		}
+
+		[Test]
+		public void NearestReturnsClosestFirst()
+		{
+			addBuildings(50);
+
+			for (int q = 0; q < 100; q++)
+			{
+				Vector3 point = randomPoint();
+				List<int> results = new List<int>();
+				Assert.AreEqual(10, _index.Nearest(point, 10, -1f, results));
+
+				List<float> distances = new List<float>();
+				for (int i = 0; i < _bounds.Count; i++)
+				{
+					distances.Add(sqrDistanceXZ(_bounds[i], point));
+				}
+				distances.Sort();
+				for (int k = 0; k < results.Count; k++)
+				{
+					Assert.AreEqual(distances[k], sqrDistanceXZ(_bounds[results[k]], point), 1e-3f, "neighbour {0} out of order", k);
+				}
+			}
+
+			List<int> limited = new List<int>();
+			_index.Nearest(new Vector3(-1000f, 0f, -1000f), 10, 50f, limited);
+			Assert.AreEqual(0, limited.Count, "neighbours beyond max distance returned");
+		}
+
+		[Test]
+		public void IntersectingMatchesBruteForce()
+		{
+			addBuildings(50);
+
+			for (int q = 0; q < 200; q++)
+			{
+				Bounds box = new Bounds(randomPoint(), new Vector3(30f, 10f, 30f) * (float)_random.NextDouble());
+				List<int> results = new List<int>();
+				_index.Intersecting(box, results);
+
+				HashSet<int> found = new HashSet<int>(results);
+				for (int i = 0; i < _bounds.Count; i++)
+				{
+					Assert.AreEqual(box.Intersects(_bounds[i]), found.Contains(i), "item {0}", i);
+				}
+			}
+		}
+
+		[Test]
+		public void RaycastHitsClosestBox()
+		{
+			addBuildings(50);
+
+			int hits = 0;
+			for (int q = 0; q < 200; q++)
+			{
+				Vector3 origin = randomPoint() + Vector3.up * 100f;
+				Ray ray = new Ray(origin, randomPoint() - origin);
+
+				float closest = float.PositiveInfinity;
+				for (int i = 0; i < _bounds.Count; i++)
+				{
+					float distance;
+					if (_bounds[i].IntersectRay(ray, out distance)) { closest = Mathf.Min(closest, distance); }
+				}
+
+				int item;
+				float hitDistance;
+				bool hit = _index.Raycast(ray, 1000f, out item, out hitDistance);
+				Assert.AreEqual(!float.IsPositiveInfinity(closest), hit, "ray {0}", q);
+				if (hit)
+				{
+					hits++;
+					Assert.AreEqual(closest, hitDistance, 1e-2f, "ray {0} did not return the closest box", q);
+
+					List<int> all = new List<int>();
+					_index.RaycastAll(ray, 1000f, all);
+					Assert.IsTrue(all.Contains(item), "closest hit missing from all hits");
+				}
+			}
+			Assert.Greater(hits, 0, "no ray hit anything, test data is off");
+		}
+
+		[Test]
+		public void TilesAreAddedAndRemovedWhole()
+		{
+			addBuildings(20);
+			Assert.AreEqual(TILES_PER_SIDE * TILES_PER_SIDE, _index.TileCount);
+			Assert.AreEqual(20 * TILES_PER_SIDE * TILES_PER_SIDE, _index.Count);
+
+			Assert.IsTrue(_index.Remove(tileId(0, 0)));
+			Assert.IsFalse(_index.Remove(tileId(0, 0)), "tile removed twice");
+			Assert.AreEqual(20 * (TILES_PER_SIDE * TILES_PER_SIDE - 1), _index.Count);
+
+			// buildings of neighbour tiles reach up to 6m into the removed tile
+			List<int> results = new List<int>();
+			_index.Intersecting(new Bounds(new Vector3(TILE_SIZE / 2f, 0f, TILE_SIZE / 2f), new Vector3(TILE_SIZE, 100f, TILE_SIZE) * 0.8f), results);
+			Assert.AreEqual(0, results.Count, "items of a removed tile returned");
+
+			// a tile that changes after it was indexed is rebuilt with its old and new items
+			_index.Add(tileId(1, 1), new Bounds(new Vector3(150f, 0f, 150f), Vector3.one), -1);
+			results.Clear();
+			_index.Radius(new Vector3(150f, 0f, 150f), 0.1f, results);
+			Assert.IsTrue(results.Contains(-1), "item added to an indexed tile not found");
+			Assert.AreEqual(20 * (TILES_PER_SIDE * TILES_PER_SIDE - 1) + 1, _index.Count);
+
+			_index.Clear();
+			results.Clear();
+			Assert.AreEqual(0, _index.Radius(new Vector3(150f, 0f, 150f), 1000f, results));
+		}
+
+		[Test]
+		public void SmallTrees()
+		{
+			PackedRTree<int> empty = new PackedRTree<int>(new List<Bounds>(), new List<int>());
+			List<int> results = new List<int>();
+			Assert.AreEqual(0, empty.Radius(Vector3.zero, 10f, results));
+			Assert.AreEqual(0, empty.RaycastAll(new Ray(Vector3.up, Vector3.down), 10f, results));
+
+			for (int count = 1; count <= 40; count++)
+			{
+				List<Bounds> bounds = new List<Bounds>();
+				List<int> items = new List<int>();
+				for (int i = 0; i < count; i++)
+				{
+					bounds.Add(new Bounds(new Vector3(i, 0f, 0f), Vector3.one * 0.5f));
+					items.Add(i);
+				}
+				PackedRTree<int> tree = new PackedRTree<int>(bounds, items, 4);
+				results.Clear();
+				Assert.AreEqual(count, tree.Radius(new Vector3(count / 2f, 0f, 0f), count, results), "{0} items", count);
+			}
+		}
+
+		[Test]
+		public void QueriesWhileTilesChange()
+		{
+			addBuildings(50);
+			Exception failure = null;
+			_stopWorkers = false;
+
+			Thread[] workers = new Thread[2];
+			for (int w = 0; w < workers.Length; w++)
+			{
+				int seed = w;
+				workers[w] = new Thread(() =>
+				{
+					try
+					{
+						System.Random random = new System.Random(seed);
+						List<int> results = new List<int>();
+						while (!_stopWorkers)
+						{
+							results.Clear();
+							Vector3 point = new Vector3((float)random.NextDouble() * 400f, 0f, (float)random.NextDouble() * 400f);
+							_index.Radius(point, 30f, results);
+							_index.Nearest(point, 5, -1f, results);
+						}
+					}
+					catch (Exception ex)
+					{
+						failure = ex;
+					}
+				});
+				workers[w].Start();
+			}
+
+			for (int i = 0; i < 200; i++)
+			{
+				UnwrappedTileId tile = tileId(i % TILES_PER_SIDE, (i / TILES_PER_SIDE) % TILES_PER_SIDE);
+				_index.Remove(tile);
+				addTile(tile, 50);
+			}
+			_stopWorkers = true;
+			foreach (Thread worker in workers) { worker.Join(); }
+
+			Assert.IsNull(failure, "query failed while tiles changed: {0}", failure);
+		}
+
+		/// <summary>
+		/// Points of features over 16 tiles, thousands of proximity queries as in a frame of gameplay, against
+		/// <see cref="KDTree{T}"/> as used by 'KdTreeCollection'.
+		/// </summary>
+		[Test]
+		public void BenchmarkAgainstKDTree()
+		{
+			const int perTile = 1500;
+			const int queries = 5000;
+			const float radius = 25f;
+
+			List<Vector3> points = new List<Vector3>();
+			for (int i = 0; i < queries; i++) { points.Add(randomPoint()); }
+
+			Stopwatch sw = Stopwatch.StartNew();
+			KDTree<int> kdTree = new KDTree<int>(2);
+			List<Vector3> positions = new List<Vector3>();
+			for (int x = 0; x < TILES_PER_SIDE; x++)
+			{
+				for (int y = 0; y < TILES_PER_SIDE; y++)
+				{
+					for (int i = 0; i < perTile; i++)
+					{
+						Vector3 position = new Vector3((x + (float)_random.NextDouble()) * TILE_SIZE, 0f, (y + (float)_random.NextDouble()) * TILE_SIZE);
+						positions.Add(position);
+						kdTree.AddPoint(new double[] { position.x, position.z }, positions.Count - 1);
+					}
+				}
+			}
+			double kdBuild = sw.Elapsed.TotalMilliseconds;
+
+			sw = Stopwatch.StartNew();
+			long kdRadiusHits = 0;
+			foreach (Vector3 point in points)
+			{
+				NearestNeighbour<int> iterator = kdTree.NearestNeighbors(new double[] { point.x, point.z }, perTile, radius * radius);
+				while (iterator.MoveNext()) { kdRadiusHits++; }
+			}
+			double kdRadius = sw.Elapsed.TotalMilliseconds;
+
+			sw = Stopwatch.StartNew();
+			foreach (Vector3 point in points)
+			{
+				NearestNeighbour<int> iterator = kdTree.NearestNeighbors(new double[] { point.x, point.z }, 10);
+				while (iterator.MoveNext()) { }
+			}
+			double kdNearest = sw.Elapsed.TotalMilliseconds;
+
+			sw = Stopwatch.StartNew();
+			for (int tile = 0; tile < TILES_PER_SIDE * TILES_PER_SIDE; tile++)
+			{
+				List<Bounds> bounds = new List<Bounds>(perTile);
+				List<int> items = new List<int>(perTile);
+				for (int i = tile * perTile; i < (tile + 1) * perTile; i++)
+				{
+					bounds.Add(new Bounds(positions[i], Vector3.zero));
+					items.Add(i);
+				}
+				_index.Add(tileId(tile / TILES_PER_SIDE, tile % TILES_PER_SIDE), bounds, items);
+			}
+			_index.Build();
+			double indexBuild = sw.Elapsed.TotalMilliseconds;
+
+			List<List<int>> results = new List<List<int>>();
+			for (int i = 0; i < queries; i++) { results.Add(new List<int>()); }
+
+			sw = Stopwatch.StartNew();
+			_index.Radius(points, radius, results);
+			double indexRadius = sw.Elapsed.TotalMilliseconds;
+			long indexRadiusHits = 0;
+			foreach (List<int> result in results)
+			{
+				indexRadiusHits += result.Count;
+				result.Clear();
+			}
+
+			sw = Stopwatch.StartNew();
+			_index.Nearest(points, 10, -1f, results);
+			double indexNearest = sw.Elapsed.TotalMilliseconds;
+
+			UnityEngine.Debug.Log(string.Format(
+				"{0} points, {1} queries, radius {2}m\n"
+				+ "KDTree: build {3:0.0}ms, radius {4:0.0}ms ({5} hits), 10-NN {6:0.0}ms\n"
+				+ "FeatureSpatialIndex: build {7:0.0}ms, radius {8:0.0}ms ({9} hits), 10-NN {10:0.0}ms"
+				, positions.Count, queries, radius
+				, kdBuild, kdRadius, kdRadiusHits, kdNearest
+				, indexBuild, indexRadius, indexRadiusHits, indexNearest
+			));
+
+			// the KDTree threshold excludes the boundary, float rounding may move a point across it
+			Assert.AreEqual(kdRadiusHits, indexRadiusHits, kdRadiusHits / 1000d + 1d, "radius queries disagree");
+		}
+
+		private void addBuildings(int perTile)
+		{
+			for (int x = 0; x < TILES_PER_SIDE; x++)
+			{
+				for (int y = 0; y < TILES_PER_SIDE; y++)
+				{
+					addTile(tileId(x, y), perTile);
+				}
+			}
+		}
+
+		private void addTile(UnwrappedTileId tile, int count)
+		{
+			List<Bounds> bounds = new List<Bounds>();
+			List<int> items = new List<int>();
+			for (int i = 0; i < count; i++)
+			{
+				Vector3 center = new Vector3(
+					(tile.X + (float)_random.NextDouble()) * TILE_SIZE
+					, 0f
+					, (tile.Y + (float)_random.NextDouble()) * TILE_SIZE
+				);
+				Vector3 size = new Vector3(2f + (float)_random.NextDouble() * 10f, (float)_random.NextDouble() * 30f, 2f + (float)_random.NextDouble() * 10f);
+				Bounds building = new Bounds(center + Vector3.up * size.y / 2f, size);
+				items.Add(_bounds.Count);
+				_bounds.Add(building);
+				bounds.Add(building);
+			}
+			_index.Add(tile, bounds, items);
+		}
+
+		private Vector3 randomPoint()
+		{
+			return new Vector3((float)_random.NextDouble() * TILE_SIZE * TILES_PER_SIDE, 0f, (float)_random.NextDouble() * TILE_SIZE * TILES_PER_SIDE);
+		}
+
+		private UnwrappedTileId tileId(int x, int y)
+		{
+			return new UnwrappedTileId(16, x, y);
+		}
+
+		private static float sqrDistanceXZ(Bounds bounds, Vector3 point)
+		{
+			float dx = Mathf.Max(0f, Mathf.Max(bounds.min.x - point.x, point.x - bounds.max.x));
+			float dz = Mathf.Max(0f, Mathf.Max(bounds.min.z - point.z, point.z - bounds.max.z));
+			return dx * dx + dz * dz;
+		}
+	}
+}
@@ -0,0 +1,174 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using Mapbox.Unity.MeshGeneration.Factories.TerrainStrategies;
+	using NUnit.Framework;
+	using UnityEngine;
+	using UnityEngine.Rendering;
+
+	[TestFixture]
+	internal class TerrainMeshGridTests
+	{
+		private const float TILE_SIZE = 100f;
+		private const int BENCHMARK_TILES = 200;
+
+		[Test]
+		public void SharesLayoutPerSampleCount()
+		{
+			var grid = TerrainMeshGrid.Get(10, true);
+			Assert.AreSame(grid, TerrainMeshGrid.Get(10, true));
+			Assert.AreNotSame(grid, TerrainMeshGrid.Get(10, false));
+
+			Assert.AreEqual(100 + 36, grid.VertexCount);
+			Assert.AreEqual(9 * 9 * 6 + 36 * 6, grid.Triangles.Length);
+			Assert.AreEqual(100, TerrainMeshGrid.Get(10, false).VertexCount);
+			foreach (var index in grid.Triangles)
+			{
+				Assert.That(index >= 0 && index < grid.VertexCount);
+			}
+		}
+
+		[Test]
+		public void SamplesHeightsLikeTheTile()
+		{
+			var n = 17;
+			var grid = TerrainMeshGrid.Get(n, false);
+			var heights = terrain(3);
+			var vertices = new Vector3[grid.VertexCount];
+			var normals = new Vector3[grid.VertexCount];
+			var bounds = grid.Build(heights, 2f, TILE_SIZE, TILE_SIZE, vertices, normals);
+
+			for (float y = 0; y < n; y++)
+			{
+				for (float x = 0; x < n; x++)
+				{
+					var v = vertices[(int)(y * n + x)];
+					Assert.AreEqual(heights[((int)((1 - y / (n - 1)) * 255) * 256) + ((int)(x / (n - 1) * 255))] * 2f, v.y);
+					Assert.AreEqual((x / (n - 1) - 0.5f) * TILE_SIZE, v.x, 1e-4);
+					Assert.AreEqual((0.5f - y / (n - 1)) * TILE_SIZE, v.z, 1e-4);
+					Assert.That(bounds.Contains(v));
+				}
+			}
+		}
+
+		[Test]
+		public void NormalsFollowTheSurface()
+		{
+			var n = 33;
+			var grid = TerrainMeshGrid.Get(n, false);
+			var vertices = new Vector3[grid.VertexCount];
+			var normals = new Vector3[grid.VertexCount];
+			grid.Build(terrain(5), 1f, TILE_SIZE, TILE_SIZE, vertices, normals);
+
+			for (int y = 1; y < n - 1; y++)
+			{
+				for (int x = 1; x < n - 1; x++)
+				{
+					var normal = normals[y * n + x];
+					Assert.AreEqual(1f, normal.magnitude, 1e-4);
+					Assert.Greater(normal.y, 0f);
+					Assert.AreEqual(0f, Vector3.Dot(normal, vertices[y * n + x + 1] - vertices[y * n + x - 1]), 1e-3);
+					Assert.AreEqual(0f, Vector3.Dot(normal, vertices[(y + 1) * n + x] - vertices[(y - 1) * n + x]), 1e-3);
+				}
+			}
+
+			grid.Build(null, 12f, TILE_SIZE, TILE_SIZE, vertices, normals);
+			Assert.AreEqual(12f, vertices[n + 1].y);
+			Assert.AreEqual(Vector3.up, normals[n + 1]);
+		}
+
+		[Test]
+		public void TrianglesFaceUpAndSkirtsOutwards()
+		{
+			var grid = TerrainMeshGrid.Get(9, true);
+			var vertices = new Vector3[grid.VertexCount];
+			var normals = new Vector3[grid.VertexCount];
+			var bounds = grid.Build(terrain(7), 1f, TILE_SIZE, TILE_SIZE, vertices, normals);
+
+			var gridTriangles = (grid.SampleCount - 1) * (grid.SampleCount - 1) * 6;
+			for (int i = 0; i < grid.Triangles.Length; i += 3)
+			{
+				var a = vertices[grid.Triangles[i]];
+				var b = vertices[grid.Triangles[i + 1]];
+				var c = vertices[grid.Triangles[i + 2]];
+				var face = Vector3.Cross(b - a, c - a);
+				if (i < gridTriangles)
+				{
+					Assert.Greater(face.y, 0f, "triangle " + i / 3);
+				}
+				else
+				{
+					//skirts hang below their edge and face away from the tile centre
+					var centre = (a + b + c) / 3;
+					Assert.Greater(face.x * centre.x + face.z * centre.z, 0f, "skirt triangle " + i / 3);
+					Assert.AreEqual(0f, face.y, 1e-2);
+				}
+			}
+
+			for (int i = grid.GridVertexCount; i < grid.VertexCount; i++)
+			{
+				Assert.That(bounds.Contains(vertices[i]));
+			}
+		}
+
+		[Test]
+		public void LargestGridUses32BitIndices()
+		{
+			var grid = TerrainMeshGrid.Get(255, true);
+			Assert.AreEqual(255 * 255 + 4 * 254, grid.VertexCount);
+			var vertices = new Vector3[grid.VertexCount];
+			var normals = new Vector3[grid.VertexCount];
+			var bounds = grid.Build(terrain(2), 1f, TILE_SIZE, TILE_SIZE, vertices, normals);
+
+			var mesh = new Mesh();
+			try
+			{
+				grid.Apply(mesh, vertices, normals, bounds);
+				Assert.AreEqual(IndexFormat.UInt32, mesh.indexFormat);
+				Assert.AreEqual(grid.VertexCount, mesh.vertexCount);
+				var triangles = mesh.triangles;
+				Assert.AreEqual(grid.Triangles.Length, triangles.Length);
+				Assert.AreEqual(grid.VertexCount - 1, Mathf.Max(triangles), "indices wrapped");
+
+				var small = TerrainMeshGrid.Get(10, true);
+				vertices = new Vector3[small.VertexCount];
+				normals = new Vector3[small.VertexCount];
+				small.Apply(mesh, vertices, normals, small.Build(null, 0f, TILE_SIZE, TILE_SIZE, vertices, normals));
+				Assert.AreEqual(IndexFormat.UInt16, mesh.indexFormat);
+			}
+			finally
+			{
+				UnityEngine.Object.DestroyImmediate(mesh);
+			}
+		}
+
+		[Test]
+		public void BenchmarkTileBuild()
+		{
+			var heights = terrain(1);
+			var grid = TerrainMeshGrid.Get(40, true);
+			var vertices = new Vector3[grid.VertexCount];
+			var normals = new Vector3[grid.VertexCount];
+			grid.Build(heights, 1f, TILE_SIZE, TILE_SIZE, vertices, normals);
+
+			var watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_TILES; i++)
+			{
+				grid.Build(heights, 1f, TILE_SIZE, TILE_SIZE, vertices, normals);
+			}
+			Debug.Log(string.Format("[TerrainMeshGrid] {0} samples with skirts: {1:0.000}ms per tile", grid.SampleCount, watch.Elapsed.TotalMilliseconds / BENCHMARK_TILES));
+		}
+
+		/// <summary> 256 x 256 heights with hills and noise, laid out like UnityTile.HeightData. </summary>
+		private static float[] terrain(int seed)
+		{
+			var random = new System.Random(seed);
+			var heights = new float[256 * 256];
+			for (int i = 0; i < heights.Length; i++)
+			{
+				heights[i] = (float)(30 * Math.Sin(i % 256 * 0.05) * Math.Cos(i / 256 * 0.04) + random.NextDouble());
+			}
+			return heights;
+		}
+	}
+}
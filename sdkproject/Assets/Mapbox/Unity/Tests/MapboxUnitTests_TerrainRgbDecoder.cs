@@ -0,0 +1,298 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.IO;
+	using Mapbox.IO.Compression;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class TerrainRgbDecoderTests
+	{
+		private const int SIZE = TerrainRgbDecoder.SIZE;
+		private const int BENCHMARK_TILES = 50;
+
+		[Test]
+		public void DecodesEveryFilterType()
+		{
+			var pixels = terrain(SIZE, SIZE, 3, 11);
+			var png = encode(SIZE, SIZE, 2, pixels, -1);
+			var decoder = new PngDecoder();
+			var heights = new float[SIZE * SIZE];
+
+			Assert.IsTrue(TerrainRgbDecoder.DecodeHeights(decoder, png, heights, 1.5f));
+			assertHeights(pixels, 3, SIZE, heights, 1.5f);
+
+			// texture based decoding reads the same values
+			var row = SIZE - 1;
+			var r = pixels[0];
+			var g = pixels[1];
+			var b = pixels[2];
+			Assert.AreEqual(1.5f * (-10000f + ((r * 65536f + g * 256f + b) * 0.1f)), heights[row * SIZE]);
+		}
+
+		[Test]
+		public void DecodesPaletteAndAlpha()
+		{
+			var decoder = new PngDecoder();
+			var heights = new float[SIZE * SIZE];
+
+			var rgba = terrain(SIZE, SIZE, 4, 3);
+			Assert.IsTrue(TerrainRgbDecoder.DecodeHeights(decoder, encode(SIZE, SIZE, 6, rgba, 4), heights, 1f));
+			assertHeights(rgba, 4, SIZE, heights, 1f);
+
+			// two colour palette image, eg sea level tiles
+			var indexed = new byte[SIZE * SIZE];
+			for (int i = 0; i < indexed.Length; i++) { indexed[i] = (byte)(i / SIZE < 100 ? 0 : 1); }
+			var png = encode(SIZE, SIZE, 3, indexed, 1, new byte[] { 1, 134, 160, 1, 134, 170 });
+			Assert.IsTrue(TerrainRgbDecoder.DecodeHeights(decoder, png, heights, 1f));
+			Assert.AreEqual(-10000f + (1 * 65536 + 134 * 256 + 160) * 0.1f, heights[(SIZE - 1) * SIZE]);
+			Assert.AreEqual(-10000f + (1 * 65536 + 134 * 256 + 170) * 0.1f, heights[0]);
+		}
+
+		[Test]
+		public void ResamplesSmallerImages()
+		{
+			var pixels = terrain(128, 128, 3, 5);
+			var heights = new float[SIZE * SIZE];
+			Assert.IsTrue(TerrainRgbDecoder.DecodeHeights(new PngDecoder(), encode(128, 128, 2, pixels, 0), heights, 1f));
+			for (int row = 0; row < SIZE; row++)
+			{
+				for (int col = 0; col < SIZE; col++)
+				{
+					var p = ((127 - row / 2) * 128 + col / 2) * 3;
+					Assert.AreEqual(-10000f + ((pixels[p] << 16) | (pixels[p + 1] << 8) | pixels[p + 2]) * 0.1f, heights[row * SIZE + col]);
+				}
+			}
+		}
+
+		[Test]
+		public void RejectsUnsupportedAndCorruptImages()
+		{
+			var heights = new float[SIZE * SIZE];
+			var png = encode(4, 4, 2, new byte[4 * 4 * 3], 0);
+			png[24] = 16; // bit depth
+			Assert.IsFalse(TerrainRgbDecoder.DecodeHeights(new PngDecoder(), png, heights, 1f));
+			Assert.Throws<FormatException>(() => new PngDecoder().Decode(new byte[] { 1, 2, 3 }, (y, p, bpp) => { }));
+		}
+
+		[Test]
+		public void PyramidRangeMatchesScan()
+		{
+			var heights = grid(SIZE, 1);
+			var pyramid = new HeightPyramid();
+			pyramid.Build(heights, SIZE);
+			Assert.AreEqual(9, pyramid.LevelCount);
+
+			var random = new System.Random(2);
+			for (int i = 0; i < 500; i++)
+			{
+				int col0 = random.Next(SIZE), col1 = random.Next(col0, SIZE), row0 = random.Next(SIZE), row1 = random.Next(row0, SIZE);
+				float min, max;
+				pyramid.GetRange(col0, row0, col1, row1, out min, out max);
+
+				float expectedMin = float.MaxValue, expectedMax = float.MinValue;
+				for (int row = row0; row <= row1; row++)
+				{
+					for (int col = col0; col <= col1; col++)
+					{
+						expectedMin = Math.Min(expectedMin, heights[row * SIZE + col]);
+						expectedMax = Math.Max(expectedMax, heights[row * SIZE + col]);
+					}
+				}
+				Assert.AreEqual(expectedMin, min);
+				Assert.AreEqual(expectedMax, max);
+			}
+
+			Assert.IsFalse(pyramid.IsFlat);
+			pyramid.Build(new float[SIZE * SIZE], SIZE);
+			Assert.IsTrue(pyramid.IsFlat);
+			Assert.AreEqual(0f, pyramid.MaxHeight);
+		}
+
+		[Test]
+		public void PyramidRaycastMatchesMarching()
+		{
+			var heights = grid(SIZE, 4);
+			var pyramid = new HeightPyramid();
+			pyramid.Build(heights, SIZE);
+
+			var random = new System.Random(9);
+			for (int i = 0; i < 300; i++)
+			{
+				var origin = new Vector3((float)random.NextDouble() * SIZE, 600, (float)random.NextDouble() * SIZE);
+				var target = new Vector3((float)random.NextDouble() * SIZE, -300, (float)random.NextDouble() * SIZE);
+				var direction = target - origin;
+
+				// every ray ends below the terrain, grazing contacts are within float precision so the
+				// hit has to be on a column and no later than where marching is clearly below the surface
+				float distance;
+				Assert.IsTrue(pyramid.Raycast(origin, direction, out distance), "ray " + i);
+				//just past the hit, a hit on the side of a column is on the boundary of the cell before it
+				var point = origin + direction * (distance + 1e-5f);
+				Assert.LessOrEqual(point.y, heights[(int)point.z * SIZE + (int)point.x] + 2e-2f, "ray " + i);
+				Assert.LessOrEqual(distance, march(heights, origin, direction, 1e-2f) + 1e-4f, "ray " + i);
+			}
+
+			// straight down and parallel above the terrain
+			float down;
+			Assert.IsTrue(pyramid.Raycast(new Vector3(10.5f, 1000, 20.5f), new Vector3(0, -1, 0), out down));
+			Assert.AreEqual(1000 - heights[20 * SIZE + 10], down, 1e-3);
+			Assert.IsFalse(pyramid.Raycast(new Vector3(0, 1000, 10), new Vector3(1, 0, 0), out down));
+		}
+
+		[Test]
+		public void BenchmarkDecoding()
+		{
+			var png = encode(SIZE, SIZE, 2, terrain(SIZE, SIZE, 3, 1), -1);
+			var decoder = new PngDecoder();
+			var heights = new float[SIZE * SIZE];
+			var pyramid = new HeightPyramid();
+
+			TerrainRgbDecoder.DecodeHeights(decoder, png, heights, 1f);
+			var watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_TILES; i++)
+			{
+				TerrainRgbDecoder.DecodeHeights(decoder, png, heights, 1f);
+			}
+			var decodeMs = watch.Elapsed.TotalMilliseconds / BENCHMARK_TILES;
+
+			watch = System.Diagnostics.Stopwatch.StartNew();
+			for (int i = 0; i < BENCHMARK_TILES; i++)
+			{
+				pyramid.Build(heights, SIZE);
+			}
+			var pyramidMs = watch.Elapsed.TotalMilliseconds / BENCHMARK_TILES;
+
+			Debug.Log(string.Format("[TerrainRgbDecoder] per tile: decoding {0:0.00}ms, pyramid {1:0.00}ms", decodeMs, pyramidMs));
+		}
+
+		private static void assertHeights(byte[] pixels, int bpp, int width, float[] heights, float scale)
+		{
+			for (int y = 0; y < SIZE; y++)
+			{
+				for (int x = 0; x < SIZE; x++)
+				{
+					var p = (y * width + x) * bpp;
+					var expected = scale * (-10000f + ((pixels[p] << 16) | (pixels[p + 1] << 8) | pixels[p + 2]) * 0.1f);
+					Assert.AreEqual(expected, heights[(SIZE - 1 - y) * SIZE + x], "pixel " + x + "," + y);
+				}
+			}
+		}
+
+		/// <summary> Smooth hills around 400m encoded as terrain-RGB with some noise. </summary>
+		private static byte[] terrain(int width, int height, int bpp, int seed)
+		{
+			var random = new System.Random(seed);
+			var pixels = new byte[width * height * bpp];
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					var metres = 400 + 150 * Math.Sin(x * 0.05) * Math.Cos(y * 0.03) + random.NextDouble() * 5;
+					var v = (int)((metres + 10000) * 10);
+					var p = (y * width + x) * bpp;
+					pixels[p] = (byte)(v >> 16);
+					pixels[p + 1] = (byte)(v >> 8);
+					pixels[p + 2] = (byte)v;
+					if (bpp == 4) { pixels[p + 3] = 255; }
+				}
+			}
+			return pixels;
+		}
+
+		private static float[] grid(int size, int seed)
+		{
+			var random = new System.Random(seed);
+			var heights = new float[size * size];
+			for (int i = 0; i < heights.Length; i++)
+			{
+				heights[i] = (float)(200 * Math.Sin(i % size * 0.07) * Math.Cos(i / size * 0.05) + random.NextDouble() * 20);
+			}
+			return heights;
+		}
+
+		/// <summary> First point of a ray at least <paramref name="depth"/> below the sample columns, marching in small steps. </summary>
+		private static float march(float[] heights, Vector3 origin, Vector3 direction, float depth)
+		{
+			var steps = 20000;
+			for (int i = 0; i <= steps; i++)
+			{
+				var t = (float)i / steps;
+				var p = origin + direction * t;
+				if (p.x >= 0 && p.z >= 0 && p.x < SIZE && p.z < SIZE && p.y <= heights[(int)p.z * SIZE + (int)p.x] - depth)
+				{
+					return t;
+				}
+			}
+			return float.MaxValue;
+		}
+
+		/// <summary>
+		/// Minimal png encoder, 8 bit only. <paramref name="filter"/> -1 cycles through all filter types row by row.
+		/// CRCs are left empty, the decoder doesn't check them.
+		/// </summary>
+		private static byte[] encode(int width, int height, int colorType, byte[] pixels, int filter, byte[] palette = null)
+		{
+			var bpp = colorType == 2 ? 3 : colorType == 6 ? 4 : 1;
+			var stride = width * bpp;
+			var raw = new MemoryStream();
+			var previous = new byte[stride];
+			for (int y = 0; y < height; y++)
+			{
+				var type = filter < 0 ? y % 5 : filter;
+				raw.WriteByte((byte)type);
+				for (int i = 0; i < stride; i++)
+				{
+					int a = i >= bpp ? pixels[y * stride + i - bpp] : 0;
+					int b = previous[i];
+					int c = i >= bpp ? previous[i - bpp] : 0;
+					int predictor = 0;
+					switch (type)
+					{
+						case 1: predictor = a; break;
+						case 2: predictor = b; break;
+						case 3: predictor = (a + b) >> 1; break;
+						case 4:
+							int pa = Math.Abs(b - c), pb = Math.Abs(a - c), pc = Math.Abs(a + b - c - c);
+							predictor = pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+							break;
+					}
+					raw.WriteByte((byte)(pixels[y * stride + i] - predictor));
+				}
+				Buffer.BlockCopy(pixels, y * stride, previous, 0, stride);
+			}
+
+			var compressed = new MemoryStream();
+			compressed.WriteByte(0x78);
+			compressed.WriteByte(0x9C);
+			using (var deflate = new DeflateStream(compressed, CompressionMode.Compress, true))
+			{
+				var bytes = raw.ToArray();
+				deflate.Write(bytes, 0, bytes.Length);
+			}
+			compressed.Write(new byte[4], 0, 4); // adler32
+
+			var png = new MemoryStream();
+			png.Write(new byte[] { 137, 80, 78, 71, 13, 10, 26, 10 }, 0, 8);
+			writeChunk(png, "IHDR", new byte[] {
+				(byte)(width >> 24), (byte)(width >> 16), (byte)(width >> 8), (byte)width,
+				(byte)(height >> 24), (byte)(height >> 16), (byte)(height >> 8), (byte)height,
+				8, (byte)colorType, 0, 0, 0 });
+			if (palette != null) { writeChunk(png, "PLTE", palette); }
+			writeChunk(png, "IDAT", compressed.ToArray());
+			writeChunk(png, "IEND", new byte[0]);
+			return png.ToArray();
+		}
+
+		private static void writeChunk(Stream stream, string type, byte[] data)
+		{
+			stream.Write(new byte[] { (byte)(data.Length >> 24), (byte)(data.Length >> 16), (byte)(data.Length >> 8), (byte)data.Length }, 0, 4);
+			for (int i = 0; i < 4; i++) { stream.WriteByte((byte)type[i]); }
+			stream.Write(data, 0, data.Length);
+			stream.Write(new byte[4], 0, 4);
+		}
+	}
+}
@@ -0,0 +1,375 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Diagnostics;
+	using System.IO;
+	using Mapbox.Map;
+	using Mapbox.Platform.Cache;
+	using Mapbox.Unity.Map;
+	using Mapbox.Unity.Map.Interfaces;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.Unity.MeshGeneration.Enums;
+	using Mapbox.Unity.MeshGeneration.Factories;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	/// <summary>
+	/// Replays recorded tiles through the terrain, imagery and vector factories without a map or a network connection
+	/// and logs per stage timings from <see cref="TileTrace"/>. Set MAPBOX_REPLAY_TILEPACKS to a folder of tile packs
+	/// recorded for the tiles around <see cref="LATITUDE"/>, <see cref="LONGITUDE"/> to replay real data, otherwise
+	/// synthetic tiles are generated. Set MAPBOX_TILE_TRACE to a file to also write the run as a Chrome trace.
+	/// </summary>
+	[TestFixture]
+	internal class TilePipelineTests
+	{
+		private const string REPLAY_FOLDER_VARIABLE = "MAPBOX_REPLAY_TILEPACKS";
+		private const string TRACE_FILE_VARIABLE = "MAPBOX_TILE_TRACE";
+		private const double LATITUDE = 37.7749;
+		private const double LONGITUDE = -122.4194;
+		private const int ZOOM = 16;
+		private const int TILES_PER_SIDE = 4;
+		private const int BUILDINGS_PER_TILE = 400;
+		private const int EXTENT = 4096;
+		private const double TIMEOUT_SECONDS = 120;
+
+		private class ReplayMap : IMapReadable
+		{
+			private readonly Transform _root;
+			private readonly Vector2d _center;
+
+			public ReplayMap(Transform root, Vector2d center)
+			{
+				_root = root;
+				_center = center;
+			}
+
+			public Vector2d CenterMercator { get { return Conversions.LatLonToMeters(_center); } }
+			public float WorldRelativeScale { get { return 1f; } }
+			public Vector2d CenterLatitudeLongitude { get { return _center; } }
+			public float Zoom { get { return ZOOM; } }
+			public int InitialZoom { get { return ZOOM; } }
+			public int AbsoluteZoom { get { return ZOOM; } }
+			public Transform Root { get { return _root; } }
+			public float UnityTileSize { get { return 100f; } }
+			public Texture2D LoadingTexture { get { return null; } }
+			public Material TileMaterial { get { return null; } }
+			public HashSet<UnwrappedTileId> CurrentExtent { get { return new HashSet<UnwrappedTileId>(); } }
+			public event Action OnInitialized = delegate { };
+			public event Action OnUpdated = delegate { };
+
+			public Vector2d WorldToGeoPosition(Vector3 realworldPoint)
+			{
+				throw new NotSupportedException();
+			}
+
+			public Vector3 GeoToWorldPosition(Vector2d latitudeLongitude, bool queryHeight = true)
+			{
+				throw new NotSupportedException();
+			}
+		}
+
+		private List<UnityEngine.Object> _objects = new List<UnityEngine.Object>();
+		private List<AbstractTileFactory> _factories = new List<AbstractTileFactory>();
+		private string _folder;
+		private OfflineFileSource _source;
+
+		[SetUp]
+		public void SetUp()
+		{
+			_folder = Path.Combine(Path.GetTempPath(), "MapboxTilePipelineTests");
+			Directory.CreateDirectory(_folder);
+		}
+
+		[TearDown]
+		public void TearDown()
+		{
+			TileTrace.Enabled = false;
+			TileTrace.TrackAllocations = false;
+			TileTrace.Clear();
+			foreach (var factory in _factories)
+			{
+				factory.Clear();
+				UnityEngine.Object.DestroyImmediate(factory);
+			}
+			_factories.Clear();
+			foreach (var obj in _objects)
+			{
+				UnityEngine.Object.DestroyImmediate(obj);
+			}
+			_objects.Clear();
+			if (_source != null)
+			{
+				_source.Dispose();
+				_source = null;
+			}
+			Directory.Delete(_folder, true);
+		}
+
+		[Test]
+		public void BenchmarkReplayedTiles()
+		{
+			var terrain = new TerrainLayer(new ElevationLayerProperties() { elevationLayerType = ElevationLayerType.TerrainWithElevation });
+			terrain.Initialize();
+			var imagery = new ImageryLayer(new ImageryLayerProperties() { sourceType = ImagerySourceType.MapboxSatellite });
+			imagery.Initialize();
+			var vector = new VectorLayer();
+			vector.AddPolygonFeatureSubLayer("buildings", "building");
+			vector.Initialize();
+			_factories.Add(terrain.Factory);
+			_factories.Add(imagery.Factory);
+			_factories.Add(vector.Factory);
+
+			var tileIds = TileIds();
+			var packs = new TilePackCache();
+			var replayFolder = Environment.GetEnvironmentVariable(REPLAY_FOLDER_VARIABLE);
+			if (!string.IsNullOrEmpty(replayFolder))
+			{
+				Assert.Greater(packs.OpenDirectory(replayFolder), 0, "no tile packs in " + replayFolder);
+			}
+			else
+			{
+				var path = Path.Combine(_folder, "replay" + TilePackCache.FILE_EXTENSION);
+				WritePack(path, tileIds, vector.LayerSourceId, terrain.LayerSourceId, imagery.LayerSourceId);
+				packs.Open(path);
+			}
+			_source = new OfflineFileSource().AddCache(packs);
+			foreach (var factory in _factories)
+			{
+				factory.Initialize(_source);
+			}
+
+			var root = new GameObject("replay");
+			_objects.Add(root);
+			var material = new Material(Shader.Find("Diffuse"));
+			_objects.Add(material);
+			var map = new ReplayMap(root.transform, Conversions.TileIdToCenterLatitudeLongitude(tileIds[0].X, tileIds[0].Y, ZOOM));
+
+			TileTrace.Clear();
+			TileTrace.TrackAllocations = true;
+			TileTrace.Enabled = true;
+			var watch = Stopwatch.StartNew();
+			var tiles = new List<UnityTile>();
+			foreach (var tileId in tileIds)
+			{
+				var tile = new GameObject(tileId.ToString()).AddComponent<UnityTile>();
+				_objects.Add(tile.gameObject);
+				tile.transform.SetParent(root.transform, false);
+				tile.MeshRenderer.sharedMaterial = material;
+				tile.Initialize(map, tileId, map.WorldRelativeScale, ZOOM);
+				tile.TileState = TilePropertyState.Loading;
+				tiles.Add(tile);
+				foreach (var factory in _factories)
+				{
+					factory.Register(tile);
+				}
+			}
+
+			// decoding runs on workers, coroutines of the layer visualizers have to be pumped without a player loop
+			while (tiles.Exists(IsLoading) && watch.Elapsed.TotalSeconds < TIMEOUT_SECONDS)
+			{
+				Runnable.Instance.UpdateRoutines();
+				System.Threading.Thread.Sleep(1);
+			}
+			watch.Stop();
+			TileTrace.Enabled = false;
+
+			Assert.IsFalse(tiles.Exists(IsLoading), "tiles still loading after " + TIMEOUT_SECONDS + "s");
+			foreach (var tile in tiles)
+			{
+				Assert.AreEqual(TilePropertyState.Loaded, tile.VectorDataState, tile.CanonicalTileId + " vector");
+				Assert.AreEqual(TilePropertyState.Loaded, tile.HeightDataState, tile.CanonicalTileId + " terrain");
+				Assert.AreEqual(TilePropertyState.Loaded, tile.RasterDataState, tile.CanonicalTileId + " raster");
+			}
+			Assert.AreEqual(0, _source.Misses, "replay requested tiles that weren't recorded");
+
+			var spans = new List<TileTraceSpan>();
+			TileTrace.Collect(spans);
+			var report = new TileTraceReport(spans);
+			foreach (var stage in new TileTraceStage[] { TileTraceStage.Fetch, TileTraceStage.Parse, TileTraceStage.Decode, TileTraceStage.Modifiers, TileTraceStage.Terrain, TileTraceStage.Raster })
+			{
+				Assert.IsNotNull(report[stage], stage + " wasn't traced");
+			}
+			Assert.AreEqual(tiles.Count, report[TileTraceStage.Terrain].Tiles);
+
+			var traceFile = Environment.GetEnvironmentVariable(TRACE_FILE_VARIABLE);
+			if (!string.IsNullOrEmpty(traceFile))
+			{
+				using (var writer = new StreamWriter(traceFile))
+				{
+					TileTrace.WriteChromeTrace(writer, spans);
+				}
+			}
+
+			UnityEngine.Debug.Log(string.Format(
+				"[TilePipeline] {0} tiles from {1} in {2:0}ms, {3} spans, {4} dropped\n{5}"
+				, tiles.Count
+				, string.IsNullOrEmpty(replayFolder) ? "synthetic tiles" : replayFolder
+				, watch.Elapsed.TotalMilliseconds
+				, spans.Count
+				, TileTrace.Dropped
+				, report
+			));
+		}
+
+		#region helper methods
+
+		private static bool IsLoading(UnityTile tile)
+		{
+			return tile.VectorDataState == TilePropertyState.Loading
+				|| tile.HeightDataState == TilePropertyState.Loading
+				|| tile.RasterDataState == TilePropertyState.Loading;
+		}
+
+		private static List<UnwrappedTileId> TileIds()
+		{
+			var center = Conversions.LatitudeLongitudeToTileId(LATITUDE, LONGITUDE, ZOOM);
+			var ids = new List<UnwrappedTileId>();
+			for (int y = 0; y < TILES_PER_SIDE; y++)
+			{
+				for (int x = 0; x < TILES_PER_SIDE; x++)
+				{
+					ids.Add(new UnwrappedTileId(ZOOM, center.X + x - TILES_PER_SIDE / 2, center.Y + y - TILES_PER_SIDE / 2));
+				}
+			}
+			return ids;
+		}
+
+		private static void WritePack(string path, List<UnwrappedTileId> tileIds, string vectorTilesetId, string terrainTilesetId, string imageryTilesetId)
+		{
+			var random = new System.Random(42);
+			using (var writer = new TilePackWriter(path))
+			{
+				foreach (var tileId in tileIds)
+				{
+					writer.Add(vectorTilesetId, tileId.Canonical, new CacheItem() { Data = VectorTile(random) });
+					writer.Add(terrainTilesetId, tileId.Canonical, new CacheItem() { Data = TerrainPng(tileId.X, tileId.Y) });
+					writer.Add(imageryTilesetId, tileId.Canonical, new CacheItem() { Data = RasterJpg(random) });
+				}
+				writer.Finish();
+			}
+		}
+
+		/// <summary> Terrain-RGB png of rolling hills, continuous across tiles. </summary>
+		private static byte[] TerrainPng(int tileX, int tileY)
+		{
+			var texture = new Texture2D(256, 256, TextureFormat.RGB24, false);
+			var pixels = new Color32[256 * 256];
+			for (int y = 0; y < 256; y++)
+			{
+				for (int x = 0; x < 256; x++)
+				{
+					float height = 50f + 30f * Mathf.Sin((tileX * 256 + x) * 0.02f) * Mathf.Cos((tileY * 256 + y) * 0.02f);
+					int value = (int)((height + 10000f) * 10f);
+					pixels[y * 256 + x] = new Color32((byte)(value >> 16), (byte)(value >> 8), (byte)value, 255);
+				}
+			}
+			texture.SetPixels32(pixels);
+			var png = texture.EncodeToPNG();
+			UnityEngine.Object.DestroyImmediate(texture);
+			return png;
+		}
+
+		private static byte[] RasterJpg(System.Random random)
+		{
+			var texture = new Texture2D(256, 256, TextureFormat.RGB24, false);
+			var pixels = new Color32[256 * 256];
+			for (int i = 0; i < pixels.Length; i++)
+			{
+				pixels[i] = new Color32((byte)random.Next(256), (byte)random.Next(256), (byte)random.Next(256), 255);
+			}
+			texture.SetPixels32(pixels);
+			var jpg = texture.EncodeToJPG(75);
+			UnityEngine.Object.DestroyImmediate(texture);
+			return jpg;
+		}
+
+		/// <summary>
+		/// Mapbox vector tile with a 'building' layer of rectangular footprints, each tagged with a height.
+		/// </summary>
+		private static byte[] VectorTile(System.Random random)
+		{
+			var layer = new MemoryStream();
+			WriteVarint(layer, (15 << 3) | 0);
+			WriteVarint(layer, 2);
+			WriteBytes(layer, 1, System.Text.Encoding.UTF8.GetBytes("building"));
+
+			for (int i = 0; i < BUILDINGS_PER_TILE; i++)
+			{
+				int x = random.Next(EXTENT - 100);
+				int y = random.Next(EXTENT - 100);
+				int width = random.Next(10, 100);
+				int depth = random.Next(10, 100);
+
+				// exterior rings have a positive area in tile coordinates
+				var geometry = new MemoryStream();
+				WriteVarint(geometry, (1 << 3) | 1); // MoveTo
+				WriteVarint(geometry, ZigZag(x));
+				WriteVarint(geometry, ZigZag(y));
+				WriteVarint(geometry, (3 << 3) | 2); // LineTo
+				WriteVarint(geometry, ZigZag(width));
+				WriteVarint(geometry, ZigZag(0));
+				WriteVarint(geometry, ZigZag(0));
+				WriteVarint(geometry, ZigZag(depth));
+				WriteVarint(geometry, ZigZag(-width));
+				WriteVarint(geometry, ZigZag(0));
+				WriteVarint(geometry, (1 << 3) | 7); // ClosePath
+
+				// key 0 'height', value i
+				var tags = new MemoryStream();
+				WriteVarint(tags, 0);
+				WriteVarint(tags, (ulong)i);
+
+				var feature = new MemoryStream();
+				WriteVarint(feature, (1 << 3) | 0);
+				WriteVarint(feature, (ulong)i + 1);
+				WriteBytes(feature, 2, tags.ToArray());
+				WriteVarint(feature, (3 << 3) | 0);
+				WriteVarint(feature, 3); // POLYGON
+				WriteBytes(feature, 4, geometry.ToArray());
+				WriteBytes(layer, 2, feature.ToArray());
+			}
+
+			WriteBytes(layer, 3, System.Text.Encoding.UTF8.GetBytes("height"));
+			for (int i = 0; i < BUILDINGS_PER_TILE; i++)
+			{
+				var value = new MemoryStream();
+				WriteVarint(value, (5 << 3) | 0); // uint_value
+				WriteVarint(value, (ulong)random.Next(5, 60));
+				WriteBytes(layer, 4, value.ToArray());
+			}
+			WriteVarint(layer, (5 << 3) | 0);
+			WriteVarint(layer, EXTENT);
+
+			var tile = new MemoryStream();
+			WriteBytes(tile, 3, layer.ToArray());
+			return tile.ToArray();
+		}
+
+		private static ulong ZigZag(int value)
+		{
+			return (ulong)(uint)((value << 1) ^ (value >> 31));
+		}
+
+		private static void WriteVarint(Stream stream, ulong value)
+		{
+			while (value >= 0x80)
+			{
+				stream.WriteByte((byte)(value | 0x80));
+				value >>= 7;
+			}
+			stream.WriteByte((byte)value);
+		}
+
+		private static void WriteBytes(Stream stream, int field, byte[] bytes)
+		{
+			WriteVarint(stream, (ulong)((field << 3) | 2));
+			WriteVarint(stream, (ulong)bytes.Length);
+			stream.Write(bytes, 0, bytes.Length);
+		}
+
+		#endregion
+	}
+}
@@ -0,0 +1,298 @@
+namespace Mapbox.Unity.Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using Mapbox.Map;
+	using Mapbox.Platform;
+	using Mapbox.Unity.Location;
+	using Mapbox.Unity.Map;
+	using Mapbox.Unity.Utilities;
+	using Mapbox.Utils;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class TilePrefetcherTests
+	{
+		private const int ZOOM = 16;
+		private const double METERS_PER_DEGREE = 111320d;
+
+		private class FakeRequest : IAsyncRequest
+		{
+			public CanonicalTileId TileId;
+			public Action<Response> Callback;
+			public double DueAt;
+			public bool Canceled;
+
+			public bool IsCompleted { get; private set; }
+
+			public HttpRequestType RequestType { get { return HttpRequestType.Get; } }
+
+			public void Cancel()
+			{
+				Canceled = true;
+			}
+
+			public void Complete(int bytes)
+			{
+				IsCompleted = true;
+				Callback(Response.FromCache(new byte[bytes]));
+			}
+		}
+
+		private List<FakeRequest> _started;
+		private bool _allCached;
+		private TilePrefetcher _prefetcher;
+
+		[SetUp]
+		public void SetUp()
+		{
+			_started = new List<FakeRequest>();
+			_allCached = false;
+			_prefetcher = new TilePrefetcher((tileId, callback, requests) =>
+			{
+				if (_allCached) { return; }
+				var request = new FakeRequest() { TileId = tileId, Callback = callback };
+				_started.Add(request);
+				requests.Add(request);
+			});
+			_prefetcher.Zoom = ZOOM;
+		}
+
+		[Test]
+		public void EstimatorFollowsStraightTrack()
+		{
+			var motion = new LocationMotionEstimator();
+			Assert.IsFalse(motion.HasVelocity);
+
+			// 10 m/s north-east
+			for (int i = 0; i < 30; i++)
+			{
+				motion.Add(fix(60.19d, 24.96d, 7.07d * i, 7.07d * i, i));
+			}
+
+			Assert.IsTrue(motion.HasVelocity);
+			Assert.AreEqual(10d, motion.SpeedMetersPerSecond, 1d);
+			Assert.AreEqual(1d, motion.Velocity.x / motion.Velocity.y, 0.1d);
+
+			// heading only updates don't change the estimate
+			Assert.IsFalse(motion.Add(fix(60.19d, 24.96d, 0, 0, 29)));
+
+			var ahead = motion.Predict(10d);
+			Assert.Greater(ahead.x, motion.Position.x);
+			Assert.Greater(ahead.y, motion.Position.y);
+		}
+
+		[Test]
+		public void PrefetchesAheadWithinLimits()
+		{
+			_prefetcher.MaxInFlight = 3;
+			var now = driveEast(10);
+
+			Assert.AreEqual(3, _started.Count, "in flight limit not applied");
+			var current = Conversions.LatitudeLongitudeToTileId(60.19d, 24.96d + 90d / METERS_PER_DEGREE / Math.Cos(60.19d * Math.PI / 180d), ZOOM);
+			foreach (var request in _started)
+			{
+				Assert.GreaterOrEqual(request.TileId.X, current.X - _prefetcher.Radius, "prefetched a tile behind the user");
+			}
+
+			// completions free slots
+			_started[0].Complete(1000);
+			_prefetcher.Update(now);
+			Assert.AreEqual(4, _started.Count);
+			Assert.AreEqual(3, _prefetcher.InFlight);
+
+			// no new prefetches above the memory budget
+			_prefetcher.MaxBytes = _prefetcher.HeldBytes / 2;
+			_started[1].Complete(1000);
+			_prefetcher.Update(now);
+			Assert.AreEqual(4, _started.Count);
+		}
+
+		[Test]
+		public void BandwidthBudgetThrottles()
+		{
+			_prefetcher.MaxInFlight = 1000;
+			_prefetcher.BytesPerSecond = 64 * 1024;
+			var now = driveEast(2);
+
+			// the initial burst covers a few tiles of the default size only
+			var burst = _started.Count;
+			Assert.Greater(burst, 0);
+			Assert.Less(burst, 10);
+
+			_prefetcher.Update(now);
+			Assert.AreEqual(burst, _started.Count, "budget was not spent");
+
+			_prefetcher.Update(now + 1d);
+			Assert.Greater(_started.Count, burst, "budget was not refilled");
+		}
+
+		[Test]
+		public void CountsHitsAndMisses()
+		{
+			driveEast(10);
+			Assert.Greater(_started.Count, 1);
+
+			var done = _started[0];
+			done.Complete(1000);
+			var loading = _started[1];
+
+			var notPrefetched = new CanonicalTileId(ZOOM, 0, 1);
+			_prefetcher.TilesShown(new List<UnwrappedTileId>()
+			{
+				unwrapped(done.TileId),
+				unwrapped(loading.TileId),
+				unwrapped(notPrefetched),
+				unwrapped(new CanonicalTileId(ZOOM - 1, 0, 0))
+			});
+
+			var stats = _prefetcher.Stats;
+			Assert.AreEqual(1, stats.Hits);
+			Assert.AreEqual(1, stats.LateHits);
+			Assert.AreEqual(1, stats.Misses, "only tiles at the prefetch zoom count as misses");
+			Assert.AreEqual(1000, stats.Bytes);
+			Assert.IsFalse(loading.Canceled, "shown tile was canceled");
+
+			// prefetches that are never shown expire
+			_prefetcher.MinSpeedMetersPerSecond = 100d;
+			_prefetcher.Update(1000d);
+			Assert.AreEqual(_started.Count - 2, _prefetcher.Stats.Wasted);
+			Assert.AreEqual(0, _prefetcher.InFlight);
+			Assert.AreEqual(0, _prefetcher.HeldBytes);
+		}
+
+		[Test]
+		public void CachedTilesAreNeitherHitsNorMisses()
+		{
+			_allCached = true;
+			driveEast(10);
+
+			var stats = _prefetcher.Stats;
+			Assert.AreEqual(0, _started.Count);
+			Assert.AreEqual(0, stats.Prefetched);
+			Assert.Greater(stats.AlreadyCached, 0);
+			Assert.AreEqual(0, _prefetcher.InFlight);
+
+			var ahead = Conversions.LatitudeLongitudeToTileId(60.19d, 24.96d + 150d / METERS_PER_DEGREE / Math.Cos(60.19d * Math.PI / 180d), ZOOM);
+			_prefetcher.TilesShown(new List<UnwrappedTileId>() { ahead });
+			Assert.AreEqual(0, _prefetcher.Stats.Hits);
+			Assert.AreEqual(0, _prefetcher.Stats.Misses);
+		}
+
+		[Test]
+		public void ReplayHelsinkiTrace()
+		{
+			var path = Path.Combine(Application.dataPath, "Mapbox/Unity/Location/ExampleGpsTraces/Helsinki.txt");
+			var log = File.ReadAllBytes(path);
+			var lines = 0;
+			foreach (var line in File.ReadAllLines(path))
+			{
+				if (!string.IsNullOrEmpty(line) && !line.StartsWith("#")) { lines++; }
+			}
+
+			// the trace was recorded while walking: small tiles, a long horizon and a 3x3 view around the
+			// reported location, responses take a second
+			const int zoom = 18;
+			const double latency = 1d;
+			_prefetcher.Zoom = zoom;
+			_prefetcher.HorizonSeconds = 120d;
+			var view = new HashSet<CanonicalTileId>();
+			var pending = new List<FakeRequest>();
+
+			using (var reader = new LocationLogReader(log))
+			{
+				var locations = reader.GetLocations();
+				// the reader loops through the log
+				for (int i = 0; i < lines && locations.MoveNext(); i++)
+				{
+					var location = locations.Current;
+					var now = location.TimestampDevice;
+
+					for (int r = pending.Count - 1; r >= 0; r--)
+					{
+						if (pending[r].DueAt <= now)
+						{
+							pending[r].Complete(24 * 1024);
+							pending.RemoveAt(r);
+						}
+					}
+
+					var before = _started.Count;
+					_prefetcher.UpdateLocation(location, now);
+					for (int r = before; r < _started.Count; r++)
+					{
+						_started[r].DueAt = now + latency;
+						pending.Add(_started[r]);
+					}
+
+					if (location.LatitudeLongitude == Vector2d.zero) { continue; }
+					updateView(view, Conversions.LatitudeLongitudeToTileId(location.LatitudeLongitude.x, location.LatitudeLongitude.y, zoom).Canonical, 1);
+				}
+			}
+
+			var stats = _prefetcher.Stats;
+			Debug.Log("Helsinki trace, " + lines + " locations: " + stats);
+			Assert.Greater(stats.Prefetched, 0);
+			Assert.Greater(stats.Hits, 0);
+			Assert.LessOrEqual(stats.Bytes, stats.Prefetched * 24 * 1024);
+		}
+
+		// moves east at 10 m/s for `seconds`, returns the time of the last fix
+		private double driveEast(int seconds)
+		{
+			for (int i = 0; i < seconds; i++)
+			{
+				_prefetcher.UpdateLocation(fix(60.19d, 24.96d, 0, 10d * i, i), i);
+			}
+			return seconds - 1;
+		}
+
+		private void updateView(HashSet<CanonicalTileId> view, CanonicalTileId center, int radius)
+		{
+			var visible = new HashSet<CanonicalTileId>();
+			for (int y = center.Y - radius; y <= center.Y + radius; y++)
+			{
+				for (int x = center.X - radius; x <= center.X + radius; x++)
+				{
+					visible.Add(new CanonicalTileId(center.Z, x, y));
+				}
+			}
+
+			var shown = new List<UnwrappedTileId>();
+			var removed = new List<UnwrappedTileId>();
+			foreach (var tileId in visible)
+			{
+				if (!view.Contains(tileId)) { shown.Add(unwrapped(tileId)); }
+			}
+			foreach (var tileId in view)
+			{
+				if (!visible.Contains(tileId)) { removed.Add(unwrapped(tileId)); }
+			}
+
+			_prefetcher.TilesRemoved(removed);
+			_prefetcher.TilesShown(shown);
+			view.Clear();
+			view.UnionWith(visible);
+		}
+
+		private static Location fix(double lat, double lng, double northMeters, double eastMeters, double timestamp)
+		{
+			var location = new Location();
+			location.LatitudeLongitude = new Vector2d(
+				lat + northMeters / METERS_PER_DEGREE
+				, lng + eastMeters / (METERS_PER_DEGREE * Math.Cos(lat * Math.PI / 180d))
+			);
+			location.Accuracy = 5f;
+			location.Timestamp = timestamp;
+			location.IsLocationUpdated = true;
+			return location;
+		}
+
+		private static UnwrappedTileId unwrapped(CanonicalTileId tileId)
+		{
+			return new UnwrappedTileId(tileId.Z, tileId.X, tileId.Y);
+		}
+	}
+}
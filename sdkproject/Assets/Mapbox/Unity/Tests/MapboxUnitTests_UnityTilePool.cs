@@ -0,0 +1,184 @@
+namespace Mapbox.Unity.Tests
+{
+	using System.Collections.Generic;
+	using Mapbox.Unity.Map;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.Unity.MeshGeneration.Modifiers;
+	using NUnit.Framework;
+	using UnityEngine;
+
+	[TestFixture]
+	internal class UnityTilePoolTests
+	{
+		private List<UnityTile> _created;
+		private UnityTilePool _pool;
+
+		[SetUp]
+		public void SetUp()
+		{
+			_created = new List<UnityTile>();
+			_pool = new UnityTilePool(new Queue<UnityTile>(), () =>
+			{
+				var tile = new GameObject().AddComponent<UnityTile>();
+				_created.Add(tile);
+				return tile;
+			});
+		}
+
+		[TearDown]
+		public void TearDown()
+		{
+			foreach (var tile in _created)
+			{
+				if (tile != null)
+				{
+					Object.DestroyImmediate(tile.gameObject);
+				}
+			}
+		}
+
+		[Test]
+		public void ReusesReturnedTiles()
+		{
+			var first = _pool.Get();
+			var second = _pool.Get();
+			Assert.AreNotSame(first, second);
+
+			first.Recycle();
+			_pool.Put(first);
+			Assert.AreSame(first, _pool.Get());
+
+			Assert.AreEqual(2, _pool.CreatedCount);
+			Assert.AreEqual(1, _pool.ReusedCount);
+			Assert.AreEqual(2, _pool.ActiveCount);
+			Assert.AreEqual(2, _pool.PeakActiveCount);
+			Assert.AreEqual(0, _pool.InactiveCount);
+		}
+
+		[Test]
+		public void SkipsDestroyedTiles()
+		{
+			var tile = _pool.Get();
+			tile.Recycle();
+			_pool.Put(tile);
+			Object.DestroyImmediate(tile.gameObject);
+
+			Assert.AreNotSame(tile, _pool.Get());
+			Assert.AreEqual(2, _pool.CreatedCount);
+			Assert.AreEqual(0, _pool.ReusedCount);
+		}
+
+		[Test]
+		public void WarmsUpInSteps()
+		{
+			_pool.Get();
+			Assert.AreEqual(3, _pool.WarmUp(6, 3));
+			Assert.AreEqual(2, _pool.WarmUp(6, 3));
+			Assert.AreEqual(0, _pool.WarmUp(6, 3));
+			Assert.AreEqual(5, _pool.InactiveCount);
+			Assert.AreEqual(5, _pool.WarmedUpCount);
+
+			foreach (var tile in _created)
+			{
+				if (tile.IsRecycled)
+				{
+					Assert.IsFalse(tile.gameObject.activeSelf);
+				}
+			}
+
+			for (int i = 0; i < 5; i++)
+			{
+				_pool.Get();
+			}
+			Assert.AreEqual(1, _pool.CreatedCount);
+			Assert.AreEqual(5, _pool.ReusedCount);
+		}
+
+		[Test]
+		public void ClearDestroysPooledTilesOnly()
+		{
+			var active = _pool.Get();
+			_pool.WarmUp(4, 4);
+
+			var destroyed = new List<UnityTile>();
+			_pool.Clear(tile => destroyed.Add(tile));
+
+			Assert.AreEqual(3, destroyed.Count);
+			Assert.IsFalse(destroyed.Contains(active));
+			Assert.AreEqual(3, _pool.DestroyedCount);
+			Assert.AreEqual(0, _pool.InactiveCount);
+			Assert.AreEqual(1, _pool.ActiveCount);
+		}
+
+		[Test]
+		public void SatelliteMaterialsMoveToTheNextFeatureObject()
+		{
+			var template = new Material(Shader.Find("Diffuse"));
+			var options = new GeometryMaterialOptions();
+			options.style = StyleTypes.Satellite;
+			options.materials = new MaterialList[] { new MaterialList() { Materials = new Material[] { template } } };
+			var modifier = ScriptableObject.CreateInstance<MaterialModifier>();
+			modifier.SetProperties(options);
+			var tile = _pool.Get();
+			var pooled = CreateEntity();
+			var next = CreateEntity();
+
+			try
+			{
+				modifier.Run(pooled, tile);
+				var material = pooled.MeshRenderer.sharedMaterial;
+				Assert.AreNotSame(template, material);
+
+				modifier.OnPoolItem(pooled);
+				Object.DestroyImmediate(pooled.GameObject);
+				modifier.Run(next, tile);
+				Assert.AreSame(material, next.MeshRenderer.sharedMaterial, "materials of the pooled object weren't reused");
+
+				modifier.Clear();
+				Assert.IsTrue(material == null, "materials weren't destroyed");
+			}
+			finally
+			{
+				Object.DestroyImmediate(pooled.Mesh);
+				Object.DestroyImmediate(next.Mesh);
+				Object.DestroyImmediate(next.GameObject);
+				Object.DestroyImmediate(modifier);
+				Object.DestroyImmediate(template);
+			}
+		}
+
+		[Test]
+		public void ObjectPoolCountsCreatedAndReused()
+		{
+			var pool = new ObjectPool<List<int>>(() => new List<int>());
+			var list = pool.GetObject();
+			pool.Put(list);
+			Assert.AreEqual(1, pool.Count);
+			Assert.AreSame(list, pool.GetObject());
+			pool.GetObject();
+
+			Assert.AreEqual(2, pool.CreatedCount);
+			Assert.AreEqual(1, pool.ReusedCount);
+			Assert.AreEqual(0, pool.Count);
+		}
+
+		#region helper methods
+
+		private static VectorEntity CreateEntity()
+		{
+			var go = new GameObject();
+			var entity = new VectorEntity()
+			{
+				GameObject = go,
+				Transform = go.transform,
+				MeshFilter = go.AddComponent<MeshFilter>(),
+				MeshRenderer = go.AddComponent<MeshRenderer>(),
+				Mesh = new Mesh()
+			};
+			entity.MeshFilter.sharedMesh = entity.Mesh;
+			return entity;
+		}
+
+		#endregion
+	}
+}
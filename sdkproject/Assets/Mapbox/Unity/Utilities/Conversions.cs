@@ -8,6 +8,7 @@ namespace Mapbox.Unity.Utilities
 {
 	using Mapbox.Map;
 	using System;
+	using System.Collections.Generic;
 	using Mapbox.Utils;
 	using UnityEngine;
 	using System.Globalization;
@@ -23,6 +24,10 @@ namespace Mapbox.Unity.Utilities
 		private const int EarthRadius = 6378137; //no seams with globe example
 		private const double InitialResolution = 2 * Math.PI * EarthRadius / TileSize;
 		private const double OriginShift = 2 * Math.PI * EarthRadius / 2;
+		// hoisted factors of the batch conversions
+		internal const double MetersPerDegree = OriginShift / 180;
+		internal const double MercatorMetersPerRadian = OriginShift / Math.PI;
+		internal const double HalfDegreeInRadians = Math.PI / 360;
 
 		/// <summary>
 		/// Converts <see cref="T:Mapbox.Utils.Vector2d"/> struct, WGS84
@@ -261,6 +266,119 @@ namespace Mapbox.Unity.Utilities
 			return unityTilePoint;
 		}
 
+		/// <summary>
+		/// Batch version of <see cref="LatLonToMeters(double, double)"/>, converts <paramref name="count"/> WGS84 lat/lon
+		/// starting at <paramref name="sourceIndex"/> into <paramref name="meters"/> starting at <paramref name="destinationIndex"/>.
+		/// Source and destination may be the same array.
+		/// </summary>
+		public static void LatLonToMeters(Vector2d[] latLons, int sourceIndex, Vector2d[] meters, int destinationIndex, int count)
+		{
+			CheckRange(latLons, "latLons", sourceIndex, count);
+			CheckRange(meters, "meters", destinationIndex, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				var latLon = latLons[sourceIndex + i];
+				meters[destinationIndex + i] = new Vector2d(
+					latLon.y * MetersPerDegree,
+					Math.Log(Math.Tan((90 + latLon.x) * HalfDegreeInRadians)) * MercatorMetersPerRadian);
+			}
+		}
+
+		public static void LatLonToMeters(Vector2d[] latLons, Vector2d[] meters)
+		{
+			LatLonToMeters(latLons, 0, meters, 0, latLons.Length);
+		}
+
+		/// <summary>
+		/// Batch version of <see cref="MetersToLatLon(Vector2d)"/>, converts <paramref name="count"/> web mercator positions
+		/// starting at <paramref name="sourceIndex"/> into <paramref name="latLons"/> starting at <paramref name="destinationIndex"/>.
+		/// Source and destination may be the same array.
+		/// </summary>
+		public static void MetersToLatLon(Vector2d[] meters, int sourceIndex, Vector2d[] latLons, int destinationIndex, int count)
+		{
+			CheckRange(meters, "meters", sourceIndex, count);
+			CheckRange(latLons, "latLons", destinationIndex, count);
+
+			for (int i = 0; i < count; i++)
+			{
+				var m = meters[sourceIndex + i];
+				latLons[destinationIndex + i] = new Vector2d(
+					Math.Atan(Math.Exp(m.y / MercatorMetersPerRadian)) / HalfDegreeInRadians - 90,
+					m.x / MetersPerDegree);
+			}
+		}
+
+		public static void MetersToLatLon(Vector2d[] meters, Vector2d[] latLons)
+		{
+			MetersToLatLon(meters, 0, latLons, 0, meters.Length);
+		}
+
+		/// <summary>
+		/// Batch version of <see cref="GeoToWorldPosition(double, double, Vector2d, float)"/> writing x/z positions,
+		/// the way callers use them. Converts <paramref name="count"/> WGS84 lat/lon starting at <paramref name="sourceIndex"/>.
+		/// </summary>
+		public static void GeoToWorldPosition(Vector2d[] latLons, int sourceIndex, Vector2d refPoint, float scale, Vector3[] positions, int destinationIndex, int count)
+		{
+			CheckRange(latLons, "latLons", sourceIndex, count);
+			CheckRange(positions, "positions", destinationIndex, count);
+
+			double scaleX = MetersPerDegree * scale;
+			double scaleZ = MercatorMetersPerRadian * scale;
+			double offsetX = -refPoint.x * scale;
+			double offsetZ = -refPoint.y * scale;
+			for (int i = 0; i < count; i++)
+			{
+				var latLon = latLons[sourceIndex + i];
+				var mercator = Math.Log(Math.Tan((90 + latLon.x) * HalfDegreeInRadians));
+				positions[destinationIndex + i] = new Vector3((float)(latLon.y * scaleX + offsetX), 0, (float)(mercator * scaleZ + offsetZ));
+			}
+		}
+
+		/// <summary> Append the x/z world positions of <paramref name="latLons"/> to <paramref name="positions"/>, eg a route geometry. </summary>
+		public static void GeoToWorldPosition(IList<Vector2d> latLons, Vector2d refPoint, float scale, List<Vector3> positions)
+		{
+			int count = latLons.Count;
+			if (positions.Capacity < positions.Count + count)
+			{
+				positions.Capacity = positions.Count + count;
+			}
+
+			double scaleX = MetersPerDegree * scale;
+			double scaleZ = MercatorMetersPerRadian * scale;
+			double offsetX = -refPoint.x * scale;
+			double offsetZ = -refPoint.y * scale;
+			for (int i = 0; i < count; i++)
+			{
+				var latLon = latLons[i];
+				var mercator = Math.Log(Math.Tan((90 + latLon.x) * HalfDegreeInRadians));
+				positions.Add(new Vector3((float)(latLon.y * scaleX + offsetX), 0, (float)(mercator * scaleZ + offsetZ)));
+			}
+		}
+
+		/// <summary>
+		/// Batch version of <see cref="LatitudeLongitudeToUnityTilePosition(Vector2d, int, float, ulong)"/>, every coordinate is
+		/// relative to the center of the tile containing it. The tile is found from the meters computed anyway instead of
+		/// another round of trig, and the result doesn't depend on the layer extent so it's not a parameter.
+		/// Use <see cref="TileTransform.LatLonToLocal"/> if all coordinates belong to one known tile.
+		/// </summary>
+		public static void LatitudeLongitudeToUnityTilePosition(Vector2d[] coordinates, int sourceIndex, int tileZoom, float tileScale, Vector2[] positions, int destinationIndex, int count)
+		{
+			CheckRange(coordinates, "coordinates", sourceIndex, count);
+			CheckRange(positions, "positions", destinationIndex, count);
+
+			double tileSize = 2 * OriginShift / Math.Pow(2, tileZoom);
+			for (int i = 0; i < count; i++)
+			{
+				var latLon = coordinates[sourceIndex + i];
+				double x = latLon.y * MetersPerDegree;
+				double y = Math.Log(Math.Tan((90 + latLon.x) * HalfDegreeInRadians)) * MercatorMetersPerRadian;
+				double centerX = (Math.Floor((x + OriginShift) / tileSize) + 0.5) * tileSize - OriginShift;
+				double centerY = OriginShift - (Math.Floor((OriginShift - y) / tileSize) + 0.5) * tileSize;
+				positions[destinationIndex + i] = new Vector2((float)((x - centerX) * tileScale), (float)((y - centerY) * tileScale));
+			}
+		}
+
 		/// <summary>
 		/// Gets the WGS84 longitude of the northwest corner from a tile's X position and zoom level.
 		/// See: http://wiki.openstreetmap.org/wiki/Slippy_map_tilenames.
@@ -393,6 +511,15 @@ namespace Mapbox.Unity.Utilities
 			return (-10000f + ((r * 65536f + g * 256f + b) * 0.1f));
 		}
 
+		internal static void CheckRange(Array array, string name, int index, int count)
+		{
+			if (null == array) { throw new ArgumentNullException(name); }
+			if (index < 0 || count < 0 || index > array.Length - count)
+			{
+				throw new ArgumentOutOfRangeException(name, string.Format("{0} items from {1} don't fit into {2}", count, index, array.Length));
+			}
+		}
+
 		private static double Resolution(int zoom)
 		{
 			return InitialResolution / Math.Pow(2, zoom);
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------
+// <copyright file="MainThreadHttpPipeline.cs" company="Mapbox">
+//     Copyright (c) 2019 Mapbox. All rights reserved.
+// </copyright>
+//-----------------------------------------------------------------------
+
+#if !UNITY_WEBGL && !NETFX_CORE
+
+namespace Mapbox.Unity.Utilities
+{
+	using System;
+	using System.Collections;
+	using System.Collections.Generic;
+	using Mapbox.Platform;
+	using UnityEngine;
+
+#if UNITY_EDITOR
+	using UnityEditor;
+#endif
+
+
+	/// <summary>
+	/// Shared <see cref="HttpPipeline"/> whose callbacks run on the main thread, once per frame via <see cref="Runnable"/>.
+	/// </summary>
+	internal static class MainThreadHttpPipeline
+	{
+
+
+		private static readonly object _lock = new object();
+		private static readonly object _pipelineLock = new object();
+		private static readonly Queue<Action> _completed = new Queue<Action>();
+		private static volatile HttpPipeline _pipeline;
+		private static int _routineId = -1;
+
+
+		public static IAsyncRequest Request(string url, Action<Response> callback, int timeout, HttpRequestType requestType)
+		{
+			HttpPipeline pipeline = _pipeline;
+			if (null == pipeline)
+			{
+				// requests may come from worker threads too: only ever start one I/O thread
+				lock (_pipelineLock)
+				{
+					if (null == _pipeline)
+					{
+						_pipeline = new HttpPipeline(dispatch: enqueueCompleted);
+					}
+					pipeline = _pipeline;
+				}
+			}
+
+			// (re)start delivery, eg after entering/leaving play mode destroyed the Runnable
+			if (_routineId < 0 || !Runnable.IsRunning(_routineId))
+			{
+#if UNITY_EDITOR
+				if (!EditorApplication.isPlaying)
+				{
+					Runnable.EnableRunnableInEditor();
+				}
+#endif
+				_routineId = Runnable.Run(deliverCompleted());
+			}
+
+			return pipeline.Request(url, callback, timeout, requestType);
+		}
+
+
+		private static void enqueueCompleted(Action callback)
+		{
+			lock (_lock)
+			{
+				_completed.Enqueue(callback);
+			}
+		}
+
+
+		private static IEnumerator deliverCompleted()
+		{
+			List<Action> batch = new List<Action>();
+			while (true)
+			{
+				lock (_lock)
+				{
+					while (_completed.Count > 0) { batch.Add(_completed.Dequeue()); }
+				}
+
+				for (int i = 0; i < batch.Count; i++)
+				{
+					try
+					{
+						batch[i]();
+					}
+					catch (Exception ex)
+					{
+						Debug.LogException(ex);
+					}
+				}
+				batch.Clear();
+
+				yield return null;
+			}
+		}
+	}
+}
+
+#endif
@@ -1,10 +1,12 @@
 ﻿namespace Mapbox.Unity.Utilities
 {
 	using Mapbox.Unity.Map;
+	using Mapbox.Utils;
 	using System;
 	using System.Collections;
 	using System.Collections.Generic;
 	using System.Diagnostics;
+	using System.IO;
 	using UnityEngine;
 
 	public class MapVisualizerPerformance : MonoBehaviour
@@ -18,6 +20,17 @@
 		public float TotalTime = 0;
 		private float _firstRun;
 
+		[Tooltip("Trace the tile pipeline and log per stage timings of each run.")]
+		public bool TraceTiles = false;
+		[Tooltip("Also trace the allocations of each stage.")]
+		public bool TraceAllocations = false;
+		[Tooltip("Folder to write each traced run to in the Chrome trace format, nothing is written if empty.")]
+		public string ChromeTraceFolder = "";
+		/// <summary> Stage timings of the last traced run. </summary>
+		[NonSerialized]
+		public TileTraceReport LastReport;
+		private List<TileTraceSpan> _spans = new List<TileTraceSpan>();
+
 		protected virtual void Awake()
 		{
 			TotalTime = 0;
@@ -29,12 +42,22 @@
 			{
 				if (s == ModuleState.Working)
 				{
+					if (TraceTiles)
+					{
+						TileTrace.TrackAllocations = TraceAllocations;
+						TileTrace.Clear();
+						TileTrace.Enabled = true;
+					}
 					_sw.Reset();
 					_sw.Start();
 				}
 				else if (s == ModuleState.Finished)
 				{
 					_sw.Stop();
+					if (TraceTiles)
+					{
+						ReportTrace();
+					}
 					if (_currentTest > 1)
 					{
 						TotalTime += _sw.ElapsedMilliseconds;
@@ -54,13 +77,39 @@
 					{
 						if (_currentTest > 1)
 						{
-							UnityEngine.Debug.Log("First Run:        " + _firstRun + " \r\nRest Average: " + TotalTime / (_currentTest - 1));
+							UnityEngine.Debug.Log("First Run:        " + _firstRun + " \r\nRest Average: " + TotalTime / (_currentTest - 1) + " \r\n" + _mapVisualizer.TilePool);
 						}
 					}
 				}
 			};
 		}
 
+		protected virtual void OnDestroy()
+		{
+			if (TraceTiles)
+			{
+				TileTrace.Enabled = false;
+			}
+		}
+
+		private void ReportTrace()
+		{
+			_spans.Clear();
+			TileTrace.Collect(_spans);
+			LastReport = new TileTraceReport(_spans);
+			UnityEngine.Debug.Log("Test " + _currentTest + " stages:\r\n" + LastReport + "dropped spans: " + TileTrace.Dropped);
+
+			if (!string.IsNullOrEmpty(ChromeTraceFolder))
+			{
+				Directory.CreateDirectory(ChromeTraceFolder);
+				var path = Path.Combine(ChromeTraceFolder, "tiles_" + _currentTest + ".json");
+				using (var writer = new StreamWriter(path))
+				{
+					TileTrace.WriteChromeTrace(writer, _spans);
+				}
+			}
+		}
+
 		public void Run()
 		{
 			//TODO : FIX THIS ERROR	
@@ -17,10 +17,21 @@
 			_objectGenerator = objectGenerator;
 		}
 
+		/// <summary> Objects waiting to be reused. </summary>
+		public int Count { get { return _objects.Count; } }
+		/// <summary> Objects the generator had to create because the pool was empty. </summary>
+		public int CreatedCount { get; private set; }
+		/// <summary> Objects handed out from the pool instead of being created. </summary>
+		public int ReusedCount { get; private set; }
+
 		public T GetObject()
 		{
 			if (_objects.Count > 0)
+			{
+				ReusedCount++;
 				return _objects.Dequeue();
+			}
+			CreatedCount++;
 			return _objectGenerator();
 		}
 
@@ -0,0 +1,159 @@
+namespace Mapbox.Unity.Utilities
+{
+	using System;
+	using System.Collections.Generic;
+	using Mapbox.Map;
+	using Mapbox.Unity.MeshGeneration.Data;
+	using Mapbox.Utils;
+	using Mapbox.VectorTile.Geometry;
+	using UnityEngine;
+
+	/// <summary>
+	/// Affine mapping from the coordinates of one tile to the local space of its <see cref="UnityTile"/>, computed once per tile
+	/// so every vertex costs one multiply-add per axis instead of the divisions and tile bound lookups of
+	/// <see cref="Conversions.LatitudeLongitudeToUnityTilePosition(Vector2d, int, float, ulong)"/>.
+	/// Vector tile coordinates (0 - layer extent, y down) and web mercator meters both map linearly, lat/lon go through
+	/// meters first. <see cref="Translate"/> moves the output from tile to world space for maps that aren't rotated or scaled.
+	/// </summary>
+	public struct TileTransform
+	{
+		/// <summary> Local x and z per vector tile unit, z is negative as vector tile y points south. </summary>
+		public readonly float ScaleX;
+		public readonly float ScaleZ;
+		/// <summary> Local position of vector tile coordinate (0, 0), the north west corner of the tile. </summary>
+		public readonly float OffsetX;
+		public readonly float OffsetY;
+		public readonly float OffsetZ;
+		/// <summary> Local units per web mercator meter. </summary>
+		public readonly float TileScale;
+
+		// local position of web mercator (0, 0), kept in double as meters are large
+		private readonly double _meterOffsetX;
+		private readonly double _meterOffsetZ;
+
+		/// <summary> Transform for a tile of <paramref name="tileBounds"/> meters scaled by <paramref name="tileScale"/>. </summary>
+		public TileTransform(RectD tileBounds, float tileScale, float layerExtent = 4096)
+			: this(tileBounds.Size.x, tileBounds.Size.y, tileScale, layerExtent, -tileBounds.Center.x * tileScale, -tileBounds.Center.y * tileScale, 0)
+		{
+		}
+
+		/// <summary>
+		/// Transform from tile size and scale only, eg on worker threads that captured them from the tile.
+		/// Meters are relative to the tile center.
+		/// </summary>
+		public TileTransform(double tileSizeX, double tileSizeY, float tileScale, float layerExtent = 4096)
+			: this(tileSizeX, tileSizeY, tileScale, layerExtent, 0, 0, 0)
+		{
+		}
+
+		private TileTransform(double tileSizeX, double tileSizeY, float tileScale, float layerExtent, double meterOffsetX, double meterOffsetZ, float offsetY)
+		{
+			if (layerExtent <= 0) { throw new ArgumentOutOfRangeException("layerExtent"); }
+
+			ScaleX = (float)(tileSizeX * tileScale / layerExtent);
+			ScaleZ = (float)(-tileSizeY * tileScale / layerExtent);
+			OffsetX = (float)(-tileSizeX / 2 * tileScale);
+			OffsetY = offsetY;
+			OffsetZ = (float)(tileSizeY / 2 * tileScale);
+			TileScale = tileScale;
+			_meterOffsetX = meterOffsetX;
+			_meterOffsetZ = meterOffsetZ;
+		}
+
+		private TileTransform(TileTransform other, Vector3 offset)
+		{
+			ScaleX = other.ScaleX;
+			ScaleZ = other.ScaleZ;
+			OffsetX = other.OffsetX + offset.x;
+			OffsetY = other.OffsetY + offset.y;
+			OffsetZ = other.OffsetZ + offset.z;
+			TileScale = other.TileScale;
+			_meterOffsetX = other._meterOffsetX + offset.x;
+			_meterOffsetZ = other._meterOffsetZ + offset.z;
+		}
+
+		public static TileTransform ForTile(UnityTile tile, float layerExtent = 4096)
+		{
+			return new TileTransform(tile.Rect, tile.TileScale, layerExtent);
+		}
+
+		public static TileTransform ForTile(UnwrappedTileId tileId, float tileScale, float layerExtent = 4096)
+		{
+			return new TileTransform(Conversions.TileBounds(tileId), tileScale, layerExtent);
+		}
+
+		/// <summary>
+		/// Same transform with <paramref name="offset"/> added to every output, eg the tile's position to go straight to world space.
+		/// </summary>
+		public TileTransform Translate(Vector3 offset)
+		{
+			return new TileTransform(this, offset);
+		}
+
+		public Vector3 VectorTileToLocal(float x, float y)
+		{
+			return new Vector3(x * ScaleX + OffsetX, OffsetY, y * ScaleZ + OffsetZ);
+		}
+
+		/// <summary> Append the local positions of <paramref name="points"/> to <paramref name="results"/>. </summary>
+		public void VectorTileToLocal(List<Point2d<float>> points, List<Vector3> results)
+		{
+			int count = points.Count;
+			if (results.Capacity < results.Count + count)
+			{
+				results.Capacity = results.Count + count;
+			}
+			float scaleX = ScaleX, offsetX = OffsetX, offsetY = OffsetY, scaleZ = ScaleZ, offsetZ = OffsetZ;
+			for (int i = 0; i < count; i++)
+			{
+				var point = points[i];
+				results.Add(new Vector3(point.X * scaleX + offsetX, offsetY, point.Y * scaleZ + offsetZ));
+			}
+		}
+
+		public Vector3 MetersToLocal(Vector2d meters)
+		{
+			return new Vector3((float)(meters.x * TileScale + _meterOffsetX), OffsetY, (float)(meters.y * TileScale + _meterOffsetZ));
+		}
+
+		/// <summary> Web mercator meters to local positions, <paramref name="count"/> items from the given start indices. </summary>
+		public void MetersToLocal(Vector2d[] meters, int sourceIndex, Vector3[] positions, int destinationIndex, int count)
+		{
+			Conversions.CheckRange(meters, "meters", sourceIndex, count);
+			Conversions.CheckRange(positions, "positions", destinationIndex, count);
+
+			double scale = TileScale;
+			double offsetX = _meterOffsetX;
+			double offsetZ = _meterOffsetZ;
+			float offsetY = OffsetY;
+			for (int i = 0; i < count; i++)
+			{
+				var m = meters[sourceIndex + i];
+				positions[destinationIndex + i] = new Vector3((float)(m.x * scale + offsetX), offsetY, (float)(m.y * scale + offsetZ));
+			}
+		}
+
+		/// <summary>
+		/// WGS84 lat/lon to local positions in one pass, without the per point tile lookup of
+		/// <see cref="Conversions.LatitudeLongitudeToUnityTilePosition(Vector2d, int, float, ulong)"/>.
+		/// Points outside the tile extrapolate instead of snapping to the tile containing them.
+		/// </summary>
+		public void LatLonToLocal(Vector2d[] latLons, int sourceIndex, Vector3[] positions, int destinationIndex, int count)
+		{
+			Conversions.CheckRange(latLons, "latLons", sourceIndex, count);
+			Conversions.CheckRange(positions, "positions", destinationIndex, count);
+
+			double scaleX = Conversions.MetersPerDegree * TileScale;
+			double scaleZ = Conversions.MercatorMetersPerRadian * TileScale;
+			double offsetX = _meterOffsetX;
+			double offsetZ = _meterOffsetZ;
+			float offsetY = OffsetY;
+			for (int i = 0; i < count; i++)
+			{
+				var latLon = latLons[sourceIndex + i];
+				var mercator = Math.Log(Math.Tan((90 + latLon.x) * Conversions.HalfDegreeInRadians));
+				positions[destinationIndex + i] = new Vector3((float)(latLon.y * scaleX + offsetX), offsetY, (float)(mercator * scaleZ + offsetZ));
+			}
+		}
+	}
+}